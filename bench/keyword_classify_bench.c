@@ -0,0 +1,157 @@
+/**
+ * @file keyword_classify_bench.c
+ * @brief قياس مصغّر لتصنيف الكلمات المفتاحية: المسح الخطي بـ strcmp مقابل التجزئة التامة.
+ *
+ * يُبنى ويُشغَّل عبر: python3 scripts/bench.py --mode keywords
+ * المدخلات: ملفات .baa تُقطَّع إلى كلمات، ثم تُصنَّف كل كلمة مرات عديدة بالطريقتين.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "language_profile.h"
+
+typedef struct
+{
+    const char *text;
+    size_t length;
+} BenchWord;
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int bench_word_byte(unsigned char c)
+{
+    return c >= 0x80u || c == '_' || (c >= '0' && c <= '9') ||
+           (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+/** التصنيف القديم: مسح خطي لجدول الكلمات مع strcmp على نسخة منتهية بصفر. */
+static int bench_classify_linear(const BenchWord *w, const BaaLanguageKeyword *keywords, size_t count)
+{
+    char word[256];
+    if (w->length >= sizeof(word)) return -1;
+    memcpy(word, w->text, w->length);
+    word[w->length] = '\0';
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (keywords[i].lexical_keyword && strcmp(word, keywords[i].label) == 0)
+            return (int)keywords[i].token_type;
+    }
+    return -1;
+}
+
+static int bench_classify_hash(const BenchWord *w)
+{
+    BaaTokenType type = TOKEN_INVALID;
+    return baa_language_keyword_token_n(w->text, w->length, &type) ? (int)type : -1;
+}
+
+static char *bench_read_file(const char *path, size_t *out_len)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *buf = size >= 0 ? (char *)malloc((size_t)size + 1u) : NULL;
+    if (buf && fread(buf, 1, (size_t)size, f) != (size_t)size)
+    {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    if (buf)
+    {
+        buf[size] = '\0';
+        *out_len = (size_t)size;
+    }
+    return buf;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s <iterations> <file.baa>...\n", argv[0]);
+        return 2;
+    }
+    const long iterations = strtol(argv[1], NULL, 10);
+
+    BenchWord *words = NULL;
+    size_t word_count = 0, word_cap = 0, keyword_hits = 0;
+    for (int a = 2; a < argc; ++a)
+    {
+        size_t len = 0;
+        char *buf = bench_read_file(argv[a], &len);
+        if (!buf)
+        {
+            fprintf(stderr, "error: cannot read %s\n", argv[a]);
+            return 1;
+        }
+        for (size_t i = 0; i < len;)
+        {
+            if (!bench_word_byte((unsigned char)buf[i]))
+            {
+                ++i;
+                continue;
+            }
+            size_t start = i;
+            while (i < len && bench_word_byte((unsigned char)buf[i])) ++i;
+            if (word_count == word_cap)
+            {
+                word_cap = word_cap ? word_cap * 2u : 1024u;
+                words = (BenchWord *)realloc(words, word_cap * sizeof(*words));
+                if (!words) return 1;
+            }
+            words[word_count].text = buf + start;
+            words[word_count].length = i - start;
+            ++word_count;
+        }
+    }
+    if (word_count == 0 || iterations <= 0) return 1;
+
+    size_t keyword_count = 0;
+    const BaaLanguageKeyword *keywords = baa_language_keywords(&keyword_count);
+
+    // تحقق من تطابق الطريقتين قبل القياس.
+    for (size_t i = 0; i < word_count; ++i)
+    {
+        const int expected = bench_classify_linear(&words[i], keywords, keyword_count);
+        if (expected != bench_classify_hash(&words[i]))
+        {
+            fprintf(stderr, "error: classification mismatch for '%.*s'\n",
+                    (int)words[i].length, words[i].text);
+            return 1;
+        }
+        if (expected >= 0) ++keyword_hits;
+    }
+
+    volatile long sink = 0;
+    double t0 = bench_now();
+    for (long it = 0; it < iterations; ++it)
+        for (size_t i = 0; i < word_count; ++i)
+            sink += bench_classify_linear(&words[i], keywords, keyword_count);
+    const double linear_s = bench_now() - t0;
+
+    t0 = bench_now();
+    for (long it = 0; it < iterations; ++it)
+        for (size_t i = 0; i < word_count; ++i)
+            sink += bench_classify_hash(&words[i]);
+    const double hash_s = bench_now() - t0;
+
+    const double total = (double)word_count * (double)iterations;
+    printf("{\"words\":%zu,\"keyword_hits\":%zu,\"iterations\":%ld,"
+           "\"linear_ns_per_word\":%.2f,\"hash_ns_per_word\":%.2f,\"speedup\":%.2f}\n",
+           word_count, keyword_hits, iterations,
+           linear_s * 1e9 / total, hash_s * 1e9 / total,
+           hash_s > 0.0 ? linear_s / hash_s : 0.0);
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file text_scan_bench.c
+ * @brief قياس مصغّر لمسح نصوص المصدر: التحقق من UTF-8 وعدّ الأسطر وتخطي المسافات لكل مسار.
+ *
+ * يُبنى ويُشغَّل عبر: python3 scripts/bench.py --mode textscan
+ * المدخلات: ملفات .baa تُضمّ في مخزن واحد، ثم تُقارن نتائج كل مسار (SSE2/AVX2) بالمسار
+ * العددي على المخزن وعلى نسخ مشوَّهة عشوائياً منه قبل قياس الإنتاجية.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "text_scan.h"
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static char *bench_read_file(const char *path, size_t *out_len)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *buf = size >= 0 ? (char *)malloc((size_t)size + 1u) : NULL;
+    if (buf && fread(buf, 1, (size_t)size, f) != (size_t)size)
+    {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    if (buf)
+    {
+        buf[size] = '\0';
+        *out_len = (size_t)size;
+    }
+    return buf;
+}
+
+/** مولّد xorshift ثابت البذرة كي تتكرر الحالات المشوَّهة بين التشغيلات. */
+static unsigned bench_rand(unsigned *state)
+{
+    unsigned x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+typedef struct
+{
+    size_t valid_prefix;
+    size_t newlines;
+    size_t space_run;
+    size_t find_either;
+} BenchScan;
+
+static BenchScan bench_scan(const char *text, size_t len, size_t at)
+{
+    BenchScan r;
+    r.valid_prefix = baa_utf8_valid_prefix(text, len);
+    r.newlines = baa_text_count_newlines(text, len);
+    r.space_run = baa_text_span_space(text + at, len - at);
+    r.find_either = baa_text_find_either(text + at, len - at, '"', '\\');
+    return r;
+}
+
+/** يقارن مستوى level بالمسار العددي على text[0..len) من عدة نقاط بداية؛ يعيد 0 عند التطابق. */
+static int bench_cross_check(BaaTextScanLevel level, const char *text, size_t len)
+{
+    const size_t starts[] = {0u, 1u, 7u, 15u, 16u, 31u, 33u, len / 2u};
+    for (size_t s = 0; s < sizeof(starts) / sizeof(starts[0]); ++s)
+    {
+        const size_t at = starts[s] <= len ? starts[s] : len;
+        baa_text_scan_limit_level(BAA_TEXT_SCAN_SCALAR);
+        const BenchScan expected = bench_scan(text, len, at);
+        baa_text_scan_limit_level(level);
+        const BenchScan actual = bench_scan(text, len, at);
+        if (memcmp(&expected, &actual, sizeof(expected)) != 0)
+        {
+            fprintf(stderr,
+                    "error: level %d disagrees with scalar (len=%zu at=%zu): "
+                    "prefix %zu/%zu newlines %zu/%zu space %zu/%zu find %zu/%zu\n",
+                    (int)level, len, at, expected.valid_prefix, actual.valid_prefix,
+                    expected.newlines, actual.newlines, expected.space_run, actual.space_run,
+                    expected.find_either, actual.find_either);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s <iterations> <file.baa>...\n", argv[0]);
+        return 2;
+    }
+    const long iterations = strtol(argv[1], NULL, 10);
+
+    char *text = NULL;
+    size_t len = 0;
+    for (int a = 2; a < argc; ++a)
+    {
+        size_t file_len = 0;
+        char *buf = bench_read_file(argv[a], &file_len);
+        if (!buf)
+        {
+            fprintf(stderr, "error: cannot read %s\n", argv[a]);
+            return 1;
+        }
+        text = (char *)realloc(text, len + file_len + 1u);
+        if (!text) return 1;
+        memcpy(text + len, buf, file_len);
+        len += file_len;
+        text[len] = '\0';
+        free(buf);
+    }
+    if (len == 0 || iterations <= 0) return 1;
+
+    const BaaTextScanLevel best = baa_text_scan_limit_level(BAA_TEXT_SCAN_AVX2);
+
+    // تحقق من تطابق كل مسار مع المسار العددي: المخزن كاملاً، ثم نوافذ مشوَّهة
+    // بأطوال وإزاحات متغيرة تعبر حدود 16 و32 بايتاً.
+    char *mutated = (char *)malloc(len + 1u);
+    if (!mutated) return 1;
+    unsigned seed = 0x9E3779B9u;
+    size_t cases = 0;
+    for (int level = BAA_TEXT_SCAN_SSE2; level <= (int)best; ++level)
+    {
+        if (bench_cross_check((BaaTextScanLevel)level, text, len) != 0) return 1;
+        ++cases;
+        for (int round = 0; round < 2000; ++round)
+        {
+            const size_t off = bench_rand(&seed) % len;
+            size_t win = 1u + bench_rand(&seed) % 96u;
+            if (win > len - off) win = len - off;
+            memcpy(mutated, text + off, win);
+            const unsigned edits = bench_rand(&seed) % 4u;
+            for (unsigned e = 0; e < edits; ++e)
+            {
+                static const unsigned char k_bytes[] = {
+                    0x80, 0xBF, 0xC0, 0xC1, 0xC2, 0xD8, 0xD9, 0xDF, 0xE0, 0xED,
+                    0xEF, 0xF0, 0xF4, 0xF5, 0xFF, '\n', ' ', '\t', '"', '\\'};
+                mutated[bench_rand(&seed) % win] =
+                    (char)k_bytes[bench_rand(&seed) % sizeof(k_bytes)];
+            }
+            if (bench_cross_check((BaaTextScanLevel)level, mutated, win) != 0) return 1;
+            ++cases;
+        }
+    }
+    free(mutated);
+
+    printf("{\"bytes\":%zu,\"iterations\":%ld,\"best_level\":%d,\"cross_checked_cases\":%zu,\"levels\":[",
+           len, iterations, (int)best, cases);
+    volatile size_t sink = 0;
+    for (int level = BAA_TEXT_SCAN_SCALAR; level <= (int)best; ++level)
+    {
+        baa_text_scan_limit_level((BaaTextScanLevel)level);
+        double t0 = bench_now();
+        for (long it = 0; it < iterations; ++it)
+            sink += baa_utf8_valid_prefix(text, len);
+        const double validate_s = bench_now() - t0;
+
+        t0 = bench_now();
+        for (long it = 0; it < iterations; ++it)
+            sink += baa_text_count_newlines(text, len);
+        const double newlines_s = bench_now() - t0;
+
+        const double mb = (double)len * (double)iterations / 1e6;
+        printf("%s{\"level\":%d,\"utf8_validate_mb_per_s\":%.1f,\"count_newlines_mb_per_s\":%.1f}",
+               level == BAA_TEXT_SCAN_SCALAR ? "" : ",", level,
+               validate_s > 0.0 ? mb / validate_s : 0.0,
+               newlines_s > 0.0 ? mb / newlines_s : 0.0);
+    }
+    printf("]}\n");
+    (void)sink;
+    free(text);
+    return 0;
+}
@@ -23,6 +23,25 @@ RESULTS_DIR = BENCH_DIR / "results"
 
 TIME_RE = re.compile(r"^\[TIME\]\s+(.*)$")
 MEM_RE = re.compile(r"^\[MEM\]\s+(.*)$")
+REGALLOC_RE = re.compile(r"^\[REGALLOC\]\s+(.*)$")
+ANALYSIS_RE = re.compile(r"^\[ANALYSIS\]\s+(.*)$")
+OPT_PASS_RE = re.compile(r"^\[OPT-PASS\]\s+(.*)$")
+OPT_SUMMARY_RE = re.compile(r"^\[OPT\]\s+(.*)$")
+IR_LOAD_RE = re.compile(r"= حمل ")
+IR_STORE_RE = re.compile(r"^\s*خزن ", re.M)
+IR_ALLOCA_RE = re.compile(r"= حجز ")
+
+# خط التمريرات الافتراضي بدون sroa (لقياس أثرها وحدها في وضع memops).
+NO_SROA_PIPELINE = {
+    "O1": "mem2reg,canon,instcombine,sccp,constfold,copyprop,memopt,dce,cfg-simplify,licm",
+    "O2": "mem2reg,canon,instcombine,sccp,constfold,copyprop,gvn,cse,memopt,dce,cfg-simplify,licm",
+}
+
+# الخط الافتراضي بدون memopt (أثر تمرير الخزن/حذف الحمل والخزن الزائد وحده).
+NO_MEMOPT_PIPELINE = {
+    "O1": "sroa,mem2reg,canon,instcombine,sccp,constfold,copyprop,dce,cfg-simplify,licm",
+    "O2": "sroa,mem2reg,canon,instcombine,sccp,constfold,copyprop,gvn,cse,dce,cfg-simplify,licm",
+}
 
 
 def _run_capture(cmd: list[str], cwd: Path) -> subprocess.CompletedProcess[str]:
@@ -196,15 +215,643 @@ def _median(xs: list[float]) -> float:
     return 0.5 * (ys[mid - 1] + ys[mid])
 
 
+ARABIC_DIGITS = str.maketrans("0123456789", "٠١٢٣٤٥٦٧٨٩")
+
+
+def _symbol_scale_source(symbols: int) -> str:
+    """Half globals, half locals (64 per function); every local reads one global."""
+    def num(n: int) -> str:
+        return str(n).translate(ARABIC_DIGITS)
+
+    globals_count = max(1, symbols // 2)
+    funcs = max(1, (symbols - globals_count) // 64)
+    lines = [f"صحيح ع{num(i)} = {num(i % 10)}." for i in range(globals_count)]
+    for f in range(funcs):
+        lines.append(f"صحيح دفعة{num(f)}(صحيح أساس) {{")
+        for i in range(64):
+            g = (f * 64 + i) % globals_count
+            lines.append(f"    صحيح س{num(i)} = أساس + ع{num(g)}.")
+        lines.append("    إرجع " + " + ".join(f"س{num(i)}" for i in range(64)) + ".")
+        lines.append("}")
+    lines.append("صحيح الرئيسية() {")
+    lines.append("    صحيح مجموع = ٠.")
+    for f in range(funcs):
+        lines.append(f"    مجموع = مجموع + دفعة{num(f)}(١).")
+    lines.append("    إرجع مجموع - مجموع.")
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+def _nested_scope_source(depth: int, locals_per_scope: int, funcs: int) -> str:
+    """`funcs` functions, each nesting `depth` blocks that declare `locals_per_scope` locals."""
+    def num(n: int) -> str:
+        return str(n).translate(ARABIC_DIGITS)
+
+    lines: list[str] = []
+    for f in range(funcs):
+        lines.append(f"صحيح متداخل{num(f)}(صحيح أساس) {{")
+        lines.append("    صحيح مجموع = أساس.")
+        for d in range(depth):
+            lines.append("{")
+            for i in range(locals_per_scope):
+                lines.append(f"صحيح ن{num(d)}_{num(i)} = مجموع + {num(i)}.")
+            lines.append(f"مجموع = مجموع + ن{num(d)}_{num(locals_per_scope - 1)}.")
+        lines.append("}" * depth)
+        lines.append("    إرجع مجموع.")
+        lines.append("}")
+    lines.append("صحيح الرئيسية() {")
+    lines.append("    إرجع ٠.")
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+def _macro_header_source(macros: int) -> tuple[str, str]:
+    """A header with `macros` constants (a conditional per 64) and a main that reads a spread of them."""
+    def num(n: int) -> str:
+        return str(n).translate(ARABIC_DIGITS)
+
+    header: list[str] = []
+    for i in range(macros):
+        if i % 64 == 0:
+            header.append(f"#إذا_عرف ثابت_{num(i)}")
+            header.append("#وإلا")
+        # قيم الماكرو الرقمية تُمرر كما هي إلى المحلل، فنستخدم أرقاماً لاتينية.
+        header.append(f"#تعريف ثابت_{num(i)} {i % 100}")
+        if i % 64 == 0:
+            header.append("#نهاية")
+    step = max(1, macros // 256)
+    used = list(range(0, macros, step))
+    main = ['#تضمين "macros.baahd"', "صحيح الرئيسية() {", "    صحيح مجموع = ٠."]
+    main += [f"    مجموع = مجموع + ثابت_{num(i)}." for i in used]
+    main += ["    إرجع مجموع - مجموع.", "}"]
+    return "\n".join(header) + "\n", "\n".join(main) + "\n"
+
+
+def _many_funcs_source(funcs: int) -> str:
+    """`bench/compile_many_funcs.baa` scaled to `funcs` functions, with locals and a string literal."""
+    lines = ["صحيح مصيدة = 0.", ""]
+    for i in range(funcs):
+        lines.append(f"صحيح ف{i}(صحيح س) {{ صحيح مؤقت = س * 3. نص وسم = \"دالة {i}\". إرجع مؤقت + {i}. }}")
+    lines.append("صحيح الرئيسية() {")
+    lines.append("    صحيح مجموع = 0.")
+    for i in range(0, funcs, max(1, funcs // 64)):
+        lines.append(f"    مجموع = مجموع + ف{i}(1).")
+    lines.append("    إرجع مصيدة * مجموع.")
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+def _parallel_funcs_source(funcs: int) -> str:
+    """`funcs` independent functions, each with a loop, a branch and a switch, so every phase has per-function work."""
+    lines: list[str] = []
+    for i in range(funcs):
+        lines += [
+            f"صحيح ف{i}(صحيح ن) {{",
+            f"    صحيح م = {i}.",
+            "    لكل (صحيح ي = ٠؛ ي < ن؛ ي++) {",
+            f"        صحيح ك = ن * ٣ + {i}.",
+            "        إذا (ي % ٢ == ٠) { م = م + ي * ك. } وإلا { م = م - ي. }",
+            "    }",
+            "    اختر (م % ٤) {",
+            "        حالة ٠: م = م + ١. توقف.",
+            "        حالة ١: م = م * ٢. توقف.",
+            "        افتراضي: م = م - ٣. توقف.",
+            "    }",
+            "    إرجع م.",
+            "}",
+        ]
+    lines += ["صحيح الرئيسية() {", "    صحيح م = ٠."]
+    lines += [f"    م = م + ف{i}(٥)." for i in range(0, funcs, max(1, funcs // 64))]
+    lines += ["    اطبع م.", "    إرجع ٠.", "}"]
+    return "\n".join(lines) + "\n"
+
+
+def _bench_threads(baa: Path, out_dir: Path, funcs: list[int], counts: list[int], runs: int) -> list[dict]:
+    """One generated module per size compiled at -O2 with each --threads count; median per-phase times and output identity."""
+    phases = ("opt", "isel", "regalloc", "emit", "total")
+    rows: list[dict] = []
+    for n in funcs:
+        src = out_dir / f"parallel_funcs_{n}.baa"
+        src.write_text(_parallel_funcs_source(n), encoding="utf-8")
+        serial_asm: bytes | None = None
+        for threads in counts:
+            asm = out_dir / f"parallel_funcs_{n}.t{threads}.s"
+            cmd = [str(baa), "-O2", "-S", "--assembler=gas", "--time-phases", f"--threads={threads}",
+                   str(src), "-o", str(asm)]
+            row: dict = {"funcs": n, "threads": threads}
+            samples: dict[str, list[float]] = {ph: [] for ph in phases}
+            for _ in range(max(1, runs)):
+                p = _run_capture(cmd, cwd=ROOT)
+                stats = _extract_compiler_stats(p.stderr).get("time_phases", {})
+                if p.returncode != 0 or "total" not in stats:
+                    row["error"] = p.stderr[-4000:]
+                    break
+                for ph in phases:
+                    samples[ph].append(float(stats.get(ph, 0.0)))
+            if "error" not in row:
+                row["time_s"] = {ph: _median(v) for ph, v in samples.items()}
+                data = asm.read_bytes()
+                if serial_asm is None:
+                    serial_asm = data
+                row["identical"] = data == serial_asm
+            rows.append(row)
+
+    base = {r["funcs"]: r["time_s"]["total"] for r in rows if "time_s" in r and r["threads"] == counts[0]}
+    for r in rows:
+        if "error" in r:
+            print(f"threads funcs={r['funcs']} threads={r['threads']}: error")
+            continue
+        t = r["time_s"]
+        speedup = base.get(r["funcs"], 0.0) / t["total"] if t["total"] > 0 else 0.0
+        r["speedup"] = speedup
+        print(
+            f"threads funcs={r['funcs']:>6} threads={r['threads']:>2} opt={t['opt']:.4f} isel={t['isel']:.4f} "
+            f"regalloc={t['regalloc']:.4f} emit={t['emit']:.4f} total={t['total']:.4f} "
+            f"x{speedup:.2f} identical={'yes' if r['identical'] else 'NO'}"
+        )
+    return rows
+
+
+# عدد تعليمات الآلة التقريبي لكل جملة يولدها _regalloc_scale_source عند -O0.
+REGALLOC_SCALE_INSTS_PER_STMT = 24
+
+
+def _regalloc_scale_source(insts: int) -> str:
+    """One function of about `insts` machine instructions: 8 rotating locals, a branch every 8th statement, a call every 32nd."""
+    def num(n: int) -> str:
+        return str(n).translate(ARABIC_DIGITS)
+
+    stmts = max(1, insts // REGALLOC_SCALE_INSTS_PER_STMT)
+    lines = ["صحيح مساعد(صحيح س) {", "    إرجع س % ٩٧ + ١.", "}", "صحيح ضخم(صحيح أ) {"]
+    for v in range(8):
+        lines.append(f"    صحيح م{num(v)} = أ + {num(v)}.")
+    for i in range(stmts):
+        d = num(i % 8)
+        s = num((i * 3 + 1) % 8)
+        if i % 32 == 31:
+            lines.append(f"    م{d} = م{d} + مساعد(م{s}).")
+        elif i % 8 == 7:
+            lines.append(f"    إذا (م{d} > ١٠٠٠) {{ م{d} = م{d} - م{s} % ١٠٠٠. }}")
+        else:
+            lines.append(f"    م{d} = م{s} * ٣ + م{d} % ٧ + {num(i % 100)}.")
+    lines.append("    إرجع " + " + ".join(f"م{num(v)}" for v in range(8)) + ".")
+    lines += ["}", "صحيح الرئيسية() {", "    اطبع ضخم(٣).", "    إرجع ٠.", "}"]
+    return "\n".join(lines) + "\n"
+
+
+def _measure_phase(baa: Path, src: Path, runs: int, phase: str) -> tuple[list[float], str | None]:
+    phase_s: list[float] = []
+    for _ in range(max(1, runs)):
+        p = _run_capture([str(baa), "--check", "--time-phases", str(src)], cwd=ROOT)
+        stats = _extract_compiler_stats(p.stderr)
+        if p.returncode != 0 or phase not in stats.get("time_phases", {}):
+            return phase_s, p.stderr[-4000:]
+        phase_s.append(float(stats["time_phases"][phase]))
+    return phase_s, None
+
+
+def _measure_analyze(baa: Path, src: Path, runs: int) -> tuple[list[float], str | None]:
+    return _measure_phase(baa, src, runs, "analyze")
+
+
+def _bench_symbol_scaling(baa: Path, out_dir: Path, scales: list[int], runs: int) -> list[dict]:
+    """Measure semantic-analysis time per symbol; a flat ns/symbol column means O(1) lookup."""
+    rows: list[dict] = []
+    for n in scales:
+        src = out_dir / f"symbols_{n}.baa"
+        src.write_text(_symbol_scale_source(n), encoding="utf-8")
+        analyze_s, error = _measure_analyze(baa, src, runs)
+        row: dict = {"symbols": n}
+        if error is not None:
+            row["error"] = error
+        else:
+            med = _median(analyze_s)
+            row["analyze_s"] = {"runs": analyze_s, "median": med}
+            row["analyze_ns_per_symbol"] = med * 1e9 / n
+            print(f"symbols {n}: analyze={med:.6f}s ({row['analyze_ns_per_symbol']:.1f} ns/symbol)")
+        rows.append(row)
+    return rows
+
+
+def _bench_scope_depth(baa: Path, out_dir: Path, depths: list[int], runs: int) -> list[dict]:
+    """Keep ~16k locals fixed while nesting deeper; flat analyze time means O(1) scope exit."""
+    total_locals = 16384
+    rows: list[dict] = []
+    for depth in depths:
+        per_scope = 4
+        funcs = max(1, total_locals // (depth * per_scope))
+        src = out_dir / f"scopes_{depth}.baa"
+        src.write_text(_nested_scope_source(depth, per_scope, funcs), encoding="utf-8")
+        analyze_s, error = _measure_analyze(baa, src, runs)
+        row: dict = {"depth": depth, "locals": funcs * depth * per_scope, "functions": funcs}
+        if error is not None:
+            row["error"] = error
+        else:
+            med = _median(analyze_s)
+            row["analyze_s"] = {"runs": analyze_s, "median": med}
+            row["analyze_ns_per_local"] = med * 1e9 / row["locals"]
+            print(f"scopes depth={depth}: analyze={med:.6f}s ({row['analyze_ns_per_local']:.1f} ns/local)")
+        rows.append(row)
+    return rows
+
+
+def _bench_macro_header(baa: Path, out_dir: Path, counts: list[int], runs: int) -> list[dict]:
+    """Lex a header with thousands of macros; flat ns/macro means O(1) define/lookup."""
+    rows: list[dict] = []
+    for n in counts:
+        case_dir = out_dir / f"macros_{n}"
+        case_dir.mkdir(parents=True, exist_ok=True)
+        header, main = _macro_header_source(n)
+        (case_dir / "macros.baahd").write_text(header, encoding="utf-8")
+        src = case_dir / "main.baa"
+        src.write_text(main, encoding="utf-8")
+        parse_s, error = _measure_phase(baa, src, runs, "parse")
+        row: dict = {"macros": n}
+        if error is not None:
+            row["error"] = error
+        else:
+            med = _median(parse_s)
+            row["parse_s"] = {"runs": parse_s, "median": med}
+            row["parse_ns_per_macro"] = med * 1e9 / n
+            print(f"macros {n}: parse={med:.6f}s ({row['parse_ns_per_macro']:.1f} ns/macro)")
+        rows.append(row)
+    return rows
+
+
+def _bench_shared_includes(baa: Path, out_dir: Path, unit_counts: list[int], runs: int) -> list[dict]:
+    """Build N units that include one shared header; source_loads stays 1 when the include cache works."""
+    header = "".join(
+        f"صحيح مشترك{i}(صحيح س) {{\n    إرجع س + {i}.\n}}\n" for i in range(2000)
+    )
+    rows: list[dict] = []
+    for n in unit_counts:
+        case_dir = out_dir / f"includes_{n}"
+        case_dir.mkdir(parents=True, exist_ok=True)
+        (case_dir / "مشترك.baahd").write_text(header, encoding="utf-8")
+        units: list[str] = []
+        for u in range(n):
+            name = f"u{u}.baa"
+            (case_dir / name).write_text(
+                f'#تضمين "مشترك.baahd"\nصحيح دالة{u}() {{\n    إرجع مشترك{u % 2000}(١).\n}}\n',
+                encoding="utf-8",
+            )
+            units.append(name)
+        read_s: list[float] = []
+        parse_s: list[float] = []
+        row: dict = {"units": n, "header_bytes": len(header.encode("utf-8"))}
+        for _ in range(max(1, runs)):
+            p = _run_capture([str(baa), "--check", "--time-phases", *units], cwd=case_dir)
+            stats = _extract_compiler_stats(p.stderr)
+            phases = stats.get("time_phases", {})
+            if p.returncode != 0 or "read" not in phases:
+                row["error"] = p.stderr[-4000:]
+                break
+            read_s.append(float(phases["read"]))
+            parse_s.append(float(phases["parse"]))
+            mem = stats.get("mem", {})
+            row["source_loads"] = int(mem.get("source_loads", "0"))
+            row["source_cache_hits"] = int(mem.get("source_cache_hits", "0"))
+        if "error" not in row:
+            row["read_s"] = {"runs": read_s, "median": _median(read_s)}
+            row["parse_s"] = {"runs": parse_s, "median": _median(parse_s)}
+            print(
+                f"includes units={n}: read={row['read_s']['median']:.6f}s "
+                f"parse={row['parse_s']['median']:.6f}s "
+                f"loads={row['source_loads']} hits={row['source_cache_hits']}"
+            )
+        rows.append(row)
+    return rows
+
+
+def _bench_lex_throughput(baa: Path, out_dir: Path, func_counts: list[int], runs: int) -> list[dict]:
+    """Lexing+parsing throughput (MB/s of source) over compile_many_funcs-style input."""
+    rows: list[dict] = []
+    for n in func_counts:
+        src = out_dir / f"lex_{n}.baa"
+        src.write_text(_many_funcs_source(n), encoding="utf-8")
+        size = src.stat().st_size
+        parse_s, error = _measure_phase(baa, src, runs, "parse")
+        row: dict = {"functions": n, "bytes": size}
+        if error is not None:
+            row["error"] = error
+        else:
+            med = _median(parse_s)
+            row["parse_s"] = {"runs": parse_s, "median": med}
+            row["parse_mb_per_s"] = (size / 1e6) / med if med > 0 else None
+            mbps = row["parse_mb_per_s"] or 0.0
+            print(f"lex functions={n} ({size / 1e6:.2f} MB): parse={med:.6f}s ({mbps:.1f} MB/s)")
+        rows.append(row)
+    return rows
+
+
+def _asm_inst_count(asm: Path) -> int:
+    """Instruction lines in a GAS file (indented, not directives)."""
+    count = 0
+    for line in asm.read_text(encoding="utf-8", errors="replace").splitlines():
+        if line[:1] in (" ", "\t") and not line.strip().startswith((".", "#")) and line.strip():
+            count += 1
+    return count
+
+
+def _bench_regalloc_scaling(baa: Path, out_dir: Path, sizes: list[int], runs: int) -> list[dict]:
+    """Regalloc time (--time-phases) on one generated function per size; a flat ns/inst column means linear scaling."""
+    rows: list[dict] = []
+    for n in sizes:
+        src = out_dir / f"regalloc_scale_{n}.baa"
+        src.write_text(_regalloc_scale_source(n), encoding="utf-8")
+        for allocator in ("linear", "split"):
+            asm = out_dir / f"regalloc_scale_{n}.{allocator}.s"
+            cmd = [str(baa), "-O0", "-S", "--time-phases", f"--regalloc={allocator}", str(src), "-o", str(asm)]
+            times: list[float] = []
+            row: dict = {"size": n, "allocator": allocator}
+            for _ in range(max(1, runs)):
+                p = _run_capture(cmd, cwd=ROOT)
+                stats = _extract_compiler_stats(p.stderr)
+                if p.returncode != 0 or "regalloc" not in stats.get("time_phases", {}):
+                    row["error"] = p.stderr[-4000:]
+                    break
+                times.append(float(stats["time_phases"]["regalloc"]))
+            if "error" not in row:
+                med = _median(times)
+                insts = _asm_inst_count(asm)
+                row["insts"] = insts
+                row["regalloc_s"] = {"runs": times, "median": med}
+                row["regalloc_ns_per_inst"] = med * 1e9 / insts if insts else None
+            rows.append(row)
+
+    # رسم نصي: طول الشريط يتناسب مع الزمن لكل تعليمة، فالأشرطة المتساوية تعني نمواً خطياً.
+    ok = [r for r in rows if r.get("regalloc_ns_per_inst")]
+    widest = max((r["regalloc_ns_per_inst"] for r in ok), default=0.0)
+    for r in rows:
+        if "error" in r:
+            print(f"regalloc-scaling size={r['size']} {r['allocator']}: error")
+            continue
+        per = r["regalloc_ns_per_inst"] or 0.0
+        bar = "#" * max(1, round(40 * per / widest)) if widest > 0 else ""
+        print(
+            f"regalloc-scaling {r['allocator']:6} insts={r['insts']:>8} "
+            f"regalloc={r['regalloc_s']['median']:.6f}s {per:9.1f} ns/inst {bar}"
+        )
+    return rows
+
+
+def _bench_keyword_classify(out_dir: Path, iterations: int) -> dict:
+    """Keyword classification micro-benchmark: linear strcmp scan vs perfect hash over tests/corpus_docs."""
+    cc = os.environ.get("CC") or shutil.which("cc") or shutil.which("gcc")
+    if not cc:
+        return {"error": "no C compiler found (set CC)"}
+    exe = out_dir / ("keyword_classify_bench" + (".exe" if os.name == "nt" else ""))
+    build = _run_capture(
+        [
+            cc, "-std=c11", "-O2",
+            "-I", str(ROOT / "src" / "frontend"), "-I", str(ROOT / "src"),
+            "-o", str(exe),
+            str(BENCH_DIR / "keyword_classify_bench.c"),
+            str(ROOT / "src" / "frontend" / "language_profile.c"),
+        ],
+        cwd=ROOT,
+    )
+    if build.returncode != 0:
+        return {"error": build.stderr.strip()}
+    docs = sorted((ROOT / "tests" / "corpus_docs").glob("*.baa"))
+    run = _run_capture([str(exe), str(iterations), *[str(d) for d in docs]], cwd=ROOT)
+    if run.returncode != 0:
+        return {"error": run.stderr.strip()}
+    row = json.loads(run.stdout)
+    row["sources"] = [str(d.relative_to(ROOT)) for d in docs]
+    print(
+        f"keywords words={row['words']}: linear={row['linear_ns_per_word']:.1f} ns/word "
+        f"hash={row['hash_ns_per_word']:.1f} ns/word ({row['speedup']:.1f}x)"
+    )
+    return row
+
+def _bench_text_scan(out_dir: Path, iterations: int) -> dict:
+    """Bulk text scanning micro-benchmark: scalar vs SSE2/AVX2 UTF-8 validation and newline counting."""
+    cc = os.environ.get("CC") or shutil.which("cc") or shutil.which("gcc")
+    if not cc:
+        return {"error": "no C compiler found (set CC)"}
+    exe = out_dir / ("text_scan_bench" + (".exe" if os.name == "nt" else ""))
+    build = _run_capture(
+        [
+            cc, "-std=c11", "-O2",
+            "-I", str(ROOT / "src" / "support"), "-I", str(ROOT / "src"),
+            "-o", str(exe),
+            str(BENCH_DIR / "text_scan_bench.c"),
+            str(ROOT / "src" / "support" / "text_scan.c"),
+        ],
+        cwd=ROOT,
+    )
+    if build.returncode != 0:
+        return {"error": build.stderr.strip()}
+    sources = sorted(p for d in ("tests", "examples") for p in (ROOT / d).rglob("*.baa"))
+    run = _run_capture([str(exe), str(iterations), *[str(s) for s in sources]], cwd=ROOT)
+    if run.returncode != 0:
+        return {"error": run.stderr.strip()}
+    row = json.loads(run.stdout)
+    row["source_count"] = len(sources)
+    for level in row["levels"]:
+        print(
+            f"textscan level={level['level']} ({row['bytes'] / 1e6:.2f} MB): "
+            f"utf8={level['utf8_validate_mb_per_s']:.0f} MB/s "
+            f"newlines={level['count_newlines_mb_per_s']:.0f} MB/s"
+        )
+    return row
+
+
+JUMP_LINE_RE = re.compile(r"^\s+(j[a-z]+)\s")
+
+
+def _object_text_bytes(obj: Path) -> int | None:
+    """Total size of .text* sections in an ELF64 or COFF object."""
+    data = obj.read_bytes()
+    if data[:4] == b"\x7fELF":
+        if data[4] != 2:
+            return None
+        shoff = int.from_bytes(data[0x28:0x30], "little")
+        shentsize = int.from_bytes(data[0x3A:0x3C], "little")
+        shnum = int.from_bytes(data[0x3C:0x3E], "little")
+        shstrndx = int.from_bytes(data[0x3E:0x40], "little")
+        headers = [data[shoff + i * shentsize : shoff + (i + 1) * shentsize] for i in range(shnum)]
+        strtab = headers[shstrndx]
+        str_off = int.from_bytes(strtab[0x18:0x20], "little")
+        total = 0
+        for h in headers:
+            name_off = str_off + int.from_bytes(h[0:4], "little")
+            name = data[name_off : data.index(b"\0", name_off)]
+            if name.startswith(b".text"):
+                total += int.from_bytes(h[0x20:0x28], "little")
+        return total
+    nsections = int.from_bytes(data[2:4], "little")
+    opt_size = int.from_bytes(data[16:18], "little")
+    total = 0
+    for i in range(nsections):
+        h = data[20 + opt_size + i * 40 : 20 + opt_size + (i + 1) * 40]
+        if h[:8].rstrip(b"\0").startswith(b".text"):
+            total += int.from_bytes(h[16:20], "little")
+    return total
+
+
+def _measure_code_size(baa: Path, src_rel: Path, out_dir: Path, stem: str, opt: str, target: str | None) -> dict:
+    """Emitted .text bytes plus static jump counts (GAS output) for one benchmark."""
+    base = [str(baa), f"-{opt}", "--assembler=gas"] + ([f"--target={target}"] if target else [])
+    asm_out = out_dir / f"{stem}.size.s"
+    obj_out = out_dir / f"{stem}.size.o"
+    p = _run_capture(base + ["-S", str(src_rel), "-o", str(asm_out)], cwd=ROOT)
+    if p.returncode != 0:
+        return {"error": p.stderr[-4000:]}
+    jumps = [m.group(1) for m in map(JUMP_LINE_RE.match, asm_out.read_text(encoding="utf-8").splitlines()) if m]
+    row: dict = {
+        "jmp": sum(1 for j in jumps if j == "jmp"),
+        "jcc": sum(1 for j in jumps if j != "jmp"),
+    }
+    p = _run_capture(base + ["-c", str(src_rel), "-o", str(obj_out)], cwd=ROOT)
+    if p.returncode != 0:
+        row["error"] = p.stderr[-4000:]
+        return row
+    row["text_bytes"] = _object_text_bytes(obj_out)
+    return row
+
+
+def _measure_assembler(baa: Path, src_rel: Path, out_dir: Path, stem: str, opt: str, runs: int) -> dict:
+    """Median emit+assemble time of -c through GAS and through the in-process ELF writer."""
+    row: dict = {}
+    for assembler in ("gas", "elf"):
+        cmd = [str(baa), f"-{opt}", f"--assembler={assembler}", "--time-phases", "-c"]
+        cmd.extend([str(src_rel), "-o", str(out_dir / f"{stem}.{assembler}.o")])
+        emit_s: list[float] = []
+        asm_s: list[float] = []
+        for _ in range(max(1, runs)):
+            p = _run_capture(cmd, cwd=ROOT)
+            phases = _extract_compiler_stats(p.stderr).get("time_phases", {})
+            if p.returncode != 0 or "assemble" not in phases:
+                row[assembler] = {"error": p.stderr[-4000:]}
+                break
+            emit_s.append(float(phases.get("emit", 0.0)))
+            asm_s.append(float(phases["assemble"]))
+        if assembler not in row:
+            row[assembler] = {"emit_s": _median(emit_s), "assemble_s": _median(asm_s)}
+    return row
+
+
+REGALLOC_TOTAL_KEYS = ("spilled", "splits", "stores", "reloads", "moves", "cost", "copies_removed", "spill_removed")
+
+
+def _measure_regalloc(baa: Path, src_rel: Path, out_dir: Path, stem: str, opt: str, target: str | None) -> dict:
+    """Per-function spill/reload counts of both register allocators for one benchmark."""
+    row: dict = {}
+    for allocator in ("linear", "split"):
+        cmd = [str(baa), f"-{opt}", f"--regalloc={allocator}", "--regalloc-stats", "-S"]
+        if target:
+            cmd.append(f"--target={target}")
+        cmd.extend([str(src_rel), "-o", str(out_dir / f"{stem}.{allocator}.s")])
+        p = _run_capture(cmd, cwd=ROOT)
+        if p.returncode != 0:
+            row[allocator] = {"error": p.stderr[-4000:]}
+            continue
+        funcs: dict[str, dict[str, int]] = {}
+        for raw in p.stderr.splitlines():
+            m = REGALLOC_RE.match(raw)
+            if not m:
+                continue
+            kv = _parse_kv_tail(m.group(1))
+            funcs[kv.get("func", "?")] = {k: int(kv[k]) for k in REGALLOC_TOTAL_KEYS if k in kv}
+        totals = {k: sum(f.get(k, 0) for f in funcs.values()) for k in REGALLOC_TOTAL_KEYS}
+        row[allocator] = {"functions": funcs, "totals": totals}
+    return row
+
+
+def _measure_analysis(baa: Path, src_rel: Path, out_dir: Path, stem: str, opt: str, target: str | None) -> dict:
+    """Per-pass analysis cache hits/misses (--opt-stats) for one benchmark."""
+    cmd = [str(baa), f"-{opt}", "--opt-stats", "-S"]
+    if target:
+        cmd.append(f"--target={target}")
+    cmd.extend([str(src_rel), "-o", str(out_dir / f"{stem}.analysis.s")])
+    p = _run_capture(cmd, cwd=ROOT)
+    if p.returncode != 0:
+        return {"error": p.stderr[-4000:]}
+    passes: dict[str, dict[str, int]] = {}
+    for raw in p.stderr.splitlines():
+        m = ANALYSIS_RE.match(raw)
+        if not m:
+            continue
+        kv = _parse_kv_tail(m.group(1))
+        name = kv.pop("pass", "?")
+        passes[name] = {k: int(v) for k, v in kv.items()}
+    return {"passes": passes, "totals": passes.pop("total", {})}
+
+
+def _measure_optimizer(baa: Path, src_rel: Path, out_dir: Path, stem: str, opt: str, target: str | None) -> dict:
+    """Per-pass runs/changes/time and the round summary from --time-phases for one benchmark."""
+    cmd = [str(baa), f"-{opt}", "--time-phases", "-S"]
+    if target:
+        cmd.append(f"--target={target}")
+    cmd.extend([str(src_rel), "-o", str(out_dir / f"{stem}.optimizer.s")])
+    p = _run_capture(cmd, cwd=ROOT)
+    if p.returncode != 0:
+        return {"error": p.stderr[-4000:]}
+    passes: dict[str, dict[str, str]] = {}
+    summary: dict[str, str] = {}
+    for raw in p.stderr.splitlines():
+        m = OPT_PASS_RE.match(raw)
+        if m:
+            kv = _parse_kv_tail(m.group(1))
+            name = kv.pop("pass", "?")
+            passes[name] = kv
+            continue
+        m = OPT_SUMMARY_RE.match(raw)
+        if m:
+            summary = _parse_kv_tail(m.group(1))
+    stats = _extract_compiler_stats(p.stderr)
+    return {"passes": passes, "summary": summary, "opt_s": stats.get("time_phases", {}).get("opt")}
+
+
+def _ir_memops(text: str) -> dict[str, int]:
+    return {
+        "loads": len(IR_LOAD_RE.findall(text)),
+        "stores": len(IR_STORE_RE.findall(text)),
+        "allocas": len(IR_ALLOCA_RE.findall(text)),
+    }
+
+
+def _measure_memops(baa: Path, src_rel: Path, out_dir: Path, stem: str, opt: str, target: str | None) -> dict:
+    """Static loads/stores/allocas in the IR before and after optimization, with and without SROA/memopt."""
+    variants: list[tuple[str, list[str]]] = [("ir", ["-O0", "--dump-ir"]), ("opt", [f"-{opt}", "--dump-ir-opt"])]
+    if opt in NO_SROA_PIPELINE:
+        variants.append(("opt_no_sroa", [f"-{opt}", "--dump-ir-opt", f"--opt-pipeline={NO_SROA_PIPELINE[opt]}"]))
+    if opt in NO_MEMOPT_PIPELINE:
+        variants.append(("opt_no_memopt", [f"-{opt}", "--dump-ir-opt", f"--opt-pipeline={NO_MEMOPT_PIPELINE[opt]}"]))
+    row: dict = {}
+    for key, flags in variants:
+        cmd = [str(baa), *flags, "-S"]
+        if target:
+            cmd.append(f"--target={target}")
+        cmd.extend([str(src_rel), "-o", str(out_dir / f"{stem}.{key}.s")])
+        p = _run_capture(cmd, cwd=ROOT)
+        if p.returncode != 0:
+            return {"error": p.stderr[-4000:]}
+        row[key] = _ir_memops(p.stdout)
+    return row
+
+
 def main() -> int:
     ap = argparse.ArgumentParser(description="Baa benchmark runner")
-    ap.add_argument("--mode", choices=["all", "compile_s", "compile_exe", "runtime", "mem"], default="all")
+    ap.add_argument("--mode", choices=["all", "compile_s", "compile_exe", "runtime", "mem", "symbols", "scopes", "macros", "lex", "keywords", "textscan", "includes", "codesize", "regalloc", "regalloc_scaling", "assembler", "analysis", "optimizer", "memops", "threads"], default="all")
     ap.add_argument("--opt", nargs="+", default=["O2"], choices=["O0", "O1", "O2"])
     ap.add_argument("--runs", type=int, default=7)
     ap.add_argument("--compile-runs", type=int, default=5)
     ap.add_argument("--verify", action="store_true")
     ap.add_argument("--time-phases", action="store_true")
     ap.add_argument("--target", default=None)
+    ap.add_argument("--symbol-scales", nargs="+", type=int, default=[1000, 4000, 16000, 64000])
+    ap.add_argument("--scope-depths", nargs="+", type=int, default=[16, 64, 256, 1024])
+    ap.add_argument("--macro-counts", nargs="+", type=int, default=[1000, 4000, 16000])
+    ap.add_argument("--lex-funcs", nargs="+", type=int, default=[1000, 10000, 50000])
+    ap.add_argument("--keyword-iterations", type=int, default=20000)
+    ap.add_argument("--textscan-iterations", type=int, default=200)
+    ap.add_argument("--include-units", nargs="+", type=int, default=[10, 40, 160])
+    ap.add_argument("--regalloc-insts", nargs="+", type=int, default=[1000, 10000, 100000])
+    ap.add_argument("--thread-funcs", nargs="+", type=int, default=[500, 2000])
+    ap.add_argument("--thread-counts", nargs="+", type=int, default=[1, 2, 4, 8])
     args = ap.parse_args()
 
     baa = _find_baa()
@@ -251,6 +898,58 @@ def main() -> int:
     exe_ext = ".exe" if os.name == "nt" else ""
 
     try:
+        if args.mode == "symbols":
+            results["config"]["symbol_scales"] = args.symbol_scales
+            results["symbol_scaling"] = _bench_symbol_scaling(
+                baa, out_dir, args.symbol_scales, args.compile_runs
+            )
+            bench_files = []
+        elif args.mode == "scopes":
+            results["config"]["scope_depths"] = args.scope_depths
+            results["scope_depth"] = _bench_scope_depth(
+                baa, out_dir, args.scope_depths, args.compile_runs
+            )
+            bench_files = []
+        elif args.mode == "macros":
+            results["config"]["macro_counts"] = args.macro_counts
+            results["macro_header"] = _bench_macro_header(
+                baa, out_dir, args.macro_counts, args.compile_runs
+            )
+            bench_files = []
+        elif args.mode == "lex":
+            results["config"]["lex_funcs"] = args.lex_funcs
+            results["lex_throughput"] = _bench_lex_throughput(
+                baa, out_dir, args.lex_funcs, args.compile_runs
+            )
+            bench_files = []
+        elif args.mode == "keywords":
+            results["config"]["keyword_iterations"] = args.keyword_iterations
+            results["keyword_classify"] = _bench_keyword_classify(out_dir, args.keyword_iterations)
+            bench_files = []
+        elif args.mode == "textscan":
+            results["config"]["textscan_iterations"] = args.textscan_iterations
+            results["text_scan"] = _bench_text_scan(out_dir, args.textscan_iterations)
+            bench_files = []
+        elif args.mode == "includes":
+            results["config"]["include_units"] = args.include_units
+            results["shared_includes"] = _bench_shared_includes(
+                baa, out_dir, args.include_units, args.compile_runs
+            )
+            bench_files = []
+        elif args.mode == "regalloc_scaling":
+            results["config"]["regalloc_insts"] = args.regalloc_insts
+            results["regalloc_scaling"] = _bench_regalloc_scaling(
+                baa, out_dir, args.regalloc_insts, args.compile_runs
+            )
+            bench_files = []
+        elif args.mode == "threads":
+            results["config"]["thread_funcs"] = args.thread_funcs
+            results["config"]["thread_counts"] = args.thread_counts
+            results["threads"] = _bench_threads(
+                baa, out_dir, args.thread_funcs, args.thread_counts, args.compile_runs
+            )
+            bench_files = []
+
         for src in bench_files:
             kind = _classify(src)
             if kind == "unknown":
@@ -302,6 +1001,75 @@ def main() -> int:
                         if last_stats:
                             metrics["compile_s_compiler_stats"] = last_stats
 
+                if args.mode == "codesize":
+                    size = _measure_code_size(baa, src_rel, out_dir, f"{name}.{opt}", opt, args.target)
+                    metrics["code_size"] = size
+                    if "error" not in size:
+                        print(
+                            f"codesize {name} {opt}: text={size['text_bytes']} bytes "
+                            f"jmp={size['jmp']} jcc={size['jcc']}"
+                        )
+
+                if args.mode == "regalloc":
+                    ra = _measure_regalloc(baa, src_rel, out_dir, f"{name}.{opt}", opt, args.target)
+                    metrics["regalloc"] = ra
+                    for allocator, data in ra.items():
+                        if "totals" in data:
+                            t = data["totals"]
+                            print(
+                                f"regalloc {name} {opt} {allocator}: spilled={t['spilled']} "
+                                f"stores={t['stores']} reloads={t['reloads']} moves={t['moves']} cost={t['cost']}"
+                            )
+
+                if args.mode == "analysis":
+                    an = _measure_analysis(baa, src_rel, out_dir, f"{name}.{opt}", opt, args.target)
+                    metrics["analysis"] = an
+                    t = an.get("totals")
+                    if t:
+                        # كل طلب كان يعيد الحساب قبل الكاش: hit+miss هو عدد الحسابات القديم.
+                        print(
+                            f"analysis {name} {opt}: "
+                            + " ".join(
+                                f"{k}={t[k + '_miss']}/{t[k + '_hit'] + t[k + '_miss']}"
+                                for k in ("preds", "dom", "loops")
+                            )
+                        )
+
+                if args.mode == "optimizer":
+                    om = _measure_optimizer(baa, src_rel, out_dir, f"{name}.{opt}", opt, args.target)
+                    metrics["optimizer"] = om
+                    s = om.get("summary")
+                    if s:
+                        print(
+                            f"optimizer {name} {opt}: funcs={s.get('funcs')} rounds={s.get('rounds')} "
+                            f"max_rounds={s.get('max_rounds')} capped={s.get('capped')} opt={om.get('opt_s')}s"
+                        )
+
+                if args.mode == "memops":
+                    mo = _measure_memops(baa, src_rel, out_dir, f"{name}.{opt}", opt, args.target)
+                    metrics["memops"] = mo
+                    if "error" not in mo:
+                        line = f"memops {name} {opt}: " + " ".join(
+                            f"{k}={mo['ir'][k]}->{mo['opt'][k]}" for k in ("loads", "stores", "allocas")
+                        )
+                        if "opt_no_sroa" in mo:
+                            n = mo["opt_no_sroa"]
+                            line += f" (no sroa: loads={n['loads']} stores={n['stores']} allocas={n['allocas']})"
+                        if "opt_no_memopt" in mo:
+                            n = mo["opt_no_memopt"]
+                            line += f" (no memopt: loads={n['loads']} stores={n['stores']})"
+                        print(line)
+
+                if args.mode == "assembler":
+                    am = _measure_assembler(baa, src_rel, out_dir, f"{name}.{opt}", opt, args.compile_runs)
+                    metrics["assembler"] = am
+                    for assembler, data in am.items():
+                        if "error" not in data:
+                            print(
+                                f"assembler {name} {opt} {assembler}: emit={data['emit_s']:.6f}s "
+                                f"assemble={data['assemble_s']:.6f}s"
+                            )
+
                 if args.mode in ("all", "compile_exe") and kind in ("runtime", "compile"):
                     exe_out = out_dir / f"{name}.{opt}{exe_ext}"
                     cmd = _compile_cmd(
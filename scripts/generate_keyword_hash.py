@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Generate the perfect-hash tables for Baa keyword and directive recognition.
+
+The keyword and directive lists stay owned by src/frontend/language_profile.c;
+this script reads them from there and emits src/frontend/language_keyword_hash.inc,
+which maps a seeded FNV-1a hash of a word to at most one candidate entry.
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+DEFAULT_PROFILE = ROOT / "src" / "frontend" / "language_profile.c"
+DEFAULT_OUTPUT = ROOT / "src" / "frontend" / "language_keyword_hash.inc"
+
+KEYWORD_RE = re.compile(r'^\s*\{"([^"]+)",\s*(TOKEN_[A-Z0-9_]+),\s*"[^"]*",\s*"[^"]*",\s*(true|false)\},?\s*$')
+DIRECTIVE_RE = re.compile(r'^\s*\{"#([^"]+)",\s*"directive",')
+MAX_SEED_ATTEMPTS = 1_000_000
+
+
+def fnv1a_seeded(data: bytes, seed: int) -> int:
+    h = (2166136261 ^ seed) & 0xFFFFFFFF
+    for b in data:
+        h ^= b
+        h = (h * 16777619) & 0xFFFFFFFF
+    return (h ^ (h >> 15)) & 0xFFFFFFFF
+
+
+def _table_block(text: str, name: str) -> list[str]:
+    start = text.find(f"{name}[] = {{")
+    if start < 0:
+        raise ValueError(f"cannot find {name} in language profile")
+    end = text.find("};", start)
+    return text[start:end].splitlines()[1:]
+
+
+def read_profile(profile: Path) -> tuple[list[tuple[int, str]], list[tuple[int, str]]]:
+    """Return (index, label) pairs for lexical keywords and for directives (without '#')."""
+    text = profile.read_text(encoding="utf-8")
+    keywords: list[tuple[int, str]] = []
+    index = 0
+    for line in _table_block(text, "g_keywords"):
+        m = KEYWORD_RE.match(line)
+        if not m:
+            continue
+        if m.group(3) == "true":
+            keywords.append((index, m.group(1)))
+        index += 1
+    directives: list[tuple[int, str]] = []
+    index = 0
+    for line in _table_block(text, "g_directives"):
+        m = DIRECTIVE_RE.match(line)
+        if not m:
+            continue
+        directives.append((index, m.group(1)))
+        index += 1
+    if not keywords or not directives:
+        raise ValueError("language profile tables are empty or unparseable")
+    return keywords, directives
+
+
+def find_perfect_hash(entries: list[tuple[int, str]]) -> tuple[int, int, list[int]]:
+    """Smallest power-of-two table (>= 2x entries) and first seed with no collisions."""
+    labels = [label for _, label in entries]
+    if len(set(labels)) != len(labels):
+        raise ValueError("duplicate labels cannot share a perfect hash")
+    size = 1
+    while size < 2 * len(entries):
+        size *= 2
+    while True:
+        for seed in range(MAX_SEED_ATTEMPTS):
+            slots = [-1] * size
+            for index, label in entries:
+                slot = fnv1a_seeded(label.encode("utf-8"), seed) & (size - 1)
+                if slots[slot] >= 0:
+                    break
+                slots[slot] = index
+            else:
+                return seed, size, slots
+        size *= 2
+
+
+def _emit_table(name: str, seed_macro: str, size_macro: str, seed: int, size: int, slots: list[int]) -> list[str]:
+    lines = [
+        f"#define {seed_macro} 0x{seed:08X}u",
+        f"#define {size_macro} {size}u",
+        f"static const signed char {name}[{size_macro}] = {{",
+    ]
+    for row in range(0, size, 16):
+        lines.append("    " + ", ".join(f"{v:2d}" for v in slots[row:row + 16]) + ",")
+    lines.append("};")
+    return lines
+
+
+def generate(profile: Path) -> str:
+    keywords, directives = read_profile(profile)
+    kw_seed, kw_size, kw_slots = find_perfect_hash(keywords)
+    dir_seed, dir_size, dir_slots = find_perfect_hash(directives)
+    lines = [
+        "// مولّد بواسطة scripts/generate_keyword_hash.py من جداول language_profile.c — لا تعدّله يدوياً.",
+        "// كل خانة تحمل فهرس المدخل الوحيد المرشح في الجدول الأصلي أو -1.",
+        "",
+    ]
+    lines += _emit_table("g_keyword_hash_slots", "BAA_KEYWORD_HASH_SEED", "BAA_KEYWORD_HASH_SIZE",
+                         kw_seed, kw_size, kw_slots)
+    lines.append("")
+    lines += _emit_table("g_directive_hash_slots", "BAA_DIRECTIVE_HASH_SEED", "BAA_DIRECTIVE_HASH_SIZE",
+                         dir_seed, dir_size, dir_slots)
+    return "\n".join(lines) + "\n"
+
+
+def _parse_args(argv: list[str]) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--profile", type=Path, default=DEFAULT_PROFILE)
+    parser.add_argument("--output", type=Path, default=DEFAULT_OUTPUT)
+    parser.add_argument(
+        "--check",
+        action="store_true",
+        help="Verify that --output already contains the generated tables.",
+    )
+    return parser.parse_args(argv)
+
+
+def main(argv: list[str] | None = None) -> int:
+    args = _parse_args(argv if argv is not None else sys.argv[1:])
+    try:
+        generated = generate(args.profile.resolve())
+    except (OSError, ValueError) as exc:
+        print(f"error: {exc}", file=sys.stderr)
+        return 2
+
+    output = args.output.resolve()
+    if args.check:
+        try:
+            current = output.read_text(encoding="utf-8")
+        except OSError as exc:
+            print(f"error: cannot read keyword hash tables {output}: {exc}", file=sys.stderr)
+            return 1
+        if current != generated:
+            print(
+                "error: keyword hash tables are stale; regenerate them without --check",
+                file=sys.stderr,
+            )
+            return 1
+        print(f"verified {output}")
+        return 0
+
+    output.write_text(generated, encoding="utf-8", newline="\n")
+    print(f"wrote {output}")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
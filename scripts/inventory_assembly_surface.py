@@ -302,6 +302,7 @@ def _compile_target(compiler: Path, target: str, sources: list[Path], directory:
                 f"--target={target}",
                 "-S",
                 "--assembler=gas",
+                "-fno-branch-fusion",
                 str(source),
                 "-o",
                 str(output),
@@ -588,6 +588,16 @@ def _run_one_definition_tests(log_dir: Path) -> StepResult:
     )
 
 
+def _run_parallel_jobs_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "parallel-jobs-tests",
+        [sys.executable, str(TESTS_DIR / "test_parallel_jobs.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=120.0,
+    )
+
+
 def _run_header_self_check_tests(log_dir: Path) -> StepResult:
     return _run_logged(
         "header-self-check-tests",
@@ -638,6 +648,186 @@ def _run_tokens_json_tests(log_dir: Path) -> StepResult:
     )
 
 
+def _run_keyword_hash_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "keyword-hash-tests",
+        [sys.executable, str(TESTS_DIR / "test_keyword_hash.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=120.0,
+    )
+
+
+def _run_ast_arena_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "ast-arena-tests",
+        [sys.executable, str(TESTS_DIR / "test_ast_arena.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=120.0,
+    )
+
+
+def _run_text_scan_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "text-scan-tests",
+        [sys.executable, str(TESTS_DIR / "test_text_scan.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_source_cache_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "source-cache-tests",
+        [sys.executable, str(TESTS_DIR / "test_source_cache.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_fused_compare_branch_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "fused-compare-branch-tests",
+        [sys.executable, str(TESTS_DIR / "test_fused_compare_branch.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_block_layout_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "block-layout-tests",
+        [sys.executable, str(TESTS_DIR / "test_block_layout.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_analysis_manager_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "analysis-manager-tests",
+        [sys.executable, str(TESTS_DIR / "test_analysis_manager.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_optimizer_worklist_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "optimizer-worklist-tests",
+        [sys.executable, str(TESTS_DIR / "test_optimizer_worklist.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_parallel_functions_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "parallel-functions-tests",
+        [sys.executable, str(TESTS_DIR / "test_parallel_functions.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_sroa_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "sroa-tests",
+        [sys.executable, str(TESTS_DIR / "test_sroa.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_memopt_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "memopt-tests",
+        [sys.executable, str(TESTS_DIR / "test_memopt.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_regalloc_split_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "regalloc-split-tests",
+        [sys.executable, str(TESTS_DIR / "test_regalloc_split.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_regalloc_coalesce_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "regalloc-coalesce-tests",
+        [sys.executable, str(TESTS_DIR / "test_regalloc_coalesce.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_regalloc_scaling_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "regalloc-scaling-tests",
+        [sys.executable, str(TESTS_DIR / "test_regalloc_scaling.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=300.0,
+    )
+
+
+def _run_elf_writer_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "elf-writer-tests",
+        [sys.executable, str(TESTS_DIR / "test_elf_writer.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_emit_buffer_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "emit-buffer-tests",
+        [sys.executable, str(TESTS_DIR / "test_emit_buffer.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_assemble_pipeline_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "assemble-pipeline-tests",
+        [sys.executable, str(TESTS_DIR / "test_assemble_pipeline.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
+def _run_switch_lowering_tests(log_dir: Path) -> StepResult:
+    return _run_logged(
+        "switch-lowering-tests",
+        [sys.executable, str(TESTS_DIR / "test_switch_lowering.py")],
+        cwd=ROOT,
+        log_dir=log_dir,
+        timeout_s=180.0,
+    )
+
+
 def _run_structure_json_tests(log_dir: Path) -> StepResult:
     return _run_logged(
         "structure-json-tests",
@@ -1021,6 +1211,11 @@ def main() -> int:
     all_results.append(one_definition_res)
     overall_ok = overall_ok and one_definition_res.passed
 
+    parallel_jobs_res = _run_parallel_jobs_tests(log_dir)
+    _print_step(parallel_jobs_res)
+    all_results.append(parallel_jobs_res)
+    overall_ok = overall_ok and parallel_jobs_res.passed
+
     header_self_check_res = _run_header_self_check_tests(log_dir)
     _print_step(header_self_check_res)
     all_results.append(header_self_check_res)
@@ -1046,6 +1241,96 @@ def main() -> int:
     all_results.append(tokens_json_res)
     overall_ok = overall_ok and tokens_json_res.passed
 
+    keyword_hash_res = _run_keyword_hash_tests(log_dir)
+    _print_step(keyword_hash_res)
+    all_results.append(keyword_hash_res)
+    overall_ok = overall_ok and keyword_hash_res.passed
+
+    ast_arena_res = _run_ast_arena_tests(log_dir)
+    _print_step(ast_arena_res)
+    all_results.append(ast_arena_res)
+    overall_ok = overall_ok and ast_arena_res.passed
+
+    text_scan_res = _run_text_scan_tests(log_dir)
+    _print_step(text_scan_res)
+    all_results.append(text_scan_res)
+    overall_ok = overall_ok and text_scan_res.passed
+
+    source_cache_res = _run_source_cache_tests(log_dir)
+    _print_step(source_cache_res)
+    all_results.append(source_cache_res)
+    overall_ok = overall_ok and source_cache_res.passed
+
+    fused_branch_res = _run_fused_compare_branch_tests(log_dir)
+    _print_step(fused_branch_res)
+    all_results.append(fused_branch_res)
+    overall_ok = overall_ok and fused_branch_res.passed
+
+    block_layout_res = _run_block_layout_tests(log_dir)
+    _print_step(block_layout_res)
+    all_results.append(block_layout_res)
+    overall_ok = overall_ok and block_layout_res.passed
+
+    switch_lowering_res = _run_switch_lowering_tests(log_dir)
+    _print_step(switch_lowering_res)
+    all_results.append(switch_lowering_res)
+    overall_ok = overall_ok and switch_lowering_res.passed
+
+    analysis_manager_res = _run_analysis_manager_tests(log_dir)
+    _print_step(analysis_manager_res)
+    all_results.append(analysis_manager_res)
+    overall_ok = overall_ok and analysis_manager_res.passed
+
+    optimizer_worklist_res = _run_optimizer_worklist_tests(log_dir)
+    _print_step(optimizer_worklist_res)
+    all_results.append(optimizer_worklist_res)
+    overall_ok = overall_ok and optimizer_worklist_res.passed
+
+    parallel_functions_res = _run_parallel_functions_tests(log_dir)
+    _print_step(parallel_functions_res)
+    all_results.append(parallel_functions_res)
+    overall_ok = overall_ok and parallel_functions_res.passed
+
+    sroa_res = _run_sroa_tests(log_dir)
+    _print_step(sroa_res)
+    all_results.append(sroa_res)
+    overall_ok = overall_ok and sroa_res.passed
+
+    memopt_res = _run_memopt_tests(log_dir)
+    _print_step(memopt_res)
+    all_results.append(memopt_res)
+    overall_ok = overall_ok and memopt_res.passed
+
+    regalloc_split_res = _run_regalloc_split_tests(log_dir)
+    _print_step(regalloc_split_res)
+    all_results.append(regalloc_split_res)
+    overall_ok = overall_ok and regalloc_split_res.passed
+
+    regalloc_coalesce_res = _run_regalloc_coalesce_tests(log_dir)
+    _print_step(regalloc_coalesce_res)
+    all_results.append(regalloc_coalesce_res)
+    overall_ok = overall_ok and regalloc_coalesce_res.passed
+
+    regalloc_scaling_res = _run_regalloc_scaling_tests(log_dir)
+    _print_step(regalloc_scaling_res)
+    all_results.append(regalloc_scaling_res)
+    overall_ok = overall_ok and regalloc_scaling_res.passed
+
+    elf_writer_res = _run_elf_writer_tests(log_dir)
+    _print_step(elf_writer_res)
+    all_results.append(elf_writer_res)
+    overall_ok = overall_ok and elf_writer_res.passed
+
+    emit_buffer_res = _run_emit_buffer_tests(log_dir)
+    _print_step(emit_buffer_res)
+    all_results.append(emit_buffer_res)
+    overall_ok = overall_ok and emit_buffer_res.passed
+
+    assemble_pipeline_res = _run_assemble_pipeline_tests(log_dir)
+    _print_step(assemble_pipeline_res)
+    all_results.append(assemble_pipeline_res)
+    overall_ok = overall_ok and assemble_pipeline_res.passed
+
     structure_json_res = _run_structure_json_tests(log_dir)
     _print_step(structure_json_res)
     all_results.append(structure_json_res)
@@ -1113,6 +1398,19 @@ def main() -> int:
     all_results.append(test_res)
     overall_ok = overall_ok and test_res.passed
 
+    if os.name != "nt":
+        elf_test_res = _run_logged(
+            "tests/test.py (--assembler=elf)",
+            [sys.executable, str(TESTS_DIR / "test.py")],
+            cwd=ROOT,
+            log_dir=log_dir,
+            timeout_s=300.0,
+            env={**os.environ, "BAA_TEST_ASSEMBLER": "elf"},
+        )
+        _print_step(elf_test_res)
+        all_results.append(elf_test_res)
+        overall_ok = overall_ok and elf_test_res.passed
+
     if args.mode in ("full", "stress", "release"):
         regress_res = _run_logged(
             "tests/regress.py",
@@ -159,6 +159,26 @@ def _compare_output_file(name: str, cmd: list[str], out_file: Path) -> CheckResu
     return _result(name, started, True, "stable output file")
 
 
+def _compare_thread_counts(name: str, cmd: list[str], out_file: Path, threads: int = 4) -> CheckResult:
+    """--threads=1 و--threads=N يجب أن ينتجا الملف نفسه بايتاً ببايت."""
+    started = time.monotonic()
+    outputs: list[bytes] = []
+    for count in (1, threads):
+        out_file.unlink(missing_ok=True)
+        p = _run([*cmd, f"--threads={count}"])
+        err = _expect_success(f"{name}: --threads={count}", p)
+        if err:
+            return _result(name, started, False, err)
+        try:
+            outputs.append(out_file.read_bytes())
+        except OSError as exc:
+            return _result(name, started, False, f"could not read --threads={count} output: {exc}")
+
+    if outputs[0] != outputs[1]:
+        return _result(name, started, False, f"output differed between --threads=1 and --threads={threads}")
+    return _result(name, started, True, f"identical output with --threads=1 and --threads={threads}")
+
+
 def _check_manifest(baa: Path, out_dir: Path) -> list[CheckResult]:
     manifest = out_dir / "manifest.json"
     output = out_dir / ("determinism_app.exe" if os.name == "nt" else "determinism_app")
@@ -328,6 +348,15 @@ def run_checks(baa: Path, out_dir: Path) -> list[CheckResult]:
             asm_output,
         )
     )
+    for assembler in ("nazm", "gas"):
+        threaded_output = out_dir / f"threaded_ir_test_{assembler}.s"
+        results.append(
+            _compare_thread_counts(
+                f"threaded-assembly:{assembler}",
+                [str(baa), "-O2", "--verify", "-S", f"--assembler={assembler}", ir_src, "-o", str(threaded_output)],
+                threaded_output,
+            )
+        )
     results.extend(_check_cross_target_assembly(baa, out_dir))
     results.extend(_check_manifest(baa, out_dir))
     results.append(_check_verifier_gate(baa, out_dir))
@@ -11,6 +11,7 @@
 #include "support/target_contract.h"
 #include "support/read_file.h"
 #include "support/diagnostics.h"
+#include "support/session.h"
 #include "support/updater.h"
 #include "frontend/lexer.h"
 #include "frontend/ast.h"
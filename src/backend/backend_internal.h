@@ -15,9 +15,13 @@
 
 #include "code_model.h"
 #include "emit.h"
+#include "emit_buf.h"
 #include "isel.h"
 #include "regalloc.h"
 #include "target.h"
+#include "../middleend/ir_defuse.h"
 #include "../middleend/ir_loop.h"
+#include "../middleend/ir_switch.h"
+#include "../support/session.h"
 
 #endif
@@ -0,0 +1,536 @@
+/**
+ * @file block_layout.c
+ * @brief ترتيب الكتل الآلية وحذف القفزات الزائدة.
+ *
+ * يُصدر اختيار التعليمات كل كتلة بترتيب IR وينهيها بقفز صريح (`jcc T; jmp F`
+ * أو `jmp T`) أياً كانت الكتلة التالية. هذا التمرير:
+ * 1. يحسب عمق الحلقة لكل كتلة من الحواف الخلفية (حلقات طبيعية).
+ * 2. يبني ترتيباً عكسياً لاحقاً (RPO) يزور مخارج الحلقة قبل جسمها، فيبقى الجسم
+ *    متجاوراً بعد الرأس.
+ * 3. يرتب الكتل بسلاسل جشعة: يُفضَّل الخلف الأعمق حلقةً الذي وُضع كل أسلافه
+ *    الأماميين، وإلا أول كتلة غير موضوعة في RPO.
+ * 4. يعكس شرط القفز حين يكون هدفه هو الكتلة التالية، ويحذف القفز إليها.
+ *
+ * يعمل بعد تخصيص السجلات، فلا يمس إلا تعليمات القفز.
+ */
+
+#include "backend_internal.h"
+#include "block_layout.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    MachineFunc* func;
+    MachineBlock** blocks;  // الكتل بترتيبها الأصلي
+    int count;
+
+    int* index_of_id;       // معرف الكتلة → فهرسها، أو -1
+    int id_limit;
+
+    int* succ_start;        // خلفاء بصيغة CSR (السعة حد أعلى: قفزات + مدخلات جداول)
+    int* succs;
+    bool* back;             // هل الحافة المقابلة في succs خلفية؟
+    int* succ_count;
+
+    int* pred_start;        // أسلاف بصيغة CSR
+    int* preds;
+
+    int* depth;             // عمق الحلقة
+    int* pending;           // أسلاف أماميون لم يوضعوا بعد
+    int* rpo;
+    int rpo_count;
+
+    int* order;             // الترتيب الناتج
+    int order_count;
+    bool* placed;
+    int pinned;             // كتلة يجب أن تبقى أخيرة (تسقط إلى الخاتمة الافتراضية)، أو -1
+
+    int* stack;             // مكدس DFS وقوائم العمل
+    int* mark;
+} LayoutCtx;
+
+static void layout_ctx_free(LayoutCtx* ctx)
+{
+    free(ctx->blocks);
+    free(ctx->index_of_id);
+    free(ctx->succ_start);
+    free(ctx->succs);
+    free(ctx->back);
+    free(ctx->succ_count);
+    free(ctx->pred_start);
+    free(ctx->preds);
+    free(ctx->depth);
+    free(ctx->pending);
+    free(ctx->rpo);
+    free(ctx->order);
+    free(ctx->placed);
+    free(ctx->stack);
+    free(ctx->mark);
+}
+
+// ============================================================================
+// تعليمات القفز (Jump Helpers)
+// ============================================================================
+
+static bool layout_is_jcc(MachineOp op)
+{
+    return op >= MACH_JE && op <= MACH_JNP;
+}
+
+static bool layout_is_jump(const MachineInst* inst)
+{
+    return inst && (inst->op == MACH_JMP || layout_is_jcc(inst->op)) &&
+           inst->dst.kind == MACH_OP_LABEL;
+}
+
+static MachineOp layout_invert_jcc(MachineOp op)
+{
+    switch (op) {
+        case MACH_JE:  return MACH_JNE;
+        case MACH_JNE: return MACH_JE;
+        case MACH_JG:  return MACH_JLE;
+        case MACH_JLE: return MACH_JG;
+        case MACH_JL:  return MACH_JGE;
+        case MACH_JGE: return MACH_JL;
+        case MACH_JA:  return MACH_JBE;
+        case MACH_JBE: return MACH_JA;
+        case MACH_JB:  return MACH_JAE;
+        case MACH_JAE: return MACH_JB;
+        case MACH_JP:  return MACH_JNP;
+        case MACH_JNP: return MACH_JP;
+        default:       return MACH_OP_COUNT;
+    }
+}
+
+static MachineInst* layout_prev_real(MachineInst* inst)
+{
+    while (inst && inst->op == MACH_COMMENT) inst = inst->prev;
+    return inst;
+}
+
+static MachineInst* layout_last_real(MachineBlock* block)
+{
+    return layout_prev_real(block->last);
+}
+
+static bool layout_ends_with_transfer(MachineBlock* block)
+{
+    MachineInst* last = layout_last_real(block);
+    return last && (last->op == MACH_JMP || last->op == MACH_RET || last->op == MACH_TAILJMP ||
+                    last->op == MACH_JMP_TABLE);
+}
+
+static void layout_remove_inst(MachineBlock* block, MachineInst* inst)
+{
+    if (inst->prev) inst->prev->next = inst->next;
+    else block->first = inst->next;
+    if (inst->next) inst->next->prev = inst->prev;
+    else block->last = inst->prev;
+    block->inst_count--;
+    inst->prev = NULL;
+    inst->next = NULL;
+    mach_inst_free(inst);
+}
+
+// ============================================================================
+// بناء الرسم (CFG)
+// ============================================================================
+
+static bool layout_ctx_init(LayoutCtx* ctx, MachineFunc* func)
+{
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->func = func;
+    ctx->pinned = -1;
+
+    int max_id = -1;
+    for (MachineBlock* b = func->blocks; b; b = b->next) {
+        ctx->count++;
+        if (b->id > max_id) max_id = b->id;
+    }
+    if (max_id < 0) return false;
+
+    const size_t n = (size_t)ctx->count;
+    ctx->id_limit = max_id + 1;
+    ctx->blocks = (MachineBlock**)malloc(n * sizeof(MachineBlock*));
+    ctx->index_of_id = (int*)malloc((size_t)ctx->id_limit * sizeof(int));
+    ctx->succ_start = (int*)calloc(n + 1, sizeof(int));
+    ctx->succ_count = (int*)calloc(n, sizeof(int));
+    ctx->pred_start = (int*)calloc(n + 1, sizeof(int));
+    ctx->depth = (int*)calloc(n, sizeof(int));
+    ctx->pending = (int*)calloc(n, sizeof(int));
+    ctx->rpo = (int*)malloc(n * sizeof(int));
+    ctx->order = (int*)malloc(n * sizeof(int));
+    ctx->placed = (bool*)calloc(n, sizeof(bool));
+    ctx->stack = (int*)malloc(2 * n * sizeof(int));
+    ctx->mark = (int*)calloc(n, sizeof(int));
+    if (!ctx->blocks || !ctx->index_of_id || !ctx->succ_start || !ctx->succ_count ||
+        !ctx->pred_start || !ctx->depth || !ctx->pending || !ctx->rpo ||
+        !ctx->order || !ctx->placed || !ctx->stack || !ctx->mark) {
+        return false;
+    }
+
+    for (int i = 0; i < ctx->id_limit; i++) ctx->index_of_id[i] = -1;
+    int i = 0;
+    for (MachineBlock* b = func->blocks; b; b = b->next, i++) {
+        ctx->blocks[i] = b;
+        if (b->id >= 0) ctx->index_of_id[b->id] = i;
+    }
+    return true;
+}
+
+static int layout_block_index(const LayoutCtx* ctx, int id)
+{
+    if (id < 0 || id >= ctx->id_limit) return -1;
+    return ctx->index_of_id[id];
+}
+
+/**
+ * @brief جدول القفز الذي تستخدمه التعليمة، أو NULL.
+ */
+static const MachineJumpTable* layout_jump_table(const LayoutCtx* ctx, const MachineInst* inst)
+{
+    if (!inst || inst->op != MACH_JMP_TABLE || inst->src2.kind != MACH_OP_IMM) return NULL;
+    int64_t t = inst->src2.data.imm;
+    if (t < 0 || t >= ctx->func->jump_table_count) return NULL;
+    return &ctx->func->jump_tables[t];
+}
+
+/**
+ * @brief إضافة خلف للكتلة b إن لم يكن موجوداً؛ false إن كان الهدف مجهولاً.
+ */
+static bool layout_add_succ(LayoutCtx* ctx, int b, int id)
+{
+    int t = layout_block_index(ctx, id);
+    if (t < 0) return false;
+    int* out = &ctx->succs[ctx->succ_start[b]];
+    for (int k = 0; k < ctx->succ_count[b]; k++) {
+        if (out[k] == t) return true;
+    }
+    out[ctx->succ_count[b]++] = t;
+    return true;
+}
+
+/**
+ * @brief جمع أهداف القفز لكل كتلة (ومدخلات جداول القفز)؛ false إن ظهر هدف
+ * مجهول أو فشل الحجز.
+ */
+static bool layout_collect_edges(LayoutCtx* ctx)
+{
+    for (int b = 0; b < ctx->count; b++) {
+        int cap = 0;
+        for (MachineInst* inst = ctx->blocks[b]->first; inst; inst = inst->next) {
+            const MachineJumpTable* jt = layout_jump_table(ctx, inst);
+            if (layout_is_jump(inst)) cap++;
+            else if (jt) cap += jt->count;
+            else if (inst->op == MACH_JMP_TABLE) return false;
+        }
+        ctx->succ_start[b + 1] = ctx->succ_start[b] + cap;
+    }
+    const size_t edges = (size_t)ctx->succ_start[ctx->count];
+    ctx->succs = (int*)malloc((edges ? edges : 1) * sizeof(int));
+    ctx->back = (bool*)calloc(edges ? edges : 1, sizeof(bool));
+    ctx->preds = (int*)malloc((edges ? edges : 1) * sizeof(int));
+    if (!ctx->succs || !ctx->back || !ctx->preds) return false;
+
+    for (int b = 0; b < ctx->count; b++) {
+        for (MachineInst* inst = ctx->blocks[b]->first; inst; inst = inst->next) {
+            if (layout_is_jump(inst)) {
+                if (!layout_add_succ(ctx, b, inst->dst.data.label_id)) return false;
+                continue;
+            }
+            const MachineJumpTable* jt = layout_jump_table(ctx, inst);
+            for (int k = 0; jt && k < jt->count; k++) {
+                if (!layout_add_succ(ctx, b, jt->label_ids[k])) return false;
+            }
+        }
+    }
+
+    for (int b = 0; b < ctx->count; b++) {
+        for (int k = 0; k < ctx->succ_count[b]; k++) {
+            ctx->pred_start[ctx->succs[ctx->succ_start[b] + k] + 1]++;
+        }
+    }
+    for (int b = 0; b < ctx->count; b++) ctx->pred_start[b + 1] += ctx->pred_start[b];
+    int* fill = ctx->mark;  // يُعاد تصفيره أدناه
+    for (int b = 0; b < ctx->count; b++) fill[b] = ctx->pred_start[b];
+    for (int b = 0; b < ctx->count; b++) {
+        for (int k = 0; k < ctx->succ_count[b]; k++) {
+            int s = ctx->succs[ctx->succ_start[b] + k];
+            ctx->preds[fill[s]++] = b;
+        }
+    }
+    memset(ctx->mark, 0, (size_t)ctx->count * sizeof(int));
+    return true;
+}
+
+// ============================================================================
+// الحلقات و RPO (Loops and Reverse Post-Order)
+// ============================================================================
+
+/**
+ * @brief DFS تكراري من كتلة الدخول؛ يضع في rpo الترتيب العكسي اللاحق،
+ * ويعلّم الحواف الخلفية إن طُلب ذلك.
+ */
+static void layout_dfs(LayoutCtx* ctx, bool mark_back)
+{
+    // mark: 0 = لم يُزر، 1 = على المكدس، 2 = انتهى.
+    memset(ctx->mark, 0, (size_t)ctx->count * sizeof(int));
+    int post = ctx->count;
+    int sp = 0;
+    ctx->stack[sp++] = 0;
+    ctx->stack[sp++] = 0;
+    ctx->mark[0] = 1;
+    while (sp > 0) {
+        int b = ctx->stack[sp - 2];
+        int k = ctx->stack[sp - 1];
+        if (k < ctx->succ_count[b]) {
+            ctx->stack[sp - 1] = k + 1;
+            int s = ctx->succs[ctx->succ_start[b] + k];
+            if (ctx->mark[s] == 0) {
+                ctx->mark[s] = 1;
+                ctx->stack[sp++] = s;
+                ctx->stack[sp++] = 0;
+            } else if (ctx->mark[s] == 1 && mark_back) {
+                ctx->back[ctx->succ_start[b] + k] = true;
+            }
+            continue;
+        }
+        ctx->mark[b] = 2;
+        ctx->rpo[--post] = b;
+        sp -= 2;
+    }
+    // إزاحة الكتل المزورة إلى بداية rpo.
+    ctx->rpo_count = ctx->count - post;
+    memmove(ctx->rpo, ctx->rpo + post, (size_t)ctx->rpo_count * sizeof(int));
+}
+
+/**
+ * @brief عمق الحلقة: كل كتلة في الحلقة الطبيعية لرأس ما تزيد عمقها بواحد.
+ */
+static void layout_compute_depth(LayoutCtx* ctx)
+{
+    memset(ctx->mark, 0, (size_t)ctx->count * sizeof(int));
+    for (int h = 0; h < ctx->count; h++) {
+        int top = 0;
+        for (int p = ctx->pred_start[h]; p < ctx->pred_start[h + 1]; p++) {
+            int u = ctx->preds[p];
+            for (int k = 0; k < ctx->succ_count[u]; k++) {
+                if (ctx->succs[ctx->succ_start[u] + k] == h && ctx->back[ctx->succ_start[u] + k] &&
+                    ctx->mark[u] != h + 1) {
+                    ctx->mark[u] = h + 1;
+                    ctx->stack[top++] = u;
+                }
+            }
+        }
+        if (top == 0) continue;
+        ctx->mark[h] = h + 1;
+        ctx->depth[h]++;
+        while (top > 0) {
+            int b = ctx->stack[--top];
+            if (b == h) continue;
+            ctx->depth[b]++;
+            for (int p = ctx->pred_start[b]; p < ctx->pred_start[b + 1]; p++) {
+                int q = ctx->preds[p];
+                if (ctx->mark[q] == h + 1) continue;
+                ctx->mark[q] = h + 1;
+                ctx->stack[top++] = q;
+            }
+        }
+    }
+}
+
+/**
+ * @brief ترتيب زيارة الخلفاء: الأقل عمقاً أولاً ثم الأعلى فهرساً، فيخرج في RPO
+ * جسم الحلقة قبل مخرجها، والكتل المتساوية بترتيبها الأصلي.
+ */
+static void layout_sort_succs(LayoutCtx* ctx)
+{
+    for (int b = 0; b < ctx->count; b++) {
+        int* s = &ctx->succs[ctx->succ_start[b]];
+        bool* bk = &ctx->back[ctx->succ_start[b]];
+        for (int i = 1; i < ctx->succ_count[b]; i++) {
+            int v = s[i];
+            bool vb = bk[i];
+            int j = i - 1;
+            while (j >= 0 && (ctx->depth[s[j]] > ctx->depth[v] ||
+                              (ctx->depth[s[j]] == ctx->depth[v] && s[j] < v))) {
+                s[j + 1] = s[j];
+                bk[j + 1] = bk[j];
+                j--;
+            }
+            s[j + 1] = v;
+            bk[j + 1] = vb;
+        }
+    }
+}
+
+// ============================================================================
+// الترتيب (Placement)
+// ============================================================================
+
+static void layout_place(LayoutCtx* ctx, int b)
+{
+    ctx->placed[b] = true;
+    ctx->order[ctx->order_count++] = b;
+    for (int k = 0; k < ctx->succ_count[b]; k++) {
+        if (!ctx->back[ctx->succ_start[b] + k]) {
+            ctx->pending[ctx->succs[ctx->succ_start[b] + k]]--;
+        }
+    }
+}
+
+static bool layout_available(const LayoutCtx* ctx, int b)
+{
+    return !ctx->placed[b] && b != ctx->pinned;
+}
+
+static int layout_best_successor(const LayoutCtx* ctx, int cur)
+{
+    int best = -1;
+    for (int k = 0; k < ctx->succ_count[cur]; k++) {
+        int s = ctx->succs[ctx->succ_start[cur] + k];
+        if (!layout_available(ctx, s) || ctx->pending[s] > 0) continue;
+        if (best < 0 || ctx->depth[s] > ctx->depth[best] ||
+            (ctx->depth[s] == ctx->depth[best] && s < best)) {
+            best = s;
+        }
+    }
+    return best;
+}
+
+static void layout_place_all(LayoutCtx* ctx)
+{
+    for (int b = 0; b < ctx->count; b++) {
+        for (int k = 0; k < ctx->succ_count[b]; k++) {
+            if (!ctx->back[ctx->succ_start[b] + k]) {
+                ctx->pending[ctx->succs[ctx->succ_start[b] + k]]++;
+            }
+        }
+    }
+
+    int seed = 0;
+    int cur = 0;
+    layout_place(ctx, 0);
+    for (;;) {
+        int next = layout_best_successor(ctx, cur);
+        if (next < 0) {
+            while (seed < ctx->rpo_count && !layout_available(ctx, ctx->rpo[seed])) seed++;
+            if (seed == ctx->rpo_count) break;
+            next = ctx->rpo[seed];
+        }
+        layout_place(ctx, next);
+        cur = next;
+    }
+
+    // الكتل غير القابلة للوصول بترتيبها الأصلي، ثم الكتلة المثبتة.
+    for (int b = 0; b < ctx->count; b++) {
+        if (layout_available(ctx, b)) layout_place(ctx, b);
+    }
+    if (ctx->pinned >= 0) layout_place(ctx, ctx->pinned);
+}
+
+// ============================================================================
+// إصلاح القفزات (Jump Fixup)
+// ============================================================================
+
+/**
+ * @brief جعل كل سقوط ضمني قفزاً صريحاً قبل تغيير الترتيب.
+ * @return false إن فشل حجز تعليمة.
+ */
+static bool layout_make_fallthrough_explicit(LayoutCtx* ctx)
+{
+    for (int b = 0; b < ctx->count; b++) {
+        MachineBlock* block = ctx->blocks[b];
+        if (layout_ends_with_transfer(block)) continue;
+        if (b + 1 == ctx->count) {
+            // تسقط إلى الخاتمة التي يضيفها المُصدر بعد آخر كتلة.
+            ctx->pinned = b;
+            continue;
+        }
+        MachineInst* jmp = mach_inst_new(MACH_JMP, mach_op_label(ctx->blocks[b + 1]->id),
+                                         mach_op_none(), mach_op_none());
+        if (!jmp) return false;
+        mach_block_append(block, jmp);
+    }
+    return true;
+}
+
+/**
+ * @brief حذف القفز إلى الكتلة التالية، مع عكس `jcc next; jmp X` إلى `j!cc X`.
+ */
+static void layout_fix_jumps(MachineBlock* block, MachineBlock* next)
+{
+    MachineInst* last = layout_last_real(block);
+    if (!next || !layout_is_jump(last)) return;
+
+    if (last->op == MACH_JMP && last->dst.data.label_id != next->id) {
+        MachineInst* prev = layout_prev_real(last->prev);
+        if (!layout_is_jump(prev) || !layout_is_jcc(prev->op) ||
+            prev->dst.data.label_id != next->id) {
+            return;
+        }
+        prev->op = layout_invert_jcc(prev->op);
+        prev->dst.data.label_id = last->dst.data.label_id;
+        layout_remove_inst(block, last);
+        return;
+    }
+
+    // القفز الأخير (المشروط أو غيره) إلى التالية لا أثر له؛ ويتكرر ذلك
+    // لحالة `jcc next; jmp next`.
+    while (layout_is_jump(last) && last->dst.data.label_id == next->id) {
+        MachineInst* prev = layout_prev_real(last->prev);
+        layout_remove_inst(block, last);
+        last = prev;
+    }
+}
+
+bool mach_layout_func(MachineFunc* func)
+{
+    if (!func || func->is_prototype || !func->blocks) return true;
+    if (func->entry && func->entry != func->blocks) return true;
+    if (!func->blocks->next) return true;
+
+    LayoutCtx ctx;
+    if (!layout_ctx_init(&ctx, func)) {
+        layout_ctx_free(&ctx);
+        return false;
+    }
+    // السقوط الضمني يصبح قفزاً صريحاً فتظهر كل الحواف في تعليمات القفز؛
+    // القفزات المضافة صحيحة في أي ترتيب.
+    if (!layout_make_fallthrough_explicit(&ctx)) {
+        layout_ctx_free(&ctx);
+        return false;
+    }
+    if (!layout_collect_edges(&ctx)) {
+        // قفز إلى كتلة خارج الدالة (أو فشل الحجز): نترك الترتيب كما هو.
+        layout_ctx_free(&ctx);
+        return true;
+    }
+
+    layout_dfs(&ctx, true);
+    layout_compute_depth(&ctx);
+    layout_sort_succs(&ctx);
+    layout_dfs(&ctx, false);
+    layout_place_all(&ctx);
+
+    for (int i = 0; i < ctx.count; i++) {
+        ctx.blocks[ctx.order[i]]->next = (i + 1 < ctx.count) ? ctx.blocks[ctx.order[i + 1]] : NULL;
+    }
+    func->blocks = ctx.blocks[ctx.order[0]];
+    for (MachineBlock* b = func->blocks; b; b = b->next) {
+        layout_fix_jumps(b, b->next);
+    }
+
+    layout_ctx_free(&ctx);
+    return true;
+}
+
+bool mach_layout_run(MachineModule* module)
+{
+    if (!module) return false;
+    for (MachineFunc* func = module->funcs; func; func = func->next) {
+        if (!mach_layout_func(func)) return false;
+    }
+    return true;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file block_layout.h
+ * @brief ترتيب الكتل الآلية وحذف القفزات الزائدة.
+ *
+ * يعمل بعد تخصيص السجلات وقبل الإصدار:
+ *   كتل بترتيب IR → ترتيب يراعي الحلقات (أجسام الحلقات متجاورة)
+ *   → عكس شرط القفز ليسقط الخلف المرجّح → حذف القفز إلى الكتلة التالية
+ *
+ * لا يغيّر أي سجل أو تعليمة غير تعليمات القفز، فنتائج التخصيص تبقى صالحة.
+ */
+
+#ifndef BAA_BLOCK_LAYOUT_H
+#define BAA_BLOCK_LAYOUT_H
+
+#include <stdbool.h>
+#include "isel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief إعادة ترتيب كتل دالة آلية واحدة وحذف قفزاتها إلى الكتلة التالية.
+ * @return false عند فشل حجز الذاكرة (تبقى الدالة صالحة بترتيبها الأصلي).
+ */
+bool mach_layout_func(MachineFunc* func);
+
+/**
+ * @brief تطبيق mach_layout_func() على كل دوال الوحدة.
+ */
+bool mach_layout_run(MachineModule* module);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BAA_BLOCK_LAYOUT_H
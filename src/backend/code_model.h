@@ -30,6 +30,15 @@ typedef enum {
     BAA_STACKPROT_ALL = 2,
 } BaaStackProtectorMode;
 
+// ============================================================================
+// مخصص السجلات (Register Allocator)
+// ============================================================================
+
+typedef enum {
+    BAA_REGALLOC_LINEAR = 0, // مسح خطي: فترة واحدة لكل vreg (الافتراضي)
+    BAA_REGALLOC_SPLIT  = 1, // فترات بفجوات مع تقسيم المدى وأوزان الحلقات
+} BaaRegAllocMode;
+
 // ============================================================================
 // خيارات الخلفية (Backend Options)
 // ============================================================================
@@ -40,6 +49,7 @@ typedef struct {
     bool pie; // -fPIE / link -pie
     BaaStackProtectorMode stack_protector;
     bool asm_comments; // --asm-comments
+    BaaRegAllocMode regalloc; // --regalloc=linear|split
 } BaaCodegenOptions;
 
 static inline BaaCodegenOptions baa_codegen_options_default(void)
@@ -50,6 +60,7 @@ static inline BaaCodegenOptions baa_codegen_options_default(void)
     o.pie = false;
     o.stack_protector = BAA_STACKPROT_OFF;
     o.asm_comments = false;
+    o.regalloc = BAA_REGALLOC_LINEAR;
     return o;
 }
 
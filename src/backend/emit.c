@@ -87,26 +87,45 @@ static MachineOperand emit_scratch_r11(int bits)
     return tmp;
 }
 
-/**
- * @brief معرفات داخلية لتفادي تعارض تسميات الكتل بين الدوال.
- *
- * في GAS، التسميات المحلية مثل .LBB_0 تكون على مستوى الملف كله،
- * لذا قد تتعارض بين دوال مختلفة إذا كانت أرقام الكتل تبدأ من الصفر
- * داخل كل دالة. الحل: إضافة بادئة رقمية لكل دالة أثناء الإصدار.
- */
-static int g_emit_next_func_uid = 0;
-static int g_emit_current_func_uid = 0;
-static int g_emit_sp_seq = 0;
+typedef struct {
+    const char** files;
+    int file_count;
+    int file_cap;
 
-// هل إصدار معلومات الديبغ مفعل؟
-static bool g_emit_debug_info = false;
-// هل إصدار تعليقات تجميع وصفية مفعل؟
-static bool g_emit_asm_comments = false;
+    int last_file_id;
+    int last_line;
+    int last_col;
 
-// الهدف واتفاقية الاستدعاء الحالية (تُملأ عبر emit_module_ex)
-static const BaaTarget* g_emit_target = NULL;
-static const BaaCallingConv* g_emit_cc = NULL;
-static BaaCodegenOptions g_emit_opts;
+    const char* last_dbg_name;
+} EmitDebugState;
+
+/**
+ * @brief حالة إصدار وحدة واحدة؛ يملكها إطار emit_module_ex2() وتُمرَّر لكل دالة إصدار.
+ */
+typedef struct {
+    /**
+     * معرفات داخلية لتفادي تعارض تسميات الكتل بين الدوال.
+     *
+     * في GAS، التسميات المحلية مثل .LBB_0 تكون على مستوى الملف كله،
+     * لذا قد تتعارض بين دوال مختلفة إذا كانت أرقام الكتل تبدأ من الصفر
+     * داخل كل دالة. الحل: إضافة بادئة رقمية لكل دالة أثناء الإصدار.
+     */
+    int next_func_uid;
+    int current_func_uid;
+    int sp_seq;
+
+    // هل إصدار معلومات الديبغ مفعل؟
+    bool debug_info;
+    // هل إصدار تعليقات تجميع وصفية مفعل؟
+    bool asm_comments;
+
+    // الهدف واتفاقية الاستدعاء الحالية
+    const BaaTarget* target;
+    const BaaCallingConv* cc;
+    BaaCodegenOptions opts;
+
+    EmitDebugState dbg;
+} EmitContext;
 
 #include "emit_support.c"
 #include "emit_frame.c"
@@ -122,7 +141,7 @@ static bool emit_operand_is_memory_like(const MachineOperand* op)
  * x86-64 لا يسمح بتعليمة حسابية ذاكرة-إلى-ذاكرة مباشرة، لذلك نمرر
  * المصدر الثاني عبر %r11 قبل تحديث الوجهة.
  */
-static bool emit_binary_mem_rhs_via_scratch(FILE* out, const char* mnemonic, MachineInst* inst)
+static bool emit_binary_mem_rhs_via_scratch(EmitContext* ctx, EmitBuf* out, const char* mnemonic, MachineInst* inst)
 {
     if (!out || !mnemonic || !inst) return false;
     if (!emit_operand_is_memory_like(&inst->dst) || !emit_operand_is_memory_like(&inst->src2)) {
@@ -136,23 +155,22 @@ static bool emit_binary_mem_rhs_via_scratch(FILE* out, const char* mnemonic, Mac
     MachineOperand tmp = emit_scratch_r11(bits);
     char suffix = size_suffix(bits);
 
-    fprintf(out, "    mov%c ", suffix);
-    emit_operand(&inst->src2, out);
-    fprintf(out, ", ");
-    emit_operand(&tmp, out);
-    fprintf(out, "\n");
-
-    fprintf(out, "    %s%c ", mnemonic, suffix);
-    emit_operand(&tmp, out);
-    fprintf(out, ", ");
-    emit_operand(&inst->dst, out);
-    fprintf(out, "\n");
+    emit_buf_fmt(out, "    mov%c ", suffix);
+    emit_operand(ctx, &inst->src2, out);
+    emit_buf_puts(out, ", ");
+    emit_operand(ctx, &tmp, out);
+    emit_buf_puts(out, "\n");
+
+    emit_buf_fmt(out, "    %s%c ", mnemonic, suffix);
+    emit_operand(ctx, &tmp, out);
+    emit_buf_puts(out, ", ");
+    emit_operand(ctx, &inst->dst, out);
+    emit_buf_puts(out, "\n");
     return true;
 }
 
-void emit_inst(MachineInst* inst, MachineFunc* func, FILE* out) {
+static void emit_inst(EmitContext* ctx, MachineInst* inst, EmitBuf* out) {
     if (!inst || !out) return;
-    (void)func;
 
     switch (inst->op) {
 #include "emit_inst_body_a.inc"
@@ -64,27 +64,22 @@ bool emit_module_ex(MachineModule* module, FILE* out, bool debug_info, const Baa
 
 /**
  * @brief نسخة موسعة لدعم خيارات نموذج الكود.
+ *
+ * حالة الإصدار (عدادات التسميات ومعلومات الديبغ) محلية لكل استدعاء، لذا يمكن
+ * إصدار وحدات مختلفة من خيوط مختلفة في الوقت نفسه.
  */
 bool emit_module_ex2(MachineModule* module, FILE* out, bool debug_info,
                      const BaaTarget* target, BaaCodegenOptions opts);
 
 /**
- * @brief إصدار كود تجميع لدالة واحدة.
+ * @brief مثل emit_module_ex2 مع إصدار الدوال على مجمّع خيوط (--threads).
  *
- * @param func الدالة الآلية.
- * @param out ملف الخرج.
- * @return صحيح عند النجاح.
- */
-bool emit_func(MachineFunc* func, FILE* out);
-
-/**
- * @brief إصدار تعليمة آلة واحدة بصيغة AT&T.
- *
- * @param inst التعليمة الآلية.
- * @param func الدالة الحاوية (للسياق).
- * @param out ملف الخرج.
+ * كل دالة تُصدَر في مخزن بالذاكرة بالـ uid الذي كانت ستأخذه تسلسلياً، ثم تُكتب
+ * بترتيب الوحدة، فالخرج مطابق بايتاً ببايت. مع debug_info يبقى الإصدار تسلسلياً
+ * لأن حالة .file/.loc تمتد عبر الدوال.
  */
-void emit_inst(MachineInst* inst, MachineFunc* func, FILE* out);
+bool emit_module_ex3(MachineModule* module, FILE* out, bool debug_info,
+                     const BaaTarget* target, BaaCodegenOptions opts, BaaThreadPool* pool);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,189 @@
+/**
+ * @file emit_buf.c
+ * @brief مخزن نص الإصدار المشترك بين مُصدّري AT&T ونظم.
+ */
+
+#include "emit_buf.h"
+
+#include <stdlib.h>
+
+void emit_buf_init(EmitBuf *b, FILE *sink)
+{
+    if (!b) return;
+    memset(b, 0, sizeof(*b));
+    b->sink = sink;
+}
+
+void emit_buf_free(EmitBuf *b)
+{
+    if (!b) return;
+    free(b->data);
+    b->data = NULL;
+    b->len = 0;
+    b->cap = 0;
+}
+
+bool emit_buf_reserve(EmitBuf *b, size_t extra)
+{
+    if (b->failed) return false;
+    if (b->len + extra <= b->cap) return true;
+
+    size_t cap = b->cap ? b->cap : 64u * 1024u;
+    while (cap < b->len + extra)
+        cap *= 2;
+    char *p = (char *)realloc(b->data, cap);
+    if (!p)
+    {
+        b->failed = true;
+        return false;
+    }
+    b->data = p;
+    b->cap = cap;
+    return true;
+}
+
+bool emit_buf_flush(EmitBuf *b)
+{
+    if (!b || b->failed) return false;
+    if (!b->sink || b->len == 0) return true;
+    if (fwrite(b->data, 1, b->len, b->sink) != b->len)
+        b->failed = true;
+    b->len = 0;
+    return !b->failed;
+}
+
+void emit_buf_u64(EmitBuf *b, uint64_t v)
+{
+    char tmp[24];
+    size_t n = sizeof(tmp);
+    do
+    {
+        tmp[--n] = (char)('0' + (int)(v % 10u));
+        v /= 10u;
+    } while (v != 0u);
+    emit_buf_write(b, tmp + n, sizeof(tmp) - n);
+}
+
+void emit_buf_i64(EmitBuf *b, int64_t v)
+{
+    if (v < 0)
+    {
+        emit_buf_putc(b, '-');
+        // نفس حيلة nazm_write_signed لتفادي فيض -INT64_MIN.
+        emit_buf_u64(b, (uint64_t)(-(v + 1)) + 1u);
+        return;
+    }
+    emit_buf_u64(b, (uint64_t)v);
+}
+
+/**
+ * @brief عدد بأساس ١٠ أو ١٦ مع عرض أدنى وحشو بالصفر أو المسافة.
+ */
+static void emit_buf_number(EmitBuf *b, uint64_t v, bool negative, unsigned base,
+                            bool upper, int width, bool zero_pad)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[24];
+    size_t n = sizeof(tmp);
+    do
+    {
+        tmp[--n] = digits[v % base];
+        v /= base;
+    } while (v != 0u);
+
+    int len = (int)(sizeof(tmp) - n) + (negative ? 1 : 0);
+    if (negative && zero_pad) emit_buf_putc(b, '-');
+    for (; width > len; width--)
+        emit_buf_putc(b, zero_pad ? '0' : ' ');
+    if (negative && !zero_pad) emit_buf_putc(b, '-');
+    emit_buf_write(b, tmp + n, sizeof(tmp) - n);
+}
+
+void emit_buf_vfmt(EmitBuf *b, const char *fmt, va_list args)
+{
+    const char *p = fmt;
+    while (*p)
+    {
+        const char *lit = p;
+        while (*p && *p != '%')
+            p++;
+        emit_buf_write(b, lit, (size_t)(p - lit));
+        if (!*p) break;
+
+        p++; // '%'
+        bool zero_pad = false;
+        int width = 0;
+        int longs = 0;
+        bool size_t_arg = false;
+        if (*p == '0')
+        {
+            zero_pad = true;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9')
+            width = width * 10 + (*p++ - '0');
+        while (*p == 'l')
+        {
+            longs++;
+            p++;
+        }
+        if (*p == 'z')
+        {
+            size_t_arg = true;
+            p++;
+        }
+
+        switch (*p)
+        {
+        case 'd':
+        case 'i':
+        {
+            int64_t v = size_t_arg ? (int64_t)va_arg(args, ptrdiff_t)
+                        : longs >= 2 ? (int64_t)va_arg(args, long long)
+                        : longs == 1 ? (int64_t)va_arg(args, long)
+                                     : (int64_t)va_arg(args, int);
+            uint64_t mag = v < 0 ? (uint64_t)(-(v + 1)) + 1u : (uint64_t)v;
+            emit_buf_number(b, mag, v < 0, 10u, false, width, zero_pad);
+            break;
+        }
+        case 'u':
+        case 'x':
+        case 'X':
+        {
+            uint64_t v = size_t_arg ? (uint64_t)va_arg(args, size_t)
+                         : longs >= 2 ? (uint64_t)va_arg(args, unsigned long long)
+                         : longs == 1 ? (uint64_t)va_arg(args, unsigned long)
+                                      : (uint64_t)va_arg(args, unsigned);
+            emit_buf_number(b, v, false, *p == 'u' ? 10u : 16u, *p == 'X', width, zero_pad);
+            break;
+        }
+        case 's':
+        {
+            const char *s = va_arg(args, const char *);
+            emit_buf_puts(b, s ? s : "(null)");
+            break;
+        }
+        case 'c':
+            emit_buf_putc(b, (char)va_arg(args, int));
+            break;
+        case '%':
+            emit_buf_putc(b, '%');
+            break;
+        default:
+            // صيغة خارج المجموعة المدعومة: تُنسخ كما هي لتظهر في فرق الخرج.
+            emit_buf_putc(b, '%');
+            if (!*p) return;
+            emit_buf_putc(b, *p);
+            break;
+        }
+        p++;
+    }
+}
+
+void emit_buf_fmt(EmitBuf *b, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    emit_buf_vfmt(b, fmt, args);
+    va_end(args);
+}
@@ -0,0 +1,94 @@
+/**
+ * @file emit_buf.h
+ * @brief مخزن نص الإصدار: كتابة نص التجميع دون stdio لكل رمز.
+ *
+ * يجمع مُصدّرا AT&T ونظم النص في مخزن واحد يُعاد استخدامه عبر الوحدة،
+ * وتُكتب الأرقام والسجلات والتسميات يدوياً بلا fprintf ولا قفل stdio.
+ * يُفرَّغ المخزن إلى ملف الخرج بعملية fwrite واحدة لكل دالة.
+ */
+
+#ifndef BAA_EMIT_BUF_H
+#define BAA_EMIT_BUF_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EMIT_BUF_PRINTF(fmt_index, args_index) \
+    __attribute__((format(printf, fmt_index, args_index)))
+#else
+#define EMIT_BUF_PRINTF(fmt_index, args_index)
+#endif
+
+typedef struct
+{
+    char *data;
+    size_t len;
+    size_t cap;
+    FILE *sink;  // NULL: يبقى النص في الذاكرة حتى يأخذه المستدعي
+    bool failed; // فشل تخصيص أو كتابة؛ تُتجاهل الكتابات اللاحقة
+} EmitBuf;
+
+/**
+ * @brief تهيئة مخزن فارغ؛ sink اختياري ويُكتب إليه عند emit_buf_flush().
+ */
+void emit_buf_init(EmitBuf *b, FILE *sink);
+
+/**
+ * @brief تحرير ذاكرة المخزن (لا يُفرِّغ ولا يغلق sink).
+ */
+void emit_buf_free(EmitBuf *b);
+
+/**
+ * @brief ضمان مساحة لـ extra بايت إضافية (مسار النمو البطيء).
+ */
+bool emit_buf_reserve(EmitBuf *b, size_t extra);
+
+/**
+ * @brief كتابة محتوى المخزن إلى sink بعملية fwrite واحدة ثم تفريغه.
+ *
+ * @return false إن فشلت الكتابة أو سبق فشل تخصيص.
+ */
+bool emit_buf_flush(EmitBuf *b);
+
+/**
+ * @brief عدد صحيح بإشارة بالنظام العشري.
+ */
+void emit_buf_i64(EmitBuf *b, int64_t v);
+
+/**
+ * @brief عدد صحيح بلا إشارة بالنظام العشري.
+ */
+void emit_buf_u64(EmitBuf *b, uint64_t v);
+
+/**
+ * @brief صياغة مصغرة بلا locale ولا stdio: %d %i %u %x %X %s %c %% مع
+ * الأطوال l/ll/z والعلم 0 والعرض.
+ */
+void emit_buf_fmt(EmitBuf *b, const char *fmt, ...) EMIT_BUF_PRINTF(2, 3);
+void emit_buf_vfmt(EmitBuf *b, const char *fmt, va_list args) EMIT_BUF_PRINTF(2, 0);
+
+static inline void emit_buf_write(EmitBuf *b, const char *s, size_t n)
+{
+    if (n == 0) return;
+    if (b->len + n > b->cap && !emit_buf_reserve(b, n)) return;
+    memcpy(b->data + b->len, s, n);
+    b->len += n;
+}
+
+static inline void emit_buf_puts(EmitBuf *b, const char *s)
+{
+    emit_buf_write(b, s, strlen(s));
+}
+
+static inline void emit_buf_putc(EmitBuf *b, char c)
+{
+    if (b->len + 1 > b->cap && !emit_buf_reserve(b, 1)) return;
+    b->data[b->len++] = c;
+}
+
+#endif // BAA_EMIT_BUF_H
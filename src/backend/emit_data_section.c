@@ -5,11 +5,11 @@
 /**
  * @brief إصدار قسم البيانات الثابتة (صيغ الطباعة والقراءة).
  */
-static void emit_rdata_section(FILE* out) {
-    emit_rodata_section(out);
-    fprintf(out, "fmt_int: .asciz \"%%lld\\n\"\n");
-    fprintf(out, "fmt_str: .asciz \"%%s\\n\"\n");
-    fprintf(out, "fmt_scan_int: .asciz \"%%lld\"\n");
+static void emit_rdata_section(EmitContext* ctx, EmitBuf* out) {
+    emit_rodata_section(ctx, out);
+    emit_buf_puts(out, "fmt_int: .asciz \"%lld\\n\"\n");
+    emit_buf_puts(out, "fmt_str: .asciz \"%s\\n\"\n");
+    emit_buf_puts(out, "fmt_scan_int: .asciz \"%lld\"\n");
 }
 
 /**
@@ -44,21 +44,21 @@ static const char* emit_data_dir_for_type(IRType* t, int* out_size_bytes) {
     }
 }
 
-static void emit_data_section(MachineModule* module, FILE* out) {
+static void emit_data_section(EmitContext* ctx, MachineModule* module, EmitBuf* out) {
     if (!module || module->global_count == 0) return;
 
-    fprintf(out, "\n.data\n");
+    emit_buf_puts(out, "\n.data\n");
 
     for (IRGlobal* g = module->globals; g; g = g->next) {
         if (!g->name) continue;
         if (g->is_extern) continue;
 
         if (g->is_internal) {
-            if (g_emit_target && g_emit_target->obj_format == BAA_OBJFORMAT_ELF) {
-                fprintf(out, ".local %s\n", g->name);
+            if (ctx->target && ctx->target->obj_format == BAA_OBJFORMAT_ELF) {
+                emit_buf_fmt(out, ".local %s\n", g->name);
             }
         } else {
-            fprintf(out, ".globl %s\n", g->name);
+            emit_buf_fmt(out, ".globl %s\n", g->name);
         }
 
         // مصفوفة عامة
@@ -93,35 +93,35 @@ static void emit_data_section(MachineModule* module, FILE* out) {
             if (all_zero) {
                 int total = count * elem_size;
                 if (total < 0) total = 0;
-                fprintf(out, "%s: .zero %d\n", g->name, total);
+                emit_buf_fmt(out, "%s: .zero %d\n", g->name, total);
             } else {
-                fprintf(out, "%s:\n", g->name);
+                emit_buf_fmt(out, "%s:\n", g->name);
                 for (int i = 0; i < count; i++) {
                     if (g->init_elems && i < g->init_elem_count && g->init_elems[i]) {
                         IRValue* iv = g->init_elems[i];
                         if (iv->kind == IR_VAL_CONST_INT) {
-                            fprintf(out, "    %s %lld\n", dir, (long long)iv->data.const_int);
+                            emit_buf_fmt(out, "    %s %lld\n", dir, (long long)iv->data.const_int);
                             continue;
                         }
                         if (iv->kind == IR_VAL_CONST_STR && elem_t && elem_t->kind == IR_TYPE_PTR) {
-                            fprintf(out, "    .quad .Lstr_%d\n", iv->data.const_str.id);
+                            emit_buf_fmt(out, "    .quad .Lstr_%d\n", iv->data.const_str.id);
                             continue;
                         }
                         if (iv->kind == IR_VAL_BAA_STR && elem_t && elem_t->kind == IR_TYPE_PTR) {
-                            fprintf(out, "    .quad .Lbs_%d\n", iv->data.const_str.id);
+                            emit_buf_fmt(out, "    .quad .Lbs_%d\n", iv->data.const_str.id);
                             continue;
                         }
                         if (iv->kind == IR_VAL_FUNC && elem_t && elem_t->kind == IR_TYPE_FUNC) {
                             MachineOperand mop = {0};
                             mop.kind = MACH_OP_FUNC;
                             mop.data.name = iv->data.global_name;
-                            fprintf(out, "    .quad ");
-                            emit_operand(&mop, out);
-                            fprintf(out, "\n");
+                            emit_buf_puts(out, "    .quad ");
+                            emit_operand(ctx, &mop, out);
+                            emit_buf_puts(out, "\n");
                             continue;
                         }
                     }
-                    fprintf(out, "    %s 0\n", dir);
+                    emit_buf_fmt(out, "    %s 0\n", dir);
                 }
             }
 
@@ -134,31 +134,31 @@ static void emit_data_section(MachineModule* module, FILE* out) {
             const char* dir = emit_data_dir_for_type(g->type, &sz);
 
             if (g->init->kind == IR_VAL_CONST_INT) {
-                fprintf(out, "%s: %s %lld\n", g->name, dir,
-                        (long long)g->init->data.const_int);
+                emit_buf_fmt(out, "%s: %s %lld\n", g->name, dir,
+                             (long long)g->init->data.const_int);
             } else if (g->init->kind == IR_VAL_CONST_STR) {
                 // C-String: تخزين مؤشر لسلسلة في جدول النصوص
-                fprintf(out, "%s: .quad .Lstr_%d\n", g->name,
-                        g->init->data.const_str.id);
+                emit_buf_fmt(out, "%s: .quad .Lstr_%d\n", g->name,
+                             g->init->data.const_str.id);
             } else if (g->init->kind == IR_VAL_BAA_STR) {
                 // نص باء: تخزين مؤشر لسلسلة حرف[] في جدول نصوص باء
-                fprintf(out, "%s: .quad .Lbs_%d\n", g->name,
-                        g->init->data.const_str.id);
+                emit_buf_fmt(out, "%s: .quad .Lbs_%d\n", g->name,
+                             g->init->data.const_str.id);
             } else if (g->init->kind == IR_VAL_FUNC) {
                 // مؤشر دالة: تخزين عنوان الدالة كـ .quad <symbol>
                 MachineOperand mop = {0};
                 mop.kind = MACH_OP_FUNC;
                 mop.data.name = g->init->data.global_name;
-                fprintf(out, "%s: .quad ", g->name);
-                emit_operand(&mop, out);
-                fprintf(out, "\n");
+                emit_buf_fmt(out, "%s: .quad ", g->name);
+                emit_operand(ctx, &mop, out);
+                emit_buf_puts(out, "\n");
             } else {
-                fprintf(out, "%s: %s 0\n", g->name, dir);
+                emit_buf_fmt(out, "%s: %s 0\n", g->name, dir);
             }
         } else {
             int sz = 8;
             const char* dir = emit_data_dir_for_type(g->type, &sz);
-            fprintf(out, "%s: %s 0\n", g->name, dir);
+            emit_buf_fmt(out, "%s: %s 0\n", g->name, dir);
         }
     }
 }
@@ -173,22 +173,22 @@ static void emit_data_section(MachineModule* module, FILE* out) {
  * - أسطر جديدة/تبويب/عودة عربة
  * - المحارف غير القابلة للطباعة (نستخدم \xHH)
  */
-static void emit_gas_escaped_string(FILE* out, const char* s) {
+static void emit_gas_escaped_string(EmitBuf* out, const char* s) {
     if (!out || !s) return;
 
     for (const unsigned char* p = (const unsigned char*)s; *p; p++) {
         unsigned char c = *p;
         switch (c) {
-            case '\"': fputs("\\\"", out); break;
-            case '\\': fputs("\\\\", out); break;
-            case '\n': fputs("\\n", out); break;
-            case '\t': fputs("\\t", out); break;
-            case '\r': fputs("\\r", out); break;
+            case '\"': emit_buf_puts(out, "\\\""); break;
+            case '\\': emit_buf_puts(out, "\\\\"); break;
+            case '\n': emit_buf_puts(out, "\\n"); break;
+            case '\t': emit_buf_puts(out, "\\t"); break;
+            case '\r': emit_buf_puts(out, "\\r"); break;
             default:
                 if (c < 0x20 || c == 0x7F) {
-                    fprintf(out, "\\x%02X", (unsigned)c);
+                    emit_buf_fmt(out, "\\x%02X", (unsigned)c);
                 } else {
-                    fputc((int)c, out);
+                    emit_buf_putc(out, (char)c);
                 }
                 break;
         }
@@ -198,33 +198,33 @@ static void emit_gas_escaped_string(FILE* out, const char* s) {
 /**
  * @brief إصدار جدول النصوص (String Table).
  */
-static void emit_string_table(MachineModule* module, FILE* out) {
+static void emit_string_table(EmitContext* ctx, MachineModule* module, EmitBuf* out) {
     if (!module || module->string_count == 0) return;
 
-    fprintf(out, "\n");
-    emit_rodata_section(out);
+    emit_buf_puts(out, "\n");
+    emit_rodata_section(ctx, out);
 
     for (IRStringEntry* s = module->strings; s; s = s->next) {
         if (!s->content) continue;
 
-        fprintf(out, ".Lstr_%d: .asciz \"", s->id);
+        emit_buf_fmt(out, ".Lstr_%d: .asciz \"", s->id);
         emit_gas_escaped_string(out, s->content);
-        fprintf(out, "\"\n");
+        emit_buf_puts(out, "\"\n");
     }
 }
 
-static void emit_baa_string_table(MachineModule* module, FILE* out) {
+static void emit_baa_string_table(EmitContext* ctx, MachineModule* module, EmitBuf* out) {
     if (!module || module->baa_string_count == 0) return;
 
-    fprintf(out, "\n");
-    emit_rodata_section(out);
+    emit_buf_puts(out, "\n");
+    emit_rodata_section(ctx, out);
 
     for (IRBaaStringEntry* s = module->baa_strings; s; s = s->next) {
         if (!s->content) continue;
 
         // محاذاة 8 بايت لأن العناصر .quad
-        fprintf(out, "    .p2align 3\n");
-        fprintf(out, ".Lbs_%d:\n", s->id);
+        emit_buf_puts(out, "    .p2align 3\n");
+        emit_buf_fmt(out, ".Lbs_%d:\n", s->id);
 
         const unsigned char* p = (const unsigned char*)s->content;
         while (*p) {
@@ -269,11 +269,11 @@ static void emit_baa_string_table(MachineModule* module, FILE* out) {
                                    ((uint64_t)bytes[3] << 24);
             uint64_t packed = bytes_field | ((uint64_t)(unsigned)len << 32);
 
-            fprintf(out, "    .quad %llu\n", (unsigned long long)packed);
+            emit_buf_fmt(out, "    .quad %llu\n", (unsigned long long)packed);
         }
 
         // النهاية: حرف بطول 0
-        fprintf(out, "    .quad 0\n");
+        emit_buf_puts(out, "    .quad 0\n");
     }
 }
 
@@ -0,0 +1,690 @@
+/**
+ * @file emit_elf.c
+ * @brief كاتب كائنات ELF64 الأصلي - الأقسام والرموز والـ relocations.
+ *
+ * يستبدل مرحلتي "نص AT&T ثم gcc -c" بترميز مباشر داخل العملية:
+ * - emit_elf_encode.c: مخازن البايتات، ModRM/SIB/REX، وتقصير القفزات
+ * - emit_elf_data.c: .data و.rodata (صيغ الطباعة، جداول النصوص والقفز)
+ * - emit_elf_inst.c: ترجمة كل MachineInst بنفس صيغ emit_inst_body_*.inc
+ *
+ * تخطيط الكائن ثابت: .text و.data و.rodata مع أقسام .rela لكل منها،
+ * ثم .note.GNU-stack و.symtab و.strtab و.shstrtab. المراجع إلى التسميات
+ * المحلية (.Lstr_N و.Lbs_N وجداول القفز) تصير رمز القسم + إزاحة كما يفعل GAS.
+ */
+
+#include "emit_elf.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "regalloc.h"
+
+// ============================================================================
+// ثوابت ELF64 (ELF64 Constants)
+// ============================================================================
+
+#define ELF_SHT_PROGBITS 1u
+#define ELF_SHT_SYMTAB 2u
+#define ELF_SHT_STRTAB 3u
+#define ELF_SHT_RELA 4u
+
+#define ELF_SHF_WRITE 0x1u
+#define ELF_SHF_ALLOC 0x2u
+#define ELF_SHF_EXECINSTR 0x4u
+#define ELF_SHF_INFO_LINK 0x40u
+
+#define ELF_STB_LOCAL 0u
+#define ELF_STB_GLOBAL 1u
+#define ELF_STT_NOTYPE 0u
+#define ELF_STT_OBJECT 1u
+#define ELF_STT_FUNC 2u
+#define ELF_STT_SECTION 3u
+
+#define ELF_R_X86_64_64 1u
+#define ELF_R_X86_64_PC32 2u
+#define ELF_R_X86_64_PLT32 4u
+
+enum
+{
+    ELF_SEC_TEXT = 0,
+    ELF_SEC_DATA,
+    ELF_SEC_RODATA,
+    ELF_SEC_COUNT
+};
+
+// ============================================================================
+// مخزن بايتات قابل للنمو (Growable Byte Buffer)
+// ============================================================================
+
+typedef struct
+{
+    uint8_t* data;
+    size_t len;
+    size_t cap;
+    bool oom;
+} ElfBuf;
+
+static bool elf_buf_reserve(ElfBuf* b, size_t extra)
+{
+    if (b->oom) return false;
+    if (b->len + extra <= b->cap) return true;
+    size_t cap = b->cap ? b->cap : 256;
+    while (cap < b->len + extra) cap *= 2;
+    uint8_t* p = (uint8_t*)realloc(b->data, cap);
+    if (!p)
+    {
+        b->oom = true;
+        return false;
+    }
+    b->data = p;
+    b->cap = cap;
+    return true;
+}
+
+static void elf_buf_put(ElfBuf* b, const void* src, size_t n)
+{
+    if (n == 0 || !elf_buf_reserve(b, n)) return;
+    memcpy(b->data + b->len, src, n);
+    b->len += n;
+}
+
+static void elf_buf_byte(ElfBuf* b, uint8_t v)
+{
+    if (!elf_buf_reserve(b, 1)) return;
+    b->data[b->len++] = v;
+}
+
+/**
+ * @brief كتابة عدد صحيح بترتيب little-endian بعرض n بايت.
+ */
+static void elf_buf_le(ElfBuf* b, uint64_t v, int n)
+{
+    if (!elf_buf_reserve(b, (size_t)n)) return;
+    for (int i = 0; i < n; i++)
+        b->data[b->len++] = (uint8_t)(v >> (8 * i));
+}
+
+static void elf_buf_zero(ElfBuf* b, size_t n)
+{
+    if (!elf_buf_reserve(b, n)) return;
+    memset(b->data + b->len, 0, n);
+    b->len += n;
+}
+
+static void elf_buf_align(ElfBuf* b, size_t align)
+{
+    while (align > 1 && (b->len % align) != 0)
+        elf_buf_byte(b, 0);
+}
+
+static void elf_buf_free(ElfBuf* b)
+{
+    free(b->data);
+    memset(b, 0, sizeof(*b));
+}
+
+// ============================================================================
+// الرموز والـ relocations (Symbols & Relocations)
+// ============================================================================
+
+typedef struct
+{
+    uint64_t offset;
+    int sym;        // معرف داخلي في ElfWriter.syms
+    uint32_t type;
+    int64_t addend;
+} ElfReloc;
+
+typedef struct
+{
+    ElfReloc* items;
+    int count;
+    int cap;
+} ElfRelocList;
+
+typedef struct
+{
+    char* name;     // مملوك؛ فارغ لرموز الأقسام
+    int section;    // ELF_SEC_* أو -1 لغير المعرّف
+    uint64_t value;
+    uint64_t size;
+    uint8_t type;   // ELF_STT_*
+    bool local;
+} ElfSymbol;
+
+typedef struct
+{
+    ElfBuf sec[ELF_SEC_COUNT];
+    ElfRelocList rel[ELF_SEC_COUNT];
+
+    ElfSymbol* syms;
+    int sym_count;
+    int sym_cap;
+    int* sym_hash;  // فهرس + 1، و0 للخانة الفارغة
+    int hash_cap;
+    int section_sym[ELF_SEC_COUNT];
+
+    // معرف النص → إزاحته في .rodata (أو UINT64_MAX)
+    uint64_t* str_off;
+    int str_cap;
+    uint64_t* bs_off;
+    int bs_cap;
+
+    const BaaTarget* target;
+    const BaaCallingConv* cc;
+    BaaCodegenOptions opts;
+    bool failed;
+} ElfWriter;
+
+static uint32_t elf_name_hash(const char* s)
+{
+    uint32_t h = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)s; *p; p++)
+        h = (h ^ *p) * 16777619u;
+    return h;
+}
+
+static int elf_sym_add(ElfWriter* w, const char* name, int section, uint8_t type, bool local)
+{
+    if (w->sym_count >= w->sym_cap)
+    {
+        int cap = w->sym_cap ? w->sym_cap * 2 : 64;
+        ElfSymbol* p = (ElfSymbol*)realloc(w->syms, (size_t)cap * sizeof(ElfSymbol));
+        if (!p)
+        {
+            w->failed = true;
+            return -1;
+        }
+        w->syms = p;
+        w->sym_cap = cap;
+    }
+    ElfSymbol* s = &w->syms[w->sym_count];
+    memset(s, 0, sizeof(*s));
+    size_t n = strlen(name);
+    s->name = (char*)malloc(n + 1);
+    if (!s->name)
+    {
+        w->failed = true;
+        return -1;
+    }
+    memcpy(s->name, name, n + 1);
+    s->section = section;
+    s->type = type;
+    s->local = local;
+    return w->sym_count++;
+}
+
+static bool elf_hash_grow(ElfWriter* w)
+{
+    int cap = w->hash_cap ? w->hash_cap * 2 : 128;
+    int* table = (int*)calloc((size_t)cap, sizeof(int));
+    if (!table) return false;
+    for (int i = 0; i < w->sym_count; i++)
+    {
+        if (!w->syms[i].name[0]) continue;
+        uint32_t h = elf_name_hash(w->syms[i].name) & (uint32_t)(cap - 1);
+        while (table[h]) h = (h + 1) & (uint32_t)(cap - 1);
+        table[h] = i + 1;
+    }
+    free(w->sym_hash);
+    w->sym_hash = table;
+    w->hash_cap = cap;
+    return true;
+}
+
+/**
+ * @brief معرف الرمز المسمى، مع إنشائه رمزاً عاماً غير معرّف عند أول مرجع.
+ */
+static int elf_sym_get(ElfWriter* w, const char* name)
+{
+    if (!name || !name[0])
+    {
+        w->failed = true;
+        return -1;
+    }
+    if ((w->sym_count + 1) * 2 > w->hash_cap && !elf_hash_grow(w))
+    {
+        w->failed = true;
+        return -1;
+    }
+    uint32_t mask = (uint32_t)(w->hash_cap - 1);
+    uint32_t h = elf_name_hash(name) & mask;
+    while (w->sym_hash[h])
+    {
+        int id = w->sym_hash[h] - 1;
+        if (strcmp(w->syms[id].name, name) == 0) return id;
+        h = (h + 1) & mask;
+    }
+    int id = elf_sym_add(w, name, -1, ELF_STT_NOTYPE, false);
+    if (id >= 0) w->sym_hash[h] = id + 1;
+    return id;
+}
+
+/**
+ * @brief تعريف رمز مسمى في قسم عند الموضع الحالي.
+ */
+static int elf_sym_define(ElfWriter* w, const char* name, int section, uint8_t type, bool local)
+{
+    int id = elf_sym_get(w, name);
+    if (id < 0) return -1;
+    ElfSymbol* s = &w->syms[id];
+    if (s->section >= 0)
+    {
+        w->failed = true; // تعريف مكرر
+        return -1;
+    }
+    s->section = section;
+    s->value = w->sec[section].len;
+    s->type = type;
+    s->local = local;
+    return id;
+}
+
+static void elf_reloc_add(ElfWriter* w, int section, uint64_t offset, int sym, uint32_t type, int64_t addend)
+{
+    ElfRelocList* l = &w->rel[section];
+    if (sym < 0)
+    {
+        w->failed = true;
+        return;
+    }
+    if (l->count >= l->cap)
+    {
+        int cap = l->cap ? l->cap * 2 : 64;
+        ElfReloc* p = (ElfReloc*)realloc(l->items, (size_t)cap * sizeof(ElfReloc));
+        if (!p)
+        {
+            w->failed = true;
+            return;
+        }
+        l->items = p;
+        l->cap = cap;
+    }
+    l->items[l->count].offset = offset;
+    l->items[l->count].sym = sym;
+    l->items[l->count].type = type;
+    l->items[l->count].addend = addend;
+    l->count++;
+}
+
+/**
+ * @brief اسم الرمز الفعلي لمرجع دالة (اطبع → printf واقرأ → scanf كما في emit_operand).
+ */
+static const char* elf_func_symbol_name(const char* name)
+{
+    if (!name) return NULL;
+    if (strcmp(name, "اطبع") == 0 || strcmp(name, "اطبع_صحيح") == 0) return "printf";
+    if (strcmp(name, "اقرأ") == 0 || strcmp(name, "اقرأ_صحيح") == 0) return "scanf";
+    return name;
+}
+
+/**
+ * @brief حل اسم معامل عام إلى رمز + إزاحة؛ تسميات .Lstr_/.Lbs_ تصير رمز .rodata.
+ */
+static bool elf_resolve_global(ElfWriter* w, const char* name, int* sym, int64_t* addend)
+{
+    *addend = 0;
+    if (!name) return false;
+    const uint64_t* table = NULL;
+    int cap = 0;
+    const char* num = NULL;
+    if (strncmp(name, ".Lstr_", 6) == 0)
+    {
+        table = w->str_off;
+        cap = w->str_cap;
+        num = name + 6;
+    }
+    else if (strncmp(name, ".Lbs_", 5) == 0)
+    {
+        table = w->bs_off;
+        cap = w->bs_cap;
+        num = name + 5;
+    }
+    if (!num)
+    {
+        *sym = elf_sym_get(w, name);
+        return *sym >= 0;
+    }
+    char* end = NULL;
+    long id = strtol(num, &end, 10);
+    if (!end || *end || id < 0 || id >= cap || table[id] == UINT64_MAX) return false;
+    *sym = w->section_sym[ELF_SEC_RODATA];
+    *addend = (int64_t)table[id];
+    return true;
+}
+
+#include "emit_elf_encode.c"
+#include "emit_elf_data.c"
+#include "emit_elf_inst.c"
+
+// ============================================================================
+// كتابة ملف الكائن (Object File Writing)
+// ============================================================================
+
+typedef struct
+{
+    uint32_t name;
+    uint32_t type;
+    uint64_t flags;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t link;
+    uint32_t info;
+    uint64_t align;
+    uint64_t entsize;
+} ElfShdr;
+
+static uint32_t elf_strtab_add(ElfBuf* b, const char* s)
+{
+    uint32_t off = (uint32_t)b->len;
+    elf_buf_put(b, s, strlen(s) + 1);
+    return off;
+}
+
+static void elf_write_rela(ElfBuf* file, const ElfRelocList* l, const int* sym_index)
+{
+    for (int i = 0; i < l->count; i++)
+    {
+        const ElfReloc* r = &l->items[i];
+        elf_buf_le(file, r->offset, 8);
+        elf_buf_le(file, ((uint64_t)(uint32_t)sym_index[r->sym] << 32) | r->type, 8);
+        elf_buf_le(file, (uint64_t)r->addend, 8);
+    }
+}
+
+/**
+ * @brief تجميع الأقسام والرموز في صورة ELF64 كاملة في الذاكرة.
+ *
+ * تنتقل ملكية الصورة إلى المستدعي عبر out_data عند النجاح.
+ */
+static bool elf_build_image(ElfWriter* w, uint8_t** out_data, size_t* out_size)
+{
+    // ترتيب الجدول: الفارغ، ثم المحلية (رموز الأقسام أولاً)، ثم العامة.
+    int* sym_index = (int*)malloc((size_t)(w->sym_count + 1) * sizeof(int));
+    int* order = (int*)malloc((size_t)(w->sym_count + 1) * sizeof(int));
+    if (!sym_index || !order)
+    {
+        free(sym_index);
+        free(order);
+        return false;
+    }
+    int n = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int i = 0; i < w->sym_count; i++)
+        {
+            if (w->syms[i].local == (pass == 0))
+            {
+                order[n] = i;
+                sym_index[i] = ++n;
+            }
+        }
+        if (pass == 0) sym_index[w->sym_count] = n + 1; // أول رمز عام
+    }
+    uint32_t first_global = (uint32_t)sym_index[w->sym_count];
+
+    static const uint16_t shndx_of[ELF_SEC_COUNT] = {1, 3, 5};
+    ElfBuf strtab = {0};
+    ElfBuf symtab = {0};
+    elf_buf_byte(&strtab, 0);
+    elf_buf_zero(&symtab, 24);
+    for (int k = 0; k < n; k++)
+    {
+        const ElfSymbol* s = &w->syms[order[k]];
+        uint32_t name_off = s->name[0] ? elf_strtab_add(&strtab, s->name) : 0;
+        uint8_t bind = s->local ? ELF_STB_LOCAL : ELF_STB_GLOBAL;
+        elf_buf_le(&symtab, name_off, 4);
+        elf_buf_byte(&symtab, (uint8_t)((bind << 4) | s->type));
+        elf_buf_byte(&symtab, 0);
+        elf_buf_le(&symtab, s->section >= 0 ? shndx_of[s->section] : 0, 2);
+        elf_buf_le(&symtab, s->value, 8);
+        elf_buf_le(&symtab, s->size, 8);
+    }
+
+    ElfBuf shstr = {0};
+    elf_buf_byte(&shstr, 0);
+    ElfShdr sh[11];
+    memset(sh, 0, sizeof(sh));
+    static const char* sec_names[ELF_SEC_COUNT] = {".text", ".data", ".rodata"};
+    static const char* rela_names[ELF_SEC_COUNT] = {".rela.text", ".rela.data", ".rela.rodata"};
+    static const uint64_t sec_flags[ELF_SEC_COUNT] = {
+        ELF_SHF_ALLOC | ELF_SHF_EXECINSTR, ELF_SHF_ALLOC | ELF_SHF_WRITE, ELF_SHF_ALLOC};
+    static const uint64_t sec_align[ELF_SEC_COUNT] = {16, 8, 8};
+
+    ElfBuf file = {0};
+    elf_buf_zero(&file, 64); // الترويسة تُملأ في النهاية
+
+    for (int s = 0; s < ELF_SEC_COUNT; s++)
+    {
+        ElfShdr* p = &sh[shndx_of[s]];
+        ElfShdr* r = &sh[shndx_of[s] + 1];
+        elf_buf_align(&file, (size_t)sec_align[s]);
+        p->name = elf_strtab_add(&shstr, sec_names[s]);
+        p->type = ELF_SHT_PROGBITS;
+        p->flags = sec_flags[s];
+        p->offset = file.len;
+        p->size = w->sec[s].len;
+        p->align = sec_align[s];
+        elf_buf_put(&file, w->sec[s].data, w->sec[s].len);
+
+        elf_buf_align(&file, 8);
+        r->name = elf_strtab_add(&shstr, rela_names[s]);
+        r->type = ELF_SHT_RELA;
+        r->flags = ELF_SHF_INFO_LINK;
+        r->offset = file.len;
+        r->size = (uint64_t)w->rel[s].count * 24u;
+        r->link = 8;
+        r->info = shndx_of[s];
+        r->align = 8;
+        r->entsize = 24;
+        elf_write_rela(&file, &w->rel[s], sym_index);
+    }
+
+    sh[7].name = elf_strtab_add(&shstr, ".note.GNU-stack");
+    sh[7].type = ELF_SHT_PROGBITS;
+    sh[7].offset = file.len;
+    sh[7].align = 1;
+
+    elf_buf_align(&file, 8);
+    sh[8].name = elf_strtab_add(&shstr, ".symtab");
+    sh[8].type = ELF_SHT_SYMTAB;
+    sh[8].offset = file.len;
+    sh[8].size = symtab.len;
+    sh[8].link = 9;
+    sh[8].info = first_global;
+    sh[8].align = 8;
+    sh[8].entsize = 24;
+    elf_buf_put(&file, symtab.data, symtab.len);
+
+    sh[9].name = elf_strtab_add(&shstr, ".strtab");
+    sh[9].type = ELF_SHT_STRTAB;
+    sh[9].offset = file.len;
+    sh[9].size = strtab.len;
+    sh[9].align = 1;
+    elf_buf_put(&file, strtab.data, strtab.len);
+
+    sh[10].name = elf_strtab_add(&shstr, ".shstrtab");
+    sh[10].type = ELF_SHT_STRTAB;
+    sh[10].offset = file.len;
+    sh[10].size = shstr.len;
+    sh[10].align = 1;
+    elf_buf_put(&file, shstr.data, shstr.len);
+
+    elf_buf_align(&file, 8);
+    uint64_t shoff = file.len;
+    for (int i = 0; i < 11; i++)
+    {
+        elf_buf_le(&file, sh[i].name, 4);
+        elf_buf_le(&file, sh[i].type, 4);
+        elf_buf_le(&file, sh[i].flags, 8);
+        elf_buf_le(&file, 0, 8); // sh_addr
+        elf_buf_le(&file, sh[i].offset, 8);
+        elf_buf_le(&file, sh[i].size, 8);
+        elf_buf_le(&file, sh[i].link, 4);
+        elf_buf_le(&file, sh[i].info, 4);
+        elf_buf_le(&file, sh[i].align, 8);
+        elf_buf_le(&file, sh[i].entsize, 8);
+    }
+
+    bool ok = !file.oom && !strtab.oom && !symtab.oom && !shstr.oom;
+    if (ok)
+    {
+        static const uint8_t ident[16] = {0x7F, 'E', 'L', 'F', 2, 1, 1, 0};
+        ElfBuf hdr = {0};
+        elf_buf_put(&hdr, ident, sizeof(ident));
+        elf_buf_le(&hdr, 1, 2);     // ET_REL
+        elf_buf_le(&hdr, 62, 2);    // EM_X86_64
+        elf_buf_le(&hdr, 1, 4);     // EV_CURRENT
+        elf_buf_le(&hdr, 0, 8);     // e_entry
+        elf_buf_le(&hdr, 0, 8);     // e_phoff
+        elf_buf_le(&hdr, shoff, 8);
+        elf_buf_le(&hdr, 0, 4);     // e_flags
+        elf_buf_le(&hdr, 64, 2);    // e_ehsize
+        elf_buf_le(&hdr, 0, 2);
+        elf_buf_le(&hdr, 0, 2);
+        elf_buf_le(&hdr, 64, 2);    // e_shentsize
+        elf_buf_le(&hdr, 11, 2);    // e_shnum
+        elf_buf_le(&hdr, 10, 2);    // e_shstrndx
+        ok = !hdr.oom;
+        if (ok) memcpy(file.data, hdr.data, 64);
+        elf_buf_free(&hdr);
+    }
+    if (ok)
+    {
+        *out_data = file.data;
+        *out_size = file.len;
+        file.data = NULL;
+    }
+
+    elf_buf_free(&file);
+    elf_buf_free(&strtab);
+    elf_buf_free(&symtab);
+    elf_buf_free(&shstr);
+    free(sym_index);
+    free(order);
+    return ok;
+}
+
+// ============================================================================
+// الواجهة العامة (Public API)
+// ============================================================================
+
+static bool elf_writer_init(ElfWriter* w)
+{
+    memset(w, 0, sizeof(*w));
+    for (int s = 0; s < ELF_SEC_COUNT; s++)
+    {
+        w->section_sym[s] = elf_sym_add(w, "", s, ELF_STT_SECTION, true);
+    }
+    return !w->failed && elf_hash_grow(w);
+}
+
+static void elf_writer_free(ElfWriter* w)
+{
+    for (int s = 0; s < ELF_SEC_COUNT; s++)
+    {
+        elf_buf_free(&w->sec[s]);
+        free(w->rel[s].items);
+    }
+    for (int i = 0; i < w->sym_count; i++)
+        free(w->syms[i].name);
+    free(w->syms);
+    free(w->sym_hash);
+    free(w->str_off);
+    free(w->bs_off);
+    memset(w, 0, sizeof(*w));
+}
+
+static bool elf_writer_failed(const ElfWriter* w)
+{
+    if (w->failed) return true;
+    for (int s = 0; s < ELF_SEC_COUNT; s++)
+    {
+        if (w->sec[s].oom) return true;
+    }
+    return false;
+}
+
+static bool elf_write_image(bool ok, uint8_t* data, size_t size, FILE* out)
+{
+    ok = ok && fwrite(data, 1, size, out) == size;
+    free(data);
+    return ok;
+}
+
+bool emit_elf_object_to_memory(MachineModule* module, const BaaTarget* target,
+                               BaaCodegenOptions opts, uint8_t** out_data, size_t* out_size)
+{
+    if (out_data) *out_data = NULL;
+    if (out_size) *out_size = 0;
+    if (!module || !out_data || !out_size || !target || target->obj_format != BAA_OBJFORMAT_ELF)
+        return false;
+
+    ElfWriter w;
+    if (!elf_writer_init(&w))
+    {
+        elf_writer_free(&w);
+        return false;
+    }
+    w.target = target;
+    w.cc = target->cc;
+    w.opts = opts;
+
+    bool ok = elf_emit_rodata_tables(&w, module) && elf_emit_data_section(&w, module);
+
+    ElfFunc f;
+    memset(&f, 0, sizeof(f));
+    f.w = &w;
+    for (MachineFunc* func = module->funcs; ok && func; func = func->next)
+    {
+        ok = elf_emit_func(&f, func);
+    }
+    elf_func_free(&f);
+
+    ok = ok && !elf_writer_failed(&w) && elf_build_image(&w, out_data, out_size);
+    elf_writer_free(&w);
+    return ok;
+}
+
+bool emit_elf_object(MachineModule* module, FILE* out,
+                     const BaaTarget* target, BaaCodegenOptions opts)
+{
+    if (!out) return false;
+    uint8_t* data = NULL;
+    size_t size = 0;
+    bool ok = emit_elf_object_to_memory(module, target, opts, &data, &size);
+    return elf_write_image(ok, data, size, out);
+}
+
+bool emit_elf_startup_to_memory(uint8_t** out_data, size_t* out_size)
+{
+    if (out_data) *out_data = NULL;
+    if (out_size) *out_size = 0;
+    if (!out_data || !out_size) return false;
+
+    ElfWriter w;
+    if (!elf_writer_init(&w))
+    {
+        elf_writer_free(&w);
+        return false;
+    }
+    ElfFunc f;
+    memset(&f, 0, sizeof(f));
+    f.w = &w;
+    bool ok = elf_emit_startup(&f);
+    elf_func_free(&f);
+
+    ok = ok && !elf_writer_failed(&w) && elf_build_image(&w, out_data, out_size);
+    elf_writer_free(&w);
+    return ok;
+}
+
+bool emit_elf_startup_object(FILE* out)
+{
+    if (!out) return false;
+    uint8_t* data = NULL;
+    size_t size = 0;
+    bool ok = emit_elf_startup_to_memory(&data, &size);
+    return elf_write_image(ok, data, size, out);
+}
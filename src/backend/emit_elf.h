@@ -0,0 +1,69 @@
+/**
+ * @file emit_elf.h
+ * @brief كاتب كائنات ELF64 الأصلي - ترميز x86-64 مباشرة بلا مجمّع خارجي.
+ *
+ * يأخذ الوحدة الآلية بعد تخصيص السجلات وترتيب الكتل ويكتب كائناً قابلاً
+ * لإعادة التموضع (ET_REL) بأقسام .text و.data و.rodata وجدول رموز
+ * وrelocations من نوع R_X86_64_PC32/PLT32/64. يطابق دلالياً ما يكتبه
+ * emit_module_ex2() ثم يجمّعه GAS، فيصلح ربطه مع كائنات المسارين معاً.
+ *
+ * المراحل:
+ *   IR → isel → regalloc → ترميز (emit_elf) → ملف .o
+ */
+
+#ifndef BAA_EMIT_ELF_H
+#define BAA_EMIT_ELF_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "isel.h"
+#include "target.h"
+#include "code_model.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief كتابة كائن ELF64 قابل لإعادة التموضع لوحدة آلية كاملة.
+ *
+ * يدعم أهداف ELF على x86-64 فقط، ولا يكتب معلومات DWARF (يبقى -g على GAS).
+ * تُبنى الأقسام في الذاكرة ثم تُكتب دفعة واحدة.
+ *
+ * @param module الوحدة الآلية (بعد تخصيص السجلات).
+ * @param out ملف الخرج (ثنائي).
+ * @param target الهدف (يجب أن يكون obj_format == BAA_OBJFORMAT_ELF).
+ * @param opts خيارات الخلفية (حماية المكدس).
+ * @return صحيح عند النجاح، خطأ عند صيغة تعليمة غير قابلة للترميز أو فشل الكتابة.
+ */
+bool emit_elf_object(MachineModule* module, FILE* out,
+                     const BaaTarget* target, BaaCodegenOptions opts);
+
+/**
+ * @brief مثل emit_elf_object() لكن تبقى صورة الكائن في الذاكرة.
+ *
+ * يفصل الترميز عن الكتابة ليقيس السائق كلاً منهما (assemble_encode/assemble_io).
+ * @param out_data صورة الكائن عند النجاح؛ يحررها المستدعي بـ free().
+ */
+bool emit_elf_object_to_memory(MachineModule* module, const BaaTarget* target,
+                               BaaCodegenOptions opts, uint8_t** out_data, size_t* out_size);
+
+/**
+ * @brief كتابة كائن بدء التشغيل لنقطة الدخول `الرئيسية_بدء` على لينكس.
+ *
+ * يرمّز نفس تعليمات driver_startup_gas_source() لهدف ELF.
+ */
+bool emit_elf_startup_object(FILE* out);
+
+/**
+ * @brief صورة كائن بدء التشغيل في الذاكرة (انظر emit_elf_object_to_memory()).
+ */
+bool emit_elf_startup_to_memory(uint8_t** out_data, size_t* out_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BAA_EMIT_ELF_H
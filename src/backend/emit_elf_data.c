@@ -0,0 +1,262 @@
+// ============================================================================
+// أقسام البيانات (.rodata / .data)
+// ============================================================================
+//
+// نفس محتوى emit_data_section.c بايتاً ببايت، لكن .rodata تُكتب قبل الدوال
+// حتى تُعرف إزاحات .Lstr_N و.Lbs_N عند ترميز التعليمات التي تشير إليها.
+// جداول القفز تُحجز بعدها لكل دالة وتُملأ relocations مدخلاتها بعد التقصير.
+
+/**
+ * @brief جدول معرف → إزاحة بحجم أكبر معرف + ١ (القيم المفقودة UINT64_MAX).
+ */
+static uint64_t* elf_offset_table(int max_id, int* out_cap)
+{
+    int cap = max_id + 1;
+    *out_cap = 0;
+    if (cap <= 0) return NULL;
+    uint64_t* t = (uint64_t*)malloc((size_t)cap * sizeof(uint64_t));
+    if (!t) return NULL;
+    for (int i = 0; i < cap; i++)
+        t[i] = UINT64_MAX;
+    *out_cap = cap;
+    return t;
+}
+
+/**
+ * @brief حروف نص باء: كل حرف UTF-8 خانة ٦٤ بت (البايتات | الطول << 32) ثم خانة صفرية.
+ */
+static void elf_emit_baa_string(ElfBuf* b, const char* content)
+{
+    const unsigned char* p = (const unsigned char*)content;
+    while (*p)
+    {
+        unsigned char b0 = p[0];
+        int len = 0;
+        if ((b0 & 0x80u) == 0x00u) len = 1;
+        else if ((b0 & 0xE0u) == 0xC0u) len = 2;
+        else if ((b0 & 0xF0u) == 0xE0u) len = 3;
+        else if ((b0 & 0xF8u) == 0xF0u) len = 4;
+
+        unsigned char bytes[4] = {0, 0, 0, 0};
+        bool ok = len > 0;
+        for (int i = 0; ok && i < len; i++)
+        {
+            unsigned char bi = p[i];
+            if (bi == 0 || (i > 0 && (bi & 0xC0u) != 0x80u)) ok = false;
+            else bytes[i] = bi;
+        }
+
+        if (!ok)
+        {
+            // U+FFFD مع التقدم بايتاً واحداً كما في emit_baa_string_table().
+            bytes[0] = 0xEF;
+            bytes[1] = 0xBF;
+            bytes[2] = 0xBD;
+            bytes[3] = 0x00;
+            len = 3;
+            p++;
+        }
+        else
+        {
+            p += (size_t)len;
+        }
+
+        uint64_t packed = (uint64_t)bytes[0] | ((uint64_t)bytes[1] << 8) |
+                          ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
+                          ((uint64_t)(unsigned)len << 32);
+        elf_buf_le(b, packed, 8);
+    }
+    elf_buf_le(b, 0, 8);
+}
+
+/**
+ * @brief صيغ الطباعة ثم جدولا النصوص في .rodata مع تسجيل إزاحة كل معرف.
+ */
+static bool elf_emit_rodata_tables(ElfWriter* w, MachineModule* module)
+{
+    static const char fmt[] = "%lld\n\0%s\n\0%lld";
+    ElfBuf* ro = &w->sec[ELF_SEC_RODATA];
+    elf_buf_put(ro, fmt, sizeof(fmt));
+
+    int max_id = -1;
+    for (IRStringEntry* s = module->strings; s; s = s->next)
+        if (s->content && s->id > max_id) max_id = s->id;
+    if (max_id >= 0)
+    {
+        w->str_off = elf_offset_table(max_id, &w->str_cap);
+        if (!w->str_off) return false;
+    }
+    for (IRStringEntry* s = module->strings; s; s = s->next)
+    {
+        if (!s->content || s->id < 0) continue;
+        w->str_off[s->id] = ro->len;
+        elf_buf_put(ro, s->content, strlen(s->content) + 1);
+    }
+
+    max_id = -1;
+    for (IRBaaStringEntry* s = module->baa_strings; s; s = s->next)
+        if (s->content && s->id > max_id) max_id = s->id;
+    if (max_id >= 0)
+    {
+        w->bs_off = elf_offset_table(max_id, &w->bs_cap);
+        if (!w->bs_off) return false;
+    }
+    for (IRBaaStringEntry* s = module->baa_strings; s; s = s->next)
+    {
+        if (!s->content || s->id < 0) continue;
+        elf_buf_align(ro, 8);
+        w->bs_off[s->id] = ro->len;
+        elf_emit_baa_string(ro, s->content);
+    }
+    return !ro->oom;
+}
+
+/**
+ * @brief حجم عنصر عام كما يختاره emit_data_dir_for_type().
+ */
+static int elf_data_size_for_type(IRType* t)
+{
+    if (!t) return 8;
+    switch (t->kind)
+    {
+    case IR_TYPE_I1:
+    case IR_TYPE_I8:
+    case IR_TYPE_U8:
+        return 1;
+    case IR_TYPE_I16:
+    case IR_TYPE_U16:
+        return 2;
+    case IR_TYPE_I32:
+    case IR_TYPE_U32:
+        return 4;
+    default:
+        return 8;
+    }
+}
+
+/**
+ * @brief خانة بيانات واحدة: ثابت صحيح، أو مؤشر (R_X86_64_64) إلى نص/دالة.
+ *
+ * @param allow_str/allow_func هل تقبل الخانة مؤشر نص أو دالة (المصفوفات تشترط نوع العنصر).
+ */
+static void elf_emit_data_value(ElfWriter* w, IRValue* v, int size, bool allow_str, bool allow_func)
+{
+    ElfBuf* data = &w->sec[ELF_SEC_DATA];
+    if (v && v->kind == IR_VAL_CONST_INT)
+    {
+        elf_buf_le(data, (uint64_t)v->data.const_int, size);
+        return;
+    }
+
+    const char* name = NULL;
+    char label[32];
+    if (v && allow_str && v->kind == IR_VAL_CONST_STR)
+    {
+        snprintf(label, sizeof(label), ".Lstr_%d", v->data.const_str.id);
+        name = label;
+    }
+    else if (v && allow_str && v->kind == IR_VAL_BAA_STR)
+    {
+        snprintf(label, sizeof(label), ".Lbs_%d", v->data.const_str.id);
+        name = label;
+    }
+    else if (v && allow_func && v->kind == IR_VAL_FUNC)
+    {
+        name = elf_func_symbol_name(v->data.global_name);
+    }
+    if (!name)
+    {
+        elf_buf_le(data, 0, size);
+        return;
+    }
+
+    // GAS يكتب .quad لهذه المراجع مهما كان عرض النوع.
+    int sym = -1;
+    int64_t addend = 0;
+    if (!elf_resolve_global(w, name, &sym, &addend))
+    {
+        w->failed = true;
+        return;
+    }
+    elf_reloc_add(w, ELF_SEC_DATA, data->len, sym, ELF_R_X86_64_64, addend);
+    elf_buf_le(data, 0, 8);
+}
+
+/**
+ * @brief المتغيرات العامة في .data بنفس ترتيب وتخطيط emit_data_section().
+ */
+static bool elf_emit_data_section(ElfWriter* w, MachineModule* module)
+{
+    if (module->global_count == 0) return true;
+
+    ElfBuf* data = &w->sec[ELF_SEC_DATA];
+    for (IRGlobal* g = module->globals; g; g = g->next)
+    {
+        if (!g->name || g->is_extern) continue;
+
+        int sym = elf_sym_define(w, g->name, ELF_SEC_DATA, ELF_STT_OBJECT, g->is_internal);
+        if (sym < 0) return false;
+        uint64_t start = data->len;
+
+        if (g->type && g->type->kind == IR_TYPE_ARRAY)
+        {
+            IRType* elem_t = g->type->data.array.element;
+            int count = g->type->data.array.count;
+            int elem_size = elf_data_size_for_type(elem_t);
+            if (count < 0) count = 0;
+            bool elem_ptr = elem_t && elem_t->kind == IR_TYPE_PTR;
+            bool elem_func = elem_t && elem_t->kind == IR_TYPE_FUNC;
+            for (int i = 0; i < count; i++)
+            {
+                IRValue* v = (g->init_elems && i < g->init_elem_count) ? g->init_elems[i] : NULL;
+                elf_emit_data_value(w, v, elem_size, elem_ptr, elem_func);
+            }
+        }
+        else
+        {
+            elf_emit_data_value(w, g->init, elf_data_size_for_type(g->type), true, true);
+        }
+        w->syms[sym].size = data->len - start;
+    }
+    return !data->oom && !w->failed;
+}
+
+/**
+ * @brief حجز جداول قفز الدالة في .rodata (محاذاة ٤) وإرجاع إزاحة كل جدول.
+ */
+static uint64_t* elf_reserve_jump_tables(ElfWriter* w, const MachineFunc* func)
+{
+    uint64_t* off = (uint64_t*)malloc((size_t)func->jump_table_count * sizeof(uint64_t));
+    if (!off) return NULL;
+    ElfBuf* ro = &w->sec[ELF_SEC_RODATA];
+    for (int t = 0; t < func->jump_table_count; t++)
+    {
+        elf_buf_align(ro, 4);
+        off[t] = ro->len;
+        for (int i = 0; i < func->jump_tables[t].count; i++)
+            elf_buf_le(ro, 0, 4);
+    }
+    return off;
+}
+
+/**
+ * @brief مدخل الجدول = .LBB - .LJT عبر R_X86_64_PC32 إلى رمز .text:
+ * S + A - P حيث A = موضع الكتلة + بعد المدخل عن بداية جدوله.
+ */
+static bool elf_fill_jump_tables(ElfFunc* f, const MachineFunc* func, const uint64_t* jt_off, uint64_t start)
+{
+    for (int t = 0; t < func->jump_table_count; t++)
+    {
+        const MachineJumpTable* jt = &func->jump_tables[t];
+        for (int i = 0; i < jt->count; i++)
+        {
+            int label = jt->label_ids[i];
+            if (label < 0 || label >= f->label_cap || f->labels[label].pos == ELF_LABEL_UNDEF) return false;
+            uint64_t entry = jt_off[t] + 4u * (uint64_t)i;
+            int64_t addend = (int64_t)(start + elf_label_final(f, label)) + 4 * (int64_t)i;
+            elf_reloc_add(f->w, ELF_SEC_RODATA, entry, f->w->section_sym[ELF_SEC_TEXT],
+                          ELF_R_X86_64_PC32, addend);
+        }
+    }
+    return !f->w->failed;
+}
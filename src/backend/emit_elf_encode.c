@@ -0,0 +1,491 @@
+// ============================================================================
+// ترميز x86-64 لدالة واحدة (Per-Function x86-64 Encoding)
+// ============================================================================
+//
+// تُرمَّز الدالة في مخزن "مستقيم" بلا القفزات إلى التسميات؛ كل قفزة تُسجَّل
+// بموضعها في المخزن وتُقرَّر سعتها لاحقاً (rel8 أو rel32). كل تسمية أو
+// relocation يحفظ عدد القفزات المسجلة قبله (nb)، فموضعه النهائي هو موضعه
+// المستقيم + مجموع أطوال تلك القفزات. التقصير يبدأ بكل القفزات قصيرة ويطيل
+// ما لا تصله إزاحة ٨ بت حتى الثبات، وهو رتيب (الإطالة لا تقصّر مسافة أخرى).
+
+#define ELF_LABEL_UNDEF SIZE_MAX
+#define ELF_JMP_CC 0xFFu
+
+typedef struct
+{
+    size_t pos;
+    int label;
+    uint8_t cc;      // رمز الشرط أو ELF_JMP_CC
+    bool is_long;
+} ElfBranch;
+
+typedef struct
+{
+    size_t pos;
+    int nb;
+} ElfLabelPos;
+
+typedef struct
+{
+    size_t pos;
+    int nb;
+    int sym;
+    uint32_t type;
+    int64_t addend;
+} ElfFixup;
+
+typedef struct
+{
+    ElfWriter* w;
+    ElfBuf code;
+
+    ElfBranch* br;
+    int br_count;
+    int br_cap;
+
+    ElfLabelPos* labels;
+    int label_cap;
+
+    ElfFixup* fix;
+    int fix_count;
+    int fix_cap;
+
+    size_t* prefix;  // prefix[j] = مجموع أطوال القفزات قبل j
+    int prefix_cap;
+
+    // حالة الدالة الجارية (مثل EmitContext في emit.c)
+    MachineFunc* func;
+    PhysReg callee_regs[16];
+    int callee_count;
+    int sp_label_next;
+    bool failed;
+} ElfFunc;
+
+static void elf_func_free(ElfFunc* f)
+{
+    elf_buf_free(&f->code);
+    free(f->br);
+    free(f->labels);
+    free(f->fix);
+    free(f->prefix);
+    memset(f, 0, sizeof(*f));
+}
+
+static void elf_byte(ElfFunc* f, uint8_t v)
+{
+    elf_buf_byte(&f->code, v);
+}
+
+static void elf_bytes(ElfFunc* f, const uint8_t* p, size_t n)
+{
+    elf_buf_put(&f->code, p, n);
+}
+
+static bool elf_fits_i8(int64_t v)
+{
+    return v >= -128 && v <= 127;
+}
+
+static bool elf_fits_i32(int64_t v)
+{
+    return v >= (int64_t)INT32_MIN && v <= (int64_t)INT32_MAX;
+}
+
+static bool elf_label_slot(ElfFunc* f, int label)
+{
+    if (label < 0)
+    {
+        f->failed = true;
+        return false;
+    }
+    if (label < f->label_cap) return true;
+    int cap = f->label_cap ? f->label_cap : 64;
+    while (cap <= label) cap *= 2;
+    ElfLabelPos* p = (ElfLabelPos*)realloc(f->labels, (size_t)cap * sizeof(ElfLabelPos));
+    if (!p)
+    {
+        f->failed = true;
+        return false;
+    }
+    for (int i = f->label_cap; i < cap; i++)
+        p[i].pos = ELF_LABEL_UNDEF;
+    f->labels = p;
+    f->label_cap = cap;
+    return true;
+}
+
+static void elf_define_label(ElfFunc* f, int label)
+{
+    if (!elf_label_slot(f, label)) return;
+    if (f->labels[label].pos != ELF_LABEL_UNDEF)
+    {
+        f->failed = true; // تسمية مكررة
+        return;
+    }
+    f->labels[label].pos = f->code.len;
+    f->labels[label].nb = f->br_count;
+}
+
+/**
+ * @brief تسجيل قفزة (غير مشروطة عند cc == ELF_JMP_CC) إلى تسمية داخل الدالة.
+ */
+static void elf_branch(ElfFunc* f, uint8_t cc, int label)
+{
+    if (!elf_label_slot(f, label)) return;
+    if (f->br_count >= f->br_cap)
+    {
+        int cap = f->br_cap ? f->br_cap * 2 : 64;
+        ElfBranch* p = (ElfBranch*)realloc(f->br, (size_t)cap * sizeof(ElfBranch));
+        if (!p)
+        {
+            f->failed = true;
+            return;
+        }
+        f->br = p;
+        f->br_cap = cap;
+    }
+    f->br[f->br_count].pos = f->code.len;
+    f->br[f->br_count].label = label;
+    f->br[f->br_count].cc = cc;
+    f->br[f->br_count].is_long = false;
+    f->br_count++;
+}
+
+/**
+ * @brief تسجيل relocation لحقل ٣٢ بت يبدأ عند الموضع الحالي في المخزن.
+ */
+static void elf_fixup(ElfFunc* f, int sym, uint32_t type, int64_t addend)
+{
+    if (sym < 0)
+    {
+        f->failed = true;
+        return;
+    }
+    if (f->fix_count >= f->fix_cap)
+    {
+        int cap = f->fix_cap ? f->fix_cap * 2 : 64;
+        ElfFixup* p = (ElfFixup*)realloc(f->fix, (size_t)cap * sizeof(ElfFixup));
+        if (!p)
+        {
+            f->failed = true;
+            return;
+        }
+        f->fix = p;
+        f->fix_cap = cap;
+    }
+    f->fix[f->fix_count].pos = f->code.len;
+    f->fix[f->fix_count].nb = f->br_count;
+    f->fix[f->fix_count].sym = sym;
+    f->fix[f->fix_count].type = type;
+    f->fix[f->fix_count].addend = addend;
+    f->fix_count++;
+}
+
+/**
+ * @brief call/jmp مباشر إلى رمز (E8/E9 + R_X86_64_PLT32) كما يكتبه GAS.
+ */
+static void elf_call_symbol(ElfFunc* f, uint8_t opcode, int sym)
+{
+    elf_byte(f, opcode);
+    elf_fixup(f, sym, ELF_R_X86_64_PLT32, -4);
+    elf_buf_le(&f->code, 0, 4);
+}
+
+static int elf_branch_size(const ElfBranch* b)
+{
+    if (!b->is_long) return 2;
+    return b->cc == ELF_JMP_CC ? 5 : 6;
+}
+
+static size_t elf_label_final(const ElfFunc* f, int label)
+{
+    return f->labels[label].pos + f->prefix[f->labels[label].nb];
+}
+
+/**
+ * @brief تقرير سعة كل قفزة حتى الثبات ثم حساب مواضع prefix النهائية.
+ */
+static bool elf_func_relax(ElfFunc* f)
+{
+    if (f->br_count + 1 > f->prefix_cap)
+    {
+        size_t* p = (size_t*)realloc(f->prefix, (size_t)(f->br_count + 1) * sizeof(size_t));
+        if (!p) return false;
+        f->prefix = p;
+        f->prefix_cap = f->br_count + 1;
+    }
+    for (int j = 0; j < f->br_count; j++)
+    {
+        int label = f->br[j].label;
+        if (label >= f->label_cap || f->labels[label].pos == ELF_LABEL_UNDEF) return false;
+    }
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        f->prefix[0] = 0;
+        for (int j = 0; j < f->br_count; j++)
+            f->prefix[j + 1] = f->prefix[j] + (size_t)elf_branch_size(&f->br[j]);
+        for (int j = 0; j < f->br_count; j++)
+        {
+            ElfBranch* b = &f->br[j];
+            if (b->is_long) continue;
+            int64_t end = (int64_t)(b->pos + f->prefix[j]) + 2;
+            int64_t disp = (int64_t)elf_label_final(f, b->label) - end;
+            if (!elf_fits_i8(disp))
+            {
+                b->is_long = true;
+                changed = true;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief نسخ الدالة المرمّزة إلى .text مع القفزات والـ relocations في مواضعها النهائية.
+ */
+static bool elf_func_flush(ElfFunc* f, uint64_t* out_start, uint64_t* out_size)
+{
+    if (f->failed || f->code.oom || !elf_func_relax(f)) return false;
+
+    ElfBuf* text = &f->w->sec[ELF_SEC_TEXT];
+    uint64_t start = text->len;
+    size_t cursor = 0;
+    for (int j = 0; j < f->br_count; j++)
+    {
+        const ElfBranch* b = &f->br[j];
+        elf_buf_put(text, f->code.data + cursor, b->pos - cursor);
+        cursor = b->pos;
+
+        int size = elf_branch_size(b);
+        int64_t end = (int64_t)(b->pos + f->prefix[j]) + size;
+        int64_t disp = (int64_t)elf_label_final(f, b->label) - end;
+        if (!b->is_long)
+        {
+            elf_buf_byte(text, b->cc == ELF_JMP_CC ? 0xEB : (uint8_t)(0x70 | b->cc));
+            elf_buf_byte(text, (uint8_t)(int8_t)disp);
+        }
+        else
+        {
+            if (b->cc == ELF_JMP_CC)
+            {
+                elf_buf_byte(text, 0xE9);
+            }
+            else
+            {
+                elf_buf_byte(text, 0x0F);
+                elf_buf_byte(text, (uint8_t)(0x80 | b->cc));
+            }
+            elf_buf_le(text, (uint64_t)(uint32_t)(int32_t)disp, 4);
+        }
+    }
+    elf_buf_put(text, f->code.data + cursor, f->code.len - cursor);
+
+    for (int i = 0; i < f->fix_count; i++)
+    {
+        const ElfFixup* x = &f->fix[i];
+        elf_reloc_add(f->w, ELF_SEC_TEXT, start + x->pos + f->prefix[x->nb], x->sym, x->type, x->addend);
+    }
+
+    *out_start = start;
+    *out_size = text->len - start;
+    return !text->oom;
+}
+
+static void elf_func_reset(ElfFunc* f)
+{
+    f->code.len = 0;
+    f->br_count = 0;
+    f->fix_count = 0;
+    for (int i = 0; i < f->label_cap; i++)
+        f->labels[i].pos = ELF_LABEL_UNDEF;
+    f->failed = false;
+}
+
+// ============================================================================
+// ModRM/SIB/REX
+// ============================================================================
+
+typedef enum
+{
+    ELF_RM_REG,
+    ELF_RM_MEM,
+    ELF_RM_RIP,
+} ElfRmKind;
+
+/**
+ * @brief معامل r/m محلول: سجل، أو [base + index*scale + disp]، أو رمز نسبي لـ RIP.
+ */
+typedef struct
+{
+    ElfRmKind kind;
+    int reg;          // ELF_RM_REG: رقم السجل (GPR أو XMM)
+    int base;         // ELF_RM_MEM
+    int index;        // -1 بلا فهرس
+    int scale_log2;
+    int32_t disp;
+    int sym;          // ELF_RM_RIP
+    int64_t addend;
+} ElfRm;
+
+static ElfRm elf_rm_reg(int reg)
+{
+    ElfRm rm;
+    memset(&rm, 0, sizeof(rm));
+    rm.kind = ELF_RM_REG;
+    rm.reg = reg;
+    rm.index = -1;
+    return rm;
+}
+
+static ElfRm elf_rm_mem(int base, int32_t disp)
+{
+    ElfRm rm = elf_rm_reg(0);
+    rm.kind = ELF_RM_MEM;
+    rm.base = base;
+    rm.disp = disp;
+    return rm;
+}
+
+static ElfRm elf_rm_rip(int sym, int64_t addend)
+{
+    ElfRm rm = elf_rm_reg(0);
+    rm.kind = ELF_RM_RIP;
+    rm.sym = sym;
+    rm.addend = addend;
+    return rm;
+}
+
+/**
+ * @brief تحويل معامل آلة إلى r/m (سجل/XMM/ذاكرة/عام).
+ */
+static bool elf_rm_from_operand(ElfFunc* f, const MachineOperand* op, ElfRm* rm)
+{
+    switch (op->kind)
+    {
+    case MACH_OP_VREG:
+        if (op->data.vreg < 0 || op->data.vreg >= PHYS_REG_COUNT) return false;
+        *rm = elf_rm_reg(op->data.vreg);
+        return true;
+    case MACH_OP_XMM:
+        if (op->data.xmm < 0 || op->data.xmm > 15) return false;
+        *rm = elf_rm_reg(op->data.xmm);
+        return true;
+    case MACH_OP_MEM:
+    {
+        // emit_operand يطبع %rbp لقاعدة غير محلولة.
+        int base = op->data.mem.base_vreg;
+        if (base < 0 || base >= PHYS_REG_COUNT) base = PHYS_RBP;
+        *rm = elf_rm_mem(base, op->data.mem.offset);
+        return true;
+    }
+    case MACH_OP_GLOBAL:
+    {
+        int sym = -1;
+        int64_t addend = 0;
+        if (!elf_resolve_global(f->w, op->data.name, &sym, &addend)) return false;
+        *rm = elf_rm_rip(sym, addend);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+// أعلام elf_emit_rm
+#define ELF_W 0x1u        // REX.W
+#define ELF_REG8 0x2u     // حقل reg سجل ٨ بت (يتطلب REX لـ spl..dil)
+#define ELF_RM8 0x4u      // r/m سجل ٨ بت
+
+/**
+ * @brief ترميز تعليمة عامة:
+ * [بادئة] [REX] كود(١-٣ بايت) ModRM [SIB] [إزاحة] [فوري بعرض imm_bytes].
+ *
+ * @param prefix 0 أو 0x66 (حجم ١٦) أو بادئة SSE إلزامية (0x66/0xF2/0xF3).
+ * @param reg رقم سجل حقل reg أو امتداد الكود (/digit).
+ */
+static void elf_emit_rm(ElfFunc* f, uint8_t prefix, unsigned flags,
+                        const uint8_t* opc, int opc_len, int reg,
+                        const ElfRm* rm, int imm_bytes, int64_t imm)
+{
+    if (prefix) elf_byte(f, prefix);
+
+    uint8_t rex = 0x40;
+    if (flags & ELF_W) rex |= 0x08;
+    if (reg & 8) rex |= 0x04;
+    bool force = (flags & ELF_REG8) && reg >= 4 && reg <= 7;
+    if (rm->kind == ELF_RM_REG)
+    {
+        if (rm->reg & 8) rex |= 0x01;
+        if ((flags & ELF_RM8) && rm->reg >= 4 && rm->reg <= 7) force = true;
+    }
+    else if (rm->kind == ELF_RM_MEM)
+    {
+        if (rm->base & 8) rex |= 0x01;
+        if (rm->index >= 0 && (rm->index & 8)) rex |= 0x02;
+    }
+    if (rex != 0x40 || force) elf_byte(f, rex);
+    elf_bytes(f, opc, (size_t)opc_len);
+
+    uint8_t r = (uint8_t)((reg & 7) << 3);
+    if (rm->kind == ELF_RM_REG)
+    {
+        elf_byte(f, (uint8_t)(0xC0 | r | (rm->reg & 7)));
+    }
+    else if (rm->kind == ELF_RM_RIP)
+    {
+        elf_byte(f, (uint8_t)(0x05 | r));
+        // الإزاحة نسبية لنهاية التعليمة، أي بعد الفوري إن وُجد.
+        elf_fixup(f, rm->sym, ELF_R_X86_64_PC32, rm->addend - 4 - imm_bytes);
+        elf_buf_le(&f->code, 0, 4);
+    }
+    else
+    {
+        int b = rm->base & 7;
+        bool sib = rm->index >= 0 || b == 4;
+        int mod = 2;
+        if (rm->disp == 0 && b != 5) mod = 0;
+        else if (elf_fits_i8(rm->disp)) mod = 1;
+        elf_byte(f, (uint8_t)((mod << 6) | r | (sib ? 4 : b)));
+        if (sib)
+        {
+            int idx = rm->index >= 0 ? (rm->index & 7) : 4;
+            elf_byte(f, (uint8_t)((rm->scale_log2 << 6) | (idx << 3) | b));
+        }
+        if (mod == 1) elf_byte(f, (uint8_t)(int8_t)rm->disp);
+        else if (mod == 2) elf_buf_le(&f->code, (uint64_t)(uint32_t)rm->disp, 4);
+    }
+
+    if (imm_bytes > 0) elf_buf_le(&f->code, (uint64_t)imm, imm_bytes);
+}
+
+/**
+ * @brief صيغ "الكود + رقم السجل" (push/pop/mov imm → reg).
+ */
+static void elf_emit_opreg(ElfFunc* f, uint8_t prefix, unsigned flags, uint8_t opcode, int reg)
+{
+    if (prefix) elf_byte(f, prefix);
+    uint8_t rex = 0x40;
+    if (flags & ELF_W) rex |= 0x08;
+    if (reg & 8) rex |= 0x01;
+    bool force = (flags & ELF_REG8) && reg >= 4 && reg <= 7;
+    if (rex != 0x40 || force) elf_byte(f, rex);
+    elf_byte(f, (uint8_t)(opcode + (reg & 7)));
+}
+
+/**
+ * @brief بادئة الحجم وأعلام REX لعرض عملية صحيحة (٨/١٦/٣٢/٦٤).
+ */
+static uint8_t elf_size_prefix(int bits)
+{
+    return bits == 16 ? 0x66 : 0;
+}
+
+static unsigned elf_size_flags(int bits)
+{
+    if (bits == 64) return ELF_W;
+    if (bits == 8) return ELF_REG8 | ELF_RM8;
+    return 0;
+}
@@ -0,0 +1,969 @@
+// ============================================================================
+// ترجمة تعليمات الآلة إلى بايتات (Instruction Encoding)
+// ============================================================================
+//
+// كل حالة تطابق ما يطبعه emit_inst_body_*.inc وemit_frame.c، بما فيها
+// المرور عبر RAX/R11 عند ذاكرة-إلى-ذاكرة أو imm64. الصيغ التي يرفضها GAS
+// (مثل imul بوجهة ذاكرة) تُفشل الترميز بدل توليد بايتات خاطئة.
+
+static const uint8_t k_elf_jcc[] = {
+    [MACH_JE] = 0x4, [MACH_JNE] = 0x5, [MACH_JG] = 0xF, [MACH_JL] = 0xC,
+    [MACH_JGE] = 0xD, [MACH_JLE] = 0xE, [MACH_JA] = 0x7, [MACH_JB] = 0x2,
+    [MACH_JAE] = 0x3, [MACH_JBE] = 0x6, [MACH_JP] = 0xA, [MACH_JNP] = 0xB,
+};
+
+static const uint8_t k_elf_setcc[] = {
+    [MACH_SETE] = 0x4, [MACH_SETNE] = 0x5, [MACH_SETG] = 0xF, [MACH_SETL] = 0xC,
+    [MACH_SETGE] = 0xD, [MACH_SETLE] = 0xE, [MACH_SETA] = 0x7, [MACH_SETB] = 0x2,
+    [MACH_SETAE] = 0x3, [MACH_SETBE] = 0x6, [MACH_SETP] = 0xA, [MACH_SETNP] = 0xB,
+};
+
+static int elf_bits(int bits)
+{
+    return (bits == 8 || bits == 16 || bits == 32) ? bits : 64;
+}
+
+/**
+ * @brief عرض العملية كما تختاره infer_suffix (dst ثم src1 ثم src2).
+ */
+static int elf_infer_bits(const MachineInst* inst)
+{
+    if (inst->dst.size_bits > 0) return elf_bits(inst->dst.size_bits);
+    if (inst->src1.size_bits > 0) return elf_bits(inst->src1.size_bits);
+    if (inst->src2.size_bits > 0) return elf_bits(inst->src2.size_bits);
+    return 64;
+}
+
+static bool elf_is_mem(const MachineOperand* op)
+{
+    return op->kind == MACH_OP_MEM || op->kind == MACH_OP_GLOBAL;
+}
+
+static bool elf_is_gpr(const MachineOperand* op)
+{
+    return op->kind == MACH_OP_VREG && op->data.vreg >= 0 && op->data.vreg < PHYS_REG_COUNT;
+}
+
+static MachineOperand elf_gpr(int reg, int bits)
+{
+    return mach_op_vreg(reg, bits);
+}
+
+/**
+ * @brief قيمة فورية مقتطعة لعرض الحقل.
+ */
+static int elf_imm_bytes(int bits)
+{
+    if (bits == 8) return 1;
+    if (bits == 16) return 2;
+    return 4;
+}
+
+/**
+ * @brief mov بعرض bits بين سجل/ذاكرة/فوري/XMM (بدون imm64).
+ */
+static bool elf_mov(ElfFunc* f, int bits, const MachineOperand* dst, const MachineOperand* src)
+{
+    ElfRm rm;
+    uint8_t p = elf_size_prefix(bits);
+    unsigned fl = elf_size_flags(bits);
+
+    if (dst->kind == MACH_OP_XMM || src->kind == MACH_OP_XMM)
+    {
+        // movq بين XMM وسجل عام أو ذاكرة.
+        unsigned w = bits == 64 ? ELF_W : 0;
+        if (dst->kind == MACH_OP_XMM && src->kind == MACH_OP_XMM)
+        {
+            static const uint8_t op[] = {0x0F, 0x7E};
+            if (!elf_rm_from_operand(f, src, &rm)) return false;
+            elf_emit_rm(f, 0xF3, 0, op, 2, dst->data.xmm, &rm, 0, 0);
+            return true;
+        }
+        if (dst->kind == MACH_OP_XMM)
+        {
+            if (!elf_rm_from_operand(f, src, &rm) || src->kind == MACH_OP_IMM) return false;
+            if (rm.kind == ELF_RM_REG)
+            {
+                static const uint8_t op[] = {0x0F, 0x6E};
+                elf_emit_rm(f, 0x66, w, op, 2, dst->data.xmm, &rm, 0, 0);
+            }
+            else
+            {
+                static const uint8_t op[] = {0x0F, 0x7E};
+                elf_emit_rm(f, 0xF3, 0, op, 2, dst->data.xmm, &rm, 0, 0);
+            }
+            return true;
+        }
+        if (!elf_rm_from_operand(f, dst, &rm)) return false;
+        if (rm.kind == ELF_RM_REG)
+        {
+            static const uint8_t op[] = {0x0F, 0x7E};
+            elf_emit_rm(f, 0x66, w, op, 2, src->data.xmm, &rm, 0, 0);
+        }
+        else
+        {
+            static const uint8_t op[] = {0x0F, 0xD6};
+            elf_emit_rm(f, 0x66, 0, op, 2, src->data.xmm, &rm, 0, 0);
+        }
+        return true;
+    }
+
+    if (src->kind == MACH_OP_IMM)
+    {
+        int64_t imm = src->data.imm;
+        if (bits == 64 && !elf_fits_i32(imm)) return false;
+        if (elf_is_gpr(dst) && bits != 64)
+        {
+            elf_emit_opreg(f, p, fl, bits == 8 ? 0xB0 : 0xB8, dst->data.vreg);
+            elf_buf_le(&f->code, (uint64_t)imm, elf_imm_bytes(bits));
+            return true;
+        }
+        if (!elf_rm_from_operand(f, dst, &rm)) return false;
+        uint8_t op = bits == 8 ? 0xC6 : 0xC7;
+        elf_emit_rm(f, p, fl, &op, 1, 0, &rm, elf_imm_bytes(bits), imm);
+        return true;
+    }
+
+    if (elf_is_gpr(src))
+    {
+        if (!elf_rm_from_operand(f, dst, &rm)) return false;
+        uint8_t op = bits == 8 ? 0x88 : 0x89;
+        elf_emit_rm(f, p, fl, &op, 1, src->data.vreg, &rm, 0, 0);
+        return true;
+    }
+
+    if (elf_is_mem(src) && elf_is_gpr(dst))
+    {
+        if (!elf_rm_from_operand(f, src, &rm)) return false;
+        uint8_t op = bits == 8 ? 0x8A : 0x8B;
+        elf_emit_rm(f, p, fl, &op, 1, dst->data.vreg, &rm, 0, 0);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief movabsq $imm64, %reg.
+ */
+static bool elf_movabs(ElfFunc* f, const MachineOperand* dst, int64_t imm)
+{
+    if (!elf_is_gpr(dst)) return false;
+    elf_emit_opreg(f, 0, ELF_W, 0xB8, dst->data.vreg);
+    elf_buf_le(&f->code, (uint64_t)imm, 8);
+    return true;
+}
+
+/**
+ * @brief عمليات ALU الثنائية بامتداد /digit: add=0 or=1 and=4 sub=5 xor=6 cmp=7.
+ *
+ * AT&T: `op src, dst`؛ الوجهة r/m والمصدر سجل أو فوري أو ذاكرة (مع وجهة سجل).
+ */
+static bool elf_alu(ElfFunc* f, int digit, int bits, const MachineOperand* dst, const MachineOperand* src)
+{
+    ElfRm rm;
+    uint8_t p = elf_size_prefix(bits);
+    unsigned fl = elf_size_flags(bits);
+
+    if (src->kind == MACH_OP_IMM)
+    {
+        int64_t imm = src->data.imm;
+        if (bits == 64 && !elf_fits_i32(imm)) return false;
+        if (!elf_rm_from_operand(f, dst, &rm)) return false;
+        uint8_t op;
+        int n;
+        if (bits == 8)
+        {
+            op = 0x80;
+            n = 1;
+        }
+        else if (elf_fits_i8(bits == 16 ? (int16_t)imm : bits == 32 ? (int32_t)imm : imm))
+        {
+            op = 0x83;
+            n = 1;
+        }
+        else
+        {
+            op = 0x81;
+            n = elf_imm_bytes(bits);
+        }
+        elf_emit_rm(f, p, fl, &op, 1, digit, &rm, n, imm);
+        return true;
+    }
+    if (elf_is_gpr(src))
+    {
+        if (!elf_rm_from_operand(f, dst, &rm)) return false;
+        uint8_t op = (uint8_t)((digit << 3) | (bits == 8 ? 0 : 1));
+        elf_emit_rm(f, p, fl, &op, 1, src->data.vreg, &rm, 0, 0);
+        return true;
+    }
+    if (elf_is_mem(src) && elf_is_gpr(dst))
+    {
+        if (!elf_rm_from_operand(f, src, &rm)) return false;
+        uint8_t op = (uint8_t)((digit << 3) | (bits == 8 ? 2 : 3));
+        elf_emit_rm(f, p, fl, &op, 1, dst->data.vreg, &rm, 0, 0);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief test src2, src1 (تبادلية: الذاكرة دائماً في r/m).
+ */
+static bool elf_test(ElfFunc* f, int bits, const MachineOperand* a, const MachineOperand* b)
+{
+    ElfRm rm;
+    uint8_t p = elf_size_prefix(bits);
+    unsigned fl = elf_size_flags(bits);
+    if (b->kind == MACH_OP_IMM)
+    {
+        if (bits == 64 && !elf_fits_i32(b->data.imm)) return false;
+        if (!elf_rm_from_operand(f, a, &rm)) return false;
+        uint8_t op = bits == 8 ? 0xF6 : 0xF7;
+        elf_emit_rm(f, p, fl, &op, 1, 0, &rm, elf_imm_bytes(bits), b->data.imm);
+        return true;
+    }
+    const MachineOperand* reg = elf_is_gpr(b) ? b : a;
+    const MachineOperand* other = reg == b ? a : b;
+    if (!elf_is_gpr(reg) || !elf_rm_from_operand(f, other, &rm)) return false;
+    uint8_t op = bits == 8 ? 0x84 : 0x85;
+    elf_emit_rm(f, p, fl, &op, 1, reg->data.vreg, &rm, 0, 0);
+    return true;
+}
+
+/**
+ * @brief إزاحات shl=/4 shr=/5 sar=/7 بفوري أو بـ %cl.
+ */
+static bool elf_shift(ElfFunc* f, int digit, int bits, const MachineOperand* dst, const MachineOperand* cnt)
+{
+    ElfRm rm;
+    if (!elf_rm_from_operand(f, dst, &rm)) return false;
+    uint8_t p = elf_size_prefix(bits);
+    unsigned fl = elf_size_flags(bits);
+    if (cnt->kind == MACH_OP_IMM && cnt->data.imm == 1)
+    {
+        // GAS يختار صيغة الإزاحة بواحد (D0/D1) الأقصر.
+        uint8_t op = bits == 8 ? 0xD0 : 0xD1;
+        elf_emit_rm(f, p, fl, &op, 1, digit, &rm, 0, 0);
+        return true;
+    }
+    if (cnt->kind == MACH_OP_IMM)
+    {
+        uint8_t op = bits == 8 ? 0xC0 : 0xC1;
+        elf_emit_rm(f, p, fl, &op, 1, digit, &rm, 1, cnt->data.imm);
+        return true;
+    }
+    if (cnt->kind == MACH_OP_VREG && cnt->data.vreg == PHYS_RCX)
+    {
+        uint8_t op = bits == 8 ? 0xD2 : 0xD3;
+        elf_emit_rm(f, p, fl, &op, 1, digit, &rm, 0, 0);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief تعليمات F6/F7 أحادية المعامل (not=/2 neg=/3 div=/6 idiv=/7).
+ */
+static bool elf_unary(ElfFunc* f, int digit, int bits, const MachineOperand* opnd)
+{
+    ElfRm rm;
+    if (!elf_rm_from_operand(f, opnd, &rm)) return false;
+    uint8_t op = bits == 8 ? 0xF6 : 0xF7;
+    elf_emit_rm(f, elf_size_prefix(bits), elf_size_flags(bits), &op, 1, digit, &rm, 0, 0);
+    return true;
+}
+
+/**
+ * @brief تعليمة SSE2 بصيغة `prefix 0F op /r` مع XMM في حقل reg.
+ */
+static bool elf_sse(ElfFunc* f, uint8_t prefix, uint8_t op2, unsigned flags, int reg, const MachineOperand* src)
+{
+    ElfRm rm;
+    if (!elf_rm_from_operand(f, src, &rm) || src->kind == MACH_OP_IMM) return false;
+    uint8_t op[2] = {0x0F, op2};
+    elf_emit_rm(f, prefix, flags, op, 2, reg, &rm, 0, 0);
+    return true;
+}
+
+/**
+ * @brief lea عنوان المصدر إلى سجل ٦٤ بت.
+ */
+static bool elf_lea(ElfFunc* f, int reg, const MachineOperand* src)
+{
+    ElfRm rm;
+    if (!elf_is_mem(src) || !elf_rm_from_operand(f, src, &rm)) return false;
+    uint8_t op = 0x8D;
+    elf_emit_rm(f, 0, ELF_W, &op, 1, reg, &rm, 0, 0);
+    return true;
+}
+
+/**
+ * @brief movzx/movsx بحسب عرضي المصدر والوجهة، مع صيغ mov الاحتياطية في GAS.
+ */
+static bool elf_extend(ElfFunc* f, bool sign, int sb, int db, const MachineOperand* dst, const MachineOperand* src)
+{
+    ElfRm rm;
+    if (!elf_is_gpr(dst)) return false;
+    if (sb == db || (!sign && sb == 32 && db == 64))
+    {
+        int bits = !sign && sb == 32 ? 32 : db;
+        MachineOperand d = *dst;
+        d.size_bits = bits;
+        return elf_mov(f, bits, &d, src);
+    }
+    if (!elf_rm_from_operand(f, src, &rm) || src->kind == MACH_OP_IMM) return false;
+
+    unsigned fl = db == 64 ? ELF_W : 0;
+    uint8_t p = db == 16 ? 0x66 : 0;
+    if (sign && sb == 32 && db == 64)
+    {
+        uint8_t op = 0x63;
+        elf_emit_rm(f, 0, ELF_W, &op, 1, dst->data.vreg, &rm, 0, 0);
+        return true;
+    }
+    if (sb == 8 && (db == 16 || db == 32 || db == 64))
+    {
+        uint8_t op[2] = {0x0F, sign ? 0xBE : 0xB6};
+        elf_emit_rm(f, p, fl | ELF_RM8, op, 2, dst->data.vreg, &rm, 0, 0);
+        return true;
+    }
+    if (sb == 16 && (db == 32 || db == 64))
+    {
+        uint8_t op[2] = {0x0F, sign ? 0xBF : 0xB7};
+        elf_emit_rm(f, 0, fl, op, 2, dst->data.vreg, &rm, 0, 0);
+        return true;
+    }
+    // احتياطي emit: mov بعرض الوجهة.
+    MachineOperand s = *src;
+    s.size_bits = db;
+    return elf_mov(f, db, dst, &s);
+}
+
+static bool elf_extend_inst(ElfFunc* f, const MachineInst* inst, bool sign)
+{
+    int sb = inst->src1.size_bits;
+    int db = inst->dst.size_bits;
+    if (sb <= 0 || sb == 1) sb = 8;
+    if (db <= 0) db = 64;
+    sb = elf_bits(sb);
+    db = elf_bits(db);
+
+    if (elf_is_mem(&inst->dst))
+    {
+        MachineOperand tmp = elf_gpr(PHYS_RAX, db);
+        return elf_extend(f, sign, sb, db, &tmp, &inst->src1) && elf_mov(f, db, &inst->dst, &tmp);
+    }
+    return elf_extend(f, sign, sb, db, &inst->dst, &inst->src1);
+}
+
+/**
+ * @brief تعليمة ثنائية بعد تطبيق مسارات المؤقت (ذاكرة-ذاكرة عبر R11، imm64 عبر movabs).
+ */
+static bool elf_binary(ElfFunc* f, const MachineInst* inst, int digit, bool mem_scratch)
+{
+    if (mem_scratch && elf_is_mem(&inst->dst) && elf_is_mem(&inst->src2))
+    {
+        int bits = inst->dst.size_bits;
+        if (bits <= 0) bits = inst->src2.size_bits;
+        bits = elf_bits(bits);
+        MachineOperand tmp = elf_gpr(PHYS_R11, bits);
+        return elf_mov(f, bits, &tmp, &inst->src2) && elf_alu(f, digit, bits, &inst->dst, &tmp);
+    }
+    if (inst->src2.kind == MACH_OP_IMM && inst->dst.size_bits == 64 && !elf_fits_i32(inst->src2.data.imm))
+    {
+        MachineOperand tmp = elf_gpr(PHYS_R11, 64);
+        return elf_movabs(f, &tmp, inst->src2.data.imm) && elf_alu(f, digit, 64, &inst->dst, &tmp);
+    }
+    return elf_alu(f, digit, elf_infer_bits(inst), &inst->dst, &inst->src2);
+}
+
+/**
+ * @brief mov/load/store مع مسار imm64 ومسار ذاكرة-إلى-ذاكرة عبر RAX.
+ */
+static bool elf_move_inst(ElfFunc* f, const MachineInst* inst, int bits, bool any_mem_pair)
+{
+    const MachineOperand* dst = &inst->dst;
+    const MachineOperand* src = &inst->src1;
+    if (src->kind == MACH_OP_IMM && bits == 64 && !elf_fits_i32(src->data.imm))
+    {
+        if (elf_is_gpr(dst)) return elf_movabs(f, dst, src->data.imm);
+        MachineOperand tmp = elf_gpr(PHYS_R11, 64);
+        return elf_is_mem(dst) && elf_movabs(f, &tmp, src->data.imm) && elf_mov(f, 64, dst, &tmp);
+    }
+    bool pair = any_mem_pair ? (elf_is_mem(dst) && elf_is_mem(src))
+                             : (dst->kind == MACH_OP_MEM && src->kind == MACH_OP_MEM);
+    if (pair)
+    {
+        MachineOperand tmp = elf_gpr(PHYS_RAX, bits);
+        return elf_mov(f, bits, &tmp, src) && elf_mov(f, bits, dst, &tmp);
+    }
+    return elf_mov(f, bits, dst, src);
+}
+
+// ============================================================================
+// الإطار (Prologue/Epilogue) - مطابق لـ emit_frame.c وemit_support.c
+// ============================================================================
+
+static int elf_shadow_bytes(const ElfFunc* f)
+{
+    return f->w->cc ? f->w->cc->shadow_space_bytes : 32;
+}
+
+static bool elf_stack_protector(const ElfFunc* f)
+{
+    if (f->w->opts.stack_protector == BAA_STACKPROT_ALL) return true;
+    if (f->w->opts.stack_protector == BAA_STACKPROT_ON) return f->func->stack_size > 0;
+    return false;
+}
+
+static int elf_canary_size(const ElfFunc* f)
+{
+    return elf_stack_protector(f) ? 8 : 0;
+}
+
+static int elf_callee_save_offset(const ElfFunc* f, int i)
+{
+    return -(f->func->stack_size + elf_shadow_bytes(f) + elf_canary_size(f) + (i + 1) * 8);
+}
+
+/**
+ * @brief movq %fs:40, %reg (قراءة كناري glibc).
+ */
+static void elf_load_fs_canary(ElfFunc* f, int reg)
+{
+    // 64 REX.W(+R) 8B /r مع SIB بلا قاعدة ولا فهرس = عنوان مطلق disp32.
+    elf_byte(f, 0x64);
+    elf_byte(f, (uint8_t)(0x48 | ((reg & 8) ? 0x04 : 0)));
+    elf_byte(f, 0x8B);
+    elf_byte(f, (uint8_t)(0x04 | ((reg & 7) << 3)));
+    elf_byte(f, 0x25);
+    elf_buf_le(&f->code, 0x28, 4);
+}
+
+static void elf_prologue(ElfFunc* f)
+{
+    static const uint8_t push_mov[] = {0x55, 0x48, 0x89, 0xE5}; // push %rbp; mov %rsp, %rbp
+    elf_bytes(f, push_mov, sizeof(push_mov));
+
+    int total = f->func->stack_size + elf_shadow_bytes(f) + elf_canary_size(f) + f->callee_count * 8;
+    int align = (f->w->cc && f->w->cc->stack_align_bytes > 0) ? f->w->cc->stack_align_bytes : 16;
+    if (align > 0 && total % align != 0) total = (total / align + 1) * align;
+    if (total > 0)
+    {
+        MachineOperand rsp = elf_gpr(PHYS_RSP, 64);
+        MachineOperand imm = mach_op_imm(total, 64);
+        (void)elf_alu(f, 5, 64, &rsp, &imm);
+    }
+
+    if (elf_stack_protector(f))
+    {
+        int off = -(f->func->stack_size + elf_shadow_bytes(f) + 8);
+        MachineOperand r11 = elf_gpr(PHYS_R11, 64);
+        MachineOperand slot = mach_op_mem(PHYS_RBP, off, 64);
+        elf_load_fs_canary(f, PHYS_R11);
+        (void)elf_mov(f, 64, &slot, &r11);
+    }
+
+    for (int i = 0; i < f->callee_count; i++)
+    {
+        MachineOperand reg = elf_gpr(f->callee_regs[i], 64);
+        MachineOperand slot = mach_op_mem(PHYS_RBP, elf_callee_save_offset(f, i), 64);
+        (void)elf_mov(f, 64, &slot, &reg);
+    }
+}
+
+/**
+ * @brief تحقق الكناري واستعادة callee-saved ثم leave (قبل ret أو النداء الذيلي).
+ */
+static void elf_unwind(ElfFunc* f)
+{
+    if (elf_stack_protector(f))
+    {
+        int off = -(f->func->stack_size + elf_shadow_bytes(f) + 8);
+        MachineOperand r10 = elf_gpr(PHYS_R10, 64);
+        MachineOperand r11 = elf_gpr(PHYS_R11, 64);
+        MachineOperand slot = mach_op_mem(PHYS_RBP, off, 64);
+        int ok_label = f->sp_label_next++;
+        (void)elf_mov(f, 64, &r11, &slot);
+        elf_load_fs_canary(f, PHYS_R10);
+        (void)elf_alu(f, 6, 64, &r11, &r10);
+        elf_branch(f, k_elf_jcc[MACH_JE], ok_label);
+        elf_call_symbol(f, 0xE8, elf_sym_get(f->w, "__stack_chk_fail"));
+        elf_byte(f, 0x0F); // ud2
+        elf_byte(f, 0x0B);
+        elf_define_label(f, ok_label);
+    }
+    for (int i = f->callee_count - 1; i >= 0; i--)
+    {
+        MachineOperand reg = elf_gpr(f->callee_regs[i], 64);
+        MachineOperand slot = mach_op_mem(PHYS_RBP, elf_callee_save_offset(f, i), 64);
+        (void)elf_mov(f, 64, &reg, &slot);
+    }
+    elf_byte(f, 0xC9); // leave
+}
+
+static bool elf_tailjmp(ElfFunc* f, const MachineInst* inst)
+{
+    elf_unwind(f);
+    if (inst->src1.kind == MACH_OP_FUNC)
+    {
+        elf_call_symbol(f, 0xE9, elf_sym_get(f->w, elf_func_symbol_name(inst->src1.data.name)));
+        return true;
+    }
+    // `jmp %reg` بلا نجمة يقبله GAS قفزاً غير مباشر.
+    ElfRm rm;
+    if (!elf_rm_from_operand(f, &inst->src1, &rm)) return false;
+    uint8_t op = 0xFF;
+    elf_emit_rm(f, 0, 0, &op, 1, 4, &rm, 0, 0);
+    return true;
+}
+
+static bool elf_call(ElfFunc* f, const MachineInst* inst)
+{
+    if (f->w->cc && f->w->cc->sysv_set_al_zero_on_call)
+    {
+        int al = inst->sysv_al < 0 ? 0 : inst->sysv_al;
+        if (al == 0)
+        {
+            elf_byte(f, 0x31); // xorl %eax, %eax
+            elf_byte(f, 0xC0);
+        }
+        else
+        {
+            elf_byte(f, 0xB8); // movl $al, %eax
+            elf_buf_le(&f->code, (uint64_t)al, 4);
+        }
+    }
+    if (inst->src1.kind == MACH_OP_FUNC)
+    {
+        elf_call_symbol(f, 0xE8, elf_sym_get(f->w, elf_func_symbol_name(inst->src1.data.name)));
+        return true;
+    }
+    ElfRm rm;
+    if (!elf_rm_from_operand(f, &inst->src1, &rm) || inst->src1.kind == MACH_OP_XMM) return false;
+    uint8_t op = 0xFF;
+    elf_emit_rm(f, 0, 0, &op, 1, 2, &rm, 0, 0);
+    return true;
+}
+
+/**
+ * @brief قفز عبر جدول: المدخلات إزاحات ٣٢ بت من بداية الجدول في .rodata.
+ */
+static bool elf_jump_table(ElfFunc* f, const MachineInst* inst, const uint64_t* jt_off)
+{
+    int t = (int)inst->src2.data.imm;
+    if (t < 0 || t >= f->func->jump_table_count) return false;
+    MachineOperand idx = inst->src1;
+    idx.size_bits = 64;
+    MachineOperand rax = elf_gpr(PHYS_RAX, 64);
+    if (!elf_mov(f, 64, &rax, &idx)) return false;
+
+    ElfRm table = elf_rm_rip(f->w->section_sym[ELF_SEC_RODATA], (int64_t)jt_off[t]);
+    uint8_t lea = 0x8D;
+    elf_emit_rm(f, 0, ELF_W, &lea, 1, PHYS_R11, &table, 0, 0);
+
+    ElfRm entry = elf_rm_mem(PHYS_R11, 0);
+    entry.index = PHYS_RAX;
+    entry.scale_log2 = 2;
+    uint8_t movslq = 0x63;
+    elf_emit_rm(f, 0, ELF_W, &movslq, 1, PHYS_RAX, &entry, 0, 0);
+
+    MachineOperand r11 = elf_gpr(PHYS_R11, 64);
+    (void)elf_alu(f, 0, 64, &rax, &r11);
+    elf_byte(f, 0xFF); // jmp *%rax
+    elf_byte(f, 0xE0);
+    return true;
+}
+
+static bool elf_inst(ElfFunc* f, MachineInst* inst, const uint64_t* jt_off)
+{
+    switch (inst->op)
+    {
+    case MACH_LABEL:
+        elf_define_label(f, inst->dst.data.label_id);
+        return true;
+
+    case MACH_COMMENT:
+    case MACH_NOP:
+        return true;
+
+    case MACH_CPU_NOP:
+        elf_byte(f, 0x90);
+        return true;
+
+    case MACH_RDTSC:
+    {
+        static const uint8_t seq[] = {
+            0x0F, 0x31,             // rdtsc
+            0x48, 0xC1, 0xE2, 0x20, // shlq $32, %rdx
+            0x48, 0x09, 0xD0,       // orq %rdx, %rax
+        };
+        MachineOperand rax = elf_gpr(PHYS_RAX, 64);
+        elf_bytes(f, seq, sizeof(seq));
+        return elf_mov(f, 64, &inst->dst, &rax);
+    }
+
+    case MACH_MOV:
+        if (inst->dst.kind == MACH_OP_NONE || inst->src1.kind == MACH_OP_NONE) return true;
+        if (inst->dst.kind == MACH_OP_VREG && inst->src1.kind == MACH_OP_VREG &&
+            inst->dst.data.vreg == inst->src1.data.vreg)
+            return true;
+        return elf_move_inst(f, inst, elf_infer_bits(inst), false);
+
+    case MACH_LOAD:
+    case MACH_STORE:
+    {
+        const MachineOperand* first = inst->op == MACH_LOAD ? &inst->dst : &inst->src1;
+        const MachineOperand* second = inst->op == MACH_LOAD ? &inst->src1 : &inst->dst;
+        int bits = elf_bits(first->size_bits > 0 ? first->size_bits : second->size_bits);
+        return elf_move_inst(f, inst, bits, true);
+    }
+
+    case MACH_ADD:
+        return elf_binary(f, inst, 0, true);
+    case MACH_SUB:
+        return elf_binary(f, inst, 5, true);
+    case MACH_AND:
+        return elf_binary(f, inst, 4, false);
+    case MACH_OR:
+        return elf_binary(f, inst, 1, false);
+    case MACH_XOR:
+        return elf_binary(f, inst, 6, false);
+
+    case MACH_IMUL:
+    {
+        int bits = elf_infer_bits(inst);
+        ElfRm rm;
+        if (!elf_is_gpr(&inst->dst) || bits == 8) return false;
+        uint8_t p = elf_size_prefix(bits);
+        unsigned fl = elf_size_flags(bits);
+        if (inst->src2.kind == MACH_OP_IMM)
+        {
+            int64_t imm = inst->src2.data.imm;
+            if (bits == 64 && !elf_fits_i32(imm)) return false;
+            rm = elf_rm_reg(inst->dst.data.vreg);
+            bool small = elf_fits_i8(bits == 16 ? (int16_t)imm : bits == 32 ? (int32_t)imm : imm);
+            uint8_t op = small ? 0x6B : 0x69;
+            elf_emit_rm(f, p, fl, &op, 1, inst->dst.data.vreg, &rm, small ? 1 : elf_imm_bytes(bits), imm);
+            return true;
+        }
+        if (!elf_rm_from_operand(f, &inst->src2, &rm)) return false;
+        static const uint8_t op[] = {0x0F, 0xAF};
+        elf_emit_rm(f, p, fl, op, 2, inst->dst.data.vreg, &rm, 0, 0);
+        return true;
+    }
+
+    case MACH_SHL:
+        return elf_shift(f, 4, elf_infer_bits(inst), &inst->dst, &inst->src2);
+    case MACH_SHR:
+        return elf_shift(f, 5, elf_infer_bits(inst), &inst->dst, &inst->src2);
+    case MACH_SAR:
+        return elf_shift(f, 7, elf_infer_bits(inst), &inst->dst, &inst->src2);
+    case MACH_NEG:
+        return elf_unary(f, 3, elf_infer_bits(inst), &inst->dst);
+    case MACH_NOT:
+        return elf_unary(f, 2, elf_infer_bits(inst), &inst->dst);
+
+    case MACH_CQO:
+        elf_byte(f, 0x48);
+        elf_byte(f, 0x99);
+        return true;
+    case MACH_IDIV:
+        return elf_unary(f, 7, 64, &inst->src1);
+    case MACH_DIV:
+        return elf_unary(f, 6, 64, &inst->src1);
+
+    case MACH_ADDSD:
+    case MACH_SUBSD:
+    case MACH_MULSD:
+    case MACH_DIVSD:
+    {
+        static const uint8_t ops[] = {0x58, 0x5C, 0x59, 0x5E};
+        if (inst->dst.kind != MACH_OP_XMM) return false;
+        return elf_sse(f, 0xF2, ops[inst->op - MACH_ADDSD], 0, inst->dst.data.xmm, &inst->src2);
+    }
+    case MACH_UCOMISD:
+        if (inst->src1.kind != MACH_OP_XMM) return false;
+        return elf_sse(f, 0x66, 0x2E, 0, inst->src1.data.xmm, &inst->src2);
+    case MACH_XORPD:
+        if (inst->dst.kind != MACH_OP_XMM) return false;
+        return elf_sse(f, 0x66, 0x57, 0, inst->dst.data.xmm, &inst->src2);
+    case MACH_CVTSI2SD:
+        if (inst->dst.kind != MACH_OP_XMM) return false;
+        return elf_sse(f, 0xF2, 0x2A, inst->src1.size_bits == 32 ? 0 : ELF_W,
+                       inst->dst.data.xmm, &inst->src1);
+    case MACH_CVTTSD2SI:
+        if (!elf_is_gpr(&inst->dst)) return false;
+        return elf_sse(f, 0xF2, 0x2C, inst->dst.size_bits == 32 ? 0 : ELF_W,
+                       inst->dst.data.vreg, &inst->src1);
+
+    case MACH_LEA:
+        if (elf_is_mem(&inst->dst))
+        {
+            MachineOperand rax = elf_gpr(PHYS_RAX, 64);
+            return elf_lea(f, PHYS_RAX, &inst->src1) && elf_mov(f, 64, &inst->dst, &rax);
+        }
+        return elf_is_gpr(&inst->dst) && elf_lea(f, inst->dst.data.vreg, &inst->src1);
+
+    case MACH_CMP:
+    {
+        if (inst->src2.kind == MACH_OP_IMM && inst->src1.size_bits == 64 &&
+            !elf_fits_i32(inst->src2.data.imm))
+        {
+            MachineOperand tmp = elf_gpr(PHYS_R11, 64);
+            return elf_movabs(f, &tmp, inst->src2.data.imm) && elf_alu(f, 7, 64, &inst->src1, &tmp);
+        }
+        int bits = elf_infer_bits(inst);
+        if (elf_is_mem(&inst->src1) && elf_is_mem(&inst->src2))
+        {
+            MachineOperand tmp = elf_gpr(PHYS_RAX, bits);
+            return elf_mov(f, bits, &tmp, &inst->src2) && elf_alu(f, 7, bits, &inst->src1, &tmp);
+        }
+        return elf_alu(f, 7, bits, &inst->src1, &inst->src2);
+    }
+
+    case MACH_TEST:
+    {
+        int bits = elf_infer_bits(inst);
+        if (elf_is_mem(&inst->src1) && elf_is_mem(&inst->src2))
+        {
+            MachineOperand tmp = elf_gpr(PHYS_RAX, bits);
+            return elf_mov(f, bits, &tmp, &inst->src2) && elf_test(f, bits, &inst->src1, &tmp);
+        }
+        return elf_test(f, bits, &inst->src1, &inst->src2);
+    }
+
+    case MACH_SETE:
+    case MACH_SETNE:
+    case MACH_SETG:
+    case MACH_SETL:
+    case MACH_SETGE:
+    case MACH_SETLE:
+    case MACH_SETA:
+    case MACH_SETB:
+    case MACH_SETAE:
+    case MACH_SETBE:
+    case MACH_SETP:
+    case MACH_SETNP:
+    {
+        ElfRm rm;
+        if (!elf_rm_from_operand(f, &inst->dst, &rm)) return false;
+        uint8_t op[2] = {0x0F, (uint8_t)(0x90 | k_elf_setcc[inst->op])};
+        elf_emit_rm(f, 0, ELF_RM8, op, 2, 0, &rm, 0, 0);
+        return true;
+    }
+
+    case MACH_MOVZX:
+        return elf_extend_inst(f, inst, false);
+    case MACH_MOVSX:
+        return elf_extend_inst(f, inst, true);
+
+    case MACH_JMP:
+        if (inst->dst.kind != MACH_OP_LABEL) return false;
+        elf_branch(f, ELF_JMP_CC, inst->dst.data.label_id);
+        return true;
+
+    case MACH_JE:
+    case MACH_JNE:
+    case MACH_JG:
+    case MACH_JL:
+    case MACH_JGE:
+    case MACH_JLE:
+    case MACH_JA:
+    case MACH_JB:
+    case MACH_JAE:
+    case MACH_JBE:
+    case MACH_JP:
+    case MACH_JNP:
+        if (inst->dst.kind != MACH_OP_LABEL) return false;
+        elf_branch(f, k_elf_jcc[inst->op], inst->dst.data.label_id);
+        return true;
+
+    case MACH_JMP_TABLE:
+        return elf_jump_table(f, inst, jt_off);
+
+    case MACH_CALL:
+        return elf_call(f, inst);
+
+    case MACH_RET:
+        elf_unwind(f);
+        elf_byte(f, 0xC3);
+        return true;
+
+    case MACH_TAILJMP:
+        return elf_tailjmp(f, inst);
+
+    case MACH_PUSH:
+        if (elf_is_gpr(&inst->src1))
+        {
+            elf_emit_opreg(f, 0, 0, 0x50, inst->src1.data.vreg);
+            return true;
+        }
+        if (inst->src1.kind == MACH_OP_IMM)
+        {
+            int64_t imm = inst->src1.data.imm;
+            if (!elf_fits_i32(imm)) return false;
+            elf_byte(f, elf_fits_i8(imm) ? 0x6A : 0x68);
+            elf_buf_le(&f->code, (uint64_t)imm, elf_fits_i8(imm) ? 1 : 4);
+            return true;
+        }
+        if (elf_is_mem(&inst->src1))
+        {
+            ElfRm rm;
+            uint8_t op = 0xFF;
+            if (!elf_rm_from_operand(f, &inst->src1, &rm)) return false;
+            elf_emit_rm(f, 0, 0, &op, 1, 6, &rm, 0, 0);
+            return true;
+        }
+        return false;
+
+    case MACH_POP:
+        if (elf_is_gpr(&inst->dst))
+        {
+            elf_emit_opreg(f, 0, 0, 0x58, inst->dst.data.vreg);
+            return true;
+        }
+        if (elf_is_mem(&inst->dst))
+        {
+            ElfRm rm;
+            uint8_t op = 0x8F;
+            if (!elf_rm_from_operand(f, &inst->dst, &rm)) return false;
+            elf_emit_rm(f, 0, 0, &op, 1, 0, &rm, 0, 0);
+            return true;
+        }
+        return false;
+
+    default:
+        // emit_inst يكتب تعليقاً فقط لعملية غير معالجة.
+        return true;
+    }
+}
+
+/**
+ * @brief أكبر معرف تسمية في الدالة؛ تسميات فحص الكناري تُرقَّم بعده.
+ */
+static int elf_func_max_label(const MachineFunc* func)
+{
+    int max_id = -1;
+    for (MachineBlock* b = func->blocks; b; b = b->next)
+    {
+        for (MachineInst* i = b->first; i; i = i->next)
+        {
+            if (i->dst.kind == MACH_OP_LABEL && i->dst.data.label_id > max_id)
+                max_id = i->dst.data.label_id;
+        }
+    }
+    for (int t = 0; t < func->jump_table_count; t++)
+    {
+        for (int e = 0; e < func->jump_tables[t].count; e++)
+        {
+            if (func->jump_tables[t].label_ids[e] > max_id)
+                max_id = func->jump_tables[t].label_ids[e];
+        }
+    }
+    return max_id;
+}
+
+/**
+ * @brief ترميز دالة كاملة إلى .text مع جداول قفزها في .rodata.
+ */
+static bool elf_emit_func(ElfFunc* f, MachineFunc* func)
+{
+    if (!func || func->is_prototype) return true;
+
+    elf_func_reset(f);
+    f->func = func;
+    f->sp_label_next = elf_func_max_label(func) + 1;
+    f->callee_count = machine_func_collect_callee_saved(func, f->w->target, f->callee_regs, 16);
+    if (f->callee_count < 0) return false;
+
+    uint64_t* jt_off = NULL;
+    if (func->jump_table_count > 0)
+    {
+        jt_off = elf_reserve_jump_tables(f->w, func);
+        if (!jt_off) return false;
+    }
+
+    elf_prologue(f);
+    bool has_ret = false;
+    bool ok = true;
+    for (MachineBlock* block = func->blocks; ok && block; block = block->next)
+    {
+        for (MachineInst* inst = block->first; ok && inst; inst = inst->next)
+        {
+            if (inst->op == MACH_RET || inst->op == MACH_TAILJMP) has_ret = true;
+            ok = elf_inst(f, inst, jt_off);
+        }
+    }
+    if (ok && !has_ret)
+    {
+        if (strcmp(func->name, "الرئيسية") == 0)
+        {
+            static const uint8_t zero_rax[] = {0x48, 0xC7, 0xC0, 0, 0, 0, 0}; // mov $0, %rax
+            elf_bytes(f, zero_rax, sizeof(zero_rax));
+        }
+        elf_unwind(f);
+        elf_byte(f, 0xC3);
+    }
+
+    uint64_t start = 0;
+    uint64_t size = 0;
+    ok = ok && elf_func_flush(f, &start, &size);
+    if (ok)
+    {
+        int sym = elf_sym_get(f->w, func->name);
+        if (sym < 0 || f->w->syms[sym].section >= 0)
+        {
+            ok = false;
+        }
+        else
+        {
+            ElfSymbol* s = &f->w->syms[sym];
+            s->section = ELF_SEC_TEXT;
+            s->value = start;
+            s->size = size;
+            s->type = ELF_STT_FUNC;
+        }
+    }
+    if (ok && jt_off) ok = elf_fill_jump_tables(f, func, jt_off, start);
+    free(jt_off);
+    return ok;
+}
+
+/**
+ * @brief كائن بدء التشغيل: نفس تعليمات driver_startup_gas_source() لهدف ELF.
+ */
+static bool elf_emit_startup(ElfFunc* f)
+{
+    elf_func_reset(f);
+    MachineOperand rsp = elf_gpr(PHYS_RSP, 64);
+    MachineOperand r10 = elf_gpr(PHYS_R10, 64);
+    MachineOperand rsi = elf_gpr(PHYS_RSI, 64);
+    MachineOperand top = mach_op_mem(PHYS_RSP, 0, 64);
+    MachineOperand argv = mach_op_mem(PHYS_RSP, 8, 64);
+    MachineOperand eight = mach_op_imm(8, 64);
+    static const uint8_t clear_args[] = {
+        0x31, 0xC9,       // xorl %ecx, %ecx
+        0x45, 0x31, 0xC0, // xorl %r8d, %r8d
+        0x45, 0x31, 0xC9, // xorl %r9d, %r9d
+    };
+
+    bool ok = elf_mov(f, 64, &r10, &rsp) && elf_mov(f, 64, &rsi, &top) && elf_lea(f, PHYS_RDX, &argv);
+    ElfRm main_rm = elf_rm_rip(elf_sym_get(f->w, "الرئيسية"), 0);
+    uint8_t lea = 0x8D;
+    elf_emit_rm(f, 0, ELF_W, &lea, 1, PHYS_RDI, &main_rm, 0, 0);
+    elf_bytes(f, clear_args, sizeof(clear_args));
+    ok = ok && elf_alu(f, 5, 64, &rsp, &eight);
+    elf_emit_opreg(f, 0, 0, 0x50, PHYS_R10);
+    elf_call_symbol(f, 0xE8, elf_sym_get(f->w, "__libc_start_main"));
+    elf_byte(f, 0xF4); // hlt
+
+    uint64_t start = 0;
+    uint64_t size = 0;
+    ok = ok && elf_func_flush(f, &start, &size);
+    int sym = ok ? elf_sym_define(f->w, "الرئيسية_بدء", ELF_SEC_TEXT, ELF_STT_FUNC, false) : -1;
+    if (sym < 0) return false;
+    f->w->syms[sym].value = start;
+    f->w->syms[sym].size = size;
+    return true;
+}
@@ -16,12 +16,12 @@
  * @param callee_saved_used مصفوفة السجلات المحفوظة المستخدمة.
  * @param callee_count عدد السجلات المحفوظة لحفظها.
  */
-static void emit_prologue(MachineFunc* func, FILE* out,
+static void emit_prologue(EmitContext* ctx, MachineFunc* func, EmitBuf* out,
                            PhysReg* callee_regs, int callee_count) {
-    emit_comment(out, "بداية prologue");
+    emit_comment(ctx, out, "بداية prologue");
     // حفظ إطار المكدس
-    fprintf(out, "    push %%rbp\n");
-    fprintf(out, "    mov %%rsp, %%rbp\n");
+    emit_buf_puts(out, "    push %rbp\n");
+    emit_buf_puts(out, "    mov %rsp, %rbp\n");
 
     // حساب حجم المكدس الإجمالي:
     // حجم محلي (func->stack_size) + shadow space (حسب الهدف) + حفظ callee-saved
@@ -31,32 +31,32 @@ static void emit_prologue(MachineFunc* func, FILE* out,
 
     // إجمالي الحجم المطلوب (بعد push rbp)
     // المكدس بعد push rbp: RSP ناقص 8 (لـ rbp المحفوظ)
-    int shadow = emit_shadow_bytes();
-    int canary_size = emit_stack_protector_size(func);
+    int shadow = emit_shadow_bytes(ctx);
+    int canary_size = emit_stack_protector_size(ctx, func);
     int total_frame = local_size + shadow + canary_size + callee_save_size;
 
     // محاذاة إلى قيمة الهدف (عادة 16 بايت)
     // بعد push rbp، RSP = aligned - 8
     // نحتاج sub ليجعل RSP محاذى عند نقاط الاستدعاء.
-    int align = emit_stack_align_bytes();
+    int align = emit_stack_align_bytes(ctx);
     if (align > 0 && (total_frame % align) != 0) {
         total_frame = ((total_frame / align) + 1) * align;
     }
 
     if (total_frame > 0) {
-        fprintf(out, "    sub $%d, %%rsp\n", total_frame);
-        emit_comment(out, "حجز إطار مكدس بحجم %d بايت", total_frame);
+        emit_buf_fmt(out, "    sub $%d, %%rsp\n", total_frame);
+        emit_comment(ctx, out, "حجز إطار مكدس بحجم %d بايت", total_frame);
     }
 
     // تهيئة كناري حماية المكدس (إن كان مفعلاً)
-    emit_stack_protector_prologue(func, out);
+    emit_stack_protector_prologue(ctx, func, out);
 
     // حفظ السجلات المحفوظة (callee-saved)
     for (int i = 0; i < callee_count; i++) {
         int save_offset = -(local_size + shadow + canary_size + (i + 1) * 8);
-        fprintf(out, "    mov %s, %d(%%rbp)\n",
-                reg64_names[callee_regs[i]], save_offset);
-        emit_comment(out, "حفظ سجل callee-saved: %s", reg64_names[callee_regs[i]]);
+        emit_buf_fmt(out, "    mov %s, %d(%%rbp)\n",
+                     reg64_names[callee_regs[i]], save_offset);
+        emit_comment(ctx, out, "حفظ سجل callee-saved: %s", reg64_names[callee_regs[i]]);
     }
 }
 
@@ -70,27 +70,27 @@ static void emit_prologue(MachineFunc* func, FILE* out,
  *
  * ملاحظة: يتم إصدار الخاتمة قبل كل تعليمة ret في الدالة.
  */
-static void emit_epilogue(MachineFunc* func, FILE* out,
+static void emit_epilogue(EmitContext* ctx, MachineFunc* func, EmitBuf* out,
                            PhysReg* callee_regs, int callee_count) {
-    emit_comment(out, "بداية epilogue");
+    emit_comment(ctx, out, "بداية epilogue");
     int local_size = func->stack_size;
-    int shadow = emit_shadow_bytes();
-    int canary_size = emit_stack_protector_size(func);
+    int shadow = emit_shadow_bytes(ctx);
+    int canary_size = emit_stack_protector_size(ctx, func);
     // تحقق كناري حماية المكدس قبل تفكيك الإطار
-    emit_stack_protector_epilogue(func, out, g_emit_sp_seq++);
+    emit_stack_protector_epilogue(ctx, func, out, ctx->sp_seq++);
 
     // استعادة السجلات المحفوظة (callee-saved) بترتيب عكسي
     for (int i = callee_count - 1; i >= 0; i--) {
         int save_offset = -(local_size + shadow + canary_size + (i + 1) * 8);
-        fprintf(out, "    mov %d(%%rbp), %s\n",
-                save_offset, reg64_names[callee_regs[i]]);
-        emit_comment(out, "استرجاع سجل callee-saved: %s", reg64_names[callee_regs[i]]);
+        emit_buf_fmt(out, "    mov %d(%%rbp), %s\n",
+                     save_offset, reg64_names[callee_regs[i]]);
+        emit_comment(ctx, out, "استرجاع سجل callee-saved: %s", reg64_names[callee_regs[i]]);
     }
 
     // استعادة المكدس والرجوع
-    fprintf(out, "    leave\n");
-    fprintf(out, "    ret\n");
-    emit_comment(out, "نهاية epilogue");
+    emit_buf_puts(out, "    leave\n");
+    emit_buf_puts(out, "    ret\n");
+    emit_comment(ctx, out, "نهاية epilogue");
 }
 
 /**
@@ -104,29 +104,29 @@ static void emit_epilogue(MachineFunc* func, FILE* out,
  * بهذه الطريقة، عندما تُنفّذ الدالة الهدف `ret` ستعود مباشرةً
  * إلى مستدعي الدالة الحالية (إعادة استخدام إطار المكدس).
  */
-static void emit_tailjmp(MachineFunc* func, MachineInst* inst, FILE* out,
+static void emit_tailjmp(EmitContext* ctx, MachineFunc* func, MachineInst* inst, EmitBuf* out,
                          PhysReg* callee_regs, int callee_count) {
     if (!func || !inst || !out) return;
 
     int local_size = func->stack_size;
-    int shadow = emit_shadow_bytes();
-    int canary_size = emit_stack_protector_size(func);
+    int shadow = emit_shadow_bytes(ctx);
+    int canary_size = emit_stack_protector_size(ctx, func);
     // تحقق كناري حماية المكدس قبل الخروج من الدالة (حتى في النداء_الذيلي)
-    emit_stack_protector_epilogue(func, out, g_emit_sp_seq++);
+    emit_stack_protector_epilogue(ctx, func, out, ctx->sp_seq++);
 
     // استعادة السجلات المحفوظة (callee-saved) بترتيب عكسي
     for (int i = callee_count - 1; i >= 0; i--) {
         int save_offset = -(local_size + shadow + canary_size + (i + 1) * 8);
-        fprintf(out, "    mov %d(%%rbp), %s\n",
-                save_offset, reg64_names[callee_regs[i]]);
+        emit_buf_fmt(out, "    mov %d(%%rbp), %s\n",
+                     save_offset, reg64_names[callee_regs[i]]);
     }
 
     // تفكيك إطار الدالة: بعد leave يصبح RSP على عنوان الرجوع
-    fprintf(out, "    leave\n");
+    emit_buf_puts(out, "    leave\n");
 
-    fprintf(out, "    jmp ");
-    emit_operand(&inst->src1, out);
-    fprintf(out, "\n");
+    emit_buf_puts(out, "    jmp ");
+    emit_operand(ctx, &inst->src1, out);
+    emit_buf_puts(out, "\n");
 }
 
 // ============================================================================
@@ -2,55 +2,78 @@
 // إصدار الدوال والوحدة (Function/Module Emission)
 // ============================================================================
 
+/**
+ * @brief إصدار جداول القفز للدالة الحالية في قسم القراءة فقط.
+ *
+ * كل مدخل إزاحة 32-بت من الجدول إلى الكتلة (`.long .LBB - .LJT`)، فلا يحتاج
+ * الجدول إلى relocations عند الربط كـ PIE.
+ */
+static void emit_jump_tables(EmitContext* ctx, const MachineFunc* func, EmitBuf* out)
+{
+    if (!func || func->jump_table_count <= 0) return;
+
+    emit_rodata_section(ctx, out);
+    for (int t = 0; t < func->jump_table_count; t++) {
+        const MachineJumpTable* jt = &func->jump_tables[t];
+        emit_buf_puts(out, "    .p2align 2\n");
+        emit_buf_fmt(out, ".LJT_%d_%d:\n", ctx->current_func_uid, t);
+        for (int i = 0; i < jt->count; i++) {
+            emit_buf_fmt(out, "    .long .LBB_%d_%d-.LJT_%d_%d\n", ctx->current_func_uid,
+                         jt->label_ids[i], ctx->current_func_uid, t);
+        }
+    }
+    emit_buf_puts(out, ".text\n");
+}
+
 /**
  * @brief جمع السجلات المحفوظة (callee-saved) المستخدمة في الدالة.
  *
  * يمشي على جميع تعليمات الدالة ويكشف أي سجلات callee-saved
  * استُخدمت كوجهة (dst) حتى نحفظها في المقدمة ونستعيدها في الخاتمة.
  */
-bool emit_func(MachineFunc* func, FILE* out) {
+static bool emit_func(EmitContext* ctx, MachineFunc* func, EmitBuf* out) {
     if (!func || !out) return false;
 
     // تخطي النماذج الأولية
     if (func->is_prototype) return true;
 
     // تعيين بادئة فريدة لتسميات الكتل داخل هذه الدالة
-    g_emit_current_func_uid = g_emit_next_func_uid++;
-    g_emit_sp_seq = 0;
+    ctx->current_func_uid = ctx->next_func_uid++;
+    ctx->sp_seq = 0;
 
     // الاسم العربي هو رمز ABI الفعلي؛ لا نولد alias لاتينيا لنقطة الدخول.
     const char* func_name = func->name;
     bool is_main = func_name && strcmp(func_name, "الرئيسية") == 0;
 
     // إصدار تعريف الرمز العام
-    fprintf(out, "\n.globl %s\n", func_name);
-    fprintf(out, "%s:\n", func_name);
-    emit_comment(out, "دالة: %s", func_name);
+    emit_buf_fmt(out, "\n.globl %s\n", func_name);
+    emit_buf_fmt(out, "%s:\n", func_name);
+    emit_comment(ctx, out, "دالة: %s", func_name);
 
     // جمع السجلات المحفوظة المستخدمة
     PhysReg callee_regs[16];
     int callee_count = machine_func_collect_callee_saved(
-        func, g_emit_target, callee_regs, 16);
+        func, ctx->target, callee_regs, 16);
     if (callee_count < 0) return false;
 
     // إصدار المقدمة
-    emit_prologue(func, out, callee_regs, callee_count);
+    emit_prologue(ctx, func, out, callee_regs, callee_count);
 
     // إصدار تعليمات الجسم
     for (MachineBlock* block = func->blocks; block; block = block->next) {
         for (MachineInst* inst = block->first; inst; inst = inst->next) {
             if (inst->op != MACH_LABEL && inst->op != MACH_COMMENT) {
-                emit_debug_loc(out, inst);
+                emit_debug_loc(ctx, out, inst);
             }
             if (inst->op == MACH_RET) {
                 // عند الرجوع: إصدار قيمة الإرجاع الافتراضية إذا كانت main
                 // ثم إصدار الخاتمة
-                emit_epilogue(func, out, callee_regs, callee_count);
+                emit_epilogue(ctx, func, out, callee_regs, callee_count);
             } else if (inst->op == MACH_TAILJMP) {
                 // نداء_ذيلي: تفكيك الإطار ثم قفز إلى الهدف
-                emit_tailjmp(func, inst, out, callee_regs, callee_count);
+                emit_tailjmp(ctx, func, inst, out, callee_regs, callee_count);
             } else {
-                emit_inst(inst, func, out);
+                emit_inst(ctx, inst, out);
             }
         }
     }
@@ -66,12 +89,13 @@ bool emit_func(MachineFunc* func, FILE* out) {
         }
         if (!has_ret) {
             if (is_main) {
-                fprintf(out, "    mov $0, %%rax\n");
+                emit_buf_puts(out, "    mov $0, %rax\n");
             }
-            emit_epilogue(func, out, callee_regs, callee_count);
+            emit_epilogue(ctx, func, out, callee_regs, callee_count);
         }
     }
 
+    emit_jump_tables(ctx, func, out);
     return true;
 }
 
@@ -79,50 +103,150 @@ bool emit_func(MachineFunc* func, FILE* out) {
 // إصدار وحدة كاملة (Module Emission)
 // ============================================================================
 
-bool emit_module_ex2(MachineModule* module, FILE* out, bool debug_info,
-                     const BaaTarget* target, BaaCodegenOptions opts) {
-    if (!module || !out) return false;
+/** إصدار موزّع: مخزن في الذاكرة لكل دالة معرّفة وسياق لكل عامل. */
+typedef struct {
+    const EmitContext* base; // سياق الوحدة (بلا معلومات ديبغ)
+    MachineFunc** funcs;     // الدوال المعرّفة فقط (بلا نماذج أولية)
+    EmitBuf* bufs;
+    bool* ok;
+    EmitContext* worker_ctx;
+} EmitParallel;
+
+static void emit_worker_begin(void* opaque, int worker) {
+    EmitParallel* par = (EmitParallel*)opaque;
+    par->worker_ctx[worker] = *par->base;
+}
+
+static void emit_worker_run(void* opaque, int index, int worker) {
+    EmitParallel* par = (EmitParallel*)opaque;
+    EmitContext* ctx = &par->worker_ctx[worker];
+
+    // الـ uid هو ترتيب الدالة بين المعرّفات، كما يعطيه الإصدار التسلسلي.
+    ctx->next_func_uid = par->base->next_func_uid + index;
+    emit_buf_init(&par->bufs[index], NULL);
+    par->ok[index] = emit_func(ctx, par->funcs[index], &par->bufs[index]) &&
+                     !par->bufs[index].failed;
+}
+
+/**
+ * @brief إصدار الدوال على المجمّع ثم كتابتها بالترتيب.
+ *
+ * الثمن أن نص كل الدوال يبقى في الذاكرة حتى الكتابة.
+ */
+static bool emit_funcs_parallel(EmitContext* ctx, MachineModule* module, EmitBuf* out,
+                                BaaThreadPool* pool) {
+    int count = 0;
+    for (MachineFunc* func = module->funcs; func; func = func->next) {
+        if (!func->is_prototype) count++;
+    }
+    if (count == 0) return true;
 
-    g_emit_target = target ? target : baa_target_builtin_windows_x86_64();
-    g_emit_cc = (g_emit_target && g_emit_target->cc) ? g_emit_target->cc : baa_target_builtin_windows_x86_64()->cc;
-    g_emit_opts = opts;
+    EmitParallel par = {0};
+    par.base = ctx;
+    par.funcs = (MachineFunc**)calloc((size_t)count, sizeof(MachineFunc*));
+    par.bufs = (EmitBuf*)calloc((size_t)count, sizeof(EmitBuf));
+    par.ok = (bool*)calloc((size_t)count, sizeof(bool));
+    par.worker_ctx = (EmitContext*)calloc((size_t)baa_thread_pool_size(pool), sizeof(EmitContext));
+    bool ok = par.funcs && par.bufs && par.ok && par.worker_ctx;
 
-    g_emit_debug_info = debug_info ? true : false;
-    g_emit_asm_comments = opts.asm_comments ? true : false;
-    emit_debug_reset();
+    if (ok) {
+        int n = 0;
+        for (MachineFunc* func = module->funcs; func; func = func->next) {
+            if (!func->is_prototype) par.funcs[n++] = func;
+        }
+
+        BaaParallelJob job = {
+            .ctx = &par,
+            .worker_begin = emit_worker_begin,
+            .run = emit_worker_run,
+        };
+        baa_thread_pool_run(pool, &job, count);
 
-    // إعادة تعيين بادئات الدوال لضمان حتمية أسماء التسميات داخل كل ملف .s
-    g_emit_next_func_uid = 0;
-    g_emit_current_func_uid = 0;
+        for (int i = 0; i < count; i++) {
+            if (ok && !par.ok[i]) ok = false;
+            if (ok) {
+                emit_buf_write(out, par.bufs[i].data, par.bufs[i].len);
+                ok = emit_buf_flush(out);
+            }
+            emit_buf_free(&par.bufs[i]);
+        }
+        ctx->next_func_uid += count;
+    }
 
+    free(par.funcs);
+    free(par.bufs);
+    free(par.ok);
+    free(par.worker_ctx);
+    return ok;
+}
+
+/**
+ * @brief جسم emit_module_ex3: النص يُجمع في المخزن ويُفرَّغ مرة بعد البيانات
+ * ومرة بعد كل دالة، فتبقى الذاكرة بحجم أكبر دالة لا الوحدة كلها.
+ */
+static bool emit_module_buf(EmitContext* ctx, MachineModule* module, EmitBuf* out,
+                            BaaThreadPool* pool) {
     // 1. قسم البيانات الثابتة (صيغ الطباعة)
-    emit_rdata_section(out);
+    emit_rdata_section(ctx, out);
 
     // 2. قسم البيانات العامة (المتغيرات)
-    emit_data_section(module, out);
+    emit_data_section(ctx, module, out);
 
     // 3. قسم النصوص (الدوال)
-    fprintf(out, "\n.text\n");
+    emit_buf_puts(out, "\n.text\n");
+    if (!emit_buf_flush(out)) return false;
 
-    for (MachineFunc* func = module->funcs; func; func = func->next) {
-        if (!emit_func(func, out)) {
-            return false;
+    // حالة .loc/.file مشتركة عبر الدوال، فمع معلومات الديبغ يبقى الإصدار تسلسلياً.
+    if (pool && !ctx->debug_info) {
+        if (!emit_funcs_parallel(ctx, module, out, pool)) return false;
+    } else {
+        for (MachineFunc* func = module->funcs; func; func = func->next) {
+            if (!emit_func(ctx, func, out)) {
+                return false;
+            }
+            if (!emit_buf_flush(out)) return false;
         }
     }
 
     // 4. جدول النصوص
-    emit_string_table(module, out);
-    emit_baa_string_table(module, out);
+    emit_string_table(ctx, module, out);
+    emit_baa_string_table(ctx, module, out);
 
     // 5. وسم "لا مكدس تنفيذي" على ELF لتفادي تحذيرات ld
-    if (g_emit_target && g_emit_target->obj_format == BAA_OBJFORMAT_ELF)
+    if (ctx->target && ctx->target->obj_format == BAA_OBJFORMAT_ELF)
     {
-        fprintf(out, "\n.section .note.GNU-stack,\"\",@progbits\n");
+        emit_buf_puts(out, "\n.section .note.GNU-stack,\"\",@progbits\n");
     }
+    return emit_buf_flush(out);
+}
 
-    emit_debug_reset();
+bool emit_module_ex3(MachineModule* module, FILE* out, bool debug_info,
+                     const BaaTarget* target, BaaCodegenOptions opts, BaaThreadPool* pool) {
+    if (!module || !out) return false;
 
-    return true;
+    EmitContext ctx_storage = {0};
+    EmitContext* ctx = &ctx_storage;
+    ctx->target = target ? target : baa_target_builtin_windows_x86_64();
+    ctx->cc = (ctx->target && ctx->target->cc) ? ctx->target->cc : baa_target_builtin_windows_x86_64()->cc;
+    ctx->opts = opts;
+
+    ctx->debug_info = debug_info ? true : false;
+    ctx->asm_comments = opts.asm_comments ? true : false;
+    emit_debug_reset(ctx);
+
+    EmitBuf buf;
+    emit_buf_init(&buf, out);
+    bool ok = emit_module_buf(ctx, module, &buf, pool);
+    emit_buf_free(&buf);
+
+    emit_debug_reset(ctx);
+
+    return ok;
+}
+
+bool emit_module_ex2(MachineModule* module, FILE* out, bool debug_info,
+                     const BaaTarget* target, BaaCodegenOptions opts) {
+    return emit_module_ex3(module, out, debug_info, target, opts, NULL);
 }
 
 bool emit_module_ex(MachineModule* module, FILE* out, bool debug_info, const BaaTarget* target) {
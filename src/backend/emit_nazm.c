@@ -10,14 +10,15 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "emit_buf.h"
 #include "regalloc.h"
 
 static BaaNazmEmitResult nazm_validate_globals(const MachineModule *module);
 static BaaNazmEmitResult nazm_validate_string_tables(const MachineModule *module);
-static unsigned nazm_write_globals(FILE *out, const MachineModule *module);
-static unsigned nazm_write_string_tables(FILE *out, const MachineModule *module);
-static void nazm_write_symbol(FILE *out, const char *name);
-static void nazm_write_symbolic_memory_operand(FILE *out, const char *name);
+static unsigned nazm_write_globals(EmitBuf *out, const MachineModule *module);
+static unsigned nazm_write_string_tables(EmitBuf *out, const MachineModule *module);
+static void nazm_write_symbol(EmitBuf *out, const char *name);
+static void nazm_write_symbolic_memory_operand(EmitBuf *out, const char *name);
 
 #include "emit_nazm_names.c"
 
@@ -542,6 +543,12 @@ static BaaNazmEmitResult nazm_validate_instruction(const MachineInst *inst,
                 "هدف القفز الذيلي ليس سجلا بعرض ٦٤ بت أو رمز دالة عربيا.",
                 inst);
 
+        case MACH_JMP_TABLE:
+            if (inst->src2.kind != MACH_OP_IMM || inst->src2.data.imm < 0)
+                return nazm_unsupported("جدول_قفز_غير_صالح", NULL,
+                                        "رقم جدول القفز ليس قيمة فورية صالحة.", inst);
+            return nazm_validate_value_operand(&inst->src1, target, inst, false);
+
         case MACH_PUSH:
             if (nazm_operand_bits(&inst->src1) != 64)
                 return nazm_unsupported("عرض_دفع", NULL,
@@ -613,30 +620,29 @@ static BaaNazmEmitResult nazm_validate_module(const MachineModule *module,
     return nazm_ok();
 }
 
-static void nazm_write_unsigned(FILE *out, uint64_t value)
+static void nazm_write_unsigned(EmitBuf *out, uint64_t value)
 {
-    static const char *const digits[10] = {
-        "٠", "١", "٢", "٣", "٤", "٥", "٦", "٧", "٨", "٩"
-    };
-    unsigned reversed[32];
-    size_t count = 0;
+    // الأرقام العربية الهندية U+0660..U+0669 تُرمَّز في UTF-8 كبايتين D9 A0+n،
+    // فيُبنى العدد كاملاً في مخزن محلي ويُكتب دفعة واحدة.
+    char bytes[40];
+    size_t pos = sizeof(bytes);
 
     do
     {
-        reversed[count++] = (unsigned)(value % 10u);
+        bytes[--pos] = (char)(0xA0u + (unsigned)(value % 10u));
+        bytes[--pos] = (char)0xD9u;
         value /= 10u;
     } while (value != 0u);
 
-    while (count > 0)
-        fputs(digits[reversed[--count]], out);
+    emit_buf_write(out, bytes + pos, sizeof(bytes) - pos);
 }
 
-static void nazm_write_signed(FILE *out, int64_t value)
+static void nazm_write_signed(EmitBuf *out, int64_t value)
 {
     uint64_t magnitude;
     if (value < 0)
     {
-        fputc('-', out);
+        emit_buf_putc(out, '-');
         magnitude = (uint64_t)(-(value + 1));
         magnitude += 1u;
     }
@@ -647,27 +653,27 @@ static void nazm_write_signed(FILE *out, int64_t value)
     nazm_write_unsigned(out, magnitude);
 }
 
-static void nazm_write_generated_string_label(FILE *out,
+static void nazm_write_generated_string_label(EmitBuf *out,
                                               bool is_baa_string,
                                               uint64_t id)
 {
-    fputs(is_baa_string ? "سلسلة_باء_" : "سلسلة_سي_", out);
+    emit_buf_puts(out, is_baa_string ? "سلسلة_باء_" : "سلسلة_سي_");
     nazm_write_unsigned(out, id);
 }
 
-static void nazm_write_symbol(FILE *out, const char *name)
+static void nazm_write_symbol(EmitBuf *out, const char *name)
 {
     const char *arabic_abi = nazm_arabic_abi_symbol(name);
     if (arabic_abi)
     {
-        fputs(arabic_abi, out);
+        emit_buf_puts(out, arabic_abi);
         return;
     }
 
     if (nazm_is_generated_static_symbol(name))
     {
         static const char prefix[] = "__baa_static_";
-        fputs("تخزين_ساكن_", out);
+        emit_buf_puts(out, "تخزين_ساكن_");
         for (const unsigned char *p =
                  (const unsigned char *)(name + sizeof(prefix) - 1u);
              *p;
@@ -676,7 +682,7 @@ static void nazm_write_symbol(FILE *out, const char *name)
             if (*p >= (unsigned char)'0' && *p <= (unsigned char)'9')
                 nazm_write_unsigned(out, (uint64_t)(*p - (unsigned char)'0'));
             else
-                fputc((int)*p, out);
+                emit_buf_putc(out, (char)*p);
         }
         return;
     }
@@ -688,10 +694,10 @@ static void nazm_write_symbol(FILE *out, const char *name)
         nazm_write_generated_string_label(out, is_baa_string, id);
         return;
     }
-    fputs(name, out);
+    emit_buf_puts(out, name);
 }
 
-static unsigned nazm_write_arabic_abi_externals(FILE *out)
+static unsigned nazm_write_arabic_abi_externals(EmitBuf *out)
 {
     unsigned lines = 0;
     for (size_t i = 0;
@@ -710,15 +716,15 @@ static unsigned nazm_write_arabic_abi_externals(FILE *out)
             }
         }
         if (seen) continue;
-        fputs(".خارجي ", out);
-        fputs(symbol, out);
-        fputc('\n', out);
+        emit_buf_puts(out, ".خارجي ");
+        emit_buf_puts(out, symbol);
+        emit_buf_putc(out, '\n');
         lines += 1;
     }
     return lines;
 }
 
-static void nazm_write_operand(FILE *out, const MachineOperand *operand)
+static void nazm_write_operand(EmitBuf *out, const MachineOperand *operand)
 {
     if (operand->kind == MACH_OP_IMM)
     {
@@ -728,40 +734,40 @@ static void nazm_write_operand(FILE *out, const MachineOperand *operand)
 
     if (operand->kind == MACH_OP_XMM)
     {
-        fputs(k_nazm_decimal_registers[operand->data.xmm], out);
+        emit_buf_puts(out, k_nazm_decimal_registers[operand->data.xmm]);
         return;
     }
 
-    fputs(nazm_register_name(operand->data.vreg, operand->size_bits), out);
+    emit_buf_puts(out, nazm_register_name(operand->data.vreg, operand->size_bits));
 }
 
-static void nazm_write_memory_operand(FILE *out, const MachineOperand *operand)
+static void nazm_write_memory_operand(EmitBuf *out, const MachineOperand *operand)
 {
-    fputc('[', out);
-    fputs(nazm_register_name(operand->data.mem.base_vreg, 64), out);
+    emit_buf_putc(out, '[');
+    emit_buf_puts(out, nazm_register_name(operand->data.mem.base_vreg, 64));
     if (operand->data.mem.offset > 0)
     {
-        fputc('+', out);
+        emit_buf_putc(out, '+');
         nazm_write_unsigned(out, (uint64_t)operand->data.mem.offset);
     }
     else if (operand->data.mem.offset < 0)
     {
         int64_t offset = operand->data.mem.offset;
-        fputc('-', out);
+        emit_buf_putc(out, '-');
         nazm_write_unsigned(out, (uint64_t)(-offset));
     }
-    fputc(']', out);
+    emit_buf_putc(out, ']');
 }
 
 #include "emit_nazm_lowering.c"
 
-static void nazm_write_local_label(FILE *out,
+static void nazm_write_local_label(EmitBuf *out,
                                    unsigned function_id,
                                    int label_id)
 {
-    fputs("كتلة_", out);
+    emit_buf_puts(out, "كتلة_");
     nazm_write_unsigned(out, function_id);
-    fputc('_', out);
+    emit_buf_putc(out, '_');
     nazm_write_unsigned(out, (uint64_t)label_id);
 }
 
@@ -778,7 +784,7 @@ static int nazm_frame_size(const MachineFunc *func,
     return total;
 }
 
-static unsigned nazm_write_epilogue(FILE *out,
+static unsigned nazm_write_epilogue(EmitBuf *out,
                                     const MachineFunc *func,
                                     const BaaTarget *target,
                                     const PhysReg *callee_regs,
@@ -787,56 +793,56 @@ static unsigned nazm_write_epilogue(FILE *out,
     for (int i = callee_count - 1; i >= 0; --i)
     {
         int offset = -(func->stack_size + target->cc->shadow_space_bytes + (i + 1) * 8);
-        fputs("    انقل ", out);
-        fputs(nazm_register_name(callee_regs[i], 64), out);
-        fputs("، [مؤشر_القاعدة", out);
+        emit_buf_puts(out, "    انقل ");
+        emit_buf_puts(out, nazm_register_name(callee_regs[i], 64));
+        emit_buf_puts(out, "، [مؤشر_القاعدة");
         nazm_write_signed(out, offset);
-        fputs("]\n", out);
+        emit_buf_puts(out, "]\n");
     }
-    fputs("    انقل مؤشر_المكدس، مؤشر_القاعدة\n", out);
-    fputs("    اسحب مؤشر_القاعدة\n", out);
-    fputs("    ارجع\n", out);
+    emit_buf_puts(out, "    انقل مؤشر_المكدس، مؤشر_القاعدة\n");
+    emit_buf_puts(out, "    اسحب مؤشر_القاعدة\n");
+    emit_buf_puts(out, "    ارجع\n");
     return (unsigned)(callee_count + 3);
 }
 
 #include "emit_nazm_data.c"
 #include "emit_nazm_function.c"
 
-BaaNazmEmitResult emit_nazm_module_with_source_map(const MachineModule *module,
-                                                   FILE *out,
-                                                   FILE *source_map,
-                                                   const char *generated_path,
-                                                   const BaaTarget *target,
-                                                   bool debug_info)
+static BaaNazmEmitResult nazm_io_error(const char *reason)
 {
-    if (!out)
-    {
-        BaaNazmEmitResult result = {0};
-        result.status = BAA_NAZM_EMIT_IO_ERROR;
-        result.op = MACH_OP_COUNT;
-        result.reason = "ملف خرج نظم غير صالح.";
-        return result;
-    }
+    BaaNazmEmitResult result = {0};
+    result.status = BAA_NAZM_EMIT_IO_ERROR;
+    result.op = MACH_OP_COUNT;
+    result.reason = reason;
+    return result;
+}
 
+/**
+ * @brief جسم الإصدار المشترك بين الخرج إلى ملف والخرج إلى الذاكرة.
+ *
+ * يُفرَّغ out بعد كل دالة؛ إن لم يكن له sink يبقى النص كله في المخزن.
+ * source_map اختياري ولا يُكتب إلا عند نهاية الوحدة.
+ */
+static BaaNazmEmitResult nazm_emit_module_buf(const MachineModule *module,
+                                              EmitBuf *out,
+                                              EmitBuf *source_map,
+                                              const char *generated_path,
+                                              const BaaTarget *target,
+                                              bool debug_info)
+{
     BaaNazmEmitResult validation = nazm_validate_module(module, target);
     if (validation.status != BAA_NAZM_EMIT_OK) return validation;
 
     NazmSourceMapWriter map = {0};
     if (!nazm_source_map_begin(&map, source_map, generated_path))
-    {
-        BaaNazmEmitResult result = {0};
-        result.status = BAA_NAZM_EMIT_IO_ERROR;
-        result.op = MACH_OP_COUNT;
-        result.reason = "فشلت كتابة خريطة مصدر نظم.";
-        return result;
-    }
+        return nazm_io_error("فشلت كتابة خريطة مصدر نظم.");
     map.debug_info = debug_info;
 
-    fputs("; مصدر نظم مولد من باء\n", out);
+    emit_buf_puts(out, "; مصدر نظم مولد من باء\n");
     map.generated_line = 1;
     map.generated_line += nazm_write_string_tables(out, module);
     map.generated_line += nazm_write_globals(out, module);
-    fputs(".نص\n", out);
+    emit_buf_puts(out, ".نص\n");
     map.generated_line += 1;
     map.generated_line += nazm_write_arabic_abi_externals(out);
 
@@ -846,9 +852,9 @@ BaaNazmEmitResult emit_nazm_module_with_source_map(const MachineModule *module,
             !nazm_arabic_abi_symbol(func->name) &&
             !nazm_identifier_has_ascii_letter(func->name))
         {
-            fputs(".خارجي ", out);
+            emit_buf_puts(out, ".خارجي ");
             nazm_write_symbol(out, func->name);
-            fputc('\n', out);
+            emit_buf_putc(out, '\n');
             map.generated_line += 1;
         }
     }
@@ -857,27 +863,94 @@ BaaNazmEmitResult emit_nazm_module_with_source_map(const MachineModule *module,
     for (const MachineFunc *func = module->funcs; func; func = func->next)
     {
         if (!func->is_prototype)
+        {
             nazm_write_function(out, func, target, function_id++, &map);
+            emit_buf_flush(out);
+        }
     }
 
-    if (map.debug_error ||
-        !nazm_source_map_end(&map) ||
-        ferror(out))
-    {
-        free(map.debug_files);
-        BaaNazmEmitResult result = {0};
-        result.status = BAA_NAZM_EMIT_IO_ERROR;
-        result.op = MACH_OP_COUNT;
-        result.reason = map.debug_error
-                      ? "نفدت الذاكرة أثناء بناء جدول ملفات التنقيح لنظم."
-                      : "فشلت كتابة مصدر نظم أو خريطته.";
-        return result;
-    }
-
+    bool map_ok = nazm_source_map_end(&map);
+    bool out_ok = emit_buf_flush(out);
     free(map.debug_files);
+    if (map.debug_error)
+        return nazm_io_error("نفدت الذاكرة أثناء بناء جدول ملفات التنقيح لنظم.");
+    if (!map_ok || !out_ok)
+        return nazm_io_error("فشلت كتابة مصدر نظم أو خريطته.");
     return nazm_ok();
 }
 
+BaaNazmEmitResult emit_nazm_module_with_source_map(const MachineModule *module,
+                                                   FILE *out,
+                                                   FILE *source_map,
+                                                   const char *generated_path,
+                                                   const BaaTarget *target,
+                                                   bool debug_info)
+{
+    if (!out) return nazm_io_error("ملف خرج نظم غير صالح.");
+
+    // يُجمع النص في مخزن ويُكتب بعملية واحدة لكل دالة بدل fputs لكل رمز.
+    EmitBuf out_buf;
+    EmitBuf map_buf;
+    emit_buf_init(&out_buf, out);
+    emit_buf_init(&map_buf, source_map);
+    BaaNazmEmitResult result = nazm_emit_module_buf(module,
+                                                    &out_buf,
+                                                    source_map ? &map_buf : NULL,
+                                                    generated_path,
+                                                    target,
+                                                    debug_info);
+    emit_buf_free(&out_buf);
+    emit_buf_free(&map_buf);
+    return result;
+}
+
+/**
+ * @brief نقل ملكية محتوى المخزن إلى text مع صفر منهٍ لا يدخل في size.
+ */
+static bool nazm_take_text(EmitBuf *buf, BaaNazmText *text)
+{
+    emit_buf_putc(buf, '\0');
+    if (buf->failed) return false;
+    text->data = buf->data;
+    text->size = buf->len - 1u;
+    buf->data = NULL;
+    return true;
+}
+
+BaaNazmEmitResult emit_nazm_module_to_memory(const MachineModule *module,
+                                             const char *generated_path,
+                                             const BaaTarget *target,
+                                             bool debug_info,
+                                             BaaNazmText *out_source,
+                                             BaaNazmText *out_source_map)
+{
+    if (!out_source) return nazm_io_error("مخزن خرج نظم غير صالح.");
+    memset(out_source, 0, sizeof(*out_source));
+    if (out_source_map) memset(out_source_map, 0, sizeof(*out_source_map));
+
+    EmitBuf out_buf;
+    EmitBuf map_buf;
+    emit_buf_init(&out_buf, NULL);
+    emit_buf_init(&map_buf, NULL);
+    BaaNazmEmitResult result = nazm_emit_module_buf(module,
+                                                    &out_buf,
+                                                    out_source_map ? &map_buf : NULL,
+                                                    generated_path,
+                                                    target,
+                                                    debug_info);
+    if (result.status == BAA_NAZM_EMIT_OK &&
+        (!nazm_take_text(&out_buf, out_source) ||
+         (out_source_map && !nazm_take_text(&map_buf, out_source_map))))
+    {
+        free(out_source->data);
+        memset(out_source, 0, sizeof(*out_source));
+        result = nazm_io_error("نفدت الذاكرة أثناء بناء مصدر نظم.");
+    }
+    emit_buf_free(&out_buf);
+    emit_buf_free(&map_buf);
+    return result;
+}
+
 BaaNazmEmitResult emit_nazm_module(const MachineModule *module,
                                    FILE *out,
                                    const BaaTarget *target)
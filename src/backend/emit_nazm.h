@@ -7,6 +7,7 @@
 #define BAA_EMIT_NAZM_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 
 #include "isel.h"
@@ -54,4 +55,26 @@ BaaNazmEmitResult emit_nazm_module_with_source_map(const MachineModule *module,
                                                    const BaaTarget *target,
                                                    bool debug_info);
 
+/**
+ * @brief نص مولد في الذاكرة يملكه المستدعي (free(data))؛ data منتهٍ بصفر.
+ */
+typedef struct
+{
+    char *data;
+    size_t size;
+} BaaNazmText;
+
+/**
+ * @brief إصدار مصدر نظم وخريطته إلى الذاكرة بدل الملفات.
+ *
+ * يخدم مسار المجمّع المضمن: يُسلَّم النص مباشرة إلى nazm_assemble_buffer
+ * دون كتابة `.نظم` مؤقت ثم قراءته. out_source_map اختياري.
+ */
+BaaNazmEmitResult emit_nazm_module_to_memory(const MachineModule *module,
+                                             const char *generated_path,
+                                             const BaaTarget *target,
+                                             bool debug_info,
+                                             BaaNazmText *out_source,
+                                             BaaNazmText *out_source_map);
+
 #endif
@@ -194,11 +194,11 @@ static BaaNazmEmitResult nazm_validate_string_tables(const MachineModule *module
     return nazm_ok();
 }
 
-static void nazm_write_data_value(FILE *out, const IRValue *value)
+static void nazm_write_data_value(EmitBuf *out, const IRValue *value)
 {
     if (!value || value->kind == IR_VAL_NONE)
     {
-        fputs("٠", out);
+        emit_buf_puts(out, "٠");
         return;
     }
     if (value->kind == IR_VAL_CONST_INT)
@@ -258,30 +258,30 @@ static uint64_t nazm_pack_baa_character(const unsigned char **cursor)
     return bytes_field | ((uint64_t)(unsigned)length << 32);
 }
 
-static unsigned nazm_write_string_tables(FILE *out,
+static unsigned nazm_write_string_tables(EmitBuf *out,
                                          const MachineModule *module)
 {
     if (!module || (!module->strings && !module->baa_strings)) return 0;
 
-    fputs(".بيانات_للقراءة\n", out);
+    emit_buf_puts(out, ".بيانات_للقراءة\n");
     unsigned lines = 1;
     for (const IRStringEntry *string = module->strings;
          string;
          string = string->next)
     {
         nazm_write_generated_string_label(out, false, (uint64_t)string->id);
-        fputs(":\n", out);
+        emit_buf_puts(out, ":\n");
         lines += 1;
         for (const unsigned char *p = (const unsigned char *)string->content;
              *p;
              ++p)
         {
-            fputs("    .عدد٨ ", out);
+            emit_buf_puts(out, "    .عدد٨ ");
             nazm_write_unsigned(out, (uint64_t)*p);
-            fputc('\n', out);
+            emit_buf_putc(out, '\n');
             lines += 1;
         }
-        fputs("    .عدد٨ ٠\n", out);
+        emit_buf_puts(out, "    .عدد٨ ٠\n");
         lines += 1;
     }
 
@@ -289,30 +289,30 @@ static unsigned nazm_write_string_tables(FILE *out,
          string;
          string = string->next)
     {
-        fputs("    .محاذاة ٨\n", out);
+        emit_buf_puts(out, "    .محاذاة ٨\n");
         nazm_write_generated_string_label(out, true, (uint64_t)string->id);
-        fputs(":\n", out);
+        emit_buf_puts(out, ":\n");
         lines += 2;
         const unsigned char *cursor = (const unsigned char *)string->content;
         while (*cursor)
         {
             uint64_t packed = nazm_pack_baa_character(&cursor);
-            fputs("    .عدد٦٤ ", out);
+            emit_buf_puts(out, "    .عدد٦٤ ");
             nazm_write_unsigned(out, packed);
-            fputc('\n', out);
+            emit_buf_putc(out, '\n');
             lines += 1;
         }
-        fputs("    .عدد٦٤ ٠\n", out);
+        emit_buf_puts(out, "    .عدد٦٤ ٠\n");
         lines += 1;
     }
     return lines;
 }
 
-static unsigned nazm_write_global(FILE *out, const IRGlobal *global)
+static unsigned nazm_write_global(EmitBuf *out, const IRGlobal *global)
 {
-    fputs(global->is_internal ? ".محلي " : ".عام ", out);
+    emit_buf_puts(out, global->is_internal ? ".محلي " : ".عام ");
     nazm_write_symbol(out, global->name);
-    fputc('\n', out);
+    emit_buf_putc(out, '\n');
     unsigned lines = 1;
 
     if (global->type->kind == IR_TYPE_ARRAY)
@@ -333,14 +333,14 @@ static unsigned nazm_write_global(FILE *out, const IRGlobal *global)
         nazm_write_symbol(out, global->name);
         if (all_zero)
         {
-            fputs(": .مساحة_صفرية ", out);
+            emit_buf_puts(out, ": .مساحة_صفرية ");
             nazm_write_unsigned(out,
                 (uint64_t)(unsigned)count * (uint64_t)(unsigned)(bits / 8));
-            fputc('\n', out);
+            emit_buf_putc(out, '\n');
             return lines + 1;
         }
 
-        fputs(":\n", out);
+        emit_buf_puts(out, ":\n");
         lines += 1;
         for (int i = 0; i < count; ++i)
         {
@@ -348,11 +348,11 @@ static unsigned nazm_write_global(FILE *out, const IRGlobal *global)
                 global->init_elems && i < global->init_elem_count
                     ? global->init_elems[i]
                     : NULL;
-            fputs("    ", out);
-            fputs(nazm_data_directive(bits), out);
-            fputc(' ', out);
+            emit_buf_puts(out, "    ");
+            emit_buf_puts(out, nazm_data_directive(bits));
+            emit_buf_putc(out, ' ');
             nazm_write_data_value(out, value);
-            fputc('\n', out);
+            emit_buf_putc(out, '\n');
             lines += 1;
         }
         return lines;
@@ -360,11 +360,11 @@ static unsigned nazm_write_global(FILE *out, const IRGlobal *global)
 
     int bits = nazm_data_type_bits(global->type);
     nazm_write_symbol(out, global->name);
-    fputs(": ", out);
-    fputs(nazm_data_directive(bits), out);
-    fputc(' ', out);
+    emit_buf_puts(out, ": ");
+    emit_buf_puts(out, nazm_data_directive(bits));
+    emit_buf_putc(out, ' ');
     nazm_write_data_value(out, global->init);
-    fputc('\n', out);
+    emit_buf_putc(out, '\n');
     return lines + 1;
 }
 
@@ -381,7 +381,7 @@ static bool nazm_module_defines_global(const MachineModule *module,
     return false;
 }
 
-static unsigned nazm_write_globals(FILE *out, const MachineModule *module)
+static unsigned nazm_write_globals(EmitBuf *out, const MachineModule *module)
 {
     unsigned lines = 0;
     bool has_storage = false;
@@ -391,9 +391,9 @@ static unsigned nazm_write_globals(FILE *out, const MachineModule *module)
         if (global->is_extern &&
             !nazm_module_defines_global(module, global->name))
         {
-            fputs(".خارجي ", out);
+            emit_buf_puts(out, ".خارجي ");
             nazm_write_symbol(out, global->name);
-            fputc('\n', out);
+            emit_buf_putc(out, '\n');
             lines += 1;
         }
         else
@@ -403,7 +403,7 @@ static unsigned nazm_write_globals(FILE *out, const MachineModule *module)
     }
 
     if (!has_storage) return lines;
-    fputs(".بيانات\n", out);
+    emit_buf_puts(out, ".بيانات\n");
     lines += 1;
     for (const IRGlobal *global = module->globals; global; global = global->next)
     {
@@ -7,7 +7,7 @@
  * canonical Nazm emitter.
  */
 
-static unsigned nazm_write_tailjmp(FILE *out,
+static unsigned nazm_write_tailjmp(EmitBuf *out,
                                    const MachineFunc *func,
                                    const BaaTarget *target,
                                    const PhysReg *callee_regs,
@@ -18,24 +18,87 @@ static unsigned nazm_write_tailjmp(FILE *out,
     {
         int offset = -(func->stack_size + target->cc->shadow_space_bytes +
                        (i + 1) * 8);
-        fputs("    انقل ", out);
-        fputs(nazm_register_name(callee_regs[i], 64), out);
-        fputs("، [مؤشر_القاعدة", out);
+        emit_buf_puts(out, "    انقل ");
+        emit_buf_puts(out, nazm_register_name(callee_regs[i], 64));
+        emit_buf_puts(out, "، [مؤشر_القاعدة");
         nazm_write_signed(out, offset);
-        fputs("]\n", out);
+        emit_buf_puts(out, "]\n");
     }
-    fputs("    انقل مؤشر_المكدس، مؤشر_القاعدة\n", out);
-    fputs("    اسحب مؤشر_القاعدة\n", out);
-    fputs("    اقفز ", out);
+    emit_buf_puts(out, "    انقل مؤشر_المكدس، مؤشر_القاعدة\n");
+    emit_buf_puts(out, "    اسحب مؤشر_القاعدة\n");
+    emit_buf_puts(out, "    اقفز ");
     if (jump_target->kind == MACH_OP_FUNC)
         nazm_write_symbol(out, jump_target->data.name);
     else
         nazm_write_operand(out, jump_target);
-    fputc('\n', out);
+    emit_buf_putc(out, '\n');
     return (unsigned)(callee_count + 3);
 }
 
-static void nazm_write_function(FILE *out,
+static void nazm_write_jump_table_label(EmitBuf *out,
+                                        unsigned function_id,
+                                        int64_t table)
+{
+    emit_buf_puts(out, "جدول_قفز_");
+    nazm_write_unsigned(out, function_id);
+    emit_buf_putc(out, '_');
+    nazm_write_unsigned(out, (uint64_t)table);
+}
+
+/**
+ * القفز عبر جدول: الفهرس في المركم، وعنوان الجدول في r11، ثم قراءة
+ * المدخل (عنوان مطلق ٦٤ بت) والقفز إليه.
+ */
+static unsigned nazm_write_jump_table_dispatch(EmitBuf *out,
+                                               unsigned function_id,
+                                               const MachineInst *inst)
+{
+    MachineOperand index = nazm_scratch_operand(PHYS_RAX, 64);
+    MachineOperand source = inst->src1;
+    source.size_bits = 64;
+    unsigned lines = nazm_write_move(out, &index, &source);
+    emit_buf_puts(out, "    احسب_عنوان سجل_عام_١١، [مؤشر_التعليمة+");
+    nazm_write_jump_table_label(out, function_id, inst->src2.data.imm);
+    emit_buf_puts(out, "]\n");
+    emit_buf_puts(out, "    ازح_يسارا سجل_المركم، ٣\n");
+    emit_buf_puts(out, "    أضف سجل_المركم، سجل_عام_١١\n");
+    emit_buf_puts(out, "    انقل سجل_المركم، [سجل_المركم]\n");
+    emit_buf_puts(out, "    اقفز سجل_المركم\n");
+    return lines + 5;
+}
+
+/**
+ * جداول القفز في قسم البيانات: مدخلات مطلقة لا تحتاج عنونة نسبية
+ * بين رمزين.
+ */
+static unsigned nazm_write_jump_tables(EmitBuf *out,
+                                       const MachineFunc *func,
+                                       unsigned function_id)
+{
+    if (func->jump_table_count <= 0) return 0;
+
+    emit_buf_puts(out, ".بيانات\n");
+    unsigned lines = 1;
+    for (int t = 0; t < func->jump_table_count; ++t)
+    {
+        const MachineJumpTable *table = &func->jump_tables[t];
+        emit_buf_puts(out, "    .محاذاة ٨\n");
+        nazm_write_jump_table_label(out, function_id, t);
+        emit_buf_puts(out, ":\n");
+        lines += 2;
+        for (int i = 0; i < table->count; ++i)
+        {
+            emit_buf_puts(out, "    .عدد٦٤ ");
+            nazm_write_local_label(out, function_id, table->label_ids[i]);
+            emit_buf_putc(out, '\n');
+            lines += 1;
+        }
+    }
+    emit_buf_puts(out, ".نص\n");
+    return lines + 1;
+}
+
+static void nazm_write_function(EmitBuf *out,
                                 const MachineFunc *func,
                                 const BaaTarget *target,
                                 unsigned function_id,
@@ -45,37 +108,37 @@ static void nazm_write_function(FILE *out,
     int callee_count = machine_func_collect_callee_saved(
         func, target, callee_regs, PHYS_REG_COUNT);
     if (callee_count < 0) callee_count = 0;
-    fputc('\n', out);
+    emit_buf_putc(out, '\n');
     map->generated_line += 1;
     map->generated_line +=
         nazm_write_debug_location_reset(out, map);
-    fputs(".عام ", out);
-    fputs(func->name, out);
-    fputc('\n', out);
+    emit_buf_puts(out, ".عام ");
+    emit_buf_puts(out, func->name);
+    emit_buf_putc(out, '\n');
     map->generated_line += 1;
-    fputs(func->name, out);
-    fputs(":\n", out);
-    fputs("    ادفع مؤشر_القاعدة\n", out);
-    fputs("    انقل مؤشر_القاعدة، مؤشر_المكدس\n", out);
+    emit_buf_puts(out, func->name);
+    emit_buf_puts(out, ":\n");
+    emit_buf_puts(out, "    ادفع مؤشر_القاعدة\n");
+    emit_buf_puts(out, "    انقل مؤشر_القاعدة، مؤشر_المكدس\n");
     map->generated_line += 3;
 
     int frame_size = nazm_frame_size(func, target, callee_count);
     if (frame_size > 0)
     {
-        fputs("    اطرح مؤشر_المكدس، ", out);
+        emit_buf_puts(out, "    اطرح مؤشر_المكدس، ");
         nazm_write_unsigned(out, (uint64_t)frame_size);
-        fputc('\n', out);
+        emit_buf_putc(out, '\n');
         map->generated_line += 1;
     }
 
     for (int i = 0; i < callee_count; ++i)
     {
         int offset = -(func->stack_size + target->cc->shadow_space_bytes + (i + 1) * 8);
-        fputs("    انقل [مؤشر_القاعدة", out);
+        emit_buf_puts(out, "    انقل [مؤشر_القاعدة");
         nazm_write_signed(out, offset);
-        fputs("]، ", out);
-        fputs(nazm_register_name(callee_regs[i], 64), out);
-        fputc('\n', out);
+        emit_buf_puts(out, "]، ");
+        emit_buf_puts(out, nazm_register_name(callee_regs[i], 64));
+        emit_buf_putc(out, '\n');
         map->generated_line += 1;
     }
 
@@ -92,7 +155,7 @@ static void nazm_write_function(FILE *out,
             {
                 case MACH_LABEL:
                     nazm_write_local_label(out, function_id, inst->dst.data.label_id);
-                    fputs(":\n", out);
+                    emit_buf_puts(out, ":\n");
                     emitted_lines = 1;
                     break;
 
@@ -146,13 +209,13 @@ static void nazm_write_function(FILE *out,
                 case MACH_IMUL:
                     if (inst->src2.kind == MACH_OP_IMM)
                     {
-                        fputs("    اضرب_موقع ", out);
+                        emit_buf_puts(out, "    اضرب_موقع ");
                         nazm_write_operand(out, &inst->dst);
-                        fputs("، ", out);
+                        emit_buf_puts(out, "، ");
                         nazm_write_operand(out, &inst->dst);
-                        fputs("، ", out);
+                        emit_buf_puts(out, "، ");
                         nazm_write_operand(out, &inst->src2);
-                        fputc('\n', out);
+                        emit_buf_putc(out, '\n');
                         emitted_lines = 1;
                     }
                     else
@@ -189,31 +252,32 @@ static void nazm_write_function(FILE *out,
 
                 case MACH_IDIV:
                 case MACH_DIV:
-                    fputs(inst->op == MACH_IDIV
-                              ? "    اقسم_موقع "
-                              : "    اقسم_غير_موقع ", out);
+                    emit_buf_puts(out,
+                                  inst->op == MACH_IDIV
+                                      ? "    اقسم_موقع "
+                                      : "    اقسم_غير_موقع ");
                     nazm_write_operand(out, &inst->src1);
-                    fputc('\n', out);
+                    emit_buf_putc(out, '\n');
                     emitted_lines = 1;
                     break;
 
                 case MACH_CQO:
-                    fputs("    وسع_إشارة_القسمة\n", out);
+                    emit_buf_puts(out, "    وسع_إشارة_القسمة\n");
                     emitted_lines = 1;
                     break;
 
                 case MACH_CPU_NOP:
-                    fputs("    لا_تفعل\n", out);
+                    emit_buf_puts(out, "    لا_تفعل\n");
                     emitted_lines = 1;
                     break;
 
                 case MACH_RDTSC:
-                    fputs("    اقرأ_عداد_الزمن\n", out);
-                    fputs("    ازح_يسارا سجل_البيانات، ٣٢\n", out);
-                    fputs("    أو_بتيا سجل_المركم، سجل_البيانات\n", out);
-                    fputs("    انقل ", out);
+                    emit_buf_puts(out, "    اقرأ_عداد_الزمن\n");
+                    emit_buf_puts(out, "    ازح_يسارا سجل_البيانات، ٣٢\n");
+                    emit_buf_puts(out, "    أو_بتيا سجل_المركم، سجل_البيانات\n");
+                    emit_buf_puts(out, "    انقل ");
                     nazm_write_operand(out, &inst->dst);
-                    fputs("، سجل_المركم\n", out);
+                    emit_buf_puts(out, "، سجل_المركم\n");
                     emitted_lines = 4;
                     break;
 
@@ -261,19 +325,24 @@ static void nazm_write_function(FILE *out,
                     break;
 
                 case MACH_JMP:
-                    fputs("    اقفز ", out);
+                    emit_buf_puts(out, "    اقفز ");
                     nazm_write_local_label(out, function_id, inst->dst.data.label_id);
-                    fputc('\n', out);
+                    emit_buf_putc(out, '\n');
                     emitted_lines = 1;
                     break;
 
+                case MACH_JMP_TABLE:
+                    emitted_lines = nazm_write_jump_table_dispatch(
+                        out, function_id, inst);
+                    break;
+
                 case MACH_JE:
                 case MACH_JNE:
-                    fputs(inst->op == MACH_JE
-                              ? "    اقفز_مساو "
-                              : "    اقفز_غير_مساو ", out);
+                    emit_buf_puts(out, inst->op == MACH_JE
+                                           ? "    اقفز_مساو "
+                                           : "    اقفز_غير_مساو ");
                     nazm_write_local_label(out, function_id, inst->dst.data.label_id);
-                    fputc('\n', out);
+                    emit_buf_putc(out, '\n');
                     emitted_lines = 1;
                     break;
 
@@ -283,11 +352,11 @@ static void nazm_write_function(FILE *out,
                 case MACH_SETA: case MACH_SETB:
                 case MACH_SETAE: case MACH_SETBE:
                 case MACH_SETP: case MACH_SETNP:
-                    fputs("    ", out);
-                    fputs(nazm_setcc_mnemonic(inst->op), out);
-                    fputc(' ', out);
+                    emit_buf_puts(out, "    ");
+                    emit_buf_puts(out, nazm_setcc_mnemonic(inst->op));
+                    emit_buf_putc(out, ' ');
                     nazm_write_any_operand(out, &inst->dst);
-                    fputc('\n', out);
+                    emit_buf_putc(out, '\n');
                     emitted_lines = 1;
                     break;
 
@@ -307,18 +376,18 @@ static void nazm_write_function(FILE *out,
                         int decimal_register_count = inst->sysv_al;
                         if (decimal_register_count < 0)
                             decimal_register_count = 0;
-                        fputs("    انقل سجل_المركم_٣٢، ", out);
+                        emit_buf_puts(out, "    انقل سجل_المركم_٣٢، ");
                         nazm_write_unsigned(
                             out, (uint64_t)decimal_register_count);
-                        fputc('\n', out);
+                        emit_buf_putc(out, '\n');
                         emitted_lines += 1;
                     }
-                    fputs("    ناد ", out);
+                    emit_buf_puts(out, "    ناد ");
                     if (inst->src1.kind == MACH_OP_FUNC)
                         nazm_write_symbol(out, inst->src1.data.name);
                     else
                         nazm_write_operand(out, &inst->src1);
-                    fputc('\n', out);
+                    emit_buf_putc(out, '\n');
                     emitted_lines += 1;
                     break;
 
@@ -330,16 +399,16 @@ static void nazm_write_function(FILE *out,
                     break;
 
                 case MACH_PUSH:
-                    fputs("    ادفع ", out);
+                    emit_buf_puts(out, "    ادفع ");
                     nazm_write_operand(out, &inst->src1);
-                    fputc('\n', out);
+                    emit_buf_putc(out, '\n');
                     emitted_lines = 1;
                     break;
 
                 case MACH_POP:
-                    fputs("    اسحب ", out);
+                    emit_buf_puts(out, "    اسحب ");
                     nazm_write_operand(out, &inst->dst);
-                    fputc('\n', out);
+                    emit_buf_putc(out, '\n');
                     emitted_lines = 1;
                     break;
 
@@ -372,10 +441,11 @@ static void nazm_write_function(FILE *out,
             nazm_write_debug_location_reset(out, map);
         if (strcmp(func->name, "الرئيسية") == 0)
         {
-            fputs("    انقل سجل_المركم، ٠\n", out);
+            emit_buf_puts(out, "    انقل سجل_المركم، ٠\n");
             map->generated_line += 1;
         }
         map->generated_line += nazm_write_epilogue(
             out, func, target, callee_regs, callee_count);
     }
+    map->generated_line += nazm_write_jump_tables(out, func, function_id);
 }
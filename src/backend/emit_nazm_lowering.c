@@ -7,7 +7,7 @@
  * preserving the reserved scratch-register contracts.
  */
 
-static void nazm_write_any_operand(FILE *out, const MachineOperand *operand)
+static void nazm_write_any_operand(EmitBuf *out, const MachineOperand *operand)
 {
     if (operand->kind == MACH_OP_MEM)
         nazm_write_memory_operand(out, operand);
@@ -17,7 +17,7 @@ static void nazm_write_any_operand(FILE *out, const MachineOperand *operand)
         nazm_write_operand(out, operand);
 }
 
-static unsigned nazm_write_move(FILE *out,
+static unsigned nazm_write_move(EmitBuf *out,
                                 const MachineOperand *dst,
                                 const MachineOperand *src)
 {
@@ -30,15 +30,15 @@ static unsigned nazm_write_move(FILE *out,
                             dst->data.mem.base_vreg == PHYS_R11
             ? PHYS_RAX
             : PHYS_R11;
-        fputs("    انقل ", out);
+        emit_buf_puts(out, "    انقل ");
         nazm_write_operand(out, &scratch);
-        fputs("، ", out);
+        emit_buf_puts(out, "، ");
         nazm_write_operand(out, src);
-        fputs("\n    انقل ", out);
+        emit_buf_puts(out, "\n    انقل ");
         nazm_write_any_operand(out, dst);
-        fputs("، ", out);
+        emit_buf_puts(out, "، ");
         nazm_write_operand(out, &scratch);
-        fputc('\n', out);
+        emit_buf_putc(out, '\n');
         return 2;
     }
 
@@ -48,23 +48,23 @@ static unsigned nazm_write_move(FILE *out,
         scratch.kind = MACH_OP_VREG;
         scratch.size_bits = nazm_operand_bits(dst);
         scratch.data.vreg = PHYS_RAX;
-        fputs("    انقل ", out);
+        emit_buf_puts(out, "    انقل ");
         nazm_write_operand(out, &scratch);
-        fputs("، ", out);
+        emit_buf_puts(out, "، ");
         nazm_write_any_operand(out, src);
-        fputs("\n    انقل ", out);
+        emit_buf_puts(out, "\n    انقل ");
         nazm_write_any_operand(out, dst);
-        fputs("، ", out);
+        emit_buf_puts(out, "، ");
         nazm_write_operand(out, &scratch);
-        fputc('\n', out);
+        emit_buf_putc(out, '\n');
         return 2;
     }
 
-    fputs("    انقل ", out);
+    emit_buf_puts(out, "    انقل ");
     nazm_write_any_operand(out, dst);
-    fputs("، ", out);
+    emit_buf_puts(out, "، ");
     nazm_write_any_operand(out, src);
-    fputc('\n', out);
+    emit_buf_putc(out, '\n');
     return 1;
 }
 
@@ -87,7 +87,7 @@ static bool nazm_operand_uses_register(const MachineOperand *operand,
     return false;
 }
 
-static unsigned nazm_write_lea(FILE *out,
+static unsigned nazm_write_lea(EmitBuf *out,
                                const MachineOperand *dst,
                                const MachineOperand *src)
 {
@@ -99,19 +99,19 @@ static unsigned nazm_write_lea(FILE *out,
 
     if (src->kind == MACH_OP_FUNC || src->kind == MACH_OP_GLOBAL)
     {
-        fputs("    احسب_عنوان ", out);
+        emit_buf_puts(out, "    احسب_عنوان ");
         nazm_write_operand(out, actual_dst);
-        fputs("، ", out);
+        emit_buf_puts(out, "، ");
         nazm_write_symbolic_memory_operand(out, src->data.name);
     }
     else
     {
-        fputs("    احسب_عنوان ", out);
+        emit_buf_puts(out, "    احسب_عنوان ");
         nazm_write_operand(out, actual_dst);
-        fputs("، ", out);
+        emit_buf_puts(out, "، ");
         nazm_write_memory_operand(out, src);
     }
-    fputc('\n', out);
+    emit_buf_putc(out, '\n');
     lines += 1;
 
     if (dst->kind == MACH_OP_MEM)
@@ -119,7 +119,7 @@ static unsigned nazm_write_lea(FILE *out,
     return lines;
 }
 
-static unsigned nazm_write_binary(FILE *out,
+static unsigned nazm_write_binary(EmitBuf *out,
                                   const char *mnemonic,
                                   const MachineOperand *dst,
                                   const MachineOperand *src)
@@ -151,39 +151,39 @@ static unsigned nazm_write_binary(FILE *out,
             actual_source = &preserved_source;
         }
         lines += nazm_write_move(out, &accumulator, dst);
-        fputs("    ", out);
-        fputs(mnemonic, out);
-        fputc(' ', out);
+        emit_buf_puts(out, "    ");
+        emit_buf_puts(out, mnemonic);
+        emit_buf_putc(out, ' ');
         nazm_write_operand(out, &accumulator);
-        fputs("، ", out);
+        emit_buf_puts(out, "، ");
         nazm_write_any_operand(out, actual_source);
-        fputc('\n', out);
+        emit_buf_putc(out, '\n');
         lines += 1;
         lines += nazm_write_move(out, dst, &accumulator);
         return lines;
     }
 
-    fputs("    ", out);
-    fputs(mnemonic, out);
-    fputc(' ', out);
+    emit_buf_puts(out, "    ");
+    emit_buf_puts(out, mnemonic);
+    emit_buf_putc(out, ' ');
     nazm_write_any_operand(out, dst);
-    fputs("، ", out);
+    emit_buf_puts(out, "، ");
     nazm_write_any_operand(out, initial_source);
-    fputc('\n', out);
+    emit_buf_putc(out, '\n');
     return prefix_lines + 1;
 }
 
-static unsigned nazm_write_unary(FILE *out,
+static unsigned nazm_write_unary(EmitBuf *out,
                                  const char *mnemonic,
                                  const MachineOperand *dst)
 {
     if (!nazm_operand_is_memory(dst))
     {
-        fputs("    ", out);
-        fputs(mnemonic, out);
-        fputc(' ', out);
+        emit_buf_puts(out, "    ");
+        emit_buf_puts(out, mnemonic);
+        emit_buf_putc(out, ' ');
         nazm_write_operand(out, dst);
-        fputc('\n', out);
+        emit_buf_putc(out, '\n');
         return 1;
     }
 
@@ -191,17 +191,17 @@ static unsigned nazm_write_unary(FILE *out,
         nazm_operand_uses_register(dst, PHYS_R11) ? PHYS_RAX : PHYS_R11,
         nazm_operand_bits(dst));
     unsigned lines = nazm_write_move(out, &scratch, dst);
-    fputs("    ", out);
-    fputs(mnemonic, out);
-    fputc(' ', out);
+    emit_buf_puts(out, "    ");
+    emit_buf_puts(out, mnemonic);
+    emit_buf_putc(out, ' ');
     nazm_write_operand(out, &scratch);
-    fputc('\n', out);
+    emit_buf_putc(out, '\n');
     lines += 1;
     lines += nazm_write_move(out, dst, &scratch);
     return lines;
 }
 
-static unsigned nazm_write_comparison(FILE *out,
+static unsigned nazm_write_comparison(EmitBuf *out,
                                       const char *mnemonic,
                                       const MachineOperand *left,
                                       const MachineOperand *right,
@@ -241,17 +241,17 @@ static unsigned nazm_write_comparison(FILE *out,
         actual_right = &right_scratch;
     }
 
-    fputs("    ", out);
-    fputs(mnemonic, out);
-    fputc(' ', out);
+    emit_buf_puts(out, "    ");
+    emit_buf_puts(out, mnemonic);
+    emit_buf_putc(out, ' ');
     nazm_write_operand(out, actual_left);
-    fputs("، ", out);
+    emit_buf_puts(out, "، ");
     nazm_write_any_operand(out, actual_right);
-    fputc('\n', out);
+    emit_buf_putc(out, '\n');
     return lines + 1;
 }
 
-static unsigned nazm_write_extension(FILE *out,
+static unsigned nazm_write_extension(EmitBuf *out,
                                      const char *mnemonic,
                                      const MachineOperand *dst,
                                      const MachineOperand *src,
@@ -295,13 +295,13 @@ static unsigned nazm_write_extension(FILE *out,
     if (dst->kind == MACH_OP_MEM)
         actual_dst = &destination_scratch;
 
-    fputs("    ", out);
-    fputs(mnemonic, out);
-    fputc(' ', out);
+    emit_buf_puts(out, "    ");
+    emit_buf_puts(out, mnemonic);
+    emit_buf_putc(out, ' ');
     nazm_write_operand(out, actual_dst);
-    fputs("، ", out);
+    emit_buf_puts(out, "، ");
     nazm_write_operand(out, actual_src);
-    fputc('\n', out);
+    emit_buf_putc(out, '\n');
     lines += 1;
 
     if (dst->kind == MACH_OP_MEM)
@@ -309,7 +309,7 @@ static unsigned nazm_write_extension(FILE *out,
     return lines;
 }
 
-static unsigned nazm_write_shift(FILE *out,
+static unsigned nazm_write_shift(EmitBuf *out,
                                  const char *mnemonic,
                                  const MachineOperand *dst,
                                  const MachineOperand *amount)
@@ -104,6 +104,7 @@ static const char *nazm_machine_op_arabic(MachineOp op)
         case MACH_JNE: return "قفز_غير_مساو";
         case MACH_CALL: return "نداء";
         case MACH_TAILJMP: return "قفز_ذيلي";
+        case MACH_JMP_TABLE: return "قفز_عبر_جدول";
         case MACH_RET: return "رجوع";
         case MACH_PUSH: return "دفع";
         case MACH_POP: return "سحب";
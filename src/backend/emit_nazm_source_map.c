@@ -7,7 +7,7 @@
 
 typedef struct
 {
-    FILE *out;
+    EmitBuf *out;
     bool first_entry;
     unsigned generated_line;
     bool debug_info;
@@ -20,7 +20,7 @@ typedef struct
     bool debug_error;
 } NazmSourceMapWriter;
 
-static int nazm_debug_file_id(FILE *out,
+static int nazm_debug_file_id(EmitBuf *out,
                               NazmSourceMapWriter *map,
                               const char *path,
                               unsigned *written_lines)
@@ -52,34 +52,34 @@ static int nazm_debug_file_id(FILE *out,
 
     int id = map->debug_file_count + 1;
     map->debug_files[map->debug_file_count++] = path;
-    fputs("    .ملف_بايتات ", out);
+    emit_buf_puts(out, "    .ملف_بايتات ");
     nazm_write_unsigned(out, (uint64_t)id);
-    fputs("، \"", out);
+    emit_buf_puts(out, "، \"");
     bool first_byte = true;
     for (const unsigned char *p = (const unsigned char *)path; *p; ++p)
     {
-        if (!first_byte) fputs("،", out);
+        if (!first_byte) emit_buf_puts(out, "،");
         first_byte = false;
         nazm_write_unsigned(out, (uint64_t)*p);
     }
-    fputs("\"\n", out);
+    emit_buf_puts(out, "\"\n");
     if (written_lines) *written_lines += 1;
     return id;
 }
 
 static unsigned nazm_write_debug_location_reset(
-    FILE *out,
+    EmitBuf *out,
     NazmSourceMapWriter *map)
 {
     if (!out || !map || !map->debug_info) return 0;
-    fputs("    .موضع ٠، ٠، ٠\n", out);
+    emit_buf_puts(out, "    .موضع ٠، ٠، ٠\n");
     map->last_debug_file = 0;
     map->last_debug_line = 0;
     map->last_debug_column = 0;
     return 1;
 }
 
-static unsigned nazm_write_source_span(FILE *out,
+static unsigned nazm_write_source_span(EmitBuf *out,
                                        NazmSourceMapWriter *map,
                                        const MachineInst *inst)
 {
@@ -95,13 +95,13 @@ static unsigned nazm_write_source_span(FILE *out,
              inst->src_line != map->last_debug_line ||
              column != map->last_debug_column))
         {
-            fputs("    .موضع ", out);
+            emit_buf_puts(out, "    .موضع ");
             nazm_write_unsigned(out, (uint64_t)file_id);
-            fputs("، ", out);
+            emit_buf_puts(out, "، ");
             nazm_write_unsigned(out, (uint64_t)inst->src_line);
-            fputs("، ", out);
+            emit_buf_puts(out, "، ");
             nazm_write_unsigned(out, (uint64_t)column);
-            fputc('\n', out);
+            emit_buf_putc(out, '\n');
             lines += 1;
             map->last_debug_file = file_id;
             map->last_debug_line = inst->src_line;
@@ -109,30 +109,30 @@ static unsigned nazm_write_source_span(FILE *out,
         }
     }
 
-    fputs("    ; موضع باء: السطر ", out);
+    emit_buf_puts(out, "    ; موضع باء: السطر ");
     nazm_write_unsigned(out, (uint64_t)inst->src_line);
     if (inst->src_col > 0)
     {
-        fputs("، العمود ", out);
+        emit_buf_puts(out, "، العمود ");
         nazm_write_unsigned(out, (uint64_t)inst->src_col);
     }
-    fputc('\n', out);
+    emit_buf_putc(out, '\n');
     return lines + 1;
 }
 
-static void nazm_write_utf8_hex(FILE *out, const char *value)
+static void nazm_write_utf8_hex(EmitBuf *out, const char *value)
 {
     static const char digits[] = "0123456789abcdef";
     if (!out || !value) return;
     for (const unsigned char *p = (const unsigned char *)value; *p; ++p)
     {
-        fputc(digits[*p >> 4], out);
-        fputc(digits[*p & 0x0fu], out);
+        emit_buf_putc(out, digits[*p >> 4]);
+        emit_buf_putc(out, digits[*p & 0x0fu]);
     }
 }
 
 static bool nazm_source_map_begin(NazmSourceMapWriter *map,
-                                  FILE *out,
+                                  EmitBuf *out,
                                   const char *generated_path)
 {
     if (!map) return false;
@@ -146,11 +146,11 @@ static bool nazm_source_map_begin(NazmSourceMapWriter *map,
     map->last_debug_line = 0;
     map->last_debug_column = 0;
     if (!out) return true;
-    fputs("{\n  \"schema\": \"baa-nazm-source-map-v1\",\n", out);
-    fputs("  \"generated_path_utf8_hex\": \"", out);
+    emit_buf_puts(out, "{\n  \"schema\": \"baa-nazm-source-map-v1\",\n");
+    emit_buf_puts(out, "  \"generated_path_utf8_hex\": \"");
     nazm_write_utf8_hex(out, generated_path ? generated_path : "");
-    fputs("\",\n  \"entries\": [\n", out);
-    return !ferror(out);
+    emit_buf_puts(out, "\",\n  \"entries\": [\n");
+    return !out->failed;
 }
 
 static void nazm_source_map_entry(NazmSourceMapWriter *map,
@@ -162,23 +162,24 @@ static void nazm_source_map_entry(NazmSourceMapWriter *map,
         inst->src_line <= 0 || generated_start == 0 ||
         generated_end < generated_start)
         return;
-    fputs(map->first_entry ? "" : ",\n", map->out);
+    emit_buf_puts(map->out, map->first_entry ? "" : ",\n");
     map->first_entry = false;
-    fprintf(map->out,
-            "    {\"generated_line_start\": %u, \"generated_line_end\": %u, "
-            "\"source_file_utf8_hex\": \"",
-            generated_start,
-            generated_end);
+    emit_buf_puts(map->out, "    {\"generated_line_start\": ");
+    emit_buf_u64(map->out, generated_start);
+    emit_buf_puts(map->out, ", \"generated_line_end\": ");
+    emit_buf_u64(map->out, generated_end);
+    emit_buf_puts(map->out, ", \"source_file_utf8_hex\": \"");
     nazm_write_utf8_hex(map->out, inst->src_file);
-    fprintf(map->out,
-            "\", \"source_line\": %d, \"source_column\": %d}",
-            inst->src_line,
-            inst->src_col > 0 ? inst->src_col : 1);
+    emit_buf_puts(map->out, "\", \"source_line\": ");
+    emit_buf_i64(map->out, inst->src_line);
+    emit_buf_puts(map->out, ", \"source_column\": ");
+    emit_buf_i64(map->out, inst->src_col > 0 ? inst->src_col : 1);
+    emit_buf_putc(map->out, '}');
 }
 
 static bool nazm_source_map_end(NazmSourceMapWriter *map)
 {
     if (!map || !map->out) return true;
-    fputs("\n  ]\n}\n", map->out);
-    return !ferror(map->out);
+    emit_buf_puts(map->out, "\n  ]\n}\n");
+    return emit_buf_flush(map->out);
 }
@@ -127,9 +127,9 @@ static bool nazm_operand_is_memory(const MachineOperand *operand)
         (operand->kind == MACH_OP_MEM || operand->kind == MACH_OP_GLOBAL);
 }
 
-static void nazm_write_symbolic_memory_operand(FILE *out, const char *name)
+static void nazm_write_symbolic_memory_operand(EmitBuf *out, const char *name)
 {
-    fputs("[مؤشر_التعليمة+", out);
+    emit_buf_puts(out, "[مؤشر_التعليمة+");
     nazm_write_symbol(out, name);
-    fputc(']', out);
+    emit_buf_putc(out, ']');
 }
@@ -1,207 +1,193 @@
 /**
  * @brief طباعة تعليق إلى ملف التجميع عند تفعيل --asm-comments.
  */
-static void emit_comment(FILE* out, const char* fmt, ...)
+static void emit_comment(EmitContext* ctx, EmitBuf* out, const char* fmt, ...)
 {
-    if (!g_emit_asm_comments || !out || !fmt) return;
+    if (!ctx->asm_comments || !out || !fmt) return;
 
-    fprintf(out, "    # ");
+    emit_buf_puts(out, "    # ");
     va_list args;
     va_start(args, fmt);
-    vfprintf(out, fmt, args);
+    emit_buf_vfmt(out, fmt, args);
     va_end(args);
-    fprintf(out, "\n");
+    emit_buf_puts(out, "\n");
 }
 
-static const BaaCallingConv* emit_cc_or_default(void)
+static const BaaCallingConv* emit_cc_or_default(EmitContext* ctx)
 {
-    if (g_emit_cc)
-        return g_emit_cc;
+    if (ctx->cc)
+        return ctx->cc;
     return baa_target_builtin_windows_x86_64()->cc;
 }
 
 // إعلان مسبق لأن بعض دوال حماية المكدس تستخدمه
-static int emit_shadow_bytes(void);
+static int emit_shadow_bytes(EmitContext* ctx);
 
-static bool emit_stack_protector_enabled_for_func(MachineFunc* func)
+static bool emit_stack_protector_enabled_for_func(EmitContext* ctx, MachineFunc* func)
 {
     if (!func) return false;
-    if (!g_emit_target || g_emit_target->obj_format != BAA_OBJFORMAT_ELF) return false;
+    if (!ctx->target || ctx->target->obj_format != BAA_OBJFORMAT_ELF) return false;
 
-    if (g_emit_opts.stack_protector == BAA_STACKPROT_ALL) return true;
-    if (g_emit_opts.stack_protector == BAA_STACKPROT_ON) return func->stack_size > 0;
+    if (ctx->opts.stack_protector == BAA_STACKPROT_ALL) return true;
+    if (ctx->opts.stack_protector == BAA_STACKPROT_ON) return func->stack_size > 0;
     return false;
 }
 
-static int emit_stack_protector_size(MachineFunc* func)
+static int emit_stack_protector_size(EmitContext* ctx, MachineFunc* func)
 {
-    return emit_stack_protector_enabled_for_func(func) ? 8 : 0;
+    return emit_stack_protector_enabled_for_func(ctx, func) ? 8 : 0;
 }
 
-static int emit_stack_protector_offset(MachineFunc* func)
+static int emit_stack_protector_offset(EmitContext* ctx, MachineFunc* func)
 {
     // نضع الكناري مباشرةً بعد مساحة locals/shadow وقبل حفظ callee-saved.
     int local_size = func ? func->stack_size : 0;
-    int shadow = emit_shadow_bytes();
+    int shadow = emit_shadow_bytes(ctx);
     return -(local_size + shadow + 8);
 }
 
-static void emit_stack_protector_prologue(MachineFunc* func, FILE* out)
+static void emit_stack_protector_prologue(EmitContext* ctx, MachineFunc* func, EmitBuf* out)
 {
-    if (!emit_stack_protector_enabled_for_func(func) || !out) return;
+    if (!emit_stack_protector_enabled_for_func(ctx, func) || !out) return;
 
     // نستخدم r11 كمؤقت حتى لا نخرب سجلات معاملات ABI عند دخول الدالة.
-    int off = emit_stack_protector_offset(func);
-    fprintf(out, "    movq %%fs:40, %%r11\n");
-    fprintf(out, "    movq %%r11, %d(%%rbp)\n", off);
+    int off = emit_stack_protector_offset(ctx, func);
+    emit_buf_puts(out, "    movq %fs:40, %r11\n");
+    emit_buf_fmt(out, "    movq %%r11, %d(%%rbp)\n", off);
 }
 
-static void emit_stack_protector_epilogue(MachineFunc* func, FILE* out, int ok_label_id)
+static void emit_stack_protector_epilogue(EmitContext* ctx, MachineFunc* func, EmitBuf* out, int ok_label_id)
 {
-    if (!emit_stack_protector_enabled_for_func(func) || !out) return;
+    if (!emit_stack_protector_enabled_for_func(ctx, func) || !out) return;
 
-    int off = emit_stack_protector_offset(func);
+    int off = emit_stack_protector_offset(ctx, func);
 
     // نستخدم r10/r11 لتفادي تخريب RAX (قيمة الإرجاع) وسجلات المعاملات.
-    fprintf(out, "    movq %d(%%rbp), %%r11\n", off);
-    fprintf(out, "    movq %%fs:40, %%r10\n");
-    fprintf(out, "    xorq %%r10, %%r11\n");
-    fprintf(out, "    je .L__sp_ok_%d_%d\n", g_emit_current_func_uid, ok_label_id);
-    fprintf(out, "    call __stack_chk_fail\n");
-    fprintf(out, "    .byte 0x0f, 0x0b\n");
-    fprintf(out, ".L__sp_ok_%d_%d:\n", g_emit_current_func_uid, ok_label_id);
+    emit_buf_fmt(out, "    movq %d(%%rbp), %%r11\n", off);
+    emit_buf_puts(out, "    movq %fs:40, %r10\n");
+    emit_buf_puts(out, "    xorq %r10, %r11\n");
+    emit_buf_fmt(out, "    je .L__sp_ok_%d_%d\n", ctx->current_func_uid, ok_label_id);
+    emit_buf_puts(out, "    call __stack_chk_fail\n");
+    emit_buf_puts(out, "    .byte 0x0f, 0x0b\n");
+    emit_buf_fmt(out, ".L__sp_ok_%d_%d:\n", ctx->current_func_uid, ok_label_id);
 }
 
-static int emit_shadow_bytes(void)
+static int emit_shadow_bytes(EmitContext* ctx)
 {
-    const BaaCallingConv* cc = emit_cc_or_default();
+    const BaaCallingConv* cc = emit_cc_or_default(ctx);
     return cc ? cc->shadow_space_bytes : 32;
 }
 
-static int emit_stack_align_bytes(void)
+static int emit_stack_align_bytes(EmitContext* ctx)
 {
-    const BaaCallingConv* cc = emit_cc_or_default();
+    const BaaCallingConv* cc = emit_cc_or_default(ctx);
     return (cc && cc->stack_align_bytes > 0) ? cc->stack_align_bytes : 16;
 }
 
-static void emit_rodata_section(FILE* out)
+static void emit_rodata_section(EmitContext* ctx, EmitBuf* out)
 {
     if (!out) return;
-    if (g_emit_target && g_emit_target->obj_format == BAA_OBJFORMAT_ELF)
+    if (ctx->target && ctx->target->obj_format == BAA_OBJFORMAT_ELF)
     {
-        fprintf(out, ".section .rodata\n");
+        emit_buf_puts(out, ".section .rodata\n");
     }
     else
     {
-        fprintf(out, ".section .rdata,\"dr\"\n");
+        emit_buf_puts(out, ".section .rdata,\"dr\"\n");
     }
 }
 
-typedef struct {
-    const char** files;
-    int file_count;
-    int file_cap;
-
-    int last_file_id;
-    int last_line;
-    int last_col;
-
-    const char* last_dbg_name;
-} EmitDebugState;
-
-static EmitDebugState g_emit_dbg = {0};
-
-static void emit_debug_reset(void) {
-    if (g_emit_dbg.files) {
-        free(g_emit_dbg.files);
-        g_emit_dbg.files = NULL;
+static void emit_debug_reset(EmitContext* ctx) {
+    if (ctx->dbg.files) {
+        free(ctx->dbg.files);
+        ctx->dbg.files = NULL;
     }
-    g_emit_dbg.file_count = 0;
-    g_emit_dbg.file_cap = 0;
-    g_emit_dbg.last_file_id = -1;
-    g_emit_dbg.last_line = -1;
-    g_emit_dbg.last_col = -1;
-    g_emit_dbg.last_dbg_name = NULL;
+    ctx->dbg.file_count = 0;
+    ctx->dbg.file_cap = 0;
+    ctx->dbg.last_file_id = -1;
+    ctx->dbg.last_line = -1;
+    ctx->dbg.last_col = -1;
+    ctx->dbg.last_dbg_name = NULL;
 }
 
-static void emit_debug_escape_path(FILE* out, const char* s) {
+static void emit_debug_escape_path(EmitBuf* out, const char* s) {
     if (!out || !s) return;
 
     for (const char* p = s; *p; p++) {
         unsigned char c = (unsigned char)*p;
         if (c == '\\' || c == '"') {
-            fputc('\\', out);
-            fputc((int)c, out);
+            emit_buf_putc(out, '\\');
+            emit_buf_putc(out, (char)c);
         } else if (c == '\n') {
-            fputs("\\n", out);
+            emit_buf_puts(out, "\\n");
         } else if (c == '\r') {
-            fputs("\\r", out);
+            emit_buf_puts(out, "\\r");
         } else if (c == '\t') {
-            fputs("\\t", out);
+            emit_buf_puts(out, "\\t");
         } else {
-            fputc((int)c, out);
+            emit_buf_putc(out, (char)c);
         }
     }
 }
 
-static int emit_debug_get_file_id(FILE* out, const char* filename) {
+static int emit_debug_get_file_id(EmitContext* ctx, EmitBuf* out, const char* filename) {
     if (!out || !filename) return -1;
 
-    for (int i = 0; i < g_emit_dbg.file_count; i++) {
-        const char* cur = g_emit_dbg.files[i];
+    for (int i = 0; i < ctx->dbg.file_count; i++) {
+        const char* cur = ctx->dbg.files[i];
         if (cur && strcmp(cur, filename) == 0) {
             return i + 1; // .file ids are 1-based
         }
     }
 
-    if (g_emit_dbg.file_count >= g_emit_dbg.file_cap) {
-        int new_cap = (g_emit_dbg.file_cap == 0) ? 8 : g_emit_dbg.file_cap * 2;
-        const char** new_arr = (const char**)realloc(g_emit_dbg.files, (size_t)new_cap * sizeof(const char*));
+    if (ctx->dbg.file_count >= ctx->dbg.file_cap) {
+        int new_cap = (ctx->dbg.file_cap == 0) ? 8 : ctx->dbg.file_cap * 2;
+        const char** new_arr = (const char**)realloc(ctx->dbg.files, (size_t)new_cap * sizeof(const char*));
         if (!new_arr) return -1;
-        g_emit_dbg.files = new_arr;
-        g_emit_dbg.file_cap = new_cap;
+        ctx->dbg.files = new_arr;
+        ctx->dbg.file_cap = new_cap;
     }
 
-    int id = g_emit_dbg.file_count + 1;
-    g_emit_dbg.files[g_emit_dbg.file_count++] = filename;
+    int id = ctx->dbg.file_count + 1;
+    ctx->dbg.files[ctx->dbg.file_count++] = filename;
 
     // إصدار .file مرة واحدة لكل ملف
-    fprintf(out, "    .file %d \"", id);
+    emit_buf_fmt(out, "    .file %d \"", id);
     emit_debug_escape_path(out, filename);
-    fprintf(out, "\"\n");
+    emit_buf_puts(out, "\"\n");
 
     return id;
 }
 
-static void emit_debug_loc(FILE* out, const MachineInst* inst) {
-    if (!g_emit_debug_info) return;
+static void emit_debug_loc(EmitContext* ctx, EmitBuf* out, const MachineInst* inst) {
+    if (!ctx->debug_info) return;
     if (!out || !inst) return;
     if (!inst->src_file || inst->src_line <= 0) return;
 
-    int file_id = emit_debug_get_file_id(out, inst->src_file);
+    int file_id = emit_debug_get_file_id(ctx, out, inst->src_file);
     if (file_id <= 0) return;
 
     int line = inst->src_line;
     int col = inst->src_col;
     if (col <= 0) col = 1;
 
-    if (file_id != g_emit_dbg.last_file_id ||
-        line != g_emit_dbg.last_line ||
-        col != g_emit_dbg.last_col) {
-        fprintf(out, "    .loc %d %d %d\n", file_id, line, col);
-        g_emit_dbg.last_file_id = file_id;
-        g_emit_dbg.last_line = line;
-        g_emit_dbg.last_col = col;
+    if (file_id != ctx->dbg.last_file_id ||
+        line != ctx->dbg.last_line ||
+        col != ctx->dbg.last_col) {
+        emit_buf_fmt(out, "    .loc %d %d %d\n", file_id, line, col);
+        ctx->dbg.last_file_id = file_id;
+        ctx->dbg.last_line = line;
+        ctx->dbg.last_col = col;
     }
 
     if (inst->dbg_name) {
         int changed = 1;
-        if (g_emit_dbg.last_dbg_name && strcmp(g_emit_dbg.last_dbg_name, inst->dbg_name) == 0) {
+        if (ctx->dbg.last_dbg_name && strcmp(ctx->dbg.last_dbg_name, inst->dbg_name) == 0) {
             changed = 0;
         }
         if (changed) {
-            fprintf(out, "    # متغير: %s\n", inst->dbg_name);
-            g_emit_dbg.last_dbg_name = inst->dbg_name;
+            emit_buf_fmt(out, "    # متغير: %s\n", inst->dbg_name);
+            ctx->dbg.last_dbg_name = inst->dbg_name;
         }
     }
 }
@@ -258,7 +244,7 @@ static char size_suffix(int bits) {
  * @param op المعامل.
  * @param out ملف الخرج.
  */
-static void emit_operand(MachineOperand* op, FILE* out) {
+static void emit_operand(EmitContext* ctx, MachineOperand* op, EmitBuf* out) {
     if (!op || !out) return;
 
     switch (op->kind) {
@@ -272,16 +258,18 @@ static void emit_operand(MachineOperand* op, FILE* out) {
                 if (reg >= 0 && reg < PHYS_REG_COUNT) {
                     int bits = op->size_bits;
                     if (bits <= 0) bits = 64;
-                    fprintf(out, "%s", reg_name_for_bits(reg, bits));
+                    emit_buf_puts(out, reg_name_for_bits(reg, bits));
                 } else {
                     // سجل غير محلول (لا ينبغي أن يحدث بعد regalloc)
-                    fprintf(out, "%%v%d", reg);
+                    emit_buf_puts(out, "%v");
+                    emit_buf_i64(out, reg);
                 }
             }
             break;
 
         case MACH_OP_IMM:
-            fprintf(out, "$%lld", (long long)op->data.imm);
+            emit_buf_putc(out, '$');
+            emit_buf_i64(out, op->data.imm);
             break;
 
         case MACH_OP_MEM:
@@ -295,27 +283,26 @@ static void emit_operand(MachineOperand* op, FILE* out) {
                     base_name = reg64_names[base];
                 }
 
-                if (offset != 0) {
-                    fprintf(out, "%d(%s)", offset, base_name);
-                } else {
-                    fprintf(out, "(%s)", base_name);
-                }
+                if (offset != 0) emit_buf_i64(out, offset);
+                emit_buf_putc(out, '(');
+                emit_buf_puts(out, base_name);
+                emit_buf_putc(out, ')');
             }
             break;
 
         case MACH_OP_LABEL:
-            fprintf(out, ".LBB_%d_%d", g_emit_current_func_uid, op->data.label_id);
+            emit_buf_puts(out, ".LBB_");
+            emit_buf_i64(out, ctx->current_func_uid);
+            emit_buf_putc(out, '_');
+            emit_buf_i64(out, op->data.label_id);
             break;
 
         case MACH_OP_GLOBAL:
             // متغير عام: name(%rip) لعنونة RIP-relative
             if (op->data.name) {
-                // التحقق من أنه تسمية نص (.Lstr_N) أو اسم متغير
-                if (strncmp(op->data.name, ".Lstr_", 6) == 0) {
-                    fprintf(out, "%s(%%rip)", op->data.name);
-                } else {
-                    fprintf(out, "%s(%%rip)", op->data.name);
-                }
+                // تسميات النصوص (.Lstr_N) والمتغيرات تُعنون بالطريقة نفسها
+                emit_buf_puts(out, op->data.name);
+                emit_buf_puts(out, "(%rip)");
             }
             break;
 
@@ -325,21 +312,22 @@ static void emit_operand(MachineOperand* op, FILE* out) {
                 // تحويل اطبع → printf
                 if (strcmp(op->data.name, "اطبع") == 0 ||
                          strcmp(op->data.name, "اطبع_صحيح") == 0) {
-                    fprintf(out, "printf");
+                    emit_buf_puts(out, "printf");
                 }
                 // تحويل اقرأ → scanf
                 else if (strcmp(op->data.name, "اقرأ") == 0 ||
                          strcmp(op->data.name, "اقرأ_صحيح") == 0) {
-                    fprintf(out, "scanf");
+                    emit_buf_puts(out, "scanf");
                 }
                 else {
-                    fprintf(out, "%s", op->data.name);
+                    emit_buf_puts(out, op->data.name);
                 }
             }
             break;
 
         case MACH_OP_XMM:
-            fprintf(out, "%%xmm%d", op->data.xmm);
+            emit_buf_puts(out, "%xmm");
+            emit_buf_i64(out, op->data.xmm);
             break;
     }
 }
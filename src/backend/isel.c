@@ -8,7 +8,7 @@
  * - اختيار أنماط التعليمات المثلى لكل عملية IR
  * - التعامل مع اتفاقية الاستدعاء عبر هدف (Windows x64 / SystemV AMD64)
  * - القسمة باستخدام CQO + IDIV
- * - المقارنات باستخدام CMP + SETcc + MOVZX
+ * - المقارنات باستخدام CMP + SETcc + MOVZX، أو CMP + Jcc حين تغذي قفزاً شرطياً فقط
  */
 
 #include "backend_internal.h"
@@ -161,8 +161,8 @@ MachineBlock *mach_block_new(const char *label, int id)
     block->last = NULL;
     block->inst_count = 0;
     block->succ_count = 0;
-    block->succs[0] = NULL;
-    block->succs[1] = NULL;
+    block->succs = NULL;
+    block->loop_depth = 0;
     block->next = NULL;
     return block;
 }
@@ -197,6 +197,7 @@ void mach_block_free(MachineBlock *block)
         mach_inst_free(inst);
         inst = next;
     }
+    free(block->succs);
     free(block->label);
     free(block);
 }
@@ -249,6 +250,20 @@ void mach_func_add_block(MachineFunc *func, MachineBlock *block)
     func->block_count++;
 }
 
+int mach_func_add_jump_table(MachineFunc *func, int *label_ids, int count)
+{
+    if (!func || !label_ids || count <= 0)
+        return -1;
+    MachineJumpTable *grown = realloc(func->jump_tables,
+                                      (size_t)(func->jump_table_count + 1) * sizeof(MachineJumpTable));
+    if (!grown)
+        return -1;
+    func->jump_tables = grown;
+    func->jump_tables[func->jump_table_count].label_ids = label_ids;
+    func->jump_tables[func->jump_table_count].count = count;
+    return func->jump_table_count++;
+}
+
 void mach_func_free(MachineFunc *func)
 {
     if (!func)
@@ -260,6 +275,9 @@ void mach_func_free(MachineFunc *func)
         mach_block_free(block);
         block = next;
     }
+    for (int i = 0; i < func->jump_table_count; i++)
+        free(func->jump_tables[i].label_ids);
+    free(func->jump_tables);
     free(func->name);
     free(func);
 }
@@ -343,9 +361,18 @@ typedef struct
     // معلومات الحلقات (للتحسينات داخل الحلقات مثل تقليل القوة)
     IRLoopInfo *loop_info;
 
+    // سلاسل التعريف/الاستعمال للدالة الحالية (لكشف المقارنات وحيدة الاستعمال)
+    IRDefUse *defuse;
+
+    // مقارنة أُصدرت أعلامها دون setcc لأن قفز_شرط لاحقاً في الكتلة يستهلكها وحده
+    IRInst *fused_cmp;
+
     // تفعيل تحسين النداء_الذيلي (Tail Call Optimization)
     bool enable_tco;
 
+    // دمج المقارنة مع قفز_شرط (GAS فقط؛ عقد نظم لا يعرف jcc غير je/jne)
+    bool fuse_cmp_branch;
+
     // الهدف الحالي (Windows x64 / SysV ...)
     const BaaTarget *target;
 
@@ -406,6 +433,25 @@ static int isel_block_in_any_loop(ISelCtx *ctx)
     return 0;
 }
 
+/**
+ * @brief عدد الحلقات التي تحتوي الكتلة الحالية (وزن التسريب في المخصص).
+ */
+static int isel_block_loop_depth(ISelCtx *ctx)
+{
+    if (!ctx || !ctx->loop_info || !ctx->ir_block)
+        return 0;
+
+    int depth = 0;
+    int n = ir_loop_info_count(ctx->loop_info);
+    for (int i = 0; i < n; i++)
+    {
+        IRLoop *L = ir_loop_info_get(ctx->loop_info, i);
+        if (L && ir_loop_contains(L, ctx->ir_block))
+            depth++;
+    }
+    return depth;
+}
+
 static int isel_is_pow2_i64(int64_t v, int *out_shift)
 {
     if (out_shift)
@@ -18,6 +18,7 @@
 #include <stdint.h>
 #include "../support/target_contract.h"
 #include "../middleend/ir.h"
+#include "../support/thread_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -103,8 +104,19 @@ typedef enum {
     MACH_JMP,       // jmp label (قفز غير مشروط)
     MACH_JE,        // je label  (قفز إذا يساوي)
     MACH_JNE,       // jne label (قفز إذا لا يساوي)
+    MACH_JG,        // jg label  (قفز إذا أكبر - signed)
+    MACH_JL,        // jl label  (قفز إذا أصغر - signed)
+    MACH_JGE,       // jge label (قفز إذا أكبر أو يساوي - signed)
+    MACH_JLE,       // jle label (قفز إذا أصغر أو يساوي - signed)
+    MACH_JA,        // ja label  (قفز إذا أكبر - unsigned)
+    MACH_JB,        // jb label  (قفز إذا أصغر - unsigned)
+    MACH_JAE,       // jae label (قفز إذا أكبر أو يساوي - unsigned)
+    MACH_JBE,       // jbe label (قفز إذا أصغر أو يساوي - unsigned)
+    MACH_JP,        // jp label  (قفز إذا unordered/parity)
+    MACH_JNP,       // jnp label (قفز إذا ordered/not parity)
     MACH_CALL,      // call target (استدعاء دالة)
     MACH_TAILJMP,   // tail jmp target (قفز_ذيلي لاستدعاء بدون رجوع)
+    MACH_JMP_TABLE, // قفز عبر جدول: src1 = فهرس (٦٤ بت، مفحوص الحدود)، src2 = رقم الجدول
     MACH_RET,       // ret (رجوع من دالة)
 
     // --------------------------------------------------------------------
@@ -219,14 +231,32 @@ typedef struct MachineBlock {
     MachineInst* last;
     int inst_count;
 
-    // الخلفاء والأسلاف
-    struct MachineBlock* succs[2];
+    // الخلفاء (مصفوفة مملوكة للكتلة؛ `تفرع` قد ينتج أكثر من خلفين)
+    struct MachineBlock** succs;
     int succ_count;
 
+    // عمق تداخل الحلقات (من ir_loop_analyze_func؛ 0 خارج كل حلقة)
+    int loop_depth;
+
     // القائمة المترابطة للكتل في الدالة
     struct MachineBlock* next;
 } MachineBlock;
 
+// ============================================================================
+// جداول القفز (Jump Tables)
+// ============================================================================
+
+/**
+ * @struct MachineJumpTable
+ * @brief جدول قفز لتعليمة MACH_JMP_TABLE: المدخل i هو هدف الفهرس i.
+ *
+ * كل مُصدر يختار صيغة المدخلات (إزاحات نسبية ٣٢ بت في GAS، عناوين ٦٤ بت في نظم).
+ */
+typedef struct MachineJumpTable {
+    int* label_ids;             // معرف الكتلة الهدف لكل مدخل
+    int count;
+} MachineJumpTable;
+
 // ============================================================================
 // دوال الآلة (Machine Functions)
 // ============================================================================
@@ -253,6 +283,10 @@ typedef struct MachineFunc {
     int stack_size;             // حجم المكدس المحلي (بالبايت)
     int param_count;            // عدد المعاملات
 
+    // جداول القفز (يشير إليها src2 في MACH_JMP_TABLE)
+    MachineJumpTable* jump_tables;
+    int jump_table_count;
+
     // القائمة المترابطة للدوال في الوحدة
     struct MachineFunc* next;
 } MachineFunc;
@@ -417,6 +451,12 @@ int mach_func_alloc_vreg(MachineFunc* func);
  */
 void mach_func_add_block(MachineFunc* func, MachineBlock* block);
 
+/**
+ * @brief إضافة جدول قفز إلى الدالة؛ تنتقل ملكية label_ids إلى الدالة.
+ * @return رقم الجدول، أو -1 عند فشل الحجز (ولا تُنقل الملكية).
+ */
+int mach_func_add_jump_table(MachineFunc* func, int* label_ids, int count);
+
 /**
  * @brief تحرير دالة آلية وجميع كتلها.
  * @param func الدالة المراد تحريرها.
@@ -469,9 +509,21 @@ MachineModule* isel_run(IRModule* ir_module);
  * @brief نسخة موسعة من isel_run مع خيارات إضافية.
  * @param ir_module وحدة IR المصدر (بعد التحسين).
  * @param enable_tco تفعيل تحسين النداء_الذيلي (Tail Call Optimization).
+ * @param fuse_cmp_branch دمج المقارنة وحيدة الاستعمال مع قفز_شرط في cmp + jcc
+ *        (لمساري GAS وELF فقط؛ نظم يستقبل setcc/test/jne).
  * @return وحدة آلية جديدة، أو NULL عند الفشل.
  */
-MachineModule* isel_run_ex(IRModule* ir_module, bool enable_tco, const BaaTarget* target);
+MachineModule* isel_run_ex(IRModule* ir_module, bool enable_tco, bool fuse_cmp_branch,
+                           const BaaTarget* target);
+
+/**
+ * @brief مثل isel_run_ex مع توزيع الدوال على مجمّع خيوط (--threads).
+ *
+ * كل عامل يخفض دوالاً كاملة بسياق ISelCtx خاص به، وتُضاف الدوال الآلية إلى
+ * الوحدة بترتيب IR نفسه. pool = NULL يعني تشغيلاً تسلسلياً.
+ */
+MachineModule* isel_run_ex2(IRModule* ir_module, bool enable_tco, bool fuse_cmp_branch,
+                            const BaaTarget* target, BaaThreadPool* pool);
 
 // ============================================================================
 // طباعة تمثيل الآلة (للتنقيح)
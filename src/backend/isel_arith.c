@@ -268,11 +268,13 @@ static void isel_lower_fneg(ISelCtx *ctx, IRInst *inst)
         mi->ir_reg = inst->dest;
 }
 
-static void isel_lower_fcmp(ISelCtx *ctx, IRInst *inst)
+/**
+ * @brief إصدار ucomisd لمقارنة عشرية دون استهلاك الأعلام.
+ *
+ * الحالة unordered (NaN) تضبط ZF وPF وCF معاً.
+ */
+static void isel_emit_fcmp_flags(ISelCtx *ctx, IRInst *inst)
 {
-    if (!inst || inst->operand_count < 2)
-        return;
-
     MachineOperand lhs0 = isel_lower_value(ctx, inst->operands[0]);
     MachineOperand rhs0 = isel_lower_value(ctx, inst->operands[1]);
     lhs0 = isel_materialize_imm_to_gpr64(ctx, lhs0);
@@ -285,6 +287,14 @@ static void isel_lower_fcmp(ISelCtx *ctx, IRInst *inst)
 
     // ucomisd xmm1, xmm0
     isel_emit(ctx, MACH_UCOMISD, mach_op_none(), xmm0, xmm1);
+}
+
+static void isel_lower_fcmp(ISelCtx *ctx, IRInst *inst)
+{
+    if (!inst || inst->operand_count < 2)
+        return;
+
+    isel_emit_fcmp_flags(ctx, inst);
 
     MachineOperand dst8 = mach_op_vreg(inst->dest, 8);
 
@@ -13,6 +13,96 @@ static void isel_lower_br(ISelCtx *ctx, IRInst *inst)
     isel_emit(ctx, MACH_JMP, target, mach_op_none(), mach_op_none());
 }
 
+/**
+ * @brief هل تغذي المقارنة قفزاً شرطياً لاحقاً في الكتلة نفسها فقط؟
+ *
+ * الشروط: نتيجة المقارنة لها استعمال واحد هو شرط قفز_شرط في نهاية الكتلة،
+ * ولا يفصل بينهما إلا نسخ لا تعيد تعريف النتيجة. النسخ تُخفض إلى mov الذي
+ * لا يغيّر الأعلام، فتبقى أعلام cmp صالحة حتى القفز.
+ */
+static bool isel_cmp_feeds_branch_only(ISelCtx *ctx, IRInst *cmp)
+{
+    if (!ctx || !ctx->defuse || !cmp || cmp->operand_count < 2 || cmp->dest < 0 ||
+        cmp->dest >= ctx->defuse->max_reg)
+        return false;
+
+    IRInst *br = cmp->next;
+    while (br && (br->op == IR_OP_COPY || br->op == IR_OP_NOP))
+    {
+        if (br->dest == cmp->dest)
+            return false;
+        br = br->next;
+    }
+    if (!br || br->op != IR_OP_BR_COND || br->operand_count < 3)
+        return false;
+
+    IRUse *use = ctx->defuse->uses_by_reg[cmp->dest];
+    return use && !use->next && use->slot == &br->operands[0];
+}
+
+/**
+ * @brief إصدار jcc لمقارنة عشرية مع معالجة الحالة unordered.
+ *
+ * NaN يضبط PF (ومعه ZF وCF)، فالمقارنات المرتبة تقفز إلى if_false عند PF،
+ * و«لا يساوي» تقفز إلى if_true عنده.
+ */
+static void isel_emit_fcmp_branch(ISelCtx *ctx, IRCmpPred pred,
+                                  MachineOperand if_true, MachineOperand if_false)
+{
+    switch (pred)
+    {
+    case IR_CMP_EQ:
+        isel_emit(ctx, MACH_JNE, if_false, mach_op_none(), mach_op_none());
+        isel_emit(ctx, MACH_JNP, if_true, mach_op_none(), mach_op_none());
+        break;
+    case IR_CMP_NE:
+        isel_emit(ctx, MACH_JP, if_true, mach_op_none(), mach_op_none());
+        isel_emit(ctx, MACH_JNE, if_true, mach_op_none(), mach_op_none());
+        break;
+    case IR_CMP_LT:
+        isel_emit(ctx, MACH_JP, if_false, mach_op_none(), mach_op_none());
+        isel_emit(ctx, MACH_JB, if_true, mach_op_none(), mach_op_none());
+        break;
+    case IR_CMP_LE:
+        isel_emit(ctx, MACH_JP, if_false, mach_op_none(), mach_op_none());
+        isel_emit(ctx, MACH_JBE, if_true, mach_op_none(), mach_op_none());
+        break;
+    case IR_CMP_GT:
+        isel_emit(ctx, MACH_JA, if_true, mach_op_none(), mach_op_none());
+        break;
+    case IR_CMP_GE:
+        isel_emit(ctx, MACH_JAE, if_true, mach_op_none(), mach_op_none());
+        break;
+    default:
+        isel_emit(ctx, MACH_JE, if_true, mach_op_none(), mach_op_none());
+        break;
+    }
+    isel_emit(ctx, MACH_JMP, if_false, mach_op_none(), mach_op_none());
+}
+
+/**
+ * @brief خفض قفز_شرط يستهلك أعلام مقارنة مدموجة.
+ *
+ * النمط: %c = قارن pred lhs, rhs ... قفز_شرط %c, if_true, if_false
+ * →  cmp lhs, rhs   (أُصدرت عند خفض المقارنة)
+ *    jCC if_true
+ *    jmp if_false
+ */
+static void isel_lower_fused_br_cond(ISelCtx *ctx, IRInst *cmp, IRInst *inst)
+{
+    MachineOperand if_true = isel_lower_value(ctx, inst->operands[1]);
+    MachineOperand if_false = isel_lower_value(ctx, inst->operands[2]);
+
+    if (isel_cmp_is_f64(cmp))
+    {
+        isel_emit_fcmp_branch(ctx, cmp->cmp_pred, if_true, if_false);
+        return;
+    }
+
+    isel_emit(ctx, isel_int_cc_op(cmp->cmp_pred, true), if_true, mach_op_none(), mach_op_none());
+    isel_emit(ctx, MACH_JMP, if_false, mach_op_none(), mach_op_none());
+}
+
 /**
  * @brief خفض عملية القفز المشروط.
  *
@@ -26,6 +116,15 @@ static void isel_lower_br_cond(ISelCtx *ctx, IRInst *inst)
     if (!inst || inst->operand_count < 3)
         return;
 
+    IRInst *fused = ctx->fused_cmp;
+    ctx->fused_cmp = NULL;
+    if (fused && inst->operands[0] && inst->operands[0]->kind == IR_VAL_REG &&
+        inst->operands[0]->data.reg_num == fused->dest)
+    {
+        isel_lower_fused_br_cond(ctx, fused, inst);
+        return;
+    }
+
     MachineOperand cond = isel_lower_value(ctx, inst->operands[0]);
     MachineOperand if_true = isel_lower_value(ctx, inst->operands[1]);
     MachineOperand if_false = isel_lower_value(ctx, inst->operands[2]);
@@ -47,6 +146,102 @@ static void isel_lower_br_cond(ISelCtx *ctx, IRInst *inst)
     isel_emit(ctx, MACH_JMP, if_false, mach_op_none(), mach_op_none());
 }
 
+/**
+ * @brief خفض `تفرع` كثيف إلى فحص حدود وقفز عبر جدول.
+ *
+ * النمط: تفرع v, default, [c0, B0] ...
+ * →  mov/movsx/movzx idx, v
+ *    sub  idx, min
+ *    cmp  idx, entries-1
+ *    ja   default          (نظم: seta/movzx/test ثم jne default)
+ *    jmp_table idx, table
+ *
+ * المتفرق فُك مسبقاً في ir_switch_lower_func()؛ إن وصل هنا (أو فشل حجز
+ * الجدول) نصدر سلسلة cmp/je.
+ */
+static void isel_lower_switch(ISelCtx *ctx, IRInst *inst)
+{
+    if (!inst || inst->operand_count < 2)
+        return;
+
+    IRValue *value = inst->operands[0];
+    MachineOperand def = isel_lower_value(ctx, inst->operands[1]);
+
+    // قيمة ثابتة (بدون تحسين): الهدف معروف الآن.
+    if (value && value->kind == IR_VAL_CONST_INT)
+    {
+        MachineOperand target = def;
+        for (int i = 0; i < inst->switch_case_count; i++)
+        {
+            if (inst->switch_cases[i].value == value->data.const_int)
+            {
+                target = mach_op_label(inst->switch_cases[i].target->id);
+                break;
+            }
+        }
+        isel_emit(ctx, MACH_JMP, target, mach_op_none(), mach_op_none());
+        return;
+    }
+
+    MachineOperand v = isel_extend_to_gpr64(ctx, isel_lower_value(ctx, value),
+                                            value ? value->type : NULL);
+
+    int64_t min = 0;
+    int64_t entries = 0;
+    int table = -1;
+    if (ir_switch_use_table(inst, &min, &entries))
+    {
+        int *label_ids = (int *)malloc((size_t)entries * sizeof(int));
+        if (label_ids)
+        {
+            for (int64_t i = 0; i < entries; i++)
+                label_ids[i] = def.data.label_id;
+            for (int i = inst->switch_case_count - 1; i >= 0; i--)
+                label_ids[inst->switch_cases[i].value - min] = inst->switch_cases[i].target->id;
+            table = mach_func_add_jump_table(ctx->mfunc, label_ids, (int)entries);
+            if (table < 0)
+                free(label_ids);
+        }
+    }
+
+    if (table < 0)
+    {
+        for (int i = 0; i < inst->switch_case_count; i++)
+        {
+            MachineOperand c = mach_op_imm(inst->switch_cases[i].value, 64);
+            if (c.data.imm < (int64_t)INT32_MIN || c.data.imm > (int64_t)INT32_MAX)
+                c = isel_materialize_imm_to_gpr64(ctx, c);
+            isel_emit(ctx, MACH_CMP, mach_op_none(), v, c);
+            isel_emit(ctx, MACH_JE, mach_op_label(inst->switch_cases[i].target->id),
+                      mach_op_none(), mach_op_none());
+        }
+        isel_emit(ctx, MACH_JMP, def, mach_op_none(), mach_op_none());
+        return;
+    }
+
+    MachineOperand idx = mach_op_vreg(mach_func_alloc_vreg(ctx->mfunc), 64);
+    isel_emit(ctx, MACH_MOV, idx, v, mach_op_none());
+    if (min != 0)
+        isel_emit(ctx, MACH_SUB, idx, idx, mach_op_imm(min, 64));
+    isel_emit(ctx, MACH_CMP, mach_op_none(), idx, mach_op_imm(entries - 1, 64));
+    if (ctx->fuse_cmp_branch)
+    {
+        isel_emit(ctx, MACH_JA, def, mach_op_none(), mach_op_none());
+    }
+    else
+    {
+        // نظم لا يعرف ja: نمط seta/movzx/test/jne نفسه الذي تُخفض إليه المقارنات.
+        int out_of_range = mach_func_alloc_vreg(ctx->mfunc);
+        MachineOperand oor8 = mach_op_vreg(out_of_range, 8);
+        MachineOperand oor64 = mach_op_vreg(out_of_range, 64);
+        isel_emit(ctx, MACH_SETA, oor8, mach_op_none(), mach_op_none());
+        isel_emit(ctx, MACH_MOVZX, oor64, oor8, mach_op_none());
+        isel_emit(ctx, MACH_TEST, mach_op_none(), oor64, oor64);
+        isel_emit(ctx, MACH_JNE, def, mach_op_none(), mach_op_none());
+    }
+    isel_emit(ctx, MACH_JMP_TABLE, mach_op_none(), idx, mach_op_imm(table, 32));
+}
+
 /**
  * @brief خفض عملية الرجوع.
  *
@@ -9,6 +9,7 @@
 
     ctx->ir_block = ir_block;
     ctx->mblock = mblock;
+    mblock->loop_depth = isel_block_loop_depth(ctx);
 
     // إصدار تسمية الكتلة
     MachineInst *label = mach_inst_new(MACH_LABEL, mach_op_label(ir_block->id),
@@ -39,15 +40,26 @@
             }
         }
 
+        // نمط المقارنة_ثم_القفز: نصدر cmp فقط ويستهلك قفز_شرط أعلامها مباشرة.
+        if (inst->op == IR_OP_CMP && isel_cmp_feeds_branch_only(ctx, inst))
+        {
+            if (isel_cmp_is_f64(inst))
+                isel_emit_fcmp_flags(ctx, inst);
+            else
+                isel_emit_cmp_flags(ctx, inst);
+            ctx->fused_cmp = inst;
+            inst = inst->next;
+            continue;
+        }
+
         isel_lower_inst(ctx, inst);
         inst = inst->next;
     }
 
     ctx->ir_inst = NULL;
+    ctx->fused_cmp = NULL;
 
-    // نسخ معلومات الخلفاء
-    mblock->succ_count = ir_block->succ_count;
-    // (سيتم ربط الخلفاء بالكتل الآلية لاحقاً)
+    // الخلفاء تُربط بالكتل الآلية بعد خفض كل الكتل (isel_lower_func).
 
     return mblock;
 }
@@ -64,6 +76,11 @@ static MachineFunc *isel_lower_func(ISelCtx *ctx, IRFunc *ir_func)
     if (!ir_func)
         return NULL;
 
+    // `تفرع` المتفرق يُفك إلى بحث ثنائي قبل الخفض؛ الكثيف يبقى لجدول قفز.
+    // يسبق ضبط next_vreg لأن الفك يحجز سجلات IR جديدة للمقارنات.
+    if (!ir_func->is_prototype)
+        (void)ir_switch_lower_func(ir_func);
+
     MachineFunc *mfunc = mach_func_new(ir_func->name);
     if (!mfunc)
         return NULL;
@@ -83,6 +100,7 @@ static MachineFunc *isel_lower_func(ISelCtx *ctx, IRFunc *ir_func)
 
     // تحليل الحلقات لاستخدامه في تحسينات داخل isel.
     ctx->loop_info = ir_loop_analyze_func(ir_func);
+    ctx->defuse = ctx->fuse_cmp_branch ? ir_defuse_build(ir_func) : NULL;
 
     // خفض كل كتلة
     for (IRBlock *block = ir_func->blocks; block; block = block->next)
@@ -99,6 +117,11 @@ static MachineFunc *isel_lower_func(ISelCtx *ctx, IRFunc *ir_func)
         ir_loop_info_free(ctx->loop_info);
         ctx->loop_info = NULL;
     }
+    if (ctx->defuse)
+    {
+        ir_defuse_free(ctx->defuse);
+        ctx->defuse = NULL;
+    }
 
     // ──────────────────────────────────────────────────────────────────────
     // ربط CFG: خلفاء الكتل الآلية (MachineBlock.succs)
@@ -136,10 +159,18 @@ static MachineFunc *isel_lower_func(ISelCtx *ctx, IRFunc *ir_func)
                         continue;
 
                     mb->succ_count = 0;
-                    mb->succs[0] = NULL;
-                    mb->succs[1] = NULL;
+                    free(mb->succs);
+                    mb->succs = NULL;
+                    if (ib->succ_count <= 0)
+                        continue;
+                    mb->succs = (MachineBlock **)calloc((size_t)ib->succ_count, sizeof(MachineBlock *));
+                    if (!mb->succs)
+                    {
+                        ctx->had_error = true;
+                        continue;
+                    }
 
-                    for (int s = 0; s < ib->succ_count && s < 2; s++)
+                    for (int s = 0; s < ib->succ_count; s++)
                     {
                         IRBlock *succ = ib->succs[s];
                         if (!succ)
@@ -285,7 +316,29 @@ static MachineFunc *isel_lower_func(ISelCtx *ctx, IRFunc *ir_func)
 // نقطة الدخول الرئيسية لاختيار التعليمات
 // ============================================================================
 
-MachineModule *isel_run_ex(IRModule *ir_module, bool enable_tco, const BaaTarget* target)
+/** خفض موزّع: خانة نتيجة لكل دالة وسياق مستقل لكل عامل. */
+typedef struct
+{
+    ISelCtx base;        // القالب المشترك (الوحدة/الهدف/الخيارات)
+    IRFunc **ir_funcs;   // الدوال بترتيب الوحدة
+    MachineFunc **out;   // النتيجة لكل دالة بالفهرس نفسه
+    ISelCtx *worker_ctx; // سياق لكل عامل
+} ISelParallel;
+
+static void isel_worker_begin(void *opaque, int worker)
+{
+    ISelParallel *par = (ISelParallel *)opaque;
+    par->worker_ctx[worker] = par->base;
+}
+
+static void isel_worker_run(void *opaque, int index, int worker)
+{
+    ISelParallel *par = (ISelParallel *)opaque;
+    par->out[index] = isel_lower_func(&par->worker_ctx[worker], par->ir_funcs[index]);
+}
+
+MachineModule *isel_run_ex2(IRModule *ir_module, bool enable_tco, bool fuse_cmp_branch,
+                            const BaaTarget* target, BaaThreadPool *pool)
 {
     if (!ir_module)
         return NULL;
@@ -302,23 +355,58 @@ MachineModule *isel_run_ex(IRModule *ir_module, bool enable_tco, const BaaTarget
     mmod->baa_strings = ir_module->baa_strings;
     mmod->baa_string_count = ir_module->baa_string_count;
 
-    ISelCtx ctx = {0};
-    ctx.mmod = mmod;
-    ctx.ir_module = ir_module;
-    ctx.enable_tco = enable_tco;
-    ctx.target = target ? target : baa_target_builtin_windows_x86_64();
+    int func_count = 0;
+    for (IRFunc *func = ir_module->funcs; func; func = func->next)
+        func_count++;
+    if (func_count < 2)
+        pool = NULL;
+    int workers = baa_thread_pool_size(pool);
+
+    ISelParallel par = {0};
+    par.base.mmod = mmod;
+    par.base.ir_module = ir_module;
+    par.base.enable_tco = enable_tco;
+    par.base.fuse_cmp_branch = fuse_cmp_branch;
+    par.base.target = target ? target : baa_target_builtin_windows_x86_64();
+    par.ir_funcs = (IRFunc **)calloc((size_t)(func_count ? func_count : 1), sizeof(IRFunc *));
+    par.out = (MachineFunc **)calloc((size_t)(func_count ? func_count : 1), sizeof(MachineFunc *));
+    par.worker_ctx = (ISelCtx *)calloc((size_t)workers, sizeof(ISelCtx));
+    if (!par.ir_funcs || !par.out || !par.worker_ctx)
+    {
+        free(par.ir_funcs);
+        free(par.out);
+        free(par.worker_ctx);
+        mach_module_free(mmod);
+        return NULL;
+    }
 
-    // خفض كل دالة
+    int n = 0;
     for (IRFunc *func = ir_module->funcs; func; func = func->next)
+        par.ir_funcs[n++] = func;
+
+    // خفض كل دالة (موزّعاً إن وُجد مجمّع؛ الخفض لا يلمس إلا الدالة نفسها)
+    // ثم الإضافة بترتيب الوحدة.
+    BaaParallelJob job = {
+        .ctx = &par,
+        .worker_begin = isel_worker_begin,
+        .run = isel_worker_run,
+    };
+    baa_thread_pool_run(pool, &job, func_count);
+
+    bool had_error = false;
+    for (int w = 0; w < workers; w++)
+        had_error |= par.worker_ctx[w].had_error;
+    for (int i = 0; i < func_count; i++)
     {
-        MachineFunc *mfunc = isel_lower_func(&ctx, func);
-        if (mfunc)
-        {
-            mach_module_add_func(mmod, mfunc);
-        }
+        if (par.out[i])
+            mach_module_add_func(mmod, par.out[i]);
     }
 
-    if (ctx.had_error)
+    free(par.ir_funcs);
+    free(par.out);
+    free(par.worker_ctx);
+
+    if (had_error)
     {
         mach_module_free(mmod);
         return NULL;
@@ -327,9 +415,15 @@ MachineModule *isel_run_ex(IRModule *ir_module, bool enable_tco, const BaaTarget
     return mmod;
 }
 
+MachineModule *isel_run_ex(IRModule *ir_module, bool enable_tco, bool fuse_cmp_branch,
+                            const BaaTarget* target)
+{
+    return isel_run_ex2(ir_module, enable_tco, fuse_cmp_branch, target, NULL);
+}
+
 MachineModule *isel_run(IRModule *ir_module)
 {
-    return isel_run_ex(ir_module, false, baa_target_builtin_windows_x86_64());
+    return isel_run_ex(ir_module, false, false, baa_target_builtin_windows_x86_64());
 }
 
 // ============================================================================
@@ -430,10 +524,32 @@ const char *mach_op_to_string(MachineOp op)
         return "je";
     case MACH_JNE:
         return "jne";
+    case MACH_JG:
+        return "jg";
+    case MACH_JL:
+        return "jl";
+    case MACH_JGE:
+        return "jge";
+    case MACH_JLE:
+        return "jle";
+    case MACH_JA:
+        return "ja";
+    case MACH_JB:
+        return "jb";
+    case MACH_JAE:
+        return "jae";
+    case MACH_JBE:
+        return "jbe";
+    case MACH_JP:
+        return "jp";
+    case MACH_JNP:
+        return "jnp";
     case MACH_CALL:
         return "call";
     case MACH_TAILJMP:
         return "tailjmp";
+    case MACH_JMP_TABLE:
+        return "jmp_table";
     case MACH_RET:
         return "ret";
     case MACH_PUSH:
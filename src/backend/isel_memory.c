@@ -132,27 +132,12 @@ static void isel_lower_store(ISelCtx *ctx, IRInst *inst)
 }
 
 /**
- * @brief خفض عملية المقارنة.
- *
- * النمط: %dst = قارن pred type lhs, rhs
- * →  cmp lhs, rhs
- *    setCC tmp8
- *    movzx vreg_dst, tmp8
+ * @brief إصدار cmp لمقارنة صحيحة دون استهلاك الأعلام.
  *
- * تحسين: إذا كان المعامل الأيمن قيمة فورية، نستخدمها مباشرة مع cmp.
+ * إذا كان المعامل الأيمن قيمة فورية نستخدمها مباشرة مع cmp.
  */
-static void isel_lower_cmp(ISelCtx *ctx, IRInst *inst)
+static void isel_emit_cmp_flags(ISelCtx *ctx, IRInst *inst)
 {
-    if (!inst || inst->operand_count < 2)
-        return;
-
-    // عشري: ucomisd + setcc
-    if (inst->operands[0] && inst->operands[0]->type && inst->operands[0]->type->kind == IR_TYPE_F64)
-    {
-        isel_lower_fcmp(ctx, inst);
-        return;
-    }
-
     int bits = isel_type_bits(inst->operands[0] ? inst->operands[0]->type : NULL);
     MachineOperand lhs = isel_lower_value(ctx, inst->operands[0]);
     MachineOperand rhs = isel_lower_value(ctx, inst->operands[1]);
@@ -167,51 +152,72 @@ static void isel_lower_cmp(ISelCtx *ctx, IRInst *inst)
         lhs = tmp_op;
     }
 
-    // تنفيذ المقارنة
     isel_emit(ctx, MACH_CMP, mach_op_none(), lhs, rhs);
+}
 
-    // اختيار تعليمة setCC المناسبة
-    MachineOp setcc;
-    switch (inst->cmp_pred)
+/**
+ * @brief كود setcc أو jcc المقابل لشرط مقارنة صحيحة.
+ */
+static MachineOp isel_int_cc_op(IRCmpPred pred, bool branch)
+{
+    switch (pred)
     {
     case IR_CMP_EQ:
-        setcc = MACH_SETE;
-        break;
+        return branch ? MACH_JE : MACH_SETE;
     case IR_CMP_NE:
-        setcc = MACH_SETNE;
-        break;
+        return branch ? MACH_JNE : MACH_SETNE;
     case IR_CMP_GT:
-        setcc = MACH_SETG;
-        break;
+        return branch ? MACH_JG : MACH_SETG;
     case IR_CMP_LT:
-        setcc = MACH_SETL;
-        break;
+        return branch ? MACH_JL : MACH_SETL;
     case IR_CMP_GE:
-        setcc = MACH_SETGE;
-        break;
+        return branch ? MACH_JGE : MACH_SETGE;
     case IR_CMP_LE:
-        setcc = MACH_SETLE;
-        break;
+        return branch ? MACH_JLE : MACH_SETLE;
     case IR_CMP_UGT:
-        setcc = MACH_SETA;
-        break;
+        return branch ? MACH_JA : MACH_SETA;
     case IR_CMP_ULT:
-        setcc = MACH_SETB;
-        break;
+        return branch ? MACH_JB : MACH_SETB;
     case IR_CMP_UGE:
-        setcc = MACH_SETAE;
-        break;
+        return branch ? MACH_JAE : MACH_SETAE;
     case IR_CMP_ULE:
-        setcc = MACH_SETBE;
-        break;
+        return branch ? MACH_JBE : MACH_SETBE;
     default:
-        setcc = MACH_SETE;
-        break;
+        return branch ? MACH_JE : MACH_SETE;
+    }
+}
+
+static bool isel_cmp_is_f64(IRInst *inst)
+{
+    return inst->operands[0] && inst->operands[0]->type &&
+           inst->operands[0]->type->kind == IR_TYPE_F64;
+}
+
+/**
+ * @brief خفض عملية المقارنة.
+ *
+ * النمط: %dst = قارن pred type lhs, rhs
+ * →  cmp lhs, rhs
+ *    setCC tmp8
+ *    movzx vreg_dst, tmp8
+ */
+static void isel_lower_cmp(ISelCtx *ctx, IRInst *inst)
+{
+    if (!inst || inst->operand_count < 2)
+        return;
+
+    // عشري: ucomisd + setcc
+    if (isel_cmp_is_f64(inst))
+    {
+        isel_lower_fcmp(ctx, inst);
+        return;
     }
 
+    isel_emit_cmp_flags(ctx, inst);
+
     // setCC يكتب بايت واحد
     MachineOperand dst8 = mach_op_vreg(inst->dest, 8);
-    isel_emit(ctx, setcc, dst8, mach_op_none(), mach_op_none());
+    isel_emit(ctx, isel_int_cc_op(inst->cmp_pred, false), dst8, mach_op_none(), mach_op_none());
 
     // توسيع بالأصفار إلى حجم كامل
     MachineOperand dst64 = mach_op_vreg(inst->dest, 64);
@@ -305,6 +305,9 @@ static void isel_lower_inst(ISelCtx *ctx, IRInst *inst)
     case IR_OP_BR_COND:
         isel_lower_br_cond(ctx, inst);
         break;
+    case IR_OP_SWITCH:
+        isel_lower_switch(ctx, inst);
+        break;
     case IR_OP_RET:
         isel_lower_ret(ctx, inst);
         break;
@@ -9,10 +9,12 @@
  * 4. المسح الخطي مع تسريب عند نفاد السجلات
  * 5. إدراج كود التسريب (store/load)
  * 6. إعادة كتابة المعاملات بسجلات فيزيائية
+ * 7. حذف النسخ mov r, r والتسريب المكرر داخل كل كتلة
  */
 
 #include "backend_internal.h"
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -469,4 +471,6 @@ void regalloc_compute_def_use(RegAllocCtx *ctx)
 #include "regalloc_liveness.c"
 #include "regalloc_linear_scan.c"
 #include "regalloc_rewrite.c"
+#include "regalloc_cleanup.c"
+#include "regalloc_split.c"
 #include "regalloc_driver.c"
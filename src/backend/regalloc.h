@@ -18,6 +18,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "../support/target_contract.h"
+#include "code_model.h"
 #include "isel.h"
 typedef struct BaaCallingConv BaaCallingConv;
 
@@ -140,6 +141,30 @@ typedef struct BlockLiveness {
     uint64_t* live_out; // السجلات الحية عند خروج الكتلة
 } BlockLiveness;
 
+// ============================================================================
+// إحصاءات التسريب (Spill Statistics)
+// ============================================================================
+
+/**
+ * @struct RegAllocStats
+ * @brief عدّادات ثابتة لكود التسريب في دالة واحدة (تُطبع مع --regalloc-stats).
+ *
+ * كل معامل يقرأ خانة تسريب يُحسب إعادة تحميل، وكل معامل يكتبها يُحسب تخزيناً،
+ * سواء كان معامل ذاكرة مباشراً أو نقلاً أدرجه المخصص. weighted_cost يضرب كل
+ * منها في 10^عمق الحلقة (حتى 10^6) ليقارب الكلفة الديناميكية.
+ */
+typedef struct RegAllocStats {
+    int vregs;              // السجلات الافتراضية ذات الفترات
+    int spilled_vregs;      // السجلات التي احتاجت خانة مكدس
+    int splits;             // عدد مرات تقسيم فترة (المخصص المقسِّم فقط)
+    int spill_stores;       // كتابات إلى خانات التسريب
+    int reloads;            // قراءات من خانات التسريب
+    int moves;              // نقل سجل ← سجل عند حدود التقسيم
+    int copies_removed;     // mov r, r (٦٤ بت) حذفها التنظيف بعد دمج النسخ
+    int spill_removed;      // تخزين/تحميل حذفه التنظيف أو استبدله بسجل
+    int64_t weighted_cost;  // (تخزين + تحميل) موزونة بعمق الحلقة
+} RegAllocStats;
+
 // ============================================================================
 // سياق تخصيص السجلات (Register Allocation Context)
 // ============================================================================
@@ -182,6 +207,9 @@ typedef struct RegAllocCtx {
 
     // السجلات المحفوظة (callee-saved) المستخدمة
     bool callee_saved_used[PHYS_REG_COUNT];
+
+    // إحصاءات التسريب لهذه الدالة
+    RegAllocStats stats;
 } RegAllocCtx;
 
 // ============================================================================
@@ -212,6 +240,29 @@ bool regalloc_run(MachineModule* module);
  */
 bool regalloc_run_ex(MachineModule* module, const BaaTarget* target);
 
+/**
+ * @brief تشغيل التخصيص بمخصص محدد مع إحصاءات اختيارية.
+ *
+ * BAA_REGALLOC_SPLIT يبني لكل vreg قائمة مدى بفجوات، ويقسم الفترة عند حدود
+ * الكتل وحول النداءات بدل تسريبها كاملة، ويختار الضحية بوزن استخداماتها
+ * (10^عمق الحلقة). الدالة التي لا يجد لها تخصيصاً صالحاً تعود إلى المسح الخطي.
+ *
+ * @param mode المخصص المطلوب.
+ * @param stats_out إن لم يكن NULL يُطبع سطر `[REGALLOC]` لكل دالة.
+ * @return صحيح عند النجاح.
+ */
+bool regalloc_run_ex2(MachineModule* module, const BaaTarget* target,
+                      BaaRegAllocMode mode, FILE* stats_out);
+
+/**
+ * @brief مثل regalloc_run_ex2 مع توزيع الدوال على مجمّع خيوط (--threads).
+ *
+ * أسطر `[REGALLOC]` تُطبع بعد انتهاء كل الدوال بترتيب الوحدة، فالخرج لا يتغير
+ * بعدد الخيوط. pool = NULL يعني تشغيلاً تسلسلياً.
+ */
+bool regalloc_run_ex3(MachineModule* module, const BaaTarget* target,
+                      BaaRegAllocMode mode, FILE* stats_out, BaaThreadPool* pool);
+
 /**
  * @brief تشغيل تخصيص السجلات على دالة واحدة.
  *
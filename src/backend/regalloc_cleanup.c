@@ -0,0 +1,263 @@
+// ============================================================================
+// تنظيف ما بعد التخصيص (Post-Allocation Cleanup)
+// ============================================================================
+//
+// بعد إعادة الكتابة تصير المعاملات سجلات فيزيائية وخانات [rbp-إزاحة]. مرور
+// أمامي داخل كل كتلة:
+// - يحذف mov r, r بعرض ٦٤ بت؛ أغلبها نسخ وحّد تلميحُ النسخ سجلَي طرفيها.
+//   نقل ٣٢ بت إلى السجل نفسه يصفّر النصف الأعلى فلا يُحذف.
+// - يتذكر لكل خانة تسريب السجلَّ الذي يحمل قيمتها منذ آخر تخزين أو تحميل،
+//   فيحذف التحميل إلى السجل نفسه والتخزين المكرر، ويقرأ السجل بدل الخانة
+//   في غيرهما.
+//
+// تُتبع خانات التسريب وحدها (ما بعد حجم الإطار قبل التخصيص): لا يأخذ أحد
+// عنوانها فلا يكتبها مؤشر ولا نداء. RAX وR11 لا يحملان خانة لأن الإصدار
+// يستعملهما مؤقتين، وكذلك RDX لأن القسمة وcqo تكتبه ضمنياً. الحالة تبدأ
+// فارغة في كل كتلة فلا حاجة لتحليل تدفق بين الكتل.
+
+typedef struct
+{
+    RegAllocCtx *ctx;
+    int spill_base;       // حجم الإطار قبل التخصيص
+    int slot_count;
+    PhysReg *holder;      // خانة → سجل يحمل قيمتها أو PHYS_NONE
+    unsigned *holder_gen; // جيل السجل عند الربط
+    unsigned reg_gen[PHYS_REG_COUNT];
+    int loop_depth;       // عمق الكتلة الحالية (لتصحيح الكلفة الموزونة)
+} RegAllocCleanup;
+
+static bool cleanup_is_reg(const MachineOperand *op)
+{
+    return op->kind == MACH_OP_VREG && op->data.vreg >= 0 && op->data.vreg < PHYS_REG_COUNT;
+}
+
+static bool cleanup_can_hold(int reg)
+{
+    return reg >= 0 && reg < PHYS_REG_COUNT && reg != PHYS_RAX && reg != PHYS_RDX &&
+           reg != PHYS_R11 && reg != PHYS_RSP && reg != PHYS_RBP;
+}
+
+/**
+ * @brief فهرس خانة التسريب التي يشير إليها المعامل، أو -1.
+ */
+static int cleanup_slot(const RegAllocCleanup *cl, const MachineOperand *op)
+{
+    if (op->kind != MACH_OP_MEM || op->data.mem.base_vreg != PHYS_RBP)
+        return -1;
+    int64_t off = -(int64_t)op->data.mem.offset - cl->spill_base;
+    if (off <= 0 || off % 8 != 0 || off / 8 > cl->slot_count)
+        return -1;
+    return (int)(off / 8) - 1;
+}
+
+static PhysReg cleanup_holder(const RegAllocCleanup *cl, int slot)
+{
+    PhysReg r = cl->holder[slot];
+    if (r == PHYS_NONE || cl->holder_gen[slot] != cl->reg_gen[r])
+        return PHYS_NONE;
+    return r;
+}
+
+static void cleanup_bind(RegAllocCleanup *cl, int slot, int reg)
+{
+    cl->holder[slot] = (PhysReg)reg;
+    cl->holder_gen[slot] = cl->reg_gen[reg];
+}
+
+static void cleanup_clobber(RegAllocCleanup *cl, int reg)
+{
+    if (reg >= 0 && reg < PHYS_REG_COUNT)
+        cl->reg_gen[reg]++;
+}
+
+/**
+ * @brief تسجيل وصول محذوف إلى خانة تسريب (عكس regalloc_stats_note).
+ */
+static void cleanup_note_removed(RegAllocCleanup *cl, bool is_store)
+{
+    RegAllocStats *st = &cl->ctx->stats;
+    if (is_store)
+        st->spill_stores--;
+    else
+        st->reloads--;
+    st->weighted_cost -= regalloc_depth_weight(cl->loop_depth);
+    st->spill_removed++;
+}
+
+/**
+ * @brief استبدال قراءة خانة بالسجل الذي يحمل قيمتها إن وُجد.
+ */
+static void cleanup_forward(RegAllocCleanup *cl, MachineOperand *op)
+{
+    int slot = cleanup_slot(cl, op);
+    if (slot < 0)
+        return;
+    PhysReg h = cleanup_holder(cl, slot);
+    if (h == PHYS_NONE)
+        return;
+    *op = mach_op_vreg(h, op->size_bits);
+    cleanup_note_removed(cl, false);
+}
+
+static void cleanup_remove_inst(MachineBlock *block, MachineInst *inst)
+{
+    if (inst->prev) inst->prev->next = inst->next;
+    else block->first = inst->next;
+    if (inst->next) inst->next->prev = inst->prev;
+    else block->last = inst->prev;
+    block->inst_count--;
+    inst->prev = NULL;
+    inst->next = NULL;
+    mach_inst_free(inst);
+}
+
+/**
+ * @brief هل التعليمة نقل ٦٤ بت لا أثر له فتُحذف؟
+ */
+static bool cleanup_is_dead_move(RegAllocCleanup *cl, const MachineInst *inst)
+{
+    if (inst->op != MACH_MOV || inst->dst.size_bits != 64 || inst->src1.size_bits != 64)
+        return false;
+
+    if (cleanup_is_reg(&inst->dst) && cleanup_is_reg(&inst->src1) &&
+        inst->dst.data.vreg == inst->src1.data.vreg)
+    {
+        cl->ctx->stats.copies_removed++;
+        return true;
+    }
+
+    // mov [S], r والسجل r ما زال يحمل قيمة S.
+    int slot = cleanup_slot(cl, &inst->dst);
+    if (slot >= 0 && cleanup_is_reg(&inst->src1) &&
+        cleanup_holder(cl, slot) == (PhysReg)inst->src1.data.vreg)
+    {
+        cleanup_note_removed(cl, true);
+        return true;
+    }
+
+    // mov r, [S] والسجل r يحمل قيمة S أصلاً.
+    slot = cleanup_slot(cl, &inst->src1);
+    if (slot >= 0 && cleanup_is_reg(&inst->dst) &&
+        cleanup_holder(cl, slot) == (PhysReg)inst->dst.data.vreg)
+    {
+        cleanup_note_removed(cl, false);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief تحديث الحالة بكتابات تعليمة واحدة (بعد معالجة قراءاتها).
+ */
+static void cleanup_apply_writes(RegAllocCleanup *cl, const MachineInst *inst, int load_slot)
+{
+    const BaaCallingConv *cc = cl->ctx->cc;
+
+    if (inst->op == MACH_CALL)
+    {
+        for (int r = 0; r < PHYS_REG_COUNT; r++)
+        {
+            if (reg_is_caller_saved_cc(cc, (PhysReg)r))
+                cleanup_clobber(cl, r);
+        }
+    }
+    else if (inst->op == MACH_CQO || inst->op == MACH_IDIV || inst->op == MACH_DIV ||
+             inst->op == MACH_RDTSC)
+    {
+        cleanup_clobber(cl, PHYS_RAX);
+        cleanup_clobber(cl, PHYS_RDX);
+    }
+
+    if (cleanup_is_reg(&inst->dst))
+        cleanup_clobber(cl, inst->dst.data.vreg);
+
+    bool mov64 = inst->op == MACH_MOV && inst->dst.size_bits == 64 && inst->src1.size_bits == 64;
+    int slot = cleanup_slot(cl, &inst->dst);
+    if (slot >= 0)
+    {
+        cl->holder[slot] = PHYS_NONE;
+        if (mov64 && cleanup_is_reg(&inst->src1) && cleanup_can_hold(inst->src1.data.vreg))
+            cleanup_bind(cl, slot, inst->src1.data.vreg);
+    }
+    else if (load_slot >= 0 && mov64 && cleanup_is_reg(&inst->dst) &&
+             cleanup_can_hold(inst->dst.data.vreg))
+    {
+        cleanup_bind(cl, load_slot, inst->dst.data.vreg);
+    }
+}
+
+/**
+ * @brief تنظيف دالة بعد تخصيص سجلاتها وإعادة كتابة معاملاتها.
+ */
+static bool regalloc_cleanup_func(RegAllocCtx *ctx, int spill_base)
+{
+    MachineFunc *func = ctx->func;
+    RegAllocCleanup cl;
+    memset(&cl, 0, sizeof(cl));
+    cl.ctx = ctx;
+    cl.spill_base = spill_base;
+    cl.slot_count = func->stack_size > spill_base ? (func->stack_size - spill_base) / 8 : 0;
+    if (cl.slot_count > 0)
+    {
+        cl.holder = (PhysReg *)malloc((size_t)cl.slot_count * sizeof(PhysReg));
+        cl.holder_gen = (unsigned *)calloc((size_t)cl.slot_count, sizeof(unsigned));
+        if (!cl.holder || !cl.holder_gen)
+        {
+            free(cl.holder);
+            free(cl.holder_gen);
+            return false;
+        }
+    }
+
+    for (MachineBlock *block = func->blocks; block; block = block->next)
+    {
+        for (int s = 0; s < cl.slot_count; s++)
+            cl.holder[s] = PHYS_NONE;
+        cl.loop_depth = block->loop_depth;
+
+        MachineInst *inst = block->first;
+        while (inst)
+        {
+            MachineInst *next = inst->next;
+            if (cleanup_is_dead_move(&cl, inst))
+            {
+                cleanup_remove_inst(block, inst);
+                inst = next;
+                continue;
+            }
+
+            int load_slot = -1;
+            switch (inst->op)
+            {
+            case MACH_MOV:
+                load_slot = cleanup_slot(&cl, &inst->src1);
+                cleanup_forward(&cl, &inst->src1);
+                if (inst->src1.kind != MACH_OP_MEM)
+                    load_slot = -1;
+                break;
+            case MACH_ADD:
+            case MACH_SUB:
+            case MACH_AND:
+            case MACH_OR:
+            case MACH_XOR:
+            case MACH_IMUL:
+                cleanup_forward(&cl, &inst->src2);
+                break;
+            case MACH_CMP:
+            case MACH_TEST:
+                cleanup_forward(&cl, &inst->src1);
+                cleanup_forward(&cl, &inst->src2);
+                break;
+            default:
+                break;
+            }
+
+            cleanup_apply_writes(&cl, inst, load_slot);
+            inst = next;
+        }
+    }
+
+    free(cl.holder);
+    free(cl.holder_gen);
+    return true;
+}
@@ -2,7 +2,27 @@
 // تشغيل تخصيص السجلات لدالة واحدة
 // ============================================================================
 
-static bool regalloc_func_ex(MachineFunc *func, const BaaCallingConv* cc)
+/** نتيجة دالة واحدة؛ سطر `[REGALLOC]` يُطبع لاحقاً بترتيب الدوال. */
+typedef struct
+{
+    bool ran;
+    bool split;
+    RegAllocStats stats;
+} RegAllocFuncResult;
+
+static void regalloc_print_stats(FILE *out, const MachineFunc *func, const RegAllocFuncResult *res)
+{
+    const RegAllocStats *st = &res->stats;
+    fprintf(out,
+            "[REGALLOC] func=%s allocator=%s vregs=%d spilled=%d splits=%d stores=%d "
+            "reloads=%d moves=%d cost=%lld copies_removed=%d spill_removed=%d\n",
+            func->name ? func->name : "?", res->split ? "split" : "linear", st->vregs,
+            st->spilled_vregs, st->splits, st->spill_stores, st->reloads, st->moves,
+            (long long)st->weighted_cost, st->copies_removed, st->spill_removed);
+}
+
+static bool regalloc_func_ex(MachineFunc *func, const BaaCallingConv* cc,
+                             BaaRegAllocMode mode, RegAllocFuncResult *out_result)
 {
     if (!func || func->is_prototype)
         return true;
@@ -15,6 +35,7 @@ static bool regalloc_func_ex(MachineFunc *func, const BaaCallingConv* cc)
         return false;
 
     ctx->cc = cc;
+    const int spill_base = func->stack_size;
 
     // 1. ترقيم التعليمات
     regalloc_number_insts(ctx);
@@ -25,17 +46,55 @@ static bool regalloc_func_ex(MachineFunc *func, const BaaCallingConv* cc)
     // 3. حساب الحيوية (live-in / live-out)
     regalloc_compute_liveness(ctx);
 
-    // 4. بناء فترات الحيوية
-    regalloc_build_intervals(ctx);
+    // 4. المخصص المقسِّم يبني فترات بفجوات ويُدرج نقلاته بنفسه.
+    bool split_done = false;
+    if (mode == BAA_REGALLOC_SPLIT)
+    {
+        SplitResult r = regalloc_split_func(ctx);
+        if (r == SPLIT_RESULT_ERROR)
+        {
+            regalloc_ctx_free(ctx);
+            return false;
+        }
+        split_done = r == SPLIT_RESULT_DONE;
+        if (!split_done)
+        {
+            ctx->next_spill_offset = func->stack_size;
+            memset(&ctx->stats, 0, sizeof(ctx->stats));
+        }
+    }
 
-    // 5. المسح الخطي
-    regalloc_linear_scan(ctx);
+    if (!split_done)
+    {
+        // 5. بناء فترات الحيوية
+        regalloc_build_intervals(ctx);
+
+        // 6. المسح الخطي
+        regalloc_linear_scan(ctx);
+
+        // 7. إدراج كود التسريب
+        regalloc_insert_spill_code(ctx);
 
-    // 6. إدراج كود التسريب
-    regalloc_insert_spill_code(ctx);
+        // 8. إعادة كتابة المعاملات
+        regalloc_rewrite(ctx);
 
-    // 7. إعادة كتابة المعاملات
-    regalloc_rewrite(ctx);
+        ctx->stats.vregs = ctx->interval_count;
+        ctx->stats.spilled_vregs = ctx->spill_count;
+    }
+
+    // 9. حذف النسخ المدموجة والتسريب المكرر داخل كل كتلة
+    if (!regalloc_cleanup_func(ctx, spill_base))
+    {
+        regalloc_ctx_free(ctx);
+        return false;
+    }
+
+    if (out_result)
+    {
+        out_result->ran = true;
+        out_result->split = split_done;
+        out_result->stats = ctx->stats;
+    }
 
     // تحرير السياق
     regalloc_ctx_free(ctx);
@@ -45,29 +104,91 @@ static bool regalloc_func_ex(MachineFunc *func, const BaaCallingConv* cc)
 
 bool regalloc_func(MachineFunc *func)
 {
-    return regalloc_func_ex(func, baa_target_builtin_windows_x86_64()->cc);
+    return regalloc_func_ex(func, baa_target_builtin_windows_x86_64()->cc,
+                            BAA_REGALLOC_LINEAR, NULL);
 }
 
 // ============================================================================
 // تشغيل تخصيص السجلات على وحدة كاملة
 // ============================================================================
 
-bool regalloc_run_ex(MachineModule *module, const BaaTarget* target)
+typedef struct
+{
+    MachineFunc **funcs;
+    RegAllocFuncResult *results;
+    bool *ok;
+    const BaaCallingConv *cc;
+    BaaRegAllocMode mode;
+} RegAllocParallel;
+
+static void regalloc_worker_run(void *opaque, int index, int worker)
+{
+    (void)worker;
+    RegAllocParallel *par = (RegAllocParallel *)opaque;
+    par->ok[index] = regalloc_func_ex(par->funcs[index], par->cc, par->mode, &par->results[index]);
+}
+
+bool regalloc_run_ex3(MachineModule *module, const BaaTarget* target,
+                      BaaRegAllocMode mode, FILE* stats_out, BaaThreadPool* pool)
 {
     if (!module)
         return false;
 
-    const BaaCallingConv* cc = regalloc_cc_or_default(target);
+    int count = 0;
+    for (MachineFunc *func = module->funcs; func; func = func->next)
+        count++;
+    if (count == 0)
+        return true;
+
+    RegAllocParallel par = {0};
+    par.cc = regalloc_cc_or_default(target);
+    par.mode = mode;
+    par.funcs = (MachineFunc **)calloc((size_t)count, sizeof(MachineFunc *));
+    par.results = (RegAllocFuncResult *)calloc((size_t)count, sizeof(RegAllocFuncResult));
+    par.ok = (bool *)calloc((size_t)count, sizeof(bool));
+    if (!par.funcs || !par.results || !par.ok)
+    {
+        free(par.funcs);
+        free(par.results);
+        free(par.ok);
+        return false;
+    }
 
+    int n = 0;
     for (MachineFunc *func = module->funcs; func; func = func->next)
+        par.funcs[n++] = func;
+
+    // الدوال مستقلة تماماً بعد isel؛ النتائج تُجمع وتُطبع بترتيب الوحدة.
+    BaaParallelJob job = {.ctx = &par, .run = regalloc_worker_run};
+    baa_thread_pool_run(count > 1 ? pool : NULL, &job, count);
+
+    bool ok = true;
+    for (int i = 0; i < count && ok; i++)
     {
-        if (!regalloc_func_ex(func, cc))
+        if (!par.ok[i])
         {
-            return false;
+            ok = false;
+            break;
         }
+        if (stats_out && par.results[i].ran)
+            regalloc_print_stats(stats_out, par.funcs[i], &par.results[i]);
     }
 
-    return true;
+    free(par.funcs);
+    free(par.results);
+    free(par.ok);
+    return ok;
+}
+
+bool regalloc_run_ex2(MachineModule *module, const BaaTarget* target,
+                      BaaRegAllocMode mode, FILE* stats_out)
+{
+    return regalloc_run_ex3(module, target, mode, stats_out, NULL);
+}
+
+bool regalloc_run_ex(MachineModule *module, const BaaTarget* target)
+{
+    return regalloc_run_ex2(module, target, BAA_REGALLOC_LINEAR, NULL);
 }
 
 bool regalloc_run(MachineModule *module)
@@ -17,21 +17,47 @@ static int interval_cmp_start(const void *a, const void *b)
 /**
  * @brief هل الفترة تعبر موقع CALL؟
  * @param li مؤشر إلى فترة الحيوية
- * @param call_pos مصفوفة مواقع CALL
+ * @param call_pos مصفوفة مواقع CALL (تصاعدية)
  * @param call_count عدد مواقع CALL
  * @return true إذا كانت الفترة تعبر CALL
+ *
+ * بحث ثنائي عن أول نداء بعد بداية الفترة: تعبر الفترة نداءً إذا وقع قبل نهايتها.
  */
 static bool interval_crosses_call(const LiveInterval *li, const int *call_pos, int call_count)
 {
     if (!li || !call_pos || call_count == 0)
         return false;
-    for (int c = 0; c < call_count; c++)
+    int lo = 0;
+    int hi = call_count;
+    while (lo < hi)
     {
-        int p = call_pos[c];
-        if (li->start < p && li->end > p)
-            return true;
+        int mid = lo + (hi - lo) / 2;
+        if (call_pos[mid] <= li->start)
+            lo = mid + 1;
+        else
+            hi = mid;
     }
-    return false;
+    return lo < call_count && call_pos[lo] < li->end;
+}
+
+/**
+ * @brief هل التعليمة pos نسخة mov بين سجلين افتراضيين عاديين بعرض ٦٤ بت؟
+ *
+ * النسخ الأضيق تُستثنى: mov بعرض ٣٢ بت إلى السجل نفسه يصفّر النصف الأعلى،
+ * فلا يجوز أن يتحول إلى mov r, r محذوف.
+ */
+static bool regalloc_copy_inst(const RegAllocCtx *ctx, int pos, int *out_dst, int *out_src)
+{
+    if (!ctx->inst_map || pos < 0 || pos >= ctx->total_insts)
+        return false;
+    MachineInst *inst = ctx->inst_map[pos];
+    if (!inst || inst->op != MACH_MOV || !is_normal_vreg(&inst->dst) ||
+        !is_normal_vreg(&inst->src1) || inst->dst.size_bits != 64 ||
+        inst->src1.size_bits != 64 || inst->dst.data.vreg == inst->src1.data.vreg)
+        return false;
+    *out_dst = inst->dst.data.vreg;
+    *out_src = inst->src1.data.vreg;
+    return true;
 }
 
 // ============================================================================
@@ -41,6 +67,9 @@ static bool interval_crosses_call(const LiveInterval *li, const int *call_pos, i
 /**
  * @struct ActiveInterval
  * @brief عنصر في قائمة الفترات النشطة مرتبة حسب نقطة النهاية.
+ *
+ * لكل فترة نشطة سجل فيزيائي مختلف، فلا تتجاوز القائمة PHYS_REG_COUNT عنصراً
+ * مهما كبرت الدالة: الإدراج بالبحث الثنائي والإزاحة كلفتهما ثابتة.
  */
 typedef struct
 {
@@ -48,6 +77,38 @@ typedef struct
     PhysReg reg;      // السجل الفيزيائي المخصص
 } ActiveEntry;
 
+/**
+ * @brief إدراج فترة في القائمة النشطة مع الحفاظ على ترتيب النهايات.
+ */
+static void active_insert(const RegAllocCtx *ctx, ActiveEntry *active, int *active_count,
+                          int interval_idx, PhysReg reg)
+{
+    int end = ctx->intervals[interval_idx].end;
+    int lo = 0;
+    int hi = *active_count;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (ctx->intervals[active[mid].interval_idx].end > end)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    memmove(&active[lo + 1], &active[lo], (size_t)(*active_count - lo) * sizeof(ActiveEntry));
+    active[lo].interval_idx = interval_idx;
+    active[lo].reg = reg;
+    (*active_count)++;
+}
+
+/**
+ * @brief حذف العنصر k من القائمة النشطة.
+ */
+static void active_remove(ActiveEntry *active, int *active_count, int k)
+{
+    memmove(&active[k], &active[k + 1], (size_t)(*active_count - k - 1) * sizeof(ActiveEntry));
+    (*active_count)--;
+}
+
 void regalloc_linear_scan(RegAllocCtx *ctx)
 {
     if (!ctx || ctx->interval_count == 0)
@@ -58,9 +119,7 @@ void regalloc_linear_scan(RegAllocCtx *ctx)
           sizeof(LiveInterval), interval_cmp_start);
 
     // قائمة الفترات النشطة
-    ActiveEntry *active = malloc(ctx->interval_count * sizeof(ActiveEntry));
-    if (!active)
-        return;
+    ActiveEntry active[PHYS_REG_COUNT];
     int active_count = 0;
 
     // بناء قائمة مواقع CALL (حسب ترتيب inst_map)
@@ -114,29 +173,43 @@ void regalloc_linear_scan(RegAllocCtx *ctx)
         LiveInterval *cur = &ctx->intervals[i];
         bool cur_crosses_call = interval_crosses_call(cur, call_pos, call_count);
 
-        // 1. انتهاء الفترات النشطة التي انتهت قبل نقطة بداية الفترة الحالية
-        int new_active_count = 0;
-        for (int j = 0; j < active_count; j++)
+        // 1. انتهاء الفترات النشطة التي انتهت قبل نقطة بداية الفترة الحالية؛
+        // القائمة مرتبة حسب النهاية فالمنتهية بادئة منها.
+        int expired = 0;
+        while (expired < active_count && ctx->intervals[active[expired].interval_idx].end < cur->start)
         {
-            LiveInterval *act = &ctx->intervals[active[j].interval_idx];
-            if (act->end < cur->start)
-            {
-                // الفترة انتهت: تحرير السجل
-                reg_free[active[j].reg] = true;
-            }
-            else
-            {
-                // الفترة لا تزال نشطة
-                active[new_active_count++] = active[j];
-            }
+            // الفترة انتهت: تحرير السجل
+            reg_free[active[expired].reg] = true;
+            expired++;
         }
-        active_count = new_active_count;
+        active_count -= expired;
+        memmove(&active[0], &active[expired], (size_t)active_count * sizeof(ActiveEntry));
 
         // 2. محاولة تخصيص سجل فيزيائي
         PhysReg assigned = PHYS_NONE;
 
+        // تلميح النسخ: إن بدأت الفترة بـ mov cur, s وانتهت فترة s عندها، يرث
+        // cur سجل s فتصير النسخة mov r, r ويحذفها التنظيف بعد التخصيص.
+        int copy_dst = -1;
+        int copy_src = -1;
+        if (regalloc_copy_inst(ctx, cur->start, &copy_dst, &copy_src) && copy_dst == cur->vreg)
+        {
+            for (int j = 0; j < active_count; j++)
+            {
+                LiveInterval *act = &ctx->intervals[active[j].interval_idx];
+                if (act->vreg != copy_src || act->end != cur->start)
+                    continue;
+                if (!(cur_crosses_call && reg_is_caller_saved_cc(cc, active[j].reg)))
+                {
+                    assigned = active[j].reg;
+                    active_remove(active, &active_count, j);
+                }
+                break;
+            }
+        }
+
         // البحث عن سجل متاح بترتيب الأفضلية
-        for (int k = 0; k < alloc_order_count; k++)
+        for (int k = 0; assigned == PHYS_NONE && k < alloc_order_count; k++)
         {
             PhysReg r = alloc_order[k];
 
@@ -168,23 +241,7 @@ void regalloc_linear_scan(RegAllocCtx *ctx)
             }
 
             // إضافة إلى القائمة النشطة (مرتبة حسب نقطة النهاية)
-            int insert_pos = active_count;
-            for (int j = 0; j < active_count; j++)
-            {
-                if (ctx->intervals[active[j].interval_idx].end > cur->end)
-                {
-                    insert_pos = j;
-                    break;
-                }
-            }
-            // إزاحة العناصر
-            for (int j = active_count; j > insert_pos; j--)
-            {
-                active[j] = active[j - 1];
-            }
-            active[insert_pos].interval_idx = i;
-            active[insert_pos].reg = assigned;
-            active_count++;
+            active_insert(ctx, active, &active_count, i, assigned);
         }
         else
         {
@@ -233,23 +290,14 @@ void regalloc_linear_scan(RegAllocCtx *ctx)
                 }
 
                 // إزالته من القائمة النشطة
-                int remove_pos = -1;
                 for (int j = 0; j < active_count; j++)
                 {
                     if (active[j].interval_idx == spill_idx)
                     {
-                        remove_pos = j;
+                        active_remove(active, &active_count, j);
                         break;
                     }
                 }
-                if (remove_pos >= 0)
-                {
-                    for (int j = remove_pos; j < active_count - 1; j++)
-                    {
-                        active[j] = active[j + 1];
-                    }
-                    active_count--;
-                }
 
                 // تخصيص السجل المحرر للفترة الحالية
                 cur->phys_reg = freed_reg;
@@ -261,22 +309,7 @@ void regalloc_linear_scan(RegAllocCtx *ctx)
                 }
 
                 // إضافة الحالية إلى القائمة النشطة
-                int insert_pos = active_count;
-                for (int j = 0; j < active_count; j++)
-                {
-                    if (ctx->intervals[active[j].interval_idx].end > cur->end)
-                    {
-                        insert_pos = j;
-                        break;
-                    }
-                }
-                for (int j = active_count; j > insert_pos; j--)
-                {
-                    active[j] = active[j - 1];
-                }
-                active[insert_pos].interval_idx = i;
-                active[insert_pos].reg = freed_reg;
-                active_count++;
+                active_insert(ctx, active, &active_count, i, freed_reg);
             }
             else
             {
@@ -305,5 +338,4 @@ void regalloc_linear_scan(RegAllocCtx *ctx)
     ctx->func->stack_size = ctx->next_spill_offset;
 
     free(call_pos);
-    free(active);
 }
@@ -2,6 +2,142 @@
 // حساب الحيوية (Liveness: live-in / live-out)
 // ============================================================================
 
+/**
+ * @brief رسم الكتل بالفهارس: الخلفاء والأسلاف بصيغة CSR.
+ *
+ * الخلف يُحوَّل إلى فهرسه عبر خريطة id → فهرس بدل البحث في كل الكتل، فيصير
+ * بناء الرسم خطياً في عدد الحواف.
+ */
+typedef struct
+{
+    int *succ_start; // bc + 1
+    int *succs;
+    int *pred_start; // bc + 1
+    int *preds;
+} LivenessGraph;
+
+static void liveness_graph_free(LivenessGraph *g)
+{
+    free(g->succ_start);
+    free(g->succs);
+    free(g->pred_start);
+    free(g->preds);
+}
+
+static bool liveness_graph_build(LivenessGraph *g, MachineBlock **block_arr, int bc)
+{
+    memset(g, 0, sizeof(*g));
+    int max_id = -1;
+    int edges = 0;
+    for (int b = 0; b < bc; b++)
+    {
+        if (block_arr[b]->id > max_id)
+            max_id = block_arr[b]->id;
+        edges += block_arr[b]->succ_count;
+    }
+
+    int *index_of_id = malloc((size_t)(max_id + 2) * sizeof(int));
+    g->succ_start = calloc((size_t)bc + 1, sizeof(int));
+    g->pred_start = calloc((size_t)bc + 1, sizeof(int));
+    g->succs = malloc((size_t)(edges > 0 ? edges : 1) * sizeof(int));
+    g->preds = malloc((size_t)(edges > 0 ? edges : 1) * sizeof(int));
+    int *fill = malloc((size_t)bc * sizeof(int));
+    bool ok = index_of_id && g->succ_start && g->pred_start && g->succs && g->preds && fill;
+    if (ok)
+    {
+        for (int i = 0; i <= max_id; i++)
+            index_of_id[i] = -1;
+        for (int b = 0; b < bc; b++)
+        {
+            if (block_arr[b]->id >= 0)
+                index_of_id[block_arr[b]->id] = b;
+        }
+
+        int n = 0;
+        for (int b = 0; b < bc; b++)
+        {
+            MachineBlock *mb = block_arr[b];
+            for (int s = 0; s < mb->succ_count; s++)
+            {
+                MachineBlock *succ = mb->succs[s];
+                if (!succ || succ->id < 0 || succ->id > max_id || index_of_id[succ->id] < 0)
+                    continue;
+                int j = index_of_id[succ->id];
+                g->succs[n++] = j;
+                g->pred_start[j + 1]++;
+            }
+            g->succ_start[b + 1] = n;
+        }
+        for (int b = 0; b < bc; b++)
+            g->pred_start[b + 1] += g->pred_start[b];
+        memcpy(fill, g->pred_start, (size_t)bc * sizeof(int));
+        for (int b = 0; b < bc; b++)
+        {
+            for (int k = g->succ_start[b]; k < g->succ_start[b + 1]; k++)
+                g->preds[fill[g->succs[k]]++] = b;
+        }
+    }
+
+    free(index_of_id);
+    free(fill);
+    if (!ok)
+        liveness_graph_free(g);
+    return ok;
+}
+
+/**
+ * @brief ترتيب الكتل بعد الزيارة (post-order) من كتلة الدخول.
+ *
+ * هذا عكس RPO، وهو الترتيب المناسب لمسألة خلفية كالحيوية: يُعالج الخلف قبل
+ * سلفه فتتقارب الحلقات في مرور أو اثنين. الكتل غير المبلوغة تُلحق بعد ذلك.
+ */
+static bool liveness_post_order(const LivenessGraph *g, int bc, int *order)
+{
+    bool *seen = calloc((size_t)bc, sizeof(bool));
+    int *stack = malloc((size_t)bc * sizeof(int));
+    int *next_succ = malloc((size_t)bc * sizeof(int));
+    if (!seen || !stack || !next_succ)
+    {
+        free(seen);
+        free(stack);
+        free(next_succ);
+        return false;
+    }
+
+    int n = 0;
+    for (int root = 0; root < bc; root++)
+    {
+        if (seen[root])
+            continue;
+        int sp = 0;
+        stack[sp++] = root;
+        seen[root] = true;
+        next_succ[root] = g->succ_start[root];
+        while (sp > 0)
+        {
+            int b = stack[sp - 1];
+            if (next_succ[b] < g->succ_start[b + 1])
+            {
+                int s = g->succs[next_succ[b]++];
+                if (!seen[s])
+                {
+                    seen[s] = true;
+                    next_succ[s] = g->succ_start[s];
+                    stack[sp++] = s;
+                }
+                continue;
+            }
+            order[n++] = b;
+            sp--;
+        }
+    }
+
+    free(seen);
+    free(stack);
+    free(next_succ);
+    return true;
+}
+
 void regalloc_compute_liveness(RegAllocCtx *ctx)
 {
     if (!ctx || !ctx->block_live)
@@ -9,80 +145,86 @@ void regalloc_compute_liveness(RegAllocCtx *ctx)
 
     int words = ctx->bitset_words;
     int bc = ctx->block_count;
+    if (bc <= 0)
+        return;
 
     // نحتاج مصفوفة مؤقتة للحسابات
     uint64_t *temp = bitset_alloc(words);
-    if (!temp)
-        return;
-
-    // بناء خريطة block_id → فهرس في block_live
-    // وخريطة الكتل الآلية
     MachineBlock **block_arr = malloc(bc * sizeof(MachineBlock *));
-    if (!block_arr)
-    {
-        free(temp);
-        return;
-    }
+    int *queue = malloc((size_t)bc * sizeof(int));
+    bool *queued = calloc((size_t)bc, sizeof(bool));
+    LivenessGraph g;
+    memset(&g, 0, sizeof(g));
+    if (!temp || !block_arr || !queue || !queued)
+        goto done;
 
     int bi = 0;
-    for (MachineBlock *b = ctx->func->blocks; b; b = b->next)
+    for (MachineBlock *b = ctx->func->blocks; b && bi < bc; b = b->next)
+        block_arr[bi++] = b;
+    for (; bi < bc; bi++)
+        block_arr[bi] = NULL;
+    for (int b = 0; b < bc; b++)
     {
-        if (bi < bc)
-            block_arr[bi] = b;
-        bi++;
+        if (!block_arr[b])
+            goto done;
     }
 
-    // التكرار حتى الثبات (fixpoint)
-    bool changed = true;
-    int iterations = 0;
-    while (changed && iterations < 100)
-    {
-        changed = false;
-        iterations++;
+    if (!liveness_graph_build(&g, block_arr, bc) || !liveness_post_order(&g, bc, queue))
+        goto done;
 
-        // المشي على الكتل بترتيب عكسي (أفضل للتقارب)
-        for (int i = bc - 1; i >= 0; i--)
-        {
-            BlockLiveness *bl = &ctx->block_live[i];
-            MachineBlock *mb = block_arr[i];
+    // قائمة عمل دائرية تبدأ بكل الكتل بترتيب ما بعد الزيارة؛ كل كتلة تظهر
+    // فيها مرة على الأكثر، ولا تعود إليها إلا إذا تغيّر live_in لأحد خلفائها.
+    for (int b = 0; b < bc; b++)
+        queued[b] = true;
+    int head = 0;
+    int pending = bc;
+    while (pending > 0)
+    {
+        int i = queue[head];
+        head = head + 1 == bc ? 0 : head + 1;
+        pending--;
+        queued[i] = false;
 
-            // live_out = اتحاد live_in لكل خلف
-            for (int s = 0; s < mb->succ_count; s++)
-            {
-                MachineBlock *succ = mb->succs[s];
-                if (!succ)
-                    continue;
+        BlockLiveness *bl = &ctx->block_live[i];
 
-                // إيجاد فهرس الخلف في المصفوفة
-                for (int j = 0; j < bc; j++)
-                {
-                    if (block_arr[j] == succ)
-                    {
-                        changed |= bitset_union(bl->live_out,
-                                                ctx->block_live[j].live_in, words);
-                        break;
-                    }
-                }
-            }
+        // live_out = اتحاد live_in لكل خلف
+        for (int k = g.succ_start[i]; k < g.succ_start[i + 1]; k++)
+            bitset_union(bl->live_out, ctx->block_live[g.succs[k]].live_in, words);
 
-            // live_in = use ∪ (live_out - def)
-            bitset_diff(temp, bl->live_out, bl->def, words);
-            bitset_union(temp, bl->use, words);
+        // live_in = use ∪ (live_out - def)
+        bitset_diff(temp, bl->live_out, bl->def, words);
+        bitset_union(temp, bl->use, words);
 
-            // التحقق من التغيير
-            for (int w = 0; w < words; w++)
+        bool changed = false;
+        for (int w = 0; w < words; w++)
+        {
+            if (bl->live_in[w] != temp[w])
             {
-                if (bl->live_in[w] != temp[w])
-                {
-                    changed = true;
-                    bl->live_in[w] = temp[w];
-                }
+                changed = true;
+                bl->live_in[w] = temp[w];
             }
         }
+        if (!changed)
+            continue;
+
+        for (int k = g.pred_start[i]; k < g.pred_start[i + 1]; k++)
+        {
+            int p = g.preds[k];
+            if (queued[p])
+                continue;
+            queued[p] = true;
+            int tail = head + pending;
+            queue[tail >= bc ? tail - bc : tail] = p;
+            pending++;
+        }
     }
 
+done:
+    liveness_graph_free(&g);
     free(temp);
     free(block_arr);
+    free(queue);
+    free(queued);
 }
 
 // ============================================================================
@@ -91,23 +233,24 @@ void regalloc_compute_liveness(RegAllocCtx *ctx)
 
 /**
  * @brief إضافة أو تحديث فترة حيوية لسجل افتراضي.
+ *
+ * interval_of يربط كل vreg بفهرس فترته (-1 قبل أول ظهور) فلا يُبحث في كل
+ * الفترات عند كل معامل.
  */
-static void update_interval(RegAllocCtx *ctx, int vreg, int pos)
+static void update_interval(RegAllocCtx *ctx, int *interval_of, int vreg, int pos)
 {
     if (vreg < 0 || vreg >= ctx->max_vreg)
         return;
 
     // البحث عن فترة موجودة
-    for (int i = 0; i < ctx->interval_count; i++)
+    int idx = interval_of[vreg];
+    if (idx >= 0)
     {
-        if (ctx->intervals[i].vreg == vreg)
-        {
-            if (pos < ctx->intervals[i].start)
-                ctx->intervals[i].start = pos;
-            if (pos > ctx->intervals[i].end)
-                ctx->intervals[i].end = pos;
-            return;
-        }
+        if (pos < ctx->intervals[idx].start)
+            ctx->intervals[idx].start = pos;
+        if (pos > ctx->intervals[idx].end)
+            ctx->intervals[idx].end = pos;
+        return;
     }
 
     // إنشاء فترة جديدة
@@ -121,6 +264,7 @@ static void update_interval(RegAllocCtx *ctx, int vreg, int pos)
         ctx->interval_capacity = new_cap;
     }
 
+    interval_of[vreg] = ctx->interval_count;
     LiveInterval *li = &ctx->intervals[ctx->interval_count++];
     li->vreg = vreg;
     li->start = pos;
@@ -130,11 +274,34 @@ static void update_interval(RegAllocCtx *ctx, int vreg, int pos)
     li->spill_offset = 0;
 }
 
+/**
+ * @brief تحديث فترة كل سجل في مجموعة بتات (بالمرور على البتات المضبوطة فقط).
+ */
+static void update_intervals_from_set(RegAllocCtx *ctx, int *interval_of, const uint64_t *set, int pos)
+{
+    for (int w = 0; w < ctx->bitset_words; w++)
+    {
+        uint64_t bits = set[w];
+        while (bits)
+        {
+            int v = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            update_interval(ctx, interval_of, v, pos);
+        }
+    }
+}
+
 void regalloc_build_intervals(RegAllocCtx *ctx)
 {
     if (!ctx || !ctx->func)
         return;
 
+    int *interval_of = malloc((size_t)ctx->max_vreg * sizeof(int));
+    if (!interval_of)
+        return;
+    for (int v = 0; v < ctx->max_vreg; v++)
+        interval_of[v] = -1;
+
     // المشي على كل تعليمة بترتيب تسلسلي
     int pos = 0;
     int block_idx = 0;
@@ -142,52 +309,35 @@ void regalloc_build_intervals(RegAllocCtx *ctx)
     {
         // السجلات الحية عند دخول الكتلة تبدأ فتراتها هنا
         if (block_idx < ctx->block_count && ctx->block_live)
-        {
-            BlockLiveness *bl = &ctx->block_live[block_idx];
-            for (int v = 0; v < ctx->max_vreg; v++)
-            {
-                if (bitset_test(bl->live_in, v))
-                {
-                    update_interval(ctx, v, pos);
-                }
-            }
-        }
+            update_intervals_from_set(ctx, interval_of, ctx->block_live[block_idx].live_in, pos);
 
         for (MachineInst *inst = block->first; inst; inst = inst->next)
         {
             // تسجيل الاستخدامات
             if (is_normal_vreg(&inst->src1))
-                update_interval(ctx, inst->src1.data.vreg, pos);
+                update_interval(ctx, interval_of, inst->src1.data.vreg, pos);
             if (is_normal_vreg(&inst->src2))
-                update_interval(ctx, inst->src2.data.vreg, pos);
+                update_interval(ctx, interval_of, inst->src2.data.vreg, pos);
             if (inst->src1.kind == MACH_OP_MEM && mem_base_vreg(&inst->src1) >= 0)
-                update_interval(ctx, mem_base_vreg(&inst->src1), pos);
+                update_interval(ctx, interval_of, mem_base_vreg(&inst->src1), pos);
             if (inst->src2.kind == MACH_OP_MEM && mem_base_vreg(&inst->src2) >= 0)
-                update_interval(ctx, mem_base_vreg(&inst->src2), pos);
+                update_interval(ctx, interval_of, mem_base_vreg(&inst->src2), pos);
             if (inst->dst.kind == MACH_OP_MEM && mem_base_vreg(&inst->dst) >= 0)
-                update_interval(ctx, mem_base_vreg(&inst->dst), pos);
+                update_interval(ctx, interval_of, mem_base_vreg(&inst->dst), pos);
 
             // تسجيل التعريف
             if (is_normal_vreg(&inst->dst))
-                update_interval(ctx, inst->dst.data.vreg, pos);
+                update_interval(ctx, interval_of, inst->dst.data.vreg, pos);
 
             pos++;
         }
 
         // السجلات الحية عند خروج الكتلة تمتد فتراتها إلى هنا
         if (block_idx < ctx->block_count && ctx->block_live)
-        {
-            BlockLiveness *bl = &ctx->block_live[block_idx];
-            for (int v = 0; v < ctx->max_vreg; v++)
-            {
-                if (bitset_test(bl->live_out, v))
-                {
-                    update_interval(ctx, v, pos - 1);
-                }
-            }
-        }
+            update_intervals_from_set(ctx, interval_of, ctx->block_live[block_idx].live_out, pos - 1);
 
         block_idx++;
     }
-}
 
+    free(interval_of);
+}
@@ -68,6 +68,37 @@ static PhysReg resolve_special_vreg_with_cc(int vreg, const BaaCallingConv* cc)
     return PHYS_NONE;
 }
 
+// ============================================================================
+// إحصاءات التسريب (Spill Statistics)
+// ============================================================================
+
+/**
+ * @brief وزن موقع في حلقة بعمق depth: 10^depth حتى 10^6.
+ */
+static int64_t regalloc_depth_weight(int depth)
+{
+    int64_t w = 1;
+    if (depth > 6)
+        depth = 6;
+    for (int i = 0; i < depth; i++)
+        w *= 10;
+    return w;
+}
+
+/**
+ * @brief تسجيل وصول واحد إلى خانة تسريب (كتابة أو قراءة).
+ */
+static void regalloc_stats_note(RegAllocCtx *ctx, bool is_store, int loop_depth)
+{
+    if (!ctx)
+        return;
+    if (is_store)
+        ctx->stats.spill_stores++;
+    else
+        ctx->stats.reloads++;
+    ctx->stats.weighted_cost += regalloc_depth_weight(loop_depth);
+}
+
 // ============================================================================
 // إعادة كتابة المعاملات (Operand Rewrite)
 // ============================================================================
@@ -78,7 +109,7 @@ static PhysReg resolve_special_vreg_with_cc(int vreg, const BaaCallingConv* cc)
  * يحوّل MACH_OP_VREG إلى سجل فيزيائي، أو إذا كان مسرّباً
  * يحوّله إلى معامل ذاكرة [RBP + offset].
  */
-static void rewrite_operand(RegAllocCtx *ctx, MachineOperand *op)
+static void rewrite_operand(RegAllocCtx *ctx, MachineOperand *op, bool is_def, int loop_depth)
 {
     if (!op)
         return;
@@ -106,6 +137,7 @@ static void rewrite_operand(RegAllocCtx *ctx, MachineOperand *op)
             if (ctx->vreg_spilled[vreg])
             {
                 // السجل مسرّب: تحويل إلى معامل ذاكرة
+                regalloc_stats_note(ctx, is_def, loop_depth);
                 op->kind = MACH_OP_MEM;
                 op->data.mem.base_vreg = PHYS_RBP;
                 op->data.mem.offset = ctx->vreg_spill_offset[vreg];
@@ -148,9 +180,9 @@ void regalloc_rewrite(RegAllocCtx *ctx)
     {
         for (MachineInst *inst = block->first; inst; inst = inst->next)
         {
-            rewrite_operand(ctx, &inst->dst);
-            rewrite_operand(ctx, &inst->src1);
-            rewrite_operand(ctx, &inst->src2);
+            rewrite_operand(ctx, &inst->dst, true, block->loop_depth);
+            rewrite_operand(ctx, &inst->src1, false, block->loop_depth);
+            rewrite_operand(ctx, &inst->src2, false, block->loop_depth);
         }
     }
 }
@@ -201,6 +233,65 @@ static void regalloc_fix_mem_base_operand(RegAllocCtx* ctx,
 
     mach_block_insert_before_local(block, pos, reload);
     op->data.mem.base_vreg = REGALLOC_VREG_SCRATCH_BASE;
+    regalloc_stats_note(ctx, false, block->loop_depth);
+
+    if (io_used_scratch) *io_used_scratch = 1;
+}
+
+static void mach_block_insert_after_local(MachineBlock* block, MachineInst* pos, MachineInst* inst)
+{
+    if (!block || !pos || !inst) return;
+
+    inst->prev = pos;
+    inst->next = pos->next;
+
+    if (pos->next) pos->next->prev = inst;
+    else block->last = inst;
+
+    pos->next = inst;
+    block->inst_count++;
+}
+
+/**
+ * @brief وجهة imul/cvttsd2si لا تقبل ذاكرة: إن سُرِّبت، نمرّ عبر R11.
+ *
+ * imul ثنائي العنوان يقرأ وجهته أيضاً، فنعيد تحميلها قبل التعليمة؛
+ * ثم نخزّن النتيجة في خانة التسريب بعدها.
+ */
+static void regalloc_fix_reg_only_dst(RegAllocCtx* ctx,
+                                      MachineBlock* block,
+                                      MachineInst* inst,
+                                      int* io_used_scratch)
+{
+    if (!ctx || !block || !inst) return;
+    if (inst->op != MACH_IMUL && inst->op != MACH_CVTTSD2SI) return;
+    if (inst->dst.kind != MACH_OP_VREG) return;
+
+    int v = inst->dst.data.vreg;
+    if (v < 0 || v >= ctx->max_vreg || !ctx->vreg_spilled[v]) return;
+    if (io_used_scratch && *io_used_scratch) return;
+
+    int bits = inst->dst.size_bits > 0 ? inst->dst.size_bits : 64;
+    int32_t spill_off = (int32_t)ctx->vreg_spill_offset[v];
+    MachineOperand scratch = mach_op_vreg(REGALLOC_VREG_SCRATCH_BASE, bits);
+
+    if (inst->op == MACH_IMUL)
+    {
+        MachineInst* reload = mach_inst_new(MACH_LOAD, scratch, mach_op_mem(-1, spill_off, bits), mach_op_none());
+        if (!reload) return;
+        reload->comment = "// إعادة تحميل وجهة imul مسرّبة";
+        mach_block_insert_before_local(block, inst, reload);
+        regalloc_stats_note(ctx, false, block->loop_depth);
+    }
+
+    MachineInst* store = mach_inst_new(MACH_STORE, mach_op_mem(-1, spill_off, bits), scratch, mach_op_none());
+    if (!store) return;
+    mach_block_insert_after_local(block, inst, store);
+    regalloc_stats_note(ctx, true, block->loop_depth);
+
+    if (inst->src1.kind == MACH_OP_VREG && inst->src1.data.vreg == v) inst->src1.data.vreg = REGALLOC_VREG_SCRATCH_BASE;
+    if (inst->src2.kind == MACH_OP_VREG && inst->src2.data.vreg == v) inst->src2.data.vreg = REGALLOC_VREG_SCRATCH_BASE;
+    inst->dst.data.vreg = REGALLOC_VREG_SCRATCH_BASE;
 
     if (io_used_scratch) *io_used_scratch = 1;
 }
@@ -226,6 +317,7 @@ void regalloc_insert_spill_code(RegAllocCtx *ctx)
         for (MachineInst *inst = block->first; inst; inst = inst->next)
         {
             int used_scratch = 0;
+            regalloc_fix_reg_only_dst(ctx, block, inst, &used_scratch);
             regalloc_fix_mem_base_operand(ctx, block, inst, &inst->dst, &used_scratch);
             regalloc_fix_mem_base_operand(ctx, block, inst, &inst->src1, &used_scratch);
             regalloc_fix_mem_base_operand(ctx, block, inst, &inst->src2, &used_scratch);
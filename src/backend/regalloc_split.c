@@ -0,0 +1,963 @@
+// ============================================================================
+// المخصص المقسِّم (Live-Range Splitting Allocator)
+// ============================================================================
+//
+// بديل للمسح الخطي يُختار بـ --regalloc=split:
+// - المواقع: التعليمة رقم i تقرأ معاملاتها عند 2i وتكتب وجهتها عند 2i+1.
+// - لكل vreg قائمة مدى [from, to) بفجوات، مبنية بالمشي العكسي على الكتل.
+// - عند نفاد السجلات تُقسم الفترة بدل تسريبها كاملة: الجزء المسرّب يبقى في
+//   خانة المكدس ويعود الباقي إلى قائمة الانتظار عند الاستخدام التالي.
+// - موضع التقسيم يُفضّل بداية الكتلة الأقل عمقاً في الحلقات، والضحية هي
+//   صاحبة أقل وزن (استخدامات × 10^عمق الحلقة لكل تعليمة).
+// - النداء مدى ثابت على السجلات المؤقتة (caller-saved) عند 2i+1، فتُقسم
+//   الفترة العابرة للنداء حوله بدل منعها من تلك السجلات طوال عمرها.
+//
+// كل أجزاء vreg واحد تتشارك خانة مكدس واحدة. لا تُعدّل الدالة الآلية قبل
+// نجاح التخصيص كاملاً؛ عند الفشل يعود regalloc_func_ex إلى المسح الخطي.
+
+#define SPLIT_POS_MAX INT_MAX
+#define SPLIT_WEIGHT_MAX_USES 64
+
+typedef struct
+{
+    int from; // أول موقع حي
+    int to;   // أول موقع بعد المدى (غير مشمول)
+} SplitRange;
+
+typedef struct
+{
+    int pos;
+    bool must_reg; // المعامل لا يقبل ذاكرة (قاعدة عنوان، وجهة imul، ...)
+} SplitUse;
+
+typedef struct
+{
+    int vreg;
+    SplitRange *ranges; // مرتبة تصاعدياً ومنفصلة
+    int range_count;
+    int range_cap;
+    SplitUse *uses; // مرتبة تصاعدياً
+    int use_count;
+    int use_cap;
+    PhysReg reg;
+    bool on_stack;
+    int next;         // الجزء التالي من نفس vreg (-1 للأخير)
+    int range_cursor; // أول مدى قد يغطي الموقع الحالي (يتقدم فقط)
+} SplitInterval;
+
+typedef struct
+{
+    RegAllocCtx *ra;
+    const BaaCallingConv *cc;
+
+    // الكتل بترتيب الدالة ومواقعها [from, to)
+    MachineBlock **blocks;
+    int *block_from;
+    int *block_to;
+    int *inst_block; // رقم التعليمة → فهرس الكتلة
+
+    SplitInterval *iv;
+    int iv_count;
+    int iv_cap;
+    int *head; // vreg → أول جزء (-1)
+    int *slot; // vreg → إزاحة خانة التسريب (0 = لا خانة)
+    int *copy_start; // vreg → أول نسخة له في copies (max_vreg + 1 مدخلاً)
+    int *copies;     // أرقام تعليمات mov بين سجلين افتراضيين، مجمعة لكل طرف
+
+    // مديات النداءات على كل سجل مؤقت قابل للتخصيص
+    SplitRange *fixed[PHYS_REG_COUNT];
+    int fixed_count[PHYS_REG_COUNT];
+    bool allocable[PHYS_REG_COUNT];
+
+    int *heap; // الفترات المنتظرة مرتبة ببدايتها
+    int heap_count;
+    int heap_cap;
+    int *active; // تغطي الموقع الحالي (سجل مختلف لكل منها)
+    int active_count;
+    int active_cap;
+    int *inactive; // في فجوة عند الموقع الحالي
+    int inactive_count;
+    int inactive_cap;
+
+    int position; // بداية الفترة الجاري تخصيصها
+    bool failed;
+} SplitCtx;
+
+static int split_start(const SplitInterval *it)
+{
+    return it->range_count > 0 ? it->ranges[0].from : SPLIT_POS_MAX;
+}
+
+static int split_end(const SplitInterval *it)
+{
+    return it->range_count > 0 ? it->ranges[it->range_count - 1].to : 0;
+}
+
+static bool split_grow(void **arr, int *cap, int need, size_t elem)
+{
+    if (need <= *cap)
+        return true;
+    int new_cap = *cap ? *cap * 2 : 4;
+    while (new_cap < need)
+        new_cap *= 2;
+    void *grown = realloc(*arr, (size_t)new_cap * elem);
+    if (!grown)
+        return false;
+    *arr = grown;
+    *cap = new_cap;
+    return true;
+}
+
+static int split_iv_new(SplitCtx *sc, int vreg)
+{
+    if (!split_grow((void **)&sc->iv, &sc->iv_cap, sc->iv_count + 1, sizeof(SplitInterval)))
+    {
+        sc->failed = true;
+        return -1;
+    }
+    SplitInterval *it = &sc->iv[sc->iv_count];
+    memset(it, 0, sizeof(*it));
+    it->vreg = vreg;
+    it->reg = PHYS_NONE;
+    it->next = -1;
+    return sc->iv_count++;
+}
+
+// ============================================================================
+// بناء الفترات (Interval Construction)
+// ============================================================================
+
+/**
+ * @brief إضافة مدى أثناء البناء العكسي (المديات مخزنة من الأحدث إلى الأقدم).
+ */
+static void split_add_range(SplitCtx *sc, int vreg, int from, int to)
+{
+    if (vreg < 0 || vreg >= sc->ra->max_vreg)
+        return;
+    if (sc->head[vreg] < 0)
+    {
+        sc->head[vreg] = split_iv_new(sc, vreg);
+        if (sc->head[vreg] < 0)
+            return;
+    }
+    SplitInterval *it = &sc->iv[sc->head[vreg]];
+    if (it->range_count > 0)
+    {
+        SplitRange *first = &it->ranges[it->range_count - 1];
+        if (to >= first->from)
+        {
+            if (from < first->from)
+                first->from = from;
+            if (to > first->to)
+                first->to = to;
+            return;
+        }
+    }
+    if (!split_grow((void **)&it->ranges, &it->range_cap, it->range_count + 1, sizeof(SplitRange)))
+    {
+        sc->failed = true;
+        return;
+    }
+    it->ranges[it->range_count].from = from;
+    it->ranges[it->range_count].to = to;
+    it->range_count++;
+}
+
+/**
+ * @brief تقصير المدى الحالي ليبدأ عند التعريف (أو مدى قصير لتعريف ميت).
+ */
+static void split_add_def(SplitCtx *sc, int vreg, int pos)
+{
+    if (vreg < 0 || vreg >= sc->ra->max_vreg)
+        return;
+    int h = sc->head[vreg];
+    if (h >= 0 && sc->iv[h].range_count > 0)
+    {
+        SplitRange *first = &sc->iv[h].ranges[sc->iv[h].range_count - 1];
+        if (first->from <= pos && pos < first->to)
+        {
+            first->from = pos;
+            return;
+        }
+    }
+    split_add_range(sc, vreg, pos, pos + 1);
+}
+
+static void split_add_use(SplitCtx *sc, int vreg, int pos, bool must_reg)
+{
+    if (vreg < 0 || vreg >= sc->ra->max_vreg || sc->head[vreg] < 0)
+        return;
+    SplitInterval *it = &sc->iv[sc->head[vreg]];
+    if (!split_grow((void **)&it->uses, &it->use_cap, it->use_count + 1, sizeof(SplitUse)))
+    {
+        sc->failed = true;
+        return;
+    }
+    it->uses[it->use_count].pos = pos;
+    it->uses[it->use_count].must_reg = must_reg;
+    it->use_count++;
+}
+
+static bool split_is_two_address(MachineOp op)
+{
+    return op == MACH_ADD || op == MACH_SUB || op == MACH_IMUL || op == MACH_SHL ||
+           op == MACH_SHR || op == MACH_SAR || op == MACH_AND || op == MACH_OR ||
+           op == MACH_XOR || op == MACH_NEG || op == MACH_NOT;
+}
+
+/**
+ * @brief استخدام معامل مصدر: vreg أو قاعدة ذاكرة (القاعدة تحتاج سجلاً دائماً).
+ */
+static void split_add_operand_use(SplitCtx *sc, const MachineOperand *op, int block_from,
+                                  int pos, int range_end, bool must_reg)
+{
+    int v = -1;
+    if (op->kind == MACH_OP_VREG && op->data.vreg >= 0)
+        v = op->data.vreg;
+    else if (op->kind == MACH_OP_MEM && op->data.mem.base_vreg >= 0)
+    {
+        v = op->data.mem.base_vreg;
+        must_reg = true;
+    }
+    if (v < 0)
+        return;
+    split_add_range(sc, v, block_from, range_end);
+    split_add_use(sc, v, pos, must_reg);
+}
+
+static bool split_build_intervals(SplitCtx *sc)
+{
+    RegAllocCtx *ra = sc->ra;
+    int call_count = 0;
+    for (int i = 0; i < ra->total_insts; i++)
+    {
+        if (ra->inst_map[i]->op == MACH_CALL)
+            call_count++;
+    }
+    for (int r = 0; r < PHYS_REG_COUNT; r++)
+    {
+        if (!sc->allocable[r] || !reg_is_caller_saved_cc(sc->cc, (PhysReg)r) || call_count == 0)
+            continue;
+        sc->fixed[r] = malloc((size_t)call_count * sizeof(SplitRange));
+        if (!sc->fixed[r])
+            return false;
+        for (int i = 0; i < ra->total_insts; i++)
+        {
+            if (ra->inst_map[i]->op != MACH_CALL)
+                continue;
+            sc->fixed[r][sc->fixed_count[r]].from = 2 * i + 1;
+            sc->fixed[r][sc->fixed_count[r]].to = 2 * i + 2;
+            sc->fixed_count[r]++;
+        }
+    }
+
+    for (int b = ra->block_count - 1; b >= 0; b--)
+    {
+        int from = sc->block_from[b];
+        int to = sc->block_to[b];
+        if (from >= to)
+            continue;
+
+        const uint64_t *live_out = ra->block_live[b].live_out;
+        for (int w = 0; w < ra->bitset_words; w++)
+        {
+            uint64_t bits = live_out[w];
+            while (bits)
+            {
+                int v = w * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                split_add_range(sc, v, from, to);
+            }
+        }
+
+        for (int i = to / 2 - 1; i >= from / 2; i--)
+        {
+            MachineInst *inst = ra->inst_map[i];
+            int use_pos = 2 * i;
+            int def_pos = 2 * i + 1;
+
+            // وجهة imul وcvttsd2si لا تقبل ذاكرة؛ ومصدر imul هو وجهته نفسها.
+            bool dst_must = inst->op == MACH_IMUL || inst->op == MACH_CVTTSD2SI;
+            if (inst->dst.kind == MACH_OP_VREG && inst->dst.data.vreg >= 0)
+            {
+                split_add_def(sc, inst->dst.data.vreg, def_pos);
+                split_add_use(sc, inst->dst.data.vreg, def_pos, dst_must);
+            }
+            bool src1_must = inst->op == MACH_CVTSI2SD ||
+                             (dst_must && split_is_two_address(inst->op));
+
+            // مصادر النداء تنتهي قبل مدى النداء الثابت، ومصدر النسخة قبل
+            // وجهتها فيمكن أن يتشاركا السجل؛ غيرها يبقى حياً حتى نهاية التعليمة
+            // فلا تشارك الوجهة سجلها.
+            int copy_dst = -1;
+            int copy_src = -1;
+            bool ends_early = inst->op == MACH_CALL ||
+                              regalloc_copy_inst(ra, i, &copy_dst, &copy_src);
+            int range_end = ends_early ? def_pos : def_pos + 1;
+            split_add_operand_use(sc, &inst->src1, from, use_pos, range_end, src1_must);
+            split_add_operand_use(sc, &inst->src2, from, use_pos, range_end, false);
+            if (inst->dst.kind == MACH_OP_MEM)
+                split_add_operand_use(sc, &inst->dst, from, use_pos, range_end, true);
+            if (sc->failed)
+                return false;
+        }
+    }
+
+    // المديات والاستخدامات بُنيت عكسياً.
+    for (int k = 0; k < sc->iv_count; k++)
+    {
+        SplitInterval *it = &sc->iv[k];
+        for (int a = 0, z = it->range_count - 1; a < z; a++, z--)
+        {
+            SplitRange t = it->ranges[a];
+            it->ranges[a] = it->ranges[z];
+            it->ranges[z] = t;
+        }
+        for (int a = 0, z = it->use_count - 1; a < z; a++, z--)
+        {
+            SplitUse t = it->uses[a];
+            it->uses[a] = it->uses[z];
+            it->uses[z] = t;
+        }
+    }
+    ra->stats.vregs = sc->iv_count;
+    return !sc->failed;
+}
+
+// ============================================================================
+// استعلامات الفترات (Interval Queries)
+// ============================================================================
+
+/**
+ * @brief هل تغطي الفترة الموقع pos؟ (الموقع لا يتناقص بين الاستدعاءات)
+ */
+static bool split_covers_forward(SplitInterval *it, int pos)
+{
+    while (it->range_cursor < it->range_count && it->ranges[it->range_cursor].to <= pos)
+        it->range_cursor++;
+    return it->range_cursor < it->range_count && it->ranges[it->range_cursor].from <= pos;
+}
+
+/**
+ * @brief أول موقع تتقاطع فيه الفترتان بدءاً من pos، أو -1.
+ */
+static int split_intersect(const SplitInterval *a, const SplitRange *b, int b_count, int pos)
+{
+    int i = a->range_cursor;
+    int j = 0;
+    while (i < a->range_count && j < b_count)
+    {
+        int lo = a->ranges[i].from > b[j].from ? a->ranges[i].from : b[j].from;
+        int hi = a->ranges[i].to < b[j].to ? a->ranges[i].to : b[j].to;
+        if (lo < pos)
+            lo = pos;
+        if (lo < hi)
+            return lo;
+        if (a->ranges[i].to <= b[j].to)
+            i++;
+        else
+            j++;
+    }
+    return -1;
+}
+
+/**
+ * @brief أول تقاطع للفترة مع نداءات السجل r (بحث ثنائي في المديات الثابتة).
+ */
+static int split_fixed_intersect(const SplitCtx *sc, int r, const SplitInterval *cur)
+{
+    const SplitRange *f = sc->fixed[r];
+    int n = sc->fixed_count[r];
+    if (!f || n == 0)
+        return -1;
+    for (int k = 0; k < cur->range_count; k++)
+    {
+        int lo = 0;
+        int hi = n;
+        while (lo < hi)
+        {
+            int mid = (lo + hi) / 2;
+            if (f[mid].to <= cur->ranges[k].from)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < n && f[lo].from < cur->ranges[k].to)
+            return f[lo].from > cur->ranges[k].from ? f[lo].from : cur->ranges[k].from;
+    }
+    return -1;
+}
+
+/**
+ * @brief أول استخدام عند pos أو بعده، أو NULL.
+ */
+static const SplitUse *split_next_use(const SplitInterval *it, int pos)
+{
+    int lo = 0;
+    int hi = it->use_count;
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+        if (it->uses[mid].pos < pos)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo < it->use_count ? &it->uses[lo] : NULL;
+}
+
+/**
+ * @brief كلفة تسريب الفترة من pos فصاعداً: مجموع أوزان الاستخدامات لكل تعليمة.
+ */
+static int64_t split_weight_from(const SplitCtx *sc, const SplitInterval *it, int pos)
+{
+    const SplitUse *u = split_next_use(it, pos);
+    if (!u)
+        return 0;
+    int64_t sum = 0;
+    int seen = 0;
+    int last = pos;
+    for (; u < it->uses + it->use_count && seen < SPLIT_WEIGHT_MAX_USES; u++, seen++)
+    {
+        int b = sc->inst_block[u->pos / 2];
+        sum += regalloc_depth_weight(sc->blocks[b]->loop_depth);
+        last = u->pos;
+    }
+    return sum * 1024 / ((last - pos) / 2 + 1);
+}
+
+/**
+ * @brief موضع تقسيم زوجي في (lo, hi]؛ يُفضّل بداية كتلة أقل عمقاً من كتلة hi.
+ *
+ * بين الكتل المتساوية في أقل عمق: الأبعد للتحميل (يبقى المدى في السجل أطول)،
+ * والأقرب للتسريب (earliest) فيقع التقسيم على رأس الحلقة وتخرج النقلة منها
+ * إلى حافة الدخول بدل أن تتكرر في كل دورة.
+ * @return -1 إن لم يوجد موضع صالح.
+ */
+static int split_pick_pos(const SplitCtx *sc, int lo, int hi, bool earliest)
+{
+    int best = hi & ~1;
+    if (best <= lo)
+        return -1;
+    int b_hi = sc->inst_block[(best / 2 < sc->ra->total_insts) ? best / 2 : sc->ra->total_insts - 1];
+    int b_lo = sc->inst_block[lo / 2];
+    int best_depth = sc->blocks[b_hi]->loop_depth;
+    for (int b = b_hi; b > b_lo; b--)
+    {
+        int d = sc->blocks[b]->loop_depth;
+        if ((d < best_depth || (earliest && d == best_depth)) && sc->block_from[b] > lo &&
+            sc->block_from[b] <= hi)
+        {
+            best_depth = d;
+            best = sc->block_from[b];
+        }
+    }
+    return best;
+}
+
+// ============================================================================
+// التقسيم والتسريب (Split & Spill)
+// ============================================================================
+
+/**
+ * @brief تقسيم الفترة عند pos: الأصل يحتفظ بما قبل pos والجزء الجديد بالباقي.
+ * @return فهرس الجزء الجديد، أو -1 إن كان pos خارج (start, end).
+ */
+static int split_at(SplitCtx *sc, int idx, int pos)
+{
+    if (pos <= split_start(&sc->iv[idx]) || pos >= split_end(&sc->iv[idx]))
+        return -1;
+    int n = split_iv_new(sc, sc->iv[idx].vreg);
+    if (n < 0)
+        return -1;
+    SplitInterval *it = &sc->iv[idx];
+    SplitInterval *ch = &sc->iv[n];
+
+    int k = 0;
+    while (k < it->range_count && it->ranges[k].to <= pos)
+        k++;
+    bool straddle = it->ranges[k].from < pos;
+    int moved = it->range_count - k;
+    int u = (int)(split_next_use(it, pos) ? split_next_use(it, pos) - it->uses : it->use_count);
+    int moved_uses = it->use_count - u;
+    if (!split_grow((void **)&ch->ranges, &ch->range_cap, moved, sizeof(SplitRange)) ||
+        (moved_uses > 0 &&
+         !split_grow((void **)&ch->uses, &ch->use_cap, moved_uses, sizeof(SplitUse))))
+    {
+        sc->failed = true;
+        return -1;
+    }
+    memcpy(ch->ranges, it->ranges + k, (size_t)moved * sizeof(SplitRange));
+    ch->range_count = moved;
+    if (straddle)
+    {
+        ch->ranges[0].from = pos;
+        it->ranges[k].to = pos;
+        it->range_count = k + 1;
+    }
+    else
+    {
+        it->range_count = k;
+    }
+    if (moved_uses > 0)
+        memcpy(ch->uses, it->uses + u, (size_t)moved_uses * sizeof(SplitUse));
+    ch->use_count = moved_uses;
+    it->use_count = u;
+    if (it->range_cursor > it->range_count)
+        it->range_cursor = it->range_count;
+
+    ch->next = it->next;
+    it->next = n;
+    sc->ra->stats.splits++;
+    return n;
+}
+
+static void split_assign_stack(SplitCtx *sc, int idx)
+{
+    SplitInterval *it = &sc->iv[idx];
+    it->on_stack = true;
+    it->reg = PHYS_NONE;
+    if (sc->slot[it->vreg] == 0)
+    {
+        sc->ra->next_spill_offset += 8;
+        sc->slot[it->vreg] = -(int)sc->ra->next_spill_offset;
+        sc->ra->stats.spilled_vregs++;
+    }
+}
+
+static void split_heap_push(SplitCtx *sc, int idx)
+{
+    if (idx < 0)
+        return;
+    if (!split_grow((void **)&sc->heap, &sc->heap_cap, sc->heap_count + 1, sizeof(int)))
+    {
+        sc->failed = true;
+        return;
+    }
+    int i = sc->heap_count++;
+    int key = split_start(&sc->iv[idx]);
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        int pk = split_start(&sc->iv[sc->heap[parent]]);
+        if (pk < key || (pk == key && sc->heap[parent] < idx))
+            break;
+        sc->heap[i] = sc->heap[parent];
+        i = parent;
+    }
+    sc->heap[i] = idx;
+}
+
+static int split_heap_pop(SplitCtx *sc)
+{
+    int top = sc->heap[0];
+    int last = sc->heap[--sc->heap_count];
+    int key = split_start(&sc->iv[last]);
+    int i = 0;
+    for (;;)
+    {
+        int c = 2 * i + 1;
+        if (c >= sc->heap_count)
+            break;
+        if (c + 1 < sc->heap_count)
+        {
+            int kc = split_start(&sc->iv[sc->heap[c]]);
+            int kd = split_start(&sc->iv[sc->heap[c + 1]]);
+            if (kd < kc || (kd == kc && sc->heap[c + 1] < sc->heap[c]))
+                c++;
+        }
+        int kc = split_start(&sc->iv[sc->heap[c]]);
+        if (key < kc || (key == kc && last < sc->heap[c]))
+            break;
+        sc->heap[i] = sc->heap[c];
+        i = c;
+    }
+    if (sc->heap_count > 0)
+        sc->heap[i] = last;
+    return top;
+}
+
+/**
+ * @brief وضع بداية الفترة في المكدس حتى الاستخدام الذي يستحق سجلاً.
+ *
+ * الاستخدامات غير الإلزامية في التعليمة الحالية تبقى معاملات ذاكرة. الباقي
+ * يعود إلى قائمة الانتظار بموضع لا يسبق الموقع الحالي.
+ */
+static void split_spill_prefix(SplitCtx *sc, int idx)
+{
+    SplitInterval *it = &sc->iv[idx];
+    int start = split_start(it);
+    int now_inst_end = sc->position | 1;
+    const SplitUse *target = NULL;
+    for (const SplitUse *u = split_next_use(it, start); u && u < it->uses + it->use_count; u++)
+    {
+        if (u->must_reg || u->pos > now_inst_end)
+        {
+            target = u;
+            break;
+        }
+    }
+    if (!target)
+    {
+        split_assign_stack(sc, idx);
+        return;
+    }
+    if ((target->pos & ~1) < sc->position)
+    {
+        // استخدام إلزامي في التعليمة الحالية: الفترة كلها تنتظر سجلاً.
+        if (start >= sc->position)
+            split_heap_push(sc, idx);
+        else
+            sc->failed = true;
+        return;
+    }
+    int lo = start > sc->position - 1 ? start : sc->position - 1;
+    int pos = split_pick_pos(sc, lo, target->pos, false);
+    if (pos < 0)
+    {
+        if (start >= sc->position)
+            split_heap_push(sc, idx);
+        else
+            sc->failed = true;
+        return;
+    }
+    int rest = split_at(sc, idx, pos);
+    split_assign_stack(sc, idx);
+    split_heap_push(sc, rest);
+}
+
+/**
+ * @brief سحب سجل من فترة مخصصة: ما بعد آخر استخدام قبل pos يذهب للمكدس.
+ */
+static void split_evict(SplitCtx *sc, int idx, int pos)
+{
+    SplitInterval *it = &sc->iv[idx];
+    if (split_start(it) >= pos)
+    {
+        it->reg = PHYS_NONE;
+        split_spill_prefix(sc, idx);
+        return;
+    }
+    int lo = split_start(it);
+    for (int k = it->use_count - 1; k >= 0; k--)
+    {
+        if (it->uses[k].pos < pos)
+        {
+            lo = it->uses[k].pos > lo ? it->uses[k].pos : lo;
+            break;
+        }
+    }
+    int at = split_pick_pos(sc, lo, pos, true);
+    if (at < 0)
+        at = pos;
+    int rest = split_at(sc, idx, at);
+    if (rest >= 0)
+        split_spill_prefix(sc, rest);
+}
+
+static void split_list_remove(int *list, int *count, int k)
+{
+    list[k] = list[--(*count)];
+}
+
+static void split_list_push(SplitCtx *sc, int **list, int *count, int *cap, int idx)
+{
+    if (!split_grow((void **)list, cap, *count + 1, sizeof(int)))
+    {
+        sc->failed = true;
+        return;
+    }
+    (*list)[(*count)++] = idx;
+}
+
+// ============================================================================
+// حلقة التخصيص (Allocation Loop)
+// ============================================================================
+
+/**
+ * @brief سجل الطرف الآخر لنسخة تلامس cur، إن كان حراً حتى نهايتها.
+ *
+ * الطرف المخصص سابقاً يعطي سجله تلميحاً، فتصير النسخة mov r, r وتُحذف بعد
+ * التخصيص. نسخ الحلقات بعد الخروج من SSA تنحل هكذا لأن فجوات المدى تفصل
+ * قيمة الدورة الحالية عن التالية.
+ */
+static PhysReg split_copy_hint(const SplitCtx *sc, int cur, const int *free_until)
+{
+    const SplitInterval *it = &sc->iv[cur];
+    int v = it->vreg;
+    int from = split_start(it);
+    int to = split_end(it);
+    for (int k = sc->copy_start[v]; k < sc->copy_start[v + 1]; k++)
+    {
+        int i = sc->copies[k];
+        const MachineInst *inst = sc->ra->inst_map[i];
+        bool is_dst = inst->dst.data.vreg == v;
+        int here = is_dst ? 2 * i + 1 : 2 * i;
+        int there = is_dst ? 2 * i : 2 * i + 1;
+        if (here < from || here >= to)
+            continue;
+        int c = sc->head[is_dst ? inst->src1.data.vreg : inst->dst.data.vreg];
+        while (c >= 0 && split_end(&sc->iv[c]) <= there)
+            c = sc->iv[c].next;
+        if (c < 0 || split_start(&sc->iv[c]) > there || sc->iv[c].on_stack)
+            continue;
+        PhysReg r = sc->iv[c].reg;
+        if (r != PHYS_NONE && free_until[r] >= to)
+            return r;
+    }
+    return PHYS_NONE;
+}
+
+static bool split_try_free(SplitCtx *sc, int cur)
+{
+    int free_until[PHYS_REG_COUNT];
+    for (int r = 0; r < PHYS_REG_COUNT; r++)
+        free_until[r] = sc->allocable[r] ? SPLIT_POS_MAX : -1;
+
+    for (int k = 0; k < sc->active_count; k++)
+        free_until[sc->iv[sc->active[k]].reg] = 0;
+    for (int k = 0; k < sc->inactive_count; k++)
+    {
+        SplitInterval *it = &sc->iv[sc->inactive[k]];
+        if (free_until[it->reg] <= 0)
+            continue;
+        int x = split_intersect(it, sc->iv[cur].ranges, sc->iv[cur].range_count, sc->position);
+        if (x >= 0 && x < free_until[it->reg])
+            free_until[it->reg] = x;
+    }
+    for (int r = 0; r < PHYS_REG_COUNT; r++)
+    {
+        if (free_until[r] <= 0)
+            continue;
+        int x = split_fixed_intersect(sc, r, &sc->iv[cur]);
+        if (x >= 0 && x < free_until[r])
+            free_until[r] = x;
+    }
+
+    int end = split_end(&sc->iv[cur]);
+    PhysReg reg = split_copy_hint(sc, cur, free_until);
+    for (int k = 0; reg == PHYS_NONE && k < alloc_order_count; k++)
+    {
+        if (free_until[alloc_order[k]] >= end)
+        {
+            reg = alloc_order[k];
+            break;
+        }
+    }
+    if (reg == PHYS_NONE)
+    {
+        for (int k = 0; k < alloc_order_count; k++)
+        {
+            PhysReg r = alloc_order[k];
+            if (reg == PHYS_NONE || free_until[r] > free_until[reg])
+                reg = r;
+        }
+        if (reg == PHYS_NONE || free_until[reg] <= sc->position)
+            return false;
+        int at = split_pick_pos(sc, sc->position, free_until[reg], false);
+        if (at < 0)
+            return false;
+        split_heap_push(sc, split_at(sc, cur, at));
+    }
+    sc->iv[cur].reg = reg;
+    return true;
+}
+
+static void split_alloc_blocked(SplitCtx *sc, int cur)
+{
+    int start = sc->position;
+    int start_even = start & ~1;
+    int use_pos[PHYS_REG_COUNT];
+    int block_pos[PHYS_REG_COUNT];
+    int64_t victim_w[PHYS_REG_COUNT];
+    for (int r = 0; r < PHYS_REG_COUNT; r++)
+    {
+        use_pos[r] = sc->allocable[r] ? SPLIT_POS_MAX : -1;
+        block_pos[r] = SPLIT_POS_MAX;
+        victim_w[r] = 0;
+    }
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        int *list = pass == 0 ? sc->active : sc->inactive;
+        int count = pass == 0 ? sc->active_count : sc->inactive_count;
+        for (int k = 0; k < count; k++)
+        {
+            SplitInterval *it = &sc->iv[list[k]];
+            if (use_pos[it->reg] < 0)
+                continue;
+            if (pass == 1 &&
+                split_intersect(it, sc->iv[cur].ranges, sc->iv[cur].range_count, start) < 0)
+                continue;
+            const SplitUse *u = split_next_use(it, start_even);
+            if (u && u->must_reg && u->pos <= (start | 1))
+            {
+                use_pos[it->reg] = -1; // يحتاج سجله في هذه التعليمة
+                continue;
+            }
+            int p = u ? u->pos : SPLIT_POS_MAX;
+            if (p < use_pos[it->reg])
+                use_pos[it->reg] = p;
+            int64_t w = split_weight_from(sc, it, start_even);
+            if (w > victim_w[it->reg])
+                victim_w[it->reg] = w;
+        }
+    }
+    for (int r = 0; r < PHYS_REG_COUNT; r++)
+    {
+        if (use_pos[r] < 0)
+            continue;
+        int x = split_fixed_intersect(sc, r, &sc->iv[cur]);
+        if (x >= 0)
+        {
+            block_pos[r] = x;
+            if (x < use_pos[r])
+                use_pos[r] = x;
+        }
+    }
+
+    const SplitUse *first = split_next_use(&sc->iv[cur], start);
+    bool must_now = false;
+    for (const SplitUse *u = first; u && u < sc->iv[cur].uses + sc->iv[cur].use_count &&
+                                    u->pos <= (start | 1);
+         u++)
+    {
+        if (u->must_reg)
+            must_now = true;
+    }
+    int end = split_end(&sc->iv[cur]);
+
+    PhysReg reg = PHYS_NONE;
+    for (int k = 0; k < alloc_order_count; k++)
+    {
+        PhysReg r = alloc_order[k];
+        if (use_pos[r] <= start)
+            continue;
+        if (block_pos[r] < end && (block_pos[r] & ~1) <= start)
+            continue;
+        if (reg == PHYS_NONE)
+        {
+            reg = r;
+            continue;
+        }
+        if (must_now)
+        {
+            if (use_pos[r] > use_pos[reg])
+                reg = r;
+        }
+        else if (victim_w[r] < victim_w[reg] ||
+                 (victim_w[r] == victim_w[reg] && use_pos[r] > use_pos[reg]))
+        {
+            reg = r;
+        }
+    }
+
+    if (reg == PHYS_NONE)
+    {
+        if (must_now)
+            sc->failed = true;
+        else
+            split_spill_prefix(sc, cur);
+        return;
+    }
+    if (!must_now && (!first || use_pos[reg] < first->pos ||
+                      victim_w[reg] >= split_weight_from(sc, &sc->iv[cur], start)))
+    {
+        split_spill_prefix(sc, cur);
+        return;
+    }
+
+    sc->iv[cur].reg = reg;
+    if (block_pos[reg] < end)
+        split_heap_push(sc, split_at(sc, cur, split_pick_pos(sc, start, block_pos[reg], false)));
+
+    // الفترات التي تشغل السجل تُقسم عند الموقع الحالي وتُزال من القوائم.
+    for (int pass = 0; pass < 2; pass++)
+    {
+        int *list = pass == 0 ? sc->active : sc->inactive;
+        int *count = pass == 0 ? &sc->active_count : &sc->inactive_count;
+        for (int k = 0; k < *count;)
+        {
+            int idx = list[k];
+            if (sc->iv[idx].reg != reg ||
+                (pass == 1 && split_intersect(&sc->iv[idx], sc->iv[cur].ranges,
+                                              sc->iv[cur].range_count, start) < 0))
+            {
+                k++;
+                continue;
+            }
+            split_list_remove(list, count, k);
+            split_evict(sc, idx, start_even);
+        }
+    }
+}
+
+static bool split_allocate(SplitCtx *sc)
+{
+    int n = sc->iv_count;
+    for (int k = 0; k < n; k++)
+        split_heap_push(sc, k);
+
+    while (sc->heap_count > 0 && !sc->failed)
+    {
+        int cur = split_heap_pop(sc);
+        int pos = split_start(&sc->iv[cur]);
+        sc->position = pos;
+
+        for (int k = 0; k < sc->active_count;)
+        {
+            SplitInterval *it = &sc->iv[sc->active[k]];
+            if (split_end(it) <= pos)
+                split_list_remove(sc->active, &sc->active_count, k);
+            else if (!split_covers_forward(it, pos))
+            {
+                split_list_push(sc, &sc->inactive, &sc->inactive_count, &sc->inactive_cap,
+                                sc->active[k]);
+                split_list_remove(sc->active, &sc->active_count, k);
+            }
+            else
+                k++;
+        }
+        for (int k = 0; k < sc->inactive_count;)
+        {
+            SplitInterval *it = &sc->iv[sc->inactive[k]];
+            if (split_end(it) <= pos)
+                split_list_remove(sc->inactive, &sc->inactive_count, k);
+            else if (split_covers_forward(it, pos))
+            {
+                split_list_push(sc, &sc->active, &sc->active_count, &sc->active_cap,
+                                sc->inactive[k]);
+                split_list_remove(sc->inactive, &sc->inactive_count, k);
+            }
+            else
+                k++;
+        }
+
+        if (!split_try_free(sc, cur))
+            split_alloc_blocked(sc, cur);
+        if (sc->iv[cur].reg != PHYS_NONE)
+            split_list_push(sc, &sc->active, &sc->active_count, &sc->active_cap, cur);
+    }
+    if (sc->failed)
+        return false;
+
+    // التحقق قبل تعديل الدالة: كل جزء له موقع، ولا استخدام إلزامي في المكدس.
+    for (int k = 0; k < sc->iv_count; k++)
+    {
+        SplitInterval *it = &sc->iv[k];
+        if (it->range_count == 0)
+            continue;
+        if (!it->on_stack && it->reg == PHYS_NONE)
+            return false;
+        if (!it->on_stack)
+            continue;
+        for (int u = 0; u < it->use_count; u++)
+        {
+            if (it->uses[u].must_reg)
+                return false;
+        }
+    }
+    return true;
+}
+
+#include "regalloc_split_resolve.c"
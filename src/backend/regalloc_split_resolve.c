@@ -0,0 +1,908 @@
+// ============================================================================
+// حل مواقع الأجزاء (Split Resolution)
+// ============================================================================
+//
+// بعد التخصيص قد يعيش vreg واحد في مواقع مختلفة:
+// - داخل الكتلة: عند بداية كل جزء يُدرج نقل من موقع الجزء السابق.
+// - على الحواف: إن اختلف موقعه في نهاية السلف عن بدايته في الخلف يُدرج نقل
+//   في نهاية السلف (خلف وحيد)، أو بداية الخلف (سلف وحيد)، أو كتلة جديدة
+//   تقسم الحافة الحرجة.
+// النقلات المتزامنة تُرتب حتى لا يُكتب سجل قبل قراءته، وتُكسر الدورات بـ R11.
+
+typedef struct
+{
+    int vreg;
+    PhysReg src; // PHYS_NONE = خانة المكدس
+    PhysReg dst;
+} SplitMove;
+
+typedef struct
+{
+    int pos;
+    SplitMove move;
+    bool elide; // تخزين في خانة محدثة أصلاً
+} SplitPosMove;
+
+typedef struct
+{
+    int max_id;
+    int *index_of_id; // معرف الكتلة → فهرسها، أو -1
+    int *pred_start;  // أسلاف كل كتلة بصيغة CSR
+    int *preds;
+
+    SplitPosMove *inner; // نقلات داخل الكتل مرتبة بالموقع
+    int inner_count;
+    int *inner_start; // أول نقل لكل كتلة (bc + 1 مدخلاً)
+
+    uint64_t *clean_out; // لكل كتلة: vregs خاناتها تحمل قيمتها الحالية عند الخروج
+    uint64_t *scratch;   // كلمتا عمل بطول bitset_words لكل منهما
+    int *store_at;       // لكل vreg: تعليمة تعريفه الوحيد إن خُزّن بعدها، أو -1
+} SplitResolve;
+
+typedef struct
+{
+    MachineBlock *block;
+    MachineInst *before; // يُدرج قبله إن لم يكن NULL
+    MachineInst *after;  // وإلا بعده (NULL = بداية الكتلة)
+} SplitInsertPoint;
+
+static PhysReg split_loc(const SplitCtx *sc, int idx)
+{
+    return sc->iv[idx].on_stack ? PHYS_NONE : sc->iv[idx].reg;
+}
+
+/**
+ * @brief الجزء الذي يغطي pos (أو أول جزء بعده إن وقع pos في فجوة).
+ */
+static int split_child_at(const SplitCtx *sc, int vreg, int pos)
+{
+    int c = sc->head[vreg];
+    while (c >= 0 && sc->iv[c].next >= 0 && split_end(&sc->iv[c]) <= pos)
+        c = sc->iv[c].next;
+    return c;
+}
+
+static bool split_is_jump(const MachineInst *inst)
+{
+    return inst->op == MACH_JMP || inst->op == MACH_JMP_TABLE ||
+           (inst->op >= MACH_JE && inst->op <= MACH_JNP);
+}
+
+static void split_insert(SplitInsertPoint *ip, MachineInst *mi)
+{
+    if (ip->before)
+    {
+        mach_block_insert_before_local(ip->block, ip->before, mi);
+        return;
+    }
+    MachineBlock *b = ip->block;
+    mi->prev = ip->after;
+    mi->next = ip->after ? ip->after->next : b->first;
+    if (mi->next)
+        mi->next->prev = mi;
+    else
+        b->last = mi;
+    if (ip->after)
+        ip->after->next = mi;
+    else
+        b->first = mi;
+    b->inst_count++;
+    ip->after = mi;
+}
+
+static bool split_emit_move(SplitCtx *sc, SplitInsertPoint *ip, int vreg, PhysReg dst, PhysReg src)
+{
+    MachineOperand d = dst == PHYS_NONE ? mach_op_mem(PHYS_RBP, sc->slot[vreg], 64)
+                                        : mach_op_vreg(dst, 64);
+    MachineOperand s = src == PHYS_NONE ? mach_op_mem(PHYS_RBP, sc->slot[vreg], 64)
+                                        : mach_op_vreg(src, 64);
+    MachineInst *mi = mach_inst_new(MACH_MOV, d, s, mach_op_none());
+    if (!mi)
+        return false;
+    mi->comment = "// نقل بين أجزاء مدى مقسوم";
+    split_insert(ip, mi);
+
+    RegAllocCtx *ra = sc->ra;
+    if (src == PHYS_NONE || dst == PHYS_NONE)
+        regalloc_stats_note(ra, dst == PHYS_NONE, ip->block->loop_depth);
+    else
+        ra->stats.moves++;
+    return true;
+}
+
+/**
+ * @brief إصدار نقلات متزامنة: لا يُكتب سجل ما دام نقل آخر يقرؤه.
+ */
+static bool split_emit_parallel(SplitCtx *sc, SplitInsertPoint *ip, SplitMove *moves, int n)
+{
+    while (n > 0)
+    {
+        bool progress = false;
+        for (int k = 0; k < n; k++)
+        {
+            bool blocked = false;
+            if (moves[k].dst != PHYS_NONE)
+            {
+                for (int j = 0; j < n && !blocked; j++)
+                    blocked = j != k && moves[j].src == moves[k].dst;
+            }
+            if (blocked)
+                continue;
+            if (!split_emit_move(sc, ip, moves[k].vreg, moves[k].dst, moves[k].src))
+                return false;
+            moves[k] = moves[--n];
+            progress = true;
+            break;
+        }
+        if (progress)
+            continue;
+
+        // دورة بين السجلات: نحفظ هدف أول نقل في R11 ونقرأ منه بدلاً منه.
+        PhysReg d = moves[0].dst;
+        if (!split_emit_move(sc, ip, moves[0].vreg, PHYS_R11, d))
+            return false;
+        for (int j = 0; j < n; j++)
+        {
+            if (moves[j].src == d)
+                moves[j].src = PHYS_R11;
+        }
+    }
+    return true;
+}
+
+static int split_pos_move_cmp(const void *a, const void *b)
+{
+    const SplitPosMove *x = (const SplitPosMove *)a;
+    const SplitPosMove *y = (const SplitPosMove *)b;
+    if (x->pos != y->pos)
+        return x->pos < y->pos ? -1 : 1;
+    return x->move.vreg - y->move.vreg;
+}
+
+/**
+ * @brief أول قفز في ذيل القفزات المتتالية في آخر الكتلة، أو NULL.
+ */
+static MachineInst *split_jump_tail(MachineBlock *b)
+{
+    MachineInst *first = NULL;
+    for (MachineInst *inst = b->last; inst && split_is_jump(inst); inst = inst->prev)
+        first = inst;
+    return first;
+}
+
+static bool split_is_store(const SplitMove *m)
+{
+    return m->src != PHYS_NONE && m->dst == PHYS_NONE;
+}
+
+/**
+ * @brief النقل اللازم لـ v على الحافة b → si، إن اختلف موقعاه.
+ */
+static bool split_edge_move(const SplitCtx *sc, int b, int si, int v, SplitMove *out)
+{
+    if (v >= sc->ra->max_vreg || sc->head[v] < 0)
+        return false;
+    PhysReg from = split_loc(sc, split_child_at(sc, v, sc->block_to[b] - 1));
+    PhysReg to = split_loc(sc, split_child_at(sc, v, sc->block_from[si]));
+    if (from == to)
+        return false;
+    out->vreg = v;
+    out->src = from;
+    out->dst = to;
+    return true;
+}
+
+static bool split_resolve_init(SplitCtx *sc, SplitResolve *rs)
+{
+    RegAllocCtx *ra = sc->ra;
+    int bc = ra->block_count;
+    rs->max_id = -1;
+    for (int b = 0; b < bc; b++)
+    {
+        if (sc->blocks[b]->id > rs->max_id)
+            rs->max_id = sc->blocks[b]->id;
+    }
+    int words = ra->bitset_words > 0 ? ra->bitset_words : 1;
+    rs->index_of_id = malloc((size_t)(rs->max_id + 2) * sizeof(int));
+    rs->pred_start = calloc((size_t)bc + 1, sizeof(int));
+    rs->inner_start = calloc((size_t)bc + 1, sizeof(int));
+    rs->clean_out = malloc((size_t)bc * (size_t)words * sizeof(uint64_t));
+    rs->scratch = malloc(2 * (size_t)words * sizeof(uint64_t));
+    rs->store_at = malloc((size_t)(ra->max_vreg > 0 ? ra->max_vreg : 1) * sizeof(int));
+    if (!rs->index_of_id || !rs->pred_start || !rs->inner_start || !rs->clean_out || !rs->scratch ||
+        !rs->store_at)
+        return false;
+
+    for (int i = 0; i <= rs->max_id; i++)
+        rs->index_of_id[i] = -1;
+    for (int b = 0; b < bc; b++)
+    {
+        if (sc->blocks[b]->id >= 0)
+            rs->index_of_id[sc->blocks[b]->id] = b;
+    }
+
+    for (int b = 0; b < bc; b++)
+    {
+        MachineBlock *mb = sc->blocks[b];
+        for (int k = 0; k < mb->succ_count; k++)
+        {
+            MachineBlock *s = mb->succs[k];
+            if (s && s->id >= 0 && s->id <= rs->max_id && rs->index_of_id[s->id] >= 0)
+                rs->pred_start[rs->index_of_id[s->id] + 1]++;
+        }
+    }
+    for (int b = 0; b < bc; b++)
+        rs->pred_start[b + 1] += rs->pred_start[b];
+    rs->preds = malloc((size_t)(rs->pred_start[bc] > 0 ? rs->pred_start[bc] : 1) * sizeof(int));
+    int *fill = malloc((size_t)bc * sizeof(int));
+    if (!rs->preds || !fill)
+    {
+        free(fill);
+        return false;
+    }
+    memcpy(fill, rs->pred_start, (size_t)bc * sizeof(int));
+    for (int b = 0; b < bc; b++)
+    {
+        MachineBlock *mb = sc->blocks[b];
+        for (int k = 0; k < mb->succ_count; k++)
+        {
+            MachineBlock *s = mb->succs[k];
+            if (s && s->id >= 0 && s->id <= rs->max_id && rs->index_of_id[s->id] >= 0)
+                rs->preds[fill[rs->index_of_id[s->id]]++] = b;
+        }
+    }
+    free(fill);
+    return true;
+}
+
+static void split_resolve_free(SplitResolve *rs)
+{
+    free(rs->index_of_id);
+    free(rs->pred_start);
+    free(rs->preds);
+    free(rs->inner);
+    free(rs->inner_start);
+    free(rs->clean_out);
+    free(rs->scratch);
+    free(rs->store_at);
+}
+
+/**
+ * @brief جمع نقلات بداية الأجزاء داخل الكتل (الحدود عند بداية كتلة تُحل على الحواف).
+ */
+static bool split_collect_inner(SplitCtx *sc, SplitResolve *rs)
+{
+    RegAllocCtx *ra = sc->ra;
+    int cap = 0;
+    for (int v = 0; v < ra->max_vreg; v++)
+    {
+        for (int c = sc->head[v]; c >= 0 && sc->iv[c].next >= 0; c = sc->iv[c].next)
+        {
+            int n = sc->iv[c].next;
+            int p = split_start(&sc->iv[n]);
+            if (split_end(&sc->iv[c]) != p || split_loc(sc, c) == split_loc(sc, n))
+                continue;
+            if ((p & 1) || p / 2 >= ra->total_insts || sc->block_from[sc->inst_block[p / 2]] == p)
+                continue;
+            if (!split_grow((void **)&rs->inner, &cap, rs->inner_count + 1, sizeof(SplitPosMove)))
+                return false;
+            SplitPosMove *pm = &rs->inner[rs->inner_count++];
+            pm->pos = p;
+            pm->move.vreg = v;
+            pm->move.src = split_loc(sc, c);
+            pm->move.dst = split_loc(sc, n);
+            pm->elide = false;
+        }
+    }
+    if (rs->inner_count > 1)
+        qsort(rs->inner, (size_t)rs->inner_count, sizeof(SplitPosMove), split_pos_move_cmp);
+    for (int k = 0; k < rs->inner_count; k++)
+        rs->inner_start[sc->inst_block[rs->inner[k].pos / 2] + 1]++;
+    for (int b = 0; b < ra->block_count; b++)
+        rs->inner_start[b + 1] += rs->inner_start[b];
+    return true;
+}
+
+// ============================================================================
+// حذف التخزين الزائد (Redundant Spill Store Elimination)
+// ============================================================================
+//
+// تحليل أمامي "يجب" (must): خانة v محدثة عند نقطة إن كُتبت قيمته الحالية
+// فيها على كل مسار منذ آخر تعريف. التعريف في سجل يُبطلها، والتعريف في جزء
+// مسرّب أو نقل سجل ← خانة يثبتها. نقل سجل ← خانة إلى خانة محدثة يُحذف، فيبقى
+// للمتغير المسرّب في حلقة تخزين واحد بعد تعريفه بدل تخزين عند كل تقسيم.
+//
+// وللمتغير ذي التعريف الوحيد الذي لا تقع أجزاؤه المسرّبة في حلقة أضحل من
+// تعريفه يُخزَّن مرة بعد التعريف مباشرة، فتُحذف كل نقلات سجل ← خانة بعده
+// (كأن يُقسم متغير حي حول حلقة داخل جسمها ولا يُعرّف فيها).
+
+static void split_bit_set(uint64_t *set, int v, bool on)
+{
+    if (on)
+        set[v / 64] |= (uint64_t)1 << (v % 64);
+    else
+        set[v / 64] &= ~((uint64_t)1 << (v % 64));
+}
+
+static void split_clean_block(SplitCtx *sc, SplitResolve *rs, int b, uint64_t *state, bool mark)
+{
+    RegAllocCtx *ra = sc->ra;
+    int k = rs->inner_start[b];
+    for (int i = sc->block_from[b] / 2; i < sc->block_to[b] / 2; i++)
+    {
+        for (; k < rs->inner_start[b + 1] && rs->inner[k].pos == 2 * i; k++)
+        {
+            SplitPosMove *pm = &rs->inner[k];
+            if (!split_is_store(&pm->move))
+                continue;
+            if (mark)
+                pm->elide = bitset_test(state, pm->move.vreg);
+            split_bit_set(state, pm->move.vreg, true);
+        }
+        const MachineOperand *dst = &ra->inst_map[i]->dst;
+        if (dst->kind != MACH_OP_VREG || dst->data.vreg < 0 || dst->data.vreg >= ra->max_vreg)
+            continue;
+        int v = dst->data.vreg;
+        if (sc->slot[v] != 0)
+            split_bit_set(state, v,
+                          sc->iv[split_child_at(sc, v, 2 * i + 1)].on_stack || rs->store_at[v] == i);
+    }
+}
+
+/**
+ * @brief اختيار المتغيرات التي تُخزَّن عند تعريفها الوحيد.
+ */
+static void split_pick_def_stores(SplitCtx *sc, SplitResolve *rs)
+{
+    RegAllocCtx *ra = sc->ra;
+    for (int v = 0; v < ra->max_vreg; v++)
+        rs->store_at[v] = -1;
+    for (int i = 0; i < ra->total_insts; i++)
+    {
+        const MachineOperand *dst = &ra->inst_map[i]->dst;
+        if (dst->kind != MACH_OP_VREG || dst->data.vreg < 0 || dst->data.vreg >= ra->max_vreg)
+            continue;
+        int v = dst->data.vreg;
+        rs->store_at[v] = rs->store_at[v] == -1 ? i : -2;
+    }
+    for (int v = 0; v < ra->max_vreg; v++)
+    {
+        int i = rs->store_at[v];
+        rs->store_at[v] = -1;
+        if (i < 0 || sc->slot[v] == 0 || sc->head[v] < 0)
+            continue;
+        if (sc->iv[split_child_at(sc, v, 2 * i + 1)].on_stack)
+            continue;
+        int def_depth = sc->blocks[sc->inst_block[i]]->loop_depth;
+        int min_depth = INT_MAX;
+        for (int c = sc->head[v]; c >= 0; c = sc->iv[c].next)
+        {
+            int p = split_start(&sc->iv[c]);
+            if (sc->iv[c].on_stack && p / 2 < ra->total_insts)
+            {
+                int d = sc->blocks[sc->inst_block[p / 2]]->loop_depth;
+                min_depth = d < min_depth ? d : min_depth;
+            }
+        }
+        if (min_depth != INT_MAX && def_depth <= min_depth)
+            rs->store_at[v] = i;
+    }
+}
+
+/**
+ * @brief حالة الدخول للكتلة si: تقاطع خروج أسلافها بعد نقلات الحواف.
+ */
+static void split_clean_in(SplitCtx *sc, SplitResolve *rs, int si, uint64_t *in, uint64_t *tmp)
+{
+    RegAllocCtx *ra = sc->ra;
+    int words = ra->bitset_words;
+    int first = rs->pred_start[si];
+    int last = rs->pred_start[si + 1];
+    memset(in, first < last && si != 0 ? 0xFF : 0, (size_t)words * sizeof(uint64_t));
+    if (si == 0)
+        return;
+    const uint64_t *live_in = ra->block_live[si].live_in;
+    for (int e = first; e < last; e++)
+    {
+        int p = rs->preds[e];
+        const uint64_t *out = rs->clean_out + (size_t)p * (size_t)words;
+        memcpy(tmp, out, (size_t)words * sizeof(uint64_t));
+        for (int w = 0; w < words; w++)
+        {
+            uint64_t bits = live_in[w] & ~out[w];
+            while (bits)
+            {
+                int v = w * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                SplitMove m;
+                if (split_edge_move(sc, p, si, v, &m) && split_is_store(&m))
+                    split_bit_set(tmp, v, true);
+            }
+        }
+        for (int w = 0; w < words; w++)
+            in[w] &= tmp[w];
+    }
+}
+
+static void split_clean_analysis(SplitCtx *sc, SplitResolve *rs)
+{
+    RegAllocCtx *ra = sc->ra;
+    int words = ra->bitset_words;
+    int bc = ra->block_count;
+    if (words <= 0)
+        return;
+    uint64_t *in = rs->scratch;
+    uint64_t *tmp = rs->scratch + words;
+    memset(rs->clean_out, 0xFF, (size_t)bc * (size_t)words * sizeof(uint64_t));
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int b = 0; b < bc; b++)
+        {
+            split_clean_in(sc, rs, b, in, tmp);
+            split_clean_block(sc, rs, b, in, false);
+            uint64_t *out = rs->clean_out + (size_t)b * (size_t)words;
+            if (memcmp(out, in, (size_t)words * sizeof(uint64_t)) != 0)
+            {
+                memcpy(out, in, (size_t)words * sizeof(uint64_t));
+                changed = true;
+            }
+        }
+    }
+    for (int b = 0; b < bc; b++)
+    {
+        split_clean_in(sc, rs, b, in, tmp);
+        split_clean_block(sc, rs, b, in, true);
+    }
+}
+
+// ============================================================================
+// إدراج النقلات (Move Insertion)
+// ============================================================================
+
+static bool split_emit_def_stores(SplitCtx *sc, SplitResolve *rs)
+{
+    RegAllocCtx *ra = sc->ra;
+    for (int v = 0; v < ra->max_vreg; v++)
+    {
+        int i = rs->store_at[v];
+        if (i < 0)
+            continue;
+        SplitInsertPoint ip = {sc->blocks[sc->inst_block[i]], NULL, ra->inst_map[i]};
+        PhysReg reg = split_loc(sc, split_child_at(sc, v, 2 * i + 1));
+        if (!split_emit_move(sc, &ip, v, PHYS_NONE, reg))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief إدراج نقلات بداية الأجزاء داخل الكتل.
+ *
+ * النقل عند تعليمة ضمن ذيل القفزات يُقدَّم قبل الذيل كله، وإلا نُفذ على
+ * مسار واحد فقط من مسارات الخروج.
+ */
+static bool split_emit_inner(SplitCtx *sc, SplitResolve *rs, MachineInst **tails,
+                             const int *tail_index)
+{
+    RegAllocCtx *ra = sc->ra;
+    SplitMove *group = rs->inner_count > 0 ? malloc((size_t)rs->inner_count * sizeof(SplitMove))
+                                           : NULL;
+    bool ok = rs->inner_count == 0 || group;
+    for (int k = 0; ok && k < rs->inner_count;)
+    {
+        int p = rs->inner[k].pos;
+        int n = 0;
+        for (; k < rs->inner_count && rs->inner[k].pos == p; k++)
+        {
+            if (!rs->inner[k].elide)
+                group[n++] = rs->inner[k].move;
+        }
+        if (n == 0)
+            continue;
+
+        int i = p / 2;
+        int b = sc->inst_block[i];
+        SplitInsertPoint ip = {sc->blocks[b], ra->inst_map[i], NULL};
+        if (tails[b] && i >= tail_index[b])
+            ip.before = tails[b];
+        ok = split_emit_parallel(sc, &ip, group, n);
+    }
+    free(group);
+    return ok;
+}
+
+static void split_retarget(MachineFunc *func, MachineBlock *b, int old_id, int new_id)
+{
+    for (MachineInst *inst = b->first; inst; inst = inst->next)
+    {
+        if (inst->op == MACH_JMP_TABLE && inst->src2.kind == MACH_OP_IMM)
+        {
+            int t = (int)inst->src2.data.imm;
+            if (t < 0 || t >= func->jump_table_count)
+                continue;
+            MachineJumpTable *jt = &func->jump_tables[t];
+            for (int e = 0; e < jt->count; e++)
+            {
+                if (jt->label_ids[e] == old_id)
+                    jt->label_ids[e] = new_id;
+            }
+        }
+        else if (split_is_jump(inst) && inst->dst.kind == MACH_OP_LABEL &&
+                 inst->dst.data.label_id == old_id)
+        {
+            inst->dst.data.label_id = new_id;
+        }
+    }
+    for (int s = 0; s < b->succ_count; s++)
+    {
+        if (b->succs[s] && b->succs[s]->id == old_id)
+            b->succs[s] = NULL; // يُملأ بالكتلة الجديدة عند الاستدعاء
+    }
+}
+
+/**
+ * @brief كتلة جديدة بعد b على الحافة b → s: تسمية، ثم النقلات، ثم jmp s.
+ */
+static MachineBlock *split_edge_block(SplitCtx *sc, MachineBlock *b, MachineBlock *s, int id)
+{
+    MachineFunc *func = sc->ra->func;
+    MachineBlock *nb = mach_block_new("حافة_مقسومة", id);
+    if (!nb)
+        return NULL;
+    nb->succs = malloc(sizeof(MachineBlock *));
+    MachineInst *label = mach_inst_new(MACH_LABEL, mach_op_label(id), mach_op_none(), mach_op_none());
+    MachineInst *jmp = mach_inst_new(MACH_JMP, mach_op_label(s->id), mach_op_none(), mach_op_none());
+    if (!nb->succs || !label || !jmp)
+    {
+        mach_inst_free(label);
+        mach_inst_free(jmp);
+        mach_block_free(nb);
+        return NULL;
+    }
+    mach_block_append(nb, label);
+    mach_block_append(nb, jmp);
+    nb->succs[0] = s;
+    nb->succ_count = 1;
+    nb->loop_depth = b->loop_depth < s->loop_depth ? b->loop_depth : s->loop_depth;
+
+    split_retarget(func, b, s->id, id);
+    for (int k = 0; k < b->succ_count; k++)
+    {
+        if (!b->succs[k])
+            b->succs[k] = nb;
+    }
+    nb->next = b->next;
+    b->next = nb;
+    func->block_count++;
+    return nb;
+}
+
+static bool split_resolve_edges(SplitCtx *sc, SplitResolve *rs, MachineInst **tails)
+{
+    RegAllocCtx *ra = sc->ra;
+    int bc = ra->block_count;
+    int words = ra->bitset_words;
+    SplitMove *moves = malloc((size_t)(ra->max_vreg > 0 ? ra->max_vreg : 1) * sizeof(SplitMove));
+    // نقلات بداية الخلف تُدرج بعد تسميته وبترتيب الحواف.
+    MachineInst **entry_cursor = calloc((size_t)bc, sizeof(MachineInst *));
+    bool ok = moves && entry_cursor;
+    int next_id = rs->max_id + 1;
+
+    for (int b = 0; ok && b < bc; b++)
+    {
+        MachineBlock *mb = sc->blocks[b];
+        const uint64_t *clean = rs->clean_out + (size_t)b * (size_t)words;
+
+        // ذيل يقرأ سجلاً (jmp عبر جدول) لا تُدرج قبله نقلات الحواف.
+        int distinct = 0;
+        for (MachineInst *inst = tails[b]; inst; inst = inst->next)
+        {
+            if (inst->op == MACH_JMP_TABLE)
+                distinct = 2;
+        }
+        for (int k = 0; k < mb->succ_count && distinct < 2; k++)
+        {
+            bool seen = false;
+            for (int j = 0; j < k && !seen; j++)
+                seen = mb->succs[j] == mb->succs[k];
+            if (!seen)
+                distinct++;
+        }
+
+        for (int k = 0; ok && k < mb->succ_count; k++)
+        {
+            MachineBlock *s = mb->succs[k];
+            if (!s || s->id < 0 || s->id > rs->max_id || rs->index_of_id[s->id] < 0)
+                continue;
+            bool seen = false;
+            for (int j = 0; j < k && !seen; j++)
+                seen = mb->succs[j] == s;
+            if (seen)
+                continue;
+            int si = rs->index_of_id[s->id];
+
+            int n = 0;
+            const uint64_t *live_in = ra->block_live[si].live_in;
+            for (int w = 0; w < words; w++)
+            {
+                uint64_t bits = live_in[w];
+                while (bits)
+                {
+                    int v = w * 64 + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    if (!split_edge_move(sc, b, si, v, &moves[n]))
+                        continue;
+                    if (split_is_store(&moves[n]) && bitset_test(clean, v))
+                        continue;
+                    n++;
+                }
+            }
+            if (n == 0)
+                continue;
+
+            SplitInsertPoint ip = {mb, tails[b], mb->last};
+            if (distinct > 1)
+            {
+                int preds = rs->pred_start[si + 1] - rs->pred_start[si] + (si == 0);
+                if (preds == 1)
+                {
+                    ip.block = s;
+                    ip.before = NULL;
+                    ip.after = entry_cursor[si];
+                    if (!ip.after && s->first && s->first->op == MACH_LABEL)
+                        ip.after = s->first;
+                }
+                else
+                {
+                    MachineBlock *nb = split_edge_block(sc, mb, s, next_id++);
+                    if (!nb)
+                    {
+                        ok = false;
+                        break;
+                    }
+                    ip.block = nb;
+                    ip.before = nb->last;
+                }
+            }
+            ok = split_emit_parallel(sc, &ip, moves, n);
+            if (ip.block == s)
+                entry_cursor[si] = ip.after;
+        }
+    }
+
+    free(entry_cursor);
+    free(moves);
+    return ok;
+}
+
+// ============================================================================
+// إعادة الكتابة الموضعية (Positional Rewrite)
+// ============================================================================
+
+static void split_rewrite_operand(SplitCtx *sc, MachineOperand *op, int pos, bool is_def,
+                                  int loop_depth, int *cursor)
+{
+    RegAllocCtx *ra = sc->ra;
+    int *vreg_field = NULL;
+    if (op->kind == MACH_OP_VREG)
+        vreg_field = &op->data.vreg;
+    else if (op->kind == MACH_OP_MEM)
+        vreg_field = &op->data.mem.base_vreg;
+    else
+        return;
+
+    int v = *vreg_field;
+    if (v < 0)
+    {
+        PhysReg phys = resolve_special_vreg_with_cc(v, sc->cc);
+        if (phys != PHYS_NONE)
+            *vreg_field = phys;
+        return;
+    }
+    if (v >= ra->max_vreg || cursor[v] < 0)
+        return;
+
+    int c = cursor[v];
+    while (sc->iv[c].next >= 0 && split_end(&sc->iv[c]) <= pos)
+        c = sc->iv[c].next;
+    cursor[v] = c;
+
+    if (!sc->iv[c].on_stack)
+    {
+        *vreg_field = sc->iv[c].reg;
+        if (reg_is_callee_saved_cc(sc->cc, sc->iv[c].reg))
+            ra->callee_saved_used[sc->iv[c].reg] = true;
+        return;
+    }
+    // split_allocate يضمن ألا تصل قاعدة عنوان إلى هنا؛ المعامل يصبح [rbp + خانة].
+    regalloc_stats_note(ra, is_def, loop_depth);
+    op->kind = MACH_OP_MEM;
+    op->data.mem.base_vreg = PHYS_RBP;
+    op->data.mem.offset = sc->slot[v];
+}
+
+static void split_rewrite(SplitCtx *sc, int *cursor)
+{
+    RegAllocCtx *ra = sc->ra;
+    for (int i = 0; i < ra->total_insts; i++)
+    {
+        MachineInst *inst = ra->inst_map[i];
+        int depth = sc->blocks[sc->inst_block[i]]->loop_depth;
+        split_rewrite_operand(sc, &inst->src1, 2 * i, false, depth, cursor);
+        split_rewrite_operand(sc, &inst->src2, 2 * i, false, depth, cursor);
+        split_rewrite_operand(sc, &inst->dst, inst->dst.kind == MACH_OP_MEM ? 2 * i : 2 * i + 1,
+                              inst->dst.kind == MACH_OP_VREG, depth, cursor);
+    }
+}
+
+// ============================================================================
+// نقطة الدخول (Entry Point)
+// ============================================================================
+
+static void split_ctx_free(SplitCtx *sc)
+{
+    for (int k = 0; k < sc->iv_count; k++)
+    {
+        free(sc->iv[k].ranges);
+        free(sc->iv[k].uses);
+    }
+    for (int r = 0; r < PHYS_REG_COUNT; r++)
+        free(sc->fixed[r]);
+    free(sc->iv);
+    free(sc->blocks);
+    free(sc->block_from);
+    free(sc->block_to);
+    free(sc->inst_block);
+    free(sc->head);
+    free(sc->slot);
+    free(sc->copy_start);
+    free(sc->copies);
+    free(sc->heap);
+    free(sc->active);
+    free(sc->inactive);
+}
+
+typedef enum
+{
+    SPLIT_RESULT_FALLBACK = 0, // لم تُعدّل الدالة؛ يُستخدم المسح الخطي
+    SPLIT_RESULT_DONE,
+    SPLIT_RESULT_ERROR // فشل ذاكرة بعد بدء تعديل الدالة
+} SplitResult;
+
+/**
+ * @brief فهرسة نسخ mov بين السجلات الافتراضية لكل من طرفيها (لتلميح النسخ).
+ */
+static bool split_collect_copies(SplitCtx *sc)
+{
+    RegAllocCtx *ra = sc->ra;
+    sc->copy_start = calloc((size_t)ra->max_vreg + 1, sizeof(int));
+    if (!sc->copy_start)
+        return false;
+    int d = -1;
+    int s = -1;
+    int total = 0;
+    for (int i = 0; i < ra->total_insts; i++)
+    {
+        if (!regalloc_copy_inst(ra, i, &d, &s) || d >= ra->max_vreg || s >= ra->max_vreg)
+            continue;
+        sc->copy_start[d + 1]++;
+        sc->copy_start[s + 1]++;
+        total += 2;
+    }
+    for (int v = 0; v < ra->max_vreg; v++)
+        sc->copy_start[v + 1] += sc->copy_start[v];
+    sc->copies = malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+    int *fill = malloc((size_t)(ra->max_vreg > 0 ? ra->max_vreg : 1) * sizeof(int));
+    if (!sc->copies || !fill)
+    {
+        free(fill);
+        return false;
+    }
+    memcpy(fill, sc->copy_start, (size_t)ra->max_vreg * sizeof(int));
+    for (int i = 0; i < ra->total_insts; i++)
+    {
+        if (!regalloc_copy_inst(ra, i, &d, &s) || d >= ra->max_vreg || s >= ra->max_vreg)
+            continue;
+        sc->copies[fill[d]++] = i;
+        sc->copies[fill[s]++] = i;
+    }
+    free(fill);
+    return true;
+}
+
+/**
+ * @brief تخصيص دالة بالمخصص المقسِّم بعد حساب الحيوية.
+ */
+static SplitResult regalloc_split_func(RegAllocCtx *ra)
+{
+    int bc = ra->block_count;
+    int total = ra->total_insts;
+    if (bc <= 0 || !ra->inst_map || !ra->block_live)
+        return SPLIT_RESULT_FALLBACK;
+
+    SplitCtx sc;
+    memset(&sc, 0, sizeof(sc));
+    sc.ra = ra;
+    sc.cc = ra->cc ? ra->cc : baa_target_builtin_windows_x86_64()->cc;
+    sc.blocks = malloc((size_t)bc * sizeof(MachineBlock *));
+    sc.block_from = malloc((size_t)bc * sizeof(int));
+    sc.block_to = malloc((size_t)bc * sizeof(int));
+    sc.inst_block = malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+    sc.head = malloc((size_t)(ra->max_vreg > 0 ? ra->max_vreg : 1) * sizeof(int));
+    sc.slot = calloc((size_t)(ra->max_vreg > 0 ? ra->max_vreg : 1), sizeof(int));
+    MachineInst **tails = calloc((size_t)bc, sizeof(MachineInst *));
+    int *tail_index = malloc((size_t)bc * sizeof(int));
+    bool ok = sc.blocks && sc.block_from && sc.block_to && sc.inst_block && sc.head && sc.slot &&
+              tails && tail_index;
+
+    if (ok)
+    {
+        for (int v = 0; v < ra->max_vreg; v++)
+            sc.head[v] = -1;
+
+        int b = 0;
+        int i = 0;
+        for (MachineBlock *mb = ra->func->blocks; mb && b < bc; mb = mb->next, b++)
+        {
+            sc.blocks[b] = mb;
+            sc.block_from[b] = 2 * i;
+            tails[b] = split_jump_tail(mb);
+            tail_index[b] = INT_MAX;
+            for (MachineInst *inst = mb->first; inst && i < total; inst = inst->next, i++)
+            {
+                sc.inst_block[i] = b;
+                if (inst == tails[b])
+                    tail_index[b] = i;
+            }
+            sc.block_to[b] = 2 * i;
+        }
+        ok = b == bc && i == total && split_collect_copies(&sc);
+
+        for (int k = 0; k < alloc_order_count; k++)
+            sc.allocable[alloc_order[k]] = true;
+        if (sc.cc->ret_phys_reg >= 0 && sc.cc->ret_phys_reg < PHYS_REG_COUNT)
+            sc.allocable[sc.cc->ret_phys_reg] = false;
+        for (int k = 0; k < sc.cc->int_arg_reg_count; k++)
+        {
+            int r = sc.cc->int_arg_phys_regs[k];
+            if (r >= 0 && r < PHYS_REG_COUNT)
+                sc.allocable[r] = false;
+        }
+    }
+
+    SplitResult result = SPLIT_RESULT_FALLBACK;
+    if (ok && split_build_intervals(&sc) && split_allocate(&sc))
+    {
+        // نقلات الأجزاء قبل نقلات الحواف في نفس الكتلة؛ والكتابة الموضعية
+        // تمشي على inst_map فلا تمس النقلات المدرجة.
+        int *cursor = malloc((size_t)(ra->max_vreg > 0 ? ra->max_vreg : 1) * sizeof(int));
+        result = SPLIT_RESULT_ERROR;
+        SplitResolve rs;
+        memset(&rs, 0, sizeof(rs));
+        bool resolved = cursor && split_resolve_init(&sc, &rs) && split_collect_inner(&sc, &rs);
+        if (resolved)
+        {
+            split_pick_def_stores(&sc, &rs);
+            split_clean_analysis(&sc, &rs);
+            resolved = split_emit_def_stores(&sc, &rs) && split_emit_inner(&sc, &rs, tails, tail_index) &&
+                       split_resolve_edges(&sc, &rs, tails);
+        }
+        split_resolve_free(&rs);
+        if (resolved)
+        {
+            memcpy(cursor, sc.head, (size_t)ra->max_vreg * sizeof(int));
+            split_rewrite(&sc, cursor);
+            ra->func->stack_size = ra->next_spill_offset;
+            result = SPLIT_RESULT_DONE;
+        }
+        free(cursor);
+    }
+
+    free(tails);
+    free(tail_index);
+    split_ctx_free(&sc);
+    return result;
+}
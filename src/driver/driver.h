@@ -14,6 +14,7 @@
 #include "../middleend/ir_optimizer.h"
 #include "../backend/target.h"
 #include "../support/runtime_checks.h"
+#include "../support/session.h"
 
 /**
  * @brief أكواد الخروج الثابتة لعقد compiler-cli-v1.
@@ -32,10 +33,12 @@ typedef enum
 {
     BAA_ASSEMBLER_GAS = 0,
     BAA_ASSEMBLER_NAZM = 1,
+    BAA_ASSEMBLER_ELF = 2, // كاتب كائنات ELF64 الأصلي داخل العملية
 } BaaAssemblerKind;
 
 typedef struct
 {
+    BaaSession* session; // جلسة الترجمة التي تملك حالة التشخيص والتحليل
     bool header_check;  // --check-header: فحص الترويسة دون توليد كود
     bool check_only;    // --check: فحص المصدر نحوياً ودلالياً دون توليد كود
     bool diagnostics_json; // --diagnostics=json: إخراج التشخيصات بصيغة JSON
@@ -51,7 +54,7 @@ typedef struct
     bool assembly_only; // -S: إنتاج كود تجميع فقط
     bool emit_nazm;     // --emit-nazm: إصدار مصدر نظم العربي فقط
     char *nazm_shadow_executable; // --nazm-shadow=<path>: مسار مجمّع نظم لمسار الظل
-    BaaAssemblerKind assembler; // --assembler=gas|nazm
+    BaaAssemblerKind assembler; // --assembler=gas|nazm|elf
     bool assembler_explicit; // هل اختار المستخدم المجمّع صراحة؟
     char *nazm_executable; // --nazm-path=<path> أو BAA_NAZM أو نظم من PATH
     bool nazm_in_process; // --نظم-داخل-العملية (يتطلب دعم nazm-api-v1 في البناء)
@@ -65,14 +68,20 @@ typedef struct
     bool verify_ssa;    // --verify-ssa: التحقق من صحة SSA
     bool verify_gate;   // --verify-gate: بوابة تحقق داخل المُحسِّن
     bool time_phases;   // --time-phases: قياس أزمنة المراحل
+    bool regalloc_stats; // --regalloc-stats: إحصاءات التسريب لكل دالة
+    bool opt_stats;     // --opt-stats: إصابات/إخفاقات كاش التحليلات + إحصاءات كل دالة
+    const char *opt_pipeline; // --opt-pipeline=<list>: ترتيب تمريرات مخصص (NULL = الافتراضي)
     bool debug_info;    // --debug-info: إصدار معلومات ديبغ
     bool runtime_checks; // -fruntime-checks: تفعيل أي فحص وقت تشغيل اختياري
     unsigned runtime_check_mask; // قناع فحوص وقت التشغيل الاختيارية
     bool custom_startup; // --startup=custom: استخدام نقطة دخول مخصصة (مع الحفاظ على CRT/libc)
     bool funroll_loops; // -funroll-loops
+    bool no_branch_fusion; // -fno-branch-fusion: إبقاء setcc/test/jne على مسار GAS كما يستقبله نظم
     bool incremental;   // --incremental: تفعيل إعادة استخدام كائنات البناء عند الأمان
     char *build_manifest_file; // ملف بيان البناء (--emit-build-manifest)
     char *cache_dir;    // مجلد كاش البناء (--cache-dir)
+    int jobs;           // -j N / --jobs=N: عدد وحدات الترجمة المتزامنة (<=1 = تسلسلي)
+    int threads;        // --threads=N: خيوط توزيع دوال الوحدة الواحدة (0 = من -j لمدخل واحد)
     OptLevel opt_level; // -O0/-O1/-O2
     const BaaTarget* target; // --target=...
     BaaCodegenOptions codegen_opts;
@@ -94,11 +103,19 @@ typedef struct
     double regalloc_s;
     double emit_s;
     double assemble_s;
+    double assemble_io_s;     // جزء assemble_s في قراءة/كتابة الملفات؛ الباقي ترميز
     double link_s;
 
     size_t ir_arena_used_max;
     size_t ir_arena_cap_max;
     size_t ir_arena_chunks_max;
+
+    size_t ast_arena_used_max;
+    size_t ast_arena_cap_max;
+    size_t ast_arena_chunks_max;
+
+    size_t source_loads;      // ملفات تضمين حُمّلت من القرص
+    size_t source_cache_hits; // ملفات تضمين خُدمت من الذاكرة المخبئية
 } CompilerPhaseTimes;
 
 #endif // BAA_DRIVER_H
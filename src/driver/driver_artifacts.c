@@ -6,6 +6,7 @@
 #include "driver_artifacts.h"
 
 #include <stdio.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 
 #ifdef _WIN32
@@ -18,10 +19,10 @@ char* driver_make_temp_artifact_path(const char* base,
                                      const char* prefix,
                                      const char* extension)
 {
-    static unsigned long artifact_counter = 0;
+    static atomic_ulong artifact_counter = 0;
     if (!base || !prefix || !extension) return NULL;
 
-    unsigned long artifact_id = ++artifact_counter;
+    unsigned long artifact_id = atomic_fetch_add(&artifact_counter, 1) + 1;
 #ifdef _WIN32
     unsigned long process_id = (unsigned long)_getpid();
 #else
@@ -0,0 +1,145 @@
+/**
+ * @file driver_assemble_queue.c
+ * @brief طابور تجميع GAS المتداخل مع ترجمة الوحدات التالية.
+ */
+
+#include "driver_assemble_queue.h"
+
+#include "process.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DRIVER_ASSEMBLE_DEFAULT_MIN 2
+#define DRIVER_ASSEMBLE_DEFAULT_MAX 8
+
+static char *driver_assemble_strdup(const char *text)
+{
+    size_t n = strlen(text);
+    char *out = (char *)malloc(n + 1u);
+    if (!out) return NULL;
+    memcpy(out, text, n + 1u);
+    return out;
+}
+
+int driver_assemble_queue_limit(const CompilerConfig *config)
+{
+    if (!config) return 1;
+    if (config->jobs >= 1) return config->jobs;
+    int cpus = baa_process_cpu_count();
+    if (cpus < DRIVER_ASSEMBLE_DEFAULT_MIN) return DRIVER_ASSEMBLE_DEFAULT_MIN;
+    if (cpus > DRIVER_ASSEMBLE_DEFAULT_MAX) return DRIVER_ASSEMBLE_DEFAULT_MAX;
+    return cpus;
+}
+
+bool driver_assemble_queue_init(DriverAssembleQueue *queue,
+                                const CompilerConfig *config,
+                                CompilerPhaseTimes *times,
+                                DriverBuildManifest *manifest)
+{
+    if (!queue) return false;
+    memset(queue, 0, sizeof(*queue));
+    int limit = driver_assemble_queue_limit(config);
+    if (limit <= 1) return false;
+
+    queue->entries = (DriverAssembleEntry *)calloc((size_t)limit, sizeof(*queue->entries));
+    if (!queue->entries) return false;
+    queue->config = config;
+    queue->times = times;
+    queue->manifest = manifest;
+    queue->limit = limit;
+    queue->rc = BAA_COMPILER_EXIT_SUCCESS;
+    return true;
+}
+
+static void driver_assemble_entry_release(const CompilerConfig *config,
+                                          DriverAssembleEntry *entry,
+                                          bool delete_object)
+{
+    if (!config->verbose) (void)driver_toolchain_delete_file_utf8(entry->asm_file);
+    if (delete_object && entry->obj_file)
+        (void)driver_toolchain_delete_file_utf8(entry->obj_file);
+    free(entry->asm_file);
+    free(entry->obj_file);
+    memset(entry, 0, sizeof(*entry));
+}
+
+/**
+ * @brief انتظار أقدم تجميع جارٍ، ونسخ كائنه للكاش إن لم يسبقه فشل.
+ *
+ * لا يُبلَّغ إلا عن أول فشل، كما في التجميع المتزامن الذي يتوقف عنده.
+ */
+static void driver_assemble_queue_pop(DriverAssembleQueue *queue, bool discard)
+{
+    DriverAssembleEntry *entry = &queue->entries[queue->head];
+    queue->head = (queue->head + 1) % queue->limit;
+    queue->count--;
+
+    if (discard || queue->rc != BAA_COMPILER_EXIT_SUCCESS)
+    {
+        // فشل سابق أنهى البناء: يُنتظر التجميع لتحرير العملية فقط ويُحذف كائنه.
+        BaaProcessResult ignored;
+        (void)baa_process_wait(&entry->assembly.process, &ignored);
+        driver_assemble_entry_release(queue->config, entry, true);
+        return;
+    }
+
+    BaaCompilerExitCode rc =
+        driver_toolchain_assemble_finish(queue->config, queue->times, &entry->assembly);
+    if (rc == BAA_COMPILER_EXIT_SUCCESS &&
+        entry->manifest_unit != DRIVER_ASSEMBLE_NO_UNIT &&
+        !driver_build_store_object(queue->config, queue->manifest,
+                                   entry->manifest_unit, entry->obj_file))
+    {
+        fprintf(stderr, "خطأ: فشل تحديث بيان/كاش البناء.\n");
+        rc = BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
+    }
+    queue->rc = rc;
+    driver_assemble_entry_release(queue->config, entry, rc != BAA_COMPILER_EXIT_SUCCESS);
+}
+
+BaaCompilerExitCode driver_assemble_queue_submit(DriverAssembleQueue *queue,
+                                                 char *asm_file,
+                                                 const char *obj_file,
+                                                 size_t manifest_unit)
+{
+    if (!queue || !queue->entries || !asm_file || !obj_file)
+    {
+        free(asm_file);
+        return BAA_COMPILER_EXIT_INTERNAL_ERROR;
+    }
+    if (queue->count == queue->limit)
+        driver_assemble_queue_pop(queue, false);
+
+    DriverAssembleEntry *entry =
+        &queue->entries[(queue->head + queue->count) % queue->limit];
+    entry->asm_file = asm_file;
+    entry->obj_file = driver_assemble_strdup(obj_file);
+    entry->manifest_unit = manifest_unit;
+    BaaCompilerExitCode rc = entry->obj_file
+        ? driver_toolchain_assemble_start(queue->config, queue->times,
+                                          entry->asm_file, entry->obj_file,
+                                          &entry->assembly)
+        : BAA_COMPILER_EXIT_INTERNAL_ERROR;
+    if (rc != BAA_COMPILER_EXIT_SUCCESS)
+    {
+        if (!entry->obj_file) fprintf(stderr, "خطأ: نفدت الذاكرة.\n");
+        if (queue->rc == BAA_COMPILER_EXIT_SUCCESS) queue->rc = rc;
+        driver_assemble_entry_release(queue->config, entry, false);
+        return queue->rc;
+    }
+    queue->count++;
+    return queue->rc;
+}
+
+BaaCompilerExitCode driver_assemble_queue_finish(DriverAssembleQueue *queue, bool discard)
+{
+    if (!queue || !queue->entries) return BAA_COMPILER_EXIT_SUCCESS;
+    while (queue->count > 0)
+        driver_assemble_queue_pop(queue, discard);
+    BaaCompilerExitCode rc = queue->rc;
+    free(queue->entries);
+    memset(queue, 0, sizeof(*queue));
+    return rc;
+}
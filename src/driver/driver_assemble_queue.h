@@ -0,0 +1,81 @@
+/**
+ * @file driver_assemble_queue.h
+ * @brief طابور تجميع GAS: إطلاق gcc -c لوحدة والمضي في ترجمة التالية.
+ *
+ * تبقى ترجمة الوحدات تسلسلية، لكن ملف .s لكل وحدة يُسلَّم لعملية gcc -c
+ * تعمل في الخلفية بحد أقصى للعمليات المتزامنة. تُنتظر العمليات بترتيب
+ * إطلاقها، فيبقى ترتيب الكائنات وبيان البناء مطابقاً للتجميع المتزامن.
+ */
+
+#ifndef BAA_DRIVER_ASSEMBLE_QUEUE_H
+#define BAA_DRIVER_ASSEMBLE_QUEUE_H
+
+#include "driver.h"
+#include "driver_build.h"
+#include "driver_toolchain.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** قيمة manifest_unit لتجميع لا يملك سجلاً في بيان البناء (مثل كائن البدء). */
+#define DRIVER_ASSEMBLE_NO_UNIT SIZE_MAX
+
+typedef struct
+{
+    DriverAssembly assembly;
+    char *asm_file;
+    char *obj_file;
+    size_t manifest_unit;
+} DriverAssembleEntry;
+
+typedef struct
+{
+    const CompilerConfig *config;
+    CompilerPhaseTimes *times;
+    DriverBuildManifest *manifest;
+    DriverAssembleEntry *entries; // حلقة بسعة limit
+    int limit;
+    int head;
+    int count;
+    BaaCompilerExitCode rc; // أول فشل؛ لا تُنسخ كائنات للكاش بعده
+} DriverAssembleQueue;
+
+/**
+ * @brief عدد عمليات gcc -c المتزامنة: -j N إن حُدد، وإلا عدد المعالجات (2..8).
+ *
+ * يُرجع 1 مع -j 1، أي تجميعاً متزامناً بلا طابور.
+ */
+int driver_assemble_queue_limit(const CompilerConfig *config);
+
+/**
+ * @brief تهيئة طابور بسعة driver_assemble_queue_limit().
+ *
+ * @return false إن كانت السعة 1 أو نفدت الذاكرة؛ يبقى التجميع حينها متزامناً.
+ */
+bool driver_assemble_queue_init(DriverAssembleQueue *queue,
+                                const CompilerConfig *config,
+                                CompilerPhaseTimes *times,
+                                DriverBuildManifest *manifest);
+
+/**
+ * @brief إطلاق تجميع asm_file إلى obj_file، بعد انتظار الأقدم إن امتلأ الطابور.
+ *
+ * يملك الطابور asm_file دائماً ويحذفه بعد التجميع (إلا مع -v)، وينسخ obj_file.
+ * عند الاكتمال يُنسخ الكائن للكاش إن كان manifest_unit سجلاً في البيان.
+ *
+ * @return أول فشل سابق أو فشل الإطلاق؛ يتوقف المستدعي عندها عن الترجمة.
+ */
+BaaCompilerExitCode driver_assemble_queue_submit(DriverAssembleQueue *queue,
+                                                 char *asm_file,
+                                                 const char *obj_file,
+                                                 size_t manifest_unit);
+
+/**
+ * @brief انتظار كل التجميعات الجارية بترتيبها ثم تحرير الطابور.
+ *
+ * مع discard (فشل في الترجمة) تُحذف كائنات التجميعات المنتظرة.
+ * @return أول فشل تجميع، أو نجاح.
+ */
+BaaCompilerExitCode driver_assemble_queue_finish(DriverAssembleQueue *queue, bool discard);
+
+#endif // BAA_DRIVER_ASSEMBLE_QUEUE_H
@@ -152,6 +152,16 @@ static void hash_string(uint64_t* h, const char* text)
     *h = fnv1a_update(*h, (const unsigned char*)"\n", 1u);
 }
 
+/**
+ * @brief اسم المجمّع كما يظهر في بصمة الذاكرة المؤقتة والبيان.
+ */
+static const char* build_assembler_name(const CompilerConfig* config)
+{
+    if (config && config->assembler == BAA_ASSEMBLER_NAZM) return "nazm";
+    if (config && config->assembler == BAA_ASSEMBLER_ELF) return "elf";
+    return "gas";
+}
+
 static void build_slot_hex(const CompilerConfig* config, const char* source, char out[17])
 {
     uint64_t h = BAA_HASH_OFFSET;
@@ -161,9 +171,7 @@ static void build_slot_hex(const CompilerConfig* config, const char* source, cha
     hash_string(&h,
                 driver_nazm_is_source_path(source)
                     ? "nazm-input"
-                    : config && config->assembler == BAA_ASSEMBLER_NAZM
-                    ? "nazm"
-                    : "gas");
+                    : build_assembler_name(config));
     if (config && config->nazm_fingerprint &&
         (driver_nazm_is_source_path(source) ||
          config->assembler == BAA_ASSEMBLER_NAZM))
@@ -172,15 +180,18 @@ static void build_slot_hex(const CompilerConfig* config, const char* source, cha
     char tmp[128];
     snprintf(tmp,
              sizeof(tmp),
-             "O=%d;dbg=%d;pic=%d;pie=%d;sp=%d;cm=%d;unroll=%d",
+             "O=%d;dbg=%d;pic=%d;pie=%d;sp=%d;cm=%d;unroll=%d;ra=%d",
              config ? (int)config->opt_level : 0,
              config ? (int)config->debug_info : 0,
              config ? (int)config->codegen_opts.pic : 0,
              config ? (int)config->codegen_opts.pie : 0,
              config ? (int)config->codegen_opts.stack_protector : 0,
              config ? (int)config->codegen_opts.code_model : 0,
-             config ? (int)config->funroll_loops : 0);
+             config ? (int)config->funroll_loops : 0,
+             config ? (int)config->codegen_opts.regalloc : 0);
     hash_string(&h, tmp);
+    if (config && config->opt_pipeline)
+        hash_string(&h, config->opt_pipeline);
     snprintf(tmp,
              sizeof(tmp),
              "rtchecks=%u",
@@ -257,7 +268,7 @@ void driver_build_manifest_free(DriverBuildManifest* manifest)
     manifest->unit_capacity = 0;
 }
 
-static DriverBuildUnitRecord* manifest_add_unit(DriverBuildManifest* manifest)
+DriverBuildUnitRecord* driver_build_manifest_add_unit(DriverBuildManifest* manifest)
 {
     if (!manifest) return NULL;
     if (manifest->unit_count >= manifest->unit_capacity) {
@@ -273,6 +284,19 @@ static DriverBuildUnitRecord* manifest_add_unit(DriverBuildManifest* manifest)
     return unit;
 }
 
+bool driver_build_manifest_take_units(DriverBuildManifest* dst, DriverBuildManifest* src)
+{
+    if (!dst || !src) return false;
+    for (size_t i = 0; i < src->unit_count; ++i) {
+        DriverBuildUnitRecord* unit = driver_build_manifest_add_unit(dst);
+        if (!unit) return false;
+        *unit = src->units[i];
+        memset(&src->units[i], 0, sizeof(src->units[i]));
+    }
+    driver_build_manifest_free(src);
+    return true;
+}
+
 static int dep_cmp(const void* a, const void* b)
 {
     const DriverBuildDep* da = (const DriverBuildDep*)a;
@@ -342,7 +366,7 @@ static bool add_record(DriverBuildManifest* manifest,
                        const char* reason)
 {
     if (!manifest) return true;
-    DriverBuildUnitRecord* unit = manifest_add_unit(manifest);
+    DriverBuildUnitRecord* unit = driver_build_manifest_add_unit(manifest);
     if (!unit) return false;
 
     unit->source = driver_build_canonical_path(input_file);
@@ -352,11 +376,7 @@ static bool add_record(DriverBuildManifest* manifest,
     bool nazm_input = driver_nazm_is_source_path(input_file);
     unit->source_kind = driver_build_strdup(nazm_input ? "nazm" : "baa");
     unit->assembler = driver_build_strdup(
-        nazm_input
-            ? "nazm"
-            : config && config->assembler == BAA_ASSEMBLER_NAZM
-                ? "nazm"
-                : "gas");
+        nazm_input ? "nazm" : build_assembler_name(config));
     unit->cache_enabled = cache_enabled;
     unit->cache_hit = cache_hit;
     unit->cache_reason = driver_build_strdup(reason ? reason : "");
@@ -565,22 +585,17 @@ static bool write_cache_meta(const char* meta_path,
     return true;
 }
 
-bool driver_build_update_cache(const CompilerConfig* config,
-                               const char* input_file,
-                               const char* obj_file,
-                               const char* const* dep_paths,
-                               size_t dep_count,
-                               DriverBuildManifest* manifest)
+bool driver_build_record_object(const CompilerConfig* config,
+                                const char* input_file,
+                                const char* obj_file,
+                                const char* const* dep_paths,
+                                size_t dep_count,
+                                DriverBuildManifest* manifest,
+                                size_t* out_unit_index)
 {
+    if (!manifest || !out_unit_index) return false;
     bool cache_allowed = driver_build_cache_is_allowed(config);
-    DriverBuildManifest local_manifest;
-    DriverBuildManifest* target_manifest = manifest;
-    if (!target_manifest) {
-        driver_build_manifest_init(&local_manifest);
-        target_manifest = &local_manifest;
-    }
-
-    if (!add_record(target_manifest,
+    if (!add_record(manifest,
                     config,
                     input_file,
                     obj_file,
@@ -589,32 +604,30 @@ bool driver_build_update_cache(const CompilerConfig* config,
                     cache_allowed,
                     false,
                     cache_allowed ? "miss" : "bypass")) {
-        if (!manifest) driver_build_manifest_free(&local_manifest);
         return false;
     }
+    *out_unit_index = manifest->unit_count - 1u;
+    return true;
+}
 
-    if (!cache_allowed || target_manifest->unit_count == 0) {
-        if (!manifest) driver_build_manifest_free(&local_manifest);
-        return true;
-    }
-    DriverBuildUnitRecord* unit = &target_manifest->units[target_manifest->unit_count - 1u];
-    if (!unit->cache_slot) {
-        if (!manifest) driver_build_manifest_free(&local_manifest);
-        return false;
-    }
+bool driver_build_store_object(const CompilerConfig* config,
+                               const DriverBuildManifest* manifest,
+                               size_t unit_index,
+                               const char* obj_file)
+{
+    if (!driver_build_cache_is_allowed(config)) return true;
+    if (!manifest || unit_index >= manifest->unit_count) return false;
+    const DriverBuildUnitRecord* unit = &manifest->units[unit_index];
+    if (!unit->cache_slot) return false;
 
     const char* cache_dir = cache_dir_or_default(config);
-    if (!ensure_dir_recursive(cache_dir)) {
-        if (!manifest) driver_build_manifest_free(&local_manifest);
-        return false;
-    }
+    if (!ensure_dir_recursive(cache_dir)) return false;
 
     char* cache_obj = join_cache_path(config, unit->cache_slot, ".o");
     char* cache_meta = join_cache_path(config, unit->cache_slot, ".json");
     if (!cache_obj || !cache_meta) {
         free(cache_obj);
         free(cache_meta);
-        if (!manifest) driver_build_manifest_free(&local_manifest);
         return false;
     }
 
@@ -622,6 +635,32 @@ bool driver_build_update_cache(const CompilerConfig* config,
     if (ok) ok = write_cache_meta(cache_meta, cache_obj, unit);
     free(cache_obj);
     free(cache_meta);
+    return ok;
+}
+
+bool driver_build_update_cache(const CompilerConfig* config,
+                               const char* input_file,
+                               const char* obj_file,
+                               const char* const* dep_paths,
+                               size_t dep_count,
+                               DriverBuildManifest* manifest)
+{
+    DriverBuildManifest local_manifest;
+    DriverBuildManifest* target_manifest = manifest;
+    if (!target_manifest) {
+        driver_build_manifest_init(&local_manifest);
+        target_manifest = &local_manifest;
+    }
+
+    size_t unit_index = 0;
+    bool ok = driver_build_record_object(config,
+                                         input_file,
+                                         obj_file,
+                                         dep_paths,
+                                         dep_count,
+                                         target_manifest,
+                                         &unit_index) &&
+              driver_build_store_object(config, target_manifest, unit_index, obj_file);
     if (!manifest) driver_build_manifest_free(&local_manifest);
     return ok;
 }
@@ -672,9 +711,7 @@ bool driver_build_write_manifest(const CompilerConfig* config,
     fprintf(out, "\",\n  \"mode\": \"%s\",\n", mode);
     fprintf(out,
             "  \"assembler\": \"%s\",\n",
-            config && config->assembler == BAA_ASSEMBLER_NAZM
-                ? "nazm"
-                : "gas");
+            build_assembler_name(config));
     fputs("  \"assembler_fingerprint\": \"", out);
     json_escape(out,
                 config && config->nazm_fingerprint
@@ -35,6 +35,12 @@ typedef struct DriverBuildManifest {
 void driver_build_manifest_init(DriverBuildManifest* manifest);
 void driver_build_manifest_free(DriverBuildManifest* manifest);
 
+/** إلحاق سجل وحدة فارغ (مُصفّر) بنهاية البيان. */
+DriverBuildUnitRecord* driver_build_manifest_add_unit(DriverBuildManifest* manifest);
+
+/** نقل كل سجلات src إلى نهاية dst بالترتيب، ثم تفريغ src. */
+bool driver_build_manifest_take_units(DriverBuildManifest* dst, DriverBuildManifest* src);
+
 bool driver_build_cache_is_allowed(const CompilerConfig* config);
 
 char* driver_build_default_cache_dir(void);
@@ -52,6 +58,25 @@ bool driver_build_update_cache(const CompilerConfig* config,
                                size_t dep_count,
                                DriverBuildManifest* manifest);
 
+/**
+ * @brief تسجيل كائن وحدة في البيان دون نسخه للكاش (الكائن قد لا يكون جاهزاً بعد).
+ *
+ * يُرجع موضع السجل في out_unit_index لتمريره إلى driver_build_store_object().
+ */
+bool driver_build_record_object(const CompilerConfig* config,
+                                const char* input_file,
+                                const char* obj_file,
+                                const char* const* dep_paths,
+                                size_t dep_count,
+                                DriverBuildManifest* manifest,
+                                size_t* out_unit_index);
+
+/** نسخ كائن وحدة سُجلت بـ driver_build_record_object() إلى الكاش بعد اكتماله. */
+bool driver_build_store_object(const CompilerConfig* config,
+                               const DriverBuildManifest* manifest,
+                               size_t unit_index,
+                               const char* obj_file);
+
 bool driver_build_record_uncached(const CompilerConfig* config,
                                   const char* input_file,
                                   const char* output_file,
@@ -102,19 +102,21 @@ static bool parse_warning_flag(const char *flag)
         const WarnFlagSpec* spec = &k_warn_flag_specs[i];
         if (strcmp(flag, spec->flag) != 0) continue;
 
+        WarningConfig* warnings = diagnostics_warning_config();
+
         switch (spec->action)
         {
             case WARN_PARSE_SET_ALL:
-                g_warning_config.all_warnings = spec->value;
+                warnings->all_warnings = spec->value;
                 break;
             case WARN_PARSE_SET_AS_ERRORS:
-                g_warning_config.warnings_as_errors = spec->value;
+                warnings->warnings_as_errors = spec->value;
                 break;
             case WARN_PARSE_SET_COLOR:
-                g_warning_config.colored_output = spec->value;
+                warnings->colored_output = spec->value;
                 break;
             case WARN_PARSE_SET_SPECIFIC:
-                g_warning_config.enabled[spec->warning_type] = spec->value;
+                warnings->enabled[spec->warning_type] = spec->value;
                 break;
             default:
                 return false;
@@ -125,6 +127,23 @@ static bool parse_warning_flag(const char *flag)
     return false;
 }
 
+/**
+ * @brief تحليل عدد المهام المتزامنة لـ -j/--jobs (عدد صحيح موجب).
+ */
+static bool parse_jobs_count(const char* text, int* out_jobs)
+{
+    if (!text || !text[0] || !out_jobs) return false;
+
+    char* end = NULL;
+    errno = 0;
+    const long value = strtol(text, &end, 10);
+    if (errno == ERANGE || !end || *end != '\0' || value < 1 || value > 1024)
+        return false;
+
+    *out_jobs = (int)value;
+    return true;
+}
+
 static void parse_release_temp_arrays(char** inputs, const char** include_dirs)
 {
     free(inputs);
@@ -218,11 +237,13 @@ bool driver_parse_cli(int argc, char **argv, CompilerConfig *config, DriverParse
                     config->assembler = BAA_ASSEMBLER_GAS;
                 else if (strcmp(assembler, "nazm") == 0)
                     config->assembler = BAA_ASSEMBLER_NAZM;
+                else if (strcmp(assembler, "elf") == 0)
+                    config->assembler = BAA_ASSEMBLER_ELF;
                 else
                 {
                     fprintf(stderr,
                             "خطأ: قيمة --assembler غير معروفة '%s' "
-                            "(المتوقع gas أو nazm).\n",
+                            "(المتوقع gas أو nazm أو elf).\n",
                             assembler);
                     parse_release_temp_arrays(inputs, include_dirs);
                     return false;
@@ -425,10 +446,66 @@ bool driver_parse_cli(int argc, char **argv, CompilerConfig *config, DriverParse
                     return false;
                 }
             }
+            else if (strncmp(arg, "-j", 2) == 0 || strncmp(arg, "--jobs=", 7) == 0)
+            {
+                const char* value_text = NULL;
+                if (strcmp(arg, "-j") == 0)
+                    value_text = (i + 1 < argc) ? argv[++i] : NULL;
+                else if (arg[1] == 'j')
+                    value_text = arg + 2;
+                else
+                    value_text = arg + 7;
+
+                if (!parse_jobs_count(value_text, &config->jobs))
+                {
+                    fprintf(stderr, "Error: -j/--jobs requires a job count between 1 and 1024\n");
+                    parse_release_temp_arrays(inputs, include_dirs);
+                    return false;
+                }
+            }
+            else if (strncmp(arg, "--threads=", 10) == 0)
+            {
+                if (!parse_jobs_count(arg + 10, &config->threads))
+                {
+                    fprintf(stderr, "Error: --threads requires a thread count between 1 and 1024\n");
+                    parse_release_temp_arrays(inputs, include_dirs);
+                    return false;
+                }
+            }
             else if (strcmp(arg, "--debug-info") == 0)
                 config->debug_info = true;
             else if (strcmp(arg, "--asm-comments") == 0)
                 config->codegen_opts.asm_comments = true;
+            else if (strncmp(arg, "--regalloc=", 11) == 0)
+            {
+                const char *m = arg + 11;
+                if (strcmp(m, "linear") == 0)
+                    config->codegen_opts.regalloc = BAA_REGALLOC_LINEAR;
+                else if (strcmp(m, "split") == 0)
+                    config->codegen_opts.regalloc = BAA_REGALLOC_SPLIT;
+                else
+                {
+                    fprintf(stderr,
+                            "Error: Unknown register allocator '%s' (expected: linear, split)\n",
+                            m);
+                    parse_release_temp_arrays(inputs, include_dirs);
+                    return false;
+                }
+            }
+            else if (strcmp(arg, "--regalloc-stats") == 0)
+                config->regalloc_stats = true;
+            else if (strcmp(arg, "--opt-stats") == 0)
+                config->opt_stats = true;
+            else if (strncmp(arg, "--opt-pipeline=", 15) == 0)
+            {
+                // التحقق هنا حتى يفشل الاستدعاء قبل أي ترجمة؛ كل وحدة تمرره في IROptimizerOptions.
+                if (!ir_optimizer_validate_pipeline(arg + 15, stderr))
+                {
+                    parse_release_temp_arrays(inputs, include_dirs);
+                    return false;
+                }
+                config->opt_pipeline = arg[15] ? arg + 15 : NULL;
+            }
             else if (strcmp(arg, "-fruntime-checks") == 0)
             {
                 config->runtime_checks = true;
@@ -514,6 +591,8 @@ bool driver_parse_cli(int argc, char **argv, CompilerConfig *config, DriverParse
                 config->opt_level = OPT_LEVEL_2;
             else if (strcmp(arg, "-funroll-loops") == 0)
                 config->funroll_loops = true;
+            else if (strcmp(arg, "-fno-branch-fusion") == 0)
+                config->no_branch_fusion = true;
             else if (strcmp(arg, "-o") == 0)
             {
                 if (i + 1 < argc)
@@ -826,6 +905,22 @@ bool driver_parse_cli(int argc, char **argv, CompilerConfig *config, DriverParse
         parse_release_temp_arrays(inputs, include_dirs);
         return false;
     }
+    if (config->assembler == BAA_ASSEMBLER_ELF)
+    {
+        const char *elf_error = NULL;
+        if (config->target && config->target->obj_format != BAA_OBJFORMAT_ELF)
+            elf_error = "خطأ: --assembler=elf يكتب كائنات ELF64 فقط؛ استخدم gas أو nazm لهدف COFF.\n";
+        else if (config->debug_info)
+            elf_error = "خطأ: --assembler=elf لا يكتب معلومات DWARF؛ استخدم --assembler=gas مع --debug-info.\n";
+        else if (config->nazm_shadow_executable)
+            elf_error = "خطأ: --nazm-shadow يقارن مسار GAS بمسار نظم ولا يجتمع مع --assembler=elf.\n";
+        if (elf_error)
+        {
+            fputs(elf_error, stderr);
+            parse_release_temp_arrays(inputs, include_dirs);
+            return false;
+        }
+    }
     if (config->nazm_shadow_executable && !config->assembler_explicit)
     {
         /*
@@ -21,6 +21,7 @@
 #include "driver_toolchain.h"
 #include "driver_nazm.h"
 #include "driver_startup.h"
+#include "driver_assemble_queue.h"
 #include "driver_symbols.h"
 #include "driver_tokens.h"
 #include "driver_structure.h"
@@ -31,17 +32,23 @@
 #include "../support/version.h"
 #include "../support/file_io.h"
 #include "../support/read_file.h"
+#include "../support/source_cache.h"
+#include "../support/text_scan.h"
 #include "../support/diagnostics.h"
+#include "../support/session.h"
 #include "../support/updater.h"
 #include "../frontend/lexer.h"
 #include "../frontend/parser.h"
 #include "../frontend/analysis.h"
 #include "../backend/emit.h"
+#include "../backend/emit_elf.h"
 #include "../backend/emit_nazm.h"
 #include "../backend/isel.h"
 #include "../backend/regalloc.h"
+#include "../backend/block_layout.h"
 #include "../middleend/ir_arena.h"
 #include "../middleend/ir_lower.h"
+#include "../middleend/ir_analysis_manager.h"
 #include "../middleend/ir_optimizer.h"
 #include "../middleend/ir_outssa.h"
 #include "../middleend/ir_unroll.h"
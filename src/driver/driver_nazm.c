@@ -12,6 +12,7 @@
 
 #include <ctype.h>
 #include <limits.h>
+#include <stdatomic.h>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -283,7 +284,8 @@ static bool driver_nazm_read_bytes(const char *path,
 }
 
 static void driver_nazm_report_api_diagnostics(const NazmResult *result,
-                                               const char *source_map_path)
+                                               const char *source_map_path,
+                                               const char *source_map_text)
 {
     if (!result) return;
     for (size_t i = 0; i < result->diagnostic_count; ++i)
@@ -299,12 +301,22 @@ static void driver_nazm_report_api_diagnostics(const NazmResult *result,
         char *source_file = NULL;
         unsigned source_line = 0;
         unsigned source_col = 0;
-        if (source_map_path && diagnostic->line > 0 &&
-            driver_nazm_lookup_source_map(source_map_path,
-                                           (unsigned)diagnostic->line,
-                                           &source_file,
-                                           &source_line,
-                                           &source_col))
+        bool mapped = false;
+        if (diagnostic->line > 0)
+        {
+            mapped = source_map_text
+                ? driver_nazm_lookup_source_map_text(source_map_text,
+                                                     (unsigned)diagnostic->line,
+                                                     &source_file,
+                                                     &source_line,
+                                                     &source_col)
+                : driver_nazm_lookup_source_map(source_map_path,
+                                                (unsigned)diagnostic->line,
+                                                &source_file,
+                                                &source_line,
+                                                &source_col);
+        }
+        if (mapped)
         {
             fprintf(stderr,
                     "موضع باء الأصلي: %s:%u:%u (من سطر نظم %d).\n",
@@ -317,41 +329,38 @@ static void driver_nazm_report_api_diagnostics(const NazmResult *result,
     }
 }
 
-static BaaCompilerExitCode driver_nazm_run_in_process(
+/**
+ * @brief تجميع مصدر نظم من الذاكرة وكتابة الكائن مباشرة.
+ *
+ * زمن nazm_assemble_buffer ترميز، وكتابة الكائن تُحتسب أيضاً في assemble_io.
+ * الخريطة تُمرَّر نصاً (source_map_text) أو مساراً (source_map_path).
+ */
+static BaaCompilerExitCode driver_nazm_assemble_memory(
     const CompilerConfig *config,
-    const char *source_path,
+    CompilerPhaseTimes *times,
+    uint8_t *source,
+    size_t source_size,
     const char *source_map_path,
+    const char *source_map_text,
     const char *object_path,
     const char *logical_source_name,
     bool user_source)
 {
-    if (!config || !source_path || !object_path)
-        return BAA_COMPILER_EXIT_INTERNAL_ERROR;
-    uint8_t *source = NULL;
-    size_t source_size = 0u;
-    if (!driver_nazm_read_bytes(source_path, &source, &source_size))
-    {
-        fprintf(stderr, "خطأ: تعذرت قراءة مصدر نظم '%s'.\n", source_path);
-        return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
-    }
-
+    bool timed = times && config->time_phases;
+    double started = timed ? driver_time_seconds() : 0.0;
     NazmOptions options = nazm_default_options();
     options.format = config->target &&
                      config->target->obj_format == BAA_OBJFORMAT_COFF
         ? NAZM_FORMAT_COFF
         : NAZM_FORMAT_ELF64;
     NazmResult result = nazm_assemble_buffer(
-        source,
-        source_size,
-        logical_source_name && logical_source_name[0]
-            ? logical_source_name
-            : source_path,
-        options);
-    free(source);
+        source, source_size, logical_source_name, options);
+    double encoded = timed ? driver_time_seconds() : 0.0;
+    if (timed) times->assemble_s += encoded - started;
 
     if (result.status != NAZM_STATUS_OK)
     {
-        driver_nazm_report_api_diagnostics(&result, source_map_path);
+        driver_nazm_report_api_diagnostics(&result, source_map_path, source_map_text);
         NazmStatus status = result.status;
         nazm_result_free(&result);
         if (status == NAZM_STATUS_OUT_OF_MEMORY ||
@@ -363,12 +372,16 @@ static BaaCompilerExitCode driver_nazm_run_in_process(
         return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
     }
 
-    FILE *object = baa_fopen_utf8(object_path, "wb");
-    bool written = object &&
-        fwrite(result.object_data, 1u, result.object_size, object) ==
-            result.object_size;
-    if (object && fclose(object) != 0) written = false;
+    bool written = driver_toolchain_write_file_utf8(object_path,
+                                                    result.object_data,
+                                                    result.object_size);
     nazm_result_free(&result);
+    if (timed)
+    {
+        double finished = driver_time_seconds();
+        times->assemble_s += finished - encoded;
+        times->assemble_io_s += finished - encoded;
+    }
     if (!written)
     {
         fprintf(stderr,
@@ -379,6 +392,49 @@ static BaaCompilerExitCode driver_nazm_run_in_process(
     }
     return BAA_COMPILER_EXIT_SUCCESS;
 }
+
+static BaaCompilerExitCode driver_nazm_run_in_process(
+    const CompilerConfig *config,
+    CompilerPhaseTimes *times,
+    const char *source_path,
+    const char *source_map_path,
+    const char *object_path,
+    const char *logical_source_name,
+    bool user_source)
+{
+    if (!config || !source_path || !object_path)
+        return BAA_COMPILER_EXIT_INTERNAL_ERROR;
+    bool timed = times && config->time_phases;
+    double started = timed ? driver_time_seconds() : 0.0;
+    uint8_t *source = NULL;
+    size_t source_size = 0u;
+    if (!driver_nazm_read_bytes(source_path, &source, &source_size))
+    {
+        fprintf(stderr, "خطأ: تعذرت قراءة مصدر نظم '%s'.\n", source_path);
+        return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
+    }
+    if (timed)
+    {
+        double read_s = driver_time_seconds() - started;
+        times->assemble_s += read_s;
+        times->assemble_io_s += read_s;
+    }
+
+    BaaCompilerExitCode rc = driver_nazm_assemble_memory(
+        config,
+        times,
+        source,
+        source_size,
+        source_map_path,
+        NULL,
+        object_path,
+        logical_source_name && logical_source_name[0]
+            ? logical_source_name
+            : source_path,
+        user_source);
+    free(source);
+    return rc;
+}
 #endif
 
 static BaaCompilerExitCode driver_nazm_run_assembler(
@@ -398,17 +454,14 @@ static BaaCompilerExitCode driver_nazm_run_assembler(
 #ifdef BAA_EMBEDDED_NAZM
     if (config->nazm_in_process)
     {
-        double started = 0.0;
-        if (times && config->time_phases) started = driver_time_seconds();
         BaaCompilerExitCode rc = driver_nazm_run_in_process(
             config,
+            times,
             source_path,
             source_map_path,
             object_path,
             logical_source_name,
             user_source);
-        if (times && config->time_phases)
-            times->assemble_s += driver_time_seconds() - started;
         if (rc != BAA_COMPILER_EXIT_SUCCESS)
             (void)driver_toolchain_delete_file_utf8(object_path);
         if (!keep_source)
@@ -489,13 +542,11 @@ static BaaCompilerExitCode driver_nazm_run_assembler(
     return BAA_COMPILER_EXIT_SUCCESS;
 }
 
-BaaCompilerExitCode driver_emit_nazm_source(const CompilerConfig *config,
-                                            MachineModule *module,
-                                            const char *output_path)
+/**
+ * @brief رفض خيارات الخلفية التي لا يملك مسار نظم مكافئاً لها بعد.
+ */
+static bool driver_nazm_options_supported(const CompilerConfig *config)
 {
-    if (!config || !module || !output_path)
-        return BAA_COMPILER_EXIT_INTERNAL_ERROR;
-
     if (config->codegen_opts.stack_protector != BAA_STACKPROT_OFF)
     {
         driver_nazm_report_unsupported(
@@ -505,9 +556,39 @@ BaaCompilerExitCode driver_emit_nazm_source(const CompilerConfig *config,
             NULL,
             0,
             0);
+        return false;
+    }
+    return true;
+}
+
+static BaaCompilerExitCode driver_nazm_report_emit_failure(
+    const BaaNazmEmitResult *result,
+    const char *output_path)
+{
+    if (result->status == BAA_NAZM_EMIT_UNSUPPORTED)
+    {
+        driver_nazm_report_unsupported(result->reason,
+                                       result->blocker_kind,
+                                       result->blocker_detail,
+                                       result->source_file,
+                                       result->source_line,
+                                       result->source_col);
         return BAA_COMPILER_EXIT_UNSUPPORTED;
     }
 
+    fprintf(stderr, "خطأ: فشلت كتابة مصدر نظم '%s'.\n", output_path);
+    return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
+}
+
+BaaCompilerExitCode driver_emit_nazm_source(const CompilerConfig *config,
+                                            MachineModule *module,
+                                            const char *output_path)
+{
+    if (!config || !module || !output_path)
+        return BAA_COMPILER_EXIT_INTERNAL_ERROR;
+    if (!driver_nazm_options_supported(config))
+        return BAA_COMPILER_EXIT_UNSUPPORTED;
+
     char *source_map_path = driver_nazm_artifact_path(output_path,
                                                        ".خريطة-باء.json");
     FILE *out = baa_fopen_utf8(output_path, "wb");
@@ -544,20 +625,57 @@ BaaCompilerExitCode driver_emit_nazm_source(const CompilerConfig *config,
     (void)driver_toolchain_delete_file_utf8(output_path);
     (void)driver_toolchain_delete_file_utf8(source_map_path);
     free(source_map_path);
-    if (result.status == BAA_NAZM_EMIT_UNSUPPORTED)
-    {
-        driver_nazm_report_unsupported(result.reason,
-                                       result.blocker_kind,
-                                       result.blocker_detail,
-                                       result.source_file,
-                                       result.source_line,
-                                       result.source_col);
+    return driver_nazm_report_emit_failure(&result, output_path);
+}
+
+#ifdef BAA_EMBEDDED_NAZM
+/**
+ * @brief المسار المضمن بلا ملفات وسيطة: إصدار نظم إلى الذاكرة ثم تجميعه منها.
+ *
+ * لا يُكتب `.نظم` ولا خريطته؛ تُقرأ الخريطة من الذاكرة لتشخيصات نظم. الكائن
+ * وحده يُكتب لأن الرابط وكاش البناء يعملان على ملفات.
+ */
+static BaaCompilerExitCode driver_nazm_assemble_module_in_memory(
+    const CompilerConfig *config,
+    CompilerPhaseTimes *times,
+    MachineModule *module,
+    const char *object_path)
+{
+    static const char logical_name[] = "باء-مولد.نظم";
+    if (!driver_nazm_options_supported(config))
         return BAA_COMPILER_EXIT_UNSUPPORTED;
-    }
 
-    fprintf(stderr, "خطأ: فشلت كتابة مصدر نظم '%s'.\n", output_path);
-    return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
+    bool timed = times && config->time_phases;
+    double started = timed ? driver_time_seconds() : 0.0;
+    BaaNazmText source = {0};
+    BaaNazmText source_map = {0};
+    BaaNazmEmitResult result = emit_nazm_module_to_memory(module,
+                                                          logical_name,
+                                                          config->target,
+                                                          config->debug_info,
+                                                          &source,
+                                                          &source_map);
+    if (timed) times->emit_s += driver_time_seconds() - started;
+    if (result.status != BAA_NAZM_EMIT_OK)
+        return driver_nazm_report_emit_failure(&result, logical_name);
+
+    BaaCompilerExitCode rc = driver_nazm_assemble_memory(
+        config,
+        times,
+        (uint8_t *)source.data,
+        source.size,
+        NULL,
+        source_map.data,
+        object_path,
+        logical_name,
+        false);
+    free(source.data);
+    free(source_map.data);
+    if (rc != BAA_COMPILER_EXIT_SUCCESS)
+        (void)driver_toolchain_delete_file_utf8(object_path);
+    return rc;
 }
+#endif
 
 BaaCompilerExitCode driver_assemble_nazm_module(
     const CompilerConfig *config,
@@ -571,6 +689,11 @@ BaaCompilerExitCode driver_assemble_nazm_module(
         return BAA_COMPILER_EXIT_INTERNAL_ERROR;
 
     (void)driver_toolchain_delete_file_utf8(object_path);
+#ifdef BAA_EMBEDDED_NAZM
+    // المصدر المحفوظ (-v) وحده يحتاج ملفاً؛ غير ذلك تبقى الوحدة في الذاكرة.
+    if (config->nazm_in_process && !keep_source)
+        return driver_nazm_assemble_module_in_memory(config, times, module, object_path);
+#endif
     double started = 0.0;
     if (times && config->time_phases) started = driver_time_seconds();
     BaaCompilerExitCode emit_rc =
@@ -644,7 +767,7 @@ BaaCompilerExitCode driver_compile_nazm_input(
     DriverBuildManifest *build_manifest,
     char **out_object_path)
 {
-    static unsigned long input_counter = 0;
+    static atomic_ulong input_counter = 0;
     if (out_object_path) *out_object_path = NULL;
     if (!config || input_count <= 0 || !source_path || !times ||
         !out_object_path || !driver_nazm_is_source_path(source_path))
@@ -680,7 +803,7 @@ BaaCompilerExitCode driver_compile_nazm_input(
         int length = snprintf(suffix,
                               sizeof(suffix),
                               ".وحدة-نظم-%lu.o",
-                              ++input_counter);
+                              atomic_fetch_add(&input_counter, 1) + 1);
         if (length > 0 && (size_t)length < sizeof(suffix))
         {
             object_path = config->output_file
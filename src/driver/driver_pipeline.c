@@ -77,7 +77,9 @@ static char* driver_strdup_alloc(const char* text)
     return out;
 }
 
+#include "driver_pipeline_frontend.inc"
 #include "driver_pipeline_validation.inc"
+#include "driver_pipeline_backend.inc"
 
 static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
                                           int input_count,
@@ -85,6 +87,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
                                           CompilerPhaseTimes *phase_times,
                                           DriverBuildManifest *build_manifest,
                                           DriverOneDefinitionRegistry *odr_registry,
+                                          DriverAssembleQueue *asm_queue,
+                                          BaaThreadPool *unit_pool,
                                           char **out_obj_file,
                                           char **out_nazm_shadow_object)
 {
@@ -129,9 +133,9 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
 
     double t0 = 0.0;
     if (config->time_phases) t0 = driver_time_seconds();
-    char *source = config->source_stdin_file
-        ? read_stdin_source()
-        : read_file(current_input);
+    BaaSourceFile source_file;
+    driver_load_source(config, current_input, &source_file);
+    char *source = source_file.data;
     if (config->time_phases) phase_times->read_file_s += (driver_time_seconds() - t0);
     if (!source)
     {
@@ -142,18 +146,23 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
     if (config->source_stdin_file &&
         !driver_validate_stdin_utf8(source, current_input))
     {
-        free(source);
+        baa_source_file_release(&source_file);
         if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
         return BAA_COMPILER_EXIT_SOURCE_ERROR;
     }
 
+    BaaSourceCacheStats include_reads = {0};
+    if (config->time_phases) baa_source_cache_get_stats(&include_reads);
     if (config->time_phases) t0 = driver_time_seconds();
     Lexer lexer;
-    lexer_init(&lexer, source, current_input, config->include_dirs, config->include_dir_count);
-    Node *ast = parse(&lexer);
+    lexer_init(&lexer, config->session, source, current_input, config->include_dirs, config->include_dir_count);
+    AstArena ast_arena;
+    ast_arena_init(&ast_arena, 0);
+    Node *ast = parse(config->session, &lexer, &ast_arena);
     size_t lexer_dep_count = 0;
     const char* const* lexer_deps = lexer_get_dependencies(&lexer, &lexer_dep_count);
     if (config->time_phases) phase_times->parse_s += (driver_time_seconds() - t0);
+    driver_account_include_reads(config, phase_times, &include_reads);
 
     if (error_has_occurred())
     {
@@ -165,23 +174,18 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
                                              ast,
                                              config->semantic_query_byte))
         {
-            lexer_free_dependencies(&lexer);
-            free(source);
-            if (early_obj_file && early_obj_file != config->output_file)
-                free(early_obj_file);
+            driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, early_obj_file);
             return BAA_COMPILER_EXIT_SUCCESS;
         }
         fprintf(stderr, "Aborting %s due to syntax errors.\n", current_input);
-        lexer_free_dependencies(&lexer);
-        free(source);
-        if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
+        driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, early_obj_file);
         return BAA_COMPILER_EXIT_SOURCE_ERROR;
     }
 
     if (config->verbose)
         printf("[INFO] Running semantic analysis...\n");
     if (config->time_phases) t0 = driver_time_seconds();
-    if (!analyze(ast))
+    if (!analyze(config->session, ast))
     {
         if (config->semantic_query_json &&
             driver_semantic_query_json_write(stdout,
@@ -191,26 +195,19 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
                                              ast,
                                              config->semantic_query_byte))
         {
-            lexer_free_dependencies(&lexer);
-            free(source);
-            if (early_obj_file && early_obj_file != config->output_file)
-                free(early_obj_file);
+            driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, early_obj_file);
             return BAA_COMPILER_EXIT_SUCCESS;
         }
         fprintf(stderr, "Aborting %s due to semantic errors.\n", current_input);
-        lexer_free_dependencies(&lexer);
-        free(source);
-        if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
+        driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, early_obj_file);
         return BAA_COMPILER_EXIT_SOURCE_ERROR;
     }
     if (config->time_phases) phase_times->analyze_s += (driver_time_seconds() - t0);
 
-    if (g_warning_config.warnings_as_errors && warning_has_occurred())
+    if (diagnostics_warning_config()->warnings_as_errors && warning_has_occurred())
     {
         fprintf(stderr, "Aborting %s: warnings treated as errors (-Werror).\n", current_input);
-        lexer_free_dependencies(&lexer);
-        free(source);
-        if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
+        driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, early_obj_file);
         return BAA_COMPILER_EXIT_SOURCE_ERROR;
     }
 
@@ -223,9 +220,7 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
                                        ast))
         {
             fprintf(stderr, "خطأ: فشل إصدار symbols-json-v1.\n");
-            lexer_free_dependencies(&lexer);
-            free(source);
-            if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
+            driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, early_obj_file);
             return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
         }
     }
@@ -240,10 +235,7 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
                                               config->semantic_query_byte))
         {
             fprintf(stderr, "خطأ: فشل إصدار semantic-query-json-v1.\n");
-            lexer_free_dependencies(&lexer);
-            free(source);
-            if (early_obj_file && early_obj_file != config->output_file)
-                free(early_obj_file);
+            driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, early_obj_file);
             return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
         }
     }
@@ -257,10 +249,7 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
                                               ast))
         {
             fprintf(stderr, "خطأ: فشل إصدار semantic-index-json-v1.\n");
-            lexer_free_dependencies(&lexer);
-            free(source);
-            if (early_obj_file && early_obj_file != config->output_file)
-                free(early_obj_file);
+            driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, early_obj_file);
             return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
         }
     }
@@ -277,36 +266,36 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
                                           build_manifest))
         {
             fprintf(stderr, "خطأ: فشل تحديث بيان فحص المصدر.\n");
-            lexer_free_dependencies(&lexer);
-            free(source);
+            driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, NULL);
             return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
         }
-        lexer_free_dependencies(&lexer);
-        free(source);
+        driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, NULL);
         return BAA_COMPILER_EXIT_SUCCESS;
     }
 
     if (config->time_phases) t0 = driver_time_seconds();
-    IRModule *ir_module = ir_lower_program(ast, current_input, config->runtime_check_mask, config->target);
+    IRModule *ir_module = ir_module_new(current_input);
+    bool lowered = ir_module &&
+                   ir_lower_program(ir_module, ast, config->runtime_check_mask, config->target);
     if (config->time_phases) phase_times->lower_ir_s += (driver_time_seconds() - t0);
-    if (!ir_module)
+    if (!lowered)
     {
+        ir_module_free(ir_module);
         fprintf(stderr, "Aborting %s: internal IR lowering failure.\n", current_input);
-        lexer_free_dependencies(&lexer);
-        free(source);
-        if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
+        driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, early_obj_file);
         return BAA_COMPILER_EXIT_INTERNAL_ERROR;
     }
 
     if (!driver_record_exported_definitions(odr_registry, ir_module, current_input))
     {
         ir_module_free(ir_module);
-        lexer_free_dependencies(&lexer);
-        free(source);
-        if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
+        driver_release_frontend(config, phase_times, &ast_arena, &lexer, &source_file, early_obj_file);
         return BAA_COMPILER_EXIT_SOURCE_ERROR;
     }
 
+    // لم يعد الـ IR يستعير شيئاً من الشجرة؛ تُحرَّر ساحتها كاملة هنا.
+    driver_release_ast(config, phase_times, &ast_arena);
+
     if (config->dump_ir)
     {
         if (config->verbose)
@@ -328,8 +317,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
         fprintf(stderr,
                 "خطأ: --verify-gate يتطلب -O1 أو -O2 لأن بوابة التحقق تعمل داخل المُحسِّن.\n");
         ir_module_free(ir_module);
-        lexer_free_dependencies(&lexer);
-        free(source);
+        lexer_free(&lexer);
+        baa_source_file_release(&source_file);
         if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
         return BAA_COMPILER_EXIT_INVALID_INVOCATION;
     }
@@ -340,23 +329,36 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
             printf("[INFO] Running optimizer (-%s)...\n", ir_optimizer_level_name(config->opt_level));
 
         if (config->time_phases) t0 = driver_time_seconds();
-        if (config->verify_gate) ir_optimizer_set_verify_gate(1);
-
-        if (!ir_optimizer_run(ir_module, config->opt_level))
+        IROptimizerOptions opt_options = {0};
+        opt_options.level = config->opt_level;
+        opt_options.verify_gate = config->verify_gate;
+        opt_options.pipeline = config->opt_pipeline;
+        opt_options.pool = unit_pool;
+        // [OPT-PASS]/[OPT] مع --time-phases؛ أسطر [ANALYSIS] و[OPT-FUNC] مع --opt-stats أو -v --time-phases.
+        bool opt_report = config->opt_stats || (config->time_phases && config->verbose);
+        IRAnalysisStats analysis_stats = {0};
+        if (opt_report) opt_options.analysis_stats = &analysis_stats;
+        IROptimizerStats opt_stats = {0};
+        opt_stats.clock = driver_time_seconds;
+        if (config->time_phases || config->opt_stats) opt_options.stats = &opt_stats;
+
+        if (!ir_optimizer_run(ir_module, &opt_options))
         {
             fprintf(stderr, "Aborting %s: optimizer failed.\n", current_input);
             if (config->verify_gate)
                 fprintf(stderr, "ملاحظة: قد يكون سبب الفشل هو بوابة التحقق (--verify-gate).\n");
-            if (config->verify_gate) ir_optimizer_set_verify_gate(0);
+            ir_optimizer_stats_free(&opt_stats);
             ir_module_free(ir_module);
-            lexer_free_dependencies(&lexer);
-            free(source);
+            lexer_free(&lexer);
+            baa_source_file_release(&source_file);
             if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
             return BAA_COMPILER_EXIT_INTERNAL_ERROR;
         }
 
-        if (config->verify_gate) ir_optimizer_set_verify_gate(0);
         if (config->time_phases) phase_times->optimize_s += (driver_time_seconds() - t0);
+        if (opt_report) ir_analysis_stats_print(&analysis_stats, stderr);
+        if (opt_options.stats) ir_optimizer_stats_print(&opt_stats, stderr, opt_report);
+        ir_optimizer_stats_free(&opt_stats);
     }
 
     if (config->dump_ir_opt)
@@ -376,8 +378,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
         {
             fprintf(stderr, "فشل التحقق من سلامة الـ IR.\n");
             ir_module_free(ir_module);
-            lexer_free_dependencies(&lexer);
-            free(source);
+            lexer_free(&lexer);
+            baa_source_file_release(&source_file);
             if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
             return BAA_COMPILER_EXIT_INTERNAL_ERROR;
         }
@@ -391,8 +393,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
             fprintf(stderr,
                     "خطأ: --verify-ssa يتطلب -O1 أو -O2 لأن SSA يُبنى عبر Mem2Reg داخل المُحسِّن.\n");
             ir_module_free(ir_module);
-            lexer_free_dependencies(&lexer);
-            free(source);
+            lexer_free(&lexer);
+            baa_source_file_release(&source_file);
             if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
             return BAA_COMPILER_EXIT_INVALID_INVOCATION;
         }
@@ -405,8 +407,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
         {
             fprintf(stderr, "فشل التحقق من SSA.\n");
             ir_module_free(ir_module);
-            lexer_free_dependencies(&lexer);
-            free(source);
+            lexer_free(&lexer);
+            baa_source_file_release(&source_file);
             if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
             return BAA_COMPILER_EXIT_INTERNAL_ERROR;
         }
@@ -419,8 +421,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
     {
         fprintf(stderr, "فشل تمريرة الخروج من SSA.\n");
         ir_module_free(ir_module);
-        lexer_free_dependencies(&lexer);
-        free(source);
+        lexer_free(&lexer);
+        baa_source_file_release(&source_file);
         if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
         return BAA_COMPILER_EXIT_INTERNAL_ERROR;
     }
@@ -443,8 +445,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
             {
                 fprintf(stderr, "فشل التحقق من سلامة الـ IR بعد فك الحلقات.\n");
                 ir_module_free(ir_module);
-                lexer_free_dependencies(&lexer);
-                free(source);
+                lexer_free(&lexer);
+                baa_source_file_release(&source_file);
                 if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
                 return BAA_COMPILER_EXIT_INTERNAL_ERROR;
             }
@@ -454,15 +456,21 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
     if (config->verbose)
         printf("[INFO] Running instruction selection...\n");
     bool enable_tco = (config->opt_level >= OPT_LEVEL_2);
+    // نظم يستقبل المقارنات بصيغة setcc/test/jne، فلا يُدمج jcc إلا حين يذهب الخرج إلى GAS أو ELF وحده.
+    bool fuse_cmp_branch = (config->assembler == BAA_ASSEMBLER_GAS ||
+                            config->assembler == BAA_ASSEMBLER_ELF) &&
+                           !config->emit_nazm && !config->nazm_shadow_executable &&
+                           !config->no_branch_fusion;
     if (config->time_phases) t0 = driver_time_seconds();
-    MachineModule *mach_module = isel_run_ex(ir_module, enable_tco, config->target);
+    MachineModule *mach_module = isel_run_ex2(ir_module, enable_tco, fuse_cmp_branch, config->target,
+                                             unit_pool);
     if (config->time_phases) phase_times->isel_s += (driver_time_seconds() - t0);
     if (!mach_module)
     {
         fprintf(stderr, "Aborting %s: instruction selection failed.\n", current_input);
         ir_module_free(ir_module);
-        lexer_free_dependencies(&lexer);
-        free(source);
+        lexer_free(&lexer);
+        baa_source_file_release(&source_file);
         if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
         return BAA_COMPILER_EXIT_INTERNAL_ERROR;
     }
@@ -470,16 +478,21 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
     if (config->verbose)
         printf("[INFO] Running register allocation...\n");
     if (config->time_phases) t0 = driver_time_seconds();
-    if (!regalloc_run_ex(mach_module, config->target))
+    // أسطر [REGALLOC] (ومنها النسخ المحذوفة) تظهر أيضاً مع -v --time-phases.
+    bool regalloc_report = config->regalloc_stats || (config->time_phases && config->verbose);
+    if (!regalloc_run_ex3(mach_module, config->target, config->codegen_opts.regalloc,
+                          regalloc_report ? stderr : NULL, unit_pool))
     {
         fprintf(stderr, "Aborting %s: register allocation failed.\n", current_input);
         mach_module_free(mach_module);
         ir_module_free(ir_module);
-        lexer_free_dependencies(&lexer);
-        free(source);
+        lexer_free(&lexer);
+        baa_source_file_release(&source_file);
         if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
         return BAA_COMPILER_EXIT_INTERNAL_ERROR;
     }
+    // ترتيب الكتل بعد التخصيص (يُحتسب زمنه مع التخصيص).
+    if (config->opt_level >= OPT_LEVEL_1) (void)mach_layout_run(mach_module);
     if (config->time_phases) phase_times->regalloc_s += (driver_time_seconds() - t0);
 
     if (config->emit_nazm ||
@@ -496,8 +509,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
             fprintf(stderr, "خطأ: تعذر تحديد مسار خرج نظم.\n");
             mach_module_free(mach_module);
             ir_module_free(ir_module);
-            lexer_free_dependencies(&lexer);
-            free(source);
+            lexer_free(&lexer);
+            baa_source_file_release(&source_file);
             return BAA_COMPILER_EXIT_INTERNAL_ERROR;
         }
 
@@ -510,8 +523,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
         {
             mach_module_free(mach_module);
             ir_module_free(ir_module);
-            lexer_free_dependencies(&lexer);
-            free(source);
+            lexer_free(&lexer);
+            baa_source_file_release(&source_file);
             driver_free_if_owned(nazm_output, config->output_file);
             return nazm_rc;
         }
@@ -530,8 +543,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
 
         mach_module_free(mach_module);
         ir_module_free(ir_module);
-        lexer_free_dependencies(&lexer);
-        free(source);
+        lexer_free(&lexer);
+        baa_source_file_release(&source_file);
         driver_free_if_owned(nazm_output, config->output_file);
         return manifest_ok
             ? BAA_COMPILER_EXIT_SUCCESS
@@ -546,8 +559,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
         {
             mach_module_free(mach_module);
             ir_module_free(ir_module);
-            lexer_free_dependencies(&lexer);
-            free(source);
+            lexer_free(&lexer);
+            baa_source_file_release(&source_file);
             return shadow_rc;
         }
     }
@@ -563,8 +576,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
             free(nazm_source);
             mach_module_free(mach_module);
             ir_module_free(ir_module);
-            lexer_free_dependencies(&lexer);
-            free(source);
+            lexer_free(&lexer);
+            baa_source_file_release(&source_file);
             if (early_obj_file && early_obj_file != config->output_file)
                 free(early_obj_file);
             return BAA_COMPILER_EXIT_INTERNAL_ERROR;
@@ -582,8 +595,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
             free(nazm_source);
             mach_module_free(mach_module);
             ir_module_free(ir_module);
-            lexer_free_dependencies(&lexer);
-            free(source);
+            lexer_free(&lexer);
+            baa_source_file_release(&source_file);
             if (obj_file != config->output_file) free(obj_file);
             return assemble_rc;
         }
@@ -595,40 +608,33 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
         }
         free(nazm_source);
         mach_module_free(mach_module);
-
-        if (config->time_phases)
-        {
-            IRArenaStats s = {0};
-            ir_arena_get_stats(&ir_module->arena, &s);
-            if (s.used_bytes > phase_times->ir_arena_used_max)
-                phase_times->ir_arena_used_max = s.used_bytes;
-            if (s.cap_bytes > phase_times->ir_arena_cap_max)
-                phase_times->ir_arena_cap_max = s.cap_bytes;
-            if (s.chunks > phase_times->ir_arena_chunks_max)
-                phase_times->ir_arena_chunks_max = s.chunks;
-        }
-
+        driver_record_ir_arena(config, phase_times, ir_module);
         ir_module_free(ir_module);
-        const char* const* build_deps = lexer_deps;
-        size_t build_dep_count = lexer_dep_count;
-        free(source);
+        baa_source_file_release(&source_file);
+        return driver_finish_object_unit(config, current_input, obj_file, &lexer,
+                                         lexer_deps, lexer_dep_count,
+                                         build_manifest, out_obj_file);
+    }
 
-        if (!driver_build_update_cache(config,
-                                       current_input,
-                                       obj_file,
-                                       build_deps,
-                                       build_dep_count,
-                                       build_manifest))
+    if (config->assembler == BAA_ASSEMBLER_ELF && !config->assembly_only)
+    {
+        // كاتب ELF الأصلي: لا ملف .s ولا عملية gcc -c لهذه الوحدة.
+        char *obj_file = early_obj_file;
+        BaaCompilerExitCode elf_rc = driver_write_elf_object(
+            config, phase_times, mach_module, current_input, obj_file);
+        mach_module_free(mach_module);
+        driver_record_ir_arena(config, phase_times, ir_module);
+        ir_module_free(ir_module);
+        baa_source_file_release(&source_file);
+        if (elf_rc != BAA_COMPILER_EXIT_SUCCESS)
         {
-            fprintf(stderr, "خطأ: فشل تحديث بيان/كاش البناء.\n");
+            lexer_free(&lexer);
             if (obj_file != config->output_file) free(obj_file);
-            lexer_free_dependencies(&lexer);
-            return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
+            return elf_rc;
         }
-
-        lexer_free_dependencies(&lexer);
-        if (out_obj_file) *out_obj_file = obj_file;
-        return BAA_COMPILER_EXIT_SUCCESS;
+        return driver_finish_object_unit(config, current_input, obj_file, &lexer,
+                                         lexer_deps, lexer_dep_count,
+                                         build_manifest, out_obj_file);
     }
 
     char* final_asm_output = NULL;
@@ -647,8 +653,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
     {
         fprintf(stderr, "خطأ: فشل تحديد مسار ملف التجميع.\n");
         ir_module_free(ir_module);
-        lexer_free_dependencies(&lexer);
-        free(source);
+        lexer_free(&lexer);
+        baa_source_file_release(&source_file);
         driver_free_if_owned(final_asm_output, config->output_file);
         if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
         return BAA_COMPILER_EXIT_INTERNAL_ERROR;
@@ -660,8 +666,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
         fprintf(stderr, "خطأ: تعذرت كتابة ملف التجميع '%s'.\n", asm_file);
         mach_module_free(mach_module);
         ir_module_free(ir_module);
-        lexer_free_dependencies(&lexer);
-        free(source);
+        lexer_free(&lexer);
+        baa_source_file_release(&source_file);
         free(asm_file);
         driver_free_if_owned(final_asm_output, config->output_file);
         if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
@@ -682,8 +688,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
                 (void)driver_toolchain_delete_file_utf8(asm_file);
             mach_module_free(mach_module);
             ir_module_free(ir_module);
-            lexer_free_dependencies(&lexer);
-            free(source);
+            lexer_free(&lexer);
+            baa_source_file_release(&source_file);
             free(asm_file);
             driver_free_if_owned(final_asm_output, config->output_file);
             if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
@@ -692,7 +698,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
     }
 
     if (config->time_phases) t0 = driver_time_seconds();
-    if (!emit_module_ex2(mach_module, f_asm, config->debug_info, config->target, config->codegen_opts))
+    if (!emit_module_ex3(mach_module, f_asm, config->debug_info, config->target, config->codegen_opts,
+                         unit_pool))
     {
         fprintf(stderr, "Aborting %s: code emission failed.\n", current_input);
         fclose(f_asm);
@@ -700,8 +707,8 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
             (void)driver_toolchain_delete_file_utf8(asm_file);
         mach_module_free(mach_module);
         ir_module_free(ir_module);
-        lexer_free_dependencies(&lexer);
-        free(source);
+        lexer_free(&lexer);
+        baa_source_file_release(&source_file);
         free(asm_file);
         driver_free_if_owned(final_asm_output, config->output_file);
         if (early_obj_file && early_obj_file != config->output_file) free(early_obj_file);
@@ -711,20 +718,11 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
     fclose(f_asm);
 
     mach_module_free(mach_module);
-
-    if (config->time_phases)
-    {
-        IRArenaStats s = {0};
-        ir_arena_get_stats(&ir_module->arena, &s);
-        if (s.used_bytes > phase_times->ir_arena_used_max) phase_times->ir_arena_used_max = s.used_bytes;
-        if (s.cap_bytes > phase_times->ir_arena_cap_max) phase_times->ir_arena_cap_max = s.cap_bytes;
-        if (s.chunks > phase_times->ir_arena_chunks_max) phase_times->ir_arena_chunks_max = s.chunks;
-    }
-
+    driver_record_ir_arena(config, phase_times, ir_module);
     ir_module_free(ir_module);
     const char* const* build_deps = lexer_deps;
     size_t build_dep_count = lexer_dep_count;
-    free(source);
+    baa_source_file_release(&source_file);
 
     if (config->assembly_only)
     {
@@ -750,11 +748,15 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
                                            build_manifest);
         free(asm_file);
         driver_free_if_owned(final_asm_output, config->output_file);
-        lexer_free_dependencies(&lexer);
+        lexer_free(&lexer);
         return BAA_COMPILER_EXIT_SUCCESS;
     }
 
     char *obj_file = early_obj_file;
+    if (asm_queue)
+        return driver_queue_object_unit(config, asm_queue, current_input, asm_file, obj_file,
+                                        &lexer, build_deps, build_dep_count,
+                                        build_manifest, out_obj_file);
 
     BaaCompilerExitCode assemble_rc =
         driver_toolchain_assemble_one(config, phase_times, asm_file, obj_file);
@@ -764,7 +766,7 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
         free(asm_file);
         if (obj_file != config->output_file) free(obj_file);
         driver_free_if_owned(final_asm_output, config->output_file);
-        lexer_free_dependencies(&lexer);
+        lexer_free(&lexer);
         return assemble_rc;
     }
 
@@ -774,25 +776,22 @@ static BaaCompilerExitCode compile_one_ir(const CompilerConfig *config,
     }
     free(asm_file);
     driver_free_if_owned(final_asm_output, config->output_file);
+    return driver_finish_object_unit(config, current_input, obj_file, &lexer,
+                                     build_deps, build_dep_count,
+                                     build_manifest, out_obj_file);
+}
 
-    if (!driver_build_update_cache(config,
-                                   current_input,
-                                   obj_file,
-                                   build_deps,
-                                   build_dep_count,
-                                   build_manifest))
-    {
-        fprintf(stderr, "خطأ: فشل تحديث بيان/كاش البناء.\n");
-        if (obj_file != config->output_file) free(obj_file);
-        lexer_free_dependencies(&lexer);
-        return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
-    }
-
-    lexer_free_dependencies(&lexer);
-    if (out_obj_file) *out_obj_file = obj_file;
-    return BAA_COMPILER_EXIT_SUCCESS;
+/**
+ * @brief تحذير عند تعطيل خيار طلبه المستخدم صراحةً بسبب خيار آخر يتعارض معه.
+ */
+static void driver_warn_option_overridden(const char *option, const char *serial_work,
+                                          const char *reason)
+{
+    fprintf(stderr, "تحذير: تم تجاهل %s وستُترجم %s تسلسلياً: %s.\n", option, serial_work, reason);
 }
 
+#include "driver_pipeline_jobs.inc"
+
 BaaCompilerExitCode driver_compile_files(const CompilerConfig *config,
                                          char **input_files,
                                          int input_count,
@@ -842,69 +841,99 @@ BaaCompilerExitCode driver_compile_files(const CompilerConfig *config,
         odr_registry_ptr = &odr_registry;
     }
 
-    for (int i = 0; i < input_count; i++)
-    {
-        const char *current_input = input_files[i];
-        char *obj_file = NULL;
-        char *shadow_object = NULL;
-
-        BaaCompilerExitCode rc = driver_nazm_is_source_path(current_input)
-            ? driver_compile_nazm_input(config,
-                                        input_count,
-                                        current_input,
-                                        phase_times,
-                                        build_manifest,
-                                        &obj_file)
-            : compile_one_ir(config,
-                             input_count,
-                             current_input,
-                             phase_times,
-                             build_manifest,
-                             odr_registry_ptr,
-                             &obj_file,
-                             &shadow_object);
-
-        if (rc != BAA_COMPILER_EXIT_SUCCESS)
-        {
-            driver_odr_registry_free(odr_registry_ptr);
-            driver_free_obj_files(obj_files, obj_count, config->output_file);
-            if (out_obj_files) *out_obj_files = NULL;
-            if (out_obj_count) *out_obj_count = 0;
-            if (shadow_object)
-            {
-                (void)driver_toolchain_delete_file_utf8(shadow_object);
-                free(shadow_object);
-            }
-            return rc;
-        }
+    // التشخيصات بصيغة JSON تُجمع في ذاكرة العملية، ولا يعبر مسار الظل إلا ملفاً واحداً؛
+    // لذلك يبقى هذان الوضعان تسلسليين حتى مع -j، مع تحذير صريح بدل التجاهل الصامت.
+    bool use_jobs = config->jobs > 1 && input_count > 1;
+    if (use_jobs && config->diagnostics_json)
+    {
+        driver_warn_option_overridden("-j", "المدخلات", "--diagnostics=json يجمع التشخيصات في عملية واحدة");
+        use_jobs = false;
+    }
+    else if (use_jobs && config->nazm_shadow_executable)
+    {
+        driver_warn_option_overridden("-j", "المدخلات", "--nazm-shadow يعبر ملف كائن واحد فقط");
+        use_jobs = false;
+    }
 
-        if (shadow_object)
-        {
-            if (out_nazm_shadow_object && !*out_nazm_shadow_object)
-                *out_nazm_shadow_object = shadow_object;
-            else
-            {
-                (void)driver_toolchain_delete_file_utf8(shadow_object);
-                free(shadow_object);
-                driver_odr_registry_free(odr_registry_ptr);
-                driver_free_obj_files(obj_files, obj_count, config->output_file);
-                return BAA_COMPILER_EXIT_INTERNAL_ERROR;
-            }
-        }
+    // الترجمة التسلسلية مع GAS تُطلق gcc -c في الخلفية وتمضي في الوحدة التالية،
+    // ويُطلق كائن البدء أولاً ليتداخل تجميعه مع ترجمة الوحدات.
+    DriverAssembleQueue asm_queue;
+    DriverAssembleQueue *asm_queue_ptr = NULL;
+    if (!use_jobs && cap > 1 && build_manifest &&
+        config->assembler == BAA_ASSEMBLER_GAS &&
+        driver_assemble_queue_init(&asm_queue, config, phase_times, build_manifest))
+    {
+        asm_queue_ptr = &asm_queue;
+    }
+    char *startup_object = NULL;
+    BaaCompilerExitCode units_rc = BAA_COMPILER_EXIT_SUCCESS;
+    if (need_startup_obj && asm_queue_ptr)
+    {
+        units_rc = driver_build_startup_object(config, phase_times, asm_queue_ptr,
+                                               &startup_object);
+        if (units_rc != BAA_COMPILER_EXIT_SUCCESS)
+            fprintf(stderr, "خطأ: فشل تجميع كود بدء التشغيل.\n");
+    }
 
-        if (!config->assembly_only && !config->emit_nazm &&
-            !config->check_only && !config->header_check)
+    // خيوط الدوال داخل الوحدة: --threads صراحةً، أو عدد -j حين يوجد مدخل واحد فقط.
+    // عمال -j عمليات منفصلة، فلا يُنشأ المجمّع معهم.
+    BaaThreadPool *unit_pool = NULL;
+    if (use_jobs && config->threads > 1)
+    {
+        driver_warn_option_overridden("--threads", "دوال كل وحدة",
+                                      "-j يوزع المدخلات على عمليات منفصلة");
+    }
+    else if (!use_jobs)
+    {
+        int unit_threads = config->threads > 0 ? config->threads
+                         : (input_count == 1 ? config->jobs : 1);
+        unit_pool = baa_thread_pool_create(unit_threads);
+    }
+
+    if (units_rc == BAA_COMPILER_EXIT_SUCCESS)
+    {
+        units_rc = use_jobs
+            ? driver_compile_files_parallel(config,
+                                            input_files,
+                                            input_count,
+                                            phase_times,
+                                            build_manifest,
+                                            odr_registry_ptr,
+                                            obj_files,
+                                            &obj_count)
+            : driver_compile_files_serial(config,
+                                          input_files,
+                                          input_count,
+                                          phase_times,
+                                          build_manifest,
+                                          odr_registry_ptr,
+                                          asm_queue_ptr,
+                                          unit_pool,
+                                          obj_files,
+                                          &obj_count,
+                                          out_nazm_shadow_object);
+    }
+    baa_thread_pool_destroy(unit_pool);
+    BaaCompilerExitCode queue_rc =
+        driver_assemble_queue_finish(asm_queue_ptr, units_rc != BAA_COMPILER_EXIT_SUCCESS);
+    if (units_rc == BAA_COMPILER_EXIT_SUCCESS) units_rc = queue_rc;
+    if (units_rc != BAA_COMPILER_EXIT_SUCCESS)
+    {
+        if (startup_object)
         {
-            obj_files[obj_count++] = obj_file;
+            (void)driver_toolchain_delete_file_utf8(startup_object);
+            free(startup_object);
         }
+        driver_odr_registry_free(odr_registry_ptr);
+        driver_free_obj_files(obj_files, obj_count, config->output_file);
+        return units_rc;
     }
 
     // أضف كائن بدء التشغيل في نهاية قائمة الربط.
-    if (need_startup_obj)
+    if (need_startup_obj && !startup_object)
     {
-        char *startup_object = NULL;
         BaaCompilerExitCode startup_assemble_rc =
-            driver_build_startup_object(config, phase_times, &startup_object);
+            driver_build_startup_object(config, phase_times, NULL, &startup_object);
         if (startup_assemble_rc != BAA_COMPILER_EXIT_SUCCESS)
         {
             driver_odr_registry_free(odr_registry_ptr);
@@ -912,8 +941,8 @@ BaaCompilerExitCode driver_compile_files(const CompilerConfig *config,
             driver_free_obj_files(obj_files, obj_count, config->output_file);
             return startup_assemble_rc;
         }
-        obj_files[obj_count++] = startup_object;
     }
+    if (startup_object) obj_files[obj_count++] = startup_object;
 
     driver_odr_registry_free(odr_registry_ptr);
     if (out_obj_files) *out_obj_files = obj_files;
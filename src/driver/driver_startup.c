@@ -5,8 +5,11 @@
 
 #include "driver_startup.h"
 
+#include "driver_assemble_queue.h"
 #include "driver_nazm.h"
+#include "driver_time.h"
 #include "driver_toolchain.h"
+#include "../backend/emit_elf.h"
 #include "../support/file_io.h"
 
 #include <stdio.h>
@@ -70,9 +73,41 @@ const char *driver_startup_gas_source(const BaaTarget *target)
         "    hlt\n";
 }
 
+/**
+ * @brief ترميز كائن البدء مباشرة بكاتب ELF الأصلي (بلا ملف .s ولا gcc).
+ */
+static BaaCompilerExitCode driver_startup_write_elf(
+    const CompilerConfig *config,
+    CompilerPhaseTimes *times,
+    const char *object_path)
+{
+    double started = config->time_phases ? driver_time_seconds() : 0.0;
+    uint8_t *image = NULL;
+    size_t image_size = 0;
+    bool ok = emit_elf_startup_to_memory(&image, &image_size);
+    double encoded = config->time_phases ? driver_time_seconds() : 0.0;
+    ok = ok && driver_toolchain_write_file_utf8(object_path, image, image_size);
+    free(image);
+    if (!ok)
+    {
+        fprintf(stderr,
+                "خطأ: فشلت كتابة كائن بدء التشغيل '%s'.\n",
+                object_path);
+        return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
+    }
+    if (config->time_phases)
+    {
+        double finished = driver_time_seconds();
+        times->assemble_s += finished - started;
+        times->assemble_io_s += finished - encoded;
+    }
+    return BAA_COMPILER_EXIT_SUCCESS;
+}
+
 BaaCompilerExitCode driver_build_startup_object(
     const CompilerConfig *config,
     CompilerPhaseTimes *times,
+    DriverAssembleQueue *queue,
     char **out_object_path)
 {
     if (out_object_path) *out_object_path = NULL;
@@ -80,8 +115,13 @@ BaaCompilerExitCode driver_build_startup_object(
         return BAA_COMPILER_EXIT_INTERNAL_ERROR;
 
     bool use_nazm = config->assembler == BAA_ASSEMBLER_NAZM;
+    bool use_elf = config->assembler == BAA_ASSEMBLER_ELF &&
+                   config->target &&
+                   config->target->obj_format == BAA_OBJFORMAT_ELF;
     const char *source_suffix = use_nazm ? ".بدء-نظم.نظم" : ".بدء-غاز.s";
-    const char *object_suffix = use_nazm ? ".بدء-نظم.o" : ".بدء-غاز.o";
+    const char *object_suffix = use_nazm ? ".بدء-نظم.o"
+                                : use_elf ? ".بدء-elf.o"
+                                          : ".بدء-غاز.o";
     char *source_path =
         driver_startup_artifact_path(config->output_file, source_suffix);
     char *object_path =
@@ -105,6 +145,10 @@ BaaCompilerExitCode driver_build_startup_object(
             object_path,
             config->verbose);
     }
+    else if (use_elf)
+    {
+        rc = driver_startup_write_elf(config, times, object_path);
+    }
     else
     {
         const char *source = driver_startup_gas_source(config->target);
@@ -115,6 +159,16 @@ BaaCompilerExitCode driver_build_startup_object(
                     source_path);
             rc = BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
         }
+        else if (queue)
+        {
+            // يملك الطابور ملف المصدر ويحذفه بعد اكتمال التجميع.
+            rc = driver_assemble_queue_submit(
+                queue,
+                source_path,
+                object_path,
+                DRIVER_ASSEMBLE_NO_UNIT);
+            source_path = NULL;
+        }
         else
         {
             rc = driver_toolchain_assemble_one(
@@ -123,7 +177,7 @@ BaaCompilerExitCode driver_build_startup_object(
                 source_path,
                 object_path);
         }
-        if (!config->verbose)
+        if (source_path && !config->verbose)
             (void)driver_toolchain_delete_file_utf8(source_path);
     }
 
@@ -7,6 +7,7 @@
 #define BAA_DRIVER_STARTUP_H
 
 #include "driver.h"
+#include "driver_assemble_queue.h"
 
 /**
  * @brief Return the GAS startup source for the selected target.
@@ -17,10 +18,13 @@ const char *driver_startup_gas_source(const BaaTarget *target);
  * @brief Build the hosted startup object through the selected assembler.
  *
  * On success, `out_object_path` receives an allocated path owned by the caller.
+ * With a non-NULL `queue`, the GAS startup object is only launched; it is
+ * complete once the queue is finished.
  */
 BaaCompilerExitCode driver_build_startup_object(
     const CompilerConfig *config,
     CompilerPhaseTimes *times,
+    DriverAssembleQueue *queue,
     char **out_object_path);
 
 #endif
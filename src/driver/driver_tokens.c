@@ -63,8 +63,7 @@ static bool tokens_is_modifier(BaaTokenType type)
            type == TOKEN_EXTERN;
 }
 
-static const char *tokens_word_kind(const BaaSourceToken *token,
-                                    bool *out_of_memory)
+static const char *tokens_word_kind(const BaaSourceToken *token)
 {
     if (!token || !token->start || token->length == 0u)
         return "identifier";
@@ -73,30 +72,20 @@ static const char *tokens_word_kind(const BaaSourceToken *token,
         tokens_is_arabic_digit(token->start))
         return "number";
 
-    char *word = (char *)malloc(token->length + 1u);
-    if (!word)
-    {
-        if (out_of_memory) *out_of_memory = true;
-        return "identifier";
-    }
-    memcpy(word, token->start, token->length);
-    word[token->length] = '\0';
     BaaTokenType type = TOKEN_INVALID;
-    const bool keyword = baa_language_keyword_token(word, &type);
-    free(word);
+    const bool keyword = baa_language_keyword_token_n(token->start, token->length, &type);
     if (!keyword) return "identifier";
     if (tokens_is_type_keyword(type)) return "type";
     if (tokens_is_modifier(type)) return "modifier";
     return "keyword";
 }
 
-static const char *tokens_kind(const BaaSourceToken *token,
-                               bool *out_of_memory)
+static const char *tokens_kind(const BaaSourceToken *token)
 {
     switch (token->kind)
     {
         case BAA_SOURCE_TOKEN_WORD:
-            return tokens_word_kind(token, out_of_memory);
+            return tokens_word_kind(token);
         case BAA_SOURCE_TOKEN_LITERAL:
             return token->length > 0u && token->start[0] == '\''
                 ? "character"
@@ -136,16 +125,10 @@ BaaTokensStatus driver_tokens_json_write(FILE *out,
             "\"source_bytes\":%zu,\"tokens\":[",
             strlen(source));
 
-    bool out_of_memory = false;
     for (size_t index = 0u; index < tokens.count; ++index)
     {
         const BaaSourceToken *token = &tokens.items[index];
-        const char *kind = tokens_kind(token, &out_of_memory);
-        if (out_of_memory)
-        {
-            baa_source_tokens_free(&tokens);
-            return BAA_TOKENS_OUT_OF_MEMORY;
-        }
+        const char *kind = tokens_kind(token);
         if (index != 0u) fputc(',', out);
         fputs("{\"kind\":", out);
         tokens_json_escape(out, kind);
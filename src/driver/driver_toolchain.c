@@ -10,6 +10,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <stdatomic.h>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -71,7 +72,7 @@ static void runtime_library_resolve_from_exe_dir(const char* exe_dir)
 #define BAA_PATH_SUFFIX_GCC_BIN_W L"\\gcc\\bin\\gcc.exe"
 #define BAA_PATH_SUFFIX_GCC_BIN_DEV_W L"\\..\\gcc\\bin\\gcc.exe"
 
-static unsigned long g_toolchain_file_counter = 0;
+static atomic_ulong g_toolchain_file_counter = 0;
 
 static bool win_wide_to_utf8(const wchar_t* text, char* out, size_t out_cap)
 {
@@ -219,7 +220,7 @@ static bool win_make_link_response_path(const char* output_path,
 {
     if (!output_path || !out || out_cap == 0) return false;
     unsigned long process_id = (unsigned long)GetCurrentProcessId();
-    unsigned long file_id = ++g_toolchain_file_counter;
+    unsigned long file_id = atomic_fetch_add(&g_toolchain_file_counter, 1) + 1;
     int count = snprintf(out,
                          out_cap,
                          "%s.baa_link_%lu_%lu.rsp",
@@ -304,6 +305,16 @@ BaaObjectFormat driver_toolchain_host_object_format(void)
 #endif
 }
 
+bool driver_toolchain_write_file_utf8(const char* path, const void* data, size_t size)
+{
+    if (!path || (!data && size > 0)) return false;
+    FILE* out = baa_fopen_utf8(path, "wb");
+    if (!out) return false;
+    bool ok = size == 0 || fwrite(data, 1, size, out) == size;
+    if (fclose(out) != 0) ok = false;
+    return ok;
+}
+
 bool driver_toolchain_copy_file_utf8(const char* src_path, const char* dst_path)
 {
     if (!src_path || !dst_path) return false;
@@ -387,13 +398,17 @@ static void win_free_tool_paths(char** paths, int path_count)
 }
 #endif
 
-BaaCompilerExitCode driver_toolchain_assemble_one(const CompilerConfig *config,
-                                                  CompilerPhaseTimes *times,
-                                                  const char *asm_file,
-                                                  const char *obj_file)
+BaaCompilerExitCode driver_toolchain_assemble_start(const CompilerConfig *config,
+                                                    CompilerPhaseTimes *times,
+                                                    const char *asm_file,
+                                                    const char *obj_file,
+                                                    DriverAssembly *out_assembly)
 {
-    if (!config || !asm_file || !obj_file) return BAA_COMPILER_EXIT_INTERNAL_ERROR;
-    BaaCompilerExitCode rc = BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
+    if (!config || !asm_file || !obj_file || !out_assembly)
+        return BAA_COMPILER_EXIT_INTERNAL_ERROR;
+    memset(out_assembly, 0, sizeof(*out_assembly));
+    out_assembly->asm_file = asm_file;
+    out_assembly->obj_file = obj_file;
 
 #ifdef _WIN32
     char tool_asm[MAX_PATH] = "";
@@ -426,23 +441,54 @@ BaaCompilerExitCode driver_toolchain_assemble_one(const CompilerConfig *config,
 
     double t0 = 0.0;
     if (times && config->time_phases) t0 = driver_time_seconds();
-
-    BaaProcessResult pr;
-    if (!baa_process_run(argv, NULL, &pr) || pr.exit_code != 0)
+    bool started = baa_process_start(argv, NULL, &out_assembly->process);
+    if (times && config->time_phases) times->assemble_s += (driver_time_seconds() - t0);
+    if (!started)
     {
         fprintf(stderr, "خطأ: فشلت أداة التجميع للملف الحقيقي: %s\n", asm_file);
-        goto cleanup;
+#ifdef _WIN32
+        (void)driver_toolchain_delete_file_utf8(obj_file);
+#endif
+        return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
     }
+    return BAA_COMPILER_EXIT_SUCCESS;
+}
 
+BaaCompilerExitCode driver_toolchain_assemble_finish(const CompilerConfig *config,
+                                                     CompilerPhaseTimes *times,
+                                                     DriverAssembly *assembly)
+{
+    if (!config || !assembly || !assembly->process.started)
+        return BAA_COMPILER_EXIT_INTERNAL_ERROR;
+
+    // لا يُحتسب إلا زمن الانتظار الفعلي؛ ما تداخل منه مع ترجمة وحدات لاحقة لا يظهر في assemble.
+    double t0 = 0.0;
+    if (times && config->time_phases) t0 = driver_time_seconds();
+    BaaProcessResult pr;
+    bool waited = baa_process_wait(&assembly->process, &pr);
     if (times && config->time_phases) times->assemble_s += (driver_time_seconds() - t0);
-    rc = BAA_COMPILER_EXIT_SUCCESS;
 
-cleanup:
+    if (!waited || pr.exit_code != 0)
+    {
+        fprintf(stderr, "خطأ: فشلت أداة التجميع للملف الحقيقي: %s\n", assembly->asm_file);
 #ifdef _WIN32
-    if (rc != BAA_COMPILER_EXIT_SUCCESS)
-        (void)driver_toolchain_delete_file_utf8(obj_file);
+        (void)driver_toolchain_delete_file_utf8(assembly->obj_file);
 #endif
-    return rc;
+        return BAA_COMPILER_EXIT_TOOLCHAIN_ERROR;
+    }
+    return BAA_COMPILER_EXIT_SUCCESS;
+}
+
+BaaCompilerExitCode driver_toolchain_assemble_one(const CompilerConfig *config,
+                                                  CompilerPhaseTimes *times,
+                                                  const char *asm_file,
+                                                  const char *obj_file)
+{
+    DriverAssembly assembly;
+    BaaCompilerExitCode rc =
+        driver_toolchain_assemble_start(config, times, asm_file, obj_file, &assembly);
+    if (rc != BAA_COMPILER_EXIT_SUCCESS) return rc;
+    return driver_toolchain_assemble_finish(config, times, &assembly);
 }
 
 BaaCompilerExitCode driver_toolchain_link(const CompilerConfig *config,
@@ -8,6 +8,7 @@
 #define BAA_DRIVER_TOOLCHAIN_H
 
 #include "driver.h"
+#include "process.h"
 
 #include <stdbool.h>
 
@@ -32,7 +33,36 @@ const char *driver_toolchain_get_gcc_command(void);
 BaaObjectFormat driver_toolchain_host_object_format(void);
 
 /**
- * @brief تجميع ملف .s إلى .o عبر GCC.
+ * @brief تجميع أُطلق ولم يُنتظر بعد؛ المساران مستعاران من المستدعي.
+ */
+typedef struct
+{
+    BaaProcessHandle process;
+    const char *asm_file;
+    const char *obj_file;
+} DriverAssembly;
+
+/**
+ * @brief إطلاق gcc -c لملف .s دون انتظاره.
+ *
+ * يُحتسب زمن الإطلاق في assemble؛ وعلى المستدعي استدعاء
+ * driver_toolchain_assemble_finish() لكل تجميع أُطلق بنجاح.
+ */
+BaaCompilerExitCode driver_toolchain_assemble_start(const CompilerConfig *config,
+                                                    CompilerPhaseTimes *times,
+                                                    const char *asm_file,
+                                                    const char *obj_file,
+                                                    DriverAssembly *out_assembly);
+
+/**
+ * @brief انتظار تجميع أُطلق بـ driver_toolchain_assemble_start() وفحص نتيجته.
+ */
+BaaCompilerExitCode driver_toolchain_assemble_finish(const CompilerConfig *config,
+                                                     CompilerPhaseTimes *times,
+                                                     DriverAssembly *assembly);
+
+/**
+ * @brief تجميع ملف .s إلى .o عبر GCC وانتظاره.
  */
 BaaCompilerExitCode driver_toolchain_assemble_one(const CompilerConfig *config,
                                                   CompilerPhaseTimes *times,
@@ -52,6 +82,13 @@ BaaCompilerExitCode driver_toolchain_link(const CompilerConfig *config,
  */
 bool driver_toolchain_copy_file_utf8(const char* src_path, const char* dst_path);
 
+/**
+ * @brief كتابة بايتات في ملف جديد ("wb") مع دعم مسارات UTF-8 على ويندوز.
+ *
+ * تفشل عند أي كتابة قصيرة أو فشل إغلاق.
+ */
+bool driver_toolchain_write_file_utf8(const char* path, const void* data, size_t size);
+
 /**
  * @brief حذف ملف مع دعم مسارات UTF-8 على ويندوز.
  */
@@ -25,7 +25,7 @@ static void print_phase_times_and_mem(const CompilerConfig* config,
 
     double total = driver_time_seconds() - config->start_time;
     fprintf(stderr,
-            "[TIME] read=%.6f parse=%.6f analyze=%.6f lower=%.6f opt=%.6f verify_ir=%.6f verify_ssa=%.6f outssa=%.6f unroll=%.6f isel=%.6f regalloc=%.6f emit=%.6f assemble=%.6f link=%.6f total=%.6f\n",
+            "[TIME] read=%.6f parse=%.6f analyze=%.6f lower=%.6f opt=%.6f verify_ir=%.6f verify_ssa=%.6f outssa=%.6f unroll=%.6f isel=%.6f regalloc=%.6f emit=%.6f assemble=%.6f assemble_encode=%.6f assemble_io=%.6f link=%.6f total=%.6f\n",
             phase_times->read_file_s,
             phase_times->parse_s,
             phase_times->analyze_s,
@@ -39,14 +39,23 @@ static void print_phase_times_and_mem(const CompilerConfig* config,
             phase_times->regalloc_s,
             phase_times->emit_s,
             phase_times->assemble_s,
+            phase_times->assemble_s - phase_times->assemble_io_s,
+            phase_times->assemble_io_s,
             phase_times->link_s,
             total);
 
     fprintf(stderr,
-            "[MEM] ir_arena_used_max=%zu ir_arena_cap_max=%zu ir_arena_chunks_max=%zu\n",
+            "[MEM] ir_arena_used_max=%zu ir_arena_cap_max=%zu ir_arena_chunks_max=%zu "
+            "ast_arena_used_max=%zu ast_arena_cap_max=%zu ast_arena_chunks_max=%zu "
+            "source_loads=%zu source_cache_hits=%zu\n",
             phase_times->ir_arena_used_max,
             phase_times->ir_arena_cap_max,
-            phase_times->ir_arena_chunks_max);
+            phase_times->ir_arena_chunks_max,
+            phase_times->ast_arena_used_max,
+            phase_times->ast_arena_cap_max,
+            phase_times->ast_arena_chunks_max,
+            phase_times->source_loads,
+            phase_times->source_cache_hits);
 }
 
 static const char* main_mode_name(const CompilerConfig* config)
@@ -112,6 +121,8 @@ static int main_cleanup_and_return(const CompilerConfig* config,
                                config->target ? config->target->name : "",
                                ".");
     }
+    // التشخيصات تستعير نصوص ملفات التضمين، فلا تُحرَّر قبل كتابتها أعلاه.
+    baa_source_cache_clear();
     driver_free_obj_files(obj_files, obj_count, output_file);
     driver_parse_result_free(cli);
     if (config) free(config->nazm_fingerprint);
@@ -123,9 +134,10 @@ static int main_cleanup_and_return(const CompilerConfig* config,
 // نقطة الدخول (Main Entry Point)
 // ============================================================================
 
-static int baa_main(int argc, char **argv)
+static int baa_main(BaaSession *session, int argc, char **argv)
 {
     CompilerConfig config = {0};
+    config.session = session;
     bool output_file_owned = false;
     config.output_file = NULL;
     config.opt_level = OPT_LEVEL_1; // Default optimization level
@@ -161,7 +173,7 @@ static int baa_main(int argc, char **argv)
     }
     diagnostics_set_json_enabled(config.diagnostics_json);
     if (config.diagnostics_json)
-        g_warning_config.colored_output = false;
+        diagnostics_warning_config()->colored_output = false;
 
     if (cli.cmd == DRIVER_CMD_HELP)
     {
@@ -380,22 +392,23 @@ static int baa_main(int argc, char **argv)
 
     // v0.3.2.8.4+: الربط النهائي يبقى مقيدا بالمضيف.
     // - نسمح بـ -S لأي هدف.
-    // - يسمح نظم أيضا بـ -c عابر للأهداف لأنه يكتب ELF64/COFF مباشرة.
+    // - يسمح نظم وكاتب ELF الأصلي أيضا بـ -c عابر للأهداف لأنهما يكتبان الكائن مباشرة.
     // - GAS -c والربط النهائي يتطلبان أن يطابق الهدف نظام المضيف.
     if (!config.assembly_only && !config.emit_nazm &&
         !config.check_only && !config.header_check)
     {
         if (config.target && config.target->obj_format != driver_toolchain_host_object_format())
         {
-            bool nazm_cross_object =
+            bool direct_cross_object =
                 config.compile_only &&
                 (config.assembler == BAA_ASSEMBLER_NAZM ||
+                 config.assembler == BAA_ASSEMBLER_ELF ||
                  main_all_inputs_are_nazm(input_files, input_count));
-            if (!nazm_cross_object)
+            if (!direct_cross_object)
             {
                 fprintf(stderr,
                         "خطأ: الهدف '%s' لا يطابق نظام المضيف لمرحلة التجميع/الربط.\n"
-                        "ملاحظة: استخدم -S، أو -c --assembler=nazm لتوليد كائن عابر للأهداف. "
+                        "ملاحظة: استخدم -S، أو -c --assembler=nazm|elf لتوليد كائن عابر للأهداف. "
                         "الربط العابر للأهداف مؤجل.\n",
                         config.target->name ? config.target->name : "<unknown>");
                 driver_build_manifest_free(&build_manifest);
@@ -556,6 +569,27 @@ static int baa_main(int argc, char **argv)
                                    output_file_owned, BAA_COMPILER_EXIT_SUCCESS);
 }
 
+/**
+ * @brief تشغيل المترجم داخل جلسة ترجمة صريحة تملك حالة التشخيص والتحليل.
+ */
+static int baa_main_in_session(int argc, char **argv)
+{
+    BaaSession *session = baa_session_create();
+    if (!session)
+    {
+        fputs("خطأ داخلي: تعذر إنشاء جلسة الترجمة.\n", stderr);
+        return BAA_COMPILER_EXIT_INTERNAL_ERROR;
+    }
+
+    // الجلسة تُمرَّر صراحةً إلى parse()/analyze()؛ ربطها هنا يخدم استعلامات
+    // السائق نفسه عن التشخيصات (خيارات -W، error_has_occurred()).
+    BaaSession *previous = baa_session_bind(session);
+    int rc = baa_main(session, argc, argv);
+    (void)baa_session_bind(previous);
+    baa_session_destroy(session);
+    return rc;
+}
+
 #ifdef _WIN32
 /**
  * @brief تحويل وسيط UTF-16 من سطر أوامر ويندوز إلى UTF-8 مملوك.
@@ -606,7 +640,7 @@ int wmain(int argc, wchar_t** wide_argv)
         }
     }
 
-    int rc = baa_main(argc, utf8_argv);
+    int rc = baa_main_in_session(argc, utf8_argv);
     for (int i = 0; i < argc; ++i) free(utf8_argv[i]);
     free(utf8_argv);
     return rc;
@@ -614,6 +648,6 @@ int wmain(int argc, wchar_t** wide_argv)
 #else
 int main(int argc, char** argv)
 {
-    return baa_main(argc, argv);
+    return baa_main_in_session(argc, argv);
 }
 #endif
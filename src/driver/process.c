@@ -153,13 +153,13 @@ static bool win_build_cmdline(char* out, size_t out_cap, const char* const* argv
     return true;
 }
 
-static bool win_run_createprocess(const char* const* argv,
-                                  const char* cwd,
-                                  const char* stdout_path,
-                                  const char* stderr_path,
-                                  BaaProcessResult* out_result)
+static bool win_start_createprocess(const char* const* argv,
+                                    const char* cwd,
+                                    const char* stdout_path,
+                                    const char* stderr_path,
+                                    HANDLE* out_process)
 {
-    result_init(out_result);
+    *out_process = NULL;
     if (!argv || !argv[0]) return false;
 
     char cmdline_utf8[8192];
@@ -292,24 +292,70 @@ static bool win_run_createprocess(const char* const* argv,
 
     if (!ok) return false;
 
+    CloseHandle(pi.hThread);
+    *out_process = pi.hProcess;
+    return true;
+}
+
+static bool win_wait_process(HANDLE process, BaaProcessResult* out_result)
+{
     out_result->started = true;
-    (void)WaitForSingleObject(pi.hProcess, INFINITE);
+    (void)WaitForSingleObject(process, INFINITE);
 
     DWORD code = 0;
-    if (!GetExitCodeProcess(pi.hProcess, &code))
+    if (!GetExitCodeProcess(process, &code))
         code = 1;
     out_result->exit_code = (int)code;
 
-    CloseHandle(pi.hThread);
-    CloseHandle(pi.hProcess);
+    CloseHandle(process);
     return true;
 }
 
+static bool win_run_createprocess(const char* const* argv,
+                                  const char* cwd,
+                                  const char* stdout_path,
+                                  const char* stderr_path,
+                                  BaaProcessResult* out_result)
+{
+    result_init(out_result);
+    HANDLE process = NULL;
+    if (!win_start_createprocess(argv, cwd, stdout_path, stderr_path, &process))
+        return false;
+    return win_wait_process(process, out_result);
+}
+
 bool baa_process_run(const char* const* argv, const char* cwd, BaaProcessResult* out_result)
 {
     return win_run_createprocess(argv, cwd, NULL, NULL, out_result);
 }
 
+bool baa_process_start(const char* const* argv, const char* cwd, BaaProcessHandle* out_handle)
+{
+    if (!out_handle) return false;
+    out_handle->started = false;
+    HANDLE process = NULL;
+    if (!win_start_createprocess(argv, cwd, NULL, NULL, &process))
+        return false;
+    out_handle->process = process;
+    out_handle->started = true;
+    return true;
+}
+
+bool baa_process_wait(BaaProcessHandle* handle, BaaProcessResult* out_result)
+{
+    result_init(out_result);
+    if (!handle || !handle->started) return false;
+    handle->started = false;
+    return win_wait_process((HANDLE)handle->process, out_result);
+}
+
+int baa_process_cpu_count(void)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+}
+
 bool baa_process_run_redirect(const char* const* argv,
                               const char* cwd,
                               const char* stdout_path,
@@ -335,13 +381,12 @@ static bool posix_redirect_file(const char* path, int target_fd)
     return true;
 }
 
-static bool posix_spawn_wait(const char* const* argv,
-                             const char* cwd,
-                             const char* stdout_path,
-                             const char* stderr_path,
-                             BaaProcessResult* out_result)
+static bool posix_spawn_start(const char* const* argv,
+                              const char* cwd,
+                              const char* stdout_path,
+                              const char* stderr_path,
+                              pid_t* out_pid)
 {
-    result_init(out_result);
     if (!argv || !argv[0]) return false;
 
     pid_t pid = fork();
@@ -373,9 +418,20 @@ static bool posix_spawn_wait(const char* const* argv,
         _exit(127);
     }
 
+    *out_pid = pid;
+    return true;
+}
+
+static bool posix_wait_pid(pid_t pid, BaaProcessResult* out_result)
+{
     out_result->started = true;
     int status = 0;
-    if (waitpid(pid, &status, 0) < 0)
+    pid_t got;
+    do
+    {
+        got = waitpid(pid, &status, 0);
+    } while (got < 0 && errno == EINTR);
+    if (got < 0)
         return false;
 
     if (WIFEXITED(status))
@@ -388,6 +444,19 @@ static bool posix_spawn_wait(const char* const* argv,
     return true;
 }
 
+static bool posix_spawn_wait(const char* const* argv,
+                             const char* cwd,
+                             const char* stdout_path,
+                             const char* stderr_path,
+                             BaaProcessResult* out_result)
+{
+    result_init(out_result);
+    pid_t pid = 0;
+    if (!posix_spawn_start(argv, cwd, stdout_path, stderr_path, &pid))
+        return false;
+    return posix_wait_pid(pid, out_result);
+}
+
 bool baa_process_run(const char* const* argv, const char* cwd, BaaProcessResult* out_result)
 {
     return posix_spawn_wait(argv, cwd, NULL, NULL, out_result);
@@ -402,4 +471,30 @@ bool baa_process_run_redirect(const char* const* argv,
     return posix_spawn_wait(argv, cwd, stdout_path, stderr_path, out_result);
 }
 
+bool baa_process_start(const char* const* argv, const char* cwd, BaaProcessHandle* out_handle)
+{
+    if (!out_handle) return false;
+    out_handle->started = false;
+    pid_t pid = 0;
+    if (!posix_spawn_start(argv, cwd, NULL, NULL, &pid))
+        return false;
+    out_handle->pid = (int)pid;
+    out_handle->started = true;
+    return true;
+}
+
+bool baa_process_wait(BaaProcessHandle* handle, BaaProcessResult* out_result)
+{
+    result_init(out_result);
+    if (!handle || !handle->started) return false;
+    handle->started = false;
+    return posix_wait_pid((pid_t)handle->pid, out_result);
+}
+
+int baa_process_cpu_count(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
 #endif
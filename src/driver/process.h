@@ -15,6 +15,19 @@ typedef struct
     bool started;
 } BaaProcessResult;
 
+/**
+ * @brief عملية أُطلقت ولم يُنتظر انتهاؤها بعد (baa_process_start).
+ */
+typedef struct
+{
+#ifdef _WIN32
+    void* process; // HANDLE
+#else
+    int pid;
+#endif
+    bool started;
+} BaaProcessHandle;
+
 /**
  * @brief تشغيل عملية وانتظار انتهائها.
  * @param argv مصفوفة وسائط منتهية بـ NULL (argv[0] هو اسم/مسار التنفيذ).
@@ -33,4 +46,21 @@ bool baa_process_run_redirect(const char* const* argv,
                               const char* stderr_path,
                               BaaProcessResult* out_result);
 
+/**
+ * @brief إطلاق عملية دون انتظارها؛ تُنتظر لاحقاً بـ baa_process_wait().
+ *
+ * المخرجات موروثة كما في baa_process_run().
+ */
+bool baa_process_start(const char* const* argv, const char* cwd, BaaProcessHandle* out_handle);
+
+/**
+ * @brief انتظار عملية أطلقتها baa_process_start() وتحرير مقبضها.
+ */
+bool baa_process_wait(BaaProcessHandle* handle, BaaProcessResult* out_result);
+
+/**
+ * @brief عدد المعالجات المتاحة للمضيف (1 على الأقل).
+ */
+int baa_process_cpu_count(void);
+
 #endif // BAA_PROCESS_H
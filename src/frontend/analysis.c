@@ -14,37 +14,32 @@
 
 #include <ctype.h>
 #include <limits.h>
+#include <stdatomic.h>
 
 // ============================================================================
 // جداول الرموز (Symbol Tables)
 // ============================================================================
 
-// نستخدم نفس الهيكلية البسيطة المستخدمة سابقاً لضمان التوافق.
-// في المستقبل، يمكن استبدالها بجداول تجزئة لدعم نطاقات أعمق بشكل أفضل.
+// كل الجداول قابلة للنمو: السجلات تُخصص من ساحة الحالة (عناوين ثابتة)،
+// والبحث بالاسم يمر عبر فهرس تجزئة لكل جدول بدلاً من المسح الخطي.
 
-#define ANALYSIS_MAX_SYMBOLS 100
-#define ANALYSIS_MAX_SCOPES  64
-#define ANALYSIS_MAX_FUNCS   256
 #define ANALYSIS_MAX_FUNC_PARAMS 32
-#define ANALYSIS_SYMBOL_HASH_BUCKETS 257
 #define ANALYSIS_DIAG_CODE_SEMANTIC "B1000"
 
-// أنواع مركبة (v0.3.4)
-#define ANALYSIS_MAX_ENUMS   128
-#define ANALYSIS_MAX_STRUCTS 128
-#define ANALYSIS_MAX_ENUM_MEMBERS 128
-#define ANALYSIS_MAX_STRUCT_FIELDS 128
-#define ANALYSIS_MAX_TYPE_ALIASES 256
+#include "analysis_tables.inc"
+
+typedef struct {
+    char* name;   // مملوك (strdup)
+    int64_t value;
+    const Node* decl_node;
+} EnumMemberDef;
 
 typedef struct {
     char* name; // مملوك (strdup)
     const Node* decl_node;
     int member_count;
-    struct {
-        char* name;   // مملوك (strdup)
-        int64_t value;
-        const Node* decl_node;
-    } members[ANALYSIS_MAX_ENUM_MEMBERS];
+    int member_cap;
+    EnumMemberDef* members; // مملوك (malloc)
 } EnumDef;
 
 typedef struct {
@@ -65,7 +60,8 @@ typedef struct {
     char* name; // مملوك (strdup)
     const Node* decl_node;
     int field_count;
-    StructFieldDef fields[ANALYSIS_MAX_STRUCT_FIELDS];
+    int field_cap;
+    StructFieldDef* fields; // مملوك (malloc)
     int size;
     int align;
     bool layout_done;
@@ -76,7 +72,8 @@ typedef struct {
     char* name; // مملوك (strdup)
     const Node* decl_node;
     int field_count;
-    StructFieldDef fields[ANALYSIS_MAX_STRUCT_FIELDS];
+    int field_cap;
+    StructFieldDef* fields; // مملوك (malloc)
     int size;
     int align;
     bool layout_done;
@@ -94,28 +91,6 @@ typedef struct {
     FuncPtrSig* target_func_sig; // مملوك (clone) عند TYPE_FUNC_PTR
 } TypeAliasDef;
 
-static EnumDef enum_defs[ANALYSIS_MAX_ENUMS];
-static int enum_count = 0;
-
-static StructDef struct_defs[ANALYSIS_MAX_STRUCTS];
-static int struct_count = 0;
-
-static UnionDef union_defs[ANALYSIS_MAX_STRUCTS];
-static int union_count = 0;
-
-static TypeAliasDef type_alias_defs[ANALYSIS_MAX_TYPE_ALIASES];
-static int type_alias_count = 0;
-
-static Symbol global_symbols[ANALYSIS_MAX_SYMBOLS];
-static int global_count = 0;
-static int global_symbol_hash_head[ANALYSIS_SYMBOL_HASH_BUCKETS];
-static int global_symbol_hash_next[ANALYSIS_MAX_SYMBOLS];
-
-static Symbol local_symbols[ANALYSIS_MAX_SYMBOLS];
-static int local_count = 0;
-static int local_symbol_hash_head[ANALYSIS_SYMBOL_HASH_BUCKETS];
-static int local_symbol_hash_next[ANALYSIS_MAX_SYMBOLS];
-
 typedef struct {
     char* name;         // مملوك (strdup) ويتم تحريره في reset_analysis()
     DataType return_type;
@@ -140,28 +115,68 @@ typedef struct {
     const Node* decl_node;
 } FuncSymbol;
 
-static FuncSymbol func_symbols[ANALYSIS_MAX_FUNCS];
-static int func_count = 0;
+/**
+ * @brief حالة التحليل الدلالي لجلسة ترجمة واحدة (مملوكة لخانة BAA_SESSION_SLOT_ANALYSIS).
+ */
+typedef struct {
+    AnalysisArena arena;
+
+    EnumDef** enum_defs;
+    int enum_count, enum_cap, enum_records;
+    AnalysisNameIndex enum_index;
+
+    StructDef** struct_defs;
+    int struct_count, struct_cap, struct_records;
+    AnalysisNameIndex struct_index;
+
+    UnionDef** union_defs;
+    int union_count, union_cap, union_records;
+    AnalysisNameIndex union_index;
 
-// مكدس النطاقات المحلية: نخزن قيمة local_count عند دخول نطاق جديد.
-static int scope_stack[ANALYSIS_MAX_SCOPES];
-static int scope_depth = 0;
+    TypeAliasDef** type_alias_defs;
+    int type_alias_count, type_alias_cap, type_alias_records;
+    AnalysisNameIndex type_alias_index;
 
-static bool has_error = false;
-static bool inside_loop = false;
-static bool inside_switch = false;
+    Symbol** global_symbols;
+    int global_count, global_cap, global_records;
+    AnalysisNameIndex global_index;
 
-// معلومات الملف الحالي (للتحذيرات)
-static const char* current_filename = NULL;
+    // سجلات المحلي تبقى مخصصة بعد الخروج من النطاق ويُعاد استخدامها.
+    Symbol** local_symbols;
+    int local_count, local_cap, local_records;
+    AnalysisNameIndex local_index;
 
-static bool in_function = false;
-static DataType current_func_return_type = TYPE_INT;
-static DataType current_func_return_ptr_base_type = TYPE_INT;
-static const char* current_func_return_ptr_base_type_name = NULL;
-static int current_func_return_ptr_depth = 0;
-static FuncPtrSig* current_func_return_func_sig = NULL;
-static bool current_func_is_variadic = false;
-static const char* current_func_variadic_anchor_name = NULL;
+    FuncSymbol** func_symbols;
+    int func_count, func_cap, func_records;
+    AnalysisNameIndex func_index;
+
+    // مكدس النطاقات المحلية: نخزن قيمة local_count عند دخول نطاق جديد.
+    int* scope_stack;
+    int scope_cap;
+    int scope_depth;
+
+    bool has_error;
+    bool inside_loop;
+    bool inside_switch;
+
+    // معلومات الملف الحالي (للتحذيرات)
+    const char* current_filename;
+
+    // ساحة الشجرة الجارية: كل نص أو توقيع يُعلَّق على عقدة يُخصَّص منها.
+    AstArena* ast_arena;
+
+    bool in_function;
+    DataType current_func_return_type;
+    DataType current_func_return_ptr_base_type;
+    const char* current_func_return_ptr_base_type_name;
+    int current_func_return_ptr_depth;
+    FuncPtrSig* current_func_return_func_sig;
+    bool current_func_is_variadic;
+    const char* current_func_variadic_anchor_name;
+} AnalysisState;
+
+// حالة جلسة analyze() الجارية على هذا الخيط؛ تُضبط داخلها فقط.
+static BAA_THREAD_LOCAL AnalysisState* g_analysis = NULL;
 
 // ============================================================================
 // دوال مساعدة (Helper Functions)
@@ -179,7 +194,7 @@ static Token semantic_make_token(const char* filename, int line, int col)
     memset(&t, 0, sizeof(t));
     t.type = TOKEN_INVALID;
     t.value = NULL;
-    t.filename = filename ? filename : (current_filename ? current_filename : "غير_معروف");
+    t.filename = filename ? filename : (g_analysis->current_filename ? g_analysis->current_filename : "غير_معروف");
     t.line = (line > 0) ? line : 1;
     t.col = (col > 0) ? col : 1;
     t.length = 1;
@@ -189,7 +204,7 @@ static Token semantic_make_token(const char* filename, int line, int col)
 static DiagnosticSpan semantic_make_span(const char* filename, int line, int col, int length)
 {
     DiagnosticSpan span;
-    span.filename = filename ? filename : (current_filename ? current_filename : "غير_معروف");
+    span.filename = filename ? filename : (g_analysis->current_filename ? g_analysis->current_filename : "غير_معروف");
     span.line = (line > 0) ? line : 1;
     span.col = (col > 0) ? col : 1;
     span.end_line = span.line;
@@ -258,7 +273,7 @@ static void semantic_error_vloc(const char* filename,
                                 const char* message,
                                 va_list args)
 {
-    has_error = true;
+    g_analysis->has_error = true;
 
     Token tok = semantic_make_token(filename, line, col);
     char buf[1024];
@@ -271,7 +286,7 @@ static void semantic_error_vnode_hint(Node* node,
                                       const char* message,
                                       va_list args)
 {
-    has_error = true;
+    g_analysis->has_error = true;
 
     char buf[1024];
     (void)vsnprintf(buf, sizeof(buf), message, args);
@@ -284,7 +299,7 @@ static void semantic_error_vnode_hint(Node* node,
 
 static void semantic_error_vspan(DiagnosticSpan span, const char* message, va_list args)
 {
-    has_error = true;
+    g_analysis->has_error = true;
 
     char buf[1024];
     (void)vsnprintf(buf, sizeof(buf), message, args);
@@ -345,51 +360,18 @@ static unsigned int symbol_hash_name(const char* name)
     return h;
 }
 
-static void int_array_fill_minus_one(int* arr, int count)
-{
-    if (!arr || count <= 0) return;
-    for (int i = 0; i < count; i++) arr[i] = -1;
-}
-
-static void symbol_hash_reset_heads(int* heads, int count)
-{
-    int_array_fill_minus_one(heads, count);
-}
-
-static void symbol_hash_reset_next(int* next_arr, int count)
-{
-    int_array_fill_minus_one(next_arr, count);
-}
-
-static void symbol_hash_insert(const Symbol* symbols,
-                               int* heads,
-                               int* next_arr,
-                               int idx)
-{
-    if (!symbols || !heads || !next_arr || idx < 0) return;
-    const unsigned int h = symbol_hash_name(symbols[idx].name) % (unsigned int)ANALYSIS_SYMBOL_HASH_BUCKETS;
-    next_arr[idx] = heads[h];
-    heads[h] = idx;
-}
-
 static Symbol* global_lookup_by_name(const char* name)
 {
-    if (!name) return NULL;
-    const unsigned int h = symbol_hash_name(name) % (unsigned int)ANALYSIS_SYMBOL_HASH_BUCKETS;
-    for (int i = global_symbol_hash_head[h]; i >= 0; i = global_symbol_hash_next[i]) {
-        if (strcmp(global_symbols[i].name, name) == 0) return &global_symbols[i];
-    }
-    return NULL;
+    int i = analysis_name_index_find(&g_analysis->global_index, (void* const*)g_analysis->global_symbols,
+                                     name, symbol_hash_name(name));
+    return i >= 0 ? g_analysis->global_symbols[i] : NULL;
 }
 
 static Symbol* local_lookup_latest_by_name(const char* name)
 {
-    if (!name) return NULL;
-    const unsigned int h = symbol_hash_name(name) % (unsigned int)ANALYSIS_SYMBOL_HASH_BUCKETS;
-    for (int i = local_symbol_hash_head[h]; i >= 0; i = local_symbol_hash_next[i]) {
-        if (strcmp(local_symbols[i].name, name) == 0) return &local_symbols[i];
-    }
-    return NULL;
+    int i = analysis_name_index_find(&g_analysis->local_index, (void* const*)g_analysis->local_symbols,
+                                     name, symbol_hash_name(name));
+    return i >= 0 ? g_analysis->local_symbols[i] : NULL;
 }
 
 static int local_lookup_in_scope(const char* name, int start, int end_exclusive)
@@ -397,9 +379,11 @@ static int local_lookup_in_scope(const char* name, int start, int end_exclusive)
     if (!name) return -1;
     if (start < 0) start = 0;
     if (end_exclusive < start) end_exclusive = start;
-    const unsigned int h = symbol_hash_name(name) % (unsigned int)ANALYSIS_SYMBOL_HASH_BUCKETS;
-    for (int i = local_symbol_hash_head[h]; i >= 0; i = local_symbol_hash_next[i]) {
-        if (i >= start && i < end_exclusive && strcmp(local_symbols[i].name, name) == 0) {
+    const unsigned int h = symbol_hash_name(name);
+    const AnalysisNameIndex* index = &g_analysis->local_index;
+    for (int i = analysis_name_index_head(index, h); i >= 0; i = index->next[i]) {
+        if (i >= start && i < end_exclusive && index->hashes[i] == h &&
+            strcmp(g_analysis->local_symbols[i]->name, name) == 0) {
             return i;
         }
     }
@@ -410,22 +394,26 @@ static int local_lookup_before_scope(const char* name, int before_index)
 {
     if (!name) return -1;
     if (before_index <= 0) return -1;
-    const unsigned int h = symbol_hash_name(name) % (unsigned int)ANALYSIS_SYMBOL_HASH_BUCKETS;
-    for (int i = local_symbol_hash_head[h]; i >= 0; i = local_symbol_hash_next[i]) {
-        if (i < before_index && strcmp(local_symbols[i].name, name) == 0) {
+    const unsigned int h = symbol_hash_name(name);
+    const AnalysisNameIndex* index = &g_analysis->local_index;
+    for (int i = analysis_name_index_head(index, h); i >= 0; i = index->next[i]) {
+        if (i < before_index && index->hashes[i] == h &&
+            strcmp(g_analysis->local_symbols[i]->name, name) == 0) {
             return i;
         }
     }
     return -1;
 }
 
-static void local_symbol_hash_rebuild(void)
+/**
+ * @brief إخراج المحليات من count فصاعداً من الجدول وفهرسه (كلفة خطية في عدد المُزال).
+ */
+static void local_symbols_truncate(int count)
 {
-    symbol_hash_reset_heads(local_symbol_hash_head, ANALYSIS_SYMBOL_HASH_BUCKETS);
-    symbol_hash_reset_next(local_symbol_hash_next, ANALYSIS_MAX_SYMBOLS);
-    for (int i = 0; i < local_count; i++) {
-        symbol_hash_insert(local_symbols, local_symbol_hash_head, local_symbol_hash_next, i);
-    }
+    if (count < 0) count = 0;
+    if (count >= g_analysis->local_count) return;
+    analysis_name_index_truncate(&g_analysis->local_index, g_analysis->local_count, count);
+    g_analysis->local_count = count;
 }
 
 static void symbol_release_array_dims(Symbol* sym)
@@ -448,142 +436,198 @@ static void symbol_release_array_dims(Symbol* sym)
  * @brief إعادة تعيين جداول الرموز.
  */
 static void reset_analysis() {
-    for (int i = 0; i < global_count; i++) {
-        symbol_release_array_dims(&global_symbols[i]);
-    }
-    for (int i = 0; i < local_count; i++) {
-        symbol_release_array_dims(&local_symbols[i]);
-    }
-
-    global_count = 0;
-    local_count = 0;
-    scope_depth = 0;
-    symbol_hash_reset_heads(global_symbol_hash_head, ANALYSIS_SYMBOL_HASH_BUCKETS);
-    symbol_hash_reset_next(global_symbol_hash_next, ANALYSIS_MAX_SYMBOLS);
-    symbol_hash_reset_heads(local_symbol_hash_head, ANALYSIS_SYMBOL_HASH_BUCKETS);
-    symbol_hash_reset_next(local_symbol_hash_next, ANALYSIS_MAX_SYMBOLS);
-    for (int i = 0; i < func_count; i++) {
-        free(func_symbols[i].name);
-        func_symbols[i].name = NULL;
-        free(func_symbols[i].return_ptr_base_type_name);
-        func_symbols[i].return_ptr_base_type_name = NULL;
-        funcsig_free(func_symbols[i].return_func_sig);
-        func_symbols[i].return_func_sig = NULL;
-        funcsig_free(func_symbols[i].ref_funcptr_sig);
-        func_symbols[i].ref_funcptr_sig = NULL;
-        free(func_symbols[i].param_types);
-        func_symbols[i].param_types = NULL;
-        free(func_symbols[i].param_ptr_base_types);
-        func_symbols[i].param_ptr_base_types = NULL;
-        if (func_symbols[i].param_ptr_base_type_names) {
-            for (int k = 0; k < func_symbols[i].param_count; k++) {
-                free(func_symbols[i].param_ptr_base_type_names[k]);
+    for (int i = 0; i < g_analysis->global_count; i++) {
+        symbol_release_array_dims(g_analysis->global_symbols[i]);
+    }
+    for (int i = 0; i < g_analysis->local_count; i++) {
+        symbol_release_array_dims(g_analysis->local_symbols[i]);
+    }
+
+    g_analysis->global_count = 0;
+    g_analysis->local_count = 0;
+    g_analysis->scope_depth = 0;
+    for (int i = 0; i < g_analysis->func_count; i++) {
+        free(g_analysis->func_symbols[i]->name);
+        g_analysis->func_symbols[i]->name = NULL;
+        free(g_analysis->func_symbols[i]->return_ptr_base_type_name);
+        g_analysis->func_symbols[i]->return_ptr_base_type_name = NULL;
+        funcsig_free(g_analysis->func_symbols[i]->return_func_sig);
+        g_analysis->func_symbols[i]->return_func_sig = NULL;
+        funcsig_free(g_analysis->func_symbols[i]->ref_funcptr_sig);
+        g_analysis->func_symbols[i]->ref_funcptr_sig = NULL;
+        free(g_analysis->func_symbols[i]->param_types);
+        g_analysis->func_symbols[i]->param_types = NULL;
+        free(g_analysis->func_symbols[i]->param_ptr_base_types);
+        g_analysis->func_symbols[i]->param_ptr_base_types = NULL;
+        if (g_analysis->func_symbols[i]->param_ptr_base_type_names) {
+            for (int k = 0; k < g_analysis->func_symbols[i]->param_count; k++) {
+                free(g_analysis->func_symbols[i]->param_ptr_base_type_names[k]);
             }
         }
-        free(func_symbols[i].param_ptr_base_type_names);
-        func_symbols[i].param_ptr_base_type_names = NULL;
-        free(func_symbols[i].param_ptr_depths);
-        func_symbols[i].param_ptr_depths = NULL;
-        if (func_symbols[i].param_func_sigs) {
-            for (int k = 0; k < func_symbols[i].param_count; k++) {
-                funcsig_free(func_symbols[i].param_func_sigs[k]);
+        free(g_analysis->func_symbols[i]->param_ptr_base_type_names);
+        g_analysis->func_symbols[i]->param_ptr_base_type_names = NULL;
+        free(g_analysis->func_symbols[i]->param_ptr_depths);
+        g_analysis->func_symbols[i]->param_ptr_depths = NULL;
+        if (g_analysis->func_symbols[i]->param_func_sigs) {
+            for (int k = 0; k < g_analysis->func_symbols[i]->param_count; k++) {
+                funcsig_free(g_analysis->func_symbols[i]->param_func_sigs[k]);
             }
         }
-        free(func_symbols[i].param_func_sigs);
-        func_symbols[i].param_func_sigs = NULL;
-        func_symbols[i].param_count = 0;
-        func_symbols[i].is_variadic = false;
-        func_symbols[i].is_defined = false;
+        free(g_analysis->func_symbols[i]->param_func_sigs);
+        g_analysis->func_symbols[i]->param_func_sigs = NULL;
+        g_analysis->func_symbols[i]->param_count = 0;
+        g_analysis->func_symbols[i]->is_variadic = false;
+        g_analysis->func_symbols[i]->is_defined = false;
     }
-    func_count = 0;
+    g_analysis->func_count = 0;
 
     // تحرير تعريفات التعداد/الهياكل
-    for (int i = 0; i < enum_count; i++) {
-        free(enum_defs[i].name);
-        enum_defs[i].name = NULL;
-        for (int j = 0; j < enum_defs[i].member_count; j++) {
-            free(enum_defs[i].members[j].name);
-            enum_defs[i].members[j].name = NULL;
+    for (int i = 0; i < g_analysis->enum_count; i++) {
+        free(g_analysis->enum_defs[i]->name);
+        g_analysis->enum_defs[i]->name = NULL;
+        for (int j = 0; j < g_analysis->enum_defs[i]->member_count; j++) {
+            free(g_analysis->enum_defs[i]->members[j].name);
+            g_analysis->enum_defs[i]->members[j].name = NULL;
         }
-        enum_defs[i].member_count = 0;
-    }
-    enum_count = 0;
-
-    for (int i = 0; i < struct_count; i++) {
-        free(struct_defs[i].name);
-        struct_defs[i].name = NULL;
-        for (int j = 0; j < struct_defs[i].field_count; j++) {
-            free(struct_defs[i].fields[j].name);
-            struct_defs[i].fields[j].name = NULL;
-            free(struct_defs[i].fields[j].type_name);
-            struct_defs[i].fields[j].type_name = NULL;
-            free(struct_defs[i].fields[j].ptr_base_type_name);
-            struct_defs[i].fields[j].ptr_base_type_name = NULL;
+        free(g_analysis->enum_defs[i]->members);
+        g_analysis->enum_defs[i]->members = NULL;
+        g_analysis->enum_defs[i]->member_count = 0;
+    }
+    g_analysis->enum_count = 0;
+
+    for (int i = 0; i < g_analysis->struct_count; i++) {
+        free(g_analysis->struct_defs[i]->name);
+        g_analysis->struct_defs[i]->name = NULL;
+        for (int j = 0; j < g_analysis->struct_defs[i]->field_count; j++) {
+            free(g_analysis->struct_defs[i]->fields[j].name);
+            g_analysis->struct_defs[i]->fields[j].name = NULL;
+            free(g_analysis->struct_defs[i]->fields[j].type_name);
+            g_analysis->struct_defs[i]->fields[j].type_name = NULL;
+            free(g_analysis->struct_defs[i]->fields[j].ptr_base_type_name);
+            g_analysis->struct_defs[i]->fields[j].ptr_base_type_name = NULL;
         }
-        struct_defs[i].field_count = 0;
-        struct_defs[i].size = 0;
-        struct_defs[i].align = 0;
-        struct_defs[i].layout_done = false;
-        struct_defs[i].layout_in_progress = false;
-    }
-    struct_count = 0;
-
-    for (int i = 0; i < union_count; i++) {
-        free(union_defs[i].name);
-        union_defs[i].name = NULL;
-        for (int j = 0; j < union_defs[i].field_count; j++) {
-            free(union_defs[i].fields[j].name);
-            union_defs[i].fields[j].name = NULL;
-            free(union_defs[i].fields[j].type_name);
-            union_defs[i].fields[j].type_name = NULL;
-            free(union_defs[i].fields[j].ptr_base_type_name);
-            union_defs[i].fields[j].ptr_base_type_name = NULL;
+        free(g_analysis->struct_defs[i]->fields);
+        g_analysis->struct_defs[i]->fields = NULL;
+        g_analysis->struct_defs[i]->field_count = 0;
+        g_analysis->struct_defs[i]->size = 0;
+        g_analysis->struct_defs[i]->align = 0;
+        g_analysis->struct_defs[i]->layout_done = false;
+        g_analysis->struct_defs[i]->layout_in_progress = false;
+    }
+    g_analysis->struct_count = 0;
+
+    for (int i = 0; i < g_analysis->union_count; i++) {
+        free(g_analysis->union_defs[i]->name);
+        g_analysis->union_defs[i]->name = NULL;
+        for (int j = 0; j < g_analysis->union_defs[i]->field_count; j++) {
+            free(g_analysis->union_defs[i]->fields[j].name);
+            g_analysis->union_defs[i]->fields[j].name = NULL;
+            free(g_analysis->union_defs[i]->fields[j].type_name);
+            g_analysis->union_defs[i]->fields[j].type_name = NULL;
+            free(g_analysis->union_defs[i]->fields[j].ptr_base_type_name);
+            g_analysis->union_defs[i]->fields[j].ptr_base_type_name = NULL;
         }
-        union_defs[i].field_count = 0;
-        union_defs[i].size = 0;
-        union_defs[i].align = 0;
-        union_defs[i].layout_done = false;
-        union_defs[i].layout_in_progress = false;
-    }
-    union_count = 0;
-
-    for (int i = 0; i < type_alias_count; i++) {
-        free(type_alias_defs[i].name);
-        type_alias_defs[i].name = NULL;
-        free(type_alias_defs[i].target_type_name);
-        type_alias_defs[i].target_type_name = NULL;
-        free(type_alias_defs[i].target_ptr_base_type_name);
-        type_alias_defs[i].target_ptr_base_type_name = NULL;
-        funcsig_free(type_alias_defs[i].target_func_sig);
-        type_alias_defs[i].target_func_sig = NULL;
-        type_alias_defs[i].target_type = TYPE_INT;
-        type_alias_defs[i].target_ptr_base_type = TYPE_INT;
-        type_alias_defs[i].target_ptr_depth = 0;
-    }
-    type_alias_count = 0;
-
-    has_error = false;
-    inside_loop = false;
-    inside_switch = false;
-    in_function = false;
-    current_func_return_type = TYPE_INT;
-    current_func_return_ptr_base_type = TYPE_INT;
-    current_func_return_ptr_base_type_name = NULL;
-    current_func_return_ptr_depth = 0;
-    current_func_return_func_sig = NULL;
-    current_func_is_variadic = false;
-    current_func_variadic_anchor_name = NULL;
+        free(g_analysis->union_defs[i]->fields);
+        g_analysis->union_defs[i]->fields = NULL;
+        g_analysis->union_defs[i]->field_count = 0;
+        g_analysis->union_defs[i]->size = 0;
+        g_analysis->union_defs[i]->align = 0;
+        g_analysis->union_defs[i]->layout_done = false;
+        g_analysis->union_defs[i]->layout_in_progress = false;
+    }
+    g_analysis->union_count = 0;
+
+    for (int i = 0; i < g_analysis->type_alias_count; i++) {
+        free(g_analysis->type_alias_defs[i]->name);
+        g_analysis->type_alias_defs[i]->name = NULL;
+        free(g_analysis->type_alias_defs[i]->target_type_name);
+        g_analysis->type_alias_defs[i]->target_type_name = NULL;
+        free(g_analysis->type_alias_defs[i]->target_ptr_base_type_name);
+        g_analysis->type_alias_defs[i]->target_ptr_base_type_name = NULL;
+        funcsig_free(g_analysis->type_alias_defs[i]->target_func_sig);
+        g_analysis->type_alias_defs[i]->target_func_sig = NULL;
+        g_analysis->type_alias_defs[i]->target_type = TYPE_INT;
+        g_analysis->type_alias_defs[i]->target_ptr_base_type = TYPE_INT;
+        g_analysis->type_alias_defs[i]->target_ptr_depth = 0;
+    }
+    g_analysis->type_alias_count = 0;
+
+    // السجلات والأسماء في الساحة تُحرر دفعة واحدة؛ مصفوفات المؤشرات والفهارس تبقى للجلسة.
+    analysis_arena_free(&g_analysis->arena);
+    g_analysis->enum_records = 0;
+    g_analysis->struct_records = 0;
+    g_analysis->union_records = 0;
+    g_analysis->type_alias_records = 0;
+    g_analysis->global_records = 0;
+    g_analysis->local_records = 0;
+    g_analysis->func_records = 0;
+    analysis_name_index_relink(&g_analysis->enum_index, 0);
+    analysis_name_index_relink(&g_analysis->struct_index, 0);
+    analysis_name_index_relink(&g_analysis->union_index, 0);
+    analysis_name_index_relink(&g_analysis->type_alias_index, 0);
+    analysis_name_index_relink(&g_analysis->global_index, 0);
+    analysis_name_index_relink(&g_analysis->local_index, 0);
+    analysis_name_index_relink(&g_analysis->func_index, 0);
+
+    g_analysis->has_error = false;
+    g_analysis->inside_loop = false;
+    g_analysis->inside_switch = false;
+    g_analysis->in_function = false;
+    g_analysis->current_func_return_type = TYPE_INT;
+    g_analysis->current_func_return_ptr_base_type = TYPE_INT;
+    g_analysis->current_func_return_ptr_base_type_name = NULL;
+    g_analysis->current_func_return_ptr_depth = 0;
+    g_analysis->current_func_return_func_sig = NULL;
+    g_analysis->current_func_is_variadic = false;
+    g_analysis->current_func_variadic_anchor_name = NULL;
 }
 
-static FuncSymbol* func_lookup(const char* name)
+static void analysis_state_destroy(void* state)
 {
-    if (!name) return NULL;
-    for (int i = 0; i < func_count; i++) {
-        if (func_symbols[i].name && strcmp(func_symbols[i].name, name) == 0) {
-            return &func_symbols[i];
-        }
+    AnalysisState* previous = g_analysis;
+    g_analysis = (AnalysisState*)state;
+    reset_analysis();
+    free(g_analysis->enum_defs);
+    free(g_analysis->struct_defs);
+    free(g_analysis->union_defs);
+    free(g_analysis->type_alias_defs);
+    free(g_analysis->global_symbols);
+    free(g_analysis->local_symbols);
+    free(g_analysis->func_symbols);
+    free(g_analysis->scope_stack);
+    analysis_name_index_free(&g_analysis->enum_index);
+    analysis_name_index_free(&g_analysis->struct_index);
+    analysis_name_index_free(&g_analysis->union_index);
+    analysis_name_index_free(&g_analysis->type_alias_index);
+    analysis_name_index_free(&g_analysis->global_index);
+    analysis_name_index_free(&g_analysis->local_index);
+    analysis_name_index_free(&g_analysis->func_index);
+    g_analysis = previous;
+    free(state);
+}
+
+/**
+ * @brief حالة التحليل المملوكة للجلسة الحالية (تُنشأ عند أول تحليل).
+ */
+static AnalysisState* analysis_state_for_session(BaaSession* session)
+{
+    AnalysisState* state = (AnalysisState*)baa_session_slot(session, BAA_SESSION_SLOT_ANALYSIS);
+    if (state) return state;
+
+    state = (AnalysisState*)calloc(1, sizeof(AnalysisState));
+    if (!state) {
+        fprintf(stderr, "Fatal: out of memory while allocating semantic analysis state\n");
+        exit(1);
     }
-    return NULL;
+    baa_session_set_slot(session, BAA_SESSION_SLOT_ANALYSIS, state, analysis_state_destroy);
+    return state;
+}
+
+static FuncSymbol* func_lookup(const char* name)
+{
+    int i = analysis_name_index_find(&g_analysis->func_index, (void* const*)g_analysis->func_symbols,
+                                     name, symbol_hash_name(name));
+    return i >= 0 ? g_analysis->func_symbols[i] : NULL;
 }
 
 static int func_signature_matches_decl(const FuncSymbol* a, const Node* node)
@@ -644,13 +688,9 @@ static int func_signature_matches_decl(const FuncSymbol* a, const Node* node)
 
 static TypeAliasDef* type_alias_lookup_def(const char* name)
 {
-    if (!name) return NULL;
-    for (int i = 0; i < type_alias_count; i++) {
-        if (type_alias_defs[i].name && strcmp(type_alias_defs[i].name, name) == 0) {
-            return &type_alias_defs[i];
-        }
-    }
-    return NULL;
+    int i = analysis_name_index_find(&g_analysis->type_alias_index, (void* const*)g_analysis->type_alias_defs,
+                                     name, symbol_hash_name(name));
+    return i >= 0 ? g_analysis->type_alias_defs[i] : NULL;
 }
 
 static void func_register(Node* node)
@@ -731,7 +771,7 @@ static void func_register(Node* node)
                 return;
             }
             existing->is_defined = true;
-            existing->decl_file = node->filename ? node->filename : current_filename;
+            existing->decl_file = node->filename ? node->filename : g_analysis->current_filename;
             existing->decl_line = node->line;
             existing->decl_col = node->col;
             existing->decl_node = node;
@@ -739,13 +779,15 @@ static void func_register(Node* node)
         return;
     }
 
-    if (func_count >= ANALYSIS_MAX_FUNCS) {
-        semantic_error(node, "عدد الدوال كبير جداً.");
+    FuncSymbol* fs = (FuncSymbol*)analysis_table_slot(&g_analysis->arena, &g_analysis->func_symbols,
+                                                       &g_analysis->func_cap, &g_analysis->func_records,
+                                                       g_analysis->func_count, sizeof(FuncSymbol));
+    if (!fs || !analysis_name_index_insert(&g_analysis->func_index, g_analysis->func_count,
+                                           symbol_hash_name(name))) {
+        semantic_error(node, "نفدت الذاكرة أثناء تسجيل الدالة '%s'.", name);
         return;
     }
-
-    FuncSymbol* fs = &func_symbols[func_count++];
-    memset(fs, 0, sizeof(*fs));
+    g_analysis->func_count++;
     fs->name = strdup(name);
     if (!fs->name) {
         semantic_error(node, "نفدت الذاكرة أثناء تسجيل اسم الدالة.");
@@ -759,7 +801,7 @@ static void func_register(Node* node)
     fs->ref_funcptr_sig = NULL;
     fs->param_count = param_count;
     fs->is_variadic = node->data.func_def.is_variadic;
-    fs->decl_file = node->filename ? node->filename : current_filename;
+    fs->decl_file = node->filename ? node->filename : g_analysis->current_filename;
     fs->decl_line = node->line;
     fs->decl_col = node->col;
     fs->decl_node = node;
@@ -858,3 +900,32 @@ static void func_register(Node* node)
 #include "analysis_format.c"
 #include "analysis_infer_expr.c"
 #include "analysis_visit.c"
+
+/**
+ * @brief نقطة الدخول الرئيسية للتحليل.
+ * @param session جلسة الترجمة (تُربط بالخيط طوال الاستدعاء للتشخيصات)
+ * @param program عقدة البرنامج
+ * @return true إذا لم تحدث أخطاء
+ */
+bool analyze(BaaSession* session, Node* program) {
+    if (!session) return false;
+    BaaSession* previous_session = baa_session_bind(session);
+    AnalysisState* previous = g_analysis;
+    g_analysis = analysis_state_for_session(session);
+    reset_analysis();
+    
+    // تعيين اسم الملف الحالي (للتحذيرات)
+    if (program && program->filename) {
+        g_analysis->current_filename = program->filename;
+    } else {
+        g_analysis->current_filename = "المصدر";
+    }
+    g_analysis->ast_arena =
+        (program && program->type == NODE_PROGRAM) ? program->data.program.arena : NULL;
+    
+    analyze_node(program);
+    bool ok = !g_analysis->has_error;
+    g_analysis = previous;
+    (void)baa_session_bind(previous_session);
+    return ok;
+}
@@ -10,6 +10,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "ast.h"
+#include "../support/session.h"
 
 /**
  * @enum ScopeType
@@ -25,12 +26,12 @@ typedef enum {
  * @brief يمثل رمزاً (متغيراً) في جدول الرموز.
  */
 typedef struct {
-    char name[32];     // اسم الرمز
+    const char* name;  // اسم الرمز (مملوك لساحة التحليل)
     ScopeType scope;   // النطاق (عام أو محلي)
     DataType type;     // نوع البيانات (للمتغير: نوعه، للمصفوفة: نوع العنصر)
-    char type_name[32]; // اسم النوع عند TYPE_ENUM/TYPE_STRUCT (فارغ لغير ذلك)
+    const char* type_name; // اسم النوع عند TYPE_ENUM/TYPE_STRUCT ("" لغير ذلك)
     DataType ptr_base_type;      // نوع أساس المؤشر عندما type == TYPE_POINTER
-    char ptr_base_type_name[32]; // اسم النوع المركب لأساس المؤشر
+    const char* ptr_base_type_name; // اسم النوع المركب لأساس المؤشر ("" لغير ذلك)
     int ptr_depth;               // عمق المؤشر عندما type == TYPE_POINTER
     FuncPtrSig* func_sig;        // توقيع مؤشر الدالة عندما type == TYPE_FUNC_PTR
     bool is_array;     // هل الرمز مصفوفة؟
@@ -68,9 +69,10 @@ const BaaBuiltinDescriptor* baa_builtin_descriptors(size_t* count);
 
 /**
  * @brief تنفيذ مرحلة التحليل الدلالي للتحقق من الأنواع والرموز.
+ * @param session جلسة الترجمة المالكة لحالة التحليل والتشخيصات.
  * @param program عقدة البرنامج الرئيسية (AST Root)
  * @return true إذا كان البرنامج سليماً، false في حال وجود أخطاء.
  */
-bool analyze(Node* program);
+bool analyze(BaaSession* session, Node* program);
 
 #endif
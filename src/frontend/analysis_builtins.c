@@ -597,11 +597,13 @@ const BaaBuiltinDescriptor* baa_builtin_descriptors(size_t* count)
             ANALYSIS_ARRAY_LEN(builtin_time_funcs) +
             ANALYSIS_ARRAY_LEN(builtin_error_funcs) + 7
     };
+    // الجدول ثابت المحتوى: كل خيط يملؤه بالقيم نفسها وبالترتيب نفسه، ولا يُنشر
+    // العدد إلا بعد اكتمال التعبئة، لذا تبقى التهيئة الكسولة آمنة مع الخيوط.
     static BaaBuiltinDescriptor descriptors[BUILTIN_DESCRIPTOR_CAPACITY];
-    static size_t descriptor_count = 0;
-    static bool initialized = false;
+    static atomic_size_t published_count = 0;
 
-    if (!initialized)
+    size_t descriptor_count = atomic_load_explicit(&published_count, memory_order_acquire);
+    if (descriptor_count == 0)
     {
 #define APPEND_BUILTIN_TABLE(table_name)                                      \
         do                                                                    \
@@ -659,7 +661,7 @@ const BaaBuiltinDescriptor* baa_builtin_descriptors(size_t* count)
                                builtin_variadic_end_param_types, false);
 
 #undef APPEND_SPECIAL_BUILTIN
-        initialized = true;
+        atomic_store_explicit(&published_count, descriptor_count, memory_order_release);
     }
 
     if (count) *count = descriptor_count;
@@ -739,7 +741,7 @@ static bool builtin_check_variadic_runtime_call(Node* call_node, const char* fna
         return false;
     }
 
-    if (!current_func_is_variadic) {
+    if (!g_analysis->current_func_is_variadic) {
         semantic_error(call_node, "استدعاء '%s' مسموح فقط داخل دالة متغيرة المعاملات.", fname);
     }
 
@@ -761,12 +763,12 @@ static bool builtin_check_variadic_runtime_call(Node* call_node, const char* fna
             (void)infer_type(a1);
             if (a1->type != NODE_VAR_REF || !a1->data.var_ref.name) {
                 semantic_error(a1, "نداء 'بدء_معاملات': المعامل الثاني يجب أن يكون اسم آخر معامل ثابت.");
-            } else if (!current_func_variadic_anchor_name) {
+            } else if (!g_analysis->current_func_variadic_anchor_name) {
                 semantic_error(a1, "نداء 'بدء_معاملات': لا يوجد معامل ثابت في الدالة الحالية.");
-            } else if (strcmp(a1->data.var_ref.name, current_func_variadic_anchor_name) != 0) {
+            } else if (strcmp(a1->data.var_ref.name, g_analysis->current_func_variadic_anchor_name) != 0) {
                 semantic_error(a1,
                                "نداء 'بدء_معاملات': المعامل الثاني يجب أن يكون '%s'.",
-                               current_func_variadic_anchor_name);
+                               g_analysis->current_func_variadic_anchor_name);
             }
         }
 
@@ -5,32 +5,32 @@
 static void check_unused_local_variables_range(int start, int end);
 
 static int current_scope_start(void) {
-    if (scope_depth <= 0) return 0;
-    return scope_stack[scope_depth - 1];
+    if (g_analysis->scope_depth <= 0) return 0;
+    return g_analysis->scope_stack[g_analysis->scope_depth - 1];
 }
 
 static void scope_push(void) {
-    if (scope_depth >= (int)(sizeof(scope_stack) / sizeof(scope_stack[0]))) {
-        semantic_error(NULL, "عدد النطاقات المتداخلة كبير جداً.");
+    if (!analysis_grow_array(&g_analysis->scope_stack, &g_analysis->scope_cap,
+                             g_analysis->scope_depth + 1, sizeof(int))) {
+        semantic_error(NULL, "نفدت الذاكرة أثناء فتح نطاق جديد.");
         return;
     }
-    scope_stack[scope_depth++] = local_count;
+    g_analysis->scope_stack[g_analysis->scope_depth++] = g_analysis->local_count;
 }
 
 static void scope_pop(void) {
-    if (scope_depth <= 0) return;
-    int start = scope_stack[--scope_depth];
+    if (g_analysis->scope_depth <= 0) return;
+    int start = g_analysis->scope_stack[--g_analysis->scope_depth];
 
     // تحذيرات المتغيرات غير المستخدمة لهذا النطاق فقط
-    check_unused_local_variables_range(start, local_count);
+    check_unused_local_variables_range(start, g_analysis->local_count);
 
-    for (int i = start; i < local_count; i++) {
-        symbol_release_array_dims(&local_symbols[i]);
+    for (int i = start; i < g_analysis->local_count; i++) {
+        symbol_release_array_dims(g_analysis->local_symbols[i]);
     }
 
-    // إخراج رموز النطاق من الجدول (منطقيًا)
-    local_count = start;
-    local_symbol_hash_rebuild();
+    // إخراج رموز النطاق من الجدول وفك ربطها من الفهرس (بدون إعادة بناء)
+    local_symbols_truncate(start);
 }
 
 /**
@@ -66,14 +66,9 @@ static void add_symbol(const char* name,
         return;
     }
 
-    size_t name_len = strlen(name);
-    size_t name_cap = sizeof(global_symbols[0].name);
-    if (name_len >= name_cap) {
-        semantic_error_loc(decl_file, decl_line, decl_col,
-                           "اسم الرمز طويل جداً: '%s' (الحد الأقصى %zu حرفاً).",
-                           name, name_cap - 1);
-        return;
-    }
+    Symbol* sym = NULL;
+    AnalysisNameIndex* table_index = NULL;
+    int entry = 0;
 
     if (scope == SCOPE_GLOBAL) {
         Symbol* existing = global_lookup_by_name(name);
@@ -127,80 +122,19 @@ static void add_symbol(const char* name,
             }
             return;
         }
-        if (global_count >= ANALYSIS_MAX_SYMBOLS) {
-            semantic_error_loc(decl_file, decl_line, decl_col, "عدد المتغيرات العامة كبير جداً.");
-            return;
-        }
-        
-        memcpy(global_symbols[global_count].name, name, name_len + 1);
-        global_symbols[global_count].scope = SCOPE_GLOBAL;
-        global_symbols[global_count].type = type;
-        global_symbols[global_count].type_name[0] = '\0';
-        global_symbols[global_count].ptr_base_type = ptr_base_type;
-        global_symbols[global_count].ptr_base_type_name[0] = '\0';
-        global_symbols[global_count].ptr_depth = ptr_depth;
-        global_symbols[global_count].func_sig = NULL;
-        if (type_name && type_name[0]) {
-            size_t tn_len = strlen(type_name);
-            size_t tn_cap = sizeof(global_symbols[global_count].type_name);
-            if (tn_len < tn_cap) {
-                memcpy(global_symbols[global_count].type_name, type_name, tn_len + 1);
-            }
-        }
-        if (ptr_base_type_name && ptr_base_type_name[0]) {
-            size_t pn_len = strlen(ptr_base_type_name);
-            size_t pn_cap = sizeof(global_symbols[global_count].ptr_base_type_name);
-            if (pn_len < pn_cap) {
-                memcpy(global_symbols[global_count].ptr_base_type_name, ptr_base_type_name, pn_len + 1);
-            }
-        }
-        if (type == TYPE_FUNC_PTR) {
-            global_symbols[global_count].func_sig = funcsig_clone(func_sig);
-            if (!global_symbols[global_count].func_sig) {
-                semantic_error_loc(decl_file, decl_line, decl_col,
-                                   "نفدت الذاكرة أثناء نسخ توقيع مؤشر الدالة للرمز '%s'.", name);
-                return;
-            }
-        }
-        global_symbols[global_count].is_array = is_array;
-        global_symbols[global_count].array_rank = 0;
-        global_symbols[global_count].array_total_elems = 0;
-        global_symbols[global_count].array_dims = NULL;
-        if (is_array && array_rank > 0 && array_dims) {
-            int* dims_copy = (int*)malloc((size_t)array_rank * sizeof(int));
-            if (!dims_copy) {
-                semantic_error_loc(decl_file, decl_line, decl_col,
-                                   "نفدت الذاكرة أثناء نسخ أبعاد المصفوفة.");
-                return;
-            }
-            for (int i = 0; i < array_rank; i++) dims_copy[i] = array_dims[i];
-            global_symbols[global_count].array_dims = dims_copy;
-            global_symbols[global_count].array_rank = array_rank;
-            global_symbols[global_count].array_total_elems = array_total_elems;
-        }
-        global_symbols[global_count].is_const = is_const;
-        global_symbols[global_count].is_static = is_static;
-        global_symbols[global_count].is_extern = is_extern;
-        global_symbols[global_count].is_defined = !is_extern;
-        global_symbols[global_count].is_used = false;
-        global_symbols[global_count].decl_line = decl_line;
-        global_symbols[global_count].decl_col = decl_col;
-        global_symbols[global_count].decl_file = decl_file;
-        global_symbols[global_count].decl_node = decl_node;
-        symbol_hash_insert(global_symbols, global_symbol_hash_head, global_symbol_hash_next, global_count);
-        global_count++;
+        sym = (Symbol*)analysis_table_slot(&g_analysis->arena, &g_analysis->global_symbols,
+                                           &g_analysis->global_cap, &g_analysis->global_records,
+                                           g_analysis->global_count, sizeof(Symbol));
+        table_index = &g_analysis->global_index;
+        entry = g_analysis->global_count;
     } else {
         // التحقق من التكرار داخل النطاق الحالي فقط
         int start = current_scope_start();
-        if (local_lookup_in_scope(name, start, local_count) >= 0) {
+        if (local_lookup_in_scope(name, start, g_analysis->local_count) >= 0) {
             semantic_error_loc(decl_file, decl_line, decl_col,
                                "إعادة تعريف المتغير المحلي '%s'.", name);
             return;
         }
-        if (local_count >= ANALYSIS_MAX_SYMBOLS) {
-            semantic_error_loc(decl_file, decl_line, decl_col, "عدد المتغيرات المحلية كبير جداً.");
-            return;
-        }
 
         // تحذير إذا كان المتغير المحلي يحجب متغيراً عاماً
         if (global_lookup_by_name(name)) {
@@ -214,63 +148,75 @@ static void add_symbol(const char* name,
                 "المتغير المحلي '%s' يحجب متغيراً محلياً من نطاق خارجي.", name);
         }
 
-        memcpy(local_symbols[local_count].name, name, name_len + 1);
-        local_symbols[local_count].scope = SCOPE_LOCAL;
-        local_symbols[local_count].type = type;
-        local_symbols[local_count].type_name[0] = '\0';
-        local_symbols[local_count].ptr_base_type = ptr_base_type;
-        local_symbols[local_count].ptr_base_type_name[0] = '\0';
-        local_symbols[local_count].ptr_depth = ptr_depth;
-        local_symbols[local_count].func_sig = NULL;
-        if (type_name && type_name[0]) {
-            size_t tn_len = strlen(type_name);
-            size_t tn_cap = sizeof(local_symbols[local_count].type_name);
-            if (tn_len < tn_cap) {
-                memcpy(local_symbols[local_count].type_name, type_name, tn_len + 1);
-            }
-        }
-        if (ptr_base_type_name && ptr_base_type_name[0]) {
-            size_t pn_len = strlen(ptr_base_type_name);
-            size_t pn_cap = sizeof(local_symbols[local_count].ptr_base_type_name);
-            if (pn_len < pn_cap) {
-                memcpy(local_symbols[local_count].ptr_base_type_name, ptr_base_type_name, pn_len + 1);
-            }
-        }
-        if (type == TYPE_FUNC_PTR) {
-            local_symbols[local_count].func_sig = funcsig_clone(func_sig);
-            if (!local_symbols[local_count].func_sig) {
-                semantic_error_loc(decl_file, decl_line, decl_col,
-                                   "نفدت الذاكرة أثناء نسخ توقيع مؤشر الدالة للرمز '%s'.", name);
-                return;
-            }
+        sym = (Symbol*)analysis_table_slot(&g_analysis->arena, &g_analysis->local_symbols,
+                                           &g_analysis->local_cap, &g_analysis->local_records,
+                                           g_analysis->local_count, sizeof(Symbol));
+        table_index = &g_analysis->local_index;
+        entry = g_analysis->local_count;
+        is_extern = false;
+    }
+
+    if (sym) {
+        sym->name = analysis_arena_strdup(&g_analysis->arena, name);
+        sym->type_name = analysis_arena_strdup(&g_analysis->arena, type_name);
+        sym->ptr_base_type_name = analysis_arena_strdup(&g_analysis->arena, ptr_base_type_name);
+    }
+    if (!sym || !sym->name || !sym->type_name || !sym->ptr_base_type_name) {
+        semantic_error_loc(decl_file, decl_line, decl_col,
+                           "نفدت الذاكرة أثناء تسجيل الرمز '%s'.", name);
+        return;
+    }
+
+    sym->scope = scope;
+    sym->type = type;
+    sym->ptr_base_type = ptr_base_type;
+    sym->ptr_depth = ptr_depth;
+    sym->func_sig = NULL;
+    if (type == TYPE_FUNC_PTR) {
+        sym->func_sig = funcsig_clone(func_sig);
+        if (!sym->func_sig) {
+            semantic_error_loc(decl_file, decl_line, decl_col,
+                               "نفدت الذاكرة أثناء نسخ توقيع مؤشر الدالة للرمز '%s'.", name);
+            return;
         }
-        local_symbols[local_count].is_array = is_array;
-        local_symbols[local_count].array_rank = 0;
-        local_symbols[local_count].array_total_elems = 0;
-        local_symbols[local_count].array_dims = NULL;
-        if (is_array && array_rank > 0 && array_dims) {
-            int* dims_copy = (int*)malloc((size_t)array_rank * sizeof(int));
-            if (!dims_copy) {
-                semantic_error_loc(decl_file, decl_line, decl_col,
-                                   "نفدت الذاكرة أثناء نسخ أبعاد المصفوفة.");
-                return;
-            }
-            for (int i = 0; i < array_rank; i++) dims_copy[i] = array_dims[i];
-            local_symbols[local_count].array_dims = dims_copy;
-            local_symbols[local_count].array_rank = array_rank;
-            local_symbols[local_count].array_total_elems = array_total_elems;
+    }
+    sym->is_array = is_array;
+    sym->array_rank = 0;
+    sym->array_total_elems = 0;
+    sym->array_dims = NULL;
+    if (is_array && array_rank > 0 && array_dims) {
+        int* dims_copy = (int*)malloc((size_t)array_rank * sizeof(int));
+        if (!dims_copy) {
+            semantic_error_loc(decl_file, decl_line, decl_col,
+                               "نفدت الذاكرة أثناء نسخ أبعاد المصفوفة.");
+            symbol_release_array_dims(sym);
+            return;
         }
-        local_symbols[local_count].is_const = is_const;
-        local_symbols[local_count].is_static = is_static;
-        local_symbols[local_count].is_extern = false;
-        local_symbols[local_count].is_defined = true;
-        local_symbols[local_count].is_used = false;
-        local_symbols[local_count].decl_line = decl_line;
-        local_symbols[local_count].decl_col = decl_col;
-        local_symbols[local_count].decl_file = decl_file;
-        local_symbols[local_count].decl_node = decl_node;
-        symbol_hash_insert(local_symbols, local_symbol_hash_head, local_symbol_hash_next, local_count);
-        local_count++;
+        for (int i = 0; i < array_rank; i++) dims_copy[i] = array_dims[i];
+        sym->array_dims = dims_copy;
+        sym->array_rank = array_rank;
+        sym->array_total_elems = array_total_elems;
+    }
+    sym->is_const = is_const;
+    sym->is_static = is_static;
+    sym->is_extern = is_extern;
+    sym->is_defined = !is_extern;
+    sym->is_used = false;
+    sym->decl_line = decl_line;
+    sym->decl_col = decl_col;
+    sym->decl_file = decl_file;
+    sym->decl_node = decl_node;
+
+    if (!analysis_name_index_insert(table_index, entry, symbol_hash_name(name))) {
+        semantic_error_loc(decl_file, decl_line, decl_col,
+                           "نفدت الذاكرة أثناء فهرسة الرمز '%s'.", name);
+        symbol_release_array_dims(sym);
+        return;
+    }
+    if (scope == SCOPE_GLOBAL) {
+        g_analysis->global_count++;
+    } else {
+        g_analysis->local_count++;
     }
 }
 
@@ -298,22 +244,24 @@ static void bind_function_use(Node* node, const FuncSymbol* function)
 static DataType infer_type(Node* node);
 static bool types_compatible(DataType got, DataType expected);
 
+/**
+ * @brief نسخ نص إلى ساحة الشجرة ليعيش ما دامت العقد التي تشير إليه.
+ */
+static char* node_strdup(const char* s)
+{
+    return s ? ast_arena_strdup(g_analysis->ast_arena, s) : NULL;
+}
+
 static void node_set_inferred_ptr(Node* node, DataType base_type, const char* base_type_name, int depth)
 {
     if (!node) return;
     // لا يمكن أن يكون التعبير "مؤشر" و"مؤشر دالة" في نفس الوقت.
-    if (node->inferred_func_sig) {
-        // ملاحظة: inferred_func_sig مملوك للعقدة (نسخة) ويجب تحريره عند استبداله.
-        funcsig_free(node->inferred_func_sig);
-        node->inferred_func_sig = NULL;
-    }
+    // القيم السابقة تبقى في ساحة الشجرة وتُحرَّر معها دفعة واحدة.
+    node->inferred_func_sig = NULL;
     node->inferred_ptr_base_type = base_type;
-    if (node->inferred_ptr_base_type_name) {
-        free(node->inferred_ptr_base_type_name);
-        node->inferred_ptr_base_type_name = NULL;
-    }
+    node->inferred_ptr_base_type_name = NULL;
     if (base_type_name && base_type_name[0]) {
-        node->inferred_ptr_base_type_name = strdup(base_type_name);
+        node->inferred_ptr_base_type_name = node_strdup(base_type_name);
     }
     node->inferred_ptr_depth = depth;
 }
@@ -330,8 +278,8 @@ static void node_set_inferred_funcptr(Node* node, FuncPtrSig* sig)
     // تفريغ معلومات المؤشر العادي حتى لا تختلط الدلالات.
     node_set_inferred_ptr(node, TYPE_INT, NULL, 0);
     // مهم: لا نخزن مؤشراً مستعاراً هنا لأن تواقيع رموز النطاقات المحلية تُحرَّر عند scope_pop().
-    // لذلك نحتفظ بنسخة مملوكة للعقدة حتى تبقى صالحة أثناء خفض الـ IR.
-    node->inferred_func_sig = funcsig_clone(sig);
+    // لذلك نحتفظ بنسخة في ساحة الشجرة حتى تبقى صالحة أثناء خفض الـ IR.
+    node->inferred_func_sig = ast_arena_funcsig_clone(g_analysis->ast_arena, sig);
     if (sig && !node->inferred_func_sig) {
         semantic_error(node, "نفدت الذاكرة أثناء نسخ توقيع مؤشر الدالة داخل AST.");
     }
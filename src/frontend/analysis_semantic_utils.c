@@ -622,7 +622,7 @@ static void maybe_warn_implicit_narrowing(DataType src_type, DataType dst_type,
     if (!implicit_conversion_may_lose_data(src_type, dst_type, expr)) return;
 
     warning_report(WARN_IMPLICIT_NARROWING,
-                   expr->filename ? expr->filename : current_filename,
+                   expr->filename ? expr->filename : g_analysis->current_filename,
                    (expr->line > 0) ? expr->line : 1,
                    (expr->col > 0) ? expr->col : 1,
                    "تحويل ضمني قد يسبب فقدان بيانات من %s إلى %s.",
@@ -636,7 +636,7 @@ static void maybe_warn_signed_unsigned_compare(DataType left_type, DataType righ
     if (!datatype_signed_unsigned_compare_after_promotion(left_type, right_type)) return;
 
     warning_report(WARN_SIGNED_UNSIGNED_COMPARE,
-                   expr->filename ? expr->filename : current_filename,
+                   expr->filename ? expr->filename : g_analysis->current_filename,
                    (expr->line > 0) ? expr->line : 1,
                    (expr->col > 0) ? expr->col : 1,
                    "مقارنة بين نوع موقّع وغير موقّع قد تعطي نتائج غير متوقعة.");
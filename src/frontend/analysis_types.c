@@ -4,29 +4,23 @@
 
 static EnumDef* enum_lookup_def(const char* name)
 {
-    if (!name) return NULL;
-    for (int i = 0; i < enum_count; i++) {
-        if (enum_defs[i].name && strcmp(enum_defs[i].name, name) == 0) return &enum_defs[i];
-    }
-    return NULL;
+    int i = analysis_name_index_find(&g_analysis->enum_index, (void* const*)g_analysis->enum_defs,
+                                     name, symbol_hash_name(name));
+    return i >= 0 ? g_analysis->enum_defs[i] : NULL;
 }
 
 static StructDef* struct_lookup_def(const char* name)
 {
-    if (!name) return NULL;
-    for (int i = 0; i < struct_count; i++) {
-        if (struct_defs[i].name && strcmp(struct_defs[i].name, name) == 0) return &struct_defs[i];
-    }
-    return NULL;
+    int i = analysis_name_index_find(&g_analysis->struct_index, (void* const*)g_analysis->struct_defs,
+                                     name, symbol_hash_name(name));
+    return i >= 0 ? g_analysis->struct_defs[i] : NULL;
 }
 
 static UnionDef* union_lookup_def(const char* name)
 {
-    if (!name) return NULL;
-    for (int i = 0; i < union_count; i++) {
-        if (union_defs[i].name && strcmp(union_defs[i].name, name) == 0) return &union_defs[i];
-    }
-    return NULL;
+    int i = analysis_name_index_find(&g_analysis->union_index, (void* const*)g_analysis->union_defs,
+                                     name, symbol_hash_name(name));
+    return i >= 0 ? g_analysis->union_defs[i] : NULL;
 }
 
 static int align_up_i32(int v, int a)
@@ -66,7 +60,7 @@ static int struct_compute_layout(StructDef* sd)
     if (!sd) return 0;
     if (sd->layout_done) return 1;
     if (sd->layout_in_progress) {
-        semantic_error_loc(current_filename, 1, 1,
+        semantic_error_loc(g_analysis->current_filename, 1, 1,
                            "تعريف هيكل تراجعي/دائري غير مدعوم حالياً (cycle) في '%s'.",
                            sd->name ? sd->name : "???");
         return 0;
@@ -106,7 +100,7 @@ static int union_compute_layout(UnionDef* ud)
     if (!ud) return 0;
     if (ud->layout_done) return 1;
     if (ud->layout_in_progress) {
-        semantic_error_loc(current_filename, 1, 1,
+        semantic_error_loc(g_analysis->current_filename, 1, 1,
                            "تعريف اتحاد تراجعي/دائري غير مدعوم حالياً (cycle) في '%s'.",
                            ud->name ? ud->name : "???");
         return 0;
@@ -159,7 +153,7 @@ static int type_size_align(DataType t, const char* type_name, int* out_align)
         case TYPE_STRUCT: {
             StructDef* sd = struct_lookup_def(type_name);
             if (!sd) {
-                semantic_error_loc(current_filename, 1, 1,
+                semantic_error_loc(g_analysis->current_filename, 1, 1,
                                    "هيكل غير معرّف '%s'.", type_name ? type_name : "???");
                 return 0;
             }
@@ -170,7 +164,7 @@ static int type_size_align(DataType t, const char* type_name, int* out_align)
         case TYPE_UNION: {
             UnionDef* ud = union_lookup_def(type_name);
             if (!ud) {
-                semantic_error_loc(current_filename, 1, 1,
+                semantic_error_loc(g_analysis->current_filename, 1, 1,
                                    "اتحاد غير معرّف '%s'.", type_name ? type_name : "???");
                 return 0;
             }
@@ -221,7 +215,7 @@ static void resolve_member_access(Node* node)
                     base->resolved_decl = ed->decl_node;
                     node->resolved_decl = ed->members[i].decl_node;
                     node->data.member_access.is_enum_value = true;
-                    node->data.member_access.enum_name = strdup(base_name);
+                    node->data.member_access.enum_name = node_strdup(base_name);
                     node->data.member_access.enum_value = ed->members[i].value;
                     return;
                 }
@@ -356,14 +350,14 @@ static void resolve_member_access(Node* node)
     }
 
     node->data.member_access.is_struct_member = true;
-    node->data.member_access.root_var = root_var ? strdup(root_var) : NULL;
+    node->data.member_access.root_var = node_strdup(root_var);
     node->data.member_access.root_is_global = root_is_global;
-    node->data.member_access.root_struct = strdup(cur_struct);
+    node->data.member_access.root_struct = node_strdup(cur_struct);
     node->data.member_access.member_offset = base_off + f->offset;
     node->data.member_access.member_type = f->type;
-    node->data.member_access.member_type_name = f->type_name ? strdup(f->type_name) : NULL;
+    node->data.member_access.member_type_name = node_strdup(f->type_name);
     node->data.member_access.member_ptr_base_type = f->ptr_base_type;
-    node->data.member_access.member_ptr_base_type_name = f->ptr_base_type_name ? strdup(f->ptr_base_type_name) : NULL;
+    node->data.member_access.member_ptr_base_type_name = node_strdup(f->ptr_base_type_name);
     node->data.member_access.member_ptr_depth = f->ptr_depth;
     node->data.member_access.member_is_const = base_const || f->is_const;
     node->resolved_decl = f->decl_node;
@@ -384,13 +378,15 @@ static void enum_register_decl(Node* node)
         return;
     }
 
-    if (enum_count >= ANALYSIS_MAX_ENUMS) {
-        semantic_error(node, "عدد التعدادات كبير جداً (الحد %d).", ANALYSIS_MAX_ENUMS);
+    EnumDef* ed = (EnumDef*)analysis_table_slot(&g_analysis->arena, &g_analysis->enum_defs,
+                                                 &g_analysis->enum_cap, &g_analysis->enum_records,
+                                                 g_analysis->enum_count, sizeof(EnumDef));
+    if (!ed || !analysis_name_index_insert(&g_analysis->enum_index, g_analysis->enum_count,
+                                           symbol_hash_name(name))) {
+        semantic_error(node, "نفدت الذاكرة أثناء تسجيل التعداد '%s'.", name);
         return;
     }
-
-    EnumDef* ed = &enum_defs[enum_count++];
-    memset(ed, 0, sizeof(*ed));
+    g_analysis->enum_count++;
     ed->name = strdup(name);
     ed->decl_node = node;
 
@@ -407,8 +403,8 @@ static void enum_register_decl(Node* node)
             }
         }
 
-        if (ed->member_count >= ANALYSIS_MAX_ENUM_MEMBERS) {
-            semantic_error(m, "عدد عناصر التعداد كبير جداً (الحد %d).", ANALYSIS_MAX_ENUM_MEMBERS);
+        if (!analysis_grow_array(&ed->members, &ed->member_cap, ed->member_count + 1, sizeof(EnumMemberDef))) {
+            semantic_error(m, "نفدت الذاكرة أثناء تسجيل عناصر التعداد '%s'.", name);
             return;
         }
 
@@ -442,13 +438,15 @@ static void struct_register_decl(Node* node)
         return;
     }
 
-    if (struct_count >= ANALYSIS_MAX_STRUCTS) {
-        semantic_error(node, "عدد الهياكل كبير جداً (الحد %d).", ANALYSIS_MAX_STRUCTS);
+    StructDef* sd = (StructDef*)analysis_table_slot(&g_analysis->arena, &g_analysis->struct_defs,
+                                          &g_analysis->struct_cap, &g_analysis->struct_records,
+                                          g_analysis->struct_count, sizeof(StructDef));
+    if (!sd || !analysis_name_index_insert(&g_analysis->struct_index, g_analysis->struct_count,
+                                           symbol_hash_name(name))) {
+        semantic_error(node, "نفدت الذاكرة أثناء تسجيل الهيكل '%s'.", name);
         return;
     }
-
-    StructDef* sd = &struct_defs[struct_count++];
-    memset(sd, 0, sizeof(*sd));
+    g_analysis->struct_count++;
     sd->name = strdup(name);
     sd->decl_node = node;
     sd->layout_done = false;
@@ -458,8 +456,8 @@ static void struct_register_decl(Node* node)
         if (f->type != NODE_VAR_DECL) continue;
         if (!f->data.var_decl.name) continue;
 
-        if (sd->field_count >= ANALYSIS_MAX_STRUCT_FIELDS) {
-            semantic_error(f, "عدد حقول الهيكل '%s' كبير جداً (الحد %d).", name, ANALYSIS_MAX_STRUCT_FIELDS);
+        if (!analysis_grow_array(&sd->fields, &sd->field_cap, sd->field_count + 1, sizeof(StructFieldDef))) {
+            semantic_error(f, "نفدت الذاكرة أثناء تسجيل حقول الهيكل '%s'.", name);
             return;
         }
 
@@ -503,13 +501,15 @@ static void union_register_decl(Node* node)
         return;
     }
 
-    if (union_count >= ANALYSIS_MAX_STRUCTS) {
-        semantic_error(node, "عدد الاتحادات كبير جداً (الحد %d).", ANALYSIS_MAX_STRUCTS);
+    UnionDef* ud = (UnionDef*)analysis_table_slot(&g_analysis->arena, &g_analysis->union_defs,
+                                          &g_analysis->union_cap, &g_analysis->union_records,
+                                          g_analysis->union_count, sizeof(UnionDef));
+    if (!ud || !analysis_name_index_insert(&g_analysis->union_index, g_analysis->union_count,
+                                           symbol_hash_name(name))) {
+        semantic_error(node, "نفدت الذاكرة أثناء تسجيل الاتحاد '%s'.", name);
         return;
     }
-
-    UnionDef* ud = &union_defs[union_count++];
-    memset(ud, 0, sizeof(*ud));
+    g_analysis->union_count++;
     ud->name = strdup(name);
     ud->decl_node = node;
     ud->layout_done = false;
@@ -519,8 +519,8 @@ static void union_register_decl(Node* node)
         if (f->type != NODE_VAR_DECL) continue;
         if (!f->data.var_decl.name) continue;
 
-        if (ud->field_count >= ANALYSIS_MAX_STRUCT_FIELDS) {
-            semantic_error(f, "عدد حقول الاتحاد '%s' كبير جداً (الحد %d).", name, ANALYSIS_MAX_STRUCT_FIELDS);
+        if (!analysis_grow_array(&ud->fields, &ud->field_cap, ud->field_count + 1, sizeof(StructFieldDef))) {
+            semantic_error(f, "نفدت الذاكرة أثناء تسجيل حقول الاتحاد '%s'.", name);
             return;
         }
 
@@ -623,18 +623,18 @@ static void type_alias_register_decl(Node* node)
         }
     }
 
-    if (type_alias_count >= ANALYSIS_MAX_TYPE_ALIASES) {
-        semantic_error(node, "عدد أسماء الأنواع البديلة كبير جداً (الحد %d).",
-                       ANALYSIS_MAX_TYPE_ALIASES);
+    // يُحجز السجل عند type_alias_count ولا يُحتسب إلا بعد نجاح كل النسخ.
+    TypeAliasDef* out = (TypeAliasDef*)analysis_table_slot(&g_analysis->arena, &g_analysis->type_alias_defs,
+                                                           &g_analysis->type_alias_cap,
+                                                           &g_analysis->type_alias_records,
+                                                           g_analysis->type_alias_count, sizeof(TypeAliasDef));
+    if (!out) {
+        semantic_error(node, "نفدت الذاكرة أثناء تسجيل الاسم البديل '%s'.", name);
         return;
     }
-
-    TypeAliasDef* out = &type_alias_defs[type_alias_count++];
-    memset(out, 0, sizeof(*out));
     out->name = strdup(name);
     out->decl_node = node;
     if (!out->name) {
-        type_alias_count--;
         semantic_error(node, "نفدت الذاكرة أثناء تسجيل الاسم البديل '%s'.", name);
         return;
     }
@@ -647,7 +647,6 @@ static void type_alias_register_decl(Node* node)
         if (!out->target_type_name) {
             free(out->name);
             out->name = NULL;
-            type_alias_count--;
             semantic_error(node, "نفدت الذاكرة أثناء تسجيل هدف الاسم البديل '%s'.", name);
             return;
         }
@@ -659,7 +658,6 @@ static void type_alias_register_decl(Node* node)
             out->target_type_name = NULL;
             free(out->name);
             out->name = NULL;
-            type_alias_count--;
             semantic_error(node, "نفدت الذاكرة أثناء تسجيل أساس مؤشر الاسم البديل '%s'.", name);
             return;
         }
@@ -673,11 +671,25 @@ static void type_alias_register_decl(Node* node)
             out->target_type_name = NULL;
             free(out->name);
             out->name = NULL;
-            type_alias_count--;
             semantic_error(node, "نفدت الذاكرة أثناء نسخ توقيع مؤشر الدالة في الاسم البديل '%s'.", name);
             return;
         }
     }
+
+    if (!analysis_name_index_insert(&g_analysis->type_alias_index, g_analysis->type_alias_count,
+                                    symbol_hash_name(name))) {
+        funcsig_free(out->target_func_sig);
+        out->target_func_sig = NULL;
+        free(out->target_ptr_base_type_name);
+        out->target_ptr_base_type_name = NULL;
+        free(out->target_type_name);
+        out->target_type_name = NULL;
+        free(out->name);
+        out->name = NULL;
+        semantic_error(node, "نفدت الذاكرة أثناء فهرسة الاسم البديل '%s'.", name);
+        return;
+    }
+    g_analysis->type_alias_count++;
 }
 
 /**
@@ -686,16 +698,16 @@ static void type_alias_register_decl(Node* node)
 static void check_unused_local_variables_range(int start, int end) {
     if (start < 0) start = 0;
     if (end < start) end = start;
-    if (end > local_count) end = local_count;
+    if (end > g_analysis->local_count) end = g_analysis->local_count;
 
     for (int i = start; i < end; i++) {
-        if (!local_symbols[i].is_used) {
+        if (!g_analysis->local_symbols[i]->is_used) {
             warning_report(WARN_UNUSED_VARIABLE,
-                local_symbols[i].decl_file,
-                local_symbols[i].decl_line,
-                local_symbols[i].decl_col,
+                g_analysis->local_symbols[i]->decl_file,
+                g_analysis->local_symbols[i]->decl_line,
+                g_analysis->local_symbols[i]->decl_col,
                 "Variable '%s' is declared but never used.",
-                local_symbols[i].name);
+                g_analysis->local_symbols[i]->name);
         }
     }
 }
@@ -706,14 +718,14 @@ static void check_unused_local_variables_range(int start, int end) {
  * @brief التحقق من المتغيرات العامة غير المستخدمة.
  */
 static void check_unused_global_variables(void) {
-    for (int i = 0; i < global_count; i++) {
-        if (!global_symbols[i].is_used && !global_symbols[i].is_extern) {
+    for (int i = 0; i < g_analysis->global_count; i++) {
+        if (!g_analysis->global_symbols[i]->is_used && !g_analysis->global_symbols[i]->is_extern) {
             warning_report(WARN_UNUSED_VARIABLE,
-                global_symbols[i].decl_file,
-                global_symbols[i].decl_line,
-                global_symbols[i].decl_col,
+                g_analysis->global_symbols[i]->decl_file,
+                g_analysis->global_symbols[i]->decl_line,
+                g_analysis->global_symbols[i]->decl_col,
                 "Global variable '%s' is declared but never used.",
-                global_symbols[i].name);
+                g_analysis->global_symbols[i]->name);
         }
     }
 }
@@ -32,7 +32,7 @@ static void analyze_statements_with_dead_code_check(Node* statements, const char
     while (stmt) {
         if (found_terminator) {
             // كود ميت بعد return/break/continue
-            warning_report(WARN_DEAD_CODE, current_filename, terminator_line, 1,
+            warning_report(WARN_DEAD_CODE, g_analysis->current_filename, terminator_line, 1,
                 "Unreachable code after '%s' statement.", context);
             // نستمر في التحليل لاكتشاف أخطاء أخرى
             found_terminator = false; // تجنب تحذيرات متعددة
@@ -71,12 +71,12 @@ static void analyze_node(Node* node) {
             }
 
             // حساب تخطيط الذاكرة للهياكل/الاتحادات مبكراً لالتقاط الأخطاء بسرعة
-            for (int i = 0; i < struct_count; i++) {
-                (void)struct_compute_layout(&struct_defs[i]);
+            for (int i = 0; i < g_analysis->struct_count; i++) {
+                (void)struct_compute_layout(g_analysis->struct_defs[i]);
             }
 
-            for (int i = 0; i < union_count; i++) {
-                (void)union_compute_layout(&union_defs[i]);
+            for (int i = 0; i < g_analysis->union_count; i++) {
+                (void)union_compute_layout(g_analysis->union_defs[i]);
             }
 
             // 0.5) تسجيل أسماء الأنواع البديلة (نوع) بعد تعريفات الأنواع المركبة
@@ -274,7 +274,7 @@ static void analyze_node(Node* node) {
                        NULL,
                        0,
                        node->line, node->col,
-                       node->filename ? node->filename : current_filename,
+                       node->filename ? node->filename : g_analysis->current_filename,
                        node);
             break;
          }
@@ -285,28 +285,26 @@ static void analyze_node(Node* node) {
 
         case NODE_FUNC_DEF: {
             // الدخول في نطاق دالة جديدة (تصفير المحلي + إنشاء نطاق)
-            local_count = 0;
-            symbol_hash_reset_heads(local_symbol_hash_head, ANALYSIS_SYMBOL_HASH_BUCKETS);
-            symbol_hash_reset_next(local_symbol_hash_next, ANALYSIS_MAX_SYMBOLS);
-            scope_depth = 0;
+            local_symbols_truncate(0);
+            g_analysis->scope_depth = 0;
             scope_push();
 
-            bool prev_in_func = in_function;
-            DataType prev_ret = current_func_return_type;
-            DataType prev_ret_ptr_base = current_func_return_ptr_base_type;
-            const char* prev_ret_ptr_base_name = current_func_return_ptr_base_type_name;
-            int prev_ret_ptr_depth = current_func_return_ptr_depth;
-            FuncPtrSig* prev_ret_func_sig = current_func_return_func_sig;
-            bool prev_is_variadic = current_func_is_variadic;
-            const char* prev_variadic_anchor = current_func_variadic_anchor_name;
-            in_function = true;
-            current_func_return_type = node->data.func_def.return_type;
-            current_func_return_ptr_base_type = node->data.func_def.return_ptr_base_type;
-            current_func_return_ptr_base_type_name = node->data.func_def.return_ptr_base_type_name;
-            current_func_return_ptr_depth = node->data.func_def.return_ptr_depth;
-            current_func_return_func_sig = node->data.func_def.return_func_sig;
-            current_func_is_variadic = node->data.func_def.is_variadic;
-            current_func_variadic_anchor_name = NULL;
+            bool prev_in_func = g_analysis->in_function;
+            DataType prev_ret = g_analysis->current_func_return_type;
+            DataType prev_ret_ptr_base = g_analysis->current_func_return_ptr_base_type;
+            const char* prev_ret_ptr_base_name = g_analysis->current_func_return_ptr_base_type_name;
+            int prev_ret_ptr_depth = g_analysis->current_func_return_ptr_depth;
+            FuncPtrSig* prev_ret_func_sig = g_analysis->current_func_return_func_sig;
+            bool prev_is_variadic = g_analysis->current_func_is_variadic;
+            const char* prev_variadic_anchor = g_analysis->current_func_variadic_anchor_name;
+            g_analysis->in_function = true;
+            g_analysis->current_func_return_type = node->data.func_def.return_type;
+            g_analysis->current_func_return_ptr_base_type = node->data.func_def.return_ptr_base_type;
+            g_analysis->current_func_return_ptr_base_type_name = node->data.func_def.return_ptr_base_type_name;
+            g_analysis->current_func_return_ptr_depth = node->data.func_def.return_ptr_depth;
+            g_analysis->current_func_return_func_sig = node->data.func_def.return_func_sig;
+            g_analysis->current_func_is_variadic = node->data.func_def.is_variadic;
+            g_analysis->current_func_variadic_anchor_name = NULL;
 
             // إضافة المعاملات كمتغيرات محلية (المعاملات ليست ثوابت افتراضياً)
             Node* param = node->data.func_def.params;
@@ -332,18 +330,18 @@ static void analyze_node(Node* node) {
                                 false,
                                 false, 0, NULL, 0,
                                 param->line, param->col,
-                                param->filename ? param->filename : current_filename,
+                                param->filename ? param->filename : g_analysis->current_filename,
                                 param);
                      // تعليم المعامل كمستخدم مباشرة
-                     if (local_count > 0) {
-                         local_symbols[local_count - 1].is_used = true;
+                     if (g_analysis->local_count > 0) {
+                         g_analysis->local_symbols[g_analysis->local_count - 1]->is_used = true;
                      }
-                     current_func_variadic_anchor_name = param->data.var_decl.name;
+                     g_analysis->current_func_variadic_anchor_name = param->data.var_decl.name;
                  }
                 param = param->next;
             }
 
-            if (current_func_is_variadic && !current_func_variadic_anchor_name) {
+            if (g_analysis->current_func_is_variadic && !g_analysis->current_func_variadic_anchor_name) {
                 semantic_error(node, "الدالة المتغيرة المعاملات تتطلب معاملاً ثابتاً واحداً على الأقل قبل '...'.");
             }
 
@@ -355,14 +353,14 @@ static void analyze_node(Node* node) {
             // خروج نطاق الدالة (يشمل تحذيرات غير المستخدم)
             scope_pop();
 
-            in_function = prev_in_func;
-            current_func_return_type = prev_ret;
-            current_func_return_ptr_base_type = prev_ret_ptr_base;
-            current_func_return_ptr_base_type_name = prev_ret_ptr_base_name;
-            current_func_return_ptr_depth = prev_ret_ptr_depth;
-            current_func_return_func_sig = prev_ret_func_sig;
-            current_func_is_variadic = prev_is_variadic;
-            current_func_variadic_anchor_name = prev_variadic_anchor;
+            g_analysis->in_function = prev_in_func;
+            g_analysis->current_func_return_type = prev_ret;
+            g_analysis->current_func_return_ptr_base_type = prev_ret_ptr_base;
+            g_analysis->current_func_return_ptr_base_type_name = prev_ret_ptr_base_name;
+            g_analysis->current_func_return_ptr_depth = prev_ret_ptr_depth;
+            g_analysis->current_func_return_func_sig = prev_ret_func_sig;
+            g_analysis->current_func_is_variadic = prev_is_variadic;
+            g_analysis->current_func_variadic_anchor_name = prev_variadic_anchor;
             break;
         }
 
@@ -558,14 +556,14 @@ static void analyze_node(Node* node) {
             if (!datatype_is_intlike(condType)) {
                 semantic_error(node->data.while_stmt.condition, "شرط 'طالما' يجب أن يكون عدداً صحيحاً أو منطقياً.");
             }
-            bool prev_loop = inside_loop;
-            inside_loop = true;
+            bool prev_loop = g_analysis->inside_loop;
+            g_analysis->inside_loop = true;
 
             scope_push();
             analyze_node(node->data.while_stmt.body);
             scope_pop();
 
-            inside_loop = prev_loop;
+            g_analysis->inside_loop = prev_loop;
             break;
         }
 
@@ -582,10 +580,10 @@ static void analyze_node(Node* node) {
             }
             if (node->data.for_stmt.increment) analyze_node(node->data.for_stmt.increment);
 
-            bool prev_loop = inside_loop;
-            inside_loop = true;
+            bool prev_loop = g_analysis->inside_loop;
+            g_analysis->inside_loop = true;
             analyze_node(node->data.for_stmt.body);
-            inside_loop = prev_loop;
+            g_analysis->inside_loop = prev_loop;
 
             scope_pop();
             break;
@@ -596,8 +594,8 @@ static void analyze_node(Node* node) {
             if (!datatype_is_intlike(st)) {
                 semantic_error(node->data.switch_stmt.expression, "تعبير 'اختر' يجب أن يكون عدداً صحيحاً.");
             }
-            bool prev_switch = inside_switch;
-            inside_switch = true;
+            bool prev_switch = g_analysis->inside_switch;
+            g_analysis->inside_switch = true;
 
             // نطاق switch
             scope_push();
@@ -619,24 +617,24 @@ static void analyze_node(Node* node) {
 
             scope_pop();
             
-            inside_switch = prev_switch;
+            g_analysis->inside_switch = prev_switch;
             break;
         }
 
         case NODE_BREAK:
-            if (!inside_loop && !inside_switch) {
+            if (!g_analysis->inside_loop && !g_analysis->inside_switch) {
                 semantic_error(node, "تم استخدام 'توقف' خارج حلقة أو 'اختر'.");
             }
             break;
 
         case NODE_CONTINUE:
-            if (!inside_loop) {
+            if (!g_analysis->inside_loop) {
                 semantic_error(node, "تم استخدام 'استمر' خارج حلقة.");
             }
             break;
 
         case NODE_RETURN:
-            if (!in_function) {
+            if (!g_analysis->in_function) {
                 semantic_error(node, "جملة 'إرجع' خارج دالة.");
                 if (node->data.return_stmt.expression) {
                     (void)infer_type(node->data.return_stmt.expression);
@@ -644,7 +642,7 @@ static void analyze_node(Node* node) {
                 break;
             }
 
-            if (current_func_return_type == TYPE_VOID) {
+            if (g_analysis->current_func_return_type == TYPE_VOID) {
                 if (node->data.return_stmt.expression) {
                     (void)infer_type(node->data.return_stmt.expression);
                     semantic_error(node, "الدالة من نوع 'عدم' لا تعيد قيمة.");
@@ -658,19 +656,19 @@ static void analyze_node(Node* node) {
             }
 
             {
-                DataType rt = infer_type_allow_null_string(node->data.return_stmt.expression, current_func_return_type);
-                if (current_func_return_type == TYPE_POINTER) {
+                DataType rt = infer_type_allow_null_string(node->data.return_stmt.expression, g_analysis->current_func_return_type);
+                if (g_analysis->current_func_return_type == TYPE_POINTER) {
                     if (!ptr_type_compatible(node->data.return_stmt.expression->inferred_ptr_base_type,
                                              node->data.return_stmt.expression->inferred_ptr_base_type_name,
                                              node->data.return_stmt.expression->inferred_ptr_depth,
-                                             current_func_return_ptr_base_type,
-                                             current_func_return_ptr_base_type_name,
-                                             current_func_return_ptr_depth,
+                                             g_analysis->current_func_return_ptr_base_type,
+                                             g_analysis->current_func_return_ptr_base_type_name,
+                                             g_analysis->current_func_return_ptr_depth,
                                              true)) {
                         semantic_error(node, "نوع الإرجاع غير متوافق مع نوع الدالة.");
                     }
-                } else if (current_func_return_type == TYPE_FUNC_PTR) {
-                    FuncPtrSig* expected_sig = current_func_return_func_sig;
+                } else if (g_analysis->current_func_return_type == TYPE_FUNC_PTR) {
+                    FuncPtrSig* expected_sig = g_analysis->current_func_return_func_sig;
                     if (!expected_sig) {
                         semantic_error(node, "توقيع مؤشر الدالة كنوع إرجاع للدالة مفقود.");
                     } else if (node->data.return_stmt.expression->type == NODE_NULL) {
@@ -680,10 +678,10 @@ static void analyze_node(Node* node) {
                                !funcsig_equal(node->data.return_stmt.expression->inferred_func_sig, expected_sig)) {
                         semantic_error(node, "نوع الإرجاع غير متوافق مع نوع الدالة (توقيع مؤشر دالة مختلف).");
                     }
-                } else if (!types_compatible(rt, current_func_return_type)) {
+                } else if (!types_compatible(rt, g_analysis->current_func_return_type)) {
                     semantic_error(node, "نوع الإرجاع غير متوافق مع نوع الدالة.");
                 } else {
-                    maybe_warn_implicit_narrowing(rt, current_func_return_type, node->data.return_stmt.expression);
+                    maybe_warn_implicit_narrowing(rt, g_analysis->current_func_return_type, node->data.return_stmt.expression);
                 }
             }
             break;
@@ -855,7 +853,7 @@ static void analyze_node(Node* node) {
                        node->data.array_decl.total_elems,
                        node->line,
                        node->col,
-                       node->filename ? node->filename : current_filename,
+                       node->filename ? node->filename : g_analysis->current_filename,
                        node);
 
             // التحقق من قائمة التهيئة: تسمح بالتهيئة الجزئية كما في C.
@@ -974,22 +972,3 @@ static void analyze_node(Node* node) {
             break;
     }
 }
-
-/**
- * @brief نقطة الدخول الرئيسية للتحليل.
- * @param program عقدة البرنامج
- * @return true إذا لم تحدث أخطاء
- */
-bool analyze(Node* program) {
-    reset_analysis();
-    
-    // تعيين اسم الملف الحالي (للتحذيرات)
-    if (program && program->filename) {
-        current_filename = program->filename;
-    } else {
-        current_filename = "المصدر";
-    }
-    
-    analyze_node(program);
-    return !has_error;
-}
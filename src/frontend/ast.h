@@ -103,20 +103,21 @@ typedef enum {
  * @brief توقيع مؤشر الدالة: أنواع المعاملات ونوع الإرجاع (مع معلومات المؤشرات).
  *
  * ملاحظة: تُستخدم هذه البنية لتمثيل نوع `دالة(...) -> ...` داخل AST
- * وجدول الرموز والتحليل الدلالي.
+ * وجدول الرموز والتحليل الدلالي. التواقيع المعلّقة على عقد AST تُخصَّص مع
+ * مصفوفاتها ونصوصها من ساحة AST، أما نسخ جدول الرموز فمملوكة (malloc).
  */
 typedef struct FuncPtrSig {
     DataType return_type;
     DataType return_ptr_base_type;
-    char* return_ptr_base_type_name; // مملوك (قد يكون NULL)
+    char* return_ptr_base_type_name; // قد يكون NULL
     int return_ptr_depth;
 
     int param_count;
     bool is_variadic;                  // هل يقبل معاملات متغيرة ( ... )
-    DataType* param_types;              // مملوك (malloc)
-    DataType* param_ptr_base_types;     // مملوك (malloc)
-    char** param_ptr_base_type_names;   // مملوك (malloc) وعناصره مملوكة (strdup) وقد تكون NULL
-    int* param_ptr_depths;              // مملوك (malloc)
+    DataType* param_types;
+    DataType* param_ptr_base_types;
+    char** param_ptr_base_type_names;   // عناصرها قد تكون NULL
+    int* param_ptr_depths;
 } FuncPtrSig;
 
 /**
@@ -179,7 +180,7 @@ typedef struct Node {
 
     union {
         // البرنامج: قائمة الدوال والمتغيرات العامة
-        struct { struct Node* declarations; } program;
+        struct { struct Node* declarations; struct AstArena* arena; } program; // arena: مالكة الشجرة
         
         // الكتلة: قائمة من الجمل البرمجية
         struct { struct Node* statements; } block;
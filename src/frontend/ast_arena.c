@@ -0,0 +1,168 @@
+/**
+ * @file ast_arena.c
+ * @brief تنفيذ مُخصِّص ساحة (Arena) لعقد شجرة AST.
+ */
+
+#include "ast_arena.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AST_ARENA_MIN_CHUNK_SIZE (64u * 1024u)
+
+static size_t ast_align_up(size_t x, size_t align) {
+    if (align == 0) return x;
+    size_t m = align - 1;
+    return (x + m) & ~m;
+}
+
+void ast_arena_init(AstArena* arena, size_t default_chunk_size) {
+    if (!arena) return;
+    arena->head = NULL;
+    arena->default_chunk_size = default_chunk_size;
+    if (arena->default_chunk_size < AST_ARENA_MIN_CHUNK_SIZE) {
+        arena->default_chunk_size = AST_ARENA_MIN_CHUNK_SIZE;
+    }
+}
+
+void ast_arena_destroy(AstArena* arena) {
+    if (!arena) return;
+    AstArenaChunk* c = arena->head;
+    while (c) {
+        AstArenaChunk* next = c->next;
+        free(c);
+        c = next;
+    }
+    arena->head = NULL;
+}
+
+void ast_arena_get_stats(const AstArena* arena, AstArenaStats* out_stats) {
+    if (!out_stats) return;
+    out_stats->chunks = 0;
+    out_stats->used_bytes = 0;
+    out_stats->cap_bytes = 0;
+
+    if (!arena) return;
+    for (const AstArenaChunk* c = arena->head; c; c = c->next) {
+        out_stats->chunks++;
+        out_stats->used_bytes += c->used;
+        out_stats->cap_bytes += c->cap;
+    }
+}
+
+void* ast_arena_alloc(AstArena* arena, size_t size, size_t align) {
+    if (!arena) return NULL;
+    if (size == 0) size = 1;
+    if (align == 0 || (align & (align - 1)) != 0) align = sizeof(void*);
+
+    AstArenaChunk* c = arena->head;
+    if (c) {
+        size_t off = ast_align_up(c->used, align);
+        if (off + size <= c->cap) {
+            c->used = off + size;
+            return (void*)(c->data + off);
+        }
+    }
+
+    size_t need = ast_align_up(size, align);
+    if (need < size) return NULL;
+    size_t cap = need > arena->default_chunk_size ? need : arena->default_chunk_size;
+    AstArenaChunk* n = (AstArenaChunk*)malloc(sizeof(AstArenaChunk) + cap);
+    if (!n) return NULL;
+    n->used = 0;
+    n->cap = cap;
+    if (c && need > arena->default_chunk_size) {
+        // كتلة كبيرة منفردة خلف الرأس: لا نهدر المساحة المتبقية في الكتلة الحالية.
+        n->next = c->next;
+        c->next = n;
+    } else {
+        n->next = c;
+        arena->head = n;
+    }
+
+    n->used = size;
+    return (void*)n->data;
+}
+
+void* ast_arena_calloc(AstArena* arena, size_t count, size_t size, size_t align) {
+    if (!arena) return NULL;
+    if (count == 0 || size == 0) {
+        return ast_arena_alloc(arena, 1, align);
+    }
+    if (count > SIZE_MAX / size) return NULL;
+
+    size_t total = count * size;
+    void* p = ast_arena_alloc(arena, total, align);
+    if (!p) return NULL;
+    memset(p, 0, total);
+    return p;
+}
+
+void* ast_arena_realloc(AstArena* arena, void* old, size_t old_size, size_t new_size, size_t align) {
+    if (!arena) return NULL;
+    if (old && new_size <= old_size) return old;
+
+    // توسيع في المكان إذا كان old آخر تخصيص في الكتلة الحالية.
+    AstArenaChunk* c = arena->head;
+    if (old && c && (unsigned char*)old + old_size == c->data + c->used &&
+        new_size - old_size <= c->cap - c->used) {
+        c->used += new_size - old_size;
+        return old;
+    }
+
+    void* p = ast_arena_alloc(arena, new_size, align);
+    if (!p) return NULL;
+    if (old && old_size) memcpy(p, old, old_size);
+    return p;
+}
+
+char* ast_arena_strdup(AstArena* arena, const char* s) {
+    if (!arena || !s) return NULL;
+    size_t len = strlen(s);
+    char* out = (char*)ast_arena_alloc(arena, len + 1, 1);
+    if (!out) return NULL;
+    memcpy(out, s, len + 1);
+    return out;
+}
+
+FuncPtrSig* ast_arena_funcsig_clone(AstArena* arena, const FuncPtrSig* s) {
+    if (!arena || !s) return NULL;
+
+    FuncPtrSig* out = (FuncPtrSig*)ast_arena_calloc(arena, 1, sizeof(FuncPtrSig), _Alignof(FuncPtrSig));
+    if (!out) return NULL;
+
+    out->return_type = s->return_type;
+    out->return_ptr_base_type = s->return_ptr_base_type;
+    out->return_ptr_depth = s->return_ptr_depth;
+    out->is_variadic = s->is_variadic;
+    if (s->return_ptr_base_type_name) {
+        out->return_ptr_base_type_name = ast_arena_strdup(arena, s->return_ptr_base_type_name);
+        if (!out->return_ptr_base_type_name) return NULL;
+    }
+
+    out->param_count = s->param_count;
+    if (out->param_count > 0) {
+        size_t n = (size_t)out->param_count;
+        out->param_types = (DataType*)ast_arena_alloc(arena, n * sizeof(DataType), _Alignof(DataType));
+        out->param_ptr_base_types = (DataType*)ast_arena_alloc(arena, n * sizeof(DataType), _Alignof(DataType));
+        out->param_ptr_base_type_names = (char**)ast_arena_calloc(arena, n, sizeof(char*), _Alignof(char*));
+        out->param_ptr_depths = (int*)ast_arena_alloc(arena, n * sizeof(int), _Alignof(int));
+        if (!out->param_types || !out->param_ptr_base_types ||
+            !out->param_ptr_base_type_names || !out->param_ptr_depths) {
+            return NULL;
+        }
+
+        for (int i = 0; i < out->param_count; i++) {
+            out->param_types[i] = s->param_types ? s->param_types[i] : TYPE_INT;
+            out->param_ptr_base_types[i] = s->param_ptr_base_types ? s->param_ptr_base_types[i] : TYPE_INT;
+            out->param_ptr_depths[i] = s->param_ptr_depths ? s->param_ptr_depths[i] : 0;
+            if (s->param_ptr_base_type_names && s->param_ptr_base_type_names[i]) {
+                out->param_ptr_base_type_names[i] = ast_arena_strdup(arena, s->param_ptr_base_type_names[i]);
+                if (!out->param_ptr_base_type_names[i]) return NULL;
+            }
+        }
+    }
+
+    return out;
+}
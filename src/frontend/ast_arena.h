@@ -0,0 +1,53 @@
+/**
+ * @file ast_arena.h
+ * @brief مُخصِّص ساحة (Arena) لعقد شجرة AST ونصوصها.
+ *
+ * تُخصَّص كل العقد والنصوص والمصفوفات المملوكة لها من كتل كبيرة، وتُحرَّر
+ * دفعة واحدة عند تدمير الساحة بعد خفض الـ IR.
+ */
+
+#ifndef BAA_FRONTEND_AST_ARENA_H
+#define BAA_FRONTEND_AST_ARENA_H
+
+#include <stddef.h>
+
+#include "ast.h"
+
+// ============================================================================
+// ساحة تخصيص AST (AST Arena)
+// ============================================================================
+
+typedef struct AstArenaChunk {
+    struct AstArenaChunk* next;
+    size_t used;
+    size_t cap;
+    unsigned char data[];
+} AstArenaChunk;
+
+typedef struct AstArena {
+    AstArenaChunk* head;
+    size_t default_chunk_size;
+} AstArena;
+
+typedef struct AstArenaStats {
+    size_t chunks;
+    size_t used_bytes;
+    size_t cap_bytes;
+} AstArenaStats;
+
+void ast_arena_init(AstArena* arena, size_t default_chunk_size);
+void ast_arena_destroy(AstArena* arena);
+
+void* ast_arena_alloc(AstArena* arena, size_t size, size_t align);
+void* ast_arena_calloc(AstArena* arena, size_t count, size_t size, size_t align);
+void* ast_arena_realloc(AstArena* arena, void* old, size_t old_size, size_t new_size, size_t align);
+char* ast_arena_strdup(AstArena* arena, const char* s);
+
+/**
+ * @brief نسخ توقيع مؤشر دالة كاملاً (مع مصفوفاته ونصوصه) داخل الساحة.
+ */
+FuncPtrSig* ast_arena_funcsig_clone(AstArena* arena, const FuncPtrSig* s);
+
+void ast_arena_get_stats(const AstArena* arena, AstArenaStats* out_stats);
+
+#endif // BAA_FRONTEND_AST_ARENA_H
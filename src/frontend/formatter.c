@@ -480,12 +480,8 @@ static bool format_control_word(const FormatToken *token)
 static bool format_type_word(const FormatToken *token)
 {
     if (!token || token->kind != FORMAT_TOKEN_WORD) return false;
-    char small[64];
-    if (token->length >= sizeof(small)) return false;
-    memcpy(small, token->start, token->length);
-    small[token->length] = '\0';
     BaaTokenType type = TOKEN_INVALID;
-    if (!baa_language_keyword_token(small, &type)) return false;
+    if (!baa_language_keyword_token_n(token->start, token->length, &type)) return false;
     return type == TOKEN_KEYWORD_INT || type == TOKEN_KEYWORD_I8 ||
            type == TOKEN_KEYWORD_I16 || type == TOKEN_KEYWORD_I32 ||
            type == TOKEN_KEYWORD_I64 || type == TOKEN_KEYWORD_U8 ||
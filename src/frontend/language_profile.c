@@ -5,6 +5,7 @@
 
 #include "language_profile.h"
 
+#include <stdint.h>
 #include <string.h>
 
 static const BaaLanguageKeyword g_keywords[] = {
@@ -72,26 +73,63 @@ static const BaaLanguageCompletionEntry g_snippets[] = {
     {"ثابت (قيمة)", "snippet", "قالب تعريف قيمة ثابتة", "ثابت", "ثابت صحيح ${1:الاسم} = ${0:القيمة}.", true},
 };
 
+_Static_assert(sizeof(g_directives) / sizeof(g_directives[0]) == BAA_DIRECTIVE_COUNT,
+               "BaaLanguageDirective must follow the order of g_directives");
+
+#include "language_keyword_hash.inc"
+
+/**
+ * @brief تجزئة FNV-1a ببذرة؛ يجب أن تطابق fnv1a_seeded في scripts/generate_keyword_hash.py.
+ */
+static uint32_t baa_language_hash(const char *word, size_t length, uint32_t seed)
+{
+    uint32_t h = 2166136261u ^ seed;
+    for (size_t i = 0; i < length; ++i)
+    {
+        h ^= (unsigned char)word[i];
+        h *= 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+static bool baa_language_label_equals(const char *label, const char *word, size_t length)
+{
+    return strncmp(label, word, length) == 0 && label[length] == '\0';
+}
+
 const BaaLanguageKeyword *baa_language_keywords(size_t *count)
 {
     if (count) *count = sizeof(g_keywords) / sizeof(g_keywords[0]);
     return g_keywords;
 }
 
+bool baa_language_keyword_token_n(const char *word, size_t length, BaaTokenType *token_type)
+{
+    if (!word || !token_type || length == 0) return false;
+    const uint32_t slot = baa_language_hash(word, length, BAA_KEYWORD_HASH_SEED) &
+                          (BAA_KEYWORD_HASH_SIZE - 1u);
+    const int index = g_keyword_hash_slots[slot];
+    if (index < 0 || !baa_language_label_equals(g_keywords[index].label, word, length)) return false;
+    *token_type = g_keywords[index].token_type;
+    return true;
+}
+
 bool baa_language_keyword_token(const char *word, BaaTokenType *token_type)
 {
-    if (!word || !token_type) return false;
-    size_t count = 0;
-    const BaaLanguageKeyword *keywords = baa_language_keywords(&count);
-    for (size_t i = 0; i < count; ++i)
-    {
-        if (keywords[i].lexical_keyword && strcmp(word, keywords[i].label) == 0)
-        {
-            *token_type = keywords[i].token_type;
-            return true;
-        }
-    }
-    return false;
+    if (!word) return false;
+    return baa_language_keyword_token_n(word, strlen(word), token_type);
+}
+
+BaaLanguageDirective baa_language_directive(const char *word, size_t length)
+{
+    if (!word || length == 0) return BAA_DIRECTIVE_NONE;
+    const uint32_t slot = baa_language_hash(word, length, BAA_DIRECTIVE_HASH_SEED) &
+                          (BAA_DIRECTIVE_HASH_SIZE - 1u);
+    const int index = g_directive_hash_slots[slot];
+    // تسميات الموجهات في الجدول تبدأ بـ '#'.
+    if (index < 0 || !baa_language_label_equals(g_directives[index].label + 1, word, length))
+        return BAA_DIRECTIVE_NONE;
+    return (BaaLanguageDirective)index;
 }
 
 const BaaLanguageCompletionEntry *baa_language_directives(size_t *count)
@@ -30,9 +30,34 @@ typedef struct
     bool snippet;
 } BaaLanguageCompletionEntry;
 
+/**
+ * @brief موجهات المعالج القبلي بترتيب جدول baa_language_directives().
+ */
+typedef enum
+{
+    BAA_DIRECTIVE_NONE = -1,
+    BAA_DIRECTIVE_INCLUDE = 0,  // #تضمين
+    BAA_DIRECTIVE_DEFINE,       // #تعريف
+    BAA_DIRECTIVE_IFDEF,        // #إذا_عرف
+    BAA_DIRECTIVE_ELSE,         // #وإلا
+    BAA_DIRECTIVE_ENDIF,        // #نهاية
+    BAA_DIRECTIVE_UNDEF,        // #الغاء_تعريف
+    BAA_DIRECTIVE_COUNT
+} BaaLanguageDirective;
+
 const BaaLanguageKeyword *baa_language_keywords(size_t *count);
 bool baa_language_keyword_token(const char *word, BaaTokenType *token_type);
 
+/**
+ * @brief تصنيف كلمة غير منتهية بصفر عبر تجزئة تامة مولّدة (مقارنة واحدة على الأكثر).
+ */
+bool baa_language_keyword_token_n(const char *word, size_t length, BaaTokenType *token_type);
+
+/**
+ * @brief تحديد الموجه من اسمه دون '#' (مثل "تضمين")، أو BAA_DIRECTIVE_NONE.
+ */
+BaaLanguageDirective baa_language_directive(const char *word, size_t length);
+
 const BaaLanguageCompletionEntry *baa_language_directives(size_t *count);
 const BaaLanguageCompletionEntry *baa_language_snippets(size_t *count);
 
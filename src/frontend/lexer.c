@@ -6,14 +6,12 @@
 
 #include "frontend_internal.h"
 #include "language_profile.h"
+#include "../support/source_cache.h"
+#include "../support/text_scan.h"
 #include <ctype.h>
+#include <limits.h>
 #include <stdarg.h>
 
-static int is_utf8_cont_byte(unsigned char b)
-{
-    return ((b & 0xC0u) == 0x80u);
-}
-
 static bool lex_decode_arabic_escape(Lexer* l, unsigned char* out_byte)
 {
     if (!l || !out_byte) return false;
@@ -53,22 +51,6 @@ static bool lex_decode_arabic_escape(Lexer* l, unsigned char* out_byte)
     return false;
 }
 
-static bool lex_append_byte(char** buf, size_t* len, size_t* cap, unsigned char byte)
-{
-    if (!buf || !len || !cap || !*buf) return false;
-
-    if (*len + 1 >= *cap) {
-        size_t new_cap = (*cap < 32) ? 32 : (*cap * 2);
-        char* new_buf = (char*)realloc(*buf, new_cap);
-        if (!new_buf) return false;
-        *buf = new_buf;
-        *cap = new_cap;
-    }
-
-    (*buf)[(*len)++] = (char)byte;
-    return true;
-}
-
 /**
  * @brief إنشاء Token لموقع محدد داخل المحلل اللفظي.
  */
@@ -100,62 +82,19 @@ static void lex_fatal(Lexer* l, const char* fmt, ...)
 }
 
 /**
- * @brief التحقق من صحة تسلسل UTF-8 بدءاً من `s`.
+ * @brief طول تسلسل UTF-8 عند الموضع الحالي، أو 0 إن كان غير صالح.
  *
- * عند النجاح:
- * - تُخزّن طول التسلسل في out_len (1..4)
- * - تُرجع true
+ * ما قبل utf8_valid_end تحقق منه مسح الملف مسبقاً فيكفي بايت القائد؛
+ * بعده يُتحقق من التسلسل هنا ليبقى التشخيص في سياقه وموضعه.
  */
-static bool lex_utf8_validate_at(const char* s, int* out_len)
+static int lex_utf8_length_here(const Lexer* l)
 {
-    if (out_len) *out_len = 0;
-    if (!s || !*s) return false;
-
-    const unsigned char b0 = (unsigned char)s[0];
-    if ((b0 & 0x80u) == 0x00u) {
-        if (out_len) *out_len = 1;
-        return true;
-    }
-
-    if ((b0 & 0xE0u) == 0xC0u) {
-        const unsigned char b1 = (unsigned char)s[1];
-        if (b1 == 0 || !is_utf8_cont_byte(b1)) return false;
-        uint32_t cp = ((uint32_t)(b0 & 0x1Fu) << 6) | (uint32_t)(b1 & 0x3Fu);
-        if (cp < 0x80u) return false; // overlong
-        if (out_len) *out_len = 2;
-        return true;
-    }
-
-    if ((b0 & 0xF0u) == 0xE0u) {
-        const unsigned char b1 = (unsigned char)s[1];
-        const unsigned char b2 = (unsigned char)s[2];
-        if (b1 == 0 || b2 == 0) return false;
-        if (!is_utf8_cont_byte(b1) || !is_utf8_cont_byte(b2)) return false;
-        uint32_t cp = ((uint32_t)(b0 & 0x0Fu) << 12) |
-                      ((uint32_t)(b1 & 0x3Fu) << 6) |
-                      (uint32_t)(b2 & 0x3Fu);
-        if (cp < 0x800u) return false; // overlong
-        if (cp >= 0xD800u && cp <= 0xDFFFu) return false; // surrogate
-        if (out_len) *out_len = 3;
-        return true;
-    }
-
-    if ((b0 & 0xF8u) == 0xF0u) {
-        const unsigned char b1 = (unsigned char)s[1];
-        const unsigned char b2 = (unsigned char)s[2];
-        const unsigned char b3 = (unsigned char)s[3];
-        if (b1 == 0 || b2 == 0 || b3 == 0) return false;
-        if (!is_utf8_cont_byte(b1) || !is_utf8_cont_byte(b2) || !is_utf8_cont_byte(b3)) return false;
-        uint32_t cp = ((uint32_t)(b0 & 0x07u) << 18) |
-                      ((uint32_t)(b1 & 0x3Fu) << 12) |
-                      ((uint32_t)(b2 & 0x3Fu) << 6) |
-                      (uint32_t)(b3 & 0x3Fu);
-        if (cp < 0x10000u || cp > 0x10FFFFu) return false;
-        if (out_len) *out_len = 4;
-        return true;
+    const char* p = l->state.cur_char;
+    const unsigned char b0 = (unsigned char)*p;
+    if (p < l->state.utf8_valid_end) {
+        return b0 < 0x80u ? 1 : (b0 < 0xE0u ? 2 : (b0 < 0xF0u ? 3 : 4));
     }
-
-    return false;
+    return baa_utf8_sequence_length(p, (size_t)(l->state.end - p));
 }
 
 #define LEX_STDLIB_DIR "stdlib"
@@ -406,17 +345,15 @@ static void lex_fatal_include_cycle(Lexer* l, const char* requested_path, const
 }
 
 /**
- * @brief محاولة قراءة ملف مرشح للتضمين.
+ * @brief محاولة قراءة ملف مرشح للتضمين عبر الذاكرة المخبئية للمصادر.
+ *
+ * النص المعاد مشترك بين كل وحدات البناء؛ لا يحرره المحلل ولا يعدّله.
  */
 static char* lex_try_read_include_candidate(Lexer* l, const char* candidate, char** out_resolved_path)
 {
     if (!l || !candidate || !candidate[0] || !out_resolved_path) return NULL;
 
-    FILE* probe = baa_fopen_utf8(candidate, "rb");
-    if (!probe) return NULL;
-    fclose(probe);
-
-    char* source = read_file(candidate);
+    char* source = baa_source_cache_get(candidate, NULL);
     if (!source) return NULL;
 
     *out_resolved_path = lex_normalize_existing_path(l, candidate);
@@ -533,7 +470,13 @@ static char* lex_resolve_and_read_include(Lexer* l, const char* requested_path,
     return NULL;
 }
 
-static void lex_skip_utf8_bom(LexerState* state)
+/**
+ * @brief تهيئة حالة مخزن مصدر جديد: تخطي الـ BOM ثم مسح المخزن كاملاً مرة واحدة.
+ *
+ * المسح المتجهي يحدد نهاية المخزن وأول تسلسل UTF-8 غير صالح، فلا تعيد حلقات
+ * المعرّفات والنصوص التحقق من كل محرف قبل ذلك الموضع.
+ */
+static void lex_begin_source(LexerState* state)
 {
     if (!state || !state->cur_char) return;
 
@@ -543,20 +486,59 @@ static void lex_skip_utf8_bom(LexerState* state)
         (unsigned char)s[2] == 0xBF) {
         state->cur_char += 3;
     }
+
+    const size_t length = strlen(state->cur_char);
+    state->end = state->cur_char + length;
+    state->utf8_valid_end = state->cur_char + baa_utf8_valid_prefix(state->cur_char, length);
 }
 
+/**
+ * @brief توسيع مصفوفة ديناميكية لتتسع لـ need عنصراً على الأقل.
+ */
+static void lex_grow_array(Lexer* l, void* items_ptr, int* cap, int need, size_t elem_size)
+{
+    void** items = (void**)items_ptr;
+    if (need <= *cap) return;
+
+    int new_cap = *cap > 0 ? *cap : 8;
+    while (new_cap < need) {
+        if (new_cap > INT_MAX / 2) lex_fatal(l, "خطأ قبلي: تجاوز حجم جداول المحلل اللفظي.");
+        new_cap *= 2;
+    }
+    void* grown = realloc(*items, (size_t)new_cap * elem_size);
+    if (!grown) lex_fatal(l, "خطأ قبلي: نفدت الذاكرة أثناء توسيع جداول المحلل اللفظي.");
+    *items = grown;
+    *cap = new_cap;
+}
+
+#include "lexer_atoms.c"
+#include "lexer_macros.c"
+
 /**
  * @brief تهيئة المحلل اللفظي بنص المصدر وتخطي الـ BOM إذا وجد.
  */
 void lexer_init(Lexer* l,
+                BaaSession* session,
                 char* src,
                 const char* filename,
                 const char* const* include_dirs,
                 size_t include_dir_count) {
+    l->session = session;
+    l->stack = NULL;
     l->stack_depth = 0;
+    l->stack_cap = 0;
+    l->macros = NULL;
     l->macro_count = 0;
+    l->macro_cap = 0;
+    l->macro_buckets = NULL;
+    l->macro_bucket_count = 0;
     l->skipping = false;
+    l->if_stack = NULL;
     l->if_depth = 0;
+    l->if_cap = 0;
+    memset(&l->atoms, 0, sizeof(l->atoms));
+    l->scratch = NULL;
+    l->scratch_cap = 0;
     l->include_dirs = include_dirs;
     l->include_dir_count = include_dir_count;
     l->dependency_paths = NULL;
@@ -570,10 +552,12 @@ void lexer_init(Lexer* l,
     l->state.col = 1;
     l->state.cur_char = src;
 
-    // تخطي علامة ترتيب البايت (BOM) لملفات UTF-8 إذا كانت موجودة
-    lex_skip_utf8_bom(&l->state);
+    // تخطي علامة ترتيب البايت (BOM) لملفات UTF-8 إذا كانت موجودة، ومسح المخزن
+    lex_begin_source(&l->state);
 
-    error_register_source(filename, src);
+    BaaSession* previous_session = baa_session_bind(session);
+    error_register_source_shared(filename, src);
+    (void)baa_session_bind(previous_session);
 
     char* root_dep = lex_normalize_existing_path(l, filename ? filename : "<unknown>");
     if (root_dep) {
@@ -602,6 +586,26 @@ void lexer_free_dependencies(Lexer* lexer)
     lexer->dependency_capacity = 0;
 }
 
+void lexer_free(Lexer* lexer)
+{
+    if (!lexer) return;
+    // لا يملك المحلل أي نص مصدر: الجذري للمستدعي، وملفات التضمين للذاكرة المخبئية.
+    if (lexer->stack_depth > 0) {
+        lexer->state = lexer->stack[0];
+    }
+    free(lexer->stack);
+    lexer->stack = NULL;
+    lexer->stack_depth = 0;
+    lexer->stack_cap = 0;
+    free(lexer->if_stack);
+    lexer->if_stack = NULL;
+    lexer->if_depth = 0;
+    lexer->if_cap = 0;
+    lex_free_macros(lexer);
+    lex_free_atoms(lexer);
+    lexer_free_dependencies(lexer);
+}
+
 static bool pp_active(const Lexer* l)
 {
     if (!l) return true;
@@ -633,6 +637,30 @@ void advance_pos(Lexer* l) {
     l->state.cur_char++;
 }
 
+/**
+ * @brief تقديم المؤشر n بايت دفعة واحدة مع تحديث السطر والعمود كما تفعل advance_pos.
+ */
+static void lex_advance_span(Lexer* l, size_t n)
+{
+    if (n == 0) return;
+    const char* p = l->state.cur_char;
+    const size_t lines = baa_text_count_newlines(p, n);
+    if (lines == 0) {
+        l->state.col += (int)n;
+    } else {
+        size_t line_start = n;
+        while (p[line_start - 1] != '\n') line_start--;
+        l->state.line += (int)lines;
+        l->state.col = 1 + (int)(n - line_start);
+    }
+    l->state.cur_char += n;
+}
+
+static size_t lex_remaining(const Lexer* l)
+{
+    return (size_t)(l->state.end - l->state.cur_char);
+}
+
 /**
  * @brief التحقق مما إذا كان البايت الحالي بداية لمحرف عربي في ترميز UTF-8.
  */
@@ -684,49 +712,85 @@ static Token lex_finish_token(Lexer* l, Token token)
     return token;
 }
 
-/**
- * @brief إضافة تعريف ماكرو جديد.
- */
-void add_macro(Lexer* l, char* name, char* value) {
-    if (l->macro_count >= 100) {
-        lex_fatal(l, "خطأ قبلي: عدد تعريفات الماكرو تجاوز الحد الأقصى (100).");
-    }
-    l->macros[l->macro_count].name = strdup(name);
-    l->macros[l->macro_count].value = strdup(value);
-    if (!l->macros[l->macro_count].name || !l->macros[l->macro_count].value) {
-        lex_fatal(l, "خطأ قبلي: نفدت الذاكرة أثناء إضافة ماكرو.");
-    }
-    l->macro_count++;
+// بايتات ASCII التي تنهي المعرّف: الصفر والمسافات البيضاء ورموز العمليات والترقيم.
+#define LEX_BIT(c) (1ull << ((unsigned)(c) & 63u))
+static const uint64_t k_lex_ident_stop_lo =
+    LEX_BIT('\0') | LEX_BIT('\t') | LEX_BIT('\n') | LEX_BIT('\v') | LEX_BIT('\f') | LEX_BIT('\r') |
+    LEX_BIT(' ') | LEX_BIT('!') | LEX_BIT('"') | LEX_BIT('%') | LEX_BIT('&') | LEX_BIT('\'') |
+    LEX_BIT('(') | LEX_BIT(')') | LEX_BIT('*') | LEX_BIT('+') | LEX_BIT(',') | LEX_BIT('-') |
+    LEX_BIT('.') | LEX_BIT('/') | LEX_BIT(':') | LEX_BIT('<') | LEX_BIT('=') | LEX_BIT('>');
+static const uint64_t k_lex_ident_stop_hi =
+    LEX_BIT('[') | LEX_BIT(']') | LEX_BIT('^') | LEX_BIT('{') | LEX_BIT('|') | LEX_BIT('}') | LEX_BIT('~');
+#undef LEX_BIT
+
+static int lex_ident_stops_at(unsigned char b)
+{
+    const uint64_t set = b < 64u ? k_lex_ident_stop_lo : k_lex_ident_stop_hi;
+    return (int)((set >> (b & 63u)) & 1u);
 }
 
 /**
- * @brief إزالة تعريف ماكرو.
+ * @brief تقديم المؤشر إلى نهاية المعرّف الحالي.
+ *
+ * بايتات ASCII تُصنَّف بقناع ثابت، والتسلسلات متعددة البايت داخل المنطقة
+ * الصالحة تُتخطى بطول بايت القائد دون تحقق إضافي.
  */
-static void remove_macro(Lexer* l, const char* name) {
-    for (int i = 0; i < l->macro_count; i++) {
-        if (strcmp(l->macros[i].name, name) == 0) {
-            free(l->macros[i].name);
-            free(l->macros[i].value);
-            // إزاحة العناصر المتبقية
-            for (int j = i; j < l->macro_count - 1; j++) {
-                l->macros[j] = l->macros[j+1];
-            }
-            l->macro_count--;
-            return;
+static void lex_scan_identifier(Lexer* l)
+{
+    const char* p = l->state.cur_char;
+    for (;;) {
+        const unsigned char b0 = (unsigned char)p[0];
+        if (b0 < 0x80u) {
+            if (lex_ident_stops_at(b0)) break;
+            p++;
+            continue;
+        }
+        // الفاصلة المنقوطة العربية (؛) والفاصلة العربية (،) تنهيان المعرّف
+        if (b0 == 0xD8 && ((unsigned char)p[1] == 0x9B || (unsigned char)p[1] == 0x8C)) break;
+
+        l->state.col += (int)(p - l->state.cur_char);
+        l->state.cur_char = (char*)p;
+        const int ulen = lex_utf8_length_here(l);
+        if (ulen == 0) {
+            lex_fatal(l, "خطأ لفظي: UTF-8 غير صالح داخل المعرّف.");
         }
+        p += ulen;
     }
+    l->state.col += (int)(p - l->state.cur_char);
+    l->state.cur_char = (char*)p;
 }
 
 /**
- * @brief البحث عن ماكرو بالاسم.
+ * @brief نسخ سلسلة أرقام لاتينية أو عربية (٠-٩ = D9 A0..A9) إلى buffer كأرقام ASCII.
  */
-char* get_macro_value(Lexer* l, const char* name) {
-    for (int i = 0; i < l->macro_count; i++) {
-        if (strcmp(l->macros[i].name, name) == 0) {
-            return l->macros[i].value;
+static void lex_scan_digits(Lexer* l, char* buffer, int* buf_idx, int cap, const char* overflow_msg)
+{
+    const char* p = l->state.cur_char;
+    int idx = *buf_idx;
+    for (;;) {
+        const unsigned char b0 = (unsigned char)p[0];
+        char digit;
+        int width;
+        if (b0 >= '0' && b0 <= '9') {
+            digit = (char)b0;
+            width = 1;
+        } else if (b0 == 0xD9 && (unsigned char)p[1] >= 0xA0 && (unsigned char)p[1] <= 0xA9) {
+            digit = (char)('0' + ((unsigned char)p[1] - 0xA0));
+            width = 2;
+        } else {
+            break;
+        }
+        if (idx >= cap - 1) {
+            l->state.col += (int)(p - l->state.cur_char);
+            l->state.cur_char = (char*)p;
+            lex_fatal(l, "%s", overflow_msg);
         }
+        buffer[idx++] = digit;
+        p += width;
     }
-    return NULL;
+    l->state.col += (int)(p - l->state.cur_char);
+    l->state.cur_char = (char*)p;
+    *buf_idx = idx;
 }
 
 #include "lexer_tokens.c"
@@ -9,6 +9,8 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "../support/session.h"
+
 // ============================================================================
 // تعريفات المحلل اللفظي (Lexer)
 // ============================================================================
@@ -119,7 +121,9 @@ typedef enum {
  */
 typedef struct {
     BaaTokenType type;     // نوع الوحدة
-    char* value;        // القيمة النصية
+    const char* value;  // القيمة النصية (مُدمجة في جدول ذرات المحلل؛ لا تُحرر)
+    int atom;           // معرّف الذرة للمعرفات والكلمات المفتاحية (0 = لا يوجد)
+    const char* span;   // بداية الوحدة في مخزن المصدر (صالح حتى lexer_free)
     int line;           // رقم السطر
     int col;            // رقم العمود
     int length;         // طول الوحدة بالبايتات داخل السطر
@@ -131,10 +135,22 @@ typedef struct {
  * @brief تمثيل لتعريف ماكرو (Preprocessor Macro).
  */
 typedef struct {
-    char* name;  // اسم الماكرو
-    char* value; // القيمة الاستبدالية
+    char* name;        // اسم الماكرو (يملك كتلة الاسم والقيمة معاً)
+    char* value;       // القيمة الاستبدالية (داخل كتلة الاسم)
+    unsigned int hash; // تجزئة FNV-1a للاسم
+    int next;          // المدخل التالي في سلسلة الدلو (-1 للنهاية)
 } Macro;
 
+/**
+ * @struct LexerCondFrame
+ * @brief مستوى واحد في مكدس الشروط (#إذا_عرف/#وإلا/#نهاية).
+ */
+typedef struct {
+    unsigned char parent_active;
+    unsigned char cond_true;
+    unsigned char in_else;
+} LexerCondFrame;
+
 /**
  * @struct LexerState
  * @brief يحافظ على حالة المحلل اللفظي لملف واحد (لدعم التضمين المتداخل).
@@ -142,16 +158,46 @@ typedef struct {
 typedef struct {
     char* source;
     char* cur_char;
+    const char* end;            // نهاية المخزن (موضع الصفر الختامي)
+    const char* utf8_valid_end; // ما قبله تحقق مسح الملف من صحة UTF-8 فيه
     const char* filename; // اسم الملف الحالي
     int line;
     int col;
 } LexerState;
 
+/**
+ * @struct LexerAtom
+ * @brief نص مُدمج (Interned) واحد؛ النص مملوك لساحة الذرات.
+ */
+typedef struct {
+    const char* text;
+    int length;
+    unsigned int hash;   // تجزئة FNV-1a للنص
+    int next;            // الذرة التالية في سلسلة الدلو (0 للنهاية)
+    int kind;            // نوع الكلمة المفتاحية المخزن مؤقتاً، أو -1 إن لم يُحسب بعد
+} LexerAtom;
+
+/**
+ * @struct LexerAtomTable
+ * @brief جدول الذرات: كل نص مميز يُخزن مرة واحدة ويُعرّف برقم صحيح (يبدأ من 1).
+ */
+typedef struct {
+    LexerAtom* atoms;    // atoms[0] غير مستخدم (الذرة 0 تعني "لا يوجد")
+    int count;           // عدد الذرات + 1
+    int cap;
+    int* buckets;        // رؤوس السلاسل (عددها قوة للعدد 2)
+    int bucket_count;
+    struct LexerAtomBlock* blocks; // ساحة نصوص الذرات
+} LexerAtomTable;
+
 /**
  * @struct Lexer
  * @brief المحلل اللفظي والمعالج القبلي (Lexer & Preprocessor).
  */
 typedef struct {
+    // جلسة الترجمة التي تُسجَّل فيها مصادر الملف وتشخيصاته
+    BaaSession* session;
+
     // الحالة الحالية
     LexerState state;
 
@@ -159,22 +205,28 @@ typedef struct {
     const char* const* include_dirs;
     size_t include_dir_count;
 
-    // مكدس التضمين (Include Stack)
-    LexerState stack[10]; // أقصى عمق للتضمين: 10
+    // مكدس التضمين (Include Stack) — ينمو حسب الحاجة؛ الدورات وحدها تحدّ العمق
+    LexerState* stack;
     int stack_depth;
+    int stack_cap;
 
     // حالة المعالج القبلي (Preprocessor State)
-    Macro macros[100];    // جدول الماكروهات (حد أقصى 100)
-    int macro_count;      // عدد الماكروهات المعرفة
-    bool skipping;        // هل نحن في وضع التخطي؟ (مُشتق من مكدس الشروط)
+    Macro* macros;         // جدول الماكروهات (ينمو حسب الحاجة)
+    int macro_count;       // عدد الماكروهات المعرفة
+    int macro_cap;
+    int* macro_buckets;    // رؤوس سلاسل التجزئة (عددها قوة للعدد 2)
+    int macro_bucket_count;
+    bool skipping;         // هل نحن في وضع التخطي؟ (مُشتق من مكدس الشروط)
 
     // مكدس الشروط (#إذا_عرف/#وإلا/#نهاية) لدعم التعشيش بشكل صحيح
-    struct {
-        unsigned char parent_active;
-        unsigned char cond_true;
-        unsigned char in_else;
-    } if_stack[32];
+    LexerCondFrame* if_stack;
     int if_depth;
+    int if_cap;
+
+    // جدول الذرات لقيم الوحدات، ومخزن مؤقت لبناء النصوص الحرفية
+    LexerAtomTable atoms;
+    char* scratch;
+    size_t scratch_cap;
 
     // تبعيات البناء المكتشفة أثناء المعالجة القبلية (مسارات مطبعة ومملوكة)
     char** dependency_paths;
@@ -184,8 +236,12 @@ typedef struct {
 
 /**
  * @brief تهيئة المحلل اللفظي بنص المصدر وتخطي الـ BOM إذا وجد.
+ *
+ * تستعير التشخيصات src دون نسخه، فيجب أن يبقى صالحاً حتى انتهاء الوحدة.
+ * @param session جلسة الترجمة المالكة لتشخيصات هذا المصدر.
  */
 void lexer_init(Lexer* lexer,
+                BaaSession* session,
                 char* src,
                 const char* filename,
                 const char* const* include_dirs,
@@ -198,6 +254,16 @@ void lexer_init(Lexer* lexer,
  */
 Token lexer_next_token(Lexer* lexer);
 
+/**
+ * @brief إدماج النص [text, text+length) وإرجاع معرّف ذرته (نفس النص يعطي نفس المعرّف).
+ */
+int lexer_intern(Lexer* lexer, const char* text, size_t length);
+
+/**
+ * @brief نص الذرة atom (أو NULL إذا كان المعرّف غير صالح).
+ */
+const char* lexer_atom_text(const Lexer* lexer, int atom);
+
 /**
  * @brief تحويل نوع الوحدة إلى نص مقروء.
  */
@@ -213,4 +279,13 @@ const char* const* lexer_get_dependencies(const Lexer* lexer, size_t* out_count)
  */
 void lexer_free_dependencies(Lexer* lexer);
 
+/**
+ * @brief تحرير كل ذاكرة المحلل اللفظي (الذرات والماكروهات والمكدسات والتبعيات).
+ *
+ * لا يحرر نص المصدر الجذري الممرر إلى lexer_init()، ولا نصوص ملفات التضمين التي
+ * تملكها الذاكرة المخبئية للمصادر (source_cache.h) حتى نهاية البناء.
+ * قيم الوحدات (Token.value) تصبح غير صالحة بعد الاستدعاء.
+ */
+void lexer_free(Lexer* lexer);
+
 #endif
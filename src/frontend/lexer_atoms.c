@@ -0,0 +1,167 @@
+// ============================================================================
+// جدول الذرات (Interned atoms) لقيم الوحدات اللفظية
+// ============================================================================
+
+#define LEX_ATOM_BLOCK_SIZE (64u * 1024u)
+#define LEX_ATOM_MIN_BUCKETS 256
+
+struct LexerAtomBlock {
+    struct LexerAtomBlock* next;
+    size_t used;
+    size_t cap;
+    char data[];
+};
+
+static unsigned int lex_hash_bytes(const char* text, size_t length)
+{
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        h ^= (unsigned char)text[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static char* lex_atom_store(Lexer* l, const char* text, size_t length)
+{
+    LexerAtomTable* t = &l->atoms;
+    struct LexerAtomBlock* block = t->blocks;
+    if (!block || block->cap - block->used < length + 1u) {
+        size_t cap = length + 1u > LEX_ATOM_BLOCK_SIZE ? length + 1u : LEX_ATOM_BLOCK_SIZE;
+        block = (struct LexerAtomBlock*)malloc(sizeof(struct LexerAtomBlock) + cap);
+        if (!block) lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء إدماج نص الوحدة.");
+        block->used = 0;
+        block->cap = cap;
+        block->next = t->blocks;
+        t->blocks = block;
+    }
+    char* out = block->data + block->used;
+    if (length) memcpy(out, text, length);
+    out[length] = '\0';
+    block->used += length + 1u;
+    return out;
+}
+
+static void lex_atom_link(LexerAtomTable* t, int atom)
+{
+    const unsigned int b = t->atoms[atom].hash & (unsigned int)(t->bucket_count - 1);
+    t->atoms[atom].next = t->buckets[b];
+    t->buckets[b] = atom;
+}
+
+static void lex_atom_rehash(Lexer* l, int buckets)
+{
+    LexerAtomTable* t = &l->atoms;
+    int* heads = (int*)realloc(t->buckets, (size_t)buckets * sizeof(int));
+    if (!heads) lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء توسيع جدول الذرات.");
+    t->buckets = heads;
+    t->bucket_count = buckets;
+    for (int b = 0; b < buckets; b++) t->buckets[b] = 0;
+    for (int a = 1; a < t->count; a++) lex_atom_link(t, a);
+}
+
+static int lex_intern_hashed(Lexer* l, const char* text, size_t length, unsigned int hash)
+{
+    LexerAtomTable* t = &l->atoms;
+    if (t->bucket_count > 0) {
+        int a = t->buckets[hash & (unsigned int)(t->bucket_count - 1)];
+        for (; a != 0; a = t->atoms[a].next) {
+            const LexerAtom* atom = &t->atoms[a];
+            if (atom->hash == hash && (size_t)atom->length == length &&
+                memcmp(atom->text, text, length) == 0) {
+                return a;
+            }
+        }
+    }
+
+    if (length > (size_t)INT_MAX) lex_fatal(l, "خطأ لفظي: الوحدة أطول من الحد المسموح.");
+    if (t->count == 0) t->count = 1; // الذرة 0 محجوزة لمعنى "لا يوجد"
+    lex_grow_array(l, &t->atoms, &t->cap, t->count + 1, sizeof(LexerAtom));
+
+    const int a = t->count++;
+    LexerAtom* atom = &t->atoms[a];
+    atom->text = lex_atom_store(l, text, length);
+    atom->length = (int)length;
+    atom->hash = hash;
+    atom->kind = -1;
+    if (t->count > t->bucket_count) {
+        lex_atom_rehash(l, t->bucket_count > 0 ? t->bucket_count * 2 : LEX_ATOM_MIN_BUCKETS);
+    } else {
+        lex_atom_link(t, a);
+    }
+    return a;
+}
+
+int lexer_intern(Lexer* l, const char* text, size_t length)
+{
+    if (!l || !text) return 0;
+    return lex_intern_hashed(l, text, length, lex_hash_bytes(text, length));
+}
+
+const char* lexer_atom_text(const Lexer* l, int atom)
+{
+    if (!l || atom <= 0 || atom >= l->atoms.count) return NULL;
+    return l->atoms.atoms[atom].text;
+}
+
+/**
+ * @brief نوع الكلمة المفتاحية للذرة (يُحسب مرة واحدة لكل نص مميز).
+ */
+static BaaTokenType lex_atom_kind(Lexer* l, int atom)
+{
+    LexerAtom* a = &l->atoms.atoms[atom];
+    if (a->kind < 0) {
+        BaaTokenType type = TOKEN_IDENTIFIER;
+        if (!baa_language_keyword_token_n(a->text, (size_t)a->length, &type)) type = TOKEN_IDENTIFIER;
+        a->kind = (int)type;
+    }
+    return (BaaTokenType)a->kind;
+}
+
+/**
+ * @brief إضافة بايت إلى المخزن المؤقت المشترك لبناء النصوص الحرفية.
+ */
+static void lex_scratch_put(Lexer* l, size_t* len, unsigned char byte)
+{
+    if (*len + 1u >= l->scratch_cap) {
+        size_t cap = l->scratch_cap < 64u ? 64u : l->scratch_cap * 2u;
+        char* grown = (char*)realloc(l->scratch, cap);
+        if (!grown) lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء بناء النص.");
+        l->scratch = grown;
+        l->scratch_cap = cap;
+    }
+    l->scratch[(*len)++] = (char)byte;
+}
+
+/**
+ * @brief إلحاق n بايت دفعة واحدة بالمخزن المؤقت المشترك.
+ */
+static void lex_scratch_append(Lexer* l, size_t* len, const char* bytes, size_t n)
+{
+    if (*len + n + 1u > l->scratch_cap) {
+        size_t cap = l->scratch_cap < 64u ? 64u : l->scratch_cap;
+        while (cap < *len + n + 1u) cap *= 2u;
+        char* grown = (char*)realloc(l->scratch, cap);
+        if (!grown) lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء بناء النص.");
+        l->scratch = grown;
+        l->scratch_cap = cap;
+    }
+    memcpy(l->scratch + *len, bytes, n);
+    *len += n;
+}
+
+static void lex_free_atoms(Lexer* l)
+{
+    struct LexerAtomBlock* block = l->atoms.blocks;
+    while (block) {
+        struct LexerAtomBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(l->atoms.atoms);
+    free(l->atoms.buckets);
+    memset(&l->atoms, 0, sizeof(l->atoms));
+    free(l->scratch);
+    l->scratch = NULL;
+    l->scratch_cap = 0;
+}
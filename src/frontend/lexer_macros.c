@@ -0,0 +1,150 @@
+// ============================================================================
+// جدول الماكروهات ومكدسات المعالج القبلي (قابلة للنمو)
+// ============================================================================
+
+#define LEX_MACRO_MIN_BUCKETS 64
+
+static unsigned int lex_macro_hash(const char* name)
+{
+    return lex_hash_bytes(name, strlen(name));
+}
+
+/**
+ * @brief مؤشر الرابط الذي يشير إلى المدخل entry داخل سلسلة دلوه.
+ */
+static int* lex_macro_link_to(Lexer* l, int entry)
+{
+    const unsigned int b = l->macros[entry].hash & (unsigned int)(l->macro_bucket_count - 1);
+    int* link = &l->macro_buckets[b];
+    while (*link != entry) link = &l->macros[*link].next;
+    return link;
+}
+
+/**
+ * @brief إلحاق المدخل entry بذيل سلسلة دلوه.
+ *
+ * الإلحاق بالذيل يبقي أقدم تعريف لاسم مكرر أولاً في السلسلة، فيطابق البحث
+ * والإزالة سلوك الجدول الخطي السابق (أول تعريف هو الفعّال).
+ */
+static void lex_macro_link_tail(Lexer* l, int entry)
+{
+    const unsigned int b = l->macros[entry].hash & (unsigned int)(l->macro_bucket_count - 1);
+    int* link = &l->macro_buckets[b];
+    while (*link >= 0) link = &l->macros[*link].next;
+    l->macros[entry].next = -1;
+    *link = entry;
+}
+
+/**
+ * @brief مضاعفة عدد الدلاء مع الحفاظ على ترتيب كل سلسلة.
+ */
+static void lex_macro_rehash(Lexer* l, int buckets)
+{
+    int* old = l->macro_buckets;
+    const int old_count = l->macro_bucket_count;
+
+    l->macro_buckets = (int*)malloc((size_t)buckets * sizeof(int));
+    if (!l->macro_buckets) lex_fatal(l, "خطأ قبلي: نفدت الذاكرة أثناء توسيع جدول الماكروهات.");
+    l->macro_bucket_count = buckets;
+    for (int b = 0; b < buckets; b++) l->macro_buckets[b] = -1;
+
+    for (int b = 0; b < old_count; b++) {
+        int i = old[b];
+        while (i >= 0) {
+            const int next = l->macros[i].next;
+            lex_macro_link_tail(l, i);
+            i = next;
+        }
+    }
+    free(old);
+}
+
+static int lex_macro_find(const Lexer* l, const char* name, unsigned int hash)
+{
+    if (l->macro_bucket_count <= 0) return -1;
+    int i = l->macro_buckets[hash & (unsigned int)(l->macro_bucket_count - 1)];
+    for (; i >= 0; i = l->macros[i].next) {
+        if (l->macros[i].hash == hash && strcmp(l->macros[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief إضافة تعريف ماكرو جديد.
+ */
+void add_macro(Lexer* l, const char* name, const char* value) {
+    const size_t name_len = strlen(name);
+    const size_t value_len = strlen(value);
+    char* block = (char*)malloc(name_len + value_len + 2u);
+    if (!block) {
+        lex_fatal(l, "خطأ قبلي: نفدت الذاكرة أثناء إضافة ماكرو.");
+    }
+    memcpy(block, name, name_len + 1u);
+    memcpy(block + name_len + 1u, value, value_len + 1u);
+
+    lex_grow_array(l, &l->macros, &l->macro_cap, l->macro_count + 1, sizeof(Macro));
+    if (l->macro_count >= l->macro_bucket_count) {
+        int buckets = l->macro_bucket_count > 0 ? l->macro_bucket_count * 2 : LEX_MACRO_MIN_BUCKETS;
+        lex_macro_rehash(l, buckets);
+    }
+
+    Macro* m = &l->macros[l->macro_count];
+    m->name = block;
+    m->value = block + name_len + 1u;
+    m->hash = lex_macro_hash(name);
+    lex_macro_link_tail(l, l->macro_count);
+    l->macro_count++;
+}
+
+/**
+ * @brief إزالة تعريف ماكرو (أقدم تعريف بالاسم) في O(طول السلسلة).
+ */
+static void remove_macro(Lexer* l, const char* name) {
+    const int i = lex_macro_find(l, name, lex_macro_hash(name));
+    if (i < 0) return;
+
+    *lex_macro_link_to(l, i) = l->macros[i].next;
+    free(l->macros[i].name);
+
+    // نقل آخر مدخل إلى الخانة المحررة وتحديث الرابط الذي يشير إليه
+    const int last = l->macro_count - 1;
+    if (i != last) {
+        int* link = lex_macro_link_to(l, last);
+        l->macros[i] = l->macros[last];
+        *link = i;
+    }
+    l->macro_count--;
+}
+
+/**
+ * @brief البحث عن ماكرو بالاسم.
+ */
+char* get_macro_value(Lexer* l, const char* name) {
+    const int i = lex_macro_find(l, name, lex_macro_hash(name));
+    return i >= 0 ? l->macros[i].value : NULL;
+}
+
+/**
+ * @brief البحث عن ماكرو باسم ذرة مُدمجة (يعيد استخدام تجزئتها دون حساب جديد).
+ */
+static const char* lex_macro_value_for_atom(Lexer* l, int atom)
+{
+    if (l->macro_count == 0) return NULL;
+    const LexerAtom* a = &l->atoms.atoms[atom];
+    const int i = lex_macro_find(l, a->text, a->hash);
+    return i >= 0 ? l->macros[i].value : NULL;
+}
+
+static void lex_free_macros(Lexer* l)
+{
+    for (int i = 0; i < l->macro_count; i++) {
+        free(l->macros[i].name);
+    }
+    free(l->macros);
+    free(l->macro_buckets);
+    l->macros = NULL;
+    l->macro_count = 0;
+    l->macro_cap = 0;
+    l->macro_buckets = NULL;
+    l->macro_bucket_count = 0;
+}
@@ -3,16 +3,13 @@ Token lexer_next_token(Lexer* l) {
     
     // 0. حلقة لتجاوز المسافات ومعالجة التضمين
     while (1) {
-        // تخطي المسافات البيضاء والأسطر الجديدة
-        while (peek(l) != '\0' && isspace(peek(l))) {
-            advance_pos(l);
-        }
+        // تخطي المسافات البيضاء والأسطر الجديدة دفعة واحدة
+        lex_advance_span(l, baa_text_span_space(l->state.cur_char, lex_remaining(l)));
 
-        // تخطي التعليقات //
+        // تخطي التعليقات // حتى نهاية السطر
         if (peek(l) == '/' && peek_next(l) == '/') {
-            while (peek(l) != '\0' && peek(l) != '\n') {
-                l->state.cur_char++; // تخطي سريع
-            }
+            const char* nl = memchr(l->state.cur_char, '\n', lex_remaining(l));
+            l->state.cur_char = nl ? (char*)nl : l->state.cur_char + lex_remaining(l);
             continue; // إعادة المحاولة (لمعالجة السطر الجديد)
         }
 
@@ -28,16 +25,12 @@ Token lexer_next_token(Lexer* l) {
                  while (!isspace(peek(l)) && peek(l) != '\0') advance_pos(l);
                  
                  size_t len = l->state.cur_char - dir_start;
-                 char* directive = malloc(len + 1);
-                 if (!directive) {
-                     lex_fatal(l, "خطأ قبلي: نفدت الذاكرة أثناء قراءة التوجيه.");
-                 }
-                 if (len) memcpy(directive, dir_start, len);
-                 directive[len] = '\0';
+                 // تصنيف الموجه بتجزئة تامة من ملف تعريف اللغة بدلاً من سلسلة strcmp
+                 const BaaLanguageDirective directive = baa_language_directive(dir_start, len);
                  
                  // 1. #تضمين (Include)
-                 if (strcmp(directive, "تضمين") == 0) {
-                     if (l->skipping) { free(directive); continue; }
+                 if (directive == BAA_DIRECTIVE_INCLUDE) {
+                     if (l->skipping) continue;
 
                      while (peek(l) != '\0' && isspace(peek(l))) advance_pos(l);
                      if (peek(l) != '"') {
@@ -49,7 +42,6 @@ Token lexer_next_token(Lexer* l) {
                      size_t path_len = l->state.cur_char - path_start;
                      char* path = malloc(path_len + 1);
                      if (!path) {
-                         free(directive);
                          lex_fatal(l, "خطأ قبلي: نفدت الذاكرة أثناء قراءة مسار #تضمين.");
                      }
                      if (path_len) memcpy(path, path_start, path_len);
@@ -67,16 +59,10 @@ Token lexer_next_token(Lexer* l) {
                      }
 
                      if (lex_include_would_cycle(l, resolved_include_path)) {
-                         free(new_src);
                          lex_fatal_include_cycle(l, path, resolved_include_path);
                      }
                       
-                     size_t max_include_depth = sizeof(l->stack) / sizeof(l->stack[0]);
-                     if ((size_t)l->stack_depth >= max_include_depth) {
-                         free(new_src);
-                         free(resolved_include_path);
-                         lex_fatal(l, "خطأ قبلي: تم تجاوز عمق التضمين الأقصى (%zu).", max_include_depth);
-                     }
+                     lex_grow_array(l, &l->stack, &l->stack_cap, l->stack_depth + 1, sizeof(LexerState));
                      l->stack[l->stack_depth++] = l->state;
                       
                      const char* stable_include_path =
@@ -87,16 +73,15 @@ Token lexer_next_token(Lexer* l) {
                      l->state.filename = stable_include_path;
                      l->state.line = 1;
                      l->state.col = 1;
-                     lex_skip_utf8_bom(&l->state);
-                      error_register_source(l->state.filename, new_src);
+                     lex_begin_source(&l->state);
+                     error_register_source_shared(l->state.filename, new_src);
                      
-                     free(directive);
                      free(path);
                      continue;
                  }
                  // 2. #تعريف (Define)
-                 else if (strcmp(directive, "تعريف") == 0) {
-                     if (l->skipping) { free(directive); continue; }
+                 else if (directive == BAA_DIRECTIVE_DEFINE) {
+                     if (l->skipping) continue;
 
                      // قراءة الاسم
                      while (peek(l) != '\0' && isspace(peek(l))) advance_pos(l);
@@ -105,7 +90,6 @@ Token lexer_next_token(Lexer* l) {
                      size_t name_len = l->state.cur_char - name_start;
                      char* name = malloc(name_len + 1);
                      if (!name) {
-                         free(directive);
                          lex_fatal(l, "خطأ قبلي: نفدت الذاكرة أثناء قراءة اسم ماكرو.");
                      }
                      if (name_len) memcpy(name, name_start, name_len);
@@ -119,7 +103,6 @@ Token lexer_next_token(Lexer* l) {
                      char* val = malloc(val_len + 1);
                      if (!val) {
                          free(name);
-                         free(directive);
                          lex_fatal(l, "خطأ قبلي: نفدت الذاكرة أثناء قراءة قيمة ماكرو.");
                      }
                      if (val_len) memcpy(val, val_start, val_len);
@@ -131,11 +114,10 @@ Token lexer_next_token(Lexer* l) {
                      add_macro(l, name, val);
                      free(name);
                      free(val);
-                     free(directive);
                      continue;
                  }
                  // 3. #إذا_عرف (If Defined)
-                 else if (strcmp(directive, "إذا_عرف") == 0) {
+                 else if (directive == BAA_DIRECTIVE_IFDEF) {
                      // قراءة الاسم
                      while (peek(l) != '\0' && isspace(peek(l))) advance_pos(l);
                      char* name_start = l->state.cur_char;
@@ -143,7 +125,6 @@ Token lexer_next_token(Lexer* l) {
                      size_t name_len = l->state.cur_char - name_start;
                      char* name = malloc(name_len + 1);
                      if (!name) {
-                         free(directive);
                          lex_fatal(l, "خطأ قبلي: نفدت الذاكرة أثناء قراءة اسم #إذا_عرف.");
                      }
                      if (name_len) memcpy(name, name_start, name_len);
@@ -151,11 +132,7 @@ Token lexer_next_token(Lexer* l) {
 
                      bool defined = (get_macro_value(l, name) != NULL);
 
-                     if (l->if_depth >= (int)(sizeof(l->if_stack) / sizeof(l->if_stack[0]))) {
-                         free(name);
-                         free(directive);
-                         lex_fatal(l, "خطأ قبلي: تجاوزت الشروط المتداخلة الحد الأقصى.");
-                     }
+                     lex_grow_array(l, &l->if_stack, &l->if_cap, l->if_depth + 1, sizeof(LexerCondFrame));
 
                      bool parent = pp_active(l);
                      l->if_stack[l->if_depth].parent_active = parent ? 1 : 0;
@@ -165,39 +142,33 @@ Token lexer_next_token(Lexer* l) {
                      pp_recompute_skipping(l);
                      
                      free(name);
-                     free(directive);
                      continue;
                  }
                  // 4. #وإلا (Else)
-                 else if (strcmp(directive, "وإلا") == 0) {
+                 else if (directive == BAA_DIRECTIVE_ELSE) {
                      if (l->if_depth <= 0) {
-                         free(directive);
                          lex_fatal(l, "خطأ قبلي: #وإلا بدون #إذا_عرف مطابق.");
                      }
                      int i = l->if_depth - 1;
                      if (l->if_stack[i].in_else) {
-                         free(directive);
                          lex_fatal(l, "خطأ قبلي: تكرار #وإلا داخل نفس الكتلة.");
                      }
                      l->if_stack[i].in_else = 1;
                      pp_recompute_skipping(l);
-                     free(directive);
                      continue;
                  }
                  // 5. #نهاية (End)
-                 else if (strcmp(directive, "نهاية") == 0) {
+                 else if (directive == BAA_DIRECTIVE_ENDIF) {
                      if (l->if_depth <= 0) {
-                         free(directive);
                          lex_fatal(l, "خطأ قبلي: #نهاية بدون #إذا_عرف مطابق.");
                      }
                      l->if_depth--;
                      pp_recompute_skipping(l);
-                     free(directive);
                      continue;
                  }
                  // 6. #الغاء_تعريف (Undefine)
-                 else if (strcmp(directive, "الغاء_تعريف") == 0) {
-                     if (l->skipping) { free(directive); continue; }
+                 else if (directive == BAA_DIRECTIVE_UNDEF) {
+                     if (l->skipping) continue;
 
                      // قراءة الاسم
                      while (peek(l) != '\0' && isspace(peek(l))) advance_pos(l);
@@ -206,7 +177,6 @@ Token lexer_next_token(Lexer* l) {
                      size_t name_len = l->state.cur_char - name_start;
                      char* name = malloc(name_len + 1);
                      if (!name) {
-                         free(directive);
                          lex_fatal(l, "خطأ قبلي: نفدت الذاكرة أثناء قراءة اسم #الغاء_تعريف.");
                      }
                      if (name_len) memcpy(name, name_start, name_len);
@@ -214,11 +184,9 @@ Token lexer_next_token(Lexer* l) {
 
                      remove_macro(l, name);
                      free(name);
-                     free(directive);
                      continue;
                  }
                  
-                 free(directive);
              }
              lex_fatal(l, "خطأ قبلي: توجيه غير معروف.");
         }
@@ -229,9 +197,8 @@ Token lexer_next_token(Lexer* l) {
                 lex_fatal(l, "خطأ قبلي: نهاية الملف قبل إغلاق #إذا_عرف (مفقود #نهاية).");
             }
 
-            // إذا كنا داخل ملف مضمن، نعود للملف السابق (Pop)
+            // إذا كنا داخل ملف مضمن، نعود للملف السابق (Pop)؛ نصه يبقى في الذاكرة المخبئية
             if (l->stack_depth > 0) {
-                free(l->state.source);
                 l->state = l->stack[--l->stack_depth];
                 continue; 
             }
@@ -243,8 +210,10 @@ Token lexer_next_token(Lexer* l) {
         }
 
         // إذا كنا في وضع التخطي، نتجاهل كل شيء حتى نجد #
+        // (أو '/' قد يبدأ تعليقاً يخفي '#' بعده)
         if (l->skipping) {
             advance_pos(l);
+            lex_advance_span(l, baa_text_find_either(l->state.cur_char, lex_remaining(l), '#', '/'));
             continue;
         }
 
@@ -257,23 +226,29 @@ Token lexer_next_token(Lexer* l) {
     token.filename = l->state.filename;
 
     char* current = l->state.cur_char;
+    token.span = current;
 
     // --- معالجة النصوص ("...") ---
     if (*current == '"') {
         advance_pos(l); // تخطي " البداية
 
-        size_t cap = 32;
         size_t len = 0;
-        char* str = (char*)malloc(cap);
-        if (!str) {
-            lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء قراءة النص.");
-        }
 
         while (peek(l) != '"' && peek(l) != '\0') {
+            // مقطع بلا هروب داخل المنطقة الصالحة يُنسخ دفعة واحدة
+            if (l->state.cur_char < l->state.utf8_valid_end) {
+                const size_t avail = (size_t)(l->state.utf8_valid_end - l->state.cur_char);
+                const size_t run = baa_text_find_either(l->state.cur_char, avail, '"', '\\');
+                if (run > 0) {
+                    lex_scratch_append(l, &len, l->state.cur_char, run);
+                    lex_advance_span(l, run);
+                    continue;
+                }
+            }
+
             if (peek(l) == '\\') {
                 advance_pos(l); // تخطي '\'
                 if (peek(l) == '\0') {
-                    free(str);
                     lex_fatal(l, "خطأ لفظي: تسلسل هروب غير مكتمل داخل النص.");
                 }
 
@@ -283,54 +258,37 @@ Token lexer_next_token(Lexer* l) {
                 else if (peek(l) == '\'') { out = (unsigned char)'\''; advance_pos(l); }
                 else if (lex_decode_arabic_escape(l, &out)) { /* done */ }
                 else {
-                    free(str);
                     lex_fatal(l, "خطأ لفظي: تسلسل هروب غير مدعوم داخل النص.");
                 }
 
-                if (!lex_append_byte(&str, &len, &cap, out)) {
-                    free(str);
-                    lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء بناء النص.");
-                }
+                lex_scratch_put(l, &len, out);
                 continue;
             }
 
             unsigned char b0 = (unsigned char)peek(l);
             if (b0 >= 0x80u) {
-                int ulen = 0;
-                if (!lex_utf8_validate_at(l->state.cur_char, &ulen)) {
-                    free(str);
+                const int ulen = lex_utf8_length_here(l);
+                if (ulen == 0) {
                     lex_fatal(l, "خطأ لفظي: تسلسل UTF-8 غير صالح داخل النص.");
                 }
                 for (int i = 0; i < ulen; i++) {
-                    if (!lex_append_byte(&str, &len, &cap, (unsigned char)*l->state.cur_char)) {
-                        free(str);
-                        lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء بناء النص.");
-                    }
+                    lex_scratch_put(l, &len, (unsigned char)*l->state.cur_char);
                     advance_pos(l);
                 }
                 continue;
             }
 
-            if (!lex_append_byte(&str, &len, &cap, b0)) {
-                free(str);
-                lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء بناء النص.");
-            }
+            lex_scratch_put(l, &len, b0);
             advance_pos(l);
         }
 
         if (peek(l) == '\0') {
-            free(str);
             lex_fatal(l, "خطأ لفظي: النص غير مُغلق.");
         }
 
-        if (!lex_append_byte(&str, &len, &cap, 0)) {
-            free(str);
-            lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء إنهاء النص.");
-        }
-
         advance_pos(l); // تخطي " النهاية
         token.type = TOKEN_STRING;
-        token.value = str;
+        token.value = lexer_atom_text(l, lexer_intern(l, l->scratch ? l->scratch : "", len));
         return lex_finish_token(l, token);
     }
 
@@ -361,8 +319,8 @@ Token lexer_next_token(Lexer* l) {
         }
         else
         {
-            int ulen = 0;
-            if (!lex_utf8_validate_at(l->state.cur_char, &ulen)) {
+            const int ulen = lex_utf8_length_here(l);
+            if (ulen == 0) {
                 lex_fatal(l, "خطأ لفظي: UTF-8 غير صالح داخل الحرف الحرفي.");
             }
             for (int i = 0; i < ulen; i++) {
@@ -379,11 +337,7 @@ Token lexer_next_token(Lexer* l) {
         advance_pos(l);
 
         token.type = TOKEN_CHAR;
-        char* val = malloc((size_t)blen + 1);
-        if (!val) { lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء إنشاء الحرف الحرفي."); }
-        if (blen) memcpy(val, bytes, (size_t)blen);
-        val[blen] = '\0';
-        token.value = val;
+        token.value = lexer_atom_text(l, lexer_intern(l, (const char*)bytes, (size_t)blen));
         return lex_finish_token(l, token);
     }
 
@@ -504,23 +458,8 @@ Token lexer_next_token(Lexer* l) {
         char buffer[64] = {0}; 
         int buf_idx = 0;
         
-        while (1) {
-            char* c = l->state.cur_char;
-            if (isdigit((unsigned char)*c)) { 
-                if (buf_idx >= (int)sizeof(buffer) - 1) {
-                    lex_fatal(l, "خطأ لفظي: العدد الصحيح أطول من الحد المسموح.");
-                }
-                buffer[buf_idx++] = *c;
-                advance_pos(l); 
-            } 
-            else if (is_arabic_digit(c)) {
-                if (buf_idx >= (int)sizeof(buffer) - 1) {
-                    lex_fatal(l, "خطأ لفظي: العدد الصحيح أطول من الحد المسموح.");
-                }
-                buffer[buf_idx++] = ((unsigned char)c[1] - 0xA0) + '0';
-                l->state.cur_char += 2; l->state.col += 2;
-            } else { break; }
-        }
+        lex_scan_digits(l, buffer, &buf_idx, (int)sizeof(buffer),
+                        "خطأ لفظي: العدد الصحيح أطول من الحد المسموح.");
 
         // رقم عشري: جزء كسري بعد '.' متبوعاً برقم
         if (peek(l) == '.' && (isdigit((unsigned char)peek_next(l)) || is_arabic_digit(l->state.cur_char + 1)))
@@ -531,120 +470,55 @@ Token lexer_next_token(Lexer* l) {
             buffer[buf_idx++] = '.';
             advance_pos(l); // تخطي '.'
 
-            while (1) {
-                char* c = l->state.cur_char;
-                if (isdigit((unsigned char)*c)) {
-                    if (buf_idx >= (int)sizeof(buffer) - 1) {
-                        lex_fatal(l, "خطأ لفظي: العدد العشري أطول من الحد المسموح.");
-                    }
-                    buffer[buf_idx++] = *c;
-                    advance_pos(l);
-                }
-                else if (is_arabic_digit(c)) {
-                    if (buf_idx >= (int)sizeof(buffer) - 1) {
-                        lex_fatal(l, "خطأ لفظي: العدد العشري أطول من الحد المسموح.");
-                    }
-                    buffer[buf_idx++] = ((unsigned char)c[1] - 0xA0) + '0';
-                    l->state.cur_char += 2; l->state.col += 2;
-                } else { break; }
-            }
+            lex_scan_digits(l, buffer, &buf_idx, (int)sizeof(buffer),
+                            "خطأ لفظي: العدد العشري أطول من الحد المسموح.");
 
             token.type = TOKEN_FLOAT;
-            token.value = strdup(buffer);
+            token.value = lexer_atom_text(l, lexer_intern(l, buffer, (size_t)buf_idx));
             return lex_finish_token(l, token);
         }
 
-        token.value = strdup(buffer);
+        token.value = lexer_atom_text(l, lexer_intern(l, buffer, (size_t)buf_idx));
         return lex_finish_token(l, token);
     }
 
     // معالجة المعرفات والكلمات المفتاحية
     if (is_arabic_start_byte(*current)) {
         char* start = l->state.cur_char;
-        while (!isspace(peek(l)) && peek(l) != '\0' && 
-               strchr(".+-,=:(){}[]!<>*/%&|^~\"'", peek(l)) == NULL) {
-            // تحقق من الفاصلة المنقوطة العربية (؛)
-            if ((unsigned char)*l->state.cur_char == 0xD8 && (unsigned char)*(l->state.cur_char+1) == 0x9B) {
-                break;
-            }
-            // تحقق من الفاصلة العربية (،)
-            if ((unsigned char)*l->state.cur_char == 0xD8 && (unsigned char)*(l->state.cur_char + 1) == 0x8C) {
-                break;
-            }
-            unsigned char b0 = (unsigned char)*l->state.cur_char;
-            if (b0 >= 0x80u) {
-                int ulen = 0;
-                if (!lex_utf8_validate_at(l->state.cur_char, &ulen)) {
-                    lex_fatal(l, "خطأ لفظي: UTF-8 غير صالح داخل المعرّف.");
-                }
-                for (int i = 0; i < ulen; i++) {
-                    advance_pos(l);
-                }
-            } else {
-                advance_pos(l);
-            }
-        }
+        lex_scan_identifier(l);
         
-        size_t len = l->state.cur_char - start;
-        char* word = malloc(len + 1);
-        if (!word) {
-            lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء نسخ المعرّف.");
-        }
-        if (len) memcpy(word, start, len);
-        word[len] = '\0';
+        // المعرّف يُدمج مباشرة من مخزن المصدر دون نسخ وسيط
+        const size_t len = (size_t)(l->state.cur_char - start);
+        const int atom = lexer_intern(l, start, len);
 
         // 1. التحقق من استبدال الماكرو
-        char* macro_val = get_macro_value(l, word);
+        const char* macro_val = lex_macro_value_for_atom(l, atom);
         if (macro_val != NULL) {
             // استبدال الرمز بقيمة الماكرو
             if (macro_val[0] == '"') {
                 token.type = TOKEN_STRING;
                 // إزالة علامات التنصيص
                 size_t vlen = strlen(macro_val);
-                if (vlen >= 2) {
-                    char* val = malloc(vlen - 1);
-                    if (!val) {
-                        free(word);
-                        lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء نسخ قيمة الماكرو.");
-                    }
-                    if (vlen > 2) memcpy(val, macro_val + 1, vlen - 2);
-                    val[vlen - 2] = '\0';
-                    token.value = val;
-                } else {
-                    token.value = strdup("");
-                    if (!token.value) {
-                        free(word);
-                        lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء نسخ قيمة الماكرو.");
-                    }
-                }
-            } 
+                token.value = lexer_atom_text(l, lexer_intern(l, macro_val + 1, vlen >= 2 ? vlen - 2 : 0));
+            }
             else if (isdigit((unsigned char)macro_val[0]) || is_arabic_digit(macro_val)) {
                 token.type = TOKEN_INT;
-                token.value = strdup(macro_val);
-                if (!token.value) {
-                    free(word);
-                    lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء نسخ قيمة الماكرو.");
-                }
+                token.value = lexer_atom_text(l, lexer_intern(l, macro_val, strlen(macro_val)));
             }
             else {
                 token.type = TOKEN_IDENTIFIER;
-                token.value = strdup(macro_val);
-                if (!token.value) {
-                    free(word);
-                    lex_fatal(l, "خطأ لفظي: نفدت الذاكرة أثناء نسخ قيمة الماكرو.");
-                }
+                token.atom = lexer_intern(l, macro_val, strlen(macro_val));
+                token.value = lexer_atom_text(l, token.atom);
             }
-            free(word);
             return lex_finish_token(l, token);
         }
 
-        // 2. الكلمات المفتاحية المحجوزة من ملف تعريف اللغة المركزي
-        if (!baa_language_keyword_token(word, &token.type)) {
-            token.type = TOKEN_IDENTIFIER;
-            token.value = word;
-            return lex_finish_token(l, token);
+        // 2. الكلمات المفتاحية المحجوزة من ملف تعريف اللغة المركزي (تُحسب مرة لكل ذرة)
+        token.atom = atom;
+        token.type = lex_atom_kind(l, atom);
+        if (token.type == TOKEN_IDENTIFIER) {
+            token.value = lexer_atom_text(l, atom);
         }
-        free(word);
         return lex_finish_token(l, token);
     }
 
@@ -7,53 +7,37 @@
 #include "frontend_internal.h"
 #include <errno.h>
 #include <limits.h>
+#include <stddef.h>
 
-// كائن المحلل القواعدي الذي يدير الحالة الحالية والوحدة القادمة
-Parser parser;
+// حالة المحلل القواعدي الجارية على هذا الخيط؛ يملكها إطار parse() ويربطها طوال التحليل.
+static BAA_THREAD_LOCAL Parser* parser = NULL;
 
 #define PARSER_MAX_TYPE_ALIASES 256
 
-typedef struct {
+struct ParserTypeAlias {
     char* name;
+    int atom; // ذرة الاسم في جدول المحلل اللفظي (المقارنة بها عددية)
     DataType target_type;
     char* target_type_name;
     DataType target_ptr_base_type;
     char* target_ptr_base_type_name;
     int target_ptr_depth;
     FuncPtrSig* target_func_sig; // مملوك (قد يكون NULL)
-} ParserTypeAlias;
-
-static ParserTypeAlias parser_type_aliases[PARSER_MAX_TYPE_ALIASES];
-static int parser_type_alias_count = 0;
-
-static void parser_funcsig_free(FuncPtrSig* s);
+};
 
 static void parser_type_alias_reset(void)
 {
-    for (int i = 0; i < parser_type_alias_count; i++) {
-        free(parser_type_aliases[i].name);
-        parser_type_aliases[i].name = NULL;
-        free(parser_type_aliases[i].target_type_name);
-        parser_type_aliases[i].target_type_name = NULL;
-        free(parser_type_aliases[i].target_ptr_base_type_name);
-        parser_type_aliases[i].target_ptr_base_type_name = NULL;
-        if (parser_type_aliases[i].target_func_sig) {
-            parser_funcsig_free(parser_type_aliases[i].target_func_sig);
-            parser_type_aliases[i].target_func_sig = NULL;
-        }
-        parser_type_aliases[i].target_type = TYPE_INT;
-        parser_type_aliases[i].target_ptr_base_type = TYPE_INT;
-        parser_type_aliases[i].target_ptr_depth = 0;
-    }
-    parser_type_alias_count = 0;
+    // نصوص الأسماء البديلة وتواقيعها مخصصة من ساحة AST وتُحرَّر معها.
+    memset(parser->type_aliases, 0, (size_t)parser->type_alias_count * sizeof(ParserTypeAlias));
+    parser->type_alias_count = 0;
 }
 
-static const ParserTypeAlias* parser_type_alias_lookup(const char* name)
+static const ParserTypeAlias* parser_type_alias_lookup(int atom)
 {
-    if (!name) return NULL;
-    for (int i = 0; i < parser_type_alias_count; i++) {
-        if (parser_type_aliases[i].name && strcmp(parser_type_aliases[i].name, name) == 0) {
-            return &parser_type_aliases[i];
+    if (atom <= 0) return NULL;
+    for (int i = 0; i < parser->type_alias_count; i++) {
+        if (parser->type_aliases[i].atom == atom) {
+            return &parser->type_aliases[i];
         }
     }
     return NULL;
@@ -67,71 +51,36 @@ typedef enum {
 
 static void synchronize_mode(ParserSyncMode mode);
 
-static void parser_funcsig_free(FuncPtrSig* s)
+/**
+ * @brief نسخ نص داخل ساحة AST الحالية (NULL عند نفاد الذاكرة).
+ */
+static char* parser_strdup(const char* s)
 {
-    if (!s) return;
-    if (s->param_ptr_base_type_names) {
-        for (int i = 0; i < s->param_count; i++) {
-            free(s->param_ptr_base_type_names[i]);
-        }
-    }
-    free(s->return_ptr_base_type_name);
-    free(s->param_types);
-    free(s->param_ptr_base_types);
-    free(s->param_ptr_base_type_names);
-    free(s->param_ptr_depths);
-    free(s);
+    return ast_arena_strdup(parser->arena, s);
 }
 
-static FuncPtrSig* parser_funcsig_clone(const FuncPtrSig* s)
+/**
+ * @brief تخصيص ذاكرة مصفّرة من ساحة AST الحالية.
+ */
+static void* parser_alloc(size_t count, size_t size)
 {
-    if (!s) return NULL;
-
-    FuncPtrSig* out = (FuncPtrSig*)calloc(1, sizeof(FuncPtrSig));
-    if (!out) return NULL;
-
-    out->return_type = s->return_type;
-    out->return_ptr_base_type = s->return_ptr_base_type;
-    out->return_ptr_depth = s->return_ptr_depth;
-    out->is_variadic = s->is_variadic;
-    if (s->return_ptr_base_type_name) {
-        out->return_ptr_base_type_name = strdup(s->return_ptr_base_type_name);
-        if (!out->return_ptr_base_type_name) {
-            free(out);
-            return NULL;
-        }
-    }
-
-    out->param_count = s->param_count;
-    if (out->param_count > 0) {
-        size_t n = (size_t)out->param_count;
-        out->param_types = (DataType*)malloc(n * sizeof(DataType));
-        out->param_ptr_base_types = (DataType*)malloc(n * sizeof(DataType));
-        out->param_ptr_base_type_names = (char**)calloc(n, sizeof(char*));
-        out->param_ptr_depths = (int*)malloc(n * sizeof(int));
-        if (!out->param_types || !out->param_ptr_base_types || !out->param_ptr_base_type_names || !out->param_ptr_depths) {
-            parser_funcsig_free(out);
-            return NULL;
-        }
+    return ast_arena_calloc(parser->arena, count, size, _Alignof(max_align_t));
+}
 
-        for (int i = 0; i < out->param_count; i++) {
-            out->param_types[i] = s->param_types ? s->param_types[i] : TYPE_INT;
-            out->param_ptr_base_types[i] = s->param_ptr_base_types ? s->param_ptr_base_types[i] : TYPE_INT;
-            out->param_ptr_depths[i] = s->param_ptr_depths ? s->param_ptr_depths[i] : 0;
-            if (s->param_ptr_base_type_names && s->param_ptr_base_type_names[i]) {
-                out->param_ptr_base_type_names[i] = strdup(s->param_ptr_base_type_names[i]);
-                if (!out->param_ptr_base_type_names[i]) {
-                    parser_funcsig_free(out);
-                    return NULL;
-                }
-            }
-        }
-    }
+/**
+ * @brief توسيع مصفوفة مخصصة من ساحة AST (المحتوى القديم يُنسخ؛ لا تحرير منفرد).
+ */
+static void* parser_grow(void* old, size_t old_size, size_t new_size)
+{
+    return ast_arena_realloc(parser->arena, old, old_size, new_size, _Alignof(max_align_t));
+}
 
-    return out;
+static FuncPtrSig* parser_funcsig_clone(const FuncPtrSig* s)
+{
+    return ast_arena_funcsig_clone(parser->arena, s);
 }
 
-static bool parser_type_alias_register(Token tok, const char* alias_name,
+static bool parser_type_alias_register(Token tok, const char* alias_name, int alias_atom,
                                        DataType target_type, const char* target_type_name,
                                        DataType target_ptr_base_type,
                                        const char* target_ptr_base_type_name,
@@ -140,46 +89,40 @@ static bool parser_type_alias_register(Token tok, const char* alias_name,
 {
     if (!alias_name) return false;
 
-    if (parser_type_alias_lookup(alias_name)) {
+    if (parser_type_alias_lookup(alias_atom)) {
         return false;
     }
 
-    if (parser_type_alias_count >= PARSER_MAX_TYPE_ALIASES) {
+    if (parser->type_alias_count >= PARSER_MAX_TYPE_ALIASES) {
         error_report(tok, "عدد أسماء الأنواع البديلة كبير جداً (الحد %d).", PARSER_MAX_TYPE_ALIASES);
         return false;
     }
 
-    ParserTypeAlias* slot = &parser_type_aliases[parser_type_alias_count];
+    ParserTypeAlias* slot = &parser->type_aliases[parser->type_alias_count];
     memset(slot, 0, sizeof(*slot));
 
-    slot->name = strdup(alias_name);
+    slot->name = parser_strdup(alias_name);
     if (!slot->name) {
         error_report(tok, "نفدت الذاكرة أثناء تسجيل اسم النوع البديل.");
         return false;
     }
+    slot->atom = alias_atom;
 
     slot->target_type = target_type;
     slot->target_ptr_base_type = target_ptr_base_type;
     slot->target_ptr_depth = target_ptr_depth;
-    slot->target_func_sig = NULL;
 
     if (target_type_name && target_type_name[0]) {
-        slot->target_type_name = strdup(target_type_name);
+        slot->target_type_name = parser_strdup(target_type_name);
         if (!slot->target_type_name) {
-            free(slot->name);
-            slot->name = NULL;
             error_report(tok, "نفدت الذاكرة أثناء تسجيل مرجع النوع البديل.");
             return false;
         }
     }
 
     if (target_ptr_base_type_name && target_ptr_base_type_name[0]) {
-        slot->target_ptr_base_type_name = strdup(target_ptr_base_type_name);
+        slot->target_ptr_base_type_name = parser_strdup(target_ptr_base_type_name);
         if (!slot->target_ptr_base_type_name) {
-            free(slot->target_type_name);
-            slot->target_type_name = NULL;
-            free(slot->name);
-            slot->name = NULL;
             error_report(tok, "نفدت الذاكرة أثناء تسجيل أساس مؤشر النوع البديل.");
             return false;
         }
@@ -188,18 +131,12 @@ static bool parser_type_alias_register(Token tok, const char* alias_name,
     if (target_type == TYPE_FUNC_PTR) {
         slot->target_func_sig = parser_funcsig_clone(target_func_sig);
         if (!slot->target_func_sig) {
-            free(slot->target_ptr_base_type_name);
-            slot->target_ptr_base_type_name = NULL;
-            free(slot->target_type_name);
-            slot->target_type_name = NULL;
-            free(slot->name);
-            slot->name = NULL;
             error_report(tok, "نفدت الذاكرة أثناء نسخ توقيع مؤشر الدالة للاسم البديل.");
             return false;
         }
     }
 
-    parser_type_alias_count++;
+    parser->type_alias_count++;
     return true;
 }
 
@@ -222,13 +159,13 @@ static int64_t parser_sign_extend_u32(uint32_t u)
  * @brief التقدم للوحدة اللفظية التالية.
  */
 void advance() {
-    parser.current = parser.next;
+    parser->current = parser->next;
     
     while (true) {
-        parser.next = lexer_next_token(parser.lexer);
-        if (parser.next.type != TOKEN_INVALID) break;
+        parser->next = lexer_next_token(parser->lexer);
+        if (parser->next.type != TOKEN_INVALID) break;
         // إذا وجدنا وحدة غير صالحة، نبلغ عن الخطأ ونستمر في البحث
-        error_report(parser.next, "وحدة لفظية غير صالحة.");
+        error_report(parser->next, "وحدة لفظية غير صالحة.");
     }
 }
 
@@ -236,12 +173,14 @@ void advance() {
  * @brief تهيئة المحلل القواعدي ولبدء قراءة أول وحدتين.
  */
 void init_parser(Lexer* l) {
-    parser.lexer = l;
-    parser.panic_mode = false;
-    parser.had_error = false;
+    parser->lexer = l;
+    parser->panic_mode = false;
+    parser->had_error = false;
     parser_type_alias_reset();
-    advance(); // Load first token into parser.next (current is garbage initially)
-    parser.current = parser.next; // Sync
+    parser->atom_func_kw = lexer_intern(l, "دالة", strlen("دالة"));
+    parser->atom_type_alias_kw = lexer_intern(l, "نوع", strlen("نوع"));
+    advance(); // Load first token into parser->next (current is garbage initially)
+    parser->current = parser->next; // Sync
     advance(); // Load next token
 }
 
@@ -332,15 +271,15 @@ static const char* parser_fix_text_for_expected(BaaTokenType type)
 
 static void parser_error_expected_current(BaaTokenType type)
 {
-    const char* found_text = parser.current.value ? parser.current.value :
-                             token_type_to_str(parser.current.type);
+    const char* found_text = parser->current.value ? parser->current.value :
+                             token_type_to_str(parser->current.type);
     const char* hint = parser_hint_for_expected(type);
     const char* fix_id = parser_fix_id_for_expected(type);
     const char* fix_title = parser_fix_title_for_expected(type);
     const char* fix_text = parser_fix_text_for_expected(type);
 
     if (hint && fix_id && fix_title && fix_text) {
-        error_report_token_hint_fix(parser.current,
+        error_report_token_hint_fix(parser->current,
                                     hint,
                                     fix_id,
                                     fix_title,
@@ -349,12 +288,12 @@ static void parser_error_expected_current(BaaTokenType type)
                                     token_type_to_str(type),
                                     found_text);
     } else if (hint) {
-        error_report_token_hint(parser.current, hint,
+        error_report_token_hint(parser->current, hint,
                                 "متوقع '%s' لكن وُجد '%s'.",
                                 token_type_to_str(type),
                                 found_text);
     } else {
-        error_report_token(parser.current,
+        error_report_token(parser->current,
                            "متوقع '%s' لكن وُجد '%s'.",
                            token_type_to_str(type),
                            found_text);
@@ -365,18 +304,36 @@ static void parser_error_expected_current(BaaTokenType type)
 // مساعدات إنشاء عقد AST مع معلومات الموقع (Debug Locations)
 // ============================================================================
 
+/**
+ * @brief مسار المصدر للعقدة: نسخة واحدة في الساحة لكل ملف بدلاً من نسخة لكل عقدة.
+ *
+ * مسارات الوحدات اللفظية مستقرة لكل ملف مضمّن، لذا يكفي تذكر آخر مؤشر مصدر.
+ */
+static const char* parser_node_filename(const char* filename)
+{
+    if (!filename) return NULL;
+    if (filename != parser->last_filename_src) {
+        if (parser->last_filename && strcmp(parser->last_filename, filename) == 0) {
+            parser->last_filename_src = filename;
+            return parser->last_filename;
+        }
+        char* copy = parser_strdup(filename);
+        if (!copy) return NULL;
+        parser->last_filename_src = filename;
+        parser->last_filename = copy;
+    }
+    return parser->last_filename;
+}
+
 static Node* ast_node_new(NodeType type, Token tok) {
-    Node* n = (Node*)malloc(sizeof(Node));
+    Node* n = (Node*)ast_arena_calloc(parser->arena, 1, sizeof(Node), _Alignof(Node));
     if (!n) {
         error_report(tok, "فشل تخصيص عقدة AST.");
         return NULL;
     }
-    memset(n, 0, sizeof(Node));
     n->type = type;
-    n->next = NULL;
-    n->filename = tok.filename ? strdup(tok.filename) : NULL;
+    n->filename = parser_node_filename(tok.filename);
     if (tok.filename && !n->filename) {
-        free(n);
         error_report(tok, "فشل نسخ مسار المصدر لعقدة AST.");
         return NULL;
     }
@@ -390,14 +347,14 @@ static Node* ast_node_new(NodeType type, Token tok) {
  * @brief التأكد من أن الوحدة الحالية من نوع معين واستهلاكها، وإلا يتم إظهار خطأ.
  */
 void eat(BaaTokenType type) {
-    if (parser.current.type == type) {
+    if (parser->current.type == type) {
         advance();
         return;
     }
 
-    if (parser.panic_mode) return;
+    if (parser->panic_mode) return;
     
-    parser.panic_mode = true;
+    parser->panic_mode = true;
     
     parser_error_expected_current(type);
 }
@@ -422,15 +379,27 @@ bool is_type_keyword(BaaTokenType type) {
 #include "parser_stmt.c"
 #include "parser_decl.c"
 
-Node* parse(Lexer* l) {
+Node* parse(BaaSession* session, Lexer* l, AstArena* arena) {
+    if (!session || !l || !arena) return NULL;
+    BaaSession* previous_session = baa_session_bind(session);
+    Parser state = {0};
+    state.arena = arena;
+    state.type_aliases = (ParserTypeAlias*)calloc(PARSER_MAX_TYPE_ALIASES, sizeof(ParserTypeAlias));
+    if (!state.type_aliases) {
+        fprintf(stderr, "Fatal: out of memory while allocating parser state\n");
+        exit(1);
+    }
+    Parser* previous = parser;
+    parser = &state;
+
     // تهيئة نظام الأخطاء بمؤشر المصدر للطباعة
     error_init(l->state.source);
-    error_register_source(l->state.filename, l->state.source);
+    error_register_source_shared(l->state.filename, l->state.source);
     init_parser(l);
 
     Node* head = NULL;
     Node* tail = NULL;
-    while (parser.current.type != TOKEN_EOF) {
+    while (parser->current.type != TOKEN_EOF) {
         Node* decl = parse_declaration();
         if (decl) {
             if (head == NULL) { head = decl; tail = decl; }
@@ -445,7 +414,14 @@ Node* parse(Lexer* l) {
     tok_program.length = 1;
 
     Node* program = ast_node_new(NODE_PROGRAM, tok_program);
-    if (!program) return NULL;
-    program->data.program.declarations = head;
+    if (program) {
+        program->data.program.declarations = head;
+        program->data.program.arena = arena;
+    }
+
+    parser_type_alias_reset();
+    free(state.type_aliases);
+    parser = previous;
+    (void)baa_session_bind(previous_session);
     return program;
 }
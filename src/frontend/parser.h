@@ -8,6 +8,10 @@
 
 #include "lexer.h"
 #include "ast.h"
+#include "ast_arena.h"
+#include "../support/session.h"
+
+typedef struct ParserTypeAlias ParserTypeAlias;
 
 /**
  * @struct Parser
@@ -19,11 +23,22 @@ typedef struct {
     Token next;
     bool panic_mode; // وضع الذعر للتعافي من الأخطاء
     bool had_error;  // هل حدث خطأ أثناء التحليل؟
+    ParserTypeAlias* type_aliases; // الأسماء البديلة للأنواع في هذه الوحدة (مملوكة)
+    int type_alias_count;
+    int atom_func_kw;       // ذرة "دالة" (كلمة سياقية لأنواع مؤشرات الدوال)
+    int atom_type_alias_kw; // ذرة "نوع" (كلمة سياقية للأسماء البديلة)
+    AstArena* arena;        // ساحة العقد ونصوصها (يملكها مستدعي parse())
+    const char* last_filename_src; // آخر مسار مصدر نُسخ إلى الساحة
+    const char* last_filename;     // نسخته داخل الساحة
 } Parser;
 
 /**
  * @brief بدء عملية التحليل القواعدي وبناء الشجرة (AST).
+ *
+ * كل العقد ونصوصها ومصفوفاتها تُخصَّص من arena؛ تبقى الشجرة صالحة حتى
+ * ast_arena_destroy(arena) ولا تُحرَّر عقدها منفردة. التشخيصات تُسجَّل في
+ * session التي تُربط بالخيط طوال الاستدعاء فقط.
  */
-Node* parse(Lexer* lexer);
+Node* parse(BaaSession* session, Lexer* lexer, AstArena* arena);
 
 #endif
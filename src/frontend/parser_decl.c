@@ -2,9 +2,9 @@
     ParserDeclQualifiers decl_q;
     parser_parse_decl_qualifiers(&decl_q);
 
-    if (parser_current_is_type_alias_keyword() && parser.next.type == TOKEN_IDENTIFIER) {
+    if (parser_current_is_type_alias_keyword() && parser->next.type == TOKEN_IDENTIFIER) {
         if (decl_q.is_const || decl_q.is_static || decl_q.is_extern) {
-            error_report(parser.current, "تعريف اسم النوع البديل لا يقبل 'ثابت' أو 'ساكن' أو 'خارجي'.");
+            error_report(parser->current, "تعريف اسم النوع البديل لا يقبل 'ثابت' أو 'ساكن' أو 'خارجي'.");
             return parse_type_alias_declaration(false);
         }
         return parse_type_alias_declaration(true);
@@ -19,7 +19,7 @@
     }
 
     if (parser_current_starts_type()) {
-        Token tok_type = parser.current;
+        Token tok_type = parser->current;
         /*
          * Composite type definitions use the identifier consumed by
          * parse_type_spec() as their declaration name.  Preserve that token
@@ -27,11 +27,11 @@
          * `enum`/`struct`/`union` keyword span.
          */
         Token tok_composite_name = tok_type;
-        if ((parser.current.type == TOKEN_ENUM ||
-             parser.current.type == TOKEN_STRUCT ||
-             parser.current.type == TOKEN_UNION) &&
-            parser.next.type == TOKEN_IDENTIFIER) {
-            tok_composite_name = parser.next;
+        if ((parser->current.type == TOKEN_ENUM ||
+             parser->current.type == TOKEN_STRUCT ||
+             parser->current.type == TOKEN_UNION) &&
+            parser->next.type == TOKEN_IDENTIFIER) {
+            tok_composite_name = parser->next;
         }
         DataType dt = TYPE_INT;
         char* type_name = NULL;
@@ -45,19 +45,18 @@
                              &ptr_base_type, &ptr_base_type_name,
                              &ptr_depth,
                              &type_func_sig)) {
-            error_report(parser.current, "متوقع نوع.");
+            error_report(parser->current, "متوقع نوع.");
             synchronize_mode(PARSER_SYNC_DECLARATION);
             return NULL;
         }
 
         // تعريف تعداد/هيكل/اتحاد: تعداد <name> { ... }  |  هيكل <name> { ... } | اتحاد <name> { ... }
-        if ((dt == TYPE_ENUM || dt == TYPE_STRUCT || dt == TYPE_UNION) && parser.current.type == TOKEN_LBRACE) {
+        if ((dt == TYPE_ENUM || dt == TYPE_STRUCT || dt == TYPE_UNION) && parser->current.type == TOKEN_LBRACE) {
             // تواقيع مؤشرات الدوال لا تنطبق على هذا المسار.
-            parser_funcsig_free(type_func_sig);
             type_func_sig = NULL;
 
             if (is_const || is_static || is_extern) {
-                error_report(parser.current, "لا يمكن وسم تعريف نوع بـ 'ثابت' أو 'ساكن' أو 'خارجي'.");
+                error_report(parser->current, "لا يمكن وسم تعريف نوع بـ 'ثابت' أو 'ساكن' أو 'خارجي'.");
             }
 
             Token tok_name = tok_composite_name;
@@ -67,14 +66,14 @@
                 Node* head = NULL;
                 Node* tail = NULL;
 
-                if (parser.current.type != TOKEN_RBRACE) {
+                if (parser->current.type != TOKEN_RBRACE) {
                     while (1) {
-                        if (parser.current.type != TOKEN_IDENTIFIER) {
-                            error_report(parser.current, "متوقع اسم عنصر تعداد.");
+                        if (parser->current.type != TOKEN_IDENTIFIER) {
+                            error_report(parser->current, "متوقع اسم عنصر تعداد.");
                             break;
                         }
-                        Token tok_mem = parser.current;
-                        char* mem_name = strdup(parser.current.value);
+                        Token tok_mem = parser->current;
+                        char* mem_name = parser_strdup(parser->current.value);
                         eat(TOKEN_IDENTIFIER);
 
                         Node* mem = ast_node_new(NODE_ENUM_MEMBER, tok_mem);
@@ -86,9 +85,9 @@
                         if (!head) { head = mem; tail = mem; }
                         else { tail->next = mem; tail = mem; }
 
-                        if (parser.current.type == TOKEN_COMMA) {
+                        if (parser->current.type == TOKEN_COMMA) {
                             eat(TOKEN_COMMA);
-                            if (parser.current.type == TOKEN_RBRACE) break; // السماح بفاصلة أخيرة
+                            if (parser->current.type == TOKEN_RBRACE) break; // السماح بفاصلة أخيرة
                             continue;
                         }
                         break;
@@ -108,12 +107,12 @@
             eat(TOKEN_LBRACE);
             Node* head_f = NULL;
             Node* tail_f = NULL;
-            while (parser.current.type != TOKEN_RBRACE && parser.current.type != TOKEN_EOF) {
+            while (parser->current.type != TOKEN_RBRACE && parser->current.type != TOKEN_EOF) {
                 bool field_const = false;
                 Token tok_field_const = {0};
-                if (parser.current.type == TOKEN_CONST) {
+                if (parser->current.type == TOKEN_CONST) {
                     field_const = true;
-                    tok_field_const = parser.current;
+                    tok_field_const = parser->current;
                     eat(TOKEN_CONST);
                 }
 
@@ -127,32 +126,23 @@
                                      &fptr_base_type, &fptr_base_type_name,
                                      &fptr_depth,
                                      &ffunc_sig)) {
-                    error_report(parser.current, "متوقع نوع حقل داخل الهيكل/الاتحاد.");
-                    free(ftype_name);
-                    free(fptr_base_type_name);
-                    parser_funcsig_free(ffunc_sig);
+                    error_report(parser->current, "متوقع نوع حقل داخل الهيكل/الاتحاد.");
                     synchronize_mode(PARSER_SYNC_DECLARATION);
                     break;
                 }
 
-                if (parser.current.type != TOKEN_IDENTIFIER) {
-                    error_report(parser.current, "متوقع اسم حقل داخل الهيكل/الاتحاد.");
-                    free(ftype_name);
-                    free(fptr_base_type_name);
-                    parser_funcsig_free(ffunc_sig);
+                if (parser->current.type != TOKEN_IDENTIFIER) {
+                    error_report(parser->current, "متوقع اسم حقل داخل الهيكل/الاتحاد.");
                     synchronize_mode(PARSER_SYNC_DECLARATION);
                     break;
                 }
 
-                Token tok_field_name = parser.current;
-                char* fname = strdup(parser.current.value);
+                Token tok_field_name = parser->current;
+                char* fname = parser_strdup(parser->current.value);
                 eat(TOKEN_IDENTIFIER);
 
-                if (parser.current.type == TOKEN_LBRACKET) {
-                    error_report(parser.current, "حقول المصفوفات داخل الهيكل/الاتحاد غير مدعومة بعد.");
-                    free(ftype_name);
-                    free(fptr_base_type_name);
-                    parser_funcsig_free(ffunc_sig);
+                if (parser->current.type == TOKEN_LBRACKET) {
+                    error_report(parser->current, "حقول المصفوفات داخل الهيكل/الاتحاد غير مدعومة بعد.");
                     synchronize_mode(PARSER_SYNC_DECLARATION);
                     break;
                 }
@@ -196,47 +186,40 @@
         }
 
         // متغير/دالة: نحتاج اسم الرمز بعد نوعه
-        Token tok_name = parser.current;
-        if (parser.current.type != TOKEN_IDENTIFIER) {
-            error_report(parser.current, "متوقع اسم معرّف بعد النوع.");
-            free(type_name);
-            free(ptr_base_type_name);
-            parser_funcsig_free(type_func_sig);
+        Token tok_name = parser->current;
+        if (parser->current.type != TOKEN_IDENTIFIER) {
+            error_report(parser->current, "متوقع اسم معرّف بعد النوع.");
             synchronize_mode(PARSER_SYNC_DECLARATION);
             return NULL;
         }
 
-        char* name = strdup(parser.current.value);
+        char* name = parser_strdup(parser->current.value);
         eat(TOKEN_IDENTIFIER);
 
-        if (dt == TYPE_VOID && parser.current.type != TOKEN_LPAREN) {
+        if (dt == TYPE_VOID && parser->current.type != TOKEN_LPAREN) {
             error_report(tok_type, "لا يمكن تعريف متغير عام من نوع 'عدم'.");
         }
 
         // دالة: نسمح فقط بأنواع بدائية حالياً
-        if (parser.current.type == TOKEN_LPAREN) {
+        if (parser->current.type == TOKEN_LPAREN) {
                 if (dt == TYPE_ENUM || dt == TYPE_STRUCT || dt == TYPE_UNION) {
-                    error_report(parser.current, "أنواع الإرجاع المعرفة من المستخدم غير مدعومة بعد في تواقيع الدوال.");
-                    free(type_name);
-                    free(ptr_base_type_name);
-                    parser_funcsig_free(type_func_sig);
-                    free(name);
+                    error_report(parser->current, "أنواع الإرجاع المعرفة من المستخدم غير مدعومة بعد في تواقيع الدوال.");
                     synchronize_mode(PARSER_SYNC_DECLARATION);
                     return NULL;
                 }
             if (is_const || is_static) {
-                error_report(parser.current, "لا يمكن تعريف الدوال بوسم 'ثابت' أو 'ساكن'.");
+                error_report(parser->current, "لا يمكن تعريف الدوال بوسم 'ثابت' أو 'ساكن'.");
             }
 
             eat(TOKEN_LPAREN);
             Node* head_param = NULL;
             Node* tail_param = NULL;
             bool is_variadic = false;
-            if (parser.current.type != TOKEN_RPAREN) {
+            if (parser->current.type != TOKEN_RPAREN) {
                 while (1) {
-                    if (parser.current.type == TOKEN_ELLIPSIS) {
+                    if (parser->current.type == TOKEN_ELLIPSIS) {
                         if (!head_param) {
-                            error_report(parser.current, "غير مدعوم: '...' يتطلب وجود معامل ثابت واحد على الأقل.");
+                            error_report(parser->current, "غير مدعوم: '...' يتطلب وجود معامل ثابت واحد على الأقل.");
                         } else {
                             is_variadic = true;
                         }
@@ -245,7 +228,7 @@
                     }
 
                     // معاملات الدالة: نسمح بالأنواع البدائية العددية/النص/منطقي/حرف + سكر نحوي 'T[]' (يُعامل كمؤشر).
-                    Token tok_param_type = parser.current;
+                    Token tok_param_type = parser->current;
                     DataType param_dt = TYPE_INT;
                     char* param_tn = NULL;
                     DataType param_ptr_base_type = TYPE_INT;
@@ -256,23 +239,17 @@
                                          &param_ptr_base_type, &param_ptr_base_type_name,
                                          &param_ptr_depth,
                                          &param_func_sig)) {
-                        error_report(parser.current, "متوقع نوع للمعامل.");
+                        error_report(parser->current, "متوقع نوع للمعامل.");
                         synchronize_mode(PARSER_SYNC_DECLARATION);
                         return NULL;
                     }
                     if (param_dt == TYPE_ENUM || param_dt == TYPE_STRUCT || param_dt == TYPE_UNION) {
                         error_report(tok_param_type, "أنواع المعاملات المعرفة من المستخدم غير مدعومة بعد في تواقيع الدوال.");
-                        if (param_tn) free(param_tn);
-                        if (param_ptr_base_type_name) free(param_ptr_base_type_name);
-                        parser_funcsig_free(param_func_sig);
                         param_tn = NULL;
                         param_dt = TYPE_INT;
                         param_func_sig = NULL;
                     } else if (param_dt == TYPE_VOID) {
                         error_report(tok_param_type, "لا يمكن استخدام 'عدم' كنوع معامل.");
-                        if (param_tn) free(param_tn);
-                        if (param_ptr_base_type_name) free(param_ptr_base_type_name);
-                        parser_funcsig_free(param_func_sig);
                         param_tn = NULL;
                         param_dt = TYPE_INT;
                         param_func_sig = NULL;
@@ -284,27 +261,19 @@
                     // سكر نحوي لمعلمات الدالة: T[] ⇢ T*
                     // ملاحظة: هذا يختلف عن مصفوفات اللغة الثابتة الحجم؛ هنا المقصود "مؤشر" مثل C.
                     // -----------------------------------------------------------------
-                    if (parser.current.type == TOKEN_LBRACKET) {
-                        Token tok_lb = parser.current;
+                    if (parser->current.type == TOKEN_LBRACKET) {
+                        Token tok_lb = parser->current;
                         eat(TOKEN_LBRACKET);
-                        if (parser.current.type != TOKEN_RBRACKET) {
+                        if (parser->current.type != TOKEN_RBRACKET) {
                             error_report(tok_lb, "غير مدعوم: معاملات الدوال تدعم فقط '[]' بدون حجم (سكر نحوي لمؤشر).");
                             // محاولة استرداد بسيطة: التخلي عن تحليل هذه الدالة.
-                            free(pname);
-                            free(param_tn);
-                            free(param_ptr_base_type_name);
-                            parser_funcsig_free(param_func_sig);
                             synchronize_mode(PARSER_SYNC_DECLARATION);
                             return NULL;
                         }
                         eat(TOKEN_RBRACKET);
 
-                        if (parser.current.type == TOKEN_LBRACKET) {
+                        if (parser->current.type == TOKEN_LBRACKET) {
                             error_report(tok_lb, "غير مدعوم: أبعاد متعددة '[][]' في معاملات الدوال.");
-                            free(pname);
-                            free(param_tn);
-                            free(param_ptr_base_type_name);
-                            parser_funcsig_free(param_func_sig);
                             synchronize_mode(PARSER_SYNC_DECLARATION);
                             return NULL;
                         }
@@ -323,20 +292,14 @@
                     }
 
                     Token tok_param_name = tok_param_type;
-                    if (parser.current.type == TOKEN_IDENTIFIER) {
-                        tok_param_name = parser.current;
-                        pname = strdup(parser.current.value);
+                    if (parser->current.type == TOKEN_IDENTIFIER) {
+                        tok_param_name = parser->current;
+                        pname = parser_strdup(parser->current.value);
                         eat(TOKEN_IDENTIFIER);
                     }
 
                     Node* param = ast_node_new(NODE_VAR_DECL, tok_param_name);
-                    if (!param) {
-                        free(pname);
-                        free(param_tn);
-                        free(param_ptr_base_type_name);
-                        parser_funcsig_free(param_func_sig);
-                        return NULL;
-                    }
+                    if (!param) return NULL;
                     param->data.var_decl.name = pname;
                     param->data.var_decl.type = param_dt;
                     param->data.var_decl.type_name = param_tn;
@@ -350,7 +313,7 @@
                     if (head_param == NULL) { head_param = param; tail_param = param; }
                     else { tail_param->next = param; tail_param = param; }
 
-                    if (parser.current.type == TOKEN_COMMA) eat(TOKEN_COMMA);
+                    if (parser->current.type == TOKEN_COMMA) eat(TOKEN_COMMA);
                     else break;
                 }
             }
@@ -359,7 +322,7 @@
             Node* body = NULL;
             bool is_proto = false;
 
-            if (parser.current.type == TOKEN_DOT) {
+            if (parser->current.type == TOKEN_DOT) {
                 eat(TOKEN_DOT);
                 is_proto = true;
             } else {
@@ -372,13 +335,7 @@
             }
 
             Node* func = ast_node_new(NODE_FUNC_DEF, tok_name);
-            if (!func) {
-                free(name);
-                free(type_name);
-                free(ptr_base_type_name);
-                parser_funcsig_free(type_func_sig);
-                return NULL;
-            }
+            if (!func) return NULL;
             func->data.func_def.name = name;
             func->data.func_def.return_type = dt;
             func->data.func_def.return_ptr_base_type = ptr_base_type;
@@ -390,18 +347,13 @@
             func->data.func_def.is_variadic = is_variadic;
             func->data.func_def.is_prototype = is_proto;
             func->data.func_def.is_extern = is_extern;
-            free(type_name);
             return func;
         }
 
         // تعريف مصفوفة عامة ثابتة الأبعاد
-        if (parser.current.type == TOKEN_LBRACKET) {
+        if (parser->current.type == TOKEN_LBRACKET) {
             if (dt == TYPE_FUNC_PTR) {
-                error_report(parser.current, "مصفوفات من نوع مؤشر دالة غير مدعومة بعد.");
-                free(type_name);
-                free(ptr_base_type_name);
-                parser_funcsig_free(type_func_sig);
-                free(name);
+                error_report(parser->current, "مصفوفات من نوع مؤشر دالة غير مدعومة بعد.");
                 synchronize_mode(PARSER_SYNC_DECLARATION);
                 return NULL;
             }
@@ -409,10 +361,6 @@
             int dim_count = 0;
             int64_t total_elems = 0;
             if (!parse_array_dimensions(&dims, &dim_count, &total_elems)) {
-                free(type_name);
-                free(ptr_base_type_name);
-                parser_funcsig_free(type_func_sig);
-                free(name);
                 synchronize_mode(PARSER_SYNC_DECLARATION);
                 return NULL;
             }
@@ -427,13 +375,7 @@
             eat(TOKEN_DOT);
 
             Node* arr = ast_node_new(NODE_ARRAY_DECL, tok_name);
-            if (!arr) {
-                free(dims);
-                free(type_name);
-                free(name);
-                parser_funcsig_free(type_func_sig);
-                return NULL;
-            }
+            if (!arr) return NULL;
             arr->data.array_decl.name = name;
             arr->data.array_decl.element_type = dt;
             arr->data.array_decl.element_type_name = type_name;
@@ -452,7 +394,6 @@
             arr->data.array_decl.has_init = has_init;
             arr->data.array_decl.init_values = init_vals;
             arr->data.array_decl.init_count = init_count;
-            parser_funcsig_free(type_func_sig);
             return arr;
         }
 
@@ -461,25 +402,19 @@
             int init_count = 0;
             bool has_init = false;
             Node* init_vals = NULL;
-            if (parser.current.type == TOKEN_ASSIGN) {
+            if (parser->current.type == TOKEN_ASSIGN) {
                 if (is_extern) {
                     error_report(decl_q.tok_extern, "لا يقبل التصريح 'خارجي' تهيئة.");
                 }
                 init_vals = parse_struct_initializer_list(&init_count, &has_init);
             }
             if (is_const && !is_extern && !has_init) {
-                error_report(parser.current, "الثابت المركب يجب تهيئته.");
+                error_report(parser->current, "الثابت المركب يجب تهيئته.");
             }
             eat(TOKEN_DOT);
 
             Node* var = ast_node_new(NODE_VAR_DECL, tok_name);
-            if (!var) {
-                free(type_name);
-                free(ptr_base_type_name);
-                parser_funcsig_free(type_func_sig);
-                free(name);
-                return NULL;
-            }
+            if (!var) return NULL;
             var->data.var_decl.name = name;
             var->data.var_decl.type = dt;
             var->data.var_decl.type_name = type_name;
@@ -498,7 +433,7 @@
         }
 
         Node* expr = NULL;
-        if (parser.current.type == TOKEN_ASSIGN) {
+        if (parser->current.type == TOKEN_ASSIGN) {
             if (is_extern) {
                 error_report(decl_q.tok_extern, "لا يقبل التصريح 'خارجي' تهيئة.");
             }
@@ -508,13 +443,7 @@
         eat(TOKEN_DOT);
 
         Node* var = ast_node_new(NODE_VAR_DECL, tok_name);
-        if (!var) {
-            free(type_name);
-            free(ptr_base_type_name);
-            parser_funcsig_free(type_func_sig);
-            free(name);
-            return NULL;
-        }
+        if (!var) return NULL;
         var->data.var_decl.name = name;
         var->data.var_decl.type = dt;
         var->data.var_decl.type_name = type_name;
@@ -532,11 +461,11 @@
         return var;
     }
     
-    if (!parser.panic_mode) {
-        error_report_token_hint(parser.current,
+    if (!parser->panic_mode) {
+        error_report_token_hint(parser->current,
                                 "ابدأ التصريح بنوع مثل 'صحيح' أو 'نص' أو بتعريف 'نوع'.",
                                 "متوقع تصريح (دالة أو متغير عام).");
-        parser.panic_mode = true;
+        parser->panic_mode = true;
     }
     synchronize_mode(PARSER_SYNC_DECLARATION);
     return NULL;
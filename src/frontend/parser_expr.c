@@ -4,22 +4,22 @@
 Node* parse_primary() {
     Node* node = NULL;
 
-    if (parser.current.type == TOKEN_INT) {
-        Token tok = parser.current;
+    if (parser->current.type == TOKEN_INT) {
+        Token tok = parser->current;
         node = ast_node_new(NODE_INT, tok);
         if (!node) return NULL;
         int64_t v = 0;
-        (void)parse_int_token_checked(parser.current, &v);
+        (void)parse_int_token_checked(parser->current, &v);
         node->data.integer.value = v;
         eat(TOKEN_INT);
     }
-    else if (parser.current.type == TOKEN_FLOAT) {
-        Token tok = parser.current;
+    else if (parser->current.type == TOKEN_FLOAT) {
+        Token tok = parser->current;
         node = ast_node_new(NODE_FLOAT, tok);
         if (!node) return NULL;
         double v = 0.0;
-        if (!parse_float_token_checked(parser.current, &v)) {
-            error_report(parser.current, "صيغة العدد العشري غير صالحة.");
+        if (!parse_float_token_checked(parser->current, &v)) {
+            error_report(parser->current, "صيغة العدد العشري غير صالحة.");
         }
         node->data.float_lit.value = v;
         uint64_t bits = 0;
@@ -27,48 +27,48 @@ Node* parse_primary() {
         node->data.float_lit.bits = bits;
         eat(TOKEN_FLOAT);
     }
-    else if (parser.current.type == TOKEN_STRING) {
-        Token tok = parser.current;
+    else if (parser->current.type == TOKEN_STRING) {
+        Token tok = parser->current;
         node = ast_node_new(NODE_STRING, tok);
         if (!node) return NULL;
-        node->data.string_lit.value = strdup(parser.current.value);
+        node->data.string_lit.value = parser_strdup(parser->current.value);
         node->data.string_lit.id = -1;
         eat(TOKEN_STRING);
     }
-    else if (parser.current.type == TOKEN_CHAR) {
-        Token tok = parser.current;
+    else if (parser->current.type == TOKEN_CHAR) {
+        Token tok = parser->current;
         node = ast_node_new(NODE_CHAR, tok);
         if (!node) return NULL;
         uint32_t cp = 0;
-        if (!utf8_decode_one(parser.current.value, &cp)) {
-            error_report(parser.current, "حرف UTF-8 غير صالح.");
+        if (!utf8_decode_one(parser->current.value, &cp)) {
+            error_report(parser->current, "حرف UTF-8 غير صالح.");
             cp = (uint32_t)'?';
         }
         node->data.char_lit.value = (int)cp;
         eat(TOKEN_CHAR);
     }
-    else if (parser.current.type == TOKEN_TRUE) {
-        Token tok = parser.current;
+    else if (parser->current.type == TOKEN_TRUE) {
+        Token tok = parser->current;
         node = ast_node_new(NODE_BOOL, tok);
         if (!node) return NULL;
         node->data.bool_lit.value = true;
         eat(TOKEN_TRUE);
     }
-    else if (parser.current.type == TOKEN_FALSE) {
-        Token tok = parser.current;
+    else if (parser->current.type == TOKEN_FALSE) {
+        Token tok = parser->current;
         node = ast_node_new(NODE_BOOL, tok);
         if (!node) return NULL;
         node->data.bool_lit.value = false;
         eat(TOKEN_FALSE);
     }
-    else if (parser.current.type == TOKEN_KEYWORD_VOID) {
-        Token tok = parser.current;
+    else if (parser->current.type == TOKEN_KEYWORD_VOID) {
+        Token tok = parser->current;
         node = ast_node_new(NODE_NULL, tok);
         if (!node) return NULL;
         eat(TOKEN_KEYWORD_VOID);
     }
-    else if (parser.current.type == TOKEN_SIZEOF) {
-        Token tok = parser.current;
+    else if (parser->current.type == TOKEN_SIZEOF) {
+        Token tok = parser->current;
         eat(TOKEN_SIZEOF);
         eat(TOKEN_LPAREN);
 
@@ -89,21 +89,14 @@ Node* parse_primary() {
             int ptr_depth = 0;
             FuncPtrSig* fsig = NULL;
             if (!parse_type_spec(&dt, &tn, &ptr_base, &ptr_base_name, &ptr_depth, &fsig)) {
-                error_report(parser.current, "متوقع نوع أو تعبير داخل 'حجم(...)'.");
-                free(tn);
-                free(ptr_base_name);
+                error_report(parser->current, "متوقع نوع أو تعبير داخل 'حجم(...)'.");
             } else {
                 if (dt == TYPE_FUNC_PTR) {
-                    error_report(parser.current, "نوع 'حجم(دالة(...))' غير مدعوم حالياً.");
-                    free(tn);
-                    free(ptr_base_name);
-                    parser_funcsig_free(fsig);
+                    error_report(parser->current, "نوع 'حجم(دالة(...))' غير مدعوم حالياً.");
                 } else {
                     node->data.sizeof_expr.has_type_form = true;
                     node->data.sizeof_expr.target_type = dt;
                     node->data.sizeof_expr.target_type_name = tn;
-                    free(ptr_base_name);
-                    parser_funcsig_free(fsig);
                 }
             }
         } else {
@@ -114,13 +107,13 @@ Node* parse_primary() {
 
         eat(TOKEN_RPAREN);
     }
-    else if (parser.current.type == TOKEN_IDENTIFIER) {
-        Token tok_ident = parser.current;
-        char* name = strdup(parser.current.value);
+    else if (parser->current.type == TOKEN_IDENTIFIER) {
+        Token tok_ident = parser->current;
+        char* name = parser_strdup(parser->current.value);
         eat(TOKEN_IDENTIFIER);
 
         // استدعاء دالة: اسم(...)
-        if (parser.current.type == TOKEN_LPAREN) {
+        if (parser->current.type == TOKEN_LPAREN) {
             eat(TOKEN_LPAREN);
             Node* head_arg = NULL;
             Node* tail_arg = NULL;
@@ -128,13 +121,13 @@ Node* parse_primary() {
             bool is_variadic_next = (name && strcmp(name, "معامل_تالي") == 0);
 
             // تحليل الوسائط (مفصولة بفاصلة)
-            if (parser.current.type != TOKEN_RPAREN) {
+            if (parser->current.type != TOKEN_RPAREN) {
                 while (1) {
                     Node* arg = NULL;
 
                     // دعم خاص لـ معامل_تالي(قائمة، نوع): المعامل الثاني يقبل "نوع" مباشرةً.
                     if (is_variadic_next && arg_index == 1 && parser_current_starts_type()) {
-                        Token tok_type = parser.current;
+                        Token tok_type = parser->current;
                         DataType dt = TYPE_INT;
                         char* tn = NULL;
                         DataType ptr_base_type = TYPE_INT;
@@ -146,15 +139,10 @@ Node* parse_primary() {
                                              &ptr_base_type, &ptr_base_type_name,
                                              &ptr_depth,
                                              &func_sig)) {
-                            error_report(parser.current, "متوقع نوع كمعامل ثانٍ في 'معامل_تالي'.");
+                            error_report(parser->current, "متوقع نوع كمعامل ثانٍ في 'معامل_تالي'.");
                         } else {
                             arg = ast_node_new(NODE_SIZEOF, tok_type);
-                            if (!arg) {
-                                free(tn);
-                                free(ptr_base_type_name);
-                                parser_funcsig_free(func_sig);
-                                return NULL;
-                            }
+                            if (!arg) return NULL;
                             arg->data.sizeof_expr.has_type_form = true;
                             arg->data.sizeof_expr.target_type = dt;
                             arg->data.sizeof_expr.target_type_name = tn;
@@ -163,8 +151,6 @@ Node* parse_primary() {
                             arg->data.sizeof_expr.size_known = false;
                         }
 
-                        free(ptr_base_type_name);
-                        parser_funcsig_free(func_sig);
                     }
 
                     if (!arg) {
@@ -176,7 +162,7 @@ Node* parse_primary() {
                     else { tail_arg->next = arg; tail_arg = arg; }
                     arg_index++;
 
-                    if (parser.current.type == TOKEN_COMMA) eat(TOKEN_COMMA);
+                    if (parser->current.type == TOKEN_COMMA) eat(TOKEN_COMMA);
                     else break;
                 }
             }
@@ -188,7 +174,7 @@ Node* parse_primary() {
             node->data.call.args = head_arg;
         }
         // الوصول لمصفوفة: اسم[فهرس][فهرس]...
-        else if (parser.current.type == TOKEN_LBRACKET) {
+        else if (parser->current.type == TOKEN_LBRACKET) {
             int index_count = 0;
             Node* indices = parse_array_indices(&index_count);
 
@@ -206,32 +192,32 @@ Node* parse_primary() {
             node->data.var_ref.name = name;
         }
     }
-    else if (parser.current.type == TOKEN_LPAREN) {
+    else if (parser->current.type == TOKEN_LPAREN) {
         eat(TOKEN_LPAREN);
         node = parse_expression();
         eat(TOKEN_RPAREN);
     }
     else {
-        if (!parser.panic_mode) {
-            error_report_token_hint(parser.current,
+        if (!parser->panic_mode) {
+            error_report_token_hint(parser->current,
                                     "ابدأ التعبير بعدد أو معرّف أو '(' أو قيمة منطقية.",
                                     "متوقع تعبير.");
-            parser.panic_mode = true;
+            parser->panic_mode = true;
         }
         return NULL;
     }
 
     // الوصول للأعضاء/القيم المؤهلة: <expr>:<member> (يمكن تكراره للتعشيش)
-    while (node && parser.current.type == TOKEN_COLON) {
+    while (node && parser->current.type == TOKEN_COLON) {
         eat(TOKEN_COLON);
 
-        if (parser.current.type != TOKEN_IDENTIFIER) {
-            error_report(parser.current, "متوقع اسم عضو بعد ':'.");
+        if (parser->current.type != TOKEN_IDENTIFIER) {
+            error_report(parser->current, "متوقع اسم عضو بعد ':'.");
             break;
         }
 
-        Token tok_member = parser.current;
-        char* member = strdup(parser.current.value);
+        Token tok_member = parser->current;
+        char* member = parser_strdup(parser->current.value);
         eat(TOKEN_IDENTIFIER);
 
         Node* ma = ast_node_new(NODE_MEMBER_ACCESS, tok_member);
@@ -242,10 +228,10 @@ Node* parse_primary() {
     }
 
     // التحقق من العمليات اللاحقة (Postfix Operators: ++, --)
-    if (node && (parser.current.type == TOKEN_INC || parser.current.type == TOKEN_DEC)) {
-        Token tok_op = parser.current;
-        UnaryOpType op = (parser.current.type == TOKEN_INC) ? UOP_INC : UOP_DEC;
-        eat(parser.current.type);
+    if (node && (parser->current.type == TOKEN_INC || parser->current.type == TOKEN_DEC)) {
+        Token tok_op = parser->current;
+        UnaryOpType op = (parser->current.type == TOKEN_INC) ? UOP_INC : UOP_DEC;
+        eat(parser->current.type);
 
         Node* postfix = ast_node_new(NODE_POSTFIX_OP, tok_op);
         if (!postfix) return NULL;
@@ -259,8 +245,8 @@ Node* parse_primary() {
 
 // المستوى 1.5: العمليات الأحادية والبادئة (!, ~, -, ++, --)
 Node* parse_unary() {
-    if (parser.current.type == TOKEN_CAST) {
-        Token tok_cast = parser.current;
+    if (parser->current.type == TOKEN_CAST) {
+        Token tok_cast = parser->current;
         eat(TOKEN_CAST);
         eat(TOKEN_LT);
 
@@ -275,12 +261,10 @@ Node* parse_unary() {
                              &target_ptr_base_type, &target_ptr_base_type_name,
                              &target_ptr_depth,
                              &target_func_sig)) {
-            error_report(parser.current, "متوقع نوع صحيح داخل تحويل 'كـ<...>'.");
-            parser_funcsig_free(target_func_sig);
+            error_report(parser->current, "متوقع نوع صحيح داخل تحويل 'كـ<...>'.");
             target_func_sig = NULL;
         } else if (target_type == TYPE_FUNC_PTR) {
-            error_report(parser.current, "التحويل الصريح إلى/من مؤشر دالة غير مدعوم حالياً.");
-            parser_funcsig_free(target_func_sig);
+            error_report(parser->current, "التحويل الصريح إلى/من مؤشر دالة غير مدعوم حالياً.");
             target_func_sig = NULL;
         }
 
@@ -290,11 +274,7 @@ Node* parse_unary() {
         eat(TOKEN_RPAREN);
 
         Node* node = ast_node_new(NODE_CAST, tok_cast);
-        if (!node) {
-            free(target_type_name);
-            free(target_ptr_base_type_name);
-            return NULL;
-        }
+        if (!node) return NULL;
 
         node->data.cast_expr.target_type = target_type;
         node->data.cast_expr.target_type_name = target_type_name;
@@ -305,23 +285,23 @@ Node* parse_unary() {
         return node;
     }
 
-    if (parser.current.type == TOKEN_MINUS || parser.current.type == TOKEN_NOT ||
-        parser.current.type == TOKEN_TILDE || parser.current.type == TOKEN_AMP ||
-        parser.current.type == TOKEN_STAR ||
-        parser.current.type == TOKEN_INC || parser.current.type == TOKEN_DEC) {
+    if (parser->current.type == TOKEN_MINUS || parser->current.type == TOKEN_NOT ||
+        parser->current.type == TOKEN_TILDE || parser->current.type == TOKEN_AMP ||
+        parser->current.type == TOKEN_STAR ||
+        parser->current.type == TOKEN_INC || parser->current.type == TOKEN_DEC) {
 
-        Token tok_op = parser.current;
+        Token tok_op = parser->current;
         
         UnaryOpType op;
-        if (parser.current.type == TOKEN_MINUS) op = UOP_NEG;
-        else if (parser.current.type == TOKEN_NOT) op = UOP_NOT;
-        else if (parser.current.type == TOKEN_TILDE) op = UOP_BIT_NOT;
-        else if (parser.current.type == TOKEN_AMP) op = UOP_ADDR;
-        else if (parser.current.type == TOKEN_STAR) op = UOP_DEREF;
-        else if (parser.current.type == TOKEN_INC) op = UOP_INC;
+        if (parser->current.type == TOKEN_MINUS) op = UOP_NEG;
+        else if (parser->current.type == TOKEN_NOT) op = UOP_NOT;
+        else if (parser->current.type == TOKEN_TILDE) op = UOP_BIT_NOT;
+        else if (parser->current.type == TOKEN_AMP) op = UOP_ADDR;
+        else if (parser->current.type == TOKEN_STAR) op = UOP_DEREF;
+        else if (parser->current.type == TOKEN_INC) op = UOP_INC;
         else op = UOP_DEC;
 
-        eat(parser.current.type);
+        eat(parser->current.type);
         Node* operand = parse_unary();
         
         if (!operand) return NULL; // Error propagation
@@ -340,14 +320,14 @@ Node* parse_multiplicative() {
     Node* left = parse_unary();
     if (!left) return NULL;
 
-    while (parser.current.type == TOKEN_STAR || parser.current.type == TOKEN_SLASH || parser.current.type == TOKEN_PERCENT) {
-        Token tok_op = parser.current;
+    while (parser->current.type == TOKEN_STAR || parser->current.type == TOKEN_SLASH || parser->current.type == TOKEN_PERCENT) {
+        Token tok_op = parser->current;
         OpType op;
-        if (parser.current.type == TOKEN_STAR) op = OP_MUL;
-        else if (parser.current.type == TOKEN_SLASH) op = OP_DIV;
+        if (parser->current.type == TOKEN_STAR) op = OP_MUL;
+        else if (parser->current.type == TOKEN_SLASH) op = OP_DIV;
         else op = OP_MOD;
         
-        eat(parser.current.type);
+        eat(parser->current.type);
         Node* right = parse_unary();
         if (!right) return NULL;
 
@@ -371,7 +351,7 @@ Node* parse_multiplicative() {
                     result = parser_sign_extend_u32(ur);
                 } else if (op == OP_DIV) {
                     if (sb == 0) {
-                        error_report(parser.current, "قسمة على صفر.");
+                        error_report(parser->current, "قسمة على صفر.");
                         result = 0;
                     } else if (sa == INT32_MIN && sb == -1) {
                         // التفاف آمن (بدون UB)
@@ -381,7 +361,7 @@ Node* parse_multiplicative() {
                     }
                 } else if (op == OP_MOD) {
                     if (sb == 0) {
-                        error_report(parser.current, "باقي قسمة على صفر.");
+                        error_report(parser->current, "باقي قسمة على صفر.");
                         result = 0;
                     } else if (sa == INT32_MIN && sb == -1) {
                         result = 0;
@@ -398,7 +378,7 @@ Node* parse_multiplicative() {
                     result = (int64_t)(ua * ub);
                 } else if (op == OP_DIV) {
                     if (b == 0) {
-                        error_report(parser.current, "قسمة على صفر.");
+                        error_report(parser->current, "قسمة على صفر.");
                         result = 0;
                     } else if (a == INT64_MIN && b == -1) {
                         result = INT64_MIN;
@@ -407,7 +387,7 @@ Node* parse_multiplicative() {
                     }
                 } else if (op == OP_MOD) {
                     if (b == 0) {
-                        error_report(parser.current, "باقي قسمة على صفر.");
+                        error_report(parser->current, "باقي قسمة على صفر.");
                         result = 0;
                     } else if (a == INT64_MIN && b == -1) {
                         result = 0;
@@ -418,7 +398,6 @@ Node* parse_multiplicative() {
             }
 
             left->data.integer.value = result;
-            free(right);
             continue;
         }
 
@@ -437,10 +416,10 @@ Node* parse_additive() {
     Node* left = parse_multiplicative();
     if (!left) return NULL;
 
-    while (parser.current.type == TOKEN_PLUS || parser.current.type == TOKEN_MINUS) {
-        Token tok_op = parser.current;
-        OpType op = (parser.current.type == TOKEN_PLUS) ? OP_ADD : OP_SUB;
-        eat(parser.current.type);
+    while (parser->current.type == TOKEN_PLUS || parser->current.type == TOKEN_MINUS) {
+        Token tok_op = parser->current;
+        OpType op = (parser->current.type == TOKEN_PLUS) ? OP_ADD : OP_SUB;
+        eat(parser->current.type);
         Node* right = parse_multiplicative();
         if (!right) return NULL;
 
@@ -464,7 +443,6 @@ Node* parse_additive() {
             }
 
             left->data.integer.value = result;
-            free(right);
             continue;
         }
 
@@ -483,10 +461,10 @@ Node* parse_shift() {
     Node* left = parse_additive();
     if (!left) return NULL;
 
-    while (parser.current.type == TOKEN_SHL || parser.current.type == TOKEN_SHR) {
-        Token tok_op = parser.current;
-        OpType op = (parser.current.type == TOKEN_SHL) ? OP_SHL : OP_SHR;
-        eat(parser.current.type);
+    while (parser->current.type == TOKEN_SHL || parser->current.type == TOKEN_SHR) {
+        Token tok_op = parser->current;
+        OpType op = (parser->current.type == TOKEN_SHL) ? OP_SHL : OP_SHR;
+        eat(parser->current.type);
         Node* right = parse_additive();
         if (!right) return NULL;
 
@@ -506,15 +484,15 @@ Node* parse_relational() {
     Node* left = parse_shift();
     if (!left) return NULL;
 
-    while (parser.current.type == TOKEN_LT || parser.current.type == TOKEN_GT ||
-           parser.current.type == TOKEN_LTE || parser.current.type == TOKEN_GTE) {
-        Token tok_op = parser.current;
+    while (parser->current.type == TOKEN_LT || parser->current.type == TOKEN_GT ||
+           parser->current.type == TOKEN_LTE || parser->current.type == TOKEN_GTE) {
+        Token tok_op = parser->current;
         OpType op;
-        if (parser.current.type == TOKEN_LT) op = OP_LT;
-        else if (parser.current.type == TOKEN_GT) op = OP_GT;
-        else if (parser.current.type == TOKEN_LTE) op = OP_LTE;
+        if (parser->current.type == TOKEN_LT) op = OP_LT;
+        else if (parser->current.type == TOKEN_GT) op = OP_GT;
+        else if (parser->current.type == TOKEN_LTE) op = OP_LTE;
         else op = OP_GTE;
-        eat(parser.current.type);
+        eat(parser->current.type);
         Node* right = parse_shift();
         if (!right) return NULL;
 
@@ -533,10 +511,10 @@ Node* parse_equality() {
     Node* left = parse_relational();
     if (!left) return NULL;
 
-    while (parser.current.type == TOKEN_EQ || parser.current.type == TOKEN_NEQ) {
-        Token tok_op = parser.current;
-        OpType op = (parser.current.type == TOKEN_EQ) ? OP_EQ : OP_NEQ;
-        eat(parser.current.type);
+    while (parser->current.type == TOKEN_EQ || parser->current.type == TOKEN_NEQ) {
+        Token tok_op = parser->current;
+        OpType op = (parser->current.type == TOKEN_EQ) ? OP_EQ : OP_NEQ;
+        eat(parser->current.type);
         Node* right = parse_relational();
         if (!right) return NULL;
 
@@ -555,8 +533,8 @@ Node* parse_bitwise_and() {
     Node* left = parse_equality();
     if (!left) return NULL;
 
-    while (parser.current.type == TOKEN_AMP) {
-        Token tok_op = parser.current;
+    while (parser->current.type == TOKEN_AMP) {
+        Token tok_op = parser->current;
         eat(TOKEN_AMP);
         Node* right = parse_equality();
         if (!right) return NULL;
@@ -576,8 +554,8 @@ Node* parse_bitwise_xor() {
     Node* left = parse_bitwise_and();
     if (!left) return NULL;
 
-    while (parser.current.type == TOKEN_CARET) {
-        Token tok_op = parser.current;
+    while (parser->current.type == TOKEN_CARET) {
+        Token tok_op = parser->current;
         eat(TOKEN_CARET);
         Node* right = parse_bitwise_and();
         if (!right) return NULL;
@@ -597,8 +575,8 @@ Node* parse_bitwise_or() {
     Node* left = parse_bitwise_xor();
     if (!left) return NULL;
 
-    while (parser.current.type == TOKEN_PIPE) {
-        Token tok_op = parser.current;
+    while (parser->current.type == TOKEN_PIPE) {
+        Token tok_op = parser->current;
         eat(TOKEN_PIPE);
         Node* right = parse_bitwise_xor();
         if (!right) return NULL;
@@ -618,8 +596,8 @@ Node* parse_logical_and() {
     Node* left = parse_bitwise_or();
     if (!left) return NULL;
 
-    while (parser.current.type == TOKEN_AND) {
-        Token tok_op = parser.current;
+    while (parser->current.type == TOKEN_AND) {
+        Token tok_op = parser->current;
         eat(TOKEN_AND);
         Node* right = parse_bitwise_or();
         if (!right) return NULL;
@@ -639,8 +617,8 @@ Node* parse_logical_or() {
     Node* left = parse_logical_and();
     if (!left) return NULL;
 
-    while (parser.current.type == TOKEN_OR) {
-        Token tok_op = parser.current;
+    while (parser->current.type == TOKEN_OR) {
+        Token tok_op = parser->current;
         eat(TOKEN_OR);
         Node* right = parse_logical_and();
         if (!right) return NULL;
@@ -1,9 +1,9 @@
 ﻿Node* parse_case() {
-    Token tok_case = parser.current;
+    Token tok_case = parser->current;
     Node* node = ast_node_new(NODE_CASE, tok_case);
     if (!node) return NULL;
 
-    if (parser.current.type == TOKEN_DEFAULT) {
+    if (parser->current.type == TOKEN_DEFAULT) {
         eat(TOKEN_DEFAULT);
         eat(TOKEN_COLON);
         node->data.case_stmt.is_default = true;
@@ -11,23 +11,23 @@
     } else {
         eat(TOKEN_CASE);
         // قيمة case يجب أن تكون ثابتاً بسيطاً (رقم/حرف) ولا يجب أن تستهلك ':' كعامل وصول للأعضاء.
-        if (parser.current.type == TOKEN_INT) {
-            Token tok = parser.current;
+        if (parser->current.type == TOKEN_INT) {
+            Token tok = parser->current;
             Node* v = ast_node_new(NODE_INT, tok);
             if (!v) return NULL;
             int64_t n = 0;
-            (void)parse_int_token_checked(parser.current, &n);
+            (void)parse_int_token_checked(parser->current, &n);
             v->data.integer.value = n;
             eat(TOKEN_INT);
             node->data.case_stmt.value = v;
         }
-        else if (parser.current.type == TOKEN_CHAR) {
-            Token tok = parser.current;
+        else if (parser->current.type == TOKEN_CHAR) {
+            Token tok = parser->current;
             Node* v = ast_node_new(NODE_CHAR, tok);
             if (!v) return NULL;
             uint32_t cp = 0;
-            if (!utf8_decode_one(parser.current.value, &cp)) {
-                error_report(parser.current, "حرف UTF-8 غير صالح.");
+            if (!utf8_decode_one(parser->current.value, &cp)) {
+                error_report(parser->current, "حرف UTF-8 غير صالح.");
                 cp = (uint32_t)'?';
             }
             v->data.char_lit.value = (int)cp;
@@ -35,7 +35,7 @@
             node->data.case_stmt.value = v;
         }
         else {
-            error_report(parser.current, "متوقع ثابت عددي أو حرفي بعد 'حالة'.");
+            error_report(parser->current, "متوقع ثابت عددي أو حرفي بعد 'حالة'.");
             node->data.case_stmt.value = NULL;
         }
         eat(TOKEN_COLON);
@@ -45,10 +45,10 @@
     Node* head_stmt = NULL;
     Node* tail_stmt = NULL;
 
-    while (parser.current.type != TOKEN_CASE && 
-           parser.current.type != TOKEN_DEFAULT && 
-           parser.current.type != TOKEN_RBRACE && 
-           parser.current.type != TOKEN_EOF) {
+    while (parser->current.type != TOKEN_CASE && 
+           parser->current.type != TOKEN_DEFAULT && 
+           parser->current.type != TOKEN_RBRACE && 
+           parser->current.type != TOKEN_EOF) {
         
         Node* stmt = parse_statement();
         if (stmt) {
@@ -64,7 +64,7 @@
 }
 
 Node* parse_switch() {
-    Token tok_switch = parser.current;
+    Token tok_switch = parser->current;
     eat(TOKEN_SWITCH);
     eat(TOKEN_LPAREN);
     Node* expr = parse_expression();
@@ -74,13 +74,13 @@ Node* parse_switch() {
     Node* head_case = NULL;
     Node* tail_case = NULL;
 
-    while (parser.current.type != TOKEN_RBRACE && parser.current.type != TOKEN_EOF) {
-        if (parser.current.type == TOKEN_CASE || parser.current.type == TOKEN_DEFAULT) {
+    while (parser->current.type != TOKEN_RBRACE && parser->current.type != TOKEN_EOF) {
+        if (parser->current.type == TOKEN_CASE || parser->current.type == TOKEN_DEFAULT) {
             Node* case_node = parse_case();
             if (head_case == NULL) { head_case = case_node; tail_case = case_node; }
             else { tail_case->next = case_node; tail_case = case_node; }
         } else {
-            error_report(parser.current, "متوقع 'حالة' أو 'افتراضي' داخل 'اختر'.");
+            error_report(parser->current, "متوقع 'حالة' أو 'افتراضي' داخل 'اختر'.");
             synchronize_mode(PARSER_SYNC_SWITCH);
         }
     }
@@ -94,11 +94,11 @@ Node* parse_switch() {
 }
 
 Node* parse_block() {
-    Token tok_lbrace = parser.current;
+    Token tok_lbrace = parser->current;
     eat(TOKEN_LBRACE);
     Node* head = NULL;
     Node* tail = NULL;
-    while (parser.current.type != TOKEN_RBRACE && parser.current.type != TOKEN_EOF) {
+    while (parser->current.type != TOKEN_RBRACE && parser->current.type != TOKEN_EOF) {
         Node* stmt = parse_statement();
         if (stmt) {
             if (head == NULL) { head = stmt; tail = stmt; } 
@@ -130,14 +130,14 @@ static void parse_array_initializer_group(Node** head, Node** tail, int* count)
 {
     eat(TOKEN_LBRACE);
 
-    if (parser.current.type != TOKEN_RBRACE) {
+    if (parser->current.type != TOKEN_RBRACE) {
         while (1) {
             parse_array_initializer_item(head, tail, count);
 
-            if (parser.current.type == TOKEN_COMMA) {
+            if (parser->current.type == TOKEN_COMMA) {
                 eat(TOKEN_COMMA);
                 // السماح بفاصلة أخيرة قبل '}' كما في C.
-                if (parser.current.type == TOKEN_RBRACE) break;
+                if (parser->current.type == TOKEN_RBRACE) break;
                 continue;
             }
             break;
@@ -152,7 +152,7 @@ static void parse_array_initializer_group(Node** head, Node** tail, int* count)
  */
 static void parse_array_initializer_item(Node** head, Node** tail, int* count)
 {
-    if (parser.current.type == TOKEN_LBRACE) {
+    if (parser->current.type == TOKEN_LBRACE) {
         parse_array_initializer_group(head, tail, count);
         return;
     }
@@ -177,7 +177,7 @@ static Node* parse_array_initializer_list(int* out_count, bool* out_has_init) {
     if (out_count) *out_count = 0;
     if (out_has_init) *out_has_init = false;
 
-    if (parser.current.type != TOKEN_ASSIGN) {
+    if (parser->current.type != TOKEN_ASSIGN) {
         return NULL;
     }
 
@@ -188,8 +188,8 @@ static Node* parse_array_initializer_list(int* out_count, bool* out_has_init) {
     Node* tail = NULL;
     int count = 0;
 
-    if (parser.current.type != TOKEN_LBRACE) {
-        error_report(parser.current, "متوقع '{' بعد '=' في تهيئة المصفوفة.");
+    if (parser->current.type != TOKEN_LBRACE) {
+        error_report(parser->current, "متوقع '{' بعد '=' في تهيئة المصفوفة.");
         return NULL;
     }
 
@@ -210,22 +210,23 @@ static Node* parse_array_initializer_list(int* out_count, bool* out_has_init) {
 static Node* parse_type_alias_declaration(bool register_alias)
 {
     if (!parser_current_is_type_alias_keyword()) {
-        error_report(parser.current, "متوقع 'نوع' في بداية تعريف الاسم البديل.");
+        error_report(parser->current, "متوقع 'نوع' في بداية تعريف الاسم البديل.");
         synchronize_mode(PARSER_SYNC_DECLARATION);
         return NULL;
     }
 
-    Token tok_kw = parser.current;
-    eat(parser.current.type);
+    Token tok_kw = parser->current;
+    eat(parser->current.type);
 
-    if (parser.current.type != TOKEN_IDENTIFIER) {
-        error_report(parser.current, "متوقع اسم بعد 'نوع'.");
+    if (parser->current.type != TOKEN_IDENTIFIER) {
+        error_report(parser->current, "متوقع اسم بعد 'نوع'.");
         synchronize_mode(PARSER_SYNC_DECLARATION);
         return NULL;
     }
 
-    Token tok_name = parser.current;
-    char* alias_name = strdup(parser.current.value);
+    Token tok_name = parser->current;
+    char* alias_name = parser_strdup(parser->current.value);
+    const int alias_atom = parser->current.atom;
     eat(TOKEN_IDENTIFIER);
 
     if (!alias_name) {
@@ -246,11 +247,7 @@ static Node* parse_type_alias_declaration(bool register_alias)
                          &target_ptr_base_type, &target_ptr_base_type_name,
                          &target_ptr_depth,
                          &target_func_sig)) {
-        error_report(parser.current, "متوقع نوع معروف بعد '=' في تعريف الاسم البديل.");
-        free(alias_name);
-        free(target_type_name);
-        free(target_ptr_base_type_name);
-        parser_funcsig_free(target_func_sig);
+        error_report(parser->current, "متوقع نوع معروف بعد '=' في تعريف الاسم البديل.");
         synchronize_mode(PARSER_SYNC_DECLARATION);
         return NULL;
     }
@@ -258,12 +255,7 @@ static Node* parse_type_alias_declaration(bool register_alias)
     eat(TOKEN_DOT);
 
     Node* alias = ast_node_new(NODE_TYPE_ALIAS, tok_name);
-    if (!alias) {
-        free(alias_name);
-        free(target_type_name);
-        free(target_ptr_base_type_name);
-        return NULL;
-    }
+    if (!alias) return NULL;
 
     alias->data.type_alias.name = alias_name;
     alias->data.type_alias.target_type = target_type;
@@ -274,7 +266,7 @@ static Node* parse_type_alias_declaration(bool register_alias)
     alias->data.type_alias.target_func_sig = target_func_sig;
 
     if (register_alias) {
-        (void)parser_type_alias_register(tok_kw, alias_name,
+        (void)parser_type_alias_register(tok_kw, alias_name, alias_atom,
                                          target_type, target_type_name,
                                          target_ptr_base_type, target_ptr_base_type_name,
                                          target_ptr_depth,
@@ -285,13 +277,13 @@ static Node* parse_type_alias_declaration(bool register_alias)
 
 static Node* parse_inline_asm_operand(bool is_output)
 {
-    if (parser.current.type != TOKEN_STRING) {
-        error_report(parser.current, "متوقع قيداً نصياً في جملة 'مجمع'.");
+    if (parser->current.type != TOKEN_STRING) {
+        error_report(parser->current, "متوقع قيداً نصياً في جملة 'مجمع'.");
         return NULL;
     }
 
-    Token tok_constraint = parser.current;
-    char* constraint = parser.current.value ? strdup(parser.current.value) : strdup("");
+    Token tok_constraint = parser->current;
+    char* constraint = parser->current.value ? parser_strdup(parser->current.value) : parser_strdup("");
     eat(TOKEN_STRING);
 
     eat(TOKEN_LPAREN);
@@ -304,10 +296,7 @@ static Node* parse_inline_asm_operand(bool is_output)
     }
 
     Node* operand = ast_node_new(NODE_ASM_OPERAND, tok_constraint);
-    if (!operand) {
-        free(constraint);
-        return NULL;
-    }
+    if (!operand) return NULL;
     operand->data.asm_operand.constraint = constraint;
     operand->data.asm_operand.expression = expr;
     operand->data.asm_operand.is_output = is_output;
@@ -319,11 +308,11 @@ static Node* parse_inline_asm_operand_list(bool is_output)
     Node* head = NULL;
     Node* tail = NULL;
 
-    while (parser.current.type != TOKEN_COLON &&
-           parser.current.type != TOKEN_RBRACE &&
-           parser.current.type != TOKEN_EOF) {
-        if (parser.current.type != TOKEN_STRING) {
-            error_report(parser.current, "متوقع قيداً نصياً في معاملات 'مجمع'.");
+    while (parser->current.type != TOKEN_COLON &&
+           parser->current.type != TOKEN_RBRACE &&
+           parser->current.type != TOKEN_EOF) {
+        if (parser->current.type != TOKEN_STRING) {
+            error_report(parser->current, "متوقع قيداً نصياً في معاملات 'مجمع'.");
             break;
         }
 
@@ -331,7 +320,7 @@ static Node* parse_inline_asm_operand_list(bool is_output)
         if (!operand) break;
         parser_list_append(&head, &tail, operand);
 
-        if (parser.current.type == TOKEN_COMMA) {
+        if (parser->current.type == TOKEN_COMMA) {
             eat(TOKEN_COMMA);
             continue;
         }
@@ -343,17 +332,17 @@ static Node* parse_inline_asm_operand_list(bool is_output)
 
 static Node* parse_inline_asm_statement(void)
 {
-    Token tok_asm = parser.current;
+    Token tok_asm = parser->current;
     eat(TOKEN_ASM);
     eat(TOKEN_LBRACE);
 
     Node* templates = NULL;
     Node* templates_tail = NULL;
-    while (parser.current.type == TOKEN_STRING) {
-        Token tok_tpl = parser.current;
+    while (parser->current.type == TOKEN_STRING) {
+        Token tok_tpl = parser->current;
         Node* tpl = ast_node_new(NODE_STRING, tok_tpl);
         if (!tpl) return NULL;
-        tpl->data.string_lit.value = parser.current.value ? strdup(parser.current.value) : strdup("");
+        tpl->data.string_lit.value = parser->current.value ? parser_strdup(parser->current.value) : parser_strdup("");
         tpl->data.string_lit.id = -1;
         eat(TOKEN_STRING);
 
@@ -364,23 +353,23 @@ static Node* parse_inline_asm_statement(void)
 
         parser_list_append(&templates, &templates_tail, tpl);
 
-        if (parser.current.type == TOKEN_COMMA) {
+        if (parser->current.type == TOKEN_COMMA) {
             eat(TOKEN_COMMA);
         }
     }
 
     if (!templates) {
-        error_report(parser.current, "جملة 'مجمع' تتطلب سطر تجميع نصياً واحداً على الأقل.");
+        error_report(parser->current, "جملة 'مجمع' تتطلب سطر تجميع نصياً واحداً على الأقل.");
     }
 
     Node* outputs = NULL;
     Node* inputs = NULL;
 
-    if (parser.current.type == TOKEN_COLON) {
+    if (parser->current.type == TOKEN_COLON) {
         eat(TOKEN_COLON);
         outputs = parse_inline_asm_operand_list(true);
 
-        if (parser.current.type == TOKEN_COLON) {
+        if (parser->current.type == TOKEN_COLON) {
             eat(TOKEN_COLON);
             inputs = parse_inline_asm_operand_list(false);
         }
@@ -388,7 +377,7 @@ static Node* parse_inline_asm_statement(void)
 
     eat(TOKEN_RBRACE);
 
-    if (parser.current.type == TOKEN_DOT) {
+    if (parser->current.type == TOKEN_DOT) {
         eat(TOKEN_DOT);
     }
 
@@ -401,27 +390,27 @@ static Node* parse_inline_asm_statement(void)
 }
 
 Node* parse_statement() {
-    if (parser.current.type == TOKEN_LBRACE) return parse_block();
+    if (parser->current.type == TOKEN_LBRACE) return parse_block();
 
-    if (parser_current_is_type_alias_keyword() && parser.next.type == TOKEN_IDENTIFIER) {
-        error_report(parser.current, "تعريف 'نوع' مسموح فقط على المستوى العام.");
+    if (parser_current_is_type_alias_keyword() && parser->next.type == TOKEN_IDENTIFIER) {
+        error_report(parser->current, "تعريف 'نوع' مسموح فقط على المستوى العام.");
         return parse_type_alias_declaration(false);
     }
 
-    if (parser.current.type == TOKEN_SWITCH) {
+    if (parser->current.type == TOKEN_SWITCH) {
         return parse_switch();
     }
 
-    if (parser.current.type == TOKEN_ASM) {
+    if (parser->current.type == TOKEN_ASM) {
         return parse_inline_asm_statement();
     }
 
-    if (parser.current.type == TOKEN_RETURN) {
-        Token tok = parser.current;
+    if (parser->current.type == TOKEN_RETURN) {
+        Token tok = parser->current;
         eat(TOKEN_RETURN);
         Node* stmt = ast_node_new(NODE_RETURN, tok);
         if (!stmt) return NULL;
-        if (parser.current.type == TOKEN_DOT) {
+        if (parser->current.type == TOKEN_DOT) {
             stmt->data.return_stmt.expression = NULL;
         } else {
             stmt->data.return_stmt.expression = parse_expression();
@@ -430,24 +419,24 @@ Node* parse_statement() {
         return stmt;
     }
 
-    if (parser.current.type == TOKEN_BREAK) {
-        Token tok = parser.current;
+    if (parser->current.type == TOKEN_BREAK) {
+        Token tok = parser->current;
         eat(TOKEN_BREAK);
         eat(TOKEN_DOT);
         Node* stmt = ast_node_new(NODE_BREAK, tok);
         return stmt;
     }
 
-    if (parser.current.type == TOKEN_CONTINUE) {
-        Token tok = parser.current;
+    if (parser->current.type == TOKEN_CONTINUE) {
+        Token tok = parser->current;
         eat(TOKEN_CONTINUE);
         eat(TOKEN_DOT);
         Node* stmt = ast_node_new(NODE_CONTINUE, tok);
         return stmt;
     }
 
-    if (parser.current.type == TOKEN_PRINT) {
-        Token tok = parser.current;
+    if (parser->current.type == TOKEN_PRINT) {
+        Token tok = parser->current;
         eat(TOKEN_PRINT);
         Node* stmt = ast_node_new(NODE_PRINT, tok);
         if (!stmt) return NULL;
@@ -456,26 +445,26 @@ Node* parse_statement() {
         return stmt;
     }
 
-    if (parser.current.type == TOKEN_READ) {
-        Token tok = parser.current;
+    if (parser->current.type == TOKEN_READ) {
+        Token tok = parser->current;
         eat(TOKEN_READ);
 
-        if (parser.current.type != TOKEN_IDENTIFIER) {
-            error_report(parser.current, "متوقع اسم متغير بعد 'اقرأ'.");
+        if (parser->current.type != TOKEN_IDENTIFIER) {
+            error_report(parser->current, "متوقع اسم متغير بعد 'اقرأ'.");
             return NULL;
         }
 
         Node* stmt = ast_node_new(NODE_READ, tok);
         if (!stmt) return NULL;
 
-        stmt->data.read_stmt.var_name = strdup(parser.current.value);
+        stmt->data.read_stmt.var_name = parser_strdup(parser->current.value);
         eat(TOKEN_IDENTIFIER);
         eat(TOKEN_DOT);
         return stmt;
     }
 
-    if (parser.current.type == TOKEN_IF) {
-        Token tok = parser.current;
+    if (parser->current.type == TOKEN_IF) {
+        Token tok = parser->current;
         eat(TOKEN_IF);
         eat(TOKEN_LPAREN);
         Node* cond = parse_expression();
@@ -483,7 +472,7 @@ Node* parse_statement() {
         Node* then_branch = parse_statement();
 
         Node* else_branch = NULL;
-        if (parser.current.type == TOKEN_ELSE) {
+        if (parser->current.type == TOKEN_ELSE) {
             eat(TOKEN_ELSE);
             else_branch = parse_statement();
         }
@@ -496,8 +485,8 @@ Node* parse_statement() {
         return stmt;
     }
 
-    if (parser.current.type == TOKEN_WHILE) {
-        Token tok = parser.current;
+    if (parser->current.type == TOKEN_WHILE) {
+        Token tok = parser->current;
         eat(TOKEN_WHILE);
         eat(TOKEN_LPAREN);
         Node* cond = parse_expression();
@@ -511,13 +500,13 @@ Node* parse_statement() {
         return stmt;
     }
 
-    if (parser.current.type == TOKEN_FOR) {
-        Token tok_for = parser.current;
+    if (parser->current.type == TOKEN_FOR) {
+        Token tok_for = parser->current;
         eat(TOKEN_FOR);
         eat(TOKEN_LPAREN);
 
         Node* init = NULL;
-        if (parser_is_decl_qualifier(parser.current.type) || parser_current_starts_type()) {
+        if (parser_is_decl_qualifier(parser->current.type) || parser_current_starts_type()) {
             ParserDeclQualifiers init_q;
             parser_parse_decl_qualifiers(&init_q);
             if (init_q.is_extern) {
@@ -526,12 +515,12 @@ Node* parse_statement() {
             }
 
             if (!parser_current_starts_type()) {
-                error_report(parser.current, "متوقع نوع في تهيئة حلقة 'لكل'.");
+                error_report(parser->current, "متوقع نوع في تهيئة حلقة 'لكل'.");
                 synchronize_mode(PARSER_SYNC_STATEMENT);
                 return NULL;
             }
 
-            Token tok_type = parser.current;
+            Token tok_type = parser->current;
             DataType dt = TYPE_INT;
             char* type_name = NULL;
             DataType ptr_base_type = TYPE_INT;
@@ -544,49 +533,41 @@ Node* parse_statement() {
                                  &ptr_base_type, &ptr_base_type_name,
                                  &ptr_depth,
                                  &func_sig)) {
-                error_report(parser.current, "متوقع نوع في تهيئة حلقة 'لكل'.");
+                error_report(parser->current, "متوقع نوع في تهيئة حلقة 'لكل'.");
                 synchronize_mode(PARSER_SYNC_STATEMENT);
                 return NULL;
             }
 
             if (dt == TYPE_STRUCT || dt == TYPE_UNION) {
-                error_report(parser.current, "تعريف الهيكل داخل تهيئة 'لكل' غير مدعوم حالياً.");
+                error_report(parser->current, "تعريف الهيكل داخل تهيئة 'لكل' غير مدعوم حالياً.");
             }
 
-            Token tok_name = parser.current;
-            if (parser.current.type != TOKEN_IDENTIFIER) {
-                error_report(parser.current, "متوقع اسم معرّف في تهيئة حلقة 'لكل'.");
-                free(type_name);
-                free(ptr_base_type_name);
-                parser_funcsig_free(func_sig);
+            Token tok_name = parser->current;
+            if (parser->current.type != TOKEN_IDENTIFIER) {
+                error_report(parser->current, "متوقع اسم معرّف في تهيئة حلقة 'لكل'.");
                 synchronize_mode(PARSER_SYNC_STATEMENT);
                 return NULL;
             }
-            char* name = strdup(parser.current.value);
+            char* name = parser_strdup(parser->current.value);
             eat(TOKEN_IDENTIFIER);
 
-            if (init_q.is_const && !init_q.is_static && parser.current.type != TOKEN_ASSIGN) {
-                error_report(parser.current, "الثابت يجب تهيئته.");
+            if (init_q.is_const && !init_q.is_static && parser->current.type != TOKEN_ASSIGN) {
+                error_report(parser->current, "الثابت يجب تهيئته.");
             }
 
             Node* expr = NULL;
-            if (parser.current.type == TOKEN_ASSIGN) {
+            if (parser->current.type == TOKEN_ASSIGN) {
                 eat(TOKEN_ASSIGN);
                 expr = parse_expression();
             } else if (!init_q.is_static) {
-                error_report(parser.current, "متوقع '=' في تهيئة حلقة 'لكل'.");
+                error_report(parser->current, "متوقع '=' في تهيئة حلقة 'لكل'.");
                 eat(TOKEN_ASSIGN);
                 expr = parse_expression();
             }
             eat(TOKEN_SEMICOLON);
 
             init = ast_node_new(NODE_VAR_DECL, tok_name);
-            if (!init) {
-                free(type_name);
-                free(ptr_base_type_name);
-                parser_funcsig_free(func_sig);
-                return NULL;
-            }
+            if (!init) return NULL;
             init->data.var_decl.name = name;
             init->data.var_decl.type = dt;
             init->data.var_decl.type_name = type_name;
@@ -599,9 +580,9 @@ Node* parse_statement() {
             init->data.var_decl.is_const = init_q.is_const;
             init->data.var_decl.is_static = init_q.is_static;
         } else {
-            if (parser.current.type == TOKEN_IDENTIFIER && parser.next.type == TOKEN_ASSIGN) {
-                Token tok_name = parser.current;
-                char* name = strdup(parser.current.value);
+            if (parser->current.type == TOKEN_IDENTIFIER && parser->next.type == TOKEN_ASSIGN) {
+                Token tok_name = parser->current;
+                char* name = parser_strdup(parser->current.value);
                 eat(TOKEN_IDENTIFIER);
                 eat(TOKEN_ASSIGN);
                 Node* expr = parse_expression();
@@ -612,7 +593,7 @@ Node* parse_statement() {
                 init->data.assign_stmt.name = name;
                 init->data.assign_stmt.expression = expr;
             } else {
-                if (parser.current.type != TOKEN_SEMICOLON) {
+                if (parser->current.type != TOKEN_SEMICOLON) {
                     init = parse_expression();
                 }
                 eat(TOKEN_SEMICOLON);
@@ -620,15 +601,15 @@ Node* parse_statement() {
         }
 
         Node* cond = NULL;
-        if (parser.current.type != TOKEN_SEMICOLON) {
+        if (parser->current.type != TOKEN_SEMICOLON) {
             cond = parse_expression();
         }
         eat(TOKEN_SEMICOLON);
 
         Node* incr = NULL;
-        if (parser.current.type == TOKEN_IDENTIFIER && parser.next.type == TOKEN_ASSIGN) {
-            Token tok_name = parser.current;
-            char* name = strdup(parser.current.value);
+        if (parser->current.type == TOKEN_IDENTIFIER && parser->next.type == TOKEN_ASSIGN) {
+            Token tok_name = parser->current;
+            char* name = parser_strdup(parser->current.value);
             eat(TOKEN_IDENTIFIER);
             eat(TOKEN_ASSIGN);
             Node* expr = parse_expression();
@@ -654,24 +635,24 @@ Node* parse_statement() {
     }
 
     ParserDeclQualifiers decl_q;
-    bool has_decl_qual = parser_is_decl_qualifier(parser.current.type);
+    bool has_decl_qual = parser_is_decl_qualifier(parser->current.type);
     if (has_decl_qual) {
         parser_parse_decl_qualifiers(&decl_q);
     } else {
         memset(&decl_q, 0, sizeof(decl_q));
     }
 
-    if (parser_current_is_type_alias_keyword() && parser.next.type == TOKEN_IDENTIFIER) {
+    if (parser_current_is_type_alias_keyword() && parser->next.type == TOKEN_IDENTIFIER) {
         if (decl_q.is_const || decl_q.is_static || decl_q.is_extern) {
-            error_report(parser.current, "تعريف اسم النوع البديل لا يقبل 'ثابت' أو 'ساكن' أو 'خارجي'.");
+            error_report(parser->current, "تعريف اسم النوع البديل لا يقبل 'ثابت' أو 'ساكن' أو 'خارجي'.");
         }
-        error_report(parser.current, "تعريف 'نوع' مسموح فقط على المستوى العام.");
+        error_report(parser->current, "تعريف 'نوع' مسموح فقط على المستوى العام.");
         return parse_type_alias_declaration(false);
     }
 
     if (has_decl_qual || parser_current_starts_type()) {
         if (!parser_current_starts_type()) {
-            error_report(parser.current, "متوقع نوع بعد واصفات التعريف.");
+            error_report(parser->current, "متوقع نوع بعد واصفات التعريف.");
             synchronize_mode(PARSER_SYNC_STATEMENT);
             return NULL;
         }
@@ -682,7 +663,7 @@ Node* parse_statement() {
             error_report(decl_q.tok_extern,
                          "الواصف 'خارجي' مسموح فقط في التصريحات العامة.");
         }
-        Token tok_type = parser.current;
+        Token tok_type = parser->current;
         DataType dt = TYPE_INT;
         char* type_name = NULL;
         DataType ptr_base_type = TYPE_INT;
@@ -695,34 +676,27 @@ Node* parse_statement() {
                              &ptr_base_type, &ptr_base_type_name,
                              &ptr_depth,
                              &func_sig)) {
-            error_report(parser.current, "متوقع نوع.");
+            error_report(parser->current, "متوقع نوع.");
             synchronize_mode(PARSER_SYNC_STATEMENT);
             return NULL;
         }
 
-        Token tok_name = parser.current;
-        if (parser.current.type != TOKEN_IDENTIFIER) {
-            error_report(parser.current, "متوقع اسم معرّف بعد النوع.");
-            free(type_name);
-            free(ptr_base_type_name);
-            parser_funcsig_free(func_sig);
+        Token tok_name = parser->current;
+        if (parser->current.type != TOKEN_IDENTIFIER) {
+            error_report(parser->current, "متوقع اسم معرّف بعد النوع.");
             synchronize_mode(PARSER_SYNC_STATEMENT);
             return NULL;
         }
-        char* name = strdup(parser.current.value);
+        char* name = parser_strdup(parser->current.value);
         eat(TOKEN_IDENTIFIER);
 
         if (dt == TYPE_VOID) {
             error_report(tok_type, "لا يمكن تعريف متغير من نوع 'عدم'.");
         }
 
-        if (parser.current.type == TOKEN_LBRACKET) {
+        if (parser->current.type == TOKEN_LBRACKET) {
             if (dt == TYPE_FUNC_PTR) {
-                error_report(parser.current, "مصفوفات من نوع مؤشر دالة غير مدعومة بعد.");
-                free(type_name);
-                free(ptr_base_type_name);
-                parser_funcsig_free(func_sig);
-                free(name);
+                error_report(parser->current, "مصفوفات من نوع مؤشر دالة غير مدعومة بعد.");
                 synchronize_mode(PARSER_SYNC_STATEMENT);
                 return NULL;
             }
@@ -730,10 +704,6 @@ Node* parse_statement() {
             int dim_count = 0;
             int64_t total_elems = 0;
             if (!parse_array_dimensions(&dims, &dim_count, &total_elems)) {
-                free(type_name);
-                free(ptr_base_type_name);
-                parser_funcsig_free(func_sig);
-                free(name);
                 synchronize_mode(PARSER_SYNC_STATEMENT);
                 return NULL;
             }
@@ -745,13 +715,7 @@ Node* parse_statement() {
             eat(TOKEN_DOT);
 
             Node* stmt = ast_node_new(NODE_ARRAY_DECL, tok_name);
-            if (!stmt) {
-                free(dims);
-                free(type_name);
-                free(name);
-                parser_funcsig_free(func_sig);
-                return NULL;
-            }
+            if (!stmt) return NULL;
             stmt->data.array_decl.name = name;
             stmt->data.array_decl.element_type = dt;
             stmt->data.array_decl.element_type_name = type_name;
@@ -769,7 +733,6 @@ Node* parse_statement() {
             stmt->data.array_decl.has_init = has_init;
             stmt->data.array_decl.init_values = init_vals;
             stmt->data.array_decl.init_count = init_count;
-            parser_funcsig_free(func_sig);
             return stmt;
         }
 
@@ -785,7 +748,7 @@ Node* parse_statement() {
             eat(TOKEN_DOT);
 
             Node* stmt = ast_node_new(NODE_VAR_DECL, tok_name);
-            if (!stmt) { free(type_name); return NULL; }
+            if (!stmt) return NULL;
             stmt->data.var_decl.name = name;
             stmt->data.var_decl.type = dt;
             stmt->data.var_decl.type_name = type_name;
@@ -802,12 +765,12 @@ Node* parse_statement() {
             return stmt;
         }
 
-        if (is_const && !is_static && parser.current.type != TOKEN_ASSIGN) {
-            error_report(parser.current, "الثابت يجب تهيئته.");
+        if (is_const && !is_static && parser->current.type != TOKEN_ASSIGN) {
+            error_report(parser->current, "الثابت يجب تهيئته.");
         }
 
         Node* expr = NULL;
-        if (parser.current.type == TOKEN_ASSIGN) {
+        if (parser->current.type == TOKEN_ASSIGN) {
             eat(TOKEN_ASSIGN);
             expr = parse_expression();
         } else if (!is_static) {
@@ -817,7 +780,7 @@ Node* parse_statement() {
         eat(TOKEN_DOT);
 
         Node* stmt = ast_node_new(NODE_VAR_DECL, tok_name);
-        if (!stmt) { free(type_name); return NULL; }
+        if (!stmt) return NULL;
         stmt->data.var_decl.name = name;
         stmt->data.var_decl.type = dt;
         stmt->data.var_decl.type_name = type_name;
@@ -834,11 +797,11 @@ Node* parse_statement() {
         return stmt;
     }
 
-    if (parser.current.type == TOKEN_STAR) {
-        Token tok_star = parser.current;
+    if (parser->current.type == TOKEN_STAR) {
+        Token tok_star = parser->current;
         Node* target = parse_unary();
         if (target && target->type == NODE_UNARY_OP && target->data.unary_op.op == UOP_DEREF &&
-            parser.current.type == TOKEN_ASSIGN) {
+            parser->current.type == TOKEN_ASSIGN) {
             eat(TOKEN_ASSIGN);
             Node* value = parse_expression();
             eat(TOKEN_DOT);
@@ -854,11 +817,11 @@ Node* parse_statement() {
         return target;
     }
 
-    if (parser.current.type == TOKEN_IDENTIFIER) {
-        Token tok_name = parser.current;
+    if (parser->current.type == TOKEN_IDENTIFIER) {
+        Token tok_name = parser->current;
 
         // إسناد إلى عضو: س:حقل = ... .
-        if (parser.next.type == TOKEN_COLON) {
+        if (parser->next.type == TOKEN_COLON) {
             Node* target = parse_expression();
             eat(TOKEN_ASSIGN);
             Node* value = parse_expression();
@@ -871,14 +834,14 @@ Node* parse_statement() {
             return stmt;
         }
 
-        if (parser.next.type == TOKEN_LBRACKET) {
-            char* name = strdup(parser.current.value);
+        if (parser->next.type == TOKEN_LBRACKET) {
+            char* name = parser_strdup(parser->current.value);
             eat(TOKEN_IDENTIFIER);
             int index_count = 0;
             Node* indices = parse_array_indices(&index_count);
 
             // إسناد إلى عضو عنصر مصفوفة: س[0]:حقل = ...
-            if (parser.current.type == TOKEN_COLON) {
+            if (parser->current.type == TOKEN_COLON) {
                 Node* target = ast_node_new(NODE_ARRAY_ACCESS, tok_name);
                 if (!target) return NULL;
                 target->data.array_op.name = name;
@@ -886,14 +849,14 @@ Node* parse_statement() {
                 target->data.array_op.index_count = index_count;
                 target->data.array_op.value = NULL;
 
-                while (parser.current.type == TOKEN_COLON) {
-                    Token tok_colon = parser.current;
+                while (parser->current.type == TOKEN_COLON) {
+                    Token tok_colon = parser->current;
                     eat(TOKEN_COLON);
-                    if (parser.current.type != TOKEN_IDENTIFIER) {
-                        error_report(parser.current, "متوقع اسم عضو بعد ':'.");
+                    if (parser->current.type != TOKEN_IDENTIFIER) {
+                        error_report(parser->current, "متوقع اسم عضو بعد ':'.");
                         break;
                     }
-                    char* member = strdup(parser.current.value);
+                    char* member = parser_strdup(parser->current.value);
                     eat(TOKEN_IDENTIFIER);
 
                     Node* ma = ast_node_new(NODE_MEMBER_ACCESS, tok_colon);
@@ -914,7 +877,7 @@ Node* parse_statement() {
                 return stmt;
             }
 
-            if (parser.current.type == TOKEN_ASSIGN) {
+            if (parser->current.type == TOKEN_ASSIGN) {
                 eat(TOKEN_ASSIGN);
                 Node* value = parse_expression();
                 eat(TOKEN_DOT);
@@ -926,7 +889,7 @@ Node* parse_statement() {
                 stmt->data.array_op.index_count = index_count;
                 stmt->data.array_op.value = value;
                 return stmt;
-            } else if (parser.current.type == TOKEN_INC || parser.current.type == TOKEN_DEC) {
+            } else if (parser->current.type == TOKEN_INC || parser->current.type == TOKEN_DEC) {
                 // array[index]++.
                 Node* access = ast_node_new(NODE_ARRAY_ACCESS, tok_name);
                 if (!access) return NULL;
@@ -935,9 +898,9 @@ Node* parse_statement() {
                 access->data.array_op.index_count = index_count;
                 access->data.array_op.value = NULL;
 
-                Token tok_op = parser.current;
-                UnaryOpType op = (parser.current.type == TOKEN_INC) ? UOP_INC : UOP_DEC;
-                eat(parser.current.type);
+                Token tok_op = parser->current;
+                UnaryOpType op = (parser->current.type == TOKEN_INC) ? UOP_INC : UOP_DEC;
+                eat(parser->current.type);
                 eat(TOKEN_DOT);
 
                 Node* stmt = ast_node_new(NODE_POSTFIX_OP, tok_op);
@@ -946,8 +909,8 @@ Node* parse_statement() {
                 stmt->data.unary_op.op = op;
                 return stmt;
             }
-        } else if (parser.next.type == TOKEN_ASSIGN) {
-            char* name = strdup(parser.current.value);
+        } else if (parser->next.type == TOKEN_ASSIGN) {
+            char* name = parser_strdup(parser->current.value);
             eat(TOKEN_IDENTIFIER);
             eat(TOKEN_ASSIGN);
             Node* expr = parse_expression();
@@ -958,7 +921,7 @@ Node* parse_statement() {
             stmt->data.assign_stmt.name = name;
             stmt->data.assign_stmt.expression = expr;
             return stmt;
-        } else if (parser.next.type == TOKEN_LPAREN) {
+        } else if (parser->next.type == TOKEN_LPAREN) {
             Node* expr = parse_expression();
             eat(TOKEN_DOT);
 
@@ -966,24 +929,23 @@ Node* parse_statement() {
             if (!stmt) return NULL;
             stmt->data.call.name = expr->data.call.name;
             stmt->data.call.args = expr->data.call.args;
-            free(expr);
             return stmt;
-        } else if (parser.next.type == TOKEN_INC || parser.next.type == TOKEN_DEC) {
+        } else if (parser->next.type == TOKEN_INC || parser->next.type == TOKEN_DEC) {
             Node* expr = parse_expression();
             eat(TOKEN_DOT);
             return expr;
         }
     }
 
-    if (!parser.panic_mode) {
-        error_report_token_hint(parser.current,
+    if (!parser->panic_mode) {
+        error_report_token_hint(parser->current,
                                 "ابدأ الجملة بتعريف، إسناد، نداء، شرط، حلقة، أو 'إرجع'.",
                                 "وحدة أو جملة غير متوقعة.");
-        parser.panic_mode = true;
+        parser->panic_mode = true;
     }
     // المعرّف غير المطابق لأي شكل جملة هو مرساة مزامنة بحد ذاته؛ تقدّم هنا
     // حتى لا يعيد parse_block تحليل الرمز نفسه إلى ما لا نهاية.
-    if (parser.current.type == TOKEN_IDENTIFIER) {
+    if (parser->current.type == TOKEN_IDENTIFIER) {
         advance();
     }
     return NULL;
@@ -1,14 +1,12 @@
 ﻿static bool parser_current_starts_type(void)
 {
-    if (is_type_keyword(parser.current.type)) return true;
-    if (parser.current.type == TOKEN_IDENTIFIER &&
-        parser.current.value &&
-        strcmp(parser.current.value, "دالة") == 0) {
+    if (is_type_keyword(parser->current.type)) return true;
+    if (parser->current.type == TOKEN_IDENTIFIER &&
+        parser->current.atom == parser->atom_func_kw) {
         return true;
     }
-    if (parser.current.type == TOKEN_IDENTIFIER &&
-        parser.current.value &&
-        parser_type_alias_lookup(parser.current.value)) {
+    if (parser->current.type == TOKEN_IDENTIFIER &&
+        parser_type_alias_lookup(parser->current.atom)) {
         return true;
     }
     return false;
@@ -16,10 +14,9 @@
 
 static bool parser_current_is_type_alias_keyword(void)
 {
-    if (parser.current.type == TOKEN_TYPE_ALIAS) return true;
-    return parser.current.type == TOKEN_IDENTIFIER &&
-           parser.current.value &&
-           strcmp(parser.current.value, "نوع") == 0;
+    if (parser->current.type == TOKEN_TYPE_ALIAS) return true;
+    return parser->current.type == TOKEN_IDENTIFIER &&
+           parser->current.atom == parser->atom_type_alias_kw;
 }
 
 static bool parser_is_decl_qualifier(BaaTokenType type)
@@ -42,35 +39,35 @@ static void parser_parse_decl_qualifiers(ParserDeclQualifiers* out_q)
 
     memset(out_q, 0, sizeof(*out_q));
 
-    while (parser_is_decl_qualifier(parser.current.type)) {
-        if (parser.current.type == TOKEN_CONST) {
+    while (parser_is_decl_qualifier(parser->current.type)) {
+        if (parser->current.type == TOKEN_CONST) {
             if (out_q->is_const) {
-                error_report(parser.current, "تكرار 'ثابت' غير مسموح.");
+                error_report(parser->current, "تكرار 'ثابت' غير مسموح.");
             } else {
                 out_q->is_const = true;
-                out_q->tok_const = parser.current;
+                out_q->tok_const = parser->current;
             }
             eat(TOKEN_CONST);
             continue;
         }
 
-        if (parser.current.type == TOKEN_STATIC) {
+        if (parser->current.type == TOKEN_STATIC) {
             if (out_q->is_static) {
-                error_report(parser.current, "تكرار 'ساكن' غير مسموح.");
+                error_report(parser->current, "تكرار 'ساكن' غير مسموح.");
             } else {
                 out_q->is_static = true;
-                out_q->tok_static = parser.current;
+                out_q->tok_static = parser->current;
             }
             eat(TOKEN_STATIC);
             continue;
         }
 
-        if (parser.current.type == TOKEN_EXTERN) {
+        if (parser->current.type == TOKEN_EXTERN) {
             if (out_q->is_extern) {
-                error_report(parser.current, "تكرار 'خارجي' غير مسموح.");
+                error_report(parser->current, "تكرار 'خارجي' غير مسموح.");
             } else {
                 out_q->is_extern = true;
-                out_q->tok_extern = parser.current;
+                out_q->tok_extern = parser->current;
             }
             eat(TOKEN_EXTERN);
             continue;
@@ -191,16 +188,15 @@ static bool parse_type_spec_ex(DataType* out_type, char** out_type_name,
     // نوع مؤشر دالة: دالة(…)->…
     // --------------------------------------------------------------------
     if (allow_func_ptr &&
-        parser.current.type == TOKEN_IDENTIFIER &&
-        parser.current.value &&
-        strcmp(parser.current.value, "دالة") == 0)
+        parser->current.type == TOKEN_IDENTIFIER &&
+        parser->current.atom == parser->atom_func_kw)
     {
-        Token tok_kw = parser.current;
+        Token tok_kw = parser->current;
         eat(TOKEN_IDENTIFIER); // دالة
 
         eat(TOKEN_LPAREN);
 
-        // جمع معاملات التوقيع
+        // جمع معاملات التوقيع (المصفوفات من ساحة AST؛ مسارات الخطأ لا تحرر شيئاً)
         int cap = 0;
         int cnt = 0;
         bool is_variadic = false;
@@ -209,17 +205,12 @@ static bool parse_type_spec_ex(DataType* out_type, char** out_type_name,
         char** p_ptr_base_names = NULL;
         int* p_ptr_depths = NULL;
 
-        if (parser.current.type != TOKEN_RPAREN) {
+        if (parser->current.type != TOKEN_RPAREN) {
             while (1) {
-                if (parser.current.type == TOKEN_ELLIPSIS) {
+                if (parser->current.type == TOKEN_ELLIPSIS) {
                     if (cnt <= 0) {
-                        error_report(parser.current, "غير مدعوم: '...' يتطلب وجود معامل ثابت واحد على الأقل.");
+                        error_report(parser->current, "غير مدعوم: '...' يتطلب وجود معامل ثابت واحد على الأقل.");
                         synchronize_mode(PARSER_SYNC_DECLARATION);
-                        for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-                        free(p_types);
-                        free(p_ptr_base_types);
-                        free(p_ptr_base_names);
-                        free(p_ptr_depths);
                         return false;
                     }
                     is_variadic = true;
@@ -227,133 +218,54 @@ static bool parse_type_spec_ex(DataType* out_type, char** out_type_name,
                     break;
                 }
 
-                Token tok_pt = parser.current;
+                Token tok_pt = parser->current;
                 DataType pdt = TYPE_INT;
-                char* ptn = NULL;
                 DataType pptr_base = TYPE_INT;
                 char* pptr_base_name = NULL;
                 int pptr_depth = 0;
-                FuncPtrSig* pfs = NULL;
 
-                if (!parse_type_spec_ex(&pdt, &ptn, &pptr_base, &pptr_base_name, &pptr_depth, &pfs, false)) {
-                    error_report(parser.current, "متوقع نوع لمعامل توقيع 'دالة(...)'.");
-                    free(ptn);
-                    free(pptr_base_name);
+                if (!parse_type_spec_ex(&pdt, NULL, &pptr_base, &pptr_base_name, &pptr_depth, NULL, false)) {
+                    error_report(parser->current, "متوقع نوع لمعامل توقيع 'دالة(...)'.");
                     synchronize_mode(PARSER_SYNC_DECLARATION);
-                    for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-                    free(p_types);
-                    free(p_ptr_base_types);
-                    free(p_ptr_base_names);
-                    free(p_ptr_depths);
                     return false;
                 }
 
-                if (pfs) {
-                    parser_funcsig_free(pfs);
-                    pfs = NULL;
-                }
-
                 if (pdt == TYPE_VOID) {
                     error_report(tok_pt, "لا يمكن استخدام 'عدم' كنوع معامل في توقيع مؤشر دالة.");
-                    free(ptn);
-                    free(pptr_base_name);
                     synchronize_mode(PARSER_SYNC_DECLARATION);
-                    for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-                    free(p_types);
-                    free(p_ptr_base_types);
-                    free(p_ptr_base_names);
-                    free(p_ptr_depths);
                     return false;
                 }
                 if (pdt == TYPE_ENUM || pdt == TYPE_STRUCT || pdt == TYPE_UNION) {
                     error_report(tok_pt, "أنواع المعاملات المعرفة من المستخدم غير مدعومة بعد في تواقيع مؤشرات الدوال.");
-                    free(ptn);
-                    free(pptr_base_name);
                     synchronize_mode(PARSER_SYNC_DECLARATION);
-                    for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-                    free(p_types);
-                    free(p_ptr_base_types);
-                    free(p_ptr_base_names);
-                    free(p_ptr_depths);
                     return false;
                 }
 
                 if (cnt >= cap) {
                     int new_cap = (cap == 0) ? 4 : (cap * 2);
-                    DataType* nt = (DataType*)realloc(p_types, (size_t)new_cap * sizeof(DataType));
-                    if (!nt) {
-                        error_report(tok_kw, "نفدت الذاكرة أثناء توسيع توقيع مؤشر الدالة.");
-                        synchronize_mode(PARSER_SYNC_DECLARATION);
-                        for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-                        free(p_types);
-                        free(p_ptr_base_types);
-                        free(p_ptr_base_names);
-                        free(p_ptr_depths);
-                        free(ptn);
-                        free(pptr_base_name);
-                        return false;
-                    }
-                    p_types = nt;
-
-                    DataType* nb = (DataType*)realloc(p_ptr_base_types, (size_t)new_cap * sizeof(DataType));
-                    if (!nb) {
-                        error_report(tok_kw, "نفدت الذاكرة أثناء توسيع توقيع مؤشر الدالة.");
-                        synchronize_mode(PARSER_SYNC_DECLARATION);
-                        for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-                        free(p_types);
-                        free(p_ptr_base_types);
-                        free(p_ptr_base_names);
-                        free(p_ptr_depths);
-                        free(ptn);
-                        free(pptr_base_name);
-                        return false;
-                    }
-                    p_ptr_base_types = nb;
-
-                    char** nn = (char**)realloc(p_ptr_base_names, (size_t)new_cap * sizeof(char*));
-                    if (!nn) {
+                    p_types = (DataType*)parser_grow(p_types, (size_t)cap * sizeof(DataType),
+                                                     (size_t)new_cap * sizeof(DataType));
+                    p_ptr_base_types = (DataType*)parser_grow(p_ptr_base_types, (size_t)cap * sizeof(DataType),
+                                                              (size_t)new_cap * sizeof(DataType));
+                    p_ptr_base_names = (char**)parser_grow(p_ptr_base_names, (size_t)cap * sizeof(char*),
+                                                           (size_t)new_cap * sizeof(char*));
+                    p_ptr_depths = (int*)parser_grow(p_ptr_depths, (size_t)cap * sizeof(int),
+                                                     (size_t)new_cap * sizeof(int));
+                    if (!p_types || !p_ptr_base_types || !p_ptr_base_names || !p_ptr_depths) {
                         error_report(tok_kw, "نفدت الذاكرة أثناء توسيع توقيع مؤشر الدالة.");
                         synchronize_mode(PARSER_SYNC_DECLARATION);
-                        for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-                        free(p_types);
-                        free(p_ptr_base_types);
-                        free(p_ptr_base_names);
-                        free(p_ptr_depths);
-                        free(ptn);
-                        free(pptr_base_name);
                         return false;
                     }
-                    p_ptr_base_names = nn;
-
-                    int* nd = (int*)realloc(p_ptr_depths, (size_t)new_cap * sizeof(int));
-                    if (!nd) {
-                        error_report(tok_kw, "نفدت الذاكرة أثناء توسيع توقيع مؤشر الدالة.");
-                        synchronize_mode(PARSER_SYNC_DECLARATION);
-                        for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-                        free(p_types);
-                        free(p_ptr_base_types);
-                        free(p_ptr_base_names);
-                        free(p_ptr_depths);
-                        free(ptn);
-                        free(pptr_base_name);
-                        return false;
-                    }
-                    p_ptr_depths = nd;
-
-                    for (int i = cap; i < new_cap; i++) {
-                        p_ptr_base_names[i] = NULL;
-                    }
                     cap = new_cap;
                 }
 
                 p_types[cnt] = pdt;
                 p_ptr_base_types[cnt] = pptr_base;
                 p_ptr_depths[cnt] = pptr_depth;
-                p_ptr_base_names[cnt] = pptr_base_name ? pptr_base_name : NULL;
-                free(ptn);
+                p_ptr_base_names[cnt] = pptr_base_name;
                 cnt++;
 
-                if (parser.current.type == TOKEN_COMMA) {
+                if (parser->current.type == TOKEN_COMMA) {
                     eat(TOKEN_COMMA);
                     continue;
                 }
@@ -364,55 +276,34 @@ static bool parse_type_spec_ex(DataType* out_type, char** out_type_name,
         eat(TOKEN_RPAREN);
 
         // السهم: ->
-        if (parser.current.type != TOKEN_MINUS || parser.next.type != TOKEN_GT) {
-            error_report(parser.current, "متوقع '->' بعد معاملات توقيع الدالة.");
-            for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-            free(p_types); free(p_ptr_base_types); free(p_ptr_base_names); free(p_ptr_depths);
+        if (parser->current.type != TOKEN_MINUS || parser->next.type != TOKEN_GT) {
+            error_report(parser->current, "متوقع '->' بعد معاملات توقيع الدالة.");
             return false;
         }
         eat(TOKEN_MINUS);
         eat(TOKEN_GT);
 
         // نوع الإرجاع
-        Token tok_rt = parser.current;
+        Token tok_rt = parser->current;
         DataType rdt = TYPE_INT;
-        char* rtn = NULL;
         DataType rptr_base = TYPE_INT;
         char* rptr_base_name = NULL;
         int rptr_depth = 0;
-        FuncPtrSig* rfs = NULL;
-        if (!parse_type_spec_ex(&rdt, &rtn, &rptr_base, &rptr_base_name, &rptr_depth, &rfs, false)) {
-            error_report(parser.current, "متوقع نوع إرجاع بعد '->' في توقيع مؤشر الدالة.");
-            for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-            free(p_types); free(p_ptr_base_types); free(p_ptr_base_names); free(p_ptr_depths);
-            free(rtn);
-            free(rptr_base_name);
+        if (!parse_type_spec_ex(&rdt, NULL, &rptr_base, &rptr_base_name, &rptr_depth, NULL, false)) {
+            error_report(parser->current, "متوقع نوع إرجاع بعد '->' في توقيع مؤشر الدالة.");
             synchronize_mode(PARSER_SYNC_DECLARATION);
             return false;
         }
-        if (rfs) {
-            parser_funcsig_free(rfs);
-            rfs = NULL;
-        }
 
         if (rdt == TYPE_ENUM || rdt == TYPE_STRUCT || rdt == TYPE_UNION) {
             error_report(tok_rt, "أنواع الإرجاع المعرفة من المستخدم غير مدعومة بعد في تواقيع مؤشرات الدوال.");
-            for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-            free(p_types); free(p_ptr_base_types); free(p_ptr_base_names); free(p_ptr_depths);
-            free(rtn);
-            free(rptr_base_name);
             synchronize_mode(PARSER_SYNC_DECLARATION);
             return false;
         }
 
-        free(rtn);
-
-        fsig = (FuncPtrSig*)calloc(1, sizeof(FuncPtrSig));
+        fsig = (FuncPtrSig*)parser_alloc(1, sizeof(FuncPtrSig));
         if (!fsig) {
             error_report(tok_kw, "نفدت الذاكرة أثناء إنشاء توقيع مؤشر الدالة.");
-            for (int i = 0; i < cnt; i++) free(p_ptr_base_names ? p_ptr_base_names[i] : NULL);
-            free(p_types); free(p_ptr_base_types); free(p_ptr_base_names); free(p_ptr_depths);
-            free(rptr_base_name);
             return false;
         }
 
@@ -434,45 +325,49 @@ static bool parse_type_spec_ex(DataType* out_type, char** out_type_name,
     // --------------------------------------------------------------------
     // الأنواع البدائية / المركبة / alias
     // --------------------------------------------------------------------
-    else if (parser.current.type == TOKEN_KEYWORD_INT ||
-             parser.current.type == TOKEN_KEYWORD_I8 ||
-             parser.current.type == TOKEN_KEYWORD_I16 ||
-             parser.current.type == TOKEN_KEYWORD_I32 ||
-             parser.current.type == TOKEN_KEYWORD_I64 ||
-             parser.current.type == TOKEN_KEYWORD_U8 ||
-             parser.current.type == TOKEN_KEYWORD_U16 ||
-             parser.current.type == TOKEN_KEYWORD_U32 ||
-             parser.current.type == TOKEN_KEYWORD_U64 ||
-             parser.current.type == TOKEN_KEYWORD_STRING ||
-             parser.current.type == TOKEN_KEYWORD_BOOL ||
-             parser.current.type == TOKEN_KEYWORD_CHAR ||
-             parser.current.type == TOKEN_KEYWORD_VOID ||
-             parser.current.type == TOKEN_KEYWORD_FLOAT ||
-             parser.current.type == TOKEN_KEYWORD_FLOAT32) {
-        dt = token_to_datatype(parser.current.type);
-        eat(parser.current.type);
+    else if (parser->current.type == TOKEN_KEYWORD_INT ||
+             parser->current.type == TOKEN_KEYWORD_I8 ||
+             parser->current.type == TOKEN_KEYWORD_I16 ||
+             parser->current.type == TOKEN_KEYWORD_I32 ||
+             parser->current.type == TOKEN_KEYWORD_I64 ||
+             parser->current.type == TOKEN_KEYWORD_U8 ||
+             parser->current.type == TOKEN_KEYWORD_U16 ||
+             parser->current.type == TOKEN_KEYWORD_U32 ||
+             parser->current.type == TOKEN_KEYWORD_U64 ||
+             parser->current.type == TOKEN_KEYWORD_STRING ||
+             parser->current.type == TOKEN_KEYWORD_BOOL ||
+             parser->current.type == TOKEN_KEYWORD_CHAR ||
+             parser->current.type == TOKEN_KEYWORD_VOID ||
+             parser->current.type == TOKEN_KEYWORD_FLOAT ||
+             parser->current.type == TOKEN_KEYWORD_FLOAT32) {
+        dt = token_to_datatype(parser->current.type);
+        eat(parser->current.type);
         parsed = true;
     }
 
-    else if (parser.current.type == TOKEN_ENUM || parser.current.type == TOKEN_STRUCT || parser.current.type == TOKEN_UNION) {
-        bool is_enum = (parser.current.type == TOKEN_ENUM);
-        bool is_union = (parser.current.type == TOKEN_UNION);
-        eat(parser.current.type);
+    else if (parser->current.type == TOKEN_ENUM || parser->current.type == TOKEN_STRUCT || parser->current.type == TOKEN_UNION) {
+        bool is_enum = (parser->current.type == TOKEN_ENUM);
+        bool is_union = (parser->current.type == TOKEN_UNION);
+        eat(parser->current.type);
 
-        if (parser.current.type != TOKEN_IDENTIFIER) {
-            error_report(parser.current, "متوقع اسم معرّف بعد كلمة النوع.");
+        if (parser->current.type != TOKEN_IDENTIFIER) {
+            error_report(parser->current, "متوقع اسم معرّف بعد كلمة النوع.");
             return false;
         }
 
-        tn = strdup(parser.current.value);
+        tn = parser_strdup(parser->current.value);
+        if (!tn) {
+            error_report(parser->current, "نفدت الذاكرة أثناء نسخ اسم النوع.");
+            return false;
+        }
         eat(TOKEN_IDENTIFIER);
 
         dt = is_enum ? TYPE_ENUM : (is_union ? TYPE_UNION : TYPE_STRUCT);
         parsed = true;
     }
 
-    else if (parser.current.type == TOKEN_IDENTIFIER && parser.current.value) {
-        const ParserTypeAlias* alias = parser_type_alias_lookup(parser.current.value);
+    else if (parser->current.type == TOKEN_IDENTIFIER && parser->current.value) {
+        const ParserTypeAlias* alias = parser_type_alias_lookup(parser->current.atom);
         if (!alias) return false;
 
         dt = alias->target_type;
@@ -483,7 +378,7 @@ static bool parse_type_spec_ex(DataType* out_type, char** out_type_name,
         // إذا كان هذا الاسم البديل يحل إلى نوع مؤشر دالة، فلا نسمح به عندما allow_func_ptr == false
         // (أي أثناء تحليل معاملات/إرجاع توقيع مؤشر دالة آخر).
         if (!allow_func_ptr && dt == TYPE_FUNC_PTR) {
-            error_report(parser.current,
+            error_report(parser->current,
                          "غير مدعوم: استخدام نوع بديل لمؤشر دالة داخل توقيع مؤشر دالة (لا ندعم Higher-order).");
             return false;
         }
@@ -491,26 +386,23 @@ static bool parse_type_spec_ex(DataType* out_type, char** out_type_name,
         if (alias->target_func_sig) {
             fsig = parser_funcsig_clone(alias->target_func_sig);
             if (!fsig) {
-                error_report(parser.current, "نفدت الذاكرة أثناء نسخ توقيع النوع البديل.");
+                error_report(parser->current, "نفدت الذاكرة أثناء نسخ توقيع النوع البديل.");
                 return false;
             }
         }
 
         if (alias->target_type_name) {
-            tn = strdup(alias->target_type_name);
+            tn = parser_strdup(alias->target_type_name);
             if (!tn) {
-                parser_funcsig_free(fsig);
-                error_report(parser.current, "نفدت الذاكرة أثناء نسخ النوع البديل.");
+                error_report(parser->current, "نفدت الذاكرة أثناء نسخ النوع البديل.");
                 return false;
             }
         }
 
         if (alias->target_ptr_base_type_name) {
-            ptr_base_name = strdup(alias->target_ptr_base_type_name);
+            ptr_base_name = parser_strdup(alias->target_ptr_base_type_name);
             if (!ptr_base_name) {
-                free(tn);
-                parser_funcsig_free(fsig);
-                error_report(parser.current, "نفدت الذاكرة أثناء نسخ أساس مؤشر النوع البديل.");
+                error_report(parser->current, "نفدت الذاكرة أثناء نسخ أساس مؤشر النوع البديل.");
                 return false;
             }
         }
@@ -522,22 +414,19 @@ static bool parse_type_spec_ex(DataType* out_type, char** out_type_name,
     if (!parsed) return false;
 
     if (dt == TYPE_FUNC_PTR) {
-        if (parser.current.type == TOKEN_STAR) {
-            error_report(parser.current, "غير مدعوم: لاحقة '*' بعد نوع مؤشر دالة.");
-            parser_funcsig_free(fsig);
+        if (parser->current.type == TOKEN_STAR) {
+            error_report(parser->current, "غير مدعوم: لاحقة '*' بعد نوع مؤشر دالة.");
             return false;
         }
 
-        // تنظيف الحقول غير المستخدمة
-        free(tn);
+        // الحقول غير المستخدمة مع مؤشرات الدوال
         tn = NULL;
-        free(ptr_base_name);
         ptr_base_name = NULL;
         ptr_base_type = TYPE_INT;
         ptr_depth = 0;
     } else {
         int suffix_ptr_depth = 0;
-        while (parser.current.type == TOKEN_STAR) {
+        while (parser->current.type == TOKEN_STAR) {
             eat(TOKEN_STAR);
             suffix_ptr_depth++;
         }
@@ -551,10 +440,9 @@ static bool parse_type_spec_ex(DataType* out_type, char** out_type_name,
 
                 if ((ptr_base_type == TYPE_ENUM || ptr_base_type == TYPE_STRUCT || ptr_base_type == TYPE_UNION) &&
                     tn && !ptr_base_name) {
-                    ptr_base_name = strdup(tn);
+                    ptr_base_name = parser_strdup(tn);
                     if (!ptr_base_name) {
-                        free(tn);
-                        error_report(parser.current, "نفدت الذاكرة أثناء نسخ اسم أساس المؤشر.");
+                        error_report(parser->current, "نفدت الذاكرة أثناء نسخ اسم أساس المؤشر.");
                         return false;
                     }
                 }
@@ -570,7 +458,6 @@ static bool parse_type_spec_ex(DataType* out_type, char** out_type_name,
 
         if (dt != TYPE_POINTER) {
             ptr_base_type = TYPE_INT;
-            free(ptr_base_name);
             ptr_base_name = NULL;
         }
     }
@@ -579,31 +466,19 @@ static bool parse_type_spec_ex(DataType* out_type, char** out_type_name,
         *out_type = dt;
     }
 
-    if (out_type_name) {
-        *out_type_name = tn;
-    } else {
-        free(tn);
-    }
+    if (out_type_name) *out_type_name = tn;
 
     if (out_ptr_base_type) {
         *out_ptr_base_type = ptr_base_type;
     }
 
-    if (out_ptr_base_type_name) {
-        *out_ptr_base_type_name = ptr_base_name;
-    } else {
-        free(ptr_base_name);
-    }
+    if (out_ptr_base_type_name) *out_ptr_base_type_name = ptr_base_name;
 
     if (out_ptr_depth) {
         *out_ptr_depth = ptr_depth;
     }
 
-    if (out_func_sig) {
-        *out_func_sig = fsig;
-    } else {
-        parser_funcsig_free(fsig);
-    }
+    if (out_func_sig) *out_func_sig = fsig;
 
     return true;
 }
@@ -622,19 +497,19 @@ static bool parse_type_spec(DataType* out_type, char** out_type_name,
 
 static bool parser_current_starts_declaration_anchor(void)
 {
-    if (parser_current_is_type_alias_keyword() && parser.next.type == TOKEN_IDENTIFIER) return true;
+    if (parser_current_is_type_alias_keyword() && parser->next.type == TOKEN_IDENTIFIER) return true;
     if (parser_current_starts_type()) return true;
-    return parser_is_decl_qualifier(parser.current.type);
+    return parser_is_decl_qualifier(parser->current.type);
 }
 
 static bool parser_current_starts_statement_anchor(void)
 {
     if (parser_current_starts_type()) return true;
     if (parser_current_is_type_alias_keyword()) return true;
-    if (parser_is_decl_qualifier(parser.current.type)) return true;
-    if (parser.current.type == TOKEN_IDENTIFIER) return true;
+    if (parser_is_decl_qualifier(parser->current.type)) return true;
+    if (parser->current.type == TOKEN_IDENTIFIER) return true;
 
-    switch (parser.current.type) {
+    switch (parser->current.type) {
         case TOKEN_LBRACE:
         case TOKEN_IF:
         case TOKEN_WHILE:
@@ -657,34 +532,34 @@ static bool parser_current_starts_statement_anchor(void)
  */
 static void synchronize_mode(ParserSyncMode mode)
 {
-    while (parser.current.type != TOKEN_EOF) {
+    while (parser->current.type != TOKEN_EOF) {
         // إذا وجدنا فاصلة منقوطة، فغالباً انتهت الجملة السابقة
-        if (parser.current.type == TOKEN_SEMICOLON || parser.current.type == TOKEN_DOT) {
+        if (parser->current.type == TOKEN_SEMICOLON || parser->current.type == TOKEN_DOT) {
             advance();
-            parser.panic_mode = false;
+            parser->panic_mode = false;
             return;
         }
 
         if (mode == PARSER_SYNC_SWITCH) {
-            if (parser.current.type == TOKEN_CASE ||
-                parser.current.type == TOKEN_DEFAULT ||
-                parser.current.type == TOKEN_RBRACE) {
-                parser.panic_mode = false;
+            if (parser->current.type == TOKEN_CASE ||
+                parser->current.type == TOKEN_DEFAULT ||
+                parser->current.type == TOKEN_RBRACE) {
+                parser->panic_mode = false;
                 return;
             }
         } else if (mode == PARSER_SYNC_DECLARATION) {
-            if (parser.current.type == TOKEN_RBRACE) {
+            if (parser->current.type == TOKEN_RBRACE) {
                 advance();
-                parser.panic_mode = false;
+                parser->panic_mode = false;
                 return;
             }
             if (parser_current_starts_declaration_anchor()) {
-                parser.panic_mode = false;
+                parser->panic_mode = false;
                 return;
             }
         } else {
-            if (parser_current_starts_statement_anchor() || parser.current.type == TOKEN_RBRACE) {
-                parser.panic_mode = false;
+            if (parser_current_starts_statement_anchor() || parser->current.type == TOKEN_RBRACE) {
+                parser->panic_mode = false;
                 return;
             }
         }
@@ -692,7 +567,7 @@ static void synchronize_mode(ParserSyncMode mode)
         advance();
     }
 
-    parser.panic_mode = false;
+    parser->panic_mode = false;
 }
 
 /**
@@ -740,7 +615,7 @@ static Node* parse_array_indices(int* out_count)
     Node* tail = NULL;
     int count = 0;
 
-    while (parser.current.type == TOKEN_LBRACKET) {
+    while (parser->current.type == TOKEN_LBRACKET) {
         eat(TOKEN_LBRACKET);
         Node* index = parse_expression();
         eat(TOKEN_RBRACKET);
@@ -782,47 +657,38 @@ static bool parse_array_dimensions(int** out_dims, int* out_rank, int64_t* out_t
     int* dims = NULL;
     int64_t total = 1;
 
-    while (parser.current.type == TOKEN_LBRACKET) {
+    while (parser->current.type == TOKEN_LBRACKET) {
         eat(TOKEN_LBRACKET);
 
         int dim = 0;
-        if (parser.current.type == TOKEN_INT) {
+        if (parser->current.type == TOKEN_INT) {
             int64_t v = 0;
-            if (parse_int_token_checked(parser.current, &v)) {
+            if (parse_int_token_checked(parser->current, &v)) {
                 if (v <= 0) {
-                    error_report(parser.current, "حجم البعد يجب أن يكون عدداً موجباً.");
+                    error_report(parser->current, "حجم البعد يجب أن يكون عدداً موجباً.");
                 } else if (v > INT_MAX) {
-                    error_report(parser.current, "حجم البعد كبير جداً.");
+                    error_report(parser->current, "حجم البعد كبير جداً.");
                 } else {
                     dim = (int)v;
                 }
             } else {
-                error_report(parser.current, "حجم البعد يجب أن يكون عدداً صحيحاً.");
+                error_report(parser->current, "حجم البعد يجب أن يكون عدداً صحيحاً.");
             }
             eat(TOKEN_INT);
         } else {
-            error_report(parser.current, "متوقع حجم بعد مصفوفة ثابت.");
+            error_report(parser->current, "متوقع حجم بعد مصفوفة ثابت.");
         }
 
         eat(TOKEN_RBRACKET);
 
-        if (rank >= cap) {
-            int new_cap = cap * 2;
-            int* new_dims = (int*)realloc(dims, (size_t)new_cap * sizeof(int));
-            if (!new_dims) {
-                free(dims);
-                error_report(parser.current, "نفدت الذاكرة أثناء تحليل أبعاد المصفوفة.");
-                return false;
-            }
-            dims = new_dims;
-            cap = new_cap;
-        }
-        if (!dims) {
-            dims = (int*)malloc((size_t)cap * sizeof(int));
+        if (!dims || rank >= cap) {
+            int new_cap = dims ? cap * 2 : cap;
+            dims = (int*)parser_grow(dims, dims ? (size_t)cap * sizeof(int) : 0u, (size_t)new_cap * sizeof(int));
             if (!dims) {
-                error_report(parser.current, "نفدت الذاكرة أثناء تحليل أبعاد المصفوفة.");
+                error_report(parser->current, "نفدت الذاكرة أثناء تحليل أبعاد المصفوفة.");
                 return false;
             }
+            cap = new_cap;
         }
 
         dims[rank++] = dim;
@@ -830,7 +696,7 @@ static bool parse_array_dimensions(int** out_dims, int* out_rank, int64_t* out_t
         if (dim > 0) {
             int64_t nt = 0;
             if (!parser_mul_i64_checked(total, (int64_t)dim, &nt)) {
-                error_report(parser.current, "حجم المصفوفة الكلي كبير جداً.");
+                error_report(parser->current, "حجم المصفوفة الكلي كبير جداً.");
                 total = 0;
             } else {
                 total = nt;
@@ -840,13 +706,9 @@ static bool parse_array_dimensions(int** out_dims, int* out_rank, int64_t* out_t
         }
     }
 
-    if (rank == 0) {
-        free(dims);
-        return false;
-    }
+    if (rank == 0) return false;
 
     if (out_dims) *out_dims = dims;
-    else free(dims);
     if (out_rank) *out_rank = rank;
     if (out_total) *out_total = total;
     return true;
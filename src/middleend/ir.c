@@ -14,39 +14,20 @@
 #include <string.h>
 
 // ============================================================================
-// سياق الوحدة الحالية (للساحة)
+// التخصيص من الساحة المالكة (تُمرَّر صراحةً من المستدعي)
 // ============================================================================
 
-static IRModule* g_ir_current_module = NULL;
-
-void ir_module_set_current(IRModule* module) {
-    g_ir_current_module = module;
-}
-
-IRModule* ir_module_get_current(void) {
-    return g_ir_current_module;
-}
-
-static IRArena* ir_cur_arena(void) {
-    if (!g_ir_current_module) {
-        return NULL;
-    }
-    return &g_ir_current_module->arena;
-}
-
-static void* ir_alloc(size_t size, size_t align) {
-    IRArena* a = ir_cur_arena();
+static void* ir_alloc(IRArena* a, size_t size, size_t align) {
     if (!a) {
-        fprintf(stderr, "خطأ: محاولة تخصيص IR بدون وحدة حالية (Arena غير مهيئة)\n");
+        fprintf(stderr, "خطأ: محاولة تخصيص IR بدون ساحة مالكة\n");
         return NULL;
     }
     return ir_arena_alloc(a, size, align);
 }
 
-static char* ir_strdup(const char* s) {
-    IRArena* a = ir_cur_arena();
+static char* ir_strdup(IRArena* a, const char* s) {
     if (!a) {
-        fprintf(stderr, "خطأ: محاولة نسخ نص IR بدون وحدة حالية (Arena غير مهيئة)\n");
+        fprintf(stderr, "خطأ: محاولة نسخ نص IR بدون ساحة مالكة\n");
         return NULL;
     }
     return ir_arena_strdup(a, s);
@@ -69,6 +50,9 @@ static IRType ir_type_u64_instance    = { .kind = IR_TYPE_U64 };
 static IRType ir_type_char_instance   = { .kind = IR_TYPE_CHAR };
 static IRType ir_type_f64_instance    = { .kind = IR_TYPE_F64 };
 
+// i8* مشترك بين كل الوحدات (لا يحمل حالة، فلا يحتاج ساحة)
+static IRType ir_type_i8_ptr_instance = { .kind = IR_TYPE_PTR, .data.pointee = &ir_type_i8_instance };
+
 // مؤشرات عامة للأنواع الأساسية
 IRType* IR_TYPE_VOID_T  = &ir_type_void_instance;
 IRType* IR_TYPE_I1_T    = &ir_type_i1_instance;
@@ -179,6 +163,7 @@ const char* ir_op_to_arabic(IROp op) {
         case IR_OP_BR:      return "قفز";
         case IR_OP_BR_COND: return "قفز_شرط";
         case IR_OP_RET:     return "رجوع";
+        case IR_OP_SWITCH:  return "تفرع";
         case IR_OP_CALL:    return "نداء";
         
         // SSA
@@ -222,6 +207,7 @@ const char* ir_op_to_english(IROp op) {
         case IR_OP_BR:      return "br";
         case IR_OP_BR_COND: return "br.cond";
         case IR_OP_RET:     return "ret";
+        case IR_OP_SWITCH:  return "switch";
         case IR_OP_CALL:    return "call";
         case IR_OP_PHI:     return "phi";
         case IR_OP_COPY:    return "copy";
@@ -330,30 +316,25 @@ const char* ir_type_to_english(IRType* type) {
 /**
  * Create a pointer type
  */
-IRType* ir_type_ptr(IRType* pointee) {
-    if (g_ir_current_module && pointee == IR_TYPE_I8_T && g_ir_current_module->cached_i8_ptr_type) {
-        return g_ir_current_module->cached_i8_ptr_type;
-    }
+IRType* ir_type_ptr(IRArena* arena, IRType* pointee) {
+    // i8* شائع جداً (النصوص، نداءات libc)؛ نسخة ثابتة مشتركة بلا تخصيص.
+    if (pointee == IR_TYPE_I8_T) return &ir_type_i8_ptr_instance;
 
-    IRType* type = (IRType*)ir_alloc(sizeof(IRType), _Alignof(IRType));
+    IRType* type = (IRType*)ir_alloc(arena, sizeof(IRType), _Alignof(IRType));
     if (!type) {
         fprintf(stderr, "خطأ: فشل تخصيص نوع مؤشر\n");
         return NULL;
     }
     type->kind = IR_TYPE_PTR;
     type->data.pointee = pointee;
-
-    if (g_ir_current_module && pointee == IR_TYPE_I8_T && !g_ir_current_module->cached_i8_ptr_type) {
-        g_ir_current_module->cached_i8_ptr_type = type;
-    }
     return type;
 }
 
 /**
  * Create an array type
  */
-IRType* ir_type_array(IRType* element, int count) {
-    IRType* type = (IRType*)ir_alloc(sizeof(IRType), _Alignof(IRType));
+IRType* ir_type_array(IRArena* arena, IRType* element, int count) {
+    IRType* type = (IRType*)ir_alloc(arena, sizeof(IRType), _Alignof(IRType));
     if (!type) {
         fprintf(stderr, "خطأ: فشل تخصيص نوع مصفوفة\n");
         return NULL;
@@ -367,8 +348,8 @@ IRType* ir_type_array(IRType* element, int count) {
 /**
  * Create a function type
  */
-IRType* ir_type_func(IRType* ret, IRType** params, int param_count) {
-    IRType* type = (IRType*)ir_alloc(sizeof(IRType), _Alignof(IRType));
+IRType* ir_type_func(IRArena* arena, IRType* ret, IRType** params, int param_count) {
+    IRType* type = (IRType*)ir_alloc(arena, sizeof(IRType), _Alignof(IRType));
     if (!type) {
         fprintf(stderr, "خطأ: فشل تخصيص نوع دالة\n");
         return NULL;
@@ -376,7 +357,7 @@ IRType* ir_type_func(IRType* ret, IRType** params, int param_count) {
     type->kind = IR_TYPE_FUNC;
     type->data.func.ret = ret;
     if (params && param_count > 0) {
-        IRType** arr = (IRType**)ir_alloc((size_t)param_count * sizeof(IRType*), _Alignof(IRType*));
+        IRType** arr = (IRType**)ir_alloc(arena, (size_t)param_count * sizeof(IRType*), _Alignof(IRType*));
         if (!arr) return NULL;
         for (int i = 0; i < param_count; i++) arr[i] = params[i];
         type->data.func.params = arr;
@@ -456,8 +437,8 @@ int ir_type_bits(IRType* type) {
 /**
  * Create a register value
  */
-IRValue* ir_value_reg(int reg_num, IRType* type) {
-    IRValue* val = (IRValue*)ir_alloc(sizeof(IRValue), _Alignof(IRValue));
+IRValue* ir_value_reg(IRArena* arena, int reg_num, IRType* type) {
+    IRValue* val = (IRValue*)ir_alloc(arena, sizeof(IRValue), _Alignof(IRValue));
     if (!val) return NULL;
     val->kind = IR_VAL_REG;
     val->type = type;
@@ -468,8 +449,8 @@ IRValue* ir_value_reg(int reg_num, IRType* type) {
 /**
  * Create an integer constant value
  */
-IRValue* ir_value_const_int(int64_t value, IRType* type) {
-    IRValue* val = (IRValue*)ir_alloc(sizeof(IRValue), _Alignof(IRValue));
+IRValue* ir_value_const_int(IRArena* arena, int64_t value, IRType* type) {
+    IRValue* val = (IRValue*)ir_alloc(arena, sizeof(IRValue), _Alignof(IRValue));
     if (!val) return NULL;
     val->kind = IR_VAL_CONST_INT;
     val->type = type ? type : IR_TYPE_I64_T;
@@ -480,22 +461,22 @@ IRValue* ir_value_const_int(int64_t value, IRType* type) {
 /**
  * Create a string constant value
  */
-IRValue* ir_value_const_str(const char* str, int id) {
-    IRValue* val = (IRValue*)ir_alloc(sizeof(IRValue), _Alignof(IRValue));
+IRValue* ir_value_const_str(IRArena* arena, const char* str, int id) {
+    IRValue* val = (IRValue*)ir_alloc(arena, sizeof(IRValue), _Alignof(IRValue));
     if (!val) return NULL;
     val->kind = IR_VAL_CONST_STR;
-    val->type = ir_type_ptr(IR_TYPE_I8_T);
-    val->data.const_str.data = str ? ir_strdup(str) : NULL;
+    val->type = ir_type_ptr(arena, IR_TYPE_I8_T);
+    val->data.const_str.data = str ? ir_strdup(arena, str) : NULL;
     val->data.const_str.id = id;
     return val;
 }
 
-IRValue* ir_value_baa_str(const char* str, int id) {
-    IRValue* val = (IRValue*)ir_alloc(sizeof(IRValue), _Alignof(IRValue));
+IRValue* ir_value_baa_str(IRArena* arena, const char* str, int id) {
+    IRValue* val = (IRValue*)ir_alloc(arena, sizeof(IRValue), _Alignof(IRValue));
     if (!val) return NULL;
     val->kind = IR_VAL_BAA_STR;
-    val->type = ir_type_ptr(IR_TYPE_CHAR_T);
-    val->data.const_str.data = str ? ir_strdup(str) : NULL;
+    val->type = ir_type_ptr(arena, IR_TYPE_CHAR_T);
+    val->data.const_str.data = str ? ir_strdup(arena, str) : NULL;
     val->data.const_str.id = id;
     return val;
 }
@@ -503,8 +484,8 @@ IRValue* ir_value_baa_str(const char* str, int id) {
 /**
  * Create a block reference value
  */
-IRValue* ir_value_block(IRBlock* block) {
-    IRValue* val = (IRValue*)ir_alloc(sizeof(IRValue), _Alignof(IRValue));
+IRValue* ir_value_block(IRArena* arena, IRBlock* block) {
+    IRValue* val = (IRValue*)ir_alloc(arena, sizeof(IRValue), _Alignof(IRValue));
     if (!val) return NULL;
     val->kind = IR_VAL_BLOCK;
     val->type = NULL;  // Blocks don't have a type
@@ -515,24 +496,24 @@ IRValue* ir_value_block(IRBlock* block) {
 /**
  * Create a global variable reference value
  */
-IRValue* ir_value_global(const char* name, IRType* type) {
-    IRValue* val = (IRValue*)ir_alloc(sizeof(IRValue), _Alignof(IRValue));
+IRValue* ir_value_global(IRArena* arena, const char* name, IRType* type) {
+    IRValue* val = (IRValue*)ir_alloc(arena, sizeof(IRValue), _Alignof(IRValue));
     if (!val) return NULL;
     val->kind = IR_VAL_GLOBAL;
-    val->type = type ? ir_type_ptr(type) : NULL;
-    val->data.global_name = name ? ir_strdup(name) : NULL;
+    val->type = type ? ir_type_ptr(arena, type) : NULL;
+    val->data.global_name = name ? ir_strdup(arena, name) : NULL;
     return val;
 }
 
 /**
  * Create a function reference value
  */
-IRValue* ir_value_func_ref(const char* name, IRType* type) {
-    IRValue* val = (IRValue*)ir_alloc(sizeof(IRValue), _Alignof(IRValue));
+IRValue* ir_value_func_ref(IRArena* arena, const char* name, IRType* type) {
+    IRValue* val = (IRValue*)ir_alloc(arena, sizeof(IRValue), _Alignof(IRValue));
     if (!val) return NULL;
     val->kind = IR_VAL_FUNC;
     val->type = type;
-    val->data.global_name = name ? ir_strdup(name) : NULL;
+    val->data.global_name = name ? ir_strdup(arena, name) : NULL;
     return val;
 }
 
@@ -551,8 +532,8 @@ void ir_value_free(IRValue* val) {
 /**
  * Create a new instruction
  */
-IRInst* ir_inst_new(IROp op, IRType* type, int dest) {
-    IRInst* inst = (IRInst*)ir_alloc(sizeof(IRInst), _Alignof(IRInst));
+IRInst* ir_inst_new(IRArena* arena, IROp op, IRType* type, int dest) {
+    IRInst* inst = (IRInst*)ir_alloc(arena, sizeof(IRInst), _Alignof(IRInst));
     if (!inst) return NULL;
     
     inst->op = op;
@@ -565,6 +546,9 @@ IRInst* ir_inst_new(IROp op, IRType* type, int dest) {
     }
     inst->cmp_pred = IR_CMP_EQ;  // Default
     inst->phi_entries = NULL;
+    inst->switch_cases = NULL;
+    inst->switch_case_count = 0;
+    inst->switch_case_capacity = 0;
     inst->call_target = NULL;
     inst->call_callee = NULL;
     inst->call_args = NULL;
@@ -575,6 +559,7 @@ IRInst* ir_inst_new(IROp op, IRType* type, int dest) {
     inst->dbg_name = NULL;
 
     inst->parent = NULL;
+    inst->arena = arena;
     inst->prev = NULL;
     inst->next = NULL;
     
@@ -616,8 +601,8 @@ void ir_inst_set_dbg_name(IRInst* inst, const char* name) {
 /**
  * Create a binary operation (add, sub, mul, div, etc.)
  */
-IRInst* ir_inst_binary(IROp op, IRType* type, int dest, IRValue* lhs, IRValue* rhs) {
-    IRInst* inst = ir_inst_new(op, type, dest);
+IRInst* ir_inst_binary(IRArena* arena, IROp op, IRType* type, int dest, IRValue* lhs, IRValue* rhs) {
+    IRInst* inst = ir_inst_new(arena, op, type, dest);
     if (!inst) return NULL;
     ir_inst_add_operand(inst, lhs);
     ir_inst_add_operand(inst, rhs);
@@ -627,8 +612,8 @@ IRInst* ir_inst_binary(IROp op, IRType* type, int dest, IRValue* lhs, IRValue* r
 /**
  * Create a unary operation (neg, not)
  */
-IRInst* ir_inst_unary(IROp op, IRType* type, int dest, IRValue* operand) {
-    IRInst* inst = ir_inst_new(op, type, dest);
+IRInst* ir_inst_unary(IRArena* arena, IROp op, IRType* type, int dest, IRValue* operand) {
+    IRInst* inst = ir_inst_new(arena, op, type, dest);
     if (!inst) return NULL;
     ir_inst_add_operand(inst, operand);
     return inst;
@@ -637,8 +622,8 @@ IRInst* ir_inst_unary(IROp op, IRType* type, int dest, IRValue* operand) {
 /**
  * Create a comparison instruction
  */
-IRInst* ir_inst_cmp(IRCmpPred pred, int dest, IRValue* lhs, IRValue* rhs) {
-    IRInst* inst = ir_inst_new(IR_OP_CMP, IR_TYPE_I1_T, dest);
+IRInst* ir_inst_cmp(IRArena* arena, IRCmpPred pred, int dest, IRValue* lhs, IRValue* rhs) {
+    IRInst* inst = ir_inst_new(arena, IR_OP_CMP, IR_TYPE_I1_T, dest);
     if (!inst) return NULL;
     inst->cmp_pred = pred;
     ir_inst_add_operand(inst, lhs);
@@ -649,17 +634,17 @@ IRInst* ir_inst_cmp(IRCmpPred pred, int dest, IRValue* lhs, IRValue* rhs) {
 /**
  * Create an alloca instruction
  */
-IRInst* ir_inst_alloca(IRType* type, int dest) {
-    IRType* ptr_type = ir_type_ptr(type);
-    IRInst* inst = ir_inst_new(IR_OP_ALLOCA, ptr_type, dest);
+IRInst* ir_inst_alloca(IRArena* arena, IRType* type, int dest) {
+    IRType* ptr_type = ir_type_ptr(arena, type);
+    IRInst* inst = ir_inst_new(arena, IR_OP_ALLOCA, ptr_type, dest);
     return inst;
 }
 
 /**
  * Create a load instruction
  */
-IRInst* ir_inst_load(IRType* type, int dest, IRValue* ptr) {
-    IRInst* inst = ir_inst_new(IR_OP_LOAD, type, dest);
+IRInst* ir_inst_load(IRArena* arena, IRType* type, int dest, IRValue* ptr) {
+    IRInst* inst = ir_inst_new(arena, IR_OP_LOAD, type, dest);
     if (!inst) return NULL;
     ir_inst_add_operand(inst, ptr);
     return inst;
@@ -668,8 +653,8 @@ IRInst* ir_inst_load(IRType* type, int dest, IRValue* ptr) {
 /**
  * Create a store instruction
  */
-IRInst* ir_inst_store(IRValue* value, IRValue* ptr) {
-    IRInst* inst = ir_inst_new(IR_OP_STORE, IR_TYPE_VOID_T, -1);  // No destination
+IRInst* ir_inst_store(IRArena* arena, IRValue* value, IRValue* ptr) {
+    IRInst* inst = ir_inst_new(arena, IR_OP_STORE, IR_TYPE_VOID_T, -1);  // No destination
     if (!inst) return NULL;
     ir_inst_add_operand(inst, value);
     ir_inst_add_operand(inst, ptr);
@@ -686,8 +671,8 @@ IRInst* ir_inst_store(IRValue* value, IRValue* ptr) {
  * - base والنتيجة لهما نفس نوع المؤشر.
  * - index فهرس عناصر (وليس بايتات) ويُضرب ضمنياً في حجم pointee.
  */
-IRInst* ir_inst_ptr_offset(IRType* ptr_type, int dest, IRValue* base, IRValue* index) {
-    IRInst* inst = ir_inst_new(IR_OP_PTR_OFFSET, ptr_type, dest);
+IRInst* ir_inst_ptr_offset(IRArena* arena, IRType* ptr_type, int dest, IRValue* base, IRValue* index) {
+    IRInst* inst = ir_inst_new(arena, IR_OP_PTR_OFFSET, ptr_type, dest);
     if (!inst) return NULL;
     ir_inst_add_operand(inst, base);
     ir_inst_add_operand(inst, index);
@@ -697,31 +682,31 @@ IRInst* ir_inst_ptr_offset(IRType* ptr_type, int dest, IRValue* base, IRValue* i
 /**
  * Create an unconditional branch
  */
-IRInst* ir_inst_br(IRBlock* target) {
-    IRInst* inst = ir_inst_new(IR_OP_BR, IR_TYPE_VOID_T, -1);
+IRInst* ir_inst_br(IRArena* arena, IRBlock* target) {
+    IRInst* inst = ir_inst_new(arena, IR_OP_BR, IR_TYPE_VOID_T, -1);
     if (!inst) return NULL;
-    ir_inst_add_operand(inst, ir_value_block(target));
+    ir_inst_add_operand(inst, ir_value_block(arena, target));
     return inst;
 }
 
 /**
  * Create a conditional branch
  */
-IRInst* ir_inst_br_cond(IRValue* cond, IRBlock* if_true, IRBlock* if_false) {
-    IRInst* inst = ir_inst_new(IR_OP_BR_COND, IR_TYPE_VOID_T, -1);
+IRInst* ir_inst_br_cond(IRArena* arena, IRValue* cond, IRBlock* if_true, IRBlock* if_false) {
+    IRInst* inst = ir_inst_new(arena, IR_OP_BR_COND, IR_TYPE_VOID_T, -1);
     if (!inst) return NULL;
     ir_inst_add_operand(inst, cond);
-    ir_inst_add_operand(inst, ir_value_block(if_true));
-    ir_inst_add_operand(inst, ir_value_block(if_false));
+    ir_inst_add_operand(inst, ir_value_block(arena, if_true));
+    ir_inst_add_operand(inst, ir_value_block(arena, if_false));
     return inst;
 }
 
 /**
  * Create a return instruction
  */
-IRInst* ir_inst_ret(IRValue* value) {
+IRInst* ir_inst_ret(IRArena* arena, IRValue* value) {
     IRType* type = value ? value->type : IR_TYPE_VOID_T;
-    IRInst* inst = ir_inst_new(IR_OP_RET, type, -1);
+    IRInst* inst = ir_inst_new(arena, IR_OP_RET, type, -1);
     if (!inst) return NULL;
     if (value) {
         ir_inst_add_operand(inst, value);
@@ -729,21 +714,66 @@ IRInst* ir_inst_ret(IRValue* value) {
     return inst;
 }
 
+/**
+ * @brief إنشاء تعليمة تفرع: قفز متعدد حسب قيمة صحيحة.
+ *
+ * الصيغة:
+ *   تفرع <type> value, افتراضي %default, [ثابت, %target]...
+ *
+ * تُضاف الحالات لاحقاً عبر ir_inst_switch_add_case().
+ */
+IRInst* ir_inst_switch(IRArena* arena, IRValue* value, IRBlock* default_target) {
+    IRInst* inst = ir_inst_new(arena, IR_OP_SWITCH, IR_TYPE_VOID_T, -1);
+    if (!inst) return NULL;
+    ir_inst_add_operand(inst, value);
+    ir_inst_add_operand(inst, ir_value_block(arena, default_target));
+    return inst;
+}
+
+/**
+ * @brief إضافة حالة [قيمة، هدف] إلى تعليمة تفرع.
+ *
+ * المصفوفة في الساحة: عند النمو تُنسخ إلى مصفوفة أكبر وتبقى القديمة حتى تحرير الساحة.
+ */
+void ir_inst_switch_add_case(IRArena* arena, IRInst* sw, int64_t value, IRBlock* target) {
+    if (!sw || sw->op != IR_OP_SWITCH || !target) return;
+
+    if (sw->switch_case_count >= sw->switch_case_capacity) {
+        int new_cap = sw->switch_case_capacity == 0 ? 8 : sw->switch_case_capacity * 2;
+        IRSwitchCase* grown = (IRSwitchCase*)ir_alloc(arena, (size_t)new_cap * sizeof(IRSwitchCase),
+                                                      _Alignof(IRSwitchCase));
+        if (!grown) return;
+        if (sw->switch_case_count > 0) {
+            memcpy(grown, sw->switch_cases, (size_t)sw->switch_case_count * sizeof(IRSwitchCase));
+        }
+        sw->switch_cases = grown;
+        sw->switch_case_capacity = new_cap;
+    }
+
+    sw->switch_cases[sw->switch_case_count].value = value;
+    sw->switch_cases[sw->switch_case_count].target = target;
+    sw->switch_case_count++;
+
+    if (sw->parent && sw->parent->parent) {
+        ir_func_invalidate_defuse(sw->parent->parent);
+    }
+}
+
 /**
  * Create a call instruction
  */
-IRInst* ir_inst_call(const char* target, IRType* ret_type, int dest, 
+IRInst* ir_inst_call(IRArena* arena, const char* target, IRType* ret_type, int dest, 
                      IRValue** args, int arg_count) {
-    IRInst* inst = ir_inst_new(IR_OP_CALL, ret_type, dest);
+    IRInst* inst = ir_inst_new(arena, IR_OP_CALL, ret_type, dest);
     if (!inst) return NULL;
     
-    inst->call_target = target ? ir_strdup(target) : NULL;
+    inst->call_target = target ? ir_strdup(arena, target) : NULL;
     inst->call_callee = NULL;
     inst->call_arg_count = arg_count;
     
     // Copy arguments
     if (arg_count > 0 && args) {
-        inst->call_args = (IRValue**)ir_alloc((size_t)arg_count * sizeof(IRValue*), _Alignof(IRValue*));
+        inst->call_args = (IRValue**)ir_alloc(arena, (size_t)arg_count * sizeof(IRValue*), _Alignof(IRValue*));
         if (!inst->call_args) {
             inst->call_arg_count = 0;
         } else {
@@ -759,10 +789,10 @@ IRInst* ir_inst_call(const char* target, IRType* ret_type, int dest,
 /**
  * Create an indirect call instruction
  */
-IRInst* ir_inst_call_indirect(IRValue* callee, IRType* ret_type, int dest,
+IRInst* ir_inst_call_indirect(IRArena* arena, IRValue* callee, IRType* ret_type, int dest,
                               IRValue** args, int arg_count)
 {
-    IRInst* inst = ir_inst_new(IR_OP_CALL, ret_type, dest);
+    IRInst* inst = ir_inst_new(arena, IR_OP_CALL, ret_type, dest);
     if (!inst) return NULL;
 
     inst->call_target = NULL;
@@ -771,7 +801,7 @@ IRInst* ir_inst_call_indirect(IRValue* callee, IRType* ret_type, int dest,
 
     // Copy arguments
     if (arg_count > 0 && args) {
-        inst->call_args = (IRValue**)ir_alloc((size_t)arg_count * sizeof(IRValue*), _Alignof(IRValue*));
+        inst->call_args = (IRValue**)ir_alloc(arena, (size_t)arg_count * sizeof(IRValue*), _Alignof(IRValue*));
         if (!inst->call_args) {
             inst->call_arg_count = 0;
         } else {
@@ -787,8 +817,8 @@ IRInst* ir_inst_call_indirect(IRValue* callee, IRType* ret_type, int dest,
 /**
  * Create a phi node
  */
-IRInst* ir_inst_phi(IRType* type, int dest) {
-    IRInst* inst = ir_inst_new(IR_OP_PHI, type, dest);
+IRInst* ir_inst_phi(IRArena* arena, IRType* type, int dest) {
+    IRInst* inst = ir_inst_new(arena, IR_OP_PHI, type, dest);
     if (!inst) return NULL;
     inst->phi_entries = NULL;  // Entries added later
     return inst;
@@ -800,7 +830,7 @@ IRInst* ir_inst_phi(IRType* type, int dest) {
 void ir_inst_phi_add(IRInst* phi, IRValue* value, IRBlock* block) {
     if (!phi || phi->op != IR_OP_PHI || !value || !block) return;
     
-    IRPhiEntry* entry = (IRPhiEntry*)ir_alloc(sizeof(IRPhiEntry), _Alignof(IRPhiEntry));
+    IRPhiEntry* entry = (IRPhiEntry*)ir_alloc(phi->arena, sizeof(IRPhiEntry), _Alignof(IRPhiEntry));
     if (!entry) return;
     
     entry->value = value;
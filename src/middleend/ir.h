@@ -20,6 +20,9 @@
 
 // إعلان مسبق لتجنب دورات تضمين بين ir.h و ir_defuse.h
 typedef struct IRDefUse IRDefUse;
+typedef struct IRLoopInfo IRLoopInfo;
+typedef struct IRAnalysisPassStats IRAnalysisPassStats;
+typedef struct IRAnalysisStats IRAnalysisStats;
 
 // ============================================================================
 // IR Opcodes (أكواد العمليات)
@@ -71,6 +74,7 @@ typedef enum {
     IR_OP_BR,       // قفز - Unconditional branch
     IR_OP_BR_COND,  // قفز_شرط - Conditional branch
     IR_OP_RET,      // رجوع - Return from function
+    IR_OP_SWITCH,   // تفرع - Multi-way branch on an integer value
     IR_OP_CALL,     // نداء - Function call
     
     // --------------------------------------------------------------------
@@ -222,6 +226,15 @@ typedef struct IRPhiEntry {
     struct IRPhiEntry* next;
 } IRPhiEntry;
 
+/**
+ * @struct IRSwitchCase
+ * @brief A single case of a switch (تفرع): [constant value, target block]
+ */
+typedef struct IRSwitchCase {
+    int64_t value;
+    struct IRBlock* target;
+} IRSwitchCase;
+
 /**
  * @struct IRInst
  * @brief Represents a single IR instruction.
@@ -248,6 +261,11 @@ typedef struct IRInst {
     
     // For Phi nodes
     IRPhiEntry* phi_entries;    // Linked list of [value, block] pairs
+
+    // For switch (تفرع): operands[0] = value, operands[1] = default block
+    IRSwitchCase* switch_cases; // Case array (arena)
+    int switch_case_count;
+    int switch_case_capacity;
     
     // For calls
     char* call_target;          // Function name
@@ -265,6 +283,9 @@ typedef struct IRInst {
 
     // الأب (الكتلة التي تحتوي التعليمة)
     struct IRBlock* parent;
+
+    // الساحة المالكة للتعليمة (لتخصيص مدخلات فاي لاحقاً)
+    IRArena* arena;
     
     // Linked list within block
     struct IRInst* prev;
@@ -298,8 +319,9 @@ typedef struct IRBlock {
     int inst_count;
     
     // Control flow graph edges
-    struct IRBlock* succs[2];   // Successors (0-2 for br/br_cond)
+    struct IRBlock** succs;     // Successors (dynamic array; distinct targets for switch)
     int succ_count;
+    int succ_capacity;
     
     struct IRBlock** preds;     // Predecessors (dynamic array)
     int pred_count;
@@ -333,7 +355,11 @@ typedef struct IRParam {
  * @brief Represents a function in the IR.
  */
 typedef struct IRFunc {
-    // ملاحظة: هذه البنية تُخصَّص داخل ساحة IR (Arena) وتُحرَّر دفعة واحدة.
+    // ملاحظة: هذه البنية تُخصَّص داخل ساحتها الخاصة وتُحرَّر مع الوحدة دفعة واحدة.
+    // كل كائنات IR المحلية للدالة (كتل/تعليمات/قيم/أنواع) تُخصَّص من `arena`،
+    // لذا يمكن لخيوط مختلفة تعديل دوال مختلفة دون مشاركة مُخصِّص.
+    IRArena arena;
+
     char* name;                 // Function name
     IRType* ret_type;           // Return type
     
@@ -357,6 +383,21 @@ typedef struct IRFunc {
 
     // كاش Def-Use (تحليل) — يُخصّص على heap ويُعاد بناؤه عند التغييرات.
     IRDefUse* def_use;
+
+    // كاش تحليلات CFG (preds/السيطرة/الحلقات) — يديره ir_analysis_manager.c.
+    // كل تحليل صالح فقط إن كان بته في analysis_valid وختمه يساوي ir_epoch.
+    uint32_t analysis_valid;
+    uint32_t preds_epoch;
+    uint32_t dom_epoch;
+    uint32_t loops_epoch;
+    uint32_t analysis_pass_epoch; // ir_epoch عند بدء التمريرة الحالية
+    IRLoopInfo* loop_info;        // معلومات الحلقات المخزنة (heap)
+    IRAnalysisPassStats* analysis_counts; // عدّادات التمريرة الجارية أو NULL
+
+    // المُحسِّن لكل دالة: آخر نقطة تثبيت بلغتها الدالة (ir_epoch + المستوى).
+    // الدالة لا تدخل خط التحسين مجدداً ما لم يتغير epoch منذ ذلك الحين.
+    uint32_t opt_clean_epoch;
+    uint8_t opt_clean_level;      // 0 = لم تبلغ نقطة تثبيت بعد
     
     // Block ID counter
     int next_block_id;
@@ -365,6 +406,9 @@ typedef struct IRFunc {
     bool is_prototype;
     bool is_variadic;            // هل الدالة متغيرة المعاملات ( ... )
     
+    // الوحدة المالكة (يضبطها ir_module_add_func)؛ للقراءة فقط أثناء التحسين.
+    struct IRModule* module;
+
     // Linked list of functions in module
     struct IRFunc* next;
 } IRFunc;
@@ -421,14 +465,11 @@ typedef struct IRBaaStringEntry {
  * @brief Represents a complete IR module (translation unit).
  */
 typedef struct IRModule {
-    // ملاحظة: هذه البنية تُخصَّص بـ malloc وتحتوي على ساحة IR.
+    // ملاحظة: هذه البنية تُخصَّص بـ malloc وتحتوي على ساحة IR.
     char* name;                 // Module name (source file)
 
-    // ساحة ذاكرة IR: كل كائنات IR تُخصَّص منها.
+    // ساحة الوحدة: العوام ومُهيِّئاتها والنصوص وما يُبنى خارج أي دالة.
     IRArena arena;
-
-    // كاش داخلي لأنواع شائعة لكل وحدة
-    IRType* cached_i8_ptr_type;
     
     // Global variables
     IRGlobal* globals;
@@ -445,14 +486,10 @@ typedef struct IRModule {
     // Baa string table (as حرف[])
     IRBaaStringEntry* baa_strings;
     int baa_string_count;
-} IRModule;
-
-// ============================================================================
-// سياق الساحة (Arena) للوحدة الحالية
-// ============================================================================
 
-void ir_module_set_current(IRModule* module);
-IRModule* ir_module_get_current(void);
+    // عدّادات كاش التحليلات أثناء ir_optimizer_run() (من IROptimizerOptions) أو NULL.
+    IRAnalysisStats* analysis_stats;
+} IRModule;
 
 // ============================================================================
 // Predefined Types (أنواع محددة مسبقاً)
@@ -512,9 +549,13 @@ char* int_to_arabic_numerals(int n, char* buf);
 // Type Construction Functions
 // ============================================================================
 
-IRType* ir_type_ptr(IRType* pointee);
-IRType* ir_type_array(IRType* element, int count);
-IRType* ir_type_func(IRType* ret, IRType** params, int param_count);
+//
+// كل دوال البناء تأخذ الساحة المالكة صراحةً: `&func->arena` لما يخص دالة،
+// و`&module->arena` لما يخص الوحدة (العوام ومُهيِّئاتها). لا توجد وحدة "حالية" ضمنية.
+
+IRType* ir_type_ptr(IRArena* arena, IRType* pointee);
+IRType* ir_type_array(IRArena* arena, IRType* element, int count);
+IRType* ir_type_func(IRArena* arena, IRType* ret, IRType** params, int param_count);
 void ir_type_free(IRType* type);
 int ir_types_equal(IRType* a, IRType* b);
 int ir_type_bits(IRType* type);
@@ -523,38 +564,40 @@ int ir_type_bits(IRType* type);
 // Value Construction Functions
 // ============================================================================
 
-IRValue* ir_value_reg(int reg_num, IRType* type);
-IRValue* ir_value_const_int(int64_t value, IRType* type);
-IRValue* ir_value_const_str(const char* str, int id);
-IRValue* ir_value_baa_str(const char* str, int id);
-IRValue* ir_value_block(IRBlock* block);
-IRValue* ir_value_global(const char* name, IRType* type);
-IRValue* ir_value_func_ref(const char* name, IRType* type);
+IRValue* ir_value_reg(IRArena* arena, int reg_num, IRType* type);
+IRValue* ir_value_const_int(IRArena* arena, int64_t value, IRType* type);
+IRValue* ir_value_const_str(IRArena* arena, const char* str, int id);
+IRValue* ir_value_baa_str(IRArena* arena, const char* str, int id);
+IRValue* ir_value_block(IRArena* arena, IRBlock* block);
+IRValue* ir_value_global(IRArena* arena, const char* name, IRType* type);
+IRValue* ir_value_func_ref(IRArena* arena, const char* name, IRType* type);
 void ir_value_free(IRValue* val);
 
 // ============================================================================
 // Instruction Construction Functions
 // ============================================================================
 
-IRInst* ir_inst_new(IROp op, IRType* type, int dest);
+IRInst* ir_inst_new(IRArena* arena, IROp op, IRType* type, int dest);
 void ir_inst_add_operand(IRInst* inst, IRValue* operand);
 void ir_inst_set_loc(IRInst* inst, const char* file, int line, int col);
 void ir_inst_set_dbg_name(IRInst* inst, const char* name);
-IRInst* ir_inst_binary(IROp op, IRType* type, int dest, IRValue* lhs, IRValue* rhs);
-IRInst* ir_inst_unary(IROp op, IRType* type, int dest, IRValue* operand);
-IRInst* ir_inst_cmp(IRCmpPred pred, int dest, IRValue* lhs, IRValue* rhs);
-IRInst* ir_inst_alloca(IRType* type, int dest);
-IRInst* ir_inst_load(IRType* type, int dest, IRValue* ptr);
-IRInst* ir_inst_store(IRValue* value, IRValue* ptr);
-IRInst* ir_inst_ptr_offset(IRType* ptr_type, int dest, IRValue* base, IRValue* index);
-IRInst* ir_inst_br(IRBlock* target);
-IRInst* ir_inst_br_cond(IRValue* cond, IRBlock* if_true, IRBlock* if_false);
-IRInst* ir_inst_ret(IRValue* value);
-IRInst* ir_inst_call(const char* target, IRType* ret_type, int dest,
+IRInst* ir_inst_binary(IRArena* arena, IROp op, IRType* type, int dest, IRValue* lhs, IRValue* rhs);
+IRInst* ir_inst_unary(IRArena* arena, IROp op, IRType* type, int dest, IRValue* operand);
+IRInst* ir_inst_cmp(IRArena* arena, IRCmpPred pred, int dest, IRValue* lhs, IRValue* rhs);
+IRInst* ir_inst_alloca(IRArena* arena, IRType* type, int dest);
+IRInst* ir_inst_load(IRArena* arena, IRType* type, int dest, IRValue* ptr);
+IRInst* ir_inst_store(IRArena* arena, IRValue* value, IRValue* ptr);
+IRInst* ir_inst_ptr_offset(IRArena* arena, IRType* ptr_type, int dest, IRValue* base, IRValue* index);
+IRInst* ir_inst_br(IRArena* arena, IRBlock* target);
+IRInst* ir_inst_br_cond(IRArena* arena, IRValue* cond, IRBlock* if_true, IRBlock* if_false);
+IRInst* ir_inst_ret(IRArena* arena, IRValue* value);
+IRInst* ir_inst_switch(IRArena* arena, IRValue* value, IRBlock* default_target);
+void ir_inst_switch_add_case(IRArena* arena, IRInst* sw, int64_t value, IRBlock* target);
+IRInst* ir_inst_call(IRArena* arena, const char* target, IRType* ret_type, int dest,
                      IRValue** args, int arg_count);
-IRInst* ir_inst_call_indirect(IRValue* callee, IRType* ret_type, int dest,
+IRInst* ir_inst_call_indirect(IRArena* arena, IRValue* callee, IRType* ret_type, int dest,
                               IRValue** args, int arg_count);
-IRInst* ir_inst_phi(IRType* type, int dest);
+IRInst* ir_inst_phi(IRArena* arena, IRType* type, int dest);
 void ir_inst_phi_add(IRInst* phi, IRValue* value, IRBlock* block);
 void ir_inst_free(IRInst* inst);
 
@@ -562,7 +605,7 @@ void ir_inst_free(IRInst* inst);
 // Block Construction Functions
 // ============================================================================
 
-IRBlock* ir_block_new(const char* label, int id);
+IRBlock* ir_block_new(IRArena* arena, const char* label, int id);
 void ir_block_append(IRBlock* block, IRInst* inst);
 void ir_block_add_pred(IRBlock* block, IRBlock* pred);
 void ir_block_add_succ(IRBlock* block, IRBlock* succ);
@@ -573,7 +616,7 @@ void ir_block_free(IRBlock* block);
 // Function Construction Functions
 // ============================================================================
 
-IRFunc* ir_func_new(const char* name, IRType* ret_type);
+IRFunc* ir_func_new(const char* name, IRType* ret_type); // تنشئ ساحة الدالة الخاصة
 int ir_func_alloc_reg(IRFunc* func);
 int ir_func_alloc_block_id(IRFunc* func);
 void ir_func_add_block(IRFunc* func, IRBlock* block);
@@ -585,7 +628,7 @@ void ir_func_free(IRFunc* func);
 // Global Variable Construction Functions
 // ============================================================================
 
-IRGlobal* ir_global_new(const char* name, IRType* type, int is_const);
+IRGlobal* ir_global_new(IRArena* arena, const char* name, IRType* type, int is_const);
 void ir_global_set_init(IRGlobal* global, IRValue* init);
 void ir_global_free(IRGlobal* global);
 
@@ -603,6 +646,7 @@ IRGlobal* ir_module_find_global(IRModule* module, const char* name);
 const char* ir_module_get_string(IRModule* module, int id);
 const char* ir_module_get_baa_string(IRModule* module, int id);
 void ir_module_free(IRModule* module);
+void ir_module_arena_stats(const IRModule* module, IRArenaStats* out_stats); // مجموع ساحة الوحدة وساحات دوالها
 
 // ============================================================================
 // Printing Functions (for --dump-ir)
@@ -0,0 +1,431 @@
+/**
+ * @file ir_alias.c
+ * @brief تنفيذ تحليل التسمية المستعارة الأساسي وملخصات نداءات وقت التشغيل.
+ */
+
+#include "ir_alias.h"
+
+#include "ir_data_layout.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/** حد عمق سلاسل التحويل/الإزاحة عند التفكيك. */
+#define IR_ALIAS_MAX_DEPTH 32
+
+struct IRAliasInfo {
+    IRFunc* func;
+    IRModule* module;  // لحجوم المتغيرات العامة فقط (قائمة العوامّ ثابتة أثناء التحسين)
+    IRDefUse* du;
+    int max_reg;
+    unsigned char* escaped;  // لكل سجل `حجز`: هل هرب عنوانه؟
+};
+
+// -----------------------------------------------------------------------------
+// ملخصات النداءات المعروفة
+// -----------------------------------------------------------------------------
+
+// دوال المكتبة المعروفة: لا تلمس ذاكرة المستخدم إلا عبر وسائطها.
+// private_state: تقرأ/تكتب حالة خاصة (errno، FILE، مخازن ساكنة) تصلها المؤشرات المجهولة فقط.
+typedef struct {
+    const char* name;
+    unsigned char private_state;
+} IRCallSummary;
+
+static const IRCallSummary k_call_summaries[] = {
+    {"اطبع", 1}, {"اطبع_صحيح", 1}, {"printf", 1}, {"اطبع_منسقا", 1},
+    {"snprintf", 1}, {"نسق_في_مخزن", 1},
+    {"scanf", 1}, {"اقرأ_منسقا", 1},
+    {"getchar", 1}, {"اقرأ_محرف_سي", 1},
+    {"puts", 1}, {"اطبع_سطر_سي", 1},
+    {"strlen", 0}, {"طول_سلسلة_سي", 0},
+    {"malloc", 1}, {"ذاكرة_احجز", 1},
+    {"calloc", 1}, {"ذاكرة_احجز_مصفرة", 1},
+    {"realloc", 1}, {"ذاكرة_اعد_الحجز", 1},
+    {"free", 1}, {"ذاكرة_حرر", 1},
+    {"memcpy", 0}, {"ذاكرة_انسخ", 0},
+    {"memset", 0}, {"ذاكرة_املأ", 0},
+    {"sqrt", 1}, {"جذر_تربيعي_سي", 1},
+    {"pow", 1}, {"اس_سي", 1},
+    {"sin", 1}, {"جيب_سي", 1},
+    {"cos", 1}, {"جيب_تمام_سي", 1},
+    {"tan", 1}, {"ظل_سي", 1},
+    {"llabs", 0}, {"مطلق_صحيح_سي", 0},
+    {"rand", 1}, {"عشوائي_سي", 1},
+    {"getenv", 1}, {"متغير_بيئة_سي", 1},
+    {"system", 1}, {"نفذ_نظام_سي", 1},
+    {"time", 1}, {"وقت_حالي_سي", 1},
+    {"ctime", 1}, {"وقت_كنص_سي", 1},
+    {"baa_fopen_utf8", 1}, {"افتح_ملف_بترميز_موحد", 1},
+    {"fclose", 1}, {"اغلق_ملف_سي", 1},
+    {"fgetc", 1}, {"اقرأ_محرف_ملف_سي", 1},
+    {"fputc", 1}, {"اكتب_محرف_ملف_سي", 1},
+    {"fread", 1}, {"اقرأ_كتلة_ملف_سي", 1},
+    {"fwrite", 1}, {"اكتب_كتلة_ملف_سي", 1},
+    {"feof", 1}, {"نهاية_ملف_سي", 1},
+    {"ftello", 1}, {"موقع_ملف_سي", 1},
+    {"fseeko", 1}, {"اذهب_لموقع_ملف_سي", 1},
+    {"fputs", 1}, {"اكتب_سلسلة_ملف_سي", 1},
+    {"exit", 1}, {"انه_العملية_سي", 1},
+    {"strerror", 1}, {"نص_خطأ_النظام_سي", 1},
+    {"__errno_location", 1}, {"موقع_خطأ_النظام_سي", 1},
+};
+
+// وسائط مؤشرات لا يحتفظ بها النداء بعد العودة، مع أثره على ذاكرتها.
+// وسيط مؤشر غير مدرج (مثل realloc) يُعامل كهروب.
+typedef struct {
+    const char* name;
+    int first_arg;
+    int last_arg;  // -1 = حتى آخر وسيط
+    unsigned char effect;
+} IRCallArgEffect;
+
+static const IRCallArgEffect k_call_arg_effects[] = {
+    // الطباعة المنسقة تقرأ السلاسل، و%n قد يكتب عبر أي وسيط.
+    {"اطبع", 0, -1, IR_MODREF_REF},
+    {"اطبع_صحيح", 0, -1, IR_MODREF_REF},
+    {"printf", 0, -1, IR_MODREF_MODREF},
+    {"اطبع_منسقا", 0, -1, IR_MODREF_MODREF},
+    {"snprintf", 0, 0, IR_MODREF_MOD},
+    {"snprintf", 2, -1, IR_MODREF_MODREF},
+    {"نسق_في_مخزن", 0, 0, IR_MODREF_MOD},
+    {"نسق_في_مخزن", 2, -1, IR_MODREF_MODREF},
+    {"scanf", 0, 0, IR_MODREF_REF},
+    {"scanf", 1, -1, IR_MODREF_MOD},
+    {"اقرأ_منسقا", 0, 0, IR_MODREF_REF},
+    {"اقرأ_منسقا", 1, -1, IR_MODREF_MOD},
+    {"puts", 0, 0, IR_MODREF_REF},
+    {"اطبع_سطر_سي", 0, 0, IR_MODREF_REF},
+    {"strlen", 0, 0, IR_MODREF_REF},
+    {"طول_سلسلة_سي", 0, 0, IR_MODREF_REF},
+    {"free", 0, 0, IR_MODREF_MOD},
+    {"ذاكرة_حرر", 0, 0, IR_MODREF_MOD},
+    {"memcpy", 0, 0, IR_MODREF_MOD},
+    {"memcpy", 1, 1, IR_MODREF_REF},
+    {"ذاكرة_انسخ", 0, 0, IR_MODREF_MOD},
+    {"ذاكرة_انسخ", 1, 1, IR_MODREF_REF},
+    {"memset", 0, 0, IR_MODREF_MOD},
+    {"ذاكرة_املأ", 0, 0, IR_MODREF_MOD},
+    {"getenv", 0, 0, IR_MODREF_REF},
+    {"متغير_بيئة_سي", 0, 0, IR_MODREF_REF},
+    {"system", 0, 0, IR_MODREF_REF},
+    {"نفذ_نظام_سي", 0, 0, IR_MODREF_REF},
+    {"time", 0, 0, IR_MODREF_MOD},
+    {"وقت_حالي_سي", 0, 0, IR_MODREF_MOD},
+    {"ctime", 0, 0, IR_MODREF_REF},
+    {"وقت_كنص_سي", 0, 0, IR_MODREF_REF},
+    {"baa_fopen_utf8", 0, 1, IR_MODREF_REF},
+    {"افتح_ملف_بترميز_موحد", 0, 1, IR_MODREF_REF},
+    {"fclose", 0, 0, IR_MODREF_MODREF},
+    {"اغلق_ملف_سي", 0, 0, IR_MODREF_MODREF},
+    {"fgetc", 0, 0, IR_MODREF_MODREF},
+    {"اقرأ_محرف_ملف_سي", 0, 0, IR_MODREF_MODREF},
+    {"fputc", 1, 1, IR_MODREF_MODREF},
+    {"اكتب_محرف_ملف_سي", 1, 1, IR_MODREF_MODREF},
+    {"fread", 0, 0, IR_MODREF_MOD},
+    {"fread", 3, 3, IR_MODREF_MODREF},
+    {"اقرأ_كتلة_ملف_سي", 0, 0, IR_MODREF_MOD},
+    {"اقرأ_كتلة_ملف_سي", 3, 3, IR_MODREF_MODREF},
+    {"fwrite", 0, 0, IR_MODREF_REF},
+    {"fwrite", 3, 3, IR_MODREF_MODREF},
+    {"اكتب_كتلة_ملف_سي", 0, 0, IR_MODREF_REF},
+    {"اكتب_كتلة_ملف_سي", 3, 3, IR_MODREF_MODREF},
+    {"feof", 0, 0, IR_MODREF_MODREF},
+    {"نهاية_ملف_سي", 0, 0, IR_MODREF_MODREF},
+    {"ftello", 0, 0, IR_MODREF_MODREF},
+    {"موقع_ملف_سي", 0, 0, IR_MODREF_MODREF},
+    {"fseeko", 0, 0, IR_MODREF_MODREF},
+    {"اذهب_لموقع_ملف_سي", 0, 0, IR_MODREF_MODREF},
+    {"fputs", 0, 0, IR_MODREF_REF},
+    {"fputs", 1, 1, IR_MODREF_MODREF},
+    {"اكتب_سلسلة_ملف_سي", 0, 0, IR_MODREF_REF},
+    {"اكتب_سلسلة_ملف_سي", 1, 1, IR_MODREF_MODREF},
+};
+
+/** هل تعرّف الوحدة دالة بجسم بنفس اسم المستدعى؟ عندها لا ينطبق ملخص المكتبة. */
+static bool ir_alias_callee_is_defined(const IRInst* call) {
+    IRModule* module = (call->parent && call->parent->parent) ? call->parent->parent->module : NULL;
+    IRFunc* f = ir_module_find_func(module, call->call_target);
+    return f && !f->is_prototype;
+}
+
+static const IRCallSummary* ir_alias_call_summary(const IRInst* call) {
+    if (!call || call->op != IR_OP_CALL || call->call_callee || !call->call_target) return NULL;
+    if (ir_alias_callee_is_defined(call)) return NULL;
+    for (size_t i = 0; i < sizeof(k_call_summaries) / sizeof(k_call_summaries[0]); i++) {
+        if (strcmp(k_call_summaries[i].name, call->call_target) == 0) return &k_call_summaries[i];
+    }
+    return NULL;
+}
+
+int ir_alias_call_arg_effect(const IRInst* call, int arg) {
+    if (!ir_alias_call_summary(call)) return -1;
+    for (size_t i = 0; i < sizeof(k_call_arg_effects) / sizeof(k_call_arg_effects[0]); i++) {
+        const IRCallArgEffect* e = &k_call_arg_effects[i];
+        if (arg < e->first_arg || (e->last_arg >= 0 && arg > e->last_arg)) continue;
+        if (strcmp(e->name, call->call_target) != 0) continue;
+        return e->effect;
+    }
+    return -1;
+}
+
+// -----------------------------------------------------------------------------
+// تفكيك العناوين
+// -----------------------------------------------------------------------------
+
+static IRInst* ir_alias_def(const IRAliasInfo* ai, IRValue* v) {
+    if (!ai || !ai->du || !v || v->kind != IR_VAL_REG) return NULL;
+    int r = v->data.reg_num;
+    if (r < 0 || r >= ai->max_reg) return NULL;
+    return ai->du->def_inst_by_reg[r];
+}
+
+static int ir_alias_pointee_size(IRType* ptr_type) {
+    if (!ptr_type || ptr_type->kind != IR_TYPE_PTR || !ptr_type->data.pointee) return 0;
+    int size = ir_type_store_size(NULL, ptr_type->data.pointee);
+    return size > 0 ? size : 0;
+}
+
+static void ir_alias_decompose(const IRAliasInfo* ai, IRValue* v, IRMemLoc* out, int depth) {
+    if (!v) return;
+
+    if (v->kind == IR_VAL_GLOBAL) {
+        out->kind = IR_MEM_BASE_GLOBAL;
+        out->global = v->data.global_name;
+        // مرجع المصفوفة العامة قد يحمل نوع العنصر؛ الحجم الحقيقي من تعريفها.
+        IRGlobal* g = ai ? ir_module_find_global(ai->module, v->data.global_name) : NULL;
+        int size = (g && g->type) ? ir_type_store_size(NULL, g->type) : 0;
+        out->object_size = size > 0 ? size : ir_alias_pointee_size(v->type);
+        return;
+    }
+    if (v->kind != IR_VAL_REG) return;
+
+    out->base_reg = v->data.reg_num;
+    IRInst* def = ir_alias_def(ai, v);
+    if (!def || depth >= IR_ALIAS_MAX_DEPTH) return;
+
+    switch (def->op) {
+        case IR_OP_ALLOCA:
+            out->kind = IR_MEM_BASE_ALLOCA;
+            out->object_size = ir_alias_pointee_size(def->type);
+            return;
+
+        case IR_OP_CAST: {
+            // تحويل مؤشر إلى مؤشر يحفظ القاعدة؛ عدد إلى مؤشر يبقى مجهولاً.
+            IRValue* src = def->operand_count >= 1 ? def->operands[0] : NULL;
+            if (!src || !src->type || src->type->kind != IR_TYPE_PTR) return;
+            if (!def->type || def->type->kind != IR_TYPE_PTR) return;
+            ir_alias_decompose(ai, src, out, depth + 1);
+            return;
+        }
+
+        case IR_OP_PTR_OFFSET: {
+            if (def->operand_count < 2 || !def->type || def->type->kind != IR_TYPE_PTR) return;
+            ir_alias_decompose(ai, def->operands[0], out, depth + 1);
+            IRValue* idx = def->operands[1];
+            int elem = ir_alias_pointee_size(def->type);
+            if (!idx || idx->kind != IR_VAL_CONST_INT || elem <= 0) {
+                out->offset_known = false;
+            } else {
+                out->offset += idx->data.const_int * (int64_t)elem;
+            }
+            return;
+        }
+
+        default:
+            return;
+    }
+}
+
+void ir_alias_loc_of(const IRAliasInfo* ai, IRValue* ptr, int size, IRMemLoc* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    out->kind = IR_MEM_BASE_UNKNOWN;
+    out->base_reg = -1;
+    out->offset_known = true;
+    out->size = size > 0 ? size : 0;
+    ir_alias_decompose(ai, ptr, out, 0);
+}
+
+bool ir_alias_inst_loc(const IRAliasInfo* ai, IRInst* inst, IRMemLoc* out) {
+    if (!inst) return false;
+    if (inst->op == IR_OP_LOAD) {
+        if (inst->operand_count < 1 || !inst->operands[0] || !inst->type) return false;
+        ir_alias_loc_of(ai, inst->operands[0], ir_type_store_size(NULL, inst->type), out);
+        return true;
+    }
+    if (inst->op == IR_OP_STORE) {
+        if (inst->operand_count < 2 || !inst->operands[0] || !inst->operands[1]) return false;
+        if (!inst->operands[0]->type) return false;
+        ir_alias_loc_of(ai, inst->operands[1], ir_type_store_size(NULL, inst->operands[0]->type), out);
+        return true;
+    }
+    return false;
+}
+
+bool ir_alias_loc_may_escape(const IRAliasInfo* ai, const IRMemLoc* loc) {
+    if (!loc) return true;
+    if (loc->kind != IR_MEM_BASE_ALLOCA) return true;
+    if (!ai || loc->base_reg < 0 || loc->base_reg >= ai->max_reg) return true;
+    return ai->escaped[loc->base_reg] != 0;
+}
+
+bool ir_alias_loc_is_dereferenceable(const IRMemLoc* loc) {
+    if (!loc || loc->kind == IR_MEM_BASE_UNKNOWN) return false;
+    if (!loc->offset_known || loc->size <= 0 || loc->object_size <= 0) return false;
+    return loc->offset >= 0 && loc->offset + loc->size <= loc->object_size;
+}
+
+// -----------------------------------------------------------------------------
+// هروب الحجوزات
+// -----------------------------------------------------------------------------
+
+static void ir_alias_escape_value(IRAliasInfo* ai, IRValue* v) {
+    if (!v || v->kind != IR_VAL_REG) return;
+    IRMemLoc loc;
+    ir_alias_loc_of(ai, v, 0, &loc);
+    if (loc.kind == IR_MEM_BASE_ALLOCA && loc.base_reg >= 0 && loc.base_reg < ai->max_reg) {
+        ai->escaped[loc.base_reg] = 1;
+    }
+}
+
+static void ir_alias_compute_escapes(IRAliasInfo* ai) {
+    for (IRBlock* b = ai->func->blocks; b; b = b->next) {
+        for (IRInst* inst = b->first; inst; inst = inst->next) {
+            switch (inst->op) {
+                case IR_OP_LOAD:
+                case IR_OP_ALLOCA:
+                    break;
+
+                case IR_OP_STORE:
+                    // المؤشر كعنوان لا يهرب؛ المؤشر كقيمة مخزَّنة يهرب.
+                    if (inst->operand_count >= 1) ir_alias_escape_value(ai, inst->operands[0]);
+                    break;
+
+                case IR_OP_CAST:
+                    if (!inst->type || inst->type->kind != IR_TYPE_PTR) {
+                        for (int i = 0; i < inst->operand_count; i++) ir_alias_escape_value(ai, inst->operands[i]);
+                    }
+                    break;
+
+                case IR_OP_PTR_OFFSET:
+                    for (int i = 1; i < inst->operand_count; i++) ir_alias_escape_value(ai, inst->operands[i]);
+                    break;
+
+                case IR_OP_CMP:
+                    // مقارنة العناوين لا تكشفها للذاكرة.
+                    break;
+
+                case IR_OP_CALL:
+                    ir_alias_escape_value(ai, inst->call_callee);
+                    for (int i = 0; i < inst->call_arg_count; i++) {
+                        if (!inst->call_args) break;
+                        if (ir_alias_call_arg_effect(inst, i) < 0) ir_alias_escape_value(ai, inst->call_args[i]);
+                    }
+                    break;
+
+                case IR_OP_PHI:
+                    for (IRPhiEntry* e = inst->phi_entries; e; e = e->next) ir_alias_escape_value(ai, e->value);
+                    break;
+
+                default:
+                    for (int i = 0; i < inst->operand_count; i++) ir_alias_escape_value(ai, inst->operands[i]);
+                    break;
+            }
+        }
+    }
+}
+
+IRAliasInfo* ir_alias_info_build(IRFunc* func) {
+    if (!func) return NULL;
+
+    IRAliasInfo* ai = (IRAliasInfo*)calloc(1, sizeof(IRAliasInfo));
+    if (!ai) return NULL;
+
+    ai->func = func;
+    ai->module = func->module;
+    ai->du = ir_defuse_build(func);
+    if (!ai->du) {
+        free(ai);
+        return NULL;
+    }
+    ai->max_reg = ai->du->max_reg;
+    ai->escaped = (unsigned char*)calloc((size_t)(ai->max_reg > 0 ? ai->max_reg : 1), 1);
+    if (!ai->escaped) {
+        ir_alias_info_free(ai);
+        return NULL;
+    }
+
+    ir_alias_compute_escapes(ai);
+    return ai;
+}
+
+void ir_alias_info_free(IRAliasInfo* ai) {
+    if (!ai) return;
+    ir_defuse_free(ai->du);
+    free(ai->escaped);
+    free(ai);
+}
+
+// -----------------------------------------------------------------------------
+// الاستعلامات
+// -----------------------------------------------------------------------------
+
+static IRAliasResult ir_alias_same_base(const IRMemLoc* a, const IRMemLoc* b) {
+    if (!a->offset_known || !b->offset_known) return IR_ALIAS_MAY;
+    if (a->size > 0 && b->size > 0) {
+        if (a->offset + a->size <= b->offset || b->offset + b->size <= a->offset) return IR_ALIAS_NO;
+        if (a->offset == b->offset && a->size == b->size) return IR_ALIAS_MUST;
+    }
+    return IR_ALIAS_MAY;
+}
+
+IRAliasResult ir_alias_query(const IRAliasInfo* ai, const IRMemLoc* a, const IRMemLoc* b) {
+    if (!a || !b) return IR_ALIAS_MAY;
+
+    if (a->kind == IR_MEM_BASE_UNKNOWN && b->kind == IR_MEM_BASE_UNKNOWN) {
+        if (a->base_reg >= 0 && a->base_reg == b->base_reg) return ir_alias_same_base(a, b);
+        return IR_ALIAS_MAY;
+    }
+
+    // مؤشر مجهول مقابل قاعدة معروفة: يصلها فقط إن هرب عنوانها.
+    if (a->kind == IR_MEM_BASE_UNKNOWN) return ir_alias_loc_may_escape(ai, b) ? IR_ALIAS_MAY : IR_ALIAS_NO;
+    if (b->kind == IR_MEM_BASE_UNKNOWN) return ir_alias_loc_may_escape(ai, a) ? IR_ALIAS_MAY : IR_ALIAS_NO;
+
+    if (a->kind != b->kind) return IR_ALIAS_NO;
+    if (a->kind == IR_MEM_BASE_ALLOCA && a->base_reg != b->base_reg) return IR_ALIAS_NO;
+    if (a->kind == IR_MEM_BASE_GLOBAL && (!a->global || !b->global || strcmp(a->global, b->global) != 0)) {
+        return IR_ALIAS_NO;
+    }
+    return ir_alias_same_base(a, b);
+}
+
+int ir_alias_call_modref(const IRAliasInfo* ai, IRInst* call, const IRMemLoc* loc) {
+    if (!call || call->op != IR_OP_CALL || !loc) return IR_MODREF_NONE;
+
+    const IRCallSummary* summary = ir_alias_call_summary(call);
+    if (!summary) {
+        // دالة مستخدم أو نداء غير مباشر: كل ما قد يصله مؤشر.
+        return ir_alias_loc_may_escape(ai, loc) ? IR_MODREF_MODREF : IR_MODREF_NONE;
+    }
+
+    int result = IR_MODREF_NONE;
+    if (summary->private_state && loc->kind == IR_MEM_BASE_UNKNOWN) result = IR_MODREF_MODREF;
+
+    for (int i = 0; i < call->call_arg_count && result != IR_MODREF_MODREF; i++) {
+        IRValue* arg = call->call_args ? call->call_args[i] : NULL;
+        if (!arg) continue;
+        bool is_ptr = (arg->kind == IR_VAL_GLOBAL) || (arg->type && arg->type->kind == IR_TYPE_PTR);
+        if (!is_ptr) continue;
+
+        int effect = ir_alias_call_arg_effect(call, i);
+        if (effect < 0) effect = IR_MODREF_MODREF;
+
+        // الدالة قد تصل الكائن كله عبر الوسيط، لا البايتات المعنونة فقط.
+        IRMemLoc arg_loc;
+        ir_alias_loc_of(ai, arg, 0, &arg_loc);
+        arg_loc.offset_known = false;
+        if (ir_alias_query(ai, &arg_loc, loc) != IR_ALIAS_NO) result |= effect;
+    }
+    return result;
+}
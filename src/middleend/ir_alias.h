@@ -0,0 +1,119 @@
+/**
+ * @file ir_alias.h
+ * @brief تحليل التسمية المستعارة (Alias Analysis) الأساسي لعمليات الذاكرة في IR.
+ *
+ * كل عنوان يُفكَّك عبر سلسلة `تحويل`/`إزاحة_مؤشر` إلى قاعدة + إزاحة:
+ * - `حجز` محلي، أو متغير عام (`@اسم`)، أو مؤشر مجهول (معامل/ناتج نداء/قيمة محمَّلة).
+ * - الإزاحة معروفة بالبايت إن كانت كل فهارس `إزاحة_مؤشر` ثابتة.
+ *
+ * قواعد الحكم:
+ * - حجزان مختلفان، أو متغيران عامان مختلفان، أو حجز مقابل عام: لا تداخل.
+ * - نفس القاعدة بإزاحتين معروفتين: مقارنة المدى [إزاحة، إزاحة+حجم).
+ * - حجز لا يهرب عنوانه لا يصل إليه أي مؤشر مجهول ولا أي نداء.
+ *
+ * ملخصات النداءات: دوال مكتبة وقت التشغيل المعروفة (بأسمائها في C وأسماء
+ * `arabic_abi_runtime.c`) لا تلمس إلا ذاكرة وسائطها وحالتها الخاصة (errno،
+ * FILE، المخازن الساكنة)، ولا تحتفظ بمؤشرات الوسائط المدرجة في الجدول. الملخص لا
+ * ينطبق إن عرّفت الوحدة دالة بجسم بنفس الاسم؛ تُعامَل عندها كأي دالة مستخدم.
+ *
+ * التحليل محلي للدالة: لا يقرأ IR دوال أخرى (المُحسِّن يوزّع الدوال على خيوط).
+ */
+
+#ifndef BAA_IR_ALIAS_H
+#define BAA_IR_ALIAS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ir.h"
+#include "ir_defuse.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    IR_ALIAS_NO = 0,   // لا تداخل مؤكد
+    IR_ALIAS_MAY = 1,  // قد يتداخلان
+    IR_ALIAS_MUST = 2  // نفس البايتات تماماً
+} IRAliasResult;
+
+/** أثر نداء على موقع ذاكرة (أقنعة بتات). */
+enum {
+    IR_MODREF_NONE = 0,
+    IR_MODREF_REF = 1,
+    IR_MODREF_MOD = 2,
+    IR_MODREF_MODREF = 3
+};
+
+typedef enum {
+    IR_MEM_BASE_UNKNOWN = 0,  // مؤشر مجهول المصدر
+    IR_MEM_BASE_ALLOCA,       // base_reg = سجل `حجز`
+    IR_MEM_BASE_GLOBAL        // global = اسم المتغير العام
+} IRMemBaseKind;
+
+/**
+ * @brief موقع ذاكرة مفكَّك: قاعدة + إزاحة + حجم الوصول.
+ */
+typedef struct {
+    IRMemBaseKind kind;
+    int base_reg;          // ALLOCA: سجل الحجز؛ UNKNOWN: سجل المؤشر (-1 إن لم يكن سجلاً)
+    const char* global;    // GLOBAL
+    int64_t offset;        // بالبايت من القاعدة
+    bool offset_known;
+    int size;              // حجم الوصول بالبايت (0 = مجهول/الكائن كله)
+    int object_size;       // حجم كائن القاعدة إن عُرف (حجز/عام)، وإلا 0
+} IRMemLoc;
+
+typedef struct IRAliasInfo IRAliasInfo;
+
+/**
+ * @brief بناء معلومات التسمية لدالة: تعريفات السجلات + هروب كل `حجز`.
+ *
+ * المعلومات تبقى صالحة بعد حذف/نقل الحمل والخزن وإعادة تسمية استعمالات
+ * السجلات، ما دامت تعليمات `حجز`/`تحويل`/`إزاحة_مؤشر` لم تُحذف.
+ */
+IRAliasInfo* ir_alias_info_build(IRFunc* func);
+
+/** تحرير معلومات التسمية (NULL-safe). */
+void ir_alias_info_free(IRAliasInfo* ai);
+
+/**
+ * @brief تفكيك عنوان إلى موقع ذاكرة.
+ * @param size حجم الوصول بالبايت (0 = مجهول).
+ */
+void ir_alias_loc_of(const IRAliasInfo* ai, IRValue* ptr, int size, IRMemLoc* out);
+
+/**
+ * @brief موقع عنوان تعليمة `حمل`/`خزن` بحجم النوع المحمَّل/المخزَّن.
+ * @return false إن لم تكن التعليمة وصولاً صالحاً.
+ */
+bool ir_alias_inst_loc(const IRAliasInfo* ai, IRInst* inst, IRMemLoc* out);
+
+/** هل يهرب عنوان هذا الموقع (قاعدة حجز هارب أو عام أو مجهول)؟ */
+bool ir_alias_loc_may_escape(const IRAliasInfo* ai, const IRMemLoc* loc);
+
+/**
+ * @brief هل الوصول بكامله داخل كائن قاعدة معروف (فلا مصيدة عند تنفيذه مبكراً)؟
+ */
+bool ir_alias_loc_is_dereferenceable(const IRMemLoc* loc);
+
+/** الحكم على موقعين. */
+IRAliasResult ir_alias_query(const IRAliasInfo* ai, const IRMemLoc* a, const IRMemLoc* b);
+
+/**
+ * @brief أثر نداء على موقع ذاكرة: IR_MODREF_* (محافظ عند الجهل).
+ */
+int ir_alias_call_modref(const IRAliasInfo* ai, IRInst* call, const IRMemLoc* loc);
+
+/**
+ * @brief أثر نداء على ذاكرة وسيطه المؤشري رقم arg حسب جدول الملخصات.
+ * @return IR_MODREF_REF/MOD/MODREF، أو -1 إن كان النداء مجهولاً أو قد يحتفظ بالمؤشر.
+ */
+int ir_alias_call_arg_effect(const IRInst* call, int arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BAA_IR_ALIAS_H
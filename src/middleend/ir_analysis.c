@@ -10,6 +10,7 @@
  */
 
 #include "ir_analysis.h"
+#include "ir_analysis_manager.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -19,7 +20,7 @@
 // ============================================================================
 
 static int ir_is_terminator_op(IROp op) {
-    return op == IR_OP_BR || op == IR_OP_BR_COND || op == IR_OP_RET;
+    return op == IR_OP_BR || op == IR_OP_BR_COND || op == IR_OP_SWITCH || op == IR_OP_RET;
 }
 
 static void ir_clear_preds(IRBlock* block) {
@@ -35,8 +36,7 @@ static void ir_clear_preds(IRBlock* block) {
 
 static void ir_clear_succs(IRBlock* block) {
     if (!block) return;
-    block->succs[0] = NULL;
-    block->succs[1] = NULL;
+    // نحتفظ بالمصفوفة لإعادة استخدامها؛ تُحرّر مع كاشات التحليل.
     block->succ_count = 0;
 }
 
@@ -103,6 +103,15 @@ bool ir_func_validate_cfg(IRFunc* func) {
                 break;
             }
 
+            case IR_OP_SWITCH: {
+                if (term->operand_count < 2 || !term->operands[0]) return false;
+                if (!ir_block_from_block_value(term->operands[1])) return false;
+                for (int i = 0; i < term->switch_case_count; i++) {
+                    if (!term->switch_cases[i].target) return false;
+                }
+                break;
+            }
+
             case IR_OP_RET:
                 // رجوع قد يملك 0 معاملات (void) أو 1 معامل.
                 if (term->operand_count > 1) return false;
@@ -164,6 +173,21 @@ void ir_func_rebuild_preds(IRFunc* func) {
             continue;
         }
 
+        if (term->op == IR_OP_SWITCH) {
+            // خلف واحد لكل هدف مختلف: الافتراضي أولاً ثم الحالات بترتيبها.
+            IRBlock* def = ir_block_from_block_value(term->operands[1]);
+            if (def) ir_block_add_succ(b, def);
+            for (int i = 0; i < term->switch_case_count; i++) {
+                IRBlock* target = term->switch_cases[i].target;
+                int seen = (target == NULL);
+                for (int k = 0; k < b->succ_count && !seen; k++) {
+                    if (b->succs[k] == target) seen = 1;
+                }
+                if (!seen) ir_block_add_succ(b, target);
+            }
+            continue;
+        }
+
         // IR_OP_RET: no successors.
     }
 
@@ -171,6 +195,10 @@ void ir_func_rebuild_preds(IRFunc* func) {
     if (func->entry) {
         func->entry->idom = func->entry;
     }
+
+    // Fresh edges: cached dominators/loops no longer describe this CFG.
+    ir_analysis_invalidate(func, IR_ANALYSIS_DOMINATORS | IR_ANALYSIS_LOOPS);
+    ir_analysis_mark_valid(func, IR_ANALYSIS_PREDS);
 }
 
 void ir_module_rebuild_preds(IRModule* module) {
@@ -256,6 +284,13 @@ void ir_func_compute_dominators(IRFunc* func) {
 
     // Ensure CFG edges are consistent with terminators.
     ir_func_rebuild_preds(func);
+    ir_func_compute_dominators_from_preds(func);
+}
+
+void ir_func_compute_dominators_from_preds(IRFunc* func) {
+    if (!func) return;
+    if (func->is_prototype) return;
+    if (!func->entry) return;
 
     int max_id = ir_func_max_block_id(func);
     if (max_id <= 0) return;
@@ -374,6 +409,8 @@ void ir_func_compute_dominators(IRFunc* func) {
     free(postorder);
     free(rpo);
     free(rpo_num);
+
+    ir_analysis_mark_valid(func, IR_ANALYSIS_DOMINATORS);
 }
 
 void ir_module_compute_dominators(IRModule* module) {
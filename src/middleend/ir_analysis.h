@@ -51,7 +51,8 @@ bool ir_module_validate_cfg(IRModule* module);
  * This clears `succs[]/succ_count` and rebuilds them from the terminator
  * instruction of each block. Predecessor arrays (`preds[]`) are also rebuilt.
  *
- * Dominance caches (idom/frontier) are cleared as part of this rebuild.
+ * Dominance caches (idom/frontier) are cleared as part of this rebuild, and
+ * the analysis manager drops its cached dominators and loop info.
  */
 void ir_func_rebuild_preds(IRFunc* func);
 
@@ -76,6 +77,13 @@ void ir_module_rebuild_preds(IRModule* module);
  */
 void ir_func_compute_dominators(IRFunc* func);
 
+/**
+ * @brief Compute dominators from the current succ/pred edges without rebuilding them.
+ *
+ * Used by the analysis manager when cached edges are still valid.
+ */
+void ir_func_compute_dominators_from_preds(IRFunc* func);
+
 /**
  * @brief Compute dominators for every function in a module.
  */
@@ -0,0 +1,247 @@
+/**
+ * @file ir_analysis_manager.c
+ * @brief تنفيذ مدير تحليلات IR (كاش preds/السيطرة/الحلقات + عدّادات لكل تمريرة).
+ */
+
+#include "ir_analysis_manager.h"
+
+#include "ir_analysis.h"
+#include "ir_loop.h"
+
+#include <string.h>
+
+// ============================================================================
+// عدّادات الإصابة/الإخفاق
+// ============================================================================
+
+enum {
+    AM_KIND_PREDS = 0,
+    AM_KIND_DOMINATORS,
+    AM_KIND_LOOPS,
+};
+
+static IRAnalysisPassStats* am_stats_for(IRAnalysisStats* stats, const char* pass) {
+    if (!stats) return NULL;
+    if (!pass) pass = "خارج_المُحسِّن";
+
+    for (int i = 0; i < stats->pass_count; i++) {
+        if (stats->passes[i].pass == pass || strcmp(stats->passes[i].pass, pass) == 0) {
+            return &stats->passes[i];
+        }
+    }
+    if (stats->pass_count >= IR_ANALYSIS_MAX_PASS_STATS) {
+        return &stats->passes[IR_ANALYSIS_MAX_PASS_STATS - 1];
+    }
+
+    IRAnalysisPassStats* s = &stats->passes[stats->pass_count++];
+    memset(s, 0, sizeof(*s));
+    s->pass = pass;
+    return s;
+}
+
+static void am_note(IRFunc* func, int kind, bool hit) {
+    IRAnalysisPassStats* s = func->analysis_counts;
+    if (!s) return;
+    if (hit) s->hits[kind]++;
+    else s->misses[kind]++;
+}
+
+// ============================================================================
+// الصلاحية
+// ============================================================================
+
+static uint32_t* am_epoch_slot(IRFunc* func, uint32_t kind) {
+    switch (kind) {
+        case IR_ANALYSIS_PREDS:      return &func->preds_epoch;
+        case IR_ANALYSIS_DOMINATORS: return &func->dom_epoch;
+        case IR_ANALYSIS_LOOPS:      return &func->loops_epoch;
+        default:                     return NULL;
+    }
+}
+
+static bool am_is_valid(IRFunc* func, uint32_t kind) {
+    if (!(func->analysis_valid & kind)) return false;
+    uint32_t* slot = am_epoch_slot(func, kind);
+    return slot && *slot == func->ir_epoch;
+}
+
+void ir_analysis_mark_valid(IRFunc* func, uint32_t kinds) {
+    if (!func) return;
+    for (uint32_t k = IR_ANALYSIS_PREDS; k <= IR_ANALYSIS_LOOPS; k <<= 1) {
+        if (!(kinds & k)) continue;
+        *am_epoch_slot(func, k) = func->ir_epoch;
+        func->analysis_valid |= k;
+    }
+}
+
+void ir_analysis_invalidate(IRFunc* func, uint32_t kinds) {
+    if (!func) return;
+    func->analysis_valid &= ~kinds;
+}
+
+void ir_func_invalidate_cfg(IRFunc* func) {
+    if (!func) return;
+    func->ir_epoch++;
+    func->analysis_valid = 0;
+}
+
+void ir_analysis_func_release(IRFunc* func) {
+    if (!func) return;
+    if (func->loop_info) {
+        ir_loop_info_free(func->loop_info);
+        func->loop_info = NULL;
+    }
+    func->analysis_valid &= ~IR_ANALYSIS_LOOPS;
+}
+
+// ============================================================================
+// الطلبات
+// ============================================================================
+
+void ir_analysis_require_preds(IRFunc* func) {
+    if (!func || func->is_prototype) return;
+
+    if (am_is_valid(func, IR_ANALYSIS_PREDS)) {
+        am_note(func, AM_KIND_PREDS, true);
+        return;
+    }
+    am_note(func, AM_KIND_PREDS, false);
+    // تعيد البناء وتختم PREDS وتُسقط السيطرة/الحلقات.
+    ir_func_rebuild_preds(func);
+}
+
+void ir_analysis_require_dominators(IRFunc* func) {
+    if (!func || func->is_prototype || !func->entry) return;
+
+    if (am_is_valid(func, IR_ANALYSIS_DOMINATORS)) {
+        am_note(func, AM_KIND_DOMINATORS, true);
+        return;
+    }
+    ir_analysis_require_preds(func);
+    am_note(func, AM_KIND_DOMINATORS, false);
+    ir_func_compute_dominators_from_preds(func);
+}
+
+IRLoopInfo* ir_analysis_require_loops(IRFunc* func) {
+    if (!func || func->is_prototype || !func->entry) return NULL;
+
+    if (am_is_valid(func, IR_ANALYSIS_LOOPS)) {
+        am_note(func, AM_KIND_LOOPS, true);
+        return func->loop_info;
+    }
+    ir_analysis_require_dominators(func);
+    am_note(func, AM_KIND_LOOPS, false);
+
+    if (func->loop_info) {
+        ir_loop_info_free(func->loop_info);
+        func->loop_info = NULL;
+    }
+    func->loop_info = ir_loop_info_build(func);
+    if (func->loop_info) {
+        ir_analysis_mark_valid(func, IR_ANALYSIS_LOOPS);
+    }
+    return func->loop_info;
+}
+
+// ============================================================================
+// حدود التمريرات
+// ============================================================================
+
+static void am_func_begin(IRFunc* f, IRAnalysisPassStats* counts) {
+    // الأختام القديمة (تغيّرات خارج أي تمريرة) لا تُعاد إحياؤها لاحقاً.
+    for (uint32_t k = IR_ANALYSIS_PREDS; k <= IR_ANALYSIS_LOOPS; k <<= 1) {
+        if ((f->analysis_valid & k) && !am_is_valid(f, k)) {
+            f->analysis_valid &= ~k;
+        }
+    }
+    f->analysis_pass_epoch = f->ir_epoch;
+    f->analysis_counts = counts;
+}
+
+static void am_func_end(IRFunc* f, uint32_t preserved) {
+    f->analysis_counts = NULL;
+    if (f->ir_epoch == f->analysis_pass_epoch) return;
+
+    // التمريرة غيّرت الدالة: المحفوظ يبقى صالحاً، والباقي يسقط.
+    uint32_t keep = f->analysis_valid & preserved;
+    f->analysis_valid = 0;
+    ir_analysis_mark_valid(f, keep);
+}
+
+void ir_analysis_pass_begin(IRModule* module, const char* pass_name) {
+    if (!module) return;
+
+    IRAnalysisPassStats* counts = am_stats_for(module->analysis_stats, pass_name);
+    for (IRFunc* f = module->funcs; f; f = f->next) {
+        am_func_begin(f, counts);
+    }
+}
+
+void ir_analysis_pass_end(IRModule* module, uint32_t preserved) {
+    if (!module) return;
+
+    for (IRFunc* f = module->funcs; f; f = f->next) {
+        am_func_end(f, preserved);
+    }
+}
+
+void ir_analysis_func_pass_begin(IRFunc* func, IRAnalysisStats* stats, const char* pass_name) {
+    if (!func) return;
+    am_func_begin(func, am_stats_for(stats, pass_name));
+}
+
+void ir_analysis_func_pass_end(IRFunc* func, uint32_t preserved) {
+    if (func) am_func_end(func, preserved);
+}
+
+// ============================================================================
+// الجمع والطباعة
+// ============================================================================
+
+void ir_analysis_stats_merge(IRAnalysisStats* dst, const IRAnalysisStats* src) {
+    if (!dst || !src) return;
+
+    for (int i = 0; i < src->pass_count; i++) {
+        const IRAnalysisPassStats* s = &src->passes[i];
+        IRAnalysisPassStats* d = am_stats_for(dst, s->pass);
+        for (int k = 0; k < IR_ANALYSIS_KIND_COUNT; k++) {
+            d->hits[k] += s->hits[k];
+            d->misses[k] += s->misses[k];
+        }
+    }
+}
+
+void ir_analysis_stats_print(const IRAnalysisStats* stats, FILE* out) {
+    if (!stats || !out) return;
+
+    uint64_t hits[IR_ANALYSIS_KIND_COUNT] = {0};
+    uint64_t misses[IR_ANALYSIS_KIND_COUNT] = {0};
+
+    for (int i = 0; i < stats->pass_count; i++) {
+        const IRAnalysisPassStats* s = &stats->passes[i];
+        fprintf(out,
+                "[ANALYSIS] pass=%s preds_hit=%llu preds_miss=%llu dom_hit=%llu dom_miss=%llu "
+                "loops_hit=%llu loops_miss=%llu\n",
+                s->pass,
+                (unsigned long long)s->hits[AM_KIND_PREDS],
+                (unsigned long long)s->misses[AM_KIND_PREDS],
+                (unsigned long long)s->hits[AM_KIND_DOMINATORS],
+                (unsigned long long)s->misses[AM_KIND_DOMINATORS],
+                (unsigned long long)s->hits[AM_KIND_LOOPS],
+                (unsigned long long)s->misses[AM_KIND_LOOPS]);
+        for (int k = 0; k < IR_ANALYSIS_KIND_COUNT; k++) {
+            hits[k] += s->hits[k];
+            misses[k] += s->misses[k];
+        }
+    }
+
+    fprintf(out,
+            "[ANALYSIS] pass=total preds_hit=%llu preds_miss=%llu dom_hit=%llu dom_miss=%llu "
+            "loops_hit=%llu loops_miss=%llu\n",
+            (unsigned long long)hits[AM_KIND_PREDS],
+            (unsigned long long)misses[AM_KIND_PREDS],
+            (unsigned long long)hits[AM_KIND_DOMINATORS],
+            (unsigned long long)misses[AM_KIND_DOMINATORS],
+            (unsigned long long)hits[AM_KIND_LOOPS],
+            (unsigned long long)misses[AM_KIND_LOOPS]);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file ir_analysis_manager.h
+ * @brief مدير تحليلات IR: كاش preds/السيطرة/الحلقات لكل دالة عبر تمريرات المُحسِّن.
+ *
+ * كل دالة تحمل نتائج آخر بناء لكل تحليل مختومة بـ `IRFunc::ir_epoch`.
+ * يكون التحليل صالحاً ما دام بته مضبوطاً وختمه يساوي epoch الحالي، فتحصل
+ * التمريرات على النتيجة المخزنة بدلاً من إعادة الحساب.
+ *
+ * التمريرات تصرّح بما تحافظ عليه (`IRPass::preserves`). عند انتهاء تمريرة:
+ * - التحليلات المحفوظة في الدوال التي تغيّرت يُعاد ختمها بالـ epoch الجديد.
+ * - غير المحفوظة تبقى بختمها القديم فتُعاد عند أول طلب.
+ *
+ * أي تعديل على CFG خارج هذا التصريح يجب أن يمر عبر `ir_func_rebuild_preds()`
+ * أو `ir_func_invalidate_cfg()`؛ كلاهما يُسقط السيطرة والحلقات المخزنة.
+ */
+
+#ifndef BAA_IR_ANALYSIS_MANAGER_H
+#define BAA_IR_ANALYSIS_MANAGER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "ir.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief أنواع التحليلات التي يخزنها المدير (أقنعة بتات).
+ */
+typedef enum {
+    IR_ANALYSIS_PREDS      = 1u << 0, /**< succs/preds لكل كتلة */
+    IR_ANALYSIS_DOMINATORS = 1u << 1, /**< idom + حدود السيطرة */
+    IR_ANALYSIS_LOOPS      = 1u << 2, /**< معلومات الحلقات الطبيعية */
+} IRAnalysisKind;
+
+/** عدد التمريرات التي تُعدّ لها الإصابات؛ الزائد يُجمع في آخر خانة. */
+#define IR_ANALYSIS_MAX_PASS_STATS 32
+
+/** عدد أنواع التحليلات المعدودة (preds، السيطرة، الحلقات). */
+#define IR_ANALYSIS_KIND_COUNT 3
+
+/**
+ * @brief عدّادات الإصابة/الإخفاق لتمريرة واحدة.
+ */
+typedef struct IRAnalysisPassStats {
+    const char* pass;
+    uint64_t hits[IR_ANALYSIS_KIND_COUNT];
+    uint64_t misses[IR_ANALYSIS_KIND_COUNT];
+} IRAnalysisPassStats;
+
+/**
+ * @brief عدّادات كاش التحليلات لتشغيل مُحسِّن واحد.
+ *
+ * يملكها المستدعي ويمررها عبر `IROptimizerOptions::analysis_stats`؛ تبدأ
+ * مصفّرة (`= {0}`) ولا يحتفظ المدير بأي عدّاد عام.
+ */
+typedef struct IRAnalysisStats {
+    IRAnalysisPassStats passes[IR_ANALYSIS_MAX_PASS_STATS];
+    int pass_count;
+} IRAnalysisStats;
+
+/** لا تحافظ التمريرة على أي تحليل (تعدّل CFG). */
+#define IR_ANALYSIS_NONE 0u
+/** تحافظ التمريرة على شكل CFG كاملاً (لا تضيف/تحذف كتلاً أو حواف). */
+#define IR_ANALYSIS_CFG_ALL (IR_ANALYSIS_PREDS | IR_ANALYSIS_DOMINATORS | IR_ANALYSIS_LOOPS)
+
+/**
+ * @brief ضمان أن succs/preds حديثة (من الكاش أو بإعادة البناء).
+ */
+void ir_analysis_require_preds(IRFunc* func);
+
+/**
+ * @brief ضمان أن idom وحدود السيطرة حديثة (يتطلب preds).
+ */
+void ir_analysis_require_dominators(IRFunc* func);
+
+/**
+ * @brief معلومات الحلقات للدالة (يتطلب السيطرة).
+ *
+ * @return معلومات مملوكة للكاش — لا تُحرَّر عبر ir_loop_info_free()، وتبقى
+ *         صالحة حتى الطلب التالي بعد إبطالها أو حتى تحرير الوحدة.
+ */
+IRLoopInfo* ir_analysis_require_loops(IRFunc* func);
+
+/**
+ * @brief تسجيل أن التحليلات المعطاة حُسبت للتو على epoch الحالي.
+ */
+void ir_analysis_mark_valid(IRFunc* func, uint32_t kinds);
+
+/**
+ * @brief إسقاط التحليلات المعطاة من الكاش دون لمس IR.
+ */
+void ir_analysis_invalidate(IRFunc* func, uint32_t kinds);
+
+/**
+ * @brief إعلان تغيّر CFG: زيادة epoch وإسقاط كل التحليلات المخزنة.
+ */
+void ir_func_invalidate_cfg(IRFunc* func);
+
+/**
+ * @brief تحرير ما يملكه الكاش على الـ heap (معلومات الحلقات).
+ */
+void ir_analysis_func_release(IRFunc* func);
+
+/**
+ * @brief بدء تمريرة على الوحدة: تنظيف الأختام القديمة وربط العدّادات باسمها.
+ *
+ * تُعدّ طلبات التمريرة في `module->analysis_stats` إن لم يكن NULL.
+ */
+void ir_analysis_pass_begin(IRModule* module, const char* pass_name);
+
+/**
+ * @brief إنهاء التمريرة: إعادة ختم التحليلات المحفوظة في الدوال التي تغيّرت.
+ *
+ * @param preserved قناع IR_ANALYSIS_* الذي تصرّح التمريرة بالمحافظة عليه.
+ */
+void ir_analysis_pass_end(IRModule* module, uint32_t preserved);
+
+/**
+ * @brief مثل ir_analysis_pass_begin() لكن لدالة واحدة من الوحدة (المُحسِّن لكل دالة).
+ *
+ * تُعدّ الطلبات في @p stats إن لم يكن NULL؛ عمال --threads يمرر كل منهم عدّاداته.
+ */
+void ir_analysis_func_pass_begin(IRFunc* func, IRAnalysisStats* stats, const char* pass_name);
+
+/**
+ * @brief مثل ir_analysis_pass_end() لكن لدالة واحدة.
+ */
+void ir_analysis_func_pass_end(IRFunc* func, uint32_t preserved);
+
+/**
+ * @brief إضافة عدّادات @p src إلى @p dst (تمريرات جديدة تُلحق بترتيب ظهورها في src).
+ */
+void ir_analysis_stats_merge(IRAnalysisStats* dst, const IRAnalysisStats* src);
+
+/**
+ * @brief طباعة سطر `[ANALYSIS]` لكل تمريرة طلبت تحليلاً، ثم سطر الإجمالي.
+ */
+void ir_analysis_stats_print(const IRAnalysisStats* stats, FILE* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BAA_IR_ANALYSIS_MANAGER_H
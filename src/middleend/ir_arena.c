@@ -8,7 +8,8 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define IR_ARENA_MIN_CHUNK_SIZE (64u * 1024u)
+#define IR_ARENA_DEFAULT_CHUNK_SIZE (64u * 1024u)
+#define IR_ARENA_MIN_CHUNK_SIZE (4u * 1024u)
 
 static size_t ir_align_up(size_t x, size_t align) {
     if (align == 0) return x;
@@ -23,7 +24,7 @@ static size_t ir_max_size(size_t a, size_t b) {
 void ir_arena_init(IRArena* arena, size_t default_chunk_size) {
     if (!arena) return;
     arena->head = NULL;
-    arena->default_chunk_size = default_chunk_size;
+    arena->default_chunk_size = default_chunk_size ? default_chunk_size : IR_ARENA_DEFAULT_CHUNK_SIZE;
     if (arena->default_chunk_size < IR_ARENA_MIN_CHUNK_SIZE) {
         arena->default_chunk_size = IR_ARENA_MIN_CHUNK_SIZE;
     }
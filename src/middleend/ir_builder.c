@@ -16,9 +16,6 @@
 // ============================================================================
 
 IRBuilder* ir_builder_new(IRModule* module) {
-    // ضمان أن تخصيصات IR التالية تذهب لساحة هذه الوحدة.
-    ir_module_set_current(module);
-
     IRBuilder* builder = (IRBuilder*)malloc(sizeof(IRBuilder));
     if (!builder) {
         fprintf(stderr, "خطأ: فشل تخصيص باني النواة\n");
@@ -26,9 +23,12 @@ IRBuilder* ir_builder_new(IRModule* module) {
     }
     
     builder->module = module;
+    builder->arena = module ? &module->arena : NULL;
     builder->current_func = NULL;
     builder->insert_block = NULL;
     builder->src_file = NULL;
+    builder->src_file_key = NULL;
+    builder->src_file_copy = NULL;
     builder->src_line = 0;
     builder->src_col = 0;
     builder->insts_emitted = 0;
@@ -45,8 +45,9 @@ void ir_builder_free(IRBuilder* builder) {
 
 void ir_builder_set_module(IRBuilder* builder, IRModule* module) {
     if (!builder) return;
-    ir_module_set_current(module);
     builder->module = module;
+    builder->arena = builder->current_func ? &builder->current_func->arena
+                                           : (module ? &module->arena : NULL);
 }
 
 // ============================================================================
@@ -61,6 +62,7 @@ IRFunc* ir_builder_create_func(IRBuilder* builder, const char* name, IRType* ret
     
     ir_module_add_func(builder->module, func);
     builder->current_func = func;
+    builder->arena = &func->arena;
     builder->insert_block = NULL;
     
     return func;
@@ -82,6 +84,7 @@ int ir_builder_add_param(IRBuilder* builder, const char* name, IRType* type) {
 void ir_builder_set_func(IRBuilder* builder, IRFunc* func) {
     if (!builder) return;
     builder->current_func = func;
+    builder->arena = func ? &func->arena : (builder->module ? &builder->module->arena : NULL);
     builder->insert_block = NULL;
 }
 
@@ -138,7 +141,7 @@ int ir_builder_alloc_reg(IRBuilder* builder) {
 
 IRValue* ir_builder_reg_value(IRBuilder* builder, int reg, IRType* type) {
     (void)builder;  // Unused, but kept for API consistency
-    return ir_value_reg(reg, type);
+    return ir_value_reg(builder->arena, reg, type);
 }
 
 // ============================================================================
@@ -147,7 +150,15 @@ IRValue* ir_builder_reg_value(IRBuilder* builder, int reg, IRType* type) {
 
 void ir_builder_set_loc(IRBuilder* builder, const char* file, int line, int col) {
     if (!builder) return;
-    builder->src_file = file;
+    // الـ IR يعيش بعد تحرير ساحة الـ AST، لذا يُنسخ اسم الملف إلى ساحة الوحدة
+    // مرة واحدة لكل ملف مصدر (تتكرر نفس المؤشرات عبر عقد الملف الواحد).
+    if (file && file != builder->src_file_key) {
+        if (!builder->src_file_copy || strcmp(builder->src_file_copy, file) != 0) {
+            builder->src_file_copy = builder->module ? ir_arena_strdup(&builder->module->arena, file) : NULL;
+        }
+        builder->src_file_key = file;
+    }
+    builder->src_file = file ? builder->src_file_copy : NULL;
     builder->src_line = line;
     builder->src_col = col;
 }
@@ -183,7 +194,7 @@ int ir_builder_emit_add(IRBuilder* builder, IRType* type, IRValue* lhs, IRValue*
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_binary(IR_OP_ADD, type, dest, lhs, rhs);
+    IRInst* inst = ir_inst_binary(builder->arena, IR_OP_ADD, type, dest, lhs, rhs);
     emit_inst(builder, inst);
     return dest;
 }
@@ -192,7 +203,7 @@ int ir_builder_emit_sub(IRBuilder* builder, IRType* type, IRValue* lhs, IRValue*
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_binary(IR_OP_SUB, type, dest, lhs, rhs);
+    IRInst* inst = ir_inst_binary(builder->arena, IR_OP_SUB, type, dest, lhs, rhs);
     emit_inst(builder, inst);
     return dest;
 }
@@ -201,7 +212,7 @@ int ir_builder_emit_mul(IRBuilder* builder, IRType* type, IRValue* lhs, IRValue*
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_binary(IR_OP_MUL, type, dest, lhs, rhs);
+    IRInst* inst = ir_inst_binary(builder->arena, IR_OP_MUL, type, dest, lhs, rhs);
     emit_inst(builder, inst);
     return dest;
 }
@@ -210,7 +221,7 @@ int ir_builder_emit_div(IRBuilder* builder, IRType* type, IRValue* lhs, IRValue*
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_binary(IR_OP_DIV, type, dest, lhs, rhs);
+    IRInst* inst = ir_inst_binary(builder->arena, IR_OP_DIV, type, dest, lhs, rhs);
     emit_inst(builder, inst);
     return dest;
 }
@@ -219,7 +230,7 @@ int ir_builder_emit_mod(IRBuilder* builder, IRType* type, IRValue* lhs, IRValue*
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_binary(IR_OP_MOD, type, dest, lhs, rhs);
+    IRInst* inst = ir_inst_binary(builder->arena, IR_OP_MOD, type, dest, lhs, rhs);
     emit_inst(builder, inst);
     return dest;
 }
@@ -228,7 +239,7 @@ int ir_builder_emit_neg(IRBuilder* builder, IRType* type, IRValue* operand) {
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_unary(IR_OP_NEG, type, dest, operand);
+    IRInst* inst = ir_inst_unary(builder->arena, IR_OP_NEG, type, dest, operand);
     emit_inst(builder, inst);
     return dest;
 }
@@ -241,7 +252,7 @@ int ir_builder_emit_alloca(IRBuilder* builder, IRType* type) {
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_alloca(type, dest);
+    IRInst* inst = ir_inst_alloca(builder->arena, type, dest);
     emit_inst(builder, inst);
     return dest;
 }
@@ -250,7 +261,7 @@ int ir_builder_emit_load(IRBuilder* builder, IRType* type, IRValue* ptr) {
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_load(type, dest, ptr);
+    IRInst* inst = ir_inst_load(builder->arena, type, dest, ptr);
     emit_inst(builder, inst);
     return dest;
 }
@@ -258,7 +269,7 @@ int ir_builder_emit_load(IRBuilder* builder, IRType* type, IRValue* ptr) {
 void ir_builder_emit_store(IRBuilder* builder, IRValue* value, IRValue* ptr) {
     if (!builder) return;
     
-    IRInst* inst = ir_inst_store(value, ptr);
+    IRInst* inst = ir_inst_store(builder->arena, value, ptr);
     emit_inst(builder, inst);
 }
 
@@ -266,7 +277,7 @@ int ir_builder_emit_ptr_offset(IRBuilder* builder, IRType* ptr_type, IRValue* ba
     if (!builder || !builder->current_func) return -1;
 
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_ptr_offset(ptr_type, dest, base, index);
+    IRInst* inst = ir_inst_ptr_offset(builder->arena, ptr_type, dest, base, index);
     emit_inst(builder, inst);
     return dest;
 }
@@ -279,7 +290,7 @@ int ir_builder_emit_cmp(IRBuilder* builder, IRCmpPred pred, IRValue* lhs, IRValu
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_cmp(pred, dest, lhs, rhs);
+    IRInst* inst = ir_inst_cmp(builder->arena, pred, dest, lhs, rhs);
     emit_inst(builder, inst);
     return dest;
 }
@@ -332,7 +343,7 @@ int ir_builder_emit_and(IRBuilder* builder, IRType* type, IRValue* lhs, IRValue*
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_binary(IR_OP_AND, type, dest, lhs, rhs);
+    IRInst* inst = ir_inst_binary(builder->arena, IR_OP_AND, type, dest, lhs, rhs);
     emit_inst(builder, inst);
     return dest;
 }
@@ -341,7 +352,7 @@ int ir_builder_emit_or(IRBuilder* builder, IRType* type, IRValue* lhs, IRValue*
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_binary(IR_OP_OR, type, dest, lhs, rhs);
+    IRInst* inst = ir_inst_binary(builder->arena, IR_OP_OR, type, dest, lhs, rhs);
     emit_inst(builder, inst);
     return dest;
 }
@@ -350,7 +361,7 @@ int ir_builder_emit_xor(IRBuilder* builder, IRType* type, IRValue* lhs, IRValue*
     if (!builder || !builder->current_func) return -1;
 
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_binary(IR_OP_XOR, type, dest, lhs, rhs);
+    IRInst* inst = ir_inst_binary(builder->arena, IR_OP_XOR, type, dest, lhs, rhs);
     emit_inst(builder, inst);
     return dest;
 }
@@ -359,7 +370,7 @@ int ir_builder_emit_not(IRBuilder* builder, IRType* type, IRValue* operand) {
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_unary(IR_OP_NOT, type, dest, operand);
+    IRInst* inst = ir_inst_unary(builder->arena, IR_OP_NOT, type, dest, operand);
     emit_inst(builder, inst);
     return dest;
 }
@@ -368,7 +379,7 @@ int ir_builder_emit_shl(IRBuilder* builder, IRType* type, IRValue* lhs, IRValue*
     if (!builder || !builder->current_func) return -1;
 
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_binary(IR_OP_SHL, type, dest, lhs, rhs);
+    IRInst* inst = ir_inst_binary(builder->arena, IR_OP_SHL, type, dest, lhs, rhs);
     emit_inst(builder, inst);
     return dest;
 }
@@ -377,7 +388,7 @@ int ir_builder_emit_shr(IRBuilder* builder, IRType* type, IRValue* lhs, IRValue*
     if (!builder || !builder->current_func) return -1;
 
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_binary(IR_OP_SHR, type, dest, lhs, rhs);
+    IRInst* inst = ir_inst_binary(builder->arena, IR_OP_SHR, type, dest, lhs, rhs);
     emit_inst(builder, inst);
     return dest;
 }
@@ -389,7 +400,7 @@ int ir_builder_emit_shr(IRBuilder* builder, IRType* type, IRValue* lhs, IRValue*
 void ir_builder_emit_br(IRBuilder* builder, IRBlock* target) {
     if (!builder || !target) return;
     
-    IRInst* inst = ir_inst_br(target);
+    IRInst* inst = ir_inst_br(builder->arena, target);
     emit_inst(builder, inst);
     
     // Update CFG
@@ -402,7 +413,7 @@ void ir_builder_emit_br_cond(IRBuilder* builder, IRValue* cond,
                               IRBlock* if_true, IRBlock* if_false) {
     if (!builder || !if_true || !if_false) return;
     
-    IRInst* inst = ir_inst_br_cond(cond, if_true, if_false);
+    IRInst* inst = ir_inst_br_cond(builder->arena, cond, if_true, if_false);
     emit_inst(builder, inst);
     
     // Update CFG
@@ -412,10 +423,37 @@ void ir_builder_emit_br_cond(IRBuilder* builder, IRValue* cond,
     }
 }
 
+IRInst* ir_builder_emit_switch(IRBuilder* builder, IRValue* value, IRBlock* default_target) {
+    if (!builder || !value || !default_target) return NULL;
+
+    IRInst* inst = ir_inst_switch(builder->arena, value, default_target);
+    emit_inst(builder, inst);
+
+    // Update CFG
+    if (inst && builder->insert_block) {
+        ir_block_add_succ(builder->insert_block, default_target);
+    }
+    return inst;
+}
+
+void ir_builder_add_switch_case(IRBuilder* builder, IRInst* sw, int64_t value, IRBlock* target) {
+    if (!builder || !sw || !target) return;
+
+    ir_inst_switch_add_case(builder->arena, sw, value, target);
+
+    // Update CFG (خلف واحد لكل هدف مختلف)
+    IRBlock* block = sw->parent;
+    if (!block) return;
+    for (int i = 0; i < block->succ_count; i++) {
+        if (block->succs[i] == target) return;
+    }
+    ir_block_add_succ(block, target);
+}
+
 void ir_builder_emit_ret(IRBuilder* builder, IRValue* value) {
     if (!builder) return;
     
-    IRInst* inst = ir_inst_ret(value);
+    IRInst* inst = ir_inst_ret(builder->arena, value);
     emit_inst(builder, inst);
 }
 
@@ -424,7 +462,7 @@ void ir_builder_emit_ret_void(IRBuilder* builder) {
 }
 
 void ir_builder_emit_ret_int(IRBuilder* builder, int64_t value) {
-    IRValue* val = ir_value_const_int(value, IR_TYPE_I64_T);
+    IRValue* val = ir_value_const_int(builder->arena, value, IR_TYPE_I64_T);
     ir_builder_emit_ret(builder, val);
 }
 
@@ -441,7 +479,7 @@ int ir_builder_emit_call(IRBuilder* builder, const char* target, IRType* ret_typ
         dest = ir_builder_alloc_reg(builder);
     }
     
-    IRInst* inst = ir_inst_call(target, ret_type, dest, args, arg_count);
+    IRInst* inst = ir_inst_call(builder->arena, target, ret_type, dest, args, arg_count);
     emit_inst(builder, inst);
     
     return dest;
@@ -457,7 +495,7 @@ int ir_builder_emit_call_indirect(IRBuilder* builder, IRValue* callee, IRType* r
         dest = ir_builder_alloc_reg(builder);
     }
 
-    IRInst* inst = ir_inst_call_indirect(callee, ret_type, dest, args, arg_count);
+    IRInst* inst = ir_inst_call_indirect(builder->arena, callee, ret_type, dest, args, arg_count);
     emit_inst(builder, inst);
     return dest;
 }
@@ -475,7 +513,7 @@ int ir_builder_emit_phi(IRBuilder* builder, IRType* type) {
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_phi(type, dest);
+    IRInst* inst = ir_inst_phi(builder->arena, type, dest);
     emit_inst(builder, inst);
     return dest;
 }
@@ -501,7 +539,7 @@ int ir_builder_emit_copy(IRBuilder* builder, IRType* type, IRValue* source) {
     if (!builder || !builder->current_func) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_unary(IR_OP_COPY, type, dest, source);
+    IRInst* inst = ir_inst_unary(builder->arena, IR_OP_COPY, type, dest, source);
     emit_inst(builder, inst);
     return dest;
 }
@@ -514,7 +552,7 @@ int ir_builder_emit_cast(IRBuilder* builder, IRValue* value, IRType* to_type) {
     if (!builder || !builder->current_func || !value) return -1;
     
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_new(IR_OP_CAST, to_type, dest);
+    IRInst* inst = ir_inst_new(builder->arena, IR_OP_CAST, to_type, dest);
     ir_inst_add_operand(inst, value);
     emit_inst(builder, inst);
     return dest;
@@ -527,7 +565,7 @@ int ir_builder_emit_cast(IRBuilder* builder, IRValue* value, IRType* to_type) {
 void ir_builder_emit_cpu_nop(IRBuilder* builder) {
     if (!builder || !builder->current_func) return;
 
-    IRInst* inst = ir_inst_new(IR_OP_CPU_NOP, IR_TYPE_VOID_T, -1);
+    IRInst* inst = ir_inst_new(builder->arena, IR_OP_CPU_NOP, IR_TYPE_VOID_T, -1);
     emit_inst(builder, inst);
 }
 
@@ -535,7 +573,7 @@ int ir_builder_emit_read_tsc(IRBuilder* builder) {
     if (!builder || !builder->current_func) return -1;
 
     int dest = ir_builder_alloc_reg(builder);
-    IRInst* inst = ir_inst_new(IR_OP_READ_TSC, IR_TYPE_I64_T, dest);
+    IRInst* inst = ir_inst_new(builder->arena, IR_OP_READ_TSC, IR_TYPE_I64_T, dest);
     emit_inst(builder, inst);
     return dest;
 }
@@ -544,34 +582,34 @@ int ir_builder_emit_read_tsc(IRBuilder* builder) {
 // Constant Value Helpers
 // ============================================================================
 
-IRValue* ir_builder_const_int(int64_t value) {
-    return ir_value_const_int(value, IR_TYPE_I64_T);
+IRValue* ir_builder_const_int(IRBuilder* builder, int64_t value) {
+    return ir_value_const_int(builder->arena, value, IR_TYPE_I64_T);
 }
 
-IRValue* ir_builder_const_i64(int64_t value) {
-    return ir_value_const_int(value, IR_TYPE_I64_T);
+IRValue* ir_builder_const_i64(IRBuilder* builder, int64_t value) {
+    return ir_value_const_int(builder->arena, value, IR_TYPE_I64_T);
 }
 
-IRValue* ir_builder_const_i32(int32_t value) {
-    return ir_value_const_int((int64_t)value, IR_TYPE_I32_T);
+IRValue* ir_builder_const_i32(IRBuilder* builder, int32_t value) {
+    return ir_value_const_int(builder->arena, (int64_t)value, IR_TYPE_I32_T);
 }
 
-IRValue* ir_builder_const_bool(int value) {
-    return ir_value_const_int(value ? 1 : 0, IR_TYPE_I1_T);
+IRValue* ir_builder_const_bool(IRBuilder* builder, int value) {
+    return ir_value_const_int(builder->arena, value ? 1 : 0, IR_TYPE_I1_T);
 }
 
 IRValue* ir_builder_const_string(IRBuilder* builder, const char* str) {
     if (!builder || !builder->module || !str) return NULL;
     
     int id = ir_module_add_string(builder->module, str);
-    return ir_value_const_str(str, id);
+    return ir_value_const_str(builder->arena, str, id);
 }
 
 IRValue* ir_builder_const_baa_string(IRBuilder* builder, const char* str) {
     if (!builder || !builder->module || !str) return NULL;
 
     int id = ir_module_add_baa_string(builder->module, str);
-    return ir_value_baa_str(str, id);
+    return ir_value_baa_str(builder->arena, str, id);
 }
 
 // ============================================================================
@@ -582,7 +620,7 @@ IRGlobal* ir_builder_create_global(IRBuilder* builder, const char* name,
                                     IRType* type, int is_const) {
     if (!builder || !builder->module) return NULL;
     
-    IRGlobal* global = ir_global_new(name, type, is_const);
+    IRGlobal* global = ir_global_new(builder->arena, name, type, is_const);
     if (!global) return NULL;
     
     ir_module_add_global(builder->module, global);
@@ -604,7 +642,7 @@ IRValue* ir_builder_get_global(IRBuilder* builder, const char* name) {
     IRGlobal* global = ir_module_find_global(builder->module, name);
     if (!global) return NULL;
     
-    return ir_value_global(name, global->type);
+    return ir_value_global(builder->arena, name, global->type);
 }
 
 // ============================================================================
@@ -15,7 +15,7 @@
  * ir_builder_set_insert_point(builder, entry);
  * 
  * int reg = ir_builder_emit_add(builder, IR_TYPE_I64_T, val1, val2);
- * ir_builder_emit_ret(builder, ir_value_reg(reg, IR_TYPE_I64_T));
+ * ir_builder_emit_ret(builder, ir_value_reg(builder->arena, reg, IR_TYPE_I64_T));
  * 
  * ir_builder_free(builder);
  * ```
@@ -43,10 +43,13 @@
 typedef struct IRBuilder {
     IRModule* module;           // Target module
     IRFunc* current_func;       // Current function being built
+    IRArena* arena;             // ساحة التخصيص: ساحة الدالة الحالية، أو ساحة الوحدة خارج الدوال
     IRBlock* insert_block;      // Current insertion block
     
     // Source location tracking (for debugging)
-    const char* src_file;
+    const char* src_file;       // نسخة داخل ساحة الوحدة (لا تستعير ذاكرة الـ AST)
+    const char* src_file_key;   // آخر مؤشر ملف مُمرَّر من المستدعي
+    const char* src_file_copy;  // نسخته المقابلة في الساحة
     int src_line;
     int src_col;
     
@@ -184,7 +187,7 @@ IRValue* ir_builder_reg_value(IRBuilder* builder, int reg, IRType* type);
 /**
  * @brief Set source location for subsequent instructions.
  * @param builder The builder.
- * @param file Source filename.
+ * @param file Source filename (copied into the module arena; the caller keeps ownership).
  * @param line Line number.
  * @param col Column number.
  */
@@ -378,6 +381,20 @@ void ir_builder_emit_br(IRBuilder* builder, IRBlock* target);
 void ir_builder_emit_br_cond(IRBuilder* builder, IRValue* cond, 
                               IRBlock* if_true, IRBlock* if_false);
 
+/**
+ * @brief Emit multi-way branch: تفرع value, افتراضي default
+ * @param builder The builder.
+ * @param value Integer value to dispatch on.
+ * @param default_target Block taken when no case matches.
+ * @return The switch instruction (cases are added with ir_builder_add_switch_case).
+ */
+IRInst* ir_builder_emit_switch(IRBuilder* builder, IRValue* value, IRBlock* default_target);
+
+/**
+ * @brief Add a case [value, target] to a switch emitted in the current block.
+ */
+void ir_builder_add_switch_case(IRBuilder* builder, IRInst* sw, int64_t value, IRBlock* target);
+
 /**
  * @brief Emit return instruction: رجوع value
  * @param builder The builder.
@@ -501,31 +518,35 @@ int ir_builder_emit_read_tsc(IRBuilder* builder);
 
 /**
  * @brief Create an integer constant value.
+ * @param builder The builder (allocates from its current arena).
  * @param value Integer value.
  * @return IRValue for the constant.
  */
-IRValue* ir_builder_const_int(int64_t value);
+IRValue* ir_builder_const_int(IRBuilder* builder, int64_t value);
 
 /**
  * @brief Create an i64 constant value.
+ * @param builder The builder (allocates from its current arena).
  * @param value Integer value.
  * @return IRValue for the constant.
  */
-IRValue* ir_builder_const_i64(int64_t value);
+IRValue* ir_builder_const_i64(IRBuilder* builder, int64_t value);
 
 /**
  * @brief Create an i32 constant value.
+ * @param builder The builder (allocates from its current arena).
  * @param value Integer value.
  * @return IRValue for the constant.
  */
-IRValue* ir_builder_const_i32(int32_t value);
+IRValue* ir_builder_const_i32(IRBuilder* builder, int32_t value);
 
 /**
  * @brief Create an i1 (boolean) constant value.
+ * @param builder The builder (allocates from its current arena).
  * @param value Boolean value (0 or 1).
  * @return IRValue for the constant.
  */
-IRValue* ir_builder_const_bool(int value);
+IRValue* ir_builder_const_bool(IRBuilder* builder, int value);
 
 /**
  * @brief Create a string constant (adds to module string table).
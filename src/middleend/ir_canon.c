@@ -26,9 +26,13 @@
 // IRPass integration
 // -----------------------------------------------------------------------------
 
+static bool ir_canon_run_func(IRFunc* func);
+
 IRPass IR_PASS_CANON = {
     .name = "توحيد_الـIR",
-    .run = ir_canon_run
+    .run = ir_canon_run,
+    .run_func = ir_canon_run_func,
+    .preserves = IR_ANALYSIS_CFG_ALL
 };
 
 // -----------------------------------------------------------------------------
@@ -184,7 +188,6 @@ bool ir_canon_run(IRModule* module) {
     if (!module) return false;
 
     // ضمان تخصيصات IR داخل هذه الوحدة إن احتجنا مستقبلاً (حتى لو لم نخصّص هنا).
-    ir_module_set_current(module);
 
     int changed = 0;
     for (IRFunc* f = module->funcs; f; f = f->next) {
@@ -193,3 +196,7 @@ bool ir_canon_run(IRModule* module) {
 
     return changed ? true : false;
 }
+
+static bool ir_canon_run_func(IRFunc* func) {
+    return ir_canon_func(func) ? true : false;
+}
@@ -24,6 +24,7 @@
 #include "ir_cfg_simplify.h"
 
 #include "ir_analysis.h"
+#include "ir_analysis_manager.h"
 #include "ir_mutate.h"
 
 #include <stdio.h>
@@ -34,9 +35,13 @@
 // IRPass integration
 // -----------------------------------------------------------------------------
 
+static bool ir_cfg_simplify_run_func(IRFunc* func);
+
 IRPass IR_PASS_CFG_SIMPLIFY = {
     .name = "تبسيط_CFG",
-    .run = ir_cfg_simplify_run
+    .run = ir_cfg_simplify_run,
+    .run_func = ir_cfg_simplify_run_func,
+    .preserves = IR_ANALYSIS_NONE
 };
 
 // -----------------------------------------------------------------------------
@@ -45,7 +50,8 @@ IRPass IR_PASS_CFG_SIMPLIFY = {
 
 static int ir_is_terminator(const IRInst* inst) {
     if (!inst) return 0;
-    return inst->op == IR_OP_BR || inst->op == IR_OP_BR_COND || inst->op == IR_OP_RET;
+    return inst->op == IR_OP_BR || inst->op == IR_OP_BR_COND || inst->op == IR_OP_SWITCH ||
+           inst->op == IR_OP_RET;
 }
 
 static IRBlock* ir_block_from_value(IRValue* v) {
@@ -66,13 +72,16 @@ static int ir_block_has_phi(const IRBlock* block) {
 static void ir_term_replace_target(IRInst* term, IRBlock* old_target, IRBlock* new_target) {
     if (!term || !old_target || !new_target) return;
 
+    // تعديل أهداف المنهي يغيّر CFG: أسقط التحليلات المخزنة للدالة.
+    if (term->parent) ir_func_invalidate_cfg(term->parent->parent);
+
     if (term->op == IR_OP_BR) {
         if (term->operand_count < 1) return;
         IRBlock* cur = ir_block_from_value(term->operands[0]);
         if (cur != old_target) return;
 
         ir_value_free(term->operands[0]);
-        term->operands[0] = ir_value_block(new_target);
+        term->operands[0] = ir_value_block(&old_target->parent->arena, new_target);
         return;
     }
 
@@ -84,11 +93,43 @@ static void ir_term_replace_target(IRInst* term, IRBlock* old_target, IRBlock* n
             if (cur != old_target) continue;
 
             ir_value_free(term->operands[i]);
-            term->operands[i] = ir_value_block(new_target);
+            term->operands[i] = ir_value_block(&old_target->parent->arena, new_target);
+        }
+        return;
+    }
+
+    if (term->op == IR_OP_SWITCH) {
+        if (term->operand_count < 2) return;
+
+        if (ir_block_from_value(term->operands[1]) == old_target) {
+            ir_value_free(term->operands[1]);
+            term->operands[1] = ir_value_block(&old_target->parent->arena, new_target);
+        }
+        for (int i = 0; i < term->switch_case_count; i++) {
+            if (term->switch_cases[i].target == old_target) {
+                term->switch_cases[i].target = new_target;
+            }
         }
     }
 }
 
+/**
+ * @brief هدف `تفرع` تشير كل حالاته إلى الكتلة الافتراضية، وإلا NULL.
+ *
+ * طي القيمة الثابتة يخص SCCP لأنه يحذف حواف ويعدّل `فاي`.
+ */
+static IRBlock* ir_switch_single_target(const IRInst* term) {
+    if (!term || term->op != IR_OP_SWITCH || term->operand_count < 2) return NULL;
+
+    IRBlock* def = ir_block_from_value(term->operands[1]);
+    if (!def) return NULL;
+
+    for (int i = 0; i < term->switch_case_count; i++) {
+        if (term->switch_cases[i].target != def) return NULL;
+    }
+    return def;
+}
+
 IRBlock* ir_cfg_split_critical_edge(IRFunc* func, IRBlock* pred, IRBlock* succ) {
     if (!func || !pred || !succ) return NULL;
     if (func->is_prototype) return NULL;
@@ -129,7 +170,7 @@ IRBlock* ir_cfg_split_critical_edge(IRFunc* func, IRBlock* pred, IRBlock* succ)
     ir_term_replace_target(term, succ, split);
 
     // split: قفز إلى succ
-    IRInst* br = ir_inst_br(succ);
+    IRInst* br = ir_inst_br(&func->arena, succ);
     if (br) {
         ir_block_append(split, br);
     }
@@ -148,17 +189,24 @@ static int ir_cfg_simplify_remove_redundant_brcond(IRFunc* func) {
         if (!b || !b->last) continue;
 
         IRInst* term = b->last;
-        if (term->op != IR_OP_BR_COND) continue;
-        if (term->operand_count < 3) continue;
-
-        IRBlock* t = ir_block_from_value(term->operands[1]);
-        IRBlock* f = ir_block_from_value(term->operands[2]);
-        if (!t || !f) continue;
-
-        if (t != f) continue;
+        IRBlock* t = NULL;
+        if (term->op == IR_OP_BR_COND) {
+            if (term->operand_count < 3) continue;
+
+            t = ir_block_from_value(term->operands[1]);
+            IRBlock* f = ir_block_from_value(term->operands[2]);
+            if (!t || !f) continue;
+
+            if (t != f) continue;
+        } else if (term->op == IR_OP_SWITCH) {
+            t = ir_switch_single_target(term);
+            if (!t) continue;
+        } else {
+            continue;
+        }
 
         // استبدال br_cond بـ br
-        IRInst* br = ir_inst_br(t);
+        IRInst* br = ir_inst_br(&func->arena, t);
         if (!br) continue;
 
         // احتفظ بمعلومات الموقع/الديبغ إن وجدت
@@ -225,7 +273,7 @@ static int ir_cfg_simplify_remove_trivial_blocks(IRFunc* func) {
     if (!func->entry) return 0;
 
     // تأكد من preds/succs حديثة
-    ir_func_rebuild_preds(func);
+    ir_analysis_require_preds(func);
 
     int changed = 0;
 
@@ -341,12 +389,14 @@ static int ir_cfg_simplify_func(IRFunc* func) {
 bool ir_cfg_simplify_run(IRModule* module) {
     if (!module) return false;
 
-    ir_module_set_current(module);
-
     int changed = 0;
     for (IRFunc* f = module->funcs; f; f = f->next) {
         changed |= ir_cfg_simplify_func(f);
     }
 
     return changed ? true : false;
-}
\ No newline at end of file
+}
+
+static bool ir_cfg_simplify_run_func(IRFunc* func) {
+    return ir_cfg_simplify_func(func) ? true : false;
+}
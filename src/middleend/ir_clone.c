@@ -10,37 +10,37 @@
 #include <stdlib.h>
 #include <string.h>
 
-static IRValue* ir_clone_value(IRValue* v, IRBlock** block_map, int map_cap) {
+static IRValue* ir_clone_value(IRArena* arena, IRValue* v, IRBlock** block_map, int map_cap) {
     if (!v) return NULL;
 
     switch (v->kind) {
         case IR_VAL_CONST_INT:
-            return ir_value_const_int(v->data.const_int, v->type);
+            return ir_value_const_int(arena, v->data.const_int, v->type);
 
         case IR_VAL_CONST_STR:
-            return ir_value_const_str(v->data.const_str.data, v->data.const_str.id);
+            return ir_value_const_str(arena, v->data.const_str.data, v->data.const_str.id);
 
         case IR_VAL_BAA_STR:
-            return ir_value_baa_str(v->data.const_str.data, v->data.const_str.id);
+            return ir_value_baa_str(arena, v->data.const_str.data, v->data.const_str.id);
 
         case IR_VAL_REG:
-            return ir_value_reg(v->data.reg_num, v->type);
+            return ir_value_reg(arena, v->data.reg_num, v->type);
 
         case IR_VAL_GLOBAL:
             // نحافظ على النوع كما هو.
-            return ir_value_global(v->data.global_name,
+            return ir_value_global(arena, v->data.global_name,
                                    (v->type && v->type->kind == IR_TYPE_PTR) ? v->type->data.pointee : v->type);
 
         case IR_VAL_FUNC:
-            return ir_value_func_ref(v->data.global_name, v->type);
+            return ir_value_func_ref(arena, v->data.global_name, v->type);
 
         case IR_VAL_BLOCK: {
             IRBlock* b = v->data.block;
-            if (!b) return ir_value_block(NULL);
+            if (!b) return ir_value_block(arena, NULL);
             if (b->id >= 0 && b->id < map_cap && block_map) {
-                return ir_value_block(block_map[b->id]);
+                return ir_value_block(arena, block_map[b->id]);
             }
-            return ir_value_block(NULL);
+            return ir_value_block(arena, NULL);
         }
 
         case IR_VAL_NONE:
@@ -63,8 +63,6 @@ static void ir_clone_inst_common(IRInst* dst, IRInst* src) {
 IRFunc* ir_func_clone(IRModule* module, IRFunc* src, const char* new_name) {
     if (!module || !src) return NULL;
 
-    ir_module_set_current(module);
-
     IRFunc* f = ir_func_new(new_name ? new_name : src->name, src->ret_type);
     if (!f) return NULL;
 
@@ -100,7 +98,7 @@ IRFunc* ir_func_clone(IRModule* module, IRFunc* src, const char* new_name) {
 
     // 1) إنشاء كتل جديدة بنفس label/id.
     for (IRBlock* b = src->blocks; b; b = b->next) {
-        IRBlock* nb = ir_block_new(b->label, b->id);
+        IRBlock* nb = ir_block_new(&f->arena, b->label, b->id);
         if (!nb) {
             free(block_map);
             return NULL;
@@ -116,7 +114,7 @@ IRFunc* ir_func_clone(IRModule* module, IRFunc* src, const char* new_name) {
     IRBlock* db = f->blocks;
     while (sb && db) {
         for (IRInst* inst = sb->first; inst; inst = inst->next) {
-            IRInst* ni = ir_inst_new(inst->op, inst->type, inst->dest);
+            IRInst* ni = ir_inst_new(&f->arena, inst->op, inst->type, inst->dest);
             if (!ni) {
                 free(block_map);
                 return NULL;
@@ -128,7 +126,7 @@ IRFunc* ir_func_clone(IRModule* module, IRFunc* src, const char* new_name) {
             ni->operand_count = 0;
             for (int k = 0; k < inst->operand_count; k++) {
                 IRValue* ov = inst->operands[k];
-                IRValue* cv = ir_clone_value(ov, block_map, map_cap);
+                IRValue* cv = ir_clone_value(&f->arena, ov, block_map, map_cap);
                 if (cv) {
                     ir_inst_add_operand(ni, cv);
                 }
@@ -137,16 +135,16 @@ IRFunc* ir_func_clone(IRModule* module, IRFunc* src, const char* new_name) {
             // call
             if (inst->op == IR_OP_CALL) {
                 ni->call_arg_count = inst->call_arg_count;
-                ni->call_target = inst->call_target ? ir_arena_strdup(&module->arena, inst->call_target) : NULL;
-                ni->call_callee = inst->call_callee ? ir_clone_value(inst->call_callee, block_map, map_cap) : NULL;
+                ni->call_target = inst->call_target ? ir_arena_strdup(&f->arena, inst->call_target) : NULL;
+                ni->call_callee = inst->call_callee ? ir_clone_value(&f->arena, inst->call_callee, block_map, map_cap) : NULL;
 
                 if (inst->call_arg_count > 0 && inst->call_args) {
-                    ni->call_args = (IRValue**)ir_arena_alloc(&module->arena,
+                    ni->call_args = (IRValue**)ir_arena_alloc(&f->arena,
                                                              (size_t)inst->call_arg_count * sizeof(IRValue*),
                                                              _Alignof(IRValue*));
                     if (ni->call_args) {
                         for (int k = 0; k < inst->call_arg_count; k++) {
-                            ni->call_args[k] = ir_clone_value(inst->call_args[k], block_map, map_cap);
+                            ni->call_args[k] = ir_clone_value(&f->arena, inst->call_args[k], block_map, map_cap);
                         }
                     } else {
                         ni->call_arg_count = 0;
@@ -154,6 +152,18 @@ IRFunc* ir_func_clone(IRModule* module, IRFunc* src, const char* new_name) {
                 }
             }
 
+            // switch cases
+            if (inst->op == IR_OP_SWITCH) {
+                for (int k = 0; k < inst->switch_case_count; k++) {
+                    IRBlock* ob = inst->switch_cases[k].target;
+                    IRBlock* nb = NULL;
+                    if (ob && ob->id >= 0 && ob->id < map_cap && block_map) {
+                        nb = block_map[ob->id];
+                    }
+                    ir_inst_switch_add_case(&f->arena, ni, inst->switch_cases[k].value, nb);
+                }
+            }
+
             // phi entries
             if (inst->op == IR_OP_PHI) {
                 // للحفاظ على نفس الترتيب، نجمع أولاً ثم نضيف بالعكس.
@@ -177,7 +187,7 @@ IRFunc* ir_func_clone(IRModule* module, IRFunc* src, const char* new_name) {
                     if (ob && ob->id >= 0 && ob->id < map_cap && block_map) {
                         nb = block_map[ob->id];
                     }
-                    IRValue* cv = ir_clone_value(e->value, block_map, map_cap);
+                    IRValue* cv = ir_clone_value(&f->arena, e->value, block_map, map_cap);
                     if (cv && nb) {
                         ir_inst_phi_add(ni, cv, nb);
                     }
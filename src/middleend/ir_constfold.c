@@ -34,9 +34,13 @@
 // IRPass integration
 // -----------------------------------------------------------------------------
 
+static bool ir_constfold_run_func(IRFunc* func);
+
 IRPass IR_PASS_CONSTFOLD = {
     .name = "طي_الثوابت",
-    .run = ir_constfold_run
+    .run = ir_constfold_run,
+    .run_func = ir_constfold_run_func,
+    .preserves = IR_ANALYSIS_CFG_ALL
 };
 
 // -----------------------------------------------------------------------------
@@ -99,10 +103,10 @@ static int is_reg(IRValue* v) {
     return v && v->kind == IR_VAL_REG;
 }
 
-static IRValue* new_const_for_type(int64_t v, IRType* t) {
+static IRValue* new_const_for_type(IRArena* arena, int64_t v, IRType* t) {
     // Preserve IR's type (esp. i1 for comparisons)
     int64_t folded = trunc_wrap_to_type(v, t);
-    return ir_value_const_int(folded, t);
+    return ir_value_const_int(arena, folded, t);
 }
 
 // -----------------------------------------------------------------------------
@@ -114,7 +118,7 @@ static IRValue* new_const_for_type(int64_t v, IRType* t) {
 // Helpers: replace register uses
 // -----------------------------------------------------------------------------
 
-static int ir_value_replace_reg_use(IRValue** slot, int reg_num, IRType* folded_type, int64_t folded_value) {
+static int ir_value_replace_reg_use(IRArena* arena, IRValue** slot, int reg_num, IRType* folded_type, int64_t folded_value) {
     if (!slot || !*slot) return 0;
 
     IRValue* v = *slot;
@@ -122,7 +126,7 @@ static int ir_value_replace_reg_use(IRValue** slot, int reg_num, IRType* folded_
 
     // Replace this IRValue with a new constant.
     ir_value_free(v);
-    *slot = new_const_for_type(folded_value, folded_type);
+    *slot = new_const_for_type(arena, folded_value, folded_type);
     return 1;
 }
 
@@ -133,17 +137,17 @@ static int ir_inst_replace_reg_uses(IRInst* inst, int reg_num, IRType* folded_ty
 
     // Normal operands
     for (int i = 0; i < inst->operand_count; i++) {
-        changed |= ir_value_replace_reg_use(&inst->operands[i], reg_num, folded_type, folded_value);
+        changed |= ir_value_replace_reg_use(inst->arena, &inst->operands[i], reg_num, folded_type, folded_value);
     }
 
     // Call args
     if (inst->op == IR_OP_CALL) {
         if (inst->call_callee) {
-            changed |= ir_value_replace_reg_use(&inst->call_callee, reg_num, folded_type, folded_value);
+            changed |= ir_value_replace_reg_use(inst->arena, &inst->call_callee, reg_num, folded_type, folded_value);
         }
         if (inst->call_args) {
             for (int i = 0; i < inst->call_arg_count; i++) {
-                changed |= ir_value_replace_reg_use(&inst->call_args[i], reg_num, folded_type, folded_value);
+                changed |= ir_value_replace_reg_use(inst->arena, &inst->call_args[i], reg_num, folded_type, folded_value);
             }
         }
     }
@@ -153,7 +157,7 @@ static int ir_inst_replace_reg_uses(IRInst* inst, int reg_num, IRType* folded_ty
         for (IRPhiEntry* e = inst->phi_entries; e; e = e->next) {
             if (e->value && is_reg(e->value) && e->value->data.reg_num == reg_num) {
                 ir_value_free(e->value);
-                e->value = new_const_for_type(folded_value, folded_type);
+                e->value = new_const_for_type(inst->arena, folded_value, folded_type);
                 changed = 1;
             }
         }
@@ -182,7 +186,7 @@ static int ir_func_replace_reg_uses(IRFunc* func, int reg_num, IRType* folded_ty
     return changed;
 }
 
-static int ir_func_replace_reg_uses_defuse(IRDefUse* du,
+static int ir_func_replace_reg_uses_defuse(IRArena* arena, IRDefUse* du,
                                           int reg_num, IRType* folded_type, int64_t folded_value) {
     if (!du) return 0;
     if (reg_num < 0 || reg_num >= du->max_reg) return 0;
@@ -196,7 +200,7 @@ static int ir_func_replace_reg_uses_defuse(IRDefUse* du,
         if (cur->data.reg_num != reg_num) continue;
 
         IRType* t = cur->type ? cur->type : folded_type;
-        *u->slot = new_const_for_type(folded_value, t);
+        *u->slot = new_const_for_type(arena, folded_value, t);
         changed = 1;
     }
 
@@ -384,7 +388,7 @@ static int ir_constfold_func(IRFunc* func) {
                 // (module-wide wrapper will call per-function, but replacing within the function is enough
                 // because virtual regs are function-scoped in this IR).
                 if (du) {
-                    changed |= ir_func_replace_reg_uses_defuse(du, folded_reg, folded_type, folded_value);
+                    changed |= ir_func_replace_reg_uses_defuse(&func->arena, du, folded_reg, folded_type, folded_value);
                 } else {
                     changed |= ir_func_replace_reg_uses(func, folded_reg, folded_type, folded_value);
                 }
@@ -405,7 +409,6 @@ bool ir_constfold_run(IRModule* module) {
     if (!module) return false;
 
     // ضمان أن أي قيم/أنواع جديدة تُخصَّص ضمن ساحة هذه الوحدة.
-    ir_module_set_current(module);
 
     int changed = 0;
     for (IRFunc* f = module->funcs; f; f = f->next) {
@@ -420,3 +423,7 @@ bool ir_constfold_run(IRModule* module) {
 
     return changed ? true : false;
 }
+
+static bool ir_constfold_run_func(IRFunc* func) {
+    return ir_constfold_func(func) ? true : false;
+}
@@ -5,19 +5,19 @@
 /**
  * Create a new basic block
  */
-IRBlock* ir_block_new(const char* label, int id) {
-    IRBlock* block = (IRBlock*)ir_alloc(sizeof(IRBlock), _Alignof(IRBlock));
+IRBlock* ir_block_new(IRArena* arena, const char* label, int id) {
+    IRBlock* block = (IRBlock*)ir_alloc(arena, sizeof(IRBlock), _Alignof(IRBlock));
     if (!block) return NULL;
     
-    block->label = label ? ir_strdup(label) : NULL;
+    block->label = label ? ir_strdup(arena, label) : NULL;
     block->id = id;
     block->parent = NULL;
     block->first = NULL;
     block->last = NULL;
     block->inst_count = 0;
-    block->succs[0] = NULL;
-    block->succs[1] = NULL;
+    block->succs = NULL;
     block->succ_count = 0;
+    block->succ_capacity = 0;
     block->preds = NULL;
     block->pred_count = 0;
     block->pred_capacity = 0;
@@ -78,18 +78,28 @@ void ir_block_add_pred(IRBlock* block, IRBlock* pred) {
  * Add a successor to a block
  */
 void ir_block_add_succ(IRBlock* block, IRBlock* succ) {
-    if (!block || !succ || block->succ_count >= 2) return;
+    if (!block || !succ) return;
+
+    // Grow array if needed (التفرع قد يملك أكثر من خلفين)
+    if (block->succ_count >= block->succ_capacity) {
+        int new_cap = block->succ_capacity == 0 ? 2 : block->succ_capacity * 2;
+        IRBlock** new_succs = (IRBlock**)realloc(block->succs, new_cap * sizeof(IRBlock*));
+        if (!new_succs) return;
+        block->succs = new_succs;
+        block->succ_capacity = new_cap;
+    }
+
     block->succs[block->succ_count++] = succ;
     ir_block_add_pred(succ, block);
 }
 
 /**
- * Check if a block is terminated (ends with br, br_cond, or ret)
+ * Check if a block is terminated (ends with br, br_cond, switch, or ret)
  */
 int ir_block_is_terminated(IRBlock* block) {
     if (!block || !block->last) return 0;
     IROp op = block->last->op;
-    return op == IR_OP_BR || op == IR_OP_BR_COND || op == IR_OP_RET;
+    return op == IR_OP_BR || op == IR_OP_BR_COND || op == IR_OP_SWITCH || op == IR_OP_RET;
 }
 
 /**
@@ -104,14 +114,25 @@ void ir_block_free(IRBlock* block) {
 // IR Function Construction
 // ============================================================================
 
+// حجم كتل ساحة الدالة: أصغر من ساحة الوحدة لأن معظم الدوال (والنماذج الأولية) صغيرة.
+#define IR_FUNC_ARENA_CHUNK_SIZE (16u * 1024u)
+
 /**
  * Create a new function
+ *
+ * تملك كل دالة ساحتها الخاصة، وتُخصَّص بنية الدالة نفسها داخلها.
  */
 IRFunc* ir_func_new(const char* name, IRType* ret_type) {
-    IRFunc* func = (IRFunc*)ir_alloc(sizeof(IRFunc), _Alignof(IRFunc));
-    if (!func) return NULL;
+    IRArena arena;
+    ir_arena_init(&arena, IR_FUNC_ARENA_CHUNK_SIZE);
+    IRFunc* func = (IRFunc*)ir_alloc(&arena, sizeof(IRFunc), _Alignof(IRFunc));
+    if (!func) {
+        ir_arena_destroy(&arena);
+        return NULL;
+    }
+    func->arena = arena;
     
-    func->name = name ? ir_strdup(name) : NULL;
+    func->name = name ? ir_strdup(&func->arena, name) : NULL;
     func->ret_type = ret_type ? ret_type : IR_TYPE_VOID_T;
     func->params = NULL;
     func->param_count = 0;
@@ -122,9 +143,19 @@ IRFunc* ir_func_new(const char* name, IRType* ret_type) {
     func->next_inst_id = 0;
     func->ir_epoch = 1;
     func->def_use = NULL;
+    func->analysis_valid = 0;
+    func->preds_epoch = 0;
+    func->dom_epoch = 0;
+    func->loops_epoch = 0;
+    func->analysis_pass_epoch = 0;
+    func->loop_info = NULL;
+    func->analysis_counts = NULL;
+    func->opt_clean_epoch = 0;
+    func->opt_clean_level = 0;
     func->next_block_id = 0;
     func->is_prototype = false;
     func->is_variadic = false;
+    func->module = NULL;
     func->next = NULL;
     
     return func;
@@ -166,6 +197,8 @@ void ir_func_add_block(IRFunc* func, IRBlock* block) {
         last->next = block;
     }
     func->block_count++;
+    // كتلة جديدة تغيّر CFG: تبطل preds/السيطرة/الحلقات المخزنة.
+    ir_func_invalidate_cfg(func);
 }
 
 /**
@@ -175,7 +208,7 @@ IRBlock* ir_func_new_block(IRFunc* func, const char* label) {
     if (!func) return NULL;
     
     int id = ir_func_alloc_block_id(func);
-    IRBlock* block = ir_block_new(label, id);
+    IRBlock* block = ir_block_new(&func->arena, label, id);
     if (!block) return NULL;
     
     ir_func_add_block(func, block);
@@ -190,14 +223,14 @@ void ir_func_add_param(IRFunc* func, const char* name, IRType* type) {
 
     // توسيع مصفوفة المعاملات داخل الساحة (Arena) عبر نسخ إلى مصفوفة جديدة.
     int new_count = func->param_count + 1;
-    IRParam* new_params = (IRParam*)ir_alloc((size_t)new_count * sizeof(IRParam), _Alignof(IRParam));
+    IRParam* new_params = (IRParam*)ir_alloc(&func->arena, (size_t)new_count * sizeof(IRParam), _Alignof(IRParam));
     if (!new_params) return;
     for (int i = 0; i < func->param_count; i++) {
         new_params[i] = func->params[i];
     }
     func->params = new_params;
 
-    func->params[func->param_count].name = name ? ir_strdup(name) : NULL;
+    func->params[func->param_count].name = name ? ir_strdup(&func->arena, name) : NULL;
     func->params[func->param_count].type = type;
     func->params[func->param_count].reg = ir_func_alloc_reg(func);
     func->param_count = new_count;
@@ -205,10 +238,22 @@ void ir_func_add_param(IRFunc* func, const char* name, IRType* type) {
 
 /**
  * Free a function and all its blocks
+ *
+ * للدوال غير المضافة إلى وحدة فقط؛ الوحدة تحرر ساحات دوالها في ir_module_free.
  */
 void ir_func_free(IRFunc* func) {
-    (void)func;
-    // تُدار الذاكرة عبر الساحة (Arena): لا تحرير فردي للدوال.
+    if (!func) return;
+    if (func->def_use) {
+        ir_defuse_free(func->def_use);
+        func->def_use = NULL;
+    }
+    ir_analysis_func_release(func);
+    for (IRBlock* b = func->blocks; b; b = b->next) {
+        ir_block_free_analysis_caches(b);
+    }
+    // البنية نفسها داخل الساحة: انسخ الساحة قبل تدميرها.
+    IRArena arena = func->arena;
+    ir_arena_destroy(&arena);
 }
 
 // ============================================================================
@@ -218,11 +263,11 @@ void ir_func_free(IRFunc* func) {
 /**
  * Create a new global variable
  */
-IRGlobal* ir_global_new(const char* name, IRType* type, int is_const) {
-    IRGlobal* global = (IRGlobal*)ir_alloc(sizeof(IRGlobal), _Alignof(IRGlobal));
+IRGlobal* ir_global_new(IRArena* arena, const char* name, IRType* type, int is_const) {
+    IRGlobal* global = (IRGlobal*)ir_alloc(arena, sizeof(IRGlobal), _Alignof(IRGlobal));
     if (!global) return NULL;
     
-    global->name = name ? ir_strdup(name) : NULL;
+    global->name = name ? ir_strdup(arena, name) : NULL;
     global->type = type;
     global->init = NULL;
     global->init_elems = NULL;
@@ -263,12 +308,9 @@ IRModule* ir_module_new(const char* name) {
     IRModule* module = (IRModule*)malloc(sizeof(IRModule));
     if (!module) return NULL;
 
-    // تهيئة الساحة أولاً ثم اجعل هذه الوحدة هي الوحدة الحالية.
     ir_arena_init(&module->arena, 0);
-    module->cached_i8_ptr_type = NULL;
-    ir_module_set_current(module);
 
-    module->name = name ? ir_strdup(name) : NULL;
+    module->name = name ? ir_strdup(&module->arena, name) : NULL;
     module->globals = NULL;
     module->global_count = 0;
     module->funcs = NULL;
@@ -278,6 +320,7 @@ IRModule* ir_module_new(const char* name) {
 
     module->baa_strings = NULL;
     module->baa_string_count = 0;
+    module->analysis_stats = NULL;
      
     return module;
 }
@@ -287,7 +330,8 @@ IRModule* ir_module_new(const char* name) {
  */
 void ir_module_add_func(IRModule* module, IRFunc* func) {
     if (!module || !func) return;
-    
+
+    func->module = module;
     if (!module->funcs) {
         module->funcs = func;
     } else {
@@ -323,9 +367,6 @@ void ir_module_add_global(IRModule* module, IRGlobal* global) {
  */
 int ir_module_add_string(IRModule* module, const char* str) {
     if (!module || !str) return -1;
-
-    // اجعل الوحدة الحالية صحيحة قبل أي تخصيص.
-    ir_module_set_current(module);
     
     // Check if string already exists
     IRStringEntry* entry = module->strings;
@@ -337,11 +378,11 @@ int ir_module_add_string(IRModule* module, const char* str) {
     }
     
     // Create new entry
-    IRStringEntry* new_entry = (IRStringEntry*)ir_alloc(sizeof(IRStringEntry), _Alignof(IRStringEntry));
+    IRStringEntry* new_entry = (IRStringEntry*)ir_alloc(&module->arena, sizeof(IRStringEntry), _Alignof(IRStringEntry));
     if (!new_entry) return -1;
     
     new_entry->id = module->string_count++;
-    new_entry->content = ir_strdup(str);
+    new_entry->content = ir_strdup(&module->arena, str);
     new_entry->next = module->strings;
     module->strings = new_entry;
     
@@ -402,24 +443,31 @@ const char* ir_module_get_string(IRModule* module, int id) {
 void ir_module_free(IRModule* module) {
     if (!module) return;
 
-    // تحرير ما تبقى من كاشات التحليل التي تم تخصيصها بالـ heap.
-    // (الكتل/التعليمات/القيم نفسها داخل الساحة.)
-    for (IRFunc* f = module->funcs; f; f = f->next) {
-        if (f->def_use) {
-            ir_defuse_free(f->def_use);
-            f->def_use = NULL;
-        }
-        for (IRBlock* b = f->blocks; b; b = b->next) {
-            ir_block_free_analysis_caches(b);
-        }
+    // تحرير كاشات التحليل (heap) ثم ساحة كل دالة.
+    IRFunc* f = module->funcs;
+    while (f) {
+        IRFunc* next = f->next;
+        ir_func_free(f);
+        f = next;
     }
 
-    // تدمير الساحة ثم تحرير هيكل الوحدة.
+    // تدمير ساحة الوحدة ثم تحرير هيكل الوحدة.
     ir_arena_destroy(&module->arena);
+    free(module);
+}
 
-    if (g_ir_current_module == module) {
-        g_ir_current_module = NULL;
+/**
+ * @brief إحصاءات الذاكرة المجمّعة لساحة الوحدة وساحات دوالها.
+ */
+void ir_module_arena_stats(const IRModule* module, IRArenaStats* out_stats) {
+    if (!out_stats) return;
+    ir_arena_get_stats(module ? &module->arena : NULL, out_stats);
+    if (!module) return;
+    for (const IRFunc* f = module->funcs; f; f = f->next) {
+        IRArenaStats fs;
+        ir_arena_get_stats(&f->arena, &fs);
+        out_stats->chunks += fs.chunks;
+        out_stats->used_bytes += fs.used_bytes;
+        out_stats->cap_bytes += fs.cap_bytes;
     }
-
-    free(module);
 }
@@ -28,48 +28,52 @@
 // IRPass integration
 // -----------------------------------------------------------------------------
 
+static bool ir_copyprop_run_func(IRFunc* func);
+
 IRPass IR_PASS_COPYPROP = {
     .name = "نشر_النسخ",
-    .run = ir_copyprop_run
+    .run = ir_copyprop_run,
+    .run_func = ir_copyprop_run_func,
+    .preserves = IR_ANALYSIS_CFG_ALL
 };
 
 // -----------------------------------------------------------------------------
 // Helpers: value classification / cloning
 // -----------------------------------------------------------------------------
 
-static IRValue* ir_value_clone_with_type(IRValue* v, IRType* override_type) {
+static IRValue* ir_value_clone_with_type(IRArena* arena, IRValue* v, IRType* override_type) {
     if (!v) return NULL;
 
     IRType* t = override_type ? override_type : v->type;
 
     switch (v->kind) {
         case IR_VAL_CONST_INT:
-            return ir_value_const_int(v->data.const_int, t);
+            return ir_value_const_int(arena, v->data.const_int, t);
 
         case IR_VAL_CONST_STR:
             // Keep same string-id and content; constructor will strdup() the data.
-            return ir_value_const_str(v->data.const_str.data, v->data.const_str.id);
+            return ir_value_const_str(arena, v->data.const_str.data, v->data.const_str.id);
 
         case IR_VAL_BAA_STR:
-            return ir_value_baa_str(v->data.const_str.data, v->data.const_str.id);
+            return ir_value_baa_str(arena, v->data.const_str.data, v->data.const_str.id);
 
         case IR_VAL_REG:
-            return ir_value_reg(v->data.reg_num, t);
+            return ir_value_reg(arena, v->data.reg_num, t);
 
         case IR_VAL_GLOBAL:
             // Note: ir_value_global() expects the pointee type and will build a ptr type.
             // If v->type is already a pointer, pass the pointee when possible.
             if (v->type && v->type->kind == IR_TYPE_PTR) {
-                return ir_value_global(v->data.global_name, v->type->data.pointee);
+                return ir_value_global(arena, v->data.global_name, v->type->data.pointee);
             }
-            return ir_value_global(v->data.global_name, v->type);
+            return ir_value_global(arena, v->data.global_name, v->type);
 
         case IR_VAL_FUNC:
-            return ir_value_func_ref(v->data.global_name, t);
+            return ir_value_func_ref(arena, v->data.global_name, t);
 
         case IR_VAL_BLOCK:
             // Blocks are control-flow labels; copying them is nonsensical for this pass.
-            return ir_value_block(v->data.block);
+            return ir_value_block(arena, v->data.block);
 
         case IR_VAL_NONE:
         default:
@@ -92,7 +96,7 @@ static IRValue* ir_canonicalize_value(IRValue* v, IRValue** aliases, int max_reg
     return ir_canonicalize_value(a, aliases, max_reg, depth + 1);
 }
 
-static int ir_try_replace_value_slot(IRValue** slot, IRValue** aliases, int max_reg) {
+static int ir_try_replace_value_slot(IRArena* arena, IRValue** slot, IRValue** aliases, int max_reg) {
     if (!slot || !*slot || !aliases) return 0;
 
     IRValue* cur = *slot;
@@ -105,7 +109,7 @@ static int ir_try_replace_value_slot(IRValue** slot, IRValue** aliases, int max_
     if (!repl) return 0;
 
     // Clone replacement; preserve the use-site type when available.
-    IRValue* new_val = ir_value_clone_with_type(repl, cur->type ? cur->type : repl->type);
+    IRValue* new_val = ir_value_clone_with_type(arena, repl, cur->type ? cur->type : repl->type);
     if (!new_val) return 0;
 
     ir_value_free(cur);
@@ -159,7 +163,7 @@ static int ir_copyprop_func(IRFunc* func) {
             if (aliases[inst->dest]) continue;
 
             IRValue* src_canon = ir_canonicalize_value(src, aliases, max_reg, 0);
-            IRValue* clone = ir_value_clone_with_type(src_canon, dest_type);
+            IRValue* clone = ir_value_clone_with_type(&func->arena, src_canon, dest_type);
             if (!clone) continue;
 
             aliases[inst->dest] = clone;
@@ -175,7 +179,7 @@ static int ir_copyprop_func(IRFunc* func) {
         if (canon == aliases[r]) continue;
 
         IRType* t = alias_types[r] ? alias_types[r] : aliases[r]->type;
-        IRValue* new_clone = ir_value_clone_with_type(canon, t);
+        IRValue* new_clone = ir_value_clone_with_type(&func->arena, canon, t);
         if (!new_clone) continue;
 
         ir_value_free(aliases[r]);
@@ -197,7 +201,7 @@ static int ir_copyprop_func(IRFunc* func) {
                 if (cur->data.reg_num != r) continue;
 
                 IRValue* repl = aliases[r];
-                IRValue* new_val = ir_value_clone_with_type(repl, cur->type ? cur->type : repl->type);
+                IRValue* new_val = ir_value_clone_with_type(&func->arena, repl, cur->type ? cur->type : repl->type);
                 if (!new_val) continue;
 
                 *u->slot = new_val;
@@ -209,21 +213,21 @@ static int ir_copyprop_func(IRFunc* func) {
         for (IRBlock* b = func->blocks; b; b = b->next) {
             for (IRInst* inst = b->first; inst; inst = inst->next) {
                 for (int i = 0; i < inst->operand_count; i++) {
-                    changed |= ir_try_replace_value_slot(&inst->operands[i], aliases, max_reg);
+                    changed |= ir_try_replace_value_slot(&func->arena, &inst->operands[i], aliases, max_reg);
                 }
 
                 if (inst->op == IR_OP_CALL) {
-                    changed |= ir_try_replace_value_slot(&inst->call_callee, aliases, max_reg);
+                    changed |= ir_try_replace_value_slot(&func->arena, &inst->call_callee, aliases, max_reg);
                     if (inst->call_args) {
                         for (int i = 0; i < inst->call_arg_count; i++) {
-                            changed |= ir_try_replace_value_slot(&inst->call_args[i], aliases, max_reg);
+                            changed |= ir_try_replace_value_slot(&func->arena, &inst->call_args[i], aliases, max_reg);
                         }
                     }
                 }
 
                 if (inst->op == IR_OP_PHI) {
                     for (IRPhiEntry* e = inst->phi_entries; e; e = e->next) {
-                        changed |= ir_try_replace_value_slot(&e->value, aliases, max_reg);
+                        changed |= ir_try_replace_value_slot(&func->arena, &e->value, aliases, max_reg);
                     }
                 }
             }
@@ -275,7 +279,6 @@ bool ir_copyprop_run(IRModule* module) {
     if (!module) return false;
 
     // ضمان أن أي قيم جديدة تُخصَّص ضمن ساحة هذه الوحدة.
-    ir_module_set_current(module);
 
     int changed = 0;
     for (IRFunc* f = module->funcs; f; f = f->next) {
@@ -284,3 +287,7 @@ bool ir_copyprop_run(IRModule* module) {
 
     return changed ? true : false;
 }
+
+static bool ir_copyprop_run_func(IRFunc* func) {
+    return ir_copyprop_func(func) ? true : false;
+}
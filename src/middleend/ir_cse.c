@@ -20,6 +20,7 @@
 #include "ir_mutate.h"
 #include "ir_defuse.h"
 #include "ir_analysis.h"
+#include "ir_analysis_manager.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -28,9 +29,13 @@
 // IRPass integration
 // -----------------------------------------------------------------------------
 
+static bool ir_cse_run_func(IRFunc* func);
+
 IRPass IR_PASS_CSE = {
     .name = "حذف_المكرر",
-    .run = ir_cse_run
+    .run = ir_cse_run,
+    .run_func = ir_cse_run_func,
+    .preserves = IR_ANALYSIS_CFG_ALL
 };
 
 // -----------------------------------------------------------------------------
@@ -293,8 +298,8 @@ static int ir_cse_func(IRFunc* func) {
     if (!func || func->is_prototype) return 0;
     if (!func->entry) return 0;
     
-    // Compute dominators first (required for dominance check)
-    ir_func_compute_dominators(func);
+    // Dominators are required for the dominance check (cached across passes).
+    ir_analysis_require_dominators(func);
     
     // Allocate hash table
     CSEEntry** table = (CSEEntry**)calloc(CSE_HASH_SIZE, sizeof(CSEEntry*));
@@ -390,7 +395,6 @@ bool ir_cse_run(IRModule* module) {
     if (!module) return false;
 
     // ضمان أن أي قيم جديدة تُخصَّص ضمن ساحة هذه الوحدة.
-    ir_module_set_current(module);
 
     int changed = 0;
     for (IRFunc* f = module->funcs; f; f = f->next) {
@@ -399,3 +403,7 @@ bool ir_cse_run(IRModule* module) {
 
     return changed ? true : false;
 }
+
+static bool ir_cse_run_func(IRFunc* func) {
+    return ir_cse_func(func) ? true : false;
+}
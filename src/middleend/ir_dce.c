@@ -14,6 +14,7 @@
 
 #include "ir_dce.h"
 #include "ir_analysis.h"
+#include "ir_analysis_manager.h"
 #include "ir_mutate.h"
 
 #include <stdlib.h>
@@ -28,9 +29,13 @@ typedef struct {
 // IRPass integration
 // -----------------------------------------------------------------------------
 
+static bool ir_dce_run_func(IRFunc* func);
+
 IRPass IR_PASS_DCE = {
     .name = "حذف_الميت",
-    .run = ir_dce_run
+    .run = ir_dce_run,
+    .run_func = ir_dce_run_func,
+    .preserves = IR_ANALYSIS_NONE
 };
 
 // -----------------------------------------------------------------------------
@@ -48,6 +53,7 @@ static int ir_inst_has_side_effects(IRInst* inst) {
 
         case IR_OP_BR:
         case IR_OP_BR_COND:
+        case IR_OP_SWITCH:
         case IR_OP_RET:
             return 1;
 
@@ -141,8 +147,8 @@ static int ir_func_remove_unreachable_blocks(IRFunc* func) {
     if (!func || func->is_prototype) return 0;
     if (!func->entry) return 0;
 
-    // Ensure CFG edges reflect terminators.
-    ir_func_rebuild_preds(func);
+    // Ensure CFG edges reflect terminators (cached when nothing changed).
+    ir_analysis_require_preds(func);
 
     int max_id = ir_func_max_block_id(func);
     if (max_id <= 0) return 0;
@@ -430,7 +436,6 @@ bool ir_dce_run(IRModule* module) {
     if (!module) return false;
 
     // ضمان أن أي قيم/تعليمات جديدة (إن وُجدت) تُخصَّص ضمن ساحة هذه الوحدة.
-    ir_module_set_current(module);
 
     int changed = 0;
 
@@ -441,3 +446,10 @@ bool ir_dce_run(IRModule* module) {
 
     return changed ? true : false;
 }
+
+static bool ir_dce_run_func(IRFunc* func) {
+    int changed = 0;
+    changed |= ir_func_remove_unreachable_blocks(func);
+    changed |= ir_func_dce_instructions(func);
+    return changed ? true : false;
+}
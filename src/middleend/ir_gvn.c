@@ -10,6 +10,7 @@
 #include "ir_gvn.h"
 
 #include "ir_analysis.h"
+#include "ir_analysis_manager.h"
 #include "ir_defuse.h"
 #include "ir_mutate.h"
 
@@ -21,9 +22,13 @@
 // IRPass integration
 // -----------------------------------------------------------------------------
 
+static bool ir_gvn_run_func(IRFunc* func);
+
 IRPass IR_PASS_GVN = {
     .name = "ترقيم_القيم",
     .run = ir_gvn_run,
+    .run_func = ir_gvn_run_func,
+    .preserves = IR_ANALYSIS_CFG_ALL
 };
 
 // -----------------------------------------------------------------------------
@@ -414,8 +419,7 @@ static int ir_gvn_func(IRFunc* func)
     if (!func || func->is_prototype) return 0;
     if (!func->entry) return 0;
 
-    ir_func_rebuild_preds(func);
-    ir_func_compute_dominators(func);
+    ir_analysis_require_dominators(func);
 
     int max_id = ir_func_max_block_id_local(func);
     if (max_id <= 0) return 0;
@@ -497,7 +501,6 @@ static int ir_gvn_func(IRFunc* func)
 bool ir_gvn_run(IRModule* module)
 {
     if (!module) return false;
-    ir_module_set_current(module);
 
     int changed = 0;
     for (IRFunc* f = module->funcs; f; f = f->next)
@@ -505,3 +508,8 @@ bool ir_gvn_run(IRModule* module)
 
     return changed ? true : false;
 }
+
+static bool ir_gvn_run_func(IRFunc* func)
+{
+    return ir_gvn_func(func) ? true : false;
+}
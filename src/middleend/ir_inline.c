@@ -43,7 +43,8 @@ static int ir_inline_count_nonterm_insts(IRFunc* f) {
         for (IRInst* inst = b->first; inst; inst = inst->next) {
             if (!inst) continue;
             if (inst == b->last) continue;
-            if (inst->op == IR_OP_BR || inst->op == IR_OP_BR_COND || inst->op == IR_OP_RET) continue;
+            if (inst->op == IR_OP_BR || inst->op == IR_OP_BR_COND || inst->op == IR_OP_SWITCH ||
+                inst->op == IR_OP_RET) continue;
             count++;
         }
     }
@@ -148,7 +149,7 @@ static IRValue* ir_inline_clone_value(IRValue* v,
         case IR_VAL_BLOCK: {
             IRBlock* nb = ir_inline_map_block(bm, bm_count, v->data.block);
             if (!nb) return NULL;
-            return ir_value_block(nb);
+            return ir_value_block(&caller->arena, nb);
         }
         case IR_VAL_REG: {
             if (!reg_map || reg_map_len <= 0 || v->data.reg_num < 0 || v->data.reg_num >= reg_map_len) {
@@ -169,7 +170,7 @@ static IRValue* ir_inline_clone_value(IRValue* v,
                 t = old_reg_types[v->data.reg_num];
             }
             if (!t) t = IR_TYPE_I64_T;
-            return ir_value_reg(nr, t);
+            return ir_value_reg(&caller->arena, nr, t);
         }
         default:
             return NULL;
@@ -296,7 +297,7 @@ static void ir_inline_move_after(IRBlock* from, IRInst* start, IRBlock* to) {
 
 static IRInst* ir_inline_emit_copy(IRBlock* b, IRType* t, int dest, IRValue* src) {
     if (!b || !t || dest < 0 || !src) return NULL;
-    IRInst* c = ir_inst_new(IR_OP_COPY, t, dest);
+    IRInst* c = ir_inst_new(&b->parent->arena, IR_OP_COPY, t, dest);
     if (!c) return NULL;
     ir_inst_add_operand(c, src);
     ir_block_append(b, c);
@@ -332,17 +333,17 @@ static int ir_inline_clone_block_body(IRFunc* caller,
                                                         caller);
                     if (!rv) return 0;
 
-                IRType* ret_ptr_type = ir_type_ptr(ret_type);
+                IRType* ret_ptr_type = ir_type_ptr(&caller->arena, ret_type);
                 if (!ret_ptr_type) return 0;
-                IRValue* ptrv = ir_value_reg(ret_slot_reg, ret_ptr_type);
-                IRInst* st = ir_inst_store(rv, ptrv);
+                IRValue* ptrv = ir_value_reg(&caller->arena, ret_slot_reg, ret_ptr_type);
+                IRInst* st = ir_inst_store(&caller->arena, rv, ptrv);
                 if (!st) return 0;
                 ir_inst_set_loc(st, inst->src_file, inst->src_line, inst->src_col);
                 ir_inst_set_dbg_name(st, inst->dbg_name);
                 ir_block_append(new_block, st);
             }
 
-            IRInst* br = ir_inst_br(cont);
+            IRInst* br = ir_inst_br(&caller->arena, cont);
             if (!br) return 0;
             ir_inst_set_loc(br, inst->src_file, inst->src_line, inst->src_col);
             ir_block_append(new_block, br);
@@ -354,7 +355,7 @@ static int ir_inline_clone_block_body(IRFunc* caller,
             IRBlock* tgt_old = inst->operands[0]->data.block;
             IRBlock* tgt_new = ir_inline_map_block(bm, bm_count, tgt_old);
             if (!tgt_new) return 0;
-            IRInst* br = ir_inst_br(tgt_new);
+            IRInst* br = ir_inst_br(&caller->arena, tgt_new);
             if (!br) return 0;
             ir_inst_set_loc(br, inst->src_file, inst->src_line, inst->src_col);
             ir_block_append(new_block, br);
@@ -373,13 +374,34 @@ static int ir_inline_clone_block_body(IRFunc* caller,
             IRBlock* t_new = ir_inline_map_block(bm, bm_count, t_old);
             IRBlock* f_new = ir_inline_map_block(bm, bm_count, f_old);
             if (!t_new || !f_new) return 0;
-            IRInst* brc = ir_inst_br_cond(cond, t_new, f_new);
+            IRInst* brc = ir_inst_br_cond(&caller->arena, cond, t_new, f_new);
             if (!brc) return 0;
             ir_inst_set_loc(brc, inst->src_file, inst->src_line, inst->src_col);
             ir_block_append(new_block, brc);
             continue;
         }
 
+        if (inst->op == IR_OP_SWITCH) {
+            if (inst->operand_count < 2 || !inst->operands[1]) return 0;
+            IRValue* v = ir_inline_clone_value(inst->operands[0], bm, bm_count,
+                                              reg_map, reg_map_len,
+                                              old_reg_types, old_reg_types_len,
+                                              caller);
+            if (!v) return 0;
+            IRBlock* d_new = ir_inline_map_block(bm, bm_count, inst->operands[1]->data.block);
+            if (!d_new) return 0;
+            IRInst* sw = ir_inst_switch(&caller->arena, v, d_new);
+            if (!sw) return 0;
+            for (int k = 0; k < inst->switch_case_count; k++) {
+                IRBlock* t_new = ir_inline_map_block(bm, bm_count, inst->switch_cases[k].target);
+                if (!t_new) return 0;
+                ir_inst_switch_add_case(&caller->arena, sw, inst->switch_cases[k].value, t_new);
+            }
+            ir_inst_set_loc(sw, inst->src_file, inst->src_line, inst->src_col);
+            ir_block_append(new_block, sw);
+            continue;
+        }
+
         // تعليمات عادية / نداء.
         int new_dest = -1;
         if (inst->dest >= 0) {
@@ -411,19 +433,19 @@ static int ir_inline_clone_block_body(IRFunc* caller,
             }
 
             if (inst->call_target) {
-                clone = ir_inst_call(inst->call_target, inst->type, new_dest, args, ac);
+                clone = ir_inst_call(&caller->arena, inst->call_target, inst->type, new_dest, args, ac);
             } else if (inst->call_callee) {
                 IRValue* callee = ir_inline_clone_value(inst->call_callee, bm, bm_count,
                                                         reg_map, reg_map_len,
                                                         old_reg_types, old_reg_types_len,
                                                         caller);
                 if (!callee) return 0;
-                clone = ir_inst_call_indirect(callee, inst->type, new_dest, args, ac);
+                clone = ir_inst_call_indirect(&caller->arena, callee, inst->type, new_dest, args, ac);
             } else {
                 return 0;
             }
         } else {
-            clone = ir_inst_new(inst->op, inst->type, new_dest);
+            clone = ir_inst_new(&caller->arena, inst->op, inst->type, new_dest);
             if (clone) {
                 clone->cmp_pred = inst->cmp_pred;
                 for (int k = 0; k < inst->operand_count; k++) {
@@ -465,7 +487,7 @@ static int ir_inline_expand_site(IRInlineSite* site) {
     int cont_id = ir_func_alloc_block_id(caller);
     char cont_label[64];
     snprintf(cont_label, sizeof(cont_label), "inline_cont_%d", cont_id);
-    IRBlock* cont = ir_block_new(cont_label, cont_id);
+    IRBlock* cont = ir_block_new(&caller->arena, cont_label, cont_id);
     if (!cont) return 0;
     ir_func_add_block(caller, cont);
 
@@ -520,7 +542,7 @@ static int ir_inline_expand_site(IRInlineSite* site) {
     int call_dest = call->dest;
     if (ret_type && ret_type->kind != IR_TYPE_VOID) {
         ret_slot_reg = ir_func_alloc_reg(caller);
-        IRInst* alloca_ret = ir_inst_alloca(ret_type, ret_slot_reg);
+        IRInst* alloca_ret = ir_inst_alloca(&caller->arena, ret_type, ret_slot_reg);
         if (!alloca_ret) { free(reg_map); return 0; }
         ir_block_append(call_bb, alloca_ret);
     }
@@ -542,7 +564,7 @@ static int ir_inline_expand_site(IRInlineSite* site) {
                  callee->name ? callee->name : "fn",
                  b->id,
                  id);
-        IRBlock* nb = ir_block_new(label, id);
+        IRBlock* nb = ir_block_new(&caller->arena, label, id);
         if (!nb) { free(bm); free(reg_map); return 0; }
         ir_func_add_block(caller, nb);
         bm[bi].from = b;
@@ -554,7 +576,7 @@ static int ir_inline_expand_site(IRInlineSite* site) {
     if (!inl_entry) { free(bm); free(reg_map); return 0; }
 
     // استبدال مسار التحكم: call_bb ينتهي بقفز إلى inl_entry.
-    IRInst* br_into = ir_inst_br(inl_entry);
+    IRInst* br_into = ir_inst_br(&caller->arena, inl_entry);
     if (!br_into) { free(bm); free(reg_map); return 0; }
     ir_block_append(call_bb, br_into);
 
@@ -582,15 +604,15 @@ static int ir_inline_expand_site(IRInlineSite* site) {
             return 0;
         }
 
-        IRType* ret_ptr_type = ir_type_ptr(ret_type);
+        IRType* ret_ptr_type = ir_type_ptr(&caller->arena, ret_type);
         if (!ret_ptr_type) {
             free(bm);
             free(old_reg_types);
             free(reg_map);
             return 0;
         }
-        IRValue* ptrv = ir_value_reg(ret_slot_reg, ret_ptr_type);
-        IRInst* ld = ir_inst_load(ret_type, call_dest, ptrv);
+        IRValue* ptrv = ir_value_reg(&caller->arena, ret_slot_reg, ret_ptr_type);
+        IRInst* ld = ir_inst_load(&caller->arena, ret_type, call_dest, ptrv);
         if (!ld) {
             free(bm);
             free(old_reg_types);
@@ -614,7 +636,6 @@ bool ir_inline_run(IRModule* module) {
     if (!module) return false;
 
     // ضمان تهيئة سياق الساحة قبل أي إنشاء لأنواع/قيم جديدة داخل التضمين.
-    ir_module_set_current(module);
 
     // التضمين يُنفذ قبل Mem2Reg. إذا كانت هناك فاي، نتجاوز لتجنب إعادة التضمين.
     if (ir_inline_module_has_any_phi(module)) {
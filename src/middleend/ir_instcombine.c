@@ -21,9 +21,13 @@
 // IRPass integration
 // -----------------------------------------------------------------------------
 
+static bool ir_instcombine_run_func(IRFunc* func);
+
 IRPass IR_PASS_INSTCOMBINE = {
     .name = "دمج_التعليمات",
     .run = ir_instcombine_run,
+    .run_func = ir_instcombine_run_func,
+    .preserves = IR_ANALYSIS_CFG_ALL
 };
 
 // -----------------------------------------------------------------------------
@@ -64,12 +68,12 @@ static int64_t ic_trunc_to_type(int64_t v, IRType* t)
     return (int64_t)u;
 }
 
-static IRValue* ic_new_const_for_type(int64_t v, IRType* t)
+static IRValue* ic_new_const_for_type(IRArena* arena, int64_t v, IRType* t)
 {
-    return ir_value_const_int(ic_trunc_to_type(v, t), t);
+    return ir_value_const_int(arena, ic_trunc_to_type(v, t), t);
 }
 
-static IRValue* ic_clone_value_with_type(IRValue* v, IRType* override_type)
+static IRValue* ic_clone_value_with_type(IRArena* arena, IRValue* v, IRType* override_type)
 {
     if (!v) return NULL;
 
@@ -78,27 +82,27 @@ static IRValue* ic_clone_value_with_type(IRValue* v, IRType* override_type)
     switch (v->kind)
     {
         case IR_VAL_CONST_INT:
-            return ir_value_const_int(v->data.const_int, t);
+            return ir_value_const_int(arena, v->data.const_int, t);
 
         case IR_VAL_CONST_STR:
-            return ir_value_const_str(v->data.const_str.data, v->data.const_str.id);
+            return ir_value_const_str(arena, v->data.const_str.data, v->data.const_str.id);
 
         case IR_VAL_BAA_STR:
-            return ir_value_baa_str(v->data.const_str.data, v->data.const_str.id);
+            return ir_value_baa_str(arena, v->data.const_str.data, v->data.const_str.id);
 
         case IR_VAL_REG:
-            return ir_value_reg(v->data.reg_num, t);
+            return ir_value_reg(arena, v->data.reg_num, t);
 
         case IR_VAL_GLOBAL:
             if (v->type && v->type->kind == IR_TYPE_PTR)
-                return ir_value_global(v->data.global_name, v->type->data.pointee);
-            return ir_value_global(v->data.global_name, v->type);
+                return ir_value_global(arena, v->data.global_name, v->type->data.pointee);
+            return ir_value_global(arena, v->data.global_name, v->type);
 
         case IR_VAL_FUNC:
-            return ir_value_func_ref(v->data.global_name, t);
+            return ir_value_func_ref(arena, v->data.global_name, t);
 
         case IR_VAL_BLOCK:
-            return ir_value_block(v->data.block);
+            return ir_value_block(arena, v->data.block);
 
         case IR_VAL_NONE:
         default:
@@ -174,15 +178,15 @@ static int ic_simplify_phi(IRInst* inst)
 
     IRValue* repl = NULL;
     if (k == IR_VAL_CONST_INT)
-        repl = ic_new_const_for_type(ci, inst->type);
+        repl = ic_new_const_for_type(inst->arena, ci, inst->type);
     else if (k == IR_VAL_REG)
-        repl = ir_value_reg(rr, inst->type);
+        repl = ir_value_reg(inst->arena, rr, inst->type);
     else if (k == IR_VAL_GLOBAL)
     {
         if (e->value->type && e->value->type->kind == IR_TYPE_PTR)
-            repl = ir_value_global(gn, e->value->type->data.pointee);
+            repl = ir_value_global(inst->arena, gn, e->value->type->data.pointee);
         else
-            repl = ir_value_global(gn, e->value->type);
+            repl = ir_value_global(inst->arena, gn, e->value->type);
     }
 
     if (!repl)
@@ -211,7 +215,7 @@ static int ic_simplify_arith(IRInst* inst)
         case IR_OP_ADD:
             if (b && ir_value_is_const_int_local(b, &cb) && cb == 0)
             {
-                IRValue* src = ic_clone_value_with_type(a, inst->type);
+                IRValue* src = ic_clone_value_with_type(inst->arena, a, inst->type);
                 if (!src) return 0;
                 ic_rewrite_to_copy(inst, src);
                 return 1;
@@ -221,7 +225,7 @@ static int ic_simplify_arith(IRInst* inst)
         case IR_OP_SUB:
             if (b && ir_value_is_const_int_local(b, &cb) && cb == 0)
             {
-                IRValue* src = ic_clone_value_with_type(a, inst->type);
+                IRValue* src = ic_clone_value_with_type(inst->arena, a, inst->type);
                 if (!src) return 0;
                 ic_rewrite_to_copy(inst, src);
                 return 1;
@@ -231,14 +235,14 @@ static int ic_simplify_arith(IRInst* inst)
         case IR_OP_MUL:
             if (b && ir_value_is_const_int_local(b, &cb) && cb == 1)
             {
-                IRValue* src = ic_clone_value_with_type(a, inst->type);
+                IRValue* src = ic_clone_value_with_type(inst->arena, a, inst->type);
                 if (!src) return 0;
                 ic_rewrite_to_copy(inst, src);
                 return 1;
             }
             if (b && ir_value_is_const_int_local(b, &cb) && cb == 0)
             {
-                IRValue* c0 = ic_new_const_for_type(0, inst->type);
+                IRValue* c0 = ic_new_const_for_type(inst->arena, 0, inst->type);
                 if (!c0) return 0;
                 ic_rewrite_to_copy(inst, c0);
                 return 1;
@@ -248,7 +252,7 @@ static int ic_simplify_arith(IRInst* inst)
         case IR_OP_AND:
             if (b && ir_value_is_const_int_local(b, &cb) && cb == 0)
             {
-                IRValue* c0 = ic_new_const_for_type(0, inst->type);
+                IRValue* c0 = ic_new_const_for_type(inst->arena, 0, inst->type);
                 if (!c0) return 0;
                 ic_rewrite_to_copy(inst, c0);
                 return 1;
@@ -258,7 +262,7 @@ static int ic_simplify_arith(IRInst* inst)
         case IR_OP_OR:
             if (b && ir_value_is_const_int_local(b, &cb) && cb == 0)
             {
-                IRValue* src = ic_clone_value_with_type(a, inst->type);
+                IRValue* src = ic_clone_value_with_type(inst->arena, a, inst->type);
                 if (!src) return 0;
                 ic_rewrite_to_copy(inst, src);
                 return 1;
@@ -268,7 +272,7 @@ static int ic_simplify_arith(IRInst* inst)
         case IR_OP_NEG:
             if (a && ir_value_is_const_int_local(a, &ca))
             {
-                IRValue* c = ic_new_const_for_type(-ca, inst->type);
+                IRValue* c = ic_new_const_for_type(inst->arena, -ca, inst->type);
                 if (!c) return 0;
                 ic_rewrite_to_copy(inst, c);
                 return 1;
@@ -278,7 +282,7 @@ static int ic_simplify_arith(IRInst* inst)
         case IR_OP_NOT:
             if (a && inst->type && inst->type->kind == IR_TYPE_I1 && ir_value_is_const_int_local(a, &ca))
             {
-                IRValue* c = ic_new_const_for_type(ca ? 0 : 1, inst->type);
+                IRValue* c = ic_new_const_for_type(inst->arena, ca ? 0 : 1, inst->type);
                 if (!c) return 0;
                 ic_rewrite_to_copy(inst, c);
                 return 1;
@@ -315,7 +319,7 @@ static int ic_simplify_arith(IRInst* inst)
                     default: return 0;
                 }
 
-                IRValue* c = ic_new_const_for_type(res, inst->type);
+                IRValue* c = ic_new_const_for_type(inst->arena, res, inst->type);
                 if (!c) return 0;
                 ic_rewrite_to_copy(inst, c);
                 return 1;
@@ -339,7 +343,7 @@ static int ic_simplify_arith(IRInst* inst)
                     default: return 0;
                 }
 
-                IRValue* c = ic_new_const_for_type(res, inst->type);
+                IRValue* c = ic_new_const_for_type(inst->arena, res, inst->type);
                 if (!c) return 0;
                 ic_rewrite_to_copy(inst, c);
                 return 1;
@@ -388,11 +392,14 @@ bool ir_instcombine_run(IRModule* module)
 {
     if (!module) return false;
 
-    ir_module_set_current(module);
-
     int changed = 0;
     for (IRFunc* f = module->funcs; f; f = f->next)
         changed |= ir_instcombine_func(f);
 
     return changed ? true : false;
 }
+
+static bool ir_instcombine_run_func(IRFunc* func)
+{
+    return ir_instcombine_func(func) ? true : false;
+}
@@ -5,20 +5,30 @@
  * ملاحظات مهمة:
  * - هذه النسخة تُطبّق LICM بشكل محافظ جداً:
  *   - ننقل فقط تعليمات "نقية" غير قابلة للمصائد.
- *   - نعتمد على تحليل الحلقات الطبيعية عبر `ir_loop_analyze_func()`.
+ *   - نعتمد على تحليل الحلقات الطبيعية المخزن عبر `ir_analysis_require_loops()`.
+ * - الحمل يُنقل إن كان عنوانه ثابتاً ولا يكتب أي خزن/نداء في الحلقة موقعه
+ *   (ir_alias.h)، وكان آمناً قبل دخول الحلقة: داخل حجز/عام معروف الحجم،
+ *   أو في رأس الحلقة قبل أي تعليمة قد تُنهي التنفيذ (نداء، قسمة/باقي على
+ *   غير ثابت، وصول خارج كائن معروف)؛ فهو يُنفَّذ في كل دخول على أي حال.
  */
 
 #include "ir_licm.h"
 
+#include "ir_alias.h"
+#include "ir_analysis_manager.h"
 #include "ir_defuse.h"
 #include "ir_loop.h"
 #include "ir_mutate.h"
 
 #include <stdlib.h>
 
+static bool ir_licm_run_func(IRFunc* func);
+
 IRPass IR_PASS_LICM = {
     .name = "LICM",
-    .run = ir_licm_run
+    .run = ir_licm_run,
+    .run_func = ir_licm_run_func,
+    .preserves = IR_ANALYSIS_CFG_ALL
 };
 
 static int ir_licm_is_safe_op(IROp op) {
@@ -35,6 +45,7 @@ static int ir_licm_is_safe_op(IROp op) {
         case IR_OP_CMP:
         case IR_OP_CAST:
         case IR_OP_COPY:
+        case IR_OP_PTR_OFFSET:
             return 1;
         default:
             return 0;
@@ -80,7 +91,8 @@ static int ir_licm_inst_is_invariant(IRInst* inst, const IRLoop* loop, const IRD
     if (inst->dest < 0) return 0;
 
     // لا ننقل فاي أو المنهيات.
-    if (inst->op == IR_OP_PHI || inst->op == IR_OP_BR || inst->op == IR_OP_BR_COND || inst->op == IR_OP_RET) {
+    if (inst->op == IR_OP_PHI || inst->op == IR_OP_BR || inst->op == IR_OP_BR_COND ||
+        inst->op == IR_OP_SWITCH || inst->op == IR_OP_RET) {
         return 0;
     }
 
@@ -95,7 +107,67 @@ static int ir_licm_inst_is_invariant(IRInst* inst, const IRLoop* loop, const IRD
     return 1;
 }
 
-static int ir_licm_loop(IRFunc* func, IRLoop* loop) {
+/** هل يكتب أي خزن أو نداء داخل الحلقة في موقع الحمل؟ */
+static int ir_licm_loop_may_clobber(const IRLoop* loop, const IRAliasInfo* ai, const IRMemLoc* loc) {
+    int nblocks = ir_loop_block_count((IRLoop*)loop);
+    for (int bi = 0; bi < nblocks; bi++) {
+        IRBlock* b = ir_loop_block_at((IRLoop*)loop, bi);
+        if (!b) continue;
+        for (IRInst* inst = b->first; inst; inst = inst->next) {
+            if (inst->op == IR_OP_STORE) {
+                IRMemLoc store_loc;
+                if (!ir_alias_inst_loc(ai, inst, &store_loc)) return 1;
+                if (ir_alias_query(ai, &store_loc, loc) != IR_ALIAS_NO) return 1;
+            } else if (inst->op == IR_OP_CALL) {
+                if (ir_alias_call_modref(ai, inst, loc) & IR_MODREF_MOD) return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/** هل قد تُنهي التعليمة التنفيذ (مصيدة أو خروج) فلا يجوز تقديم حمل عليها؟ */
+static int ir_licm_inst_may_trap(IRInst* inst, const IRAliasInfo* ai) {
+    switch (inst->op) {
+        case IR_OP_CALL:
+            return 1;
+        case IR_OP_DIV:
+        case IR_OP_MOD: {
+            if (inst->type && inst->type->kind == IR_TYPE_F64) return 0;
+            IRValue* d = (inst->operand_count >= 2) ? inst->operands[1] : NULL;
+            // القسمة على ٠ أو −١ (فيض أصغر عدد) تُطلق مصيدة.
+            return !d || d->kind != IR_VAL_CONST_INT || d->data.const_int == 0 || d->data.const_int == -1;
+        }
+        case IR_OP_LOAD:
+        case IR_OP_STORE: {
+            IRMemLoc loc;
+            return !ir_alias_inst_loc(ai, inst, &loc) || !ir_alias_loc_is_dereferenceable(&loc);
+        }
+        default:
+            return 0;
+    }
+}
+
+static int ir_licm_load_is_invariant(IRInst* inst, const IRLoop* loop, const IRDefUse* du,
+                                     const IRAliasInfo* ai) {
+    if (!inst || inst->op != IR_OP_LOAD || inst->dest < 0 || !ai) return 0;
+    if (inst->operand_count < 1 || !ir_licm_value_is_invariant(inst->operands[0], loop, du)) return 0;
+
+    IRMemLoc loc;
+    if (!ir_alias_inst_loc(ai, inst, &loc) || loc.size <= 0) return 0;
+
+    // تنفيذ الحمل قبل الحلقة يجب ألا يُدخل مصيدة لم تكن.
+    if (!ir_alias_loc_is_dereferenceable(&loc)) {
+        if (inst->parent != ir_loop_header((IRLoop*)loop)) return 0;
+        for (IRInst* it = inst->parent->first; it && it != inst; it = it->next) {
+            if (ir_licm_inst_may_trap(it, ai)) return 0;
+        }
+    }
+
+    return ir_licm_loop_may_clobber(loop, ai, &loc) ? 0 : 1;
+}
+
+static int ir_licm_loop(IRFunc* func, IRLoop* loop, const IRAliasInfo* ai) {
     if (!func || !loop) return 0;
 
     IRBlock* preheader = ir_loop_preheader(loop);
@@ -138,7 +210,8 @@ static int ir_licm_loop(IRFunc* func, IRLoop* loop) {
                     continue;
                 }
 
-                if (ir_licm_inst_is_invariant(inst, loop, du)) {
+                if (ir_licm_inst_is_invariant(inst, loop, du) ||
+                    ir_licm_load_is_invariant(inst, loop, du, ai)) {
                     // انقل إلى preheader قبل المنهي.
                     ir_block_remove_inst(b, inst);
                     ir_block_insert_before(preheader, preheader->last, inst);
@@ -160,18 +233,24 @@ static int ir_licm_func(IRFunc* func) {
     if (func->is_prototype) return 0;
     if (!func->entry) return 0;
 
-    IRLoopInfo* info = ir_loop_analyze_func(func);
+    // معلومات الحلقات مملوكة لكاش مدير التحليلات (LICM لا يغيّر CFG).
+    IRLoopInfo* info = ir_analysis_require_loops(func);
     if (!info) return 0;
 
-    int changed = 0;
     int n = ir_loop_info_count(info);
+    if (n <= 0) return 0;
+
+    // النقل لا يحذف تعليمات اشتقاق العناوين، فمعلومات التسمية تبقى صالحة.
+    IRAliasInfo* ai = ir_alias_info_build(func);
+
+    int changed = 0;
     for (int i = 0; i < n; i++) {
         IRLoop* loop = ir_loop_info_get(info, i);
         if (!loop) continue;
-        changed |= ir_licm_loop(func, loop);
+        changed |= ir_licm_loop(func, loop, ai);
     }
 
-    ir_loop_info_free(info);
+    ir_alias_info_free(ai);
     return changed;
 }
 
@@ -185,3 +264,7 @@ bool ir_licm_run(IRModule* module) {
 
     return changed ? true : false;
 }
+
+static bool ir_licm_run_func(IRFunc* func) {
+    return ir_licm_func(func) ? true : false;
+}
@@ -7,7 +7,8 @@
  *   والتي تعتمد فقط على قيم ثابتة/خارج الحلقة، ثم نقلها إلى ما قبل رأس الحلقة.
  *
  * قيود السلامة (v0.3.2.7.1):
- * - لا نقوم بنقل عمليات الذاكرة أو الاستدعاءات.
+ * - لا ننقل الخزن أو الاستدعاءات؛ الحمل يُنقل فقط إن لم يكتب شيء في الحلقة
+ *   موقعه حسب تحليل التسمية (ir_alias.h) وكان تنفيذه مبكراً آمناً.
  * - لا ننقل القسمة/الباقي لتجنب تغيير سلوك المصائد عند عدم دخول الحلقة.
  * - نحتاج preheader وحيد لرأس الحلقة (وإلا نتجاوز تلك الحلقة).
  */
@@ -254,6 +254,13 @@ IRLoopInfo* ir_loop_analyze_func(IRFunc* func) {
 
     // ضمان وجود preds و idom.
     ir_func_compute_dominators(func);
+    return ir_loop_info_build(func);
+}
+
+IRLoopInfo* ir_loop_info_build(IRFunc* func) {
+    if (!func) return NULL;
+    if (func->is_prototype) return NULL;
+    if (!func->entry) return NULL;
 
     int max_id = ir_func_max_block_id_local(func);
     if (max_id <= 0) return NULL;
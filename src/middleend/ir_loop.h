@@ -36,6 +36,13 @@ typedef struct IRLoopInfo IRLoopInfo;
  */
 IRLoopInfo* ir_loop_analyze_func(IRFunc* func);
 
+/**
+ * @brief بناء معلومات الحلقات من idom الحالية دون إعادة حساب السيطرة.
+ *
+ * يستخدمه مدير التحليلات عندما تكون السيطرة المخزنة صالحة.
+ */
+IRLoopInfo* ir_loop_info_build(IRFunc* func);
+
 /**
  * @brief تحرير معلومات الحلقات.
  */
@@ -137,12 +137,14 @@ void lower_stmt_list(IRLowerCtx* ctx, Node* first_stmt);
  *
  * This is the main integration entry point for the driver pipeline in v0.3.0.7.
  *
+ * @param module Destination module created by the caller (ir_module_new()); all
+ *        globals and functions are added to it and allocated from its arenas.
  * @param program Root AST node (must be NODE_PROGRAM).
- * @param module_name Optional module name (usually filename).
- * @return Newly allocated IRModule (caller owns; free with ir_module_free()).
+ * @return true on success; on failure the module may be partially populated and the
+ *         caller still owns it (free with ir_module_free()).
  */
-IRModule* ir_lower_program(Node* program, const char* module_name,
-                           unsigned runtime_check_mask, const BaaTarget* target);
+bool ir_lower_program(IRModule* module, Node* program,
+                      unsigned runtime_check_mask, const BaaTarget* target);
 
 #ifdef __cplusplus
 }
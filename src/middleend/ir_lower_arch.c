@@ -39,23 +39,23 @@ static bool ir_lower_try_arch_builtin(IRLowerCtx* ctx,
     if (expr->data.call.args) {
         ir_lower_report_error(ctx, expr, "استدعاء '%s' لا يقبل معاملات.", name);
         ir_lower_eval_call_args(ctx, expr->data.call.args);
-        if (out_value) *out_value = ir_builder_const_i64(0);
+        if (out_value) *out_value = ir_builder_const_i64(ctx->builder, 0);
         return true;
     }
 
     ir_lower_set_loc(ctx->builder, expr);
     if (strcmp(name, "لا_تفعل") == 0) {
         ir_builder_emit_cpu_nop(ctx->builder);
-        if (out_value) *out_value = ir_builder_const_i64(0);
+        if (out_value) *out_value = ir_builder_const_i64(ctx->builder, 0);
         return true;
     }
 
     int result = ir_builder_emit_read_tsc(ctx->builder);
     if (result < 0) {
         ir_lower_report_error(ctx, expr, "فشل خفض قراءة عداد الزمن.");
-        if (out_value) *out_value = ir_builder_const_i64(0);
+        if (out_value) *out_value = ir_builder_const_i64(ctx->builder, 0);
         return true;
     }
-    if (out_value) *out_value = ir_value_reg(result, IR_TYPE_I64_T);
+    if (out_value) *out_value = ir_value_reg(ctx->builder->arena, result, IR_TYPE_I64_T);
     return true;
 }
@@ -109,7 +109,7 @@ static void ir_lower_emit_function_return_after_noreturn(IRLowerCtx* ctx)
     if (!f || !f->ret_type || f->ret_type->kind == IR_TYPE_VOID) {
         ir_builder_emit_ret_void(ctx->builder);
     } else {
-        IRValue* z = ir_value_const_int(0, f->ret_type);
+        IRValue* z = ir_value_const_int(ctx->builder->arena, 0, f->ret_type);
         ir_builder_emit_ret(ctx->builder, z);
     }
 }
@@ -118,7 +118,7 @@ static void ir_lower_emit_exit_failure_path(IRLowerCtx* ctx)
 {
     if (!ctx || !ctx->builder) return;
 
-    IRValue* code = ir_value_const_int(BAA_RUNTIME_FAILURE_EXIT_CODE, IR_TYPE_I32_T);
+    IRValue* code = ir_value_const_int(ctx->builder->arena, BAA_RUNTIME_FAILURE_EXIT_CODE, IR_TYPE_I32_T);
     IRValue* args[1] = { code };
     ir_builder_emit_call_void(ctx->builder, "exit", args, 1);
     ir_lower_emit_function_return_after_noreturn(ctx);
@@ -172,14 +172,14 @@ static void ir_lower_emit_debug_bounds_check_value(IRLowerCtx* ctx,
 
     IRValue* i64_idx = ensure_i64(ctx, idx);
     IRValue* i64_dim = ensure_i64(ctx, dim);
-    IRValue* zero = ir_value_const_int(0, IR_TYPE_I64_T);
+    IRValue* zero = ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
 
     int ge = ir_builder_emit_cmp_ge(ctx->builder, i64_idx, zero);
     int lt = ir_builder_emit_cmp_lt(ctx->builder, i64_idx, i64_dim);
-    IRValue* ge_v = ir_value_reg(ge, IR_TYPE_I1_T);
-    IRValue* lt_v = ir_value_reg(lt, IR_TYPE_I1_T);
+    IRValue* ge_v = ir_value_reg(ctx->builder->arena, ge, IR_TYPE_I1_T);
+    IRValue* lt_v = ir_value_reg(ctx->builder->arena, lt, IR_TYPE_I1_T);
     int okb = ir_builder_emit_and(ctx->builder, IR_TYPE_I1_T, ge_v, lt_v);
-    IRValue* ok = ir_value_reg(okb, IR_TYPE_I1_T);
+    IRValue* ok = ir_value_reg(ctx->builder->arena, okb, IR_TYPE_I1_T);
 
     IRBlock* pass = cf_create_block(ctx, "حدود_سليم");
     IRBlock* fail = cf_create_block(ctx, "حدود_فشل");
@@ -204,7 +204,7 @@ static void ir_lower_emit_debug_bounds_check(IRLowerCtx* ctx, const Node* site,
         !ir_lower_runtime_check_enabled(ctx, BAA_RUNTIME_CHECK_BOUNDS)) return;
     if (dim <= 0) return;
 
-    IRValue* dimv = ir_value_const_int((int64_t)dim, IR_TYPE_I64_T);
+    IRValue* dimv = ir_value_const_int(ctx->builder->arena, (int64_t)dim, IR_TYPE_I64_T);
     ir_lower_emit_debug_bounds_check_value(ctx, site, idx, dimv, "فهرس خارج حدود المصفوفة");
 }
 
@@ -216,13 +216,13 @@ static void ir_lower_emit_debug_null_check(IRLowerCtx* ctx, const Node* site, IR
     IRType* ptr_t = ptr->type;
     IRValue* checked = ptr;
     if (!ptr_t || ptr_t->kind != IR_TYPE_PTR) {
-        ptr_t = ir_type_ptr(IR_TYPE_I8_T);
+        ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
         checked = cast_to(ctx, ptr, ptr_t);
     }
 
-    IRValue* null_ptr = ir_value_const_int(0, ptr_t);
+    IRValue* null_ptr = ir_value_const_int(ctx->builder->arena, 0, ptr_t);
     int ok_r = ir_builder_emit_cmp_ne(ctx->builder, checked, null_ptr);
-    IRValue* ok = ir_value_reg(ok_r, IR_TYPE_I1_T);
+    IRValue* ok = ir_value_reg(ctx->builder->arena, ok_r, IR_TYPE_I1_T);
 
     IRBlock* pass = cf_create_block(ctx, "مؤشر_سليم");
     IRBlock* fail = cf_create_block(ctx, "مؤشر_فارغ");
@@ -251,9 +251,9 @@ static void ir_lower_emit_debug_div_zero_check(IRLowerCtx* ctx,
 
     IRType* value_t = divisor->type ? divisor->type : IR_TYPE_I64_T;
     IRValue* checked = cast_to(ctx, divisor, value_t);
-    IRValue* zero = ir_value_const_int(0, value_t);
+    IRValue* zero = ir_value_const_int(ctx->builder->arena, 0, value_t);
     int ok_r = ir_builder_emit_cmp_ne(ctx->builder, checked, zero);
-    IRValue* ok = ir_value_reg(ok_r, IR_TYPE_I1_T);
+    IRValue* ok = ir_value_reg(ctx->builder->arena, ok_r, IR_TYPE_I1_T);
 
     IRBlock* pass = cf_create_block(ctx, "قسمة_سليمة");
     IRBlock* fail = cf_create_block(ctx, "قسمة_على_صفر");
@@ -278,15 +278,15 @@ static void ir_lower_emit_debug_shift_width_check(IRLowerCtx* ctx, const Node* s
         !ir_lower_runtime_check_enabled(ctx, BAA_RUNTIME_CHECK_SHIFT)) return;
 
     IRValue* count64 = ensure_i64(ctx, count);
-    IRValue* zero = ir_value_const_int(0, IR_TYPE_I64_T);
-    IRValue* max_width = ir_value_const_int(64, IR_TYPE_I64_T);
+    IRValue* zero = ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
+    IRValue* max_width = ir_value_const_int(ctx->builder->arena, 64, IR_TYPE_I64_T);
 
     int ge = ir_builder_emit_cmp_ge(ctx->builder, count64, zero);
     int lt = ir_builder_emit_cmp_lt(ctx->builder, count64, max_width);
-    IRValue* ge_v = ir_value_reg(ge, IR_TYPE_I1_T);
-    IRValue* lt_v = ir_value_reg(lt, IR_TYPE_I1_T);
+    IRValue* ge_v = ir_value_reg(ctx->builder->arena, ge, IR_TYPE_I1_T);
+    IRValue* lt_v = ir_value_reg(ctx->builder->arena, lt, IR_TYPE_I1_T);
     int ok_r = ir_builder_emit_and(ctx->builder, IR_TYPE_I1_T, ge_v, lt_v);
-    IRValue* ok = ir_value_reg(ok_r, IR_TYPE_I1_T);
+    IRValue* ok = ir_value_reg(ctx->builder->arena, ok_r, IR_TYPE_I1_T);
 
     IRBlock* pass = cf_create_block(ctx, "إزاحة_سليمة");
     IRBlock* fail = cf_create_block(ctx, "إزاحة_فشل");
@@ -312,11 +312,11 @@ static IRValue* ir_lower_build_linear_index(IRLowerCtx* ctx,
                                             const int* dims,
                                             int rank)
 {
-    if (!ctx || !ctx->builder) return ir_value_const_int(0, IR_TYPE_I64_T);
-    if (!indices) return ir_value_const_int(0, IR_TYPE_I64_T);
+    if (!ctx || !ctx->builder) return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
+    if (!indices) return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
 
     int effective_count = index_count > 0 ? index_count : ir_lower_index_count(indices);
-    if (effective_count <= 0) return ir_value_const_int(0, IR_TYPE_I64_T);
+    if (effective_count <= 0) return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
 
     IRValue* linear = NULL;
     int i = 0;
@@ -336,12 +336,12 @@ static IRValue* ir_lower_build_linear_index(IRLowerCtx* ctx,
         int dim = (dims && i < rank) ? dims[i] : 0;
         if (dim > 0) {
             int mr = ir_builder_emit_mul(ctx->builder, IR_TYPE_I64_T, linear,
-                                         ir_value_const_int((int64_t)dim, IR_TYPE_I64_T));
-            linear = ir_value_reg(mr, IR_TYPE_I64_T);
+                                         ir_value_const_int(ctx->builder->arena, (int64_t)dim, IR_TYPE_I64_T));
+            linear = ir_value_reg(ctx->builder->arena, mr, IR_TYPE_I64_T);
         }
 
         int ar = ir_builder_emit_add(ctx->builder, IR_TYPE_I64_T, linear, idx);
-        linear = ir_value_reg(ar, IR_TYPE_I64_T);
+        linear = ir_value_reg(ctx->builder->arena, ar, IR_TYPE_I64_T);
     }
 
     if (rank > 0 && effective_count != rank) {
@@ -350,11 +350,11 @@ static IRValue* ir_lower_build_linear_index(IRLowerCtx* ctx,
                               rank, effective_count);
     }
 
-    return linear ? linear : ir_value_const_int(0, IR_TYPE_I64_T);
+    return linear ? linear : ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
 }
 
 static IRValue* lower_to_bool(IRLowerCtx* ctx, IRValue* value) {
-    if (!ctx || !ctx->builder || !value) return ir_value_const_int(0, IR_TYPE_I1_T);
+    if (!ctx || !ctx->builder || !value) return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I1_T);
 
     // If already i1, keep it.
     if (value->type && value->type->kind == IR_TYPE_I1) {
@@ -363,10 +363,10 @@ static IRValue* lower_to_bool(IRLowerCtx* ctx, IRValue* value) {
 
     // Compare value != 0 to produce i1.
     IRType* vt = value->type ? value->type : IR_TYPE_I64_T;
-    IRValue* zero = ir_value_const_int(0, vt);
+    IRValue* zero = ir_value_const_int(ctx->builder->arena, 0, vt);
 
     int reg = ir_builder_emit_cmp_ne(ctx->builder, value, zero);
-    return ir_value_reg(reg, IR_TYPE_I1_T);
+    return ir_value_reg(ctx->builder->arena, reg, IR_TYPE_I1_T);
 }
 
 static IROp ir_binop_to_irop(OpType op) {
@@ -502,57 +502,54 @@ static void ir_lower_eval_call_args(IRLowerCtx* ctx, Node* args)
 static IRValue* ir_lower_as_char_ptr(IRLowerCtx* ctx, IRValue* v)
 {
     IRModule* m = (ctx && ctx->builder) ? ctx->builder->module : NULL;
-    if (m) ir_module_set_current(m);
     IRType* char_ptr_t = get_char_ptr_type(m);
-    if (!v) return ir_value_const_int(0, char_ptr_t);
+    if (!v) return ir_value_const_int(ctx->builder->arena, 0, char_ptr_t);
     if (v->type && ir_types_equal(v->type, char_ptr_t)) return v;
     int cr = ir_builder_emit_cast(ctx->builder, v, char_ptr_t);
-    return ir_value_reg(cr, char_ptr_t);
+    return ir_value_reg(ctx->builder->arena, cr, char_ptr_t);
 }
 
 static IRValue* ir_lower_load_char_at(IRLowerCtx* ctx, IRValue* base, IRValue* idx)
 {
     if (!ctx || !ctx->builder || !base || !idx) {
-        return ir_value_const_int(0, IR_TYPE_CHAR_T);
+        return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_CHAR_T);
     }
     IRModule* m = ctx->builder->module;
-    if (m) ir_module_set_current(m);
     IRType* char_ptr_t = get_char_ptr_type(m);
     IRValue* i64_idx = ensure_i64(ctx, idx);
     int ep = ir_builder_emit_ptr_offset(ctx->builder, char_ptr_t, base, i64_idx);
-    IRValue* elem_ptr = ir_value_reg(ep, char_ptr_t);
+    IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, char_ptr_t);
     int lr = ir_builder_emit_load(ctx->builder, IR_TYPE_CHAR_T, elem_ptr);
-    return ir_value_reg(lr, IR_TYPE_CHAR_T);
+    return ir_value_reg(ctx->builder->arena, lr, IR_TYPE_CHAR_T);
 }
 
 static void ir_lower_store_char_at(IRLowerCtx* ctx, IRValue* base, IRValue* idx, IRValue* ch)
 {
     if (!ctx || !ctx->builder || !base || !idx || !ch) return;
     IRModule* m = ctx->builder->module;
-    if (m) ir_module_set_current(m);
     IRType* char_ptr_t = get_char_ptr_type(m);
     IRValue* i64_idx = ensure_i64(ctx, idx);
     int ep = ir_builder_emit_ptr_offset(ctx->builder, char_ptr_t, base, i64_idx);
-    IRValue* elem_ptr = ir_value_reg(ep, char_ptr_t);
+    IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, char_ptr_t);
     IRValue* v = cast_to(ctx, ch, IR_TYPE_CHAR_T);
     ir_builder_emit_store(ctx->builder, v, elem_ptr);
 }
 
 static IRValue* ir_lower_char_bits_to_i64(IRLowerCtx* ctx, IRValue* ch)
 {
-    if (!ctx || !ctx->builder || !ch) return ir_value_const_int(0, IR_TYPE_I64_T);
+    if (!ctx || !ctx->builder || !ch) return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
     if (ch->type && ch->type->kind == IR_TYPE_I64) return ch;
     // ملاحظة: هذا تحويل "بتّي" للحصول على الحقول المعبأة (bytes + len) بدون فك ترميز الحرف.
     int r = ir_builder_emit_cast(ctx->builder, ch, IR_TYPE_I64_T);
-    return ir_value_reg(r, IR_TYPE_I64_T);
+    return ir_value_reg(ctx->builder->arena, r, IR_TYPE_I64_T);
 }
 
 static IRValue* ir_lower_i64_bits_to_char(IRLowerCtx* ctx, IRValue* bits)
 {
-    if (!ctx || !ctx->builder || !bits) return ir_value_const_int(0, IR_TYPE_CHAR_T);
+    if (!ctx || !ctx->builder || !bits) return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_CHAR_T);
     if (bits->type && bits->type->kind == IR_TYPE_CHAR) return bits;
     int r = ir_builder_emit_cast(ctx->builder, bits, IR_TYPE_CHAR_T);
-    return ir_value_reg(r, IR_TYPE_CHAR_T);
+    return ir_value_reg(ctx->builder->arena, r, IR_TYPE_CHAR_T);
 }
 
 /**
@@ -563,31 +560,30 @@ static IRValue* ir_lower_i64_bits_to_char(IRLowerCtx* ctx, IRValue* bits)
  */
 static IRValue* ir_lower_baa_string_to_cstr_alloc(IRLowerCtx* ctx, const Node* site, IRValue* str_in)
 {
-    if (!ctx || !ctx->builder) return ir_value_const_int(0, ir_type_ptr(IR_TYPE_I8_T));
+    if (!ctx || !ctx->builder) return ir_value_const_int(ctx->builder->arena, 0, ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T));
 
     IRBuilder* b = ctx->builder;
     IRModule* m = b->module;
-    if (m) ir_module_set_current(m);
 
     IRType* char_ptr_t = get_char_ptr_type(m);
-    IRType* i8_ptr_t = ir_type_ptr(IR_TYPE_I8_T);
+    IRType* i8_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
 
     IRValue* base = ir_lower_as_char_ptr(ctx, str_in);
-    if (!base) base = ir_value_const_int(0, char_ptr_t);
+    if (!base) base = ir_value_const_int(ctx->builder->arena, 0, char_ptr_t);
 
     int res_ptr_reg = ir_builder_emit_alloca(b, i8_ptr_t);
-    IRValue* res_ptr = ir_value_reg(res_ptr_reg, ir_type_ptr(i8_ptr_t));
-    ir_builder_emit_store(b, ir_value_const_int(0, i8_ptr_t), res_ptr);
+    IRValue* res_ptr = ir_value_reg(ctx->builder->arena, res_ptr_reg, ir_type_ptr(ctx->builder->arena, i8_ptr_t));
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, i8_ptr_t), res_ptr);
 
     IRValue* base_i8 = cast_to(ctx, base, i8_ptr_t);
-    int is_null_r = ir_builder_emit_cmp_eq(b, base_i8, ir_value_const_int(0, i8_ptr_t));
-    IRValue* is_null = ir_value_reg(is_null_r, IR_TYPE_I1_T);
+    int is_null_r = ir_builder_emit_cmp_eq(b, base_i8, ir_value_const_int(ctx->builder->arena, 0, i8_ptr_t));
+    IRValue* is_null = ir_value_reg(ctx->builder->arena, is_null_r, IR_TYPE_I1_T);
 
     IRBlock* nullb = cf_create_block(ctx, "نص_إلى_سي_فارغ");
     IRBlock* notnull = cf_create_block(ctx, "نص_إلى_سي_غير_فارغ");
     IRBlock* final_done = cf_create_block(ctx, "نص_إلى_سي_نهاية");
     if (!nullb || !notnull || !final_done) {
-        return ir_value_const_int(0, i8_ptr_t);
+        return ir_value_const_int(ctx->builder->arena, 0, i8_ptr_t);
     }
 
     if (!ir_builder_is_block_terminated(b)) {
@@ -596,7 +592,7 @@ static IRValue* ir_lower_baa_string_to_cstr_alloc(IRLowerCtx* ctx, const Node* s
 
     ir_builder_set_insert_point(b, nullb);
     ir_lower_set_loc(b, site);
-    ir_builder_emit_store(b, ir_value_const_int(0, i8_ptr_t), res_ptr);
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, i8_ptr_t), res_ptr);
     ir_builder_emit_br(b, final_done);
 
     ir_builder_set_insert_point(b, notnull);
@@ -605,10 +601,10 @@ static IRValue* ir_lower_baa_string_to_cstr_alloc(IRLowerCtx* ctx, const Node* s
     // 1) حساب طول البايتات
     int idx_ptr_reg = ir_builder_emit_alloca(b, IR_TYPE_I64_T);
     int blen_ptr_reg = ir_builder_emit_alloca(b, IR_TYPE_I64_T);
-    IRValue* idx_ptr = ir_value_reg(idx_ptr_reg, ir_type_ptr(IR_TYPE_I64_T));
-    IRValue* blen_ptr = ir_value_reg(blen_ptr_reg, ir_type_ptr(IR_TYPE_I64_T));
-    ir_builder_emit_store(b, ir_value_const_int(0, IR_TYPE_I64_T), idx_ptr);
-    ir_builder_emit_store(b, ir_value_const_int(0, IR_TYPE_I64_T), blen_ptr);
+    IRValue* idx_ptr = ir_value_reg(ctx->builder->arena, idx_ptr_reg, ir_type_ptr(ctx->builder->arena, IR_TYPE_I64_T));
+    IRValue* blen_ptr = ir_value_reg(ctx->builder->arena, blen_ptr_reg, ir_type_ptr(ctx->builder->arena, IR_TYPE_I64_T));
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T), idx_ptr);
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T), blen_ptr);
 
     IRBlock* count_head = cf_create_block(ctx, "نص_إلى_سي_عد_تحقق");
     IRBlock* count_step = cf_create_block(ctx, "نص_إلى_سي_عد_خطوة");
@@ -622,28 +618,28 @@ static IRValue* ir_lower_baa_string_to_cstr_alloc(IRLowerCtx* ctx, const Node* s
     ir_builder_set_insert_point(b, count_head);
     ir_lower_set_loc(b, site);
     int idx_r = ir_builder_emit_load(b, IR_TYPE_I64_T, idx_ptr);
-    IRValue* idx = ir_value_reg(idx_r, IR_TYPE_I64_T);
+    IRValue* idx = ir_value_reg(ctx->builder->arena, idx_r, IR_TYPE_I64_T);
     int ep = ir_builder_emit_ptr_offset(b, char_ptr_t, base, idx);
-    IRValue* elem_ptr = ir_value_reg(ep, char_ptr_t);
+    IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, char_ptr_t);
     int ch_r = ir_builder_emit_load(b, IR_TYPE_CHAR_T, elem_ptr);
-    IRValue* ch = ir_value_reg(ch_r, IR_TYPE_CHAR_T);
+    IRValue* ch = ir_value_reg(ctx->builder->arena, ch_r, IR_TYPE_CHAR_T);
     IRValue* ch_bits = ir_lower_char_bits_to_i64(ctx, ch);
-    int end_r = ir_builder_emit_cmp_eq(b, ch_bits, ir_value_const_int(0, IR_TYPE_I64_T));
-    IRValue* is_end = ir_value_reg(end_r, IR_TYPE_I1_T);
+    int end_r = ir_builder_emit_cmp_eq(b, ch_bits, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T));
+    IRValue* is_end = ir_value_reg(ctx->builder->arena, end_r, IR_TYPE_I1_T);
     ir_builder_emit_br_cond(b, is_end, count_done, count_step);
 
     ir_builder_set_insert_point(b, count_step);
     ir_lower_set_loc(b, site);
-    IRValue* len64 = ir_value_reg(ir_builder_emit_shr(b, IR_TYPE_I64_T, ch_bits,
-                                                      ir_value_const_int(32, IR_TYPE_I64_T)),
+    IRValue* len64 = ir_value_reg(ctx->builder->arena, ir_builder_emit_shr(b, IR_TYPE_I64_T, ch_bits,
+                                                      ir_value_const_int(ctx->builder->arena, 32, IR_TYPE_I64_T)),
                                   IR_TYPE_I64_T);
     int blen_r = ir_builder_emit_load(b, IR_TYPE_I64_T, blen_ptr);
-    IRValue* blen = ir_value_reg(blen_r, IR_TYPE_I64_T);
+    IRValue* blen = ir_value_reg(ctx->builder->arena, blen_r, IR_TYPE_I64_T);
     int blen2_r = ir_builder_emit_add(b, IR_TYPE_I64_T, blen, len64);
-    IRValue* blen2 = ir_value_reg(blen2_r, IR_TYPE_I64_T);
+    IRValue* blen2 = ir_value_reg(ctx->builder->arena, blen2_r, IR_TYPE_I64_T);
     ir_builder_emit_store(b, blen2, blen_ptr);
-    int idx2_r = ir_builder_emit_add(b, IR_TYPE_I64_T, idx, ir_value_const_int(1, IR_TYPE_I64_T));
-    IRValue* idx2 = ir_value_reg(idx2_r, IR_TYPE_I64_T);
+    int idx2_r = ir_builder_emit_add(b, IR_TYPE_I64_T, idx, ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T));
+    IRValue* idx2 = ir_value_reg(ctx->builder->arena, idx2_r, IR_TYPE_I64_T);
     ir_builder_emit_store(b, idx2, idx_ptr);
     ir_builder_emit_br(b, count_head);
 
@@ -651,28 +647,28 @@ static IRValue* ir_lower_baa_string_to_cstr_alloc(IRLowerCtx* ctx, const Node* s
     ir_builder_set_insert_point(b, count_done);
     ir_lower_set_loc(b, site);
     int blen3_r = ir_builder_emit_load(b, IR_TYPE_I64_T, blen_ptr);
-    IRValue* blen3 = ir_value_reg(blen3_r, IR_TYPE_I64_T);
-    int alloc_n_r = ir_builder_emit_add(b, IR_TYPE_I64_T, blen3, ir_value_const_int(1, IR_TYPE_I64_T));
-    IRValue* alloc_n = ir_value_reg(alloc_n_r, IR_TYPE_I64_T);
+    IRValue* blen3 = ir_value_reg(ctx->builder->arena, blen3_r, IR_TYPE_I64_T);
+    int alloc_n_r = ir_builder_emit_add(b, IR_TYPE_I64_T, blen3, ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T));
+    IRValue* alloc_n = ir_value_reg(ctx->builder->arena, alloc_n_r, IR_TYPE_I64_T);
     IRValue* margs[1] = { alloc_n };
     int buf_r = ir_builder_emit_call(b, "malloc", i8_ptr_t, margs, 1);
     if (buf_r < 0) {
         ir_lower_report_error(ctx, site, "فشل خفض نداء malloc أثناء تحويل نص إلى C-string.");
-        ir_builder_emit_store(b, ir_value_const_int(0, i8_ptr_t), res_ptr);
+        ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, i8_ptr_t), res_ptr);
         ir_builder_emit_br(b, final_done);
         ir_builder_set_insert_point(b, final_done);
         ir_lower_set_loc(b, site);
         int r_fail = ir_builder_emit_load(b, i8_ptr_t, res_ptr);
-        return ir_value_reg(r_fail, i8_ptr_t);
+        return ir_value_reg(ctx->builder->arena, r_fail, i8_ptr_t);
     }
-    IRValue* buf = ir_value_reg(buf_r, i8_ptr_t);
+    IRValue* buf = ir_value_reg(ctx->builder->arena, buf_r, i8_ptr_t);
 
     int fidx_ptr_reg = ir_builder_emit_alloca(b, IR_TYPE_I64_T);
     int out_ptr_reg = ir_builder_emit_alloca(b, IR_TYPE_I64_T);
-    IRValue* fidx_ptr = ir_value_reg(fidx_ptr_reg, ir_type_ptr(IR_TYPE_I64_T));
-    IRValue* out_ptr = ir_value_reg(out_ptr_reg, ir_type_ptr(IR_TYPE_I64_T));
-    ir_builder_emit_store(b, ir_value_const_int(0, IR_TYPE_I64_T), fidx_ptr);
-    ir_builder_emit_store(b, ir_value_const_int(0, IR_TYPE_I64_T), out_ptr);
+    IRValue* fidx_ptr = ir_value_reg(ctx->builder->arena, fidx_ptr_reg, ir_type_ptr(ctx->builder->arena, IR_TYPE_I64_T));
+    IRValue* out_ptr = ir_value_reg(ctx->builder->arena, out_ptr_reg, ir_type_ptr(ctx->builder->arena, IR_TYPE_I64_T));
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T), fidx_ptr);
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T), out_ptr);
 
     IRBlock* fill_head = cf_create_block(ctx, "نص_إلى_سي_ملء_تحقق");
     IRBlock* fill_body = cf_create_block(ctx, "نص_إلى_سي_ملء_جسم");
@@ -687,57 +683,57 @@ static IRValue* ir_lower_baa_string_to_cstr_alloc(IRLowerCtx* ctx, const Node* s
     ir_builder_set_insert_point(b, fill_head);
     ir_lower_set_loc(b, site);
     int fidx_r = ir_builder_emit_load(b, IR_TYPE_I64_T, fidx_ptr);
-    IRValue* fidx = ir_value_reg(fidx_r, IR_TYPE_I64_T);
+    IRValue* fidx = ir_value_reg(ctx->builder->arena, fidx_r, IR_TYPE_I64_T);
     int ep2 = ir_builder_emit_ptr_offset(b, char_ptr_t, base, fidx);
-    IRValue* elem_ptr2 = ir_value_reg(ep2, char_ptr_t);
+    IRValue* elem_ptr2 = ir_value_reg(ctx->builder->arena, ep2, char_ptr_t);
     int ch2_r = ir_builder_emit_load(b, IR_TYPE_CHAR_T, elem_ptr2);
-    IRValue* ch2 = ir_value_reg(ch2_r, IR_TYPE_CHAR_T);
+    IRValue* ch2 = ir_value_reg(ctx->builder->arena, ch2_r, IR_TYPE_CHAR_T);
     IRValue* ch2_bits = ir_lower_char_bits_to_i64(ctx, ch2);
-    int end2_r = ir_builder_emit_cmp_eq(b, ch2_bits, ir_value_const_int(0, IR_TYPE_I64_T));
-    IRValue* end2 = ir_value_reg(end2_r, IR_TYPE_I1_T);
+    int end2_r = ir_builder_emit_cmp_eq(b, ch2_bits, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T));
+    IRValue* end2 = ir_value_reg(ctx->builder->arena, end2_r, IR_TYPE_I1_T);
     ir_builder_emit_br_cond(b, end2, fill_done, fill_body);
 
     ir_builder_set_insert_point(b, fill_body);
     ir_lower_set_loc(b, site);
     int out_r = ir_builder_emit_load(b, IR_TYPE_I64_T, out_ptr);
-    IRValue* out = ir_value_reg(out_r, IR_TYPE_I64_T);
+    IRValue* out = ir_value_reg(ctx->builder->arena, out_r, IR_TYPE_I64_T);
 
-    IRValue* len2 = ir_value_reg(ir_builder_emit_shr(b, IR_TYPE_I64_T, ch2_bits,
-                                                     ir_value_const_int(32, IR_TYPE_I64_T)),
+    IRValue* len2 = ir_value_reg(ctx->builder->arena, ir_builder_emit_shr(b, IR_TYPE_I64_T, ch2_bits,
+                                                     ir_value_const_int(ctx->builder->arena, 32, IR_TYPE_I64_T)),
                                  IR_TYPE_I64_T);
-    IRValue* bytes_field = ir_value_reg(ir_builder_emit_and(b, IR_TYPE_I64_T, ch2_bits,
-                                                           ir_value_const_int(4294967295LL, IR_TYPE_I64_T)),
+    IRValue* bytes_field = ir_value_reg(ctx->builder->arena, ir_builder_emit_and(b, IR_TYPE_I64_T, ch2_bits,
+                                                           ir_value_const_int(ctx->builder->arena, 4294967295LL, IR_TYPE_I64_T)),
                                         IR_TYPE_I64_T);
 
-    IRValue* b0 = ir_value_reg(ir_builder_emit_and(b, IR_TYPE_I64_T, bytes_field,
-                                                   ir_value_const_int(255, IR_TYPE_I64_T)),
+    IRValue* b0 = ir_value_reg(ctx->builder->arena, ir_builder_emit_and(b, IR_TYPE_I64_T, bytes_field,
+                                                   ir_value_const_int(ctx->builder->arena, 255, IR_TYPE_I64_T)),
                                IR_TYPE_I64_T);
-    IRValue* b1s = ir_value_reg(ir_builder_emit_shr(b, IR_TYPE_I64_T, bytes_field,
-                                                    ir_value_const_int(8, IR_TYPE_I64_T)),
+    IRValue* b1s = ir_value_reg(ctx->builder->arena, ir_builder_emit_shr(b, IR_TYPE_I64_T, bytes_field,
+                                                    ir_value_const_int(ctx->builder->arena, 8, IR_TYPE_I64_T)),
                                 IR_TYPE_I64_T);
-    IRValue* b1 = ir_value_reg(ir_builder_emit_and(b, IR_TYPE_I64_T, b1s,
-                                                   ir_value_const_int(255, IR_TYPE_I64_T)),
+    IRValue* b1 = ir_value_reg(ctx->builder->arena, ir_builder_emit_and(b, IR_TYPE_I64_T, b1s,
+                                                   ir_value_const_int(ctx->builder->arena, 255, IR_TYPE_I64_T)),
                                IR_TYPE_I64_T);
-    IRValue* b2s = ir_value_reg(ir_builder_emit_shr(b, IR_TYPE_I64_T, bytes_field,
-                                                    ir_value_const_int(16, IR_TYPE_I64_T)),
+    IRValue* b2s = ir_value_reg(ctx->builder->arena, ir_builder_emit_shr(b, IR_TYPE_I64_T, bytes_field,
+                                                    ir_value_const_int(ctx->builder->arena, 16, IR_TYPE_I64_T)),
                                 IR_TYPE_I64_T);
-    IRValue* b2 = ir_value_reg(ir_builder_emit_and(b, IR_TYPE_I64_T, b2s,
-                                                   ir_value_const_int(255, IR_TYPE_I64_T)),
+    IRValue* b2 = ir_value_reg(ctx->builder->arena, ir_builder_emit_and(b, IR_TYPE_I64_T, b2s,
+                                                   ir_value_const_int(ctx->builder->arena, 255, IR_TYPE_I64_T)),
                                IR_TYPE_I64_T);
-    IRValue* b3s = ir_value_reg(ir_builder_emit_shr(b, IR_TYPE_I64_T, bytes_field,
-                                                    ir_value_const_int(24, IR_TYPE_I64_T)),
+    IRValue* b3s = ir_value_reg(ctx->builder->arena, ir_builder_emit_shr(b, IR_TYPE_I64_T, bytes_field,
+                                                    ir_value_const_int(ctx->builder->arena, 24, IR_TYPE_I64_T)),
                                 IR_TYPE_I64_T);
-    IRValue* b3 = ir_value_reg(ir_builder_emit_and(b, IR_TYPE_I64_T, b3s,
-                                                   ir_value_const_int(255, IR_TYPE_I64_T)),
+    IRValue* b3 = ir_value_reg(ctx->builder->arena, ir_builder_emit_and(b, IR_TYPE_I64_T, b3s,
+                                                   ir_value_const_int(ctx->builder->arena, 255, IR_TYPE_I64_T)),
                                IR_TYPE_I64_T);
 
     // اكتب b0 دائماً
     int dp0 = ir_builder_emit_ptr_offset(b, i8_ptr_t, buf, out);
-    IRValue* p0 = ir_value_reg(dp0, i8_ptr_t);
+    IRValue* p0 = ir_value_reg(ctx->builder->arena, dp0, i8_ptr_t);
     IRValue* b0_i8 = cast_to(ctx, b0, IR_TYPE_I8_T);
     ir_builder_emit_store(b, b0_i8, p0);
-    IRValue* out1 = ir_value_reg(ir_builder_emit_add(b, IR_TYPE_I64_T, out,
-                                                     ir_value_const_int(1, IR_TYPE_I64_T)),
+    IRValue* out1 = ir_value_reg(ctx->builder->arena, ir_builder_emit_add(b, IR_TYPE_I64_T, out,
+                                                     ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T)),
                                  IR_TYPE_I64_T);
     ir_builder_emit_store(b, out1, out_ptr);
 
@@ -749,58 +745,58 @@ static IRValue* ir_lower_baa_string_to_cstr_alloc(IRLowerCtx* ctx, const Node* s
     IRBlock* a3b = cf_create_block(ctx, "نص_إلى_سي_ملء_بعد_b3");
     if (!b1b || !a1b || !b2b || !a2b || !b3b || !a3b) {
         // في حالة فشل إنشاء الكتل، نكمل بشكل محافظ.
-        int fidx2_r = ir_builder_emit_add(b, IR_TYPE_I64_T, fidx, ir_value_const_int(1, IR_TYPE_I64_T));
-        ir_builder_emit_store(b, ir_value_reg(fidx2_r, IR_TYPE_I64_T), fidx_ptr);
+        int fidx2_r = ir_builder_emit_add(b, IR_TYPE_I64_T, fidx, ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T));
+        ir_builder_emit_store(b, ir_value_reg(ctx->builder->arena, fidx2_r, IR_TYPE_I64_T), fidx_ptr);
         ir_builder_emit_br(b, fill_head);
     } else {
-        int c2_r = ir_builder_emit_cmp_ge(b, len2, ir_value_const_int(2, IR_TYPE_I64_T));
-        ir_builder_emit_br_cond(b, ir_value_reg(c2_r, IR_TYPE_I1_T), b1b, a1b);
+        int c2_r = ir_builder_emit_cmp_ge(b, len2, ir_value_const_int(ctx->builder->arena, 2, IR_TYPE_I64_T));
+        ir_builder_emit_br_cond(b, ir_value_reg(ctx->builder->arena, c2_r, IR_TYPE_I1_T), b1b, a1b);
 
         ir_builder_set_insert_point(b, b1b);
         ir_lower_set_loc(b, site);
         int out1r = ir_builder_emit_load(b, IR_TYPE_I64_T, out_ptr);
-        IRValue* out1v = ir_value_reg(out1r, IR_TYPE_I64_T);
+        IRValue* out1v = ir_value_reg(ctx->builder->arena, out1r, IR_TYPE_I64_T);
         int dp1 = ir_builder_emit_ptr_offset(b, i8_ptr_t, buf, out1v);
-        IRValue* p1 = ir_value_reg(dp1, i8_ptr_t);
+        IRValue* p1 = ir_value_reg(ctx->builder->arena, dp1, i8_ptr_t);
         ir_builder_emit_store(b, cast_to(ctx, b1, IR_TYPE_I8_T), p1);
-        IRValue* out2v = ir_value_reg(ir_builder_emit_add(b, IR_TYPE_I64_T, out1v,
-                                                         ir_value_const_int(1, IR_TYPE_I64_T)),
+        IRValue* out2v = ir_value_reg(ctx->builder->arena, ir_builder_emit_add(b, IR_TYPE_I64_T, out1v,
+                                                         ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T)),
                                       IR_TYPE_I64_T);
         ir_builder_emit_store(b, out2v, out_ptr);
         ir_builder_emit_br(b, a1b);
 
         ir_builder_set_insert_point(b, a1b);
         ir_lower_set_loc(b, site);
-        int c3_r = ir_builder_emit_cmp_ge(b, len2, ir_value_const_int(3, IR_TYPE_I64_T));
-        ir_builder_emit_br_cond(b, ir_value_reg(c3_r, IR_TYPE_I1_T), b2b, a2b);
+        int c3_r = ir_builder_emit_cmp_ge(b, len2, ir_value_const_int(ctx->builder->arena, 3, IR_TYPE_I64_T));
+        ir_builder_emit_br_cond(b, ir_value_reg(ctx->builder->arena, c3_r, IR_TYPE_I1_T), b2b, a2b);
 
         ir_builder_set_insert_point(b, b2b);
         ir_lower_set_loc(b, site);
         int out2r = ir_builder_emit_load(b, IR_TYPE_I64_T, out_ptr);
-        IRValue* out2 = ir_value_reg(out2r, IR_TYPE_I64_T);
+        IRValue* out2 = ir_value_reg(ctx->builder->arena, out2r, IR_TYPE_I64_T);
         int dp2 = ir_builder_emit_ptr_offset(b, i8_ptr_t, buf, out2);
-        IRValue* p2 = ir_value_reg(dp2, i8_ptr_t);
+        IRValue* p2 = ir_value_reg(ctx->builder->arena, dp2, i8_ptr_t);
         ir_builder_emit_store(b, cast_to(ctx, b2, IR_TYPE_I8_T), p2);
-        IRValue* out3v = ir_value_reg(ir_builder_emit_add(b, IR_TYPE_I64_T, out2,
-                                                         ir_value_const_int(1, IR_TYPE_I64_T)),
+        IRValue* out3v = ir_value_reg(ctx->builder->arena, ir_builder_emit_add(b, IR_TYPE_I64_T, out2,
+                                                         ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T)),
                                       IR_TYPE_I64_T);
         ir_builder_emit_store(b, out3v, out_ptr);
         ir_builder_emit_br(b, a2b);
 
         ir_builder_set_insert_point(b, a2b);
         ir_lower_set_loc(b, site);
-        int c4_r = ir_builder_emit_cmp_ge(b, len2, ir_value_const_int(4, IR_TYPE_I64_T));
-        ir_builder_emit_br_cond(b, ir_value_reg(c4_r, IR_TYPE_I1_T), b3b, a3b);
+        int c4_r = ir_builder_emit_cmp_ge(b, len2, ir_value_const_int(ctx->builder->arena, 4, IR_TYPE_I64_T));
+        ir_builder_emit_br_cond(b, ir_value_reg(ctx->builder->arena, c4_r, IR_TYPE_I1_T), b3b, a3b);
 
         ir_builder_set_insert_point(b, b3b);
         ir_lower_set_loc(b, site);
         int out3r = ir_builder_emit_load(b, IR_TYPE_I64_T, out_ptr);
-        IRValue* out3 = ir_value_reg(out3r, IR_TYPE_I64_T);
+        IRValue* out3 = ir_value_reg(ctx->builder->arena, out3r, IR_TYPE_I64_T);
         int dp3 = ir_builder_emit_ptr_offset(b, i8_ptr_t, buf, out3);
-        IRValue* p3 = ir_value_reg(dp3, i8_ptr_t);
+        IRValue* p3 = ir_value_reg(ctx->builder->arena, dp3, i8_ptr_t);
         ir_builder_emit_store(b, cast_to(ctx, b3, IR_TYPE_I8_T), p3);
-        IRValue* out4v = ir_value_reg(ir_builder_emit_add(b, IR_TYPE_I64_T, out3,
-                                                         ir_value_const_int(1, IR_TYPE_I64_T)),
+        IRValue* out4v = ir_value_reg(ctx->builder->arena, ir_builder_emit_add(b, IR_TYPE_I64_T, out3,
+                                                         ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T)),
                                       IR_TYPE_I64_T);
         ir_builder_emit_store(b, out4v, out_ptr);
         ir_builder_emit_br(b, a3b);
@@ -808,8 +804,8 @@ static IRValue* ir_lower_baa_string_to_cstr_alloc(IRLowerCtx* ctx, const Node* s
         ir_builder_set_insert_point(b, a3b);
         ir_lower_set_loc(b, site);
         // التالي
-        IRValue* fidx2 = ir_value_reg(ir_builder_emit_add(b, IR_TYPE_I64_T, fidx,
-                                                         ir_value_const_int(1, IR_TYPE_I64_T)),
+        IRValue* fidx2 = ir_value_reg(ctx->builder->arena, ir_builder_emit_add(b, IR_TYPE_I64_T, fidx,
+                                                         ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T)),
                                       IR_TYPE_I64_T);
         ir_builder_emit_store(b, fidx2, fidx_ptr);
         ir_builder_emit_br(b, fill_head);
@@ -819,13 +815,13 @@ static IRValue* ir_lower_baa_string_to_cstr_alloc(IRLowerCtx* ctx, const Node* s
     ir_lower_set_loc(b, site);
     // ضع NULL-terminator
     int dpn = ir_builder_emit_ptr_offset(b, i8_ptr_t, buf, blen3);
-    IRValue* pn = ir_value_reg(dpn, i8_ptr_t);
-    ir_builder_emit_store(b, ir_value_const_int(0, IR_TYPE_I8_T), pn);
+    IRValue* pn = ir_value_reg(ctx->builder->arena, dpn, i8_ptr_t);
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I8_T), pn);
     ir_builder_emit_store(b, buf, res_ptr);
     ir_builder_emit_br(b, final_done);
 
     ir_builder_set_insert_point(b, final_done);
     ir_lower_set_loc(b, site);
     int r = ir_builder_emit_load(b, i8_ptr_t, res_ptr);
-    return ir_value_reg(r, i8_ptr_t);
+    return ir_value_reg(ctx->builder->arena, r, i8_ptr_t);
 }
@@ -166,6 +166,56 @@ static void lower_continue_stmt(IRLowerCtx* ctx) {
     }
 }
 
+/**
+ * @brief قيمة حالة ثابتة كما يخفضها lower_expr، بلا إصدار تعليمات.
+ */
+static int cf_switch_case_const(Node* expr, int64_t* out) {
+    if (!expr || !out) return 0;
+    switch (expr->type) {
+        case NODE_INT:
+            *out = (int64_t)expr->data.integer.value;
+            return 1;
+        case NODE_CHAR:
+            *out = (int64_t)pack_utf8_codepoint((uint32_t)expr->data.char_lit.value);
+            return 1;
+        case NODE_MEMBER_ACCESS:
+            if (!expr->data.member_access.is_enum_value) return 0;
+            *out = (int64_t)expr->data.member_access.enum_value;
+            return 1;
+        case NODE_UNARY_OP:
+            if (expr->data.unary_op.op != UOP_NEG || !expr->data.unary_op.operand ||
+                expr->data.unary_op.operand->type != NODE_INT) {
+                return 0;
+            }
+            *out = (int64_t)(0u - (uint64_t)expr->data.unary_op.operand->data.integer.value);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief هل تمثل قيمةُ الاختيار (بعرض نوعها وإشارته) الثابتَ نفسه؟
+ */
+static int cf_switch_value_fits(IRType* type, int64_t v) {
+    if (!type) return 0;
+    switch (type->kind) {
+        case IR_TYPE_I1:  return v == 0 || v == 1;
+        case IR_TYPE_I8:  return v >= INT8_MIN && v <= INT8_MAX;
+        case IR_TYPE_I16: return v >= INT16_MIN && v <= INT16_MAX;
+        case IR_TYPE_I32: return v >= INT32_MIN && v <= INT32_MAX;
+        case IR_TYPE_U8:  return v >= 0 && v <= UINT8_MAX;
+        case IR_TYPE_U16: return v >= 0 && v <= UINT16_MAX;
+        case IR_TYPE_U32: return v >= 0 && v <= (int64_t)UINT32_MAX;
+        case IR_TYPE_I64:
+        case IR_TYPE_U64:
+        case IR_TYPE_CHAR:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
 static void lower_switch_stmt(IRLowerCtx* ctx, Node* stmt) {
     if (!ctx || !ctx->builder || !stmt) return;
 
@@ -236,8 +286,29 @@ static void lower_switch_stmt(IRLowerCtx* ctx, Node* stmt) {
     int sw_reg = sw_is_reg ? sw_val->data.reg_num : -1;
     int64_t sw_const = (!sw_is_reg && sw_val && sw_val->kind == IR_VAL_CONST_INT) ? sw_val->data.const_int : 0;
 
-    // Dispatch comparisons (chain)
-    if (non_default_count == 0) {
+    // Dispatch: تفرع واحد إن كانت كل القيم ثوابت تمثلها قيمة الاختيار، وإلا سلسلة مقارنات.
+    int64_t* case_values = NULL;
+    int all_const = (non_default_count > 0 && non_default_nodes);
+    if (all_const) {
+        case_values = (int64_t*)malloc(sizeof(int64_t) * (size_t)non_default_count);
+        if (!case_values) all_const = 0;
+    }
+    for (int i = 0; all_const && i < non_default_count; i++) {
+        all_const = cf_switch_case_const(non_default_nodes[i]->data.case_stmt.value, &case_values[i]) &&
+                    cf_switch_value_fits(sw_type, case_values[i]);
+    }
+
+    if (all_const) {
+        IRBlock* fallback = default_bb ? default_bb : end_bb;
+        IRValue* dispatch = sw_is_reg ? ir_value_reg(ctx->builder->arena, sw_reg, sw_type) : ir_value_const_int(ctx->builder->arena, sw_const, sw_type);
+        IRInst* sw = ir_builder_emit_switch(ctx->builder, dispatch, fallback);
+        for (int i = 0; sw && i < non_default_count; i++) {
+            // أول حالة بالقيمة نفسها هي التي تُختار (كما في السلسلة).
+            int dup = 0;
+            for (int j = 0; j < i && !dup; j++) dup = (case_values[j] == case_values[i]);
+            if (!dup) ir_builder_add_switch_case(ctx->builder, sw, case_values[i], non_default_blocks[i]);
+        }
+    } else if (non_default_count == 0) {
         // No explicit cases: jump to default or end.
         if (!ir_builder_is_block_terminated(ctx->builder)) {
             ir_builder_emit_br(ctx->builder, default_bb ? default_bb : end_bb);
@@ -257,10 +328,10 @@ static void lower_switch_stmt(IRLowerCtx* ctx, Node* stmt) {
             }
 
             // Compare sw == case_value
-            IRValue* lhs = sw_is_reg ? ir_value_reg(sw_reg, sw_type) : ir_value_const_int(sw_const, sw_type);
+            IRValue* lhs = sw_is_reg ? ir_value_reg(ctx->builder->arena, sw_reg, sw_type) : ir_value_const_int(ctx->builder->arena, sw_const, sw_type);
             IRValue* rhs = lower_expr(ctx, case_node->data.case_stmt.value);
             int cmp_reg = ir_builder_emit_cmp_eq(ctx->builder, lhs, rhs);
-            IRValue* cmp_val = ir_value_reg(cmp_reg, IR_TYPE_I1_T);
+            IRValue* cmp_val = ir_value_reg(ctx->builder->arena, cmp_reg, IR_TYPE_I1_T);
 
             ir_builder_emit_br_cond(ctx->builder, cmp_val, true_bb, false_bb);
 
@@ -297,6 +368,7 @@ static void lower_switch_stmt(IRLowerCtx* ctx, Node* stmt) {
     if (case_nodes) free(case_nodes);
     if (non_default_blocks) free(non_default_blocks);
     if (non_default_nodes) free(non_default_nodes);
+    if (case_values) free(case_values);
     (void)default_node;
 
     cf_pop(ctx); // pop switch break target
@@ -18,7 +18,7 @@ static void ir_lower_emit_debug_string_index_check(IRLowerCtx* ctx,
 
 IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
     if (!ctx || !ctx->builder || !expr) {
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
     // تعيين موقع المصدر لهذه العقدة قبل توليد أي تعليمات.
@@ -29,7 +29,7 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
         // v0.3.0.3 required nodes
         // -----------------------------------------------------------------
         case NODE_INT:
-            return ir_builder_const_i64((int64_t)expr->data.integer.value);
+            return ir_builder_const_i64(ctx->builder, (int64_t)expr->data.integer.value);
 
         case NODE_VAR_REF: {
             const char* name = expr->data.var_ref.name;
@@ -40,20 +40,20 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                 const char* storage_name = ir_lower_binding_storage_name(b);
                 if (b->value_type && b->value_type->kind == IR_TYPE_ARRAY) {
                     ir_lower_report_error(ctx, expr, "لا يمكن استخدام المصفوفة '%s' بدون فهرس.", name ? name : "???");
-                    return ir_builder_const_i64(0);
+                    return ir_builder_const_i64(ctx->builder, 0);
                 }
                 IRType* value_type = b->value_type ? b->value_type : IR_TYPE_I64_T;
 
                 IRValue* ptr = NULL;
                 if (b->is_static_storage) {
-                    ptr = ir_value_global(storage_name, value_type);
+                    ptr = ir_value_global(ctx->builder->arena, storage_name, value_type);
                 } else {
-                    IRType* ptr_type = ir_type_ptr(value_type ? value_type : IR_TYPE_I64_T);
-                    ptr = ir_value_reg(b->ptr_reg, ptr_type);
+                    IRType* ptr_type = ir_type_ptr(ctx->builder->arena, value_type ? value_type : IR_TYPE_I64_T);
+                    ptr = ir_value_reg(ctx->builder->arena, b->ptr_reg, ptr_type);
                 }
                 int loaded = ir_builder_emit_load(ctx->builder, value_type, ptr);
                 ir_lower_tag_last_inst(ctx->builder, IR_OP_LOAD, loaded, storage_name);
-                return ir_value_reg(loaded, value_type);
+                return ir_value_reg(ctx->builder->arena, loaded, value_type);
             }
 
             // 2) Global variable (module scope)
@@ -63,10 +63,10 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
             }
             if (g) {
                 // Globals are addressable; load from @name
-                IRValue* gptr = ir_value_global(name, g->type);
+                IRValue* gptr = ir_value_global(ctx->builder->arena, name, g->type);
                 int loaded = ir_builder_emit_load(ctx->builder, g->type, gptr);
                 ir_lower_tag_last_inst(ctx->builder, IR_OP_LOAD, loaded, name);
-                return ir_value_reg(loaded, g->type);
+                return ir_value_reg(ctx->builder->arena, loaded, g->type);
             }
 
             // 3) Function reference (as a value)
@@ -86,12 +86,12 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                     pts_local[i] = (f->params && f->params[i].type) ? f->params[i].type : IR_TYPE_I64_T;
                 }
                 if (pc > 0) pts = pts_local;
-                IRType* ft = ir_type_func(f->ret_type ? f->ret_type : IR_TYPE_VOID_T, pts, pc);
-                return ir_value_func_ref(name, ft);
+                IRType* ft = ir_type_func(ctx->builder->arena, f->ret_type ? f->ret_type : IR_TYPE_VOID_T, pts, pc);
+                return ir_value_func_ref(ctx->builder->arena, name, ft);
             }
 
             ir_lower_report_error(ctx, expr, "متغير غير معروف '%s'.", name ? name : "???");
-            return ir_builder_const_i64(0);
+            return ir_builder_const_i64(ctx->builder, 0);
         }
 
         case NODE_ARRAY_ACCESS: {
@@ -111,48 +111,48 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                     Node* idx_node = expr->data.array_op.indices;
                     if (!idx_node) {
                         ir_lower_report_error(ctx, expr, "فهرس النص '%s' مفقود.", name ? name : "???");
-                        return ir_builder_const_i64(0);
+                        return ir_builder_const_i64(ctx->builder, 0);
                     }
 
                     IRType* str_t = b->value_type;
                     IRValue* str_ptr = NULL;
                     if (b->is_static_storage) {
-                        IRValue* gptr = ir_value_global(storage_name, str_t);
+                        IRValue* gptr = ir_value_global(ctx->builder->arena, storage_name, str_t);
                         int loaded = ir_builder_emit_load(ctx->builder, str_t, gptr);
-                        str_ptr = ir_value_reg(loaded, str_t);
+                        str_ptr = ir_value_reg(ctx->builder->arena, loaded, str_t);
                     } else {
-                        IRType* ptr_to_str_t = ir_type_ptr(str_t);
-                        IRValue* slot = ir_value_reg(b->ptr_reg, ptr_to_str_t);
+                        IRType* ptr_to_str_t = ir_type_ptr(ctx->builder->arena, str_t);
+                        IRValue* slot = ir_value_reg(ctx->builder->arena, b->ptr_reg, ptr_to_str_t);
                         int loaded = ir_builder_emit_load(ctx->builder, str_t, slot);
-                        str_ptr = ir_value_reg(loaded, str_t);
+                        str_ptr = ir_value_reg(ctx->builder->arena, loaded, str_t);
                     }
 
                     IRValue* idx = ensure_i64(ctx, lower_expr(ctx, idx_node));
                     ir_lower_emit_debug_string_index_check(ctx, expr, str_ptr, idx);
                     int ep = ir_builder_emit_ptr_offset(ctx->builder, str_t, str_ptr, idx);
-                    IRValue* elem_ptr = ir_value_reg(ep, str_t);
+                    IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, str_t);
                     int ch = ir_builder_emit_load(ctx->builder, IR_TYPE_CHAR_T, elem_ptr);
-                    return ir_value_reg(ch, IR_TYPE_CHAR_T);
+                    return ir_value_reg(ctx->builder->arena, ch, IR_TYPE_CHAR_T);
                 }
 
                 // مؤشرات عامة: p[i] و p[i][j]...
                 if (b->is_pointer) {
                     if (!expr->data.array_op.indices) {
                         ir_lower_report_error(ctx, expr, "فهرس المؤشر '%s' مفقود.", name ? name : "???");
-                        return ir_builder_const_i64(0);
+                        return ir_builder_const_i64(ctx->builder, 0);
                     }
 
                     IRType* ptr_t = b->value_type;
                     IRValue* ptr_val = NULL;
                     if (b->is_static_storage) {
-                        IRValue* gptr = ir_value_global(storage_name, ptr_t);
+                        IRValue* gptr = ir_value_global(ctx->builder->arena, storage_name, ptr_t);
                         int loaded = ir_builder_emit_load(ctx->builder, ptr_t, gptr);
-                        ptr_val = ir_value_reg(loaded, ptr_t);
+                        ptr_val = ir_value_reg(ctx->builder->arena, loaded, ptr_t);
                     } else {
-                        IRType* slot_t = ir_type_ptr(ptr_t);
-                        IRValue* slot = ir_value_reg(b->ptr_reg, slot_t);
+                        IRType* slot_t = ir_type_ptr(ctx->builder->arena, ptr_t);
+                        IRValue* slot = ir_value_reg(ctx->builder->arena, b->ptr_reg, slot_t);
                         int loaded = ir_builder_emit_load(ctx->builder, ptr_t, slot);
-                        ptr_val = ir_value_reg(loaded, ptr_t);
+                        ptr_val = ir_value_reg(ctx->builder->arena, loaded, ptr_t);
                     }
 
                     return ir_lower_pointer_index_chain(ctx, expr, ptr_val,
@@ -166,14 +166,14 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                     for (Node* idx = expr->data.array_op.indices; idx; idx = idx->next) {
                         (void)lower_expr(ctx, idx);
                     }
-                    return ir_builder_const_i64(0);
+                    return ir_builder_const_i64(ctx->builder, 0);
                 }
 
                 bool elem_is_agg = (b->array_elem_type == TYPE_STRUCT || b->array_elem_type == TYPE_UNION);
                 IRType* elem_t = elem_is_agg
                     ? IR_TYPE_I8_T
                     : (b->value_type->data.array.element ? b->value_type->data.array.element : IR_TYPE_I64_T);
-                IRType* elem_ptr_t = ir_type_ptr(elem_t);
+                IRType* elem_ptr_t = ir_type_ptr(ctx->builder->arena, elem_t);
                 bool elem_is_string = (!elem_is_agg &&
                                        elem_t && elem_t->kind == IR_TYPE_PTR &&
                                        elem_t->data.pointee &&
@@ -181,11 +181,11 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
 
                 IRValue* base_ptr = NULL;
                 if (b->is_static_storage) {
-                    base_ptr = ir_value_global(storage_name, elem_t);
+                    base_ptr = ir_value_global(ctx->builder->arena, storage_name, elem_t);
                 } else {
-                    IRValue* arr_ptr = ir_value_reg(b->ptr_reg, ir_type_ptr(b->value_type));
+                    IRValue* arr_ptr = ir_value_reg(ctx->builder->arena, b->ptr_reg, ir_type_ptr(ctx->builder->arena, b->value_type));
                     int base_reg = ir_builder_emit_cast(ctx->builder, arr_ptr, elem_ptr_t);
-                    base_ptr = ir_value_reg(base_reg, elem_ptr_t);
+                    base_ptr = ir_value_reg(ctx->builder->arena, base_reg, elem_ptr_t);
                 }
 
                 if (!base_ptr) {
@@ -193,7 +193,7 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                     for (Node* idx = expr->data.array_op.indices; idx; idx = idx->next) {
                         (void)lower_expr(ctx, idx);
                     }
-                    return ir_builder_const_i64(0);
+                    return ir_builder_const_i64(ctx->builder, 0);
                 }
 
                 if (elem_is_string && b->array_rank > 0 && index_count == b->array_rank + 1) {
@@ -203,17 +203,17 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                                                                         b->array_dims,
                                                                         b->array_rank);
                     int ep_outer = ir_builder_emit_ptr_offset(ctx->builder, elem_ptr_t, base_ptr, outer_linear);
-                    IRValue* outer_ptr = ir_value_reg(ep_outer, elem_ptr_t);
+                    IRValue* outer_ptr = ir_value_reg(ctx->builder->arena, ep_outer, elem_ptr_t);
                     int ld_str = ir_builder_emit_load(ctx->builder, elem_t, outer_ptr);
-                    IRValue* str_ptr = ir_value_reg(ld_str, elem_t);
+                    IRValue* str_ptr = ir_value_reg(ctx->builder->arena, ld_str, elem_t);
 
                     Node* inner_node = ir_lower_nth_index(expr->data.array_op.indices, b->array_rank);
                     IRValue* inner_idx = ensure_i64(ctx, lower_expr(ctx, inner_node));
                     ir_lower_emit_debug_string_index_check(ctx, expr, str_ptr, inner_idx);
                     int ep_inner = ir_builder_emit_ptr_offset(ctx->builder, elem_t, str_ptr, inner_idx);
-                    IRValue* ch_ptr = ir_value_reg(ep_inner, elem_t);
+                    IRValue* ch_ptr = ir_value_reg(ctx->builder->arena, ep_inner, elem_t);
                     int ch = ir_builder_emit_load(ctx->builder, IR_TYPE_CHAR_T, ch_ptr);
-                    return ir_value_reg(ch, IR_TYPE_CHAR_T);
+                    return ir_value_reg(ctx->builder->arena, ch, IR_TYPE_CHAR_T);
                 }
 
                 IRValue* linear = ir_lower_build_linear_index(ctx, expr,
@@ -222,16 +222,16 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                                                               b->array_dims,
                                                               b->array_rank);
                 int ep = ir_builder_emit_ptr_offset(ctx->builder, elem_ptr_t, base_ptr, linear);
-                IRValue* elem_ptr = ir_value_reg(ep, elem_ptr_t);
+                IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, elem_ptr_t);
 
                 if (elem_is_agg) {
                     ir_lower_report_error(ctx, expr, "استخدام عنصر مصفوفة مركبة كقيمة غير مدعوم.");
-                    return ir_builder_const_i64(0);
+                    return ir_builder_const_i64(ctx->builder, 0);
                 }
 
                 int loaded = ir_builder_emit_load(ctx->builder, elem_t, elem_ptr);
                 ir_lower_tag_last_inst(ctx->builder, IR_OP_LOAD, loaded, name);
-                return ir_value_reg(loaded, elem_t);
+                return ir_value_reg(ctx->builder->arena, loaded, elem_t);
             }
 
             IRGlobal* g = NULL;
@@ -243,16 +243,16 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                 for (Node* idx = expr->data.array_op.indices; idx; idx = idx->next) {
                     (void)lower_expr(ctx, idx);
                 }
-                return ir_builder_const_i64(0);
+                return ir_builder_const_i64(ctx->builder, 0);
             }
 
             Node* vdecl = ir_lower_find_global_var_decl(ctx, name);
             if (vdecl && vdecl->type == NODE_VAR_DECL &&
                 vdecl->data.var_decl.type == TYPE_POINTER &&
                 g && g->type) {
-                IRValue* gptr = ir_value_global(name, g->type);
+                IRValue* gptr = ir_value_global(ctx->builder->arena, name, g->type);
                 int loaded = ir_builder_emit_load(ctx->builder, g->type, gptr);
-                IRValue* p = ir_value_reg(loaded, g->type);
+                IRValue* p = ir_value_reg(ctx->builder->arena, loaded, g->type);
                 return ir_lower_pointer_index_chain(ctx, expr, p,
                                                     vdecl->data.var_decl.ptr_base_type,
                                                     vdecl->data.var_decl.ptr_base_type_name,
@@ -268,19 +268,19 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                 Node* idx_node = expr->data.array_op.indices;
                 if (!idx_node) {
                     ir_lower_report_error(ctx, expr, "فهرس النص '%s' مفقود.", name ? name : "???");
-                    return ir_builder_const_i64(0);
+                    return ir_builder_const_i64(ctx->builder, 0);
                 }
 
-                IRValue* gptr = ir_value_global(name, g->type);
+                IRValue* gptr = ir_value_global(ctx->builder->arena, name, g->type);
                 int loaded = ir_builder_emit_load(ctx->builder, g->type, gptr);
-                IRValue* str_ptr = ir_value_reg(loaded, g->type);
+                IRValue* str_ptr = ir_value_reg(ctx->builder->arena, loaded, g->type);
 
                 IRValue* idx = ensure_i64(ctx, lower_expr(ctx, idx_node));
                 ir_lower_emit_debug_string_index_check(ctx, expr, str_ptr, idx);
                 int ep = ir_builder_emit_ptr_offset(ctx->builder, g->type, str_ptr, idx);
-                IRValue* elem_ptr = ir_value_reg(ep, g->type);
+                IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, g->type);
                 int ch = ir_builder_emit_load(ctx->builder, IR_TYPE_CHAR_T, elem_ptr);
-                return ir_value_reg(ch, IR_TYPE_CHAR_T);
+                return ir_value_reg(ctx->builder->arena, ch, IR_TYPE_CHAR_T);
             }
 
             if (g->type->kind != IR_TYPE_ARRAY) {
@@ -288,7 +288,7 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                 for (Node* idx = expr->data.array_op.indices; idx; idx = idx->next) {
                     (void)lower_expr(ctx, idx);
                 }
-                return ir_builder_const_i64(0);
+                return ir_builder_const_i64(ctx->builder, 0);
             }
 
             Node* gdecl = ir_lower_find_global_array_decl(ctx, name);
@@ -305,12 +305,12 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
             IRType* elem_t = elem_is_agg
                 ? IR_TYPE_I8_T
                 : (g->type->data.array.element ? g->type->data.array.element : IR_TYPE_I64_T);
-            IRType* elem_ptr_t = ir_type_ptr(elem_t);
+            IRType* elem_ptr_t = ir_type_ptr(ctx->builder->arena, elem_t);
             bool elem_is_string = (!elem_is_agg &&
                                    elem_t && elem_t->kind == IR_TYPE_PTR &&
                                    elem_t->data.pointee &&
                                    elem_t->data.pointee->kind == IR_TYPE_CHAR);
-            IRValue* base_ptr = ir_value_global(name, elem_t);
+            IRValue* base_ptr = ir_value_global(ctx->builder->arena, name, elem_t);
 
             if (elem_is_string && rank > 0 && index_count == rank + 1) {
                 IRValue* outer_linear = ir_lower_build_linear_index(ctx, expr,
@@ -319,17 +319,17 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                                                                     dims,
                                                                     rank);
                 int ep_outer = ir_builder_emit_ptr_offset(ctx->builder, elem_ptr_t, base_ptr, outer_linear);
-                IRValue* outer_ptr = ir_value_reg(ep_outer, elem_ptr_t);
+                IRValue* outer_ptr = ir_value_reg(ctx->builder->arena, ep_outer, elem_ptr_t);
                 int ld_str = ir_builder_emit_load(ctx->builder, elem_t, outer_ptr);
-                IRValue* str_ptr = ir_value_reg(ld_str, elem_t);
+                IRValue* str_ptr = ir_value_reg(ctx->builder->arena, ld_str, elem_t);
 
                 Node* inner_node = ir_lower_nth_index(expr->data.array_op.indices, rank);
                 IRValue* inner_idx = ensure_i64(ctx, lower_expr(ctx, inner_node));
                 ir_lower_emit_debug_string_index_check(ctx, expr, str_ptr, inner_idx);
                 int ep_inner = ir_builder_emit_ptr_offset(ctx->builder, elem_t, str_ptr, inner_idx);
-                IRValue* ch_ptr = ir_value_reg(ep_inner, elem_t);
+                IRValue* ch_ptr = ir_value_reg(ctx->builder->arena, ep_inner, elem_t);
                 int ch = ir_builder_emit_load(ctx->builder, IR_TYPE_CHAR_T, ch_ptr);
-                return ir_value_reg(ch, IR_TYPE_CHAR_T);
+                return ir_value_reg(ctx->builder->arena, ch, IR_TYPE_CHAR_T);
             }
 
             IRValue* linear = ir_lower_build_linear_index(ctx, expr,
@@ -338,16 +338,16 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                                                           dims,
                                                           rank);
             int ep = ir_builder_emit_ptr_offset(ctx->builder, elem_ptr_t, base_ptr, linear);
-            IRValue* elem_ptr = ir_value_reg(ep, elem_ptr_t);
+            IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, elem_ptr_t);
 
             if (elem_is_agg) {
                 ir_lower_report_error(ctx, expr, "استخدام عنصر مصفوفة مركبة كقيمة غير مدعوم.");
-                return ir_builder_const_i64(0);
+                return ir_builder_const_i64(ctx->builder, 0);
             }
 
             int loaded = ir_builder_emit_load(ctx->builder, elem_t, elem_ptr);
             ir_lower_tag_last_inst(ctx->builder, IR_OP_LOAD, loaded, name);
-            return ir_value_reg(loaded, elem_t);
+            return ir_value_reg(ctx->builder->arena, loaded, elem_t);
         }
 
         case NODE_BIN_OP: {
@@ -364,7 +364,7 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                     IRValue* delta_v = left_ptr ? rhs0 : lhs0;
                     IRType* ptr_t = (base_ptr && base_ptr->type && base_ptr->type->kind == IR_TYPE_PTR)
                         ? base_ptr->type
-                        : ir_type_ptr(IR_TYPE_I8_T);
+                        : ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
                     base_ptr = cast_to(ctx, base_ptr, ptr_t);
                     IRValue* delta = ensure_i64(ctx, delta_v);
 
@@ -372,16 +372,16 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                     int64_t elem_size = ir_lower_pointer_elem_size(pnode);
                     if (elem_size > 1) {
                         int mr = ir_builder_emit_mul(ctx->builder, IR_TYPE_I64_T, delta,
-                                                     ir_value_const_int(elem_size, IR_TYPE_I64_T));
-                        delta = ir_value_reg(mr, IR_TYPE_I64_T);
+                                                     ir_value_const_int(ctx->builder->arena, elem_size, IR_TYPE_I64_T));
+                        delta = ir_value_reg(ctx->builder->arena, mr, IR_TYPE_I64_T);
                     }
 
                     if (op == OP_SUB) {
                         int nr = ir_builder_emit_neg(ctx->builder, IR_TYPE_I64_T, delta);
-                        delta = ir_value_reg(nr, IR_TYPE_I64_T);
+                        delta = ir_value_reg(ctx->builder->arena, nr, IR_TYPE_I64_T);
                     }
                     int pr = ir_builder_emit_ptr_offset(ctx->builder, ptr_t, base_ptr, delta);
-                    return ir_value_reg(pr, ptr_t);
+                    return ir_value_reg(ctx->builder->arena, pr, ptr_t);
                 }
 
                 if (op == OP_SUB &&
@@ -395,14 +395,14 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                     IRValue* rhs = cast_to(ctx, rhs0, IR_TYPE_I64_T);
 
                     int dr = ir_builder_emit_sub(ctx->builder, IR_TYPE_I64_T, lhs, rhs);
-                    IRValue* diff_bytes = ir_value_reg(dr, IR_TYPE_I64_T);
+                    IRValue* diff_bytes = ir_value_reg(ctx->builder->arena, dr, IR_TYPE_I64_T);
 
                     int64_t elem_size = ir_lower_pointer_elem_size(expr->data.bin_op.left);
                     if (elem_size > 1) {
                         int qr = ir_builder_emit_div(ctx->builder, IR_TYPE_I64_T,
                                                      diff_bytes,
-                                                     ir_value_const_int(elem_size, IR_TYPE_I64_T));
-                        return ir_value_reg(qr, IR_TYPE_I64_T);
+                                                     ir_value_const_int(ctx->builder->arena, elem_size, IR_TYPE_I64_T));
+                        return ir_value_reg(ctx->builder->arena, qr, IR_TYPE_I64_T);
                     }
 
                     return diff_bytes;
@@ -425,13 +425,13 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                         case IR_OP_DIV: dest = ir_builder_emit_div(ctx->builder, type, lhs, rhs); break;
                         case IR_OP_MOD:
                             ir_lower_report_error(ctx, expr, "عملية باقي غير مدعومة على 'عشري'.");
-                            return ir_value_const_int(0, IR_TYPE_F64_T);
+                            return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_F64_T);
                         default:
                             ir_lower_report_error(ctx, expr, "عملية حسابية غير مدعومة.");
-                            return ir_value_const_int(0, IR_TYPE_F64_T);
+                            return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_F64_T);
                     }
 
-                    return ir_value_reg(dest, type);
+                    return ir_value_reg(ctx->builder->arena, dest, type);
                 }
 
                 IRValue* lhs0 = lower_expr(ctx, expr->data.bin_op.left);
@@ -457,10 +457,10 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                     case IR_OP_MOD: dest = ir_builder_emit_mod(ctx->builder, type, lhs, rhs); break;
                     default:
                         ir_lower_report_error(ctx, expr, "عملية حسابية غير مدعومة.");
-                        return ir_builder_const_i64(0);
+                        return ir_builder_const_i64(ctx->builder, 0);
                 }
 
-                return ir_value_reg(dest, type);
+                return ir_value_reg(ctx->builder->arena, dest, type);
             }
 
             // Bitwise / Shift
@@ -509,10 +509,10 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                         break;
                     default:
                         ir_lower_report_error(ctx, expr, "عملية بتية غير مدعومة.");
-                        return ir_builder_const_i64(0);
+                        return ir_builder_const_i64(ctx->builder, 0);
                 }
 
-                return ir_value_reg(dest, type);
+                return ir_value_reg(ctx->builder->arena, dest, type);
             }
 
             // Comparison
@@ -523,12 +523,12 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                     IRValue* lhs0 = lower_expr(ctx, expr->data.bin_op.left);
                     IRValue* rhs0 = lower_expr(ctx, expr->data.bin_op.right);
                     IRType* st = get_char_ptr_type(ctx->builder ? ctx->builder->module : NULL);
-                    if (!st) st = ir_type_ptr(IR_TYPE_CHAR_T);
+                    if (!st) st = ir_type_ptr(ctx->builder->arena, IR_TYPE_CHAR_T);
                     IRValue* lhs = cast_to(ctx, lhs0, st);
                     IRValue* rhs = cast_to(ctx, rhs0, st);
                     IRCmpPred pred = ir_cmp_to_pred(op, false);
                     int dest = ir_builder_emit_cmp(ctx->builder, pred, lhs, rhs);
-                    return ir_value_reg(dest, IR_TYPE_I1_T);
+                    return ir_value_reg(ctx->builder->arena, dest, IR_TYPE_I1_T);
                 }
 
                 if (expr->data.bin_op.left && expr->data.bin_op.right &&
@@ -537,12 +537,12 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                     IRValue* rhs0 = lower_expr(ctx, expr->data.bin_op.right);
                     IRType* ptr_t = (lhs0 && lhs0->type && lhs0->type->kind == IR_TYPE_PTR)
                         ? lhs0->type
-                        : ((rhs0 && rhs0->type && rhs0->type->kind == IR_TYPE_PTR) ? rhs0->type : ir_type_ptr(IR_TYPE_I8_T));
+                        : ((rhs0 && rhs0->type && rhs0->type->kind == IR_TYPE_PTR) ? rhs0->type : ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T));
                     IRValue* lhs = cast_to(ctx, lhs0, ptr_t);
                     IRValue* rhs = cast_to(ctx, rhs0, ptr_t);
                     IRCmpPred pred = ir_cmp_to_pred(op, false);
                     int dest = ir_builder_emit_cmp(ctx->builder, pred, lhs, rhs);
-                    return ir_value_reg(dest, IR_TYPE_I1_T);
+                    return ir_value_reg(ctx->builder->arena, dest, IR_TYPE_I1_T);
                 }
 
                 if (expr->data.bin_op.left && expr->data.bin_op.right &&
@@ -555,18 +555,18 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                     if (lhs0 && rhs0 && lhs0->type && rhs0->type) {
                         if (lhs0->type->kind == IR_TYPE_FUNC && !ir_types_equal(lhs0->type, rhs0->type)) {
                             if (rhs0->kind == IR_VAL_CONST_INT && rhs0->data.const_int == 0) {
-                                rhs0 = ir_value_const_int(0, lhs0->type);
+                                rhs0 = ir_value_const_int(ctx->builder->arena, 0, lhs0->type);
                             }
                         } else if (rhs0->type->kind == IR_TYPE_FUNC && !ir_types_equal(lhs0->type, rhs0->type)) {
                             if (lhs0->kind == IR_VAL_CONST_INT && lhs0->data.const_int == 0) {
-                                lhs0 = ir_value_const_int(0, rhs0->type);
+                                lhs0 = ir_value_const_int(ctx->builder->arena, 0, rhs0->type);
                             }
                         }
                     }
 
                     IRCmpPred pred = ir_cmp_to_pred(op, false);
                     int dest = ir_builder_emit_cmp(ctx->builder, pred, lhs0, rhs0);
-                    return ir_value_reg(dest, IR_TYPE_I1_T);
+                    return ir_value_reg(ctx->builder->arena, dest, IR_TYPE_I1_T);
                 }
 
                 IRValue* lhs0 = lower_expr(ctx, expr->data.bin_op.left);
@@ -603,7 +603,7 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
 
                 IRCmpPred pred = ir_cmp_to_pred(op, is_unsigned);
                 int dest = ir_builder_emit_cmp(ctx->builder, pred, lhs, rhs);
-                return ir_value_reg(dest, IR_TYPE_I1_T);
+                return ir_value_reg(ctx->builder->arena, dest, IR_TYPE_I1_T);
             }
 
             // Logical AND/OR (non-short-circuit form for now; proper short-circuit will be handled
@@ -616,11 +616,11 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                 if (op == OP_AND) dest = ir_builder_emit_and(ctx->builder, IR_TYPE_I1_T, lhs, rhs);
                 else dest = ir_builder_emit_or(ctx->builder, IR_TYPE_I1_T, lhs, rhs);
 
-                return ir_value_reg(dest, IR_TYPE_I1_T);
+                return ir_value_reg(ctx->builder->arena, dest, IR_TYPE_I1_T);
             }
 
             ir_lower_report_error(ctx, expr, "عملية ثنائية غير مدعومة.");
-            return ir_builder_const_i64(0);
+            return ir_builder_const_i64(ctx->builder, 0);
         }
 
         case NODE_UNARY_OP: {
@@ -629,7 +629,7 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
             if (op == UOP_ADDR) {
                 IRType* pointee = IR_TYPE_I64_T;
                 IRValue* addr = lower_lvalue_address(ctx, expr->data.unary_op.operand, &pointee);
-                IRType* ptr_t = ir_type_ptr(pointee ? pointee : IR_TYPE_I64_T);
+                IRType* ptr_t = ir_type_ptr(ctx->builder->arena, pointee ? pointee : IR_TYPE_I64_T);
                 if (!addr->type || !ir_types_equal(addr->type, ptr_t)) {
                     addr = cast_to(ctx, addr, ptr_t);
                 }
@@ -642,11 +642,11 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                 if (!target_t || target_t->kind == IR_TYPE_VOID) {
                     target_t = IR_TYPE_I64_T;
                 }
-                IRType* ptr_t = ir_type_ptr(target_t);
+                IRType* ptr_t = ir_type_ptr(ctx->builder->arena, target_t);
                 IRValue* p = cast_to(ctx, p0, ptr_t);
                 ir_lower_emit_debug_null_check(ctx, expr, p);
                 int lr = ir_builder_emit_load(ctx->builder, target_t, p);
-                return ir_value_reg(lr, target_t);
+                return ir_value_reg(ctx->builder->arena, lr, target_t);
             }
 
             if (op == UOP_NEG) {
@@ -655,22 +655,22 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                 if (dt == TYPE_FLOAT) {
                     IRValue* operand = cast_to(ctx, operand0, IR_TYPE_F64_T);
                     int dest = ir_builder_emit_neg(ctx->builder, IR_TYPE_F64_T, operand);
-                    return ir_value_reg(dest, IR_TYPE_F64_T);
+                    return ir_value_reg(ctx->builder->arena, dest, IR_TYPE_F64_T);
                 }
 
                 IRType* t = ir_type_from_datatype(ctx->builder ? ctx->builder->module : NULL, dt);
                 if (!t) t = IR_TYPE_I64_T;
                 IRValue* operand = cast_to(ctx, operand0, t);
                 int dest = ir_builder_emit_neg(ctx->builder, t, operand);
-                return ir_value_reg(dest, t);
+                return ir_value_reg(ctx->builder->arena, dest, t);
             }
 
             if (op == UOP_NOT) {
                 // نفي منطقي: !(x) == (x == 0)
                 IRValue* operand = lower_to_bool(ctx, lower_expr(ctx, expr->data.unary_op.operand));
-                IRValue* zero = ir_value_const_int(0, IR_TYPE_I1_T);
+                IRValue* zero = ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I1_T);
                 int dest = ir_builder_emit_cmp_eq(ctx->builder, operand, zero);
-                return ir_value_reg(dest, IR_TYPE_I1_T);
+                return ir_value_reg(ctx->builder->arena, dest, IR_TYPE_I1_T);
             }
 
             if (op == UOP_BIT_NOT) {
@@ -682,44 +682,44 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
                 }
                 IRValue* operand = cast_to(ctx, operand0, t);
                 int dest = ir_builder_emit_not(ctx->builder, t, operand);
-                return ir_value_reg(dest, t);
+                return ir_value_reg(ctx->builder->arena, dest, t);
             }
 
             // ++ / -- in expression form will be addressed later (statement lowering / lvalues).
             ir_lower_report_error(ctx, expr, "عملية أحادية غير مدعومة (%d).", (int)op);
-            return ir_builder_const_i64(0);
+            return ir_builder_const_i64(ctx->builder, 0);
         }
 
         case NODE_POSTFIX_OP: {
             UnaryOpType op = expr->data.unary_op.op;
             if (op != UOP_INC && op != UOP_DEC) {
                 ir_lower_report_error(ctx, expr, "عملية لاحقة غير مدعومة (%d).", (int)op);
-                return ir_builder_const_i64(0);
+                return ir_builder_const_i64(ctx->builder, 0);
             }
 
             IRType* pointee = IR_TYPE_I64_T;
             IRValue* addr0 = lower_lvalue_address(ctx, expr->data.unary_op.operand, &pointee);
             if (!pointee || pointee->kind == IR_TYPE_VOID) {
                 ir_lower_report_error(ctx, expr, "نوع العملية اللاحقة غير صالح.");
-                return ir_builder_const_i64(0);
+                return ir_builder_const_i64(ctx->builder, 0);
             }
             if (pointee->kind == IR_TYPE_F64) {
                 ir_lower_report_error(ctx, expr, "الزيادة/النقصان للعشري غير مدعومة حالياً.");
-                return ir_builder_const_i64(0);
+                return ir_builder_const_i64(ctx->builder, 0);
             }
 
-            IRType* ptr_t = ir_type_ptr(pointee);
+            IRType* ptr_t = ir_type_ptr(ctx->builder->arena, pointee);
             IRValue* addr = cast_to(ctx, addr0, ptr_t);
 
             int old_r = ir_builder_emit_load(ctx->builder, pointee, addr);
-            IRValue* old_v = ir_value_reg(old_r, pointee);
-            IRValue* one = ir_value_const_int(1, pointee);
+            IRValue* old_v = ir_value_reg(ctx->builder->arena, old_r, pointee);
+            IRValue* one = ir_value_const_int(ctx->builder->arena, 1, pointee);
 
             int new_r = -1;
             if (op == UOP_INC) new_r = ir_builder_emit_add(ctx->builder, pointee, old_v, one);
             else new_r = ir_builder_emit_sub(ctx->builder, pointee, old_v, one);
 
-            IRValue* new_v = ir_value_reg(new_r, pointee);
+            IRValue* new_v = ir_value_reg(ctx->builder->arena, new_r, pointee);
             ir_builder_emit_store(ctx->builder, new_v, addr);
             return old_v;
         }
@@ -731,27 +731,27 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
         // Extra nodes (not in v0.3.0.3 checklist, but useful for robustness)
         // -----------------------------------------------------------------
         case NODE_BOOL:
-            return ir_value_const_int(expr->data.bool_lit.value ? 1 : 0, IR_TYPE_I1_T);
+            return ir_value_const_int(ctx->builder->arena, expr->data.bool_lit.value ? 1 : 0, IR_TYPE_I1_T);
 
         case NODE_NULL:
             if (expr->inferred_type == TYPE_FUNC_PTR) {
                 IRType* ft = ir_type_from_funcsig(ctx->builder ? ctx->builder->module : NULL,
                                                   expr->inferred_func_sig);
-                return ir_value_const_int(0, ft ? ft : ir_type_func(IR_TYPE_VOID_T, NULL, 0));
+                return ir_value_const_int(ctx->builder->arena, 0, ft ? ft : ir_type_func(ctx->builder->arena, IR_TYPE_VOID_T, NULL, 0));
             }
             if (expr->inferred_type == TYPE_STRING) {
                 IRType* char_ptr_t = get_char_ptr_type(ctx->builder ? ctx->builder->module : NULL);
-                return ir_value_const_int(0, char_ptr_t ? char_ptr_t : ir_type_ptr(IR_TYPE_CHAR_T));
+                return ir_value_const_int(ctx->builder->arena, 0, char_ptr_t ? char_ptr_t : ir_type_ptr(ctx->builder->arena, IR_TYPE_CHAR_T));
             }
-            return ir_value_const_int(0, ir_type_ptr(IR_TYPE_I8_T));
+            return ir_value_const_int(ctx->builder->arena, 0, ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T));
 
         case NODE_FLOAT:
-            return ir_value_const_int((int64_t)expr->data.float_lit.bits, IR_TYPE_F64_T);
+            return ir_value_const_int(ctx->builder->arena, (int64_t)expr->data.float_lit.bits, IR_TYPE_F64_T);
 
         case NODE_CHAR:
         {
             uint64_t packed = pack_utf8_codepoint((uint32_t)expr->data.char_lit.value);
-            return ir_value_const_int((int64_t)packed, IR_TYPE_CHAR_T);
+            return ir_value_const_int(ctx->builder->arena, (int64_t)packed, IR_TYPE_CHAR_T);
         }
 
         case NODE_STRING:
@@ -760,9 +760,9 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
         case NODE_SIZEOF:
             if (!expr->data.sizeof_expr.size_known) {
                 ir_lower_report_error(ctx, expr, "فشل حساب 'حجم' أثناء التحليل الدلالي.");
-                return ir_value_const_int(0, IR_TYPE_I64_T);
+                return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
             }
-            return ir_value_const_int(expr->data.sizeof_expr.size_bytes, IR_TYPE_I64_T);
+            return ir_value_const_int(ctx->builder->arena, expr->data.sizeof_expr.size_bytes, IR_TYPE_I64_T);
 
         case NODE_CAST: {
             IRValue* src = lower_expr(ctx, expr->data.cast_expr.expression);
@@ -775,60 +775,59 @@ IRValue* lower_expr(IRLowerCtx* ctx, Node* expr) {
         case NODE_MEMBER_ACCESS: {
             // ملاحظة: التحليل الدلالي يملأ معلومات الوصول (root/offset/type).
             if (expr->data.member_access.is_enum_value) {
-                return ir_value_const_int(expr->data.member_access.enum_value, IR_TYPE_I64_T);
+                return ir_value_const_int(ctx->builder->arena, expr->data.member_access.enum_value, IR_TYPE_I64_T);
             }
 
             if (!expr->data.member_access.is_struct_member || !expr->data.member_access.root_var) {
                 ir_lower_report_error(ctx, expr, "وصول عضو غير صالح في مسار IR.");
-                return ir_builder_const_i64(0);
+                return ir_builder_const_i64(ctx->builder, 0);
             }
 
             if (expr->data.member_access.member_type == TYPE_STRUCT ||
                 expr->data.member_access.member_type == TYPE_UNION) {
                 ir_lower_report_error(ctx, expr, "قراءة عضو هيكل من نوع هيكل كقيمة غير مدعومة.");
-                return ir_builder_const_i64(0);
+                return ir_builder_const_i64(ctx->builder, 0);
             }
 
             IRModule* m = ctx->builder->module;
-            if (m) ir_module_set_current(m);
 
-            IRType* ptr_i8_t = ir_type_ptr(IR_TYPE_I8_T);
+            IRType* ptr_i8_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
             IRValue* base_ptr = NULL;
 
             if (expr->data.member_access.root_is_global) {
-                base_ptr = ir_value_global(expr->data.member_access.root_var, IR_TYPE_I8_T);
+                base_ptr = ir_value_global(ctx->builder->arena, expr->data.member_access.root_var, IR_TYPE_I8_T);
             } else {
                 IRLowerBinding* b = find_local(ctx, expr->data.member_access.root_var);
                 if (!b || !b->value_type) {
                     ir_lower_report_error(ctx, expr, "هيكل محلي غير معروف '%s'.",
                                           expr->data.member_access.root_var);
-                    return ir_builder_const_i64(0);
+                    return ir_builder_const_i64(ctx->builder, 0);
                 }
                 if (b->is_static_storage) {
-                    base_ptr = ir_value_global(ir_lower_binding_storage_name(b), IR_TYPE_I8_T);
+                    base_ptr = ir_value_global(ctx->builder->arena, ir_lower_binding_storage_name(b), IR_TYPE_I8_T);
                 } else {
-                    IRValue* arr_ptr = ir_value_reg(b->ptr_reg, ir_type_ptr(b->value_type));
+                    IRValue* arr_ptr = ir_value_reg(ctx->builder->arena, b->ptr_reg, ir_type_ptr(ctx->builder->arena, b->value_type));
                     int c = ir_builder_emit_cast(ctx->builder, arr_ptr, ptr_i8_t);
-                    base_ptr = ir_value_reg(c, ptr_i8_t);
+                    base_ptr = ir_value_reg(ctx->builder->arena, c, ptr_i8_t);
                 }
             }
 
-            IRValue* idx = ir_value_const_int((int64_t)expr->data.member_access.member_offset, IR_TYPE_I64_T);
+            IRValue* idx = ir_value_const_int(ctx->builder->arena, (int64_t)expr->data.member_access.member_offset, IR_TYPE_I64_T);
             int ep = ir_builder_emit_ptr_offset(ctx->builder, ptr_i8_t, base_ptr, idx);
-            IRValue* byte_ptr = ir_value_reg(ep, ptr_i8_t);
+            IRValue* byte_ptr = ir_value_reg(ctx->builder->arena, ep, ptr_i8_t);
 
             IRType* field_val_t = ir_type_from_datatype(m, expr->data.member_access.member_type);
             if (!field_val_t || field_val_t->kind == IR_TYPE_VOID) field_val_t = IR_TYPE_I64_T;
 
-            IRType* field_ptr_t = ir_type_ptr(field_val_t);
+            IRType* field_ptr_t = ir_type_ptr(ctx->builder->arena, field_val_t);
             int fp = ir_builder_emit_cast(ctx->builder, byte_ptr, field_ptr_t);
-            IRValue* field_ptr = ir_value_reg(fp, field_ptr_t);
+            IRValue* field_ptr = ir_value_reg(ctx->builder->arena, fp, field_ptr_t);
             int r = ir_builder_emit_load(ctx->builder, field_val_t, field_ptr);
-            return ir_value_reg(r, field_val_t);
+            return ir_value_reg(ctx->builder->arena, r, field_val_t);
         }
 
         default:
             ir_lower_report_error(ctx, expr, "عقدة تعبير غير مدعومة (%d).", (int)expr->type);
-            return ir_builder_const_i64(0);
+            return ir_builder_const_i64(ctx->builder, 0);
     }
 }
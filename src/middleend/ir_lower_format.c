@@ -231,61 +231,59 @@ oom:
 
 static IRValue* ir_lower_char_to_cstr_tmp(IRLowerCtx* ctx, const Node* site, IRValue* ch)
 {
-    if (!ctx || !ctx->builder || !ch) return ir_value_const_int(0, ir_type_ptr(IR_TYPE_I8_T));
+    if (!ctx || !ctx->builder || !ch) return ir_value_const_int(ctx->builder->arena, 0, ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T));
 
     IRBuilder* b = ctx->builder;
-    IRModule* m = b->module;
-    if (m) ir_module_set_current(m);
 
-    IRType* i8_ptr_t = ir_type_ptr(IR_TYPE_I8_T);
+    IRType* i8_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
 
-    IRType* buf_arr_t = ir_type_array(IR_TYPE_I8_T, 5);
+    IRType* buf_arr_t = ir_type_array(ctx->builder->arena, IR_TYPE_I8_T, 5);
     int buf_ptr_reg = ir_builder_emit_alloca(b, buf_arr_t);
-    IRValue* buf_ptr = ir_value_reg(buf_ptr_reg, ir_type_ptr(buf_arr_t));
+    IRValue* buf_ptr = ir_value_reg(ctx->builder->arena, buf_ptr_reg, ir_type_ptr(ctx->builder->arena, buf_arr_t));
 
     int base_reg = ir_builder_emit_cast(b, buf_ptr, i8_ptr_t);
-    IRValue* base_ptr = ir_value_reg(base_reg, i8_ptr_t);
+    IRValue* base_ptr = ir_value_reg(ctx->builder->arena, base_reg, i8_ptr_t);
 
     // i64 معبأ = bytes + len*2^32
     int pr = ir_builder_emit_cast(b, ch, IR_TYPE_I64_T);
-    IRValue* packed = ir_value_reg(pr, IR_TYPE_I64_T);
+    IRValue* packed = ir_value_reg(ctx->builder->arena, pr, IR_TYPE_I64_T);
 
-    IRValue* c_2p32 = ir_value_const_int(4294967296LL, IR_TYPE_I64_T);
-    IRValue* c256 = ir_value_const_int(256, IR_TYPE_I64_T);
+    IRValue* c_2p32 = ir_value_const_int(ctx->builder->arena, 4294967296LL, IR_TYPE_I64_T);
+    IRValue* c256 = ir_value_const_int(ctx->builder->arena, 256, IR_TYPE_I64_T);
 
     int len_r = ir_builder_emit_div(b, IR_TYPE_I64_T, packed, c_2p32);
-    IRValue* len = ir_value_reg(len_r, IR_TYPE_I64_T);
+    IRValue* len = ir_value_reg(ctx->builder->arena, len_r, IR_TYPE_I64_T);
 
     int bytes_r = ir_builder_emit_mod(b, IR_TYPE_I64_T, packed, c_2p32);
-    IRValue* bytes = ir_value_reg(bytes_r, IR_TYPE_I64_T);
+    IRValue* bytes = ir_value_reg(ctx->builder->arena, bytes_r, IR_TYPE_I64_T);
 
     int b0_r = ir_builder_emit_mod(b, IR_TYPE_I64_T, bytes, c256);
-    IRValue* b0 = ir_value_reg(b0_r, IR_TYPE_I64_T);
+    IRValue* b0 = ir_value_reg(ctx->builder->arena, b0_r, IR_TYPE_I64_T);
     int bytes1_r = ir_builder_emit_div(b, IR_TYPE_I64_T, bytes, c256);
-    IRValue* bytes1 = ir_value_reg(bytes1_r, IR_TYPE_I64_T);
+    IRValue* bytes1 = ir_value_reg(ctx->builder->arena, bytes1_r, IR_TYPE_I64_T);
 
     int b1_r = ir_builder_emit_mod(b, IR_TYPE_I64_T, bytes1, c256);
-    IRValue* b1 = ir_value_reg(b1_r, IR_TYPE_I64_T);
+    IRValue* b1 = ir_value_reg(ctx->builder->arena, b1_r, IR_TYPE_I64_T);
     int bytes2_r = ir_builder_emit_div(b, IR_TYPE_I64_T, bytes1, c256);
-    IRValue* bytes2 = ir_value_reg(bytes2_r, IR_TYPE_I64_T);
+    IRValue* bytes2 = ir_value_reg(ctx->builder->arena, bytes2_r, IR_TYPE_I64_T);
 
     int b2_r = ir_builder_emit_mod(b, IR_TYPE_I64_T, bytes2, c256);
-    IRValue* b2 = ir_value_reg(b2_r, IR_TYPE_I64_T);
+    IRValue* b2 = ir_value_reg(ctx->builder->arena, b2_r, IR_TYPE_I64_T);
     int bytes3_r = ir_builder_emit_div(b, IR_TYPE_I64_T, bytes2, c256);
-    IRValue* bytes3 = ir_value_reg(bytes3_r, IR_TYPE_I64_T);
+    IRValue* bytes3 = ir_value_reg(ctx->builder->arena, bytes3_r, IR_TYPE_I64_T);
 
     int b3_r = ir_builder_emit_mod(b, IR_TYPE_I64_T, bytes3, c256);
-    IRValue* b3 = ir_value_reg(b3_r, IR_TYPE_I64_T);
+    IRValue* b3 = ir_value_reg(ctx->builder->arena, b3_r, IR_TYPE_I64_T);
 
-    IRValue* idx0 = ir_value_const_int(0, IR_TYPE_I64_T);
-    IRValue* idx1 = ir_value_const_int(1, IR_TYPE_I64_T);
-    IRValue* idx2 = ir_value_const_int(2, IR_TYPE_I64_T);
-    IRValue* idx3 = ir_value_const_int(3, IR_TYPE_I64_T);
+    IRValue* idx0 = ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
+    IRValue* idx1 = ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T);
+    IRValue* idx2 = ir_value_const_int(ctx->builder->arena, 2, IR_TYPE_I64_T);
+    IRValue* idx3 = ir_value_const_int(ctx->builder->arena, 3, IR_TYPE_I64_T);
 
-    IRValue* b0p = ir_value_reg(ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx0), i8_ptr_t);
-    IRValue* b1p = ir_value_reg(ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx1), i8_ptr_t);
-    IRValue* b2p = ir_value_reg(ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx2), i8_ptr_t);
-    IRValue* b3p = ir_value_reg(ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx3), i8_ptr_t);
+    IRValue* b0p = ir_value_reg(ctx->builder->arena, ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx0), i8_ptr_t);
+    IRValue* b1p = ir_value_reg(ctx->builder->arena, ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx1), i8_ptr_t);
+    IRValue* b2p = ir_value_reg(ctx->builder->arena, ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx2), i8_ptr_t);
+    IRValue* b3p = ir_value_reg(ctx->builder->arena, ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx3), i8_ptr_t);
 
     if (site) ir_lower_set_loc(b, site);
     ir_builder_emit_store(b, cast_to(ctx, b0, IR_TYPE_I8_T), b0p);
@@ -293,8 +291,8 @@ static IRValue* ir_lower_char_to_cstr_tmp(IRLowerCtx* ctx, const Node* site, IRV
     ir_builder_emit_store(b, cast_to(ctx, b2, IR_TYPE_I8_T), b2p);
     ir_builder_emit_store(b, cast_to(ctx, b3, IR_TYPE_I8_T), b3p);
 
-    IRValue* tp = ir_value_reg(ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, len), i8_ptr_t);
-    ir_builder_emit_store(b, ir_value_const_int(0, IR_TYPE_I8_T), tp);
+    IRValue* tp = ir_value_reg(ctx->builder->arena, ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, len), i8_ptr_t);
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I8_T), tp);
 
     return base_ptr;
 }
@@ -304,29 +302,27 @@ static IRValue* ir_lower_cstr_or_literal_on_null(IRLowerCtx* ctx, const Node* si
     if (!ctx || !ctx->builder || !literal) return cstr;
 
     IRBuilder* b = ctx->builder;
-    IRModule* m = b->module;
-    if (m) ir_module_set_current(m);
 
-    IRType* i8_ptr_t = ir_type_ptr(IR_TYPE_I8_T);
-    IRType* i8_ptr_ptr_t = ir_type_ptr(i8_ptr_t);
+    IRType* i8_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
+    IRType* i8_ptr_ptr_t = ir_type_ptr(ctx->builder->arena, i8_ptr_t);
 
-    IRValue* p = cstr ? cast_to(ctx, cstr, i8_ptr_t) : ir_value_const_int(0, i8_ptr_t);
+    IRValue* p = cstr ? cast_to(ctx, cstr, i8_ptr_t) : ir_value_const_int(ctx->builder->arena, 0, i8_ptr_t);
     IRValue* lit = ir_builder_const_string(b, literal);
     if (!lit) return p;
 
     int res_ptr_reg = ir_builder_emit_alloca(b, i8_ptr_t);
-    IRValue* res_ptr = ir_value_reg(res_ptr_reg, i8_ptr_ptr_t);
+    IRValue* res_ptr = ir_value_reg(ctx->builder->arena, res_ptr_reg, i8_ptr_ptr_t);
     ir_builder_emit_store(b, p, res_ptr);
 
-    int is_null_r = ir_builder_emit_cmp_eq(b, p, ir_value_const_int(0, i8_ptr_t));
-    IRValue* is_null = ir_value_reg(is_null_r, IR_TYPE_I1_T);
+    int is_null_r = ir_builder_emit_cmp_eq(b, p, ir_value_const_int(ctx->builder->arena, 0, i8_ptr_t));
+    IRValue* is_null = ir_value_reg(ctx->builder->arena, is_null_r, IR_TYPE_I1_T);
 
     IRBlock* b_null = cf_create_block(ctx, "تنسيق_نص_NULL");
     IRBlock* b_ok = cf_create_block(ctx, "تنسيق_نص_OK");
     IRBlock* b_ret = cf_create_block(ctx, "تنسيق_نص_إرجاع");
     if (!b_null || !b_ok || !b_ret) {
         int r0 = ir_builder_emit_load(b, i8_ptr_t, res_ptr);
-        return ir_value_reg(r0, i8_ptr_t);
+        return ir_value_reg(ctx->builder->arena, r0, i8_ptr_t);
     }
 
     ir_builder_emit_br_cond(b, is_null, b_null, b_ok);
@@ -343,7 +339,7 @@ static IRValue* ir_lower_cstr_or_literal_on_null(IRLowerCtx* ctx, const Node* si
     ir_builder_set_insert_point(b, b_ret);
     if (site) ir_lower_set_loc(b, site);
     int r = ir_builder_emit_load(b, i8_ptr_t, res_ptr);
-    return ir_value_reg(r, i8_ptr_t);
+    return ir_value_reg(ctx->builder->arena, r, i8_ptr_t);
 }
 
 static IRValue* ir_lower_builtin_print_format_ar(IRLowerCtx* ctx, Node* call_expr);
@@ -375,41 +371,39 @@ static bool ir_lower_variadic_extract_type(Node* type_arg, DataType* out_type)
 
 static IRValue* ir_lower_pack_variadic_args(IRLowerCtx* ctx, Node* site, IRValue** args, int arg_count)
 {
-    if (!ctx || !ctx->builder) return ir_value_const_int(0, ir_type_ptr(IR_TYPE_I8_T));
+    if (!ctx || !ctx->builder) return ir_value_const_int(ctx->builder->arena, 0, ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T));
 
     IRBuilder* b = ctx->builder;
-    IRModule* m = b->module;
-    if (m) ir_module_set_current(m);
 
-    IRType* i8_ptr_t = ir_type_ptr(IR_TYPE_I8_T);
-    IRType* i8_ptr_ptr_t = ir_type_ptr(i8_ptr_t);
-    IRType* i64_ptr_t = ir_type_ptr(IR_TYPE_I64_T);
-    IRType* f64_ptr_t = ir_type_ptr(IR_TYPE_F64_T);
+    IRType* i8_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
+    IRType* i8_ptr_ptr_t = ir_type_ptr(ctx->builder->arena, i8_ptr_t);
+    IRType* i64_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I64_T);
+    IRType* f64_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_F64_T);
 
     int slots = arg_count > 0 ? arg_count : 1;
-    IRType* buf_arr_t = ir_type_array(IR_TYPE_I8_T, slots * 8);
+    IRType* buf_arr_t = ir_type_array(ctx->builder->arena, IR_TYPE_I8_T, slots * 8);
     if (!buf_arr_t) {
         ir_lower_report_error(ctx, site, "فشل إنشاء مخزن معاملات متغيرة.");
-        return ir_value_const_int(0, i8_ptr_t);
+        return ir_value_const_int(ctx->builder->arena, 0, i8_ptr_t);
     }
 
     int buf_reg = ir_builder_emit_alloca(b, buf_arr_t);
-    IRValue* buf_arr_ptr = ir_value_reg(buf_reg, ir_type_ptr(buf_arr_t));
+    IRValue* buf_arr_ptr = ir_value_reg(ctx->builder->arena, buf_reg, ir_type_ptr(ctx->builder->arena, buf_arr_t));
     int base_cast = ir_builder_emit_cast(b, buf_arr_ptr, i8_ptr_t);
-    IRValue* base_i8 = ir_value_reg(base_cast, i8_ptr_t);
+    IRValue* base_i8 = ir_value_reg(ctx->builder->arena, base_cast, i8_ptr_t);
 
     for (int i = 0; i < arg_count; i++) {
-        IRValue* av = (args && args[i]) ? args[i] : ir_value_const_int(0, IR_TYPE_I64_T);
+        IRValue* av = (args && args[i]) ? args[i] : ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
         IRType* at = av->type ? av->type : IR_TYPE_I64_T;
 
         if (site) ir_lower_set_loc(b, site);
         int slot_r = ir_builder_emit_ptr_offset(b, i8_ptr_t, base_i8,
-                                                ir_value_const_int((int64_t)i * 8, IR_TYPE_I64_T));
-        IRValue* slot_i8 = ir_value_reg(slot_r, i8_ptr_t);
+                                                ir_value_const_int(ctx->builder->arena, (int64_t)i * 8, IR_TYPE_I64_T));
+        IRValue* slot_i8 = ir_value_reg(ctx->builder->arena, slot_r, i8_ptr_t);
 
         if (at->kind == IR_TYPE_F64) {
             int cp = ir_builder_emit_cast(b, slot_i8, f64_ptr_t);
-            IRValue* slot_f64 = ir_value_reg(cp, f64_ptr_t);
+            IRValue* slot_f64 = ir_value_reg(ctx->builder->arena, cp, f64_ptr_t);
             IRValue* fv = cast_to(ctx, av, IR_TYPE_F64_T);
             ir_builder_emit_store(b, fv, slot_f64);
             continue;
@@ -417,14 +411,14 @@ static IRValue* ir_lower_pack_variadic_args(IRLowerCtx* ctx, Node* site, IRValue
 
         if (at->kind == IR_TYPE_PTR) {
             int cp = ir_builder_emit_cast(b, slot_i8, i8_ptr_ptr_t);
-            IRValue* slot_ptr = ir_value_reg(cp, i8_ptr_ptr_t);
+            IRValue* slot_ptr = ir_value_reg(ctx->builder->arena, cp, i8_ptr_ptr_t);
             IRValue* pv = cast_to(ctx, av, i8_ptr_t);
             ir_builder_emit_store(b, pv, slot_ptr);
             continue;
         }
 
         int cp = ir_builder_emit_cast(b, slot_i8, i64_ptr_t);
-        IRValue* slot_i64 = ir_value_reg(cp, i64_ptr_t);
+        IRValue* slot_i64 = ir_value_reg(ctx->builder->arena, cp, i64_ptr_t);
         IRValue* iv = ensure_i64(ctx, av);
         ir_builder_emit_store(b, iv, slot_i64);
     }
@@ -434,12 +428,12 @@ static IRValue* ir_lower_pack_variadic_args(IRLowerCtx* ctx, Node* site, IRValue
 
 static IRValue* ir_lower_builtin_variadic_start(IRLowerCtx* ctx, Node* call_expr)
 {
-    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(0);
+    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(ctx->builder, 0);
 
     if (!ctx->current_func_is_variadic || ctx->current_func_va_base_reg < 0) {
         ir_lower_report_error(ctx, call_expr, "استدعاء 'بدء_معاملات' خارج دالة متغيرة المعاملات.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
     Node* a0 = call_expr->data.call.args;
@@ -447,12 +441,12 @@ static IRValue* ir_lower_builtin_variadic_start(IRLowerCtx* ctx, Node* call_expr
     if (!a0 || !a1 || a1->next) {
         ir_lower_report_error(ctx, call_expr, "استدعاء 'بدء_معاملات' يتطلب معاملين.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
     if (a0->type != NODE_VAR_REF) {
         ir_lower_report_error(ctx, a0, "المعامل الأول في 'بدء_معاملات' يجب أن يكون متغيراً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
     IRType* cursor_pointee = IR_TYPE_I64_T;
@@ -460,37 +454,37 @@ static IRValue* ir_lower_builtin_variadic_start(IRLowerCtx* ctx, Node* call_expr
     if (!cursor_pointee || cursor_pointee->kind != IR_TYPE_PTR) {
         ir_lower_report_error(ctx, a0, "متغير قائمة المعاملات يجب أن يكون مؤشراً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
-    IRType* i8_ptr_t = ir_type_ptr(IR_TYPE_I8_T);
-    IRValue* base = ir_value_reg(ctx->current_func_va_base_reg, i8_ptr_t);
+    IRType* i8_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
+    IRValue* base = ir_value_reg(ctx->builder->arena, ctx->current_func_va_base_reg, i8_ptr_t);
     int64_t off = (int64_t)ctx->current_func_fixed_params * 8;
     if (off > 0) {
         int pr = ir_builder_emit_ptr_offset(ctx->builder, i8_ptr_t, base,
-                                            ir_value_const_int(off, IR_TYPE_I64_T));
-        base = ir_value_reg(pr, i8_ptr_t);
+                                            ir_value_const_int(ctx->builder->arena, off, IR_TYPE_I64_T));
+        base = ir_value_reg(ctx->builder->arena, pr, i8_ptr_t);
     }
 
     if (call_expr) ir_lower_set_loc(ctx->builder, call_expr);
     ir_builder_emit_store(ctx->builder, cast_to(ctx, base, cursor_pointee), cursor_addr);
-    return ir_builder_const_i64(0);
+    return ir_builder_const_i64(ctx->builder, 0);
 }
 
 static IRValue* ir_lower_builtin_variadic_end(IRLowerCtx* ctx, Node* call_expr)
 {
-    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(0);
+    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(ctx->builder, 0);
 
     Node* a0 = call_expr->data.call.args;
     if (!a0 || a0->next) {
         ir_lower_report_error(ctx, call_expr, "استدعاء 'نهاية_معاملات' يتطلب معاملاً واحداً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
     if (a0->type != NODE_VAR_REF) {
         ir_lower_report_error(ctx, a0, "المعامل الأول في 'نهاية_معاملات' يجب أن يكون متغيراً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
     IRType* cursor_pointee = IR_TYPE_I64_T;
@@ -498,22 +492,22 @@ static IRValue* ir_lower_builtin_variadic_end(IRLowerCtx* ctx, Node* call_expr)
     if (!cursor_pointee || cursor_pointee->kind != IR_TYPE_PTR) {
         ir_lower_report_error(ctx, a0, "متغير قائمة المعاملات يجب أن يكون مؤشراً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
     if (call_expr) ir_lower_set_loc(ctx->builder, call_expr);
-    ir_builder_emit_store(ctx->builder, ir_value_const_int(0, cursor_pointee), cursor_addr);
-    return ir_builder_const_i64(0);
+    ir_builder_emit_store(ctx->builder, ir_value_const_int(ctx->builder->arena, 0, cursor_pointee), cursor_addr);
+    return ir_builder_const_i64(ctx->builder, 0);
 }
 
 static IRValue* ir_lower_builtin_variadic_next(IRLowerCtx* ctx, Node* call_expr)
 {
-    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(0);
+    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(ctx->builder, 0);
 
     if (!ctx->current_func_is_variadic) {
         ir_lower_report_error(ctx, call_expr, "استدعاء 'معامل_تالي' خارج دالة متغيرة المعاملات.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
     Node* a0 = call_expr->data.call.args;
@@ -521,41 +515,40 @@ static IRValue* ir_lower_builtin_variadic_next(IRLowerCtx* ctx, Node* call_expr)
     if (!a0 || !a1 || a1->next) {
         ir_lower_report_error(ctx, call_expr, "استدعاء 'معامل_تالي' يتطلب معاملين.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
     if (a0->type != NODE_VAR_REF) {
         ir_lower_report_error(ctx, a0, "المعامل الأول في 'معامل_تالي' يجب أن يكون متغيراً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
     DataType want = TYPE_INT;
     if (!ir_lower_variadic_extract_type(a1, &want)) {
         ir_lower_report_error(ctx, a1, "المعامل الثاني في 'معامل_تالي' يجب أن يكون نوعاً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
     IRBuilder* b = ctx->builder;
     IRModule* m = b->module;
-    if (m) ir_module_set_current(m);
 
     IRType* cursor_pointee = IR_TYPE_I64_T;
     IRValue* cursor_addr = lower_lvalue_address(ctx, a0, &cursor_pointee);
     if (!cursor_pointee || cursor_pointee->kind != IR_TYPE_PTR) {
         ir_lower_report_error(ctx, a0, "متغير قائمة المعاملات يجب أن يكون مؤشراً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
-    IRType* i8_ptr_t = ir_type_ptr(IR_TYPE_I8_T);
-    IRType* i64_ptr_t = ir_type_ptr(IR_TYPE_I64_T);
-    IRType* f64_ptr_t = ir_type_ptr(IR_TYPE_F64_T);
-    IRType* i8_ptr_ptr_t = ir_type_ptr(i8_ptr_t);
+    IRType* i8_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
+    IRType* i64_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I64_T);
+    IRType* f64_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_F64_T);
+    IRType* i8_ptr_ptr_t = ir_type_ptr(ctx->builder->arena, i8_ptr_t);
 
     if (call_expr) ir_lower_set_loc(b, call_expr);
     int cur_r = ir_builder_emit_load(b, cursor_pointee, cursor_addr);
-    IRValue* cur_raw = ir_value_reg(cur_r, cursor_pointee);
+    IRValue* cur_raw = ir_value_reg(ctx->builder->arena, cur_r, cursor_pointee);
     IRValue* cur_i8 = cast_to(ctx, cur_raw, i8_ptr_t);
 
     IRType* load_t = IR_TYPE_I64_T;
@@ -571,20 +564,20 @@ static IRValue* ir_lower_builtin_variadic_next(IRLowerCtx* ctx, Node* call_expr)
     IRValue* slot_ptr = NULL;
     if (load_t == IR_TYPE_F64_T) {
         int cp = ir_builder_emit_cast(b, cur_i8, f64_ptr_t);
-        slot_ptr = ir_value_reg(cp, f64_ptr_t);
+        slot_ptr = ir_value_reg(ctx->builder->arena, cp, f64_ptr_t);
     } else if (load_t == i8_ptr_t) {
         int cp = ir_builder_emit_cast(b, cur_i8, i8_ptr_ptr_t);
-        slot_ptr = ir_value_reg(cp, i8_ptr_ptr_t);
+        slot_ptr = ir_value_reg(ctx->builder->arena, cp, i8_ptr_ptr_t);
     } else {
         int cp = ir_builder_emit_cast(b, cur_i8, i64_ptr_t);
-        slot_ptr = ir_value_reg(cp, i64_ptr_t);
+        slot_ptr = ir_value_reg(ctx->builder->arena, cp, i64_ptr_t);
     }
 
     int val_r = ir_builder_emit_load(b, load_t, slot_ptr);
-    IRValue* val = ir_value_reg(val_r, load_t);
+    IRValue* val = ir_value_reg(ctx->builder->arena, val_r, load_t);
 
-    int next_r = ir_builder_emit_ptr_offset(b, i8_ptr_t, cur_i8, ir_value_const_int(8, IR_TYPE_I64_T));
-    IRValue* next_i8 = ir_value_reg(next_r, i8_ptr_t);
+    int next_r = ir_builder_emit_ptr_offset(b, i8_ptr_t, cur_i8, ir_value_const_int(ctx->builder->arena, 8, IR_TYPE_I64_T));
+    IRValue* next_i8 = ir_value_reg(ctx->builder->arena, next_r, i8_ptr_t);
     ir_builder_emit_store(b, cast_to(ctx, next_i8, cursor_pointee), cursor_addr);
 
     if (load_t != ret_t) {
@@ -607,11 +600,11 @@ static void ir_lower_emit_message_and_free_if_needed(IRLowerCtx* ctx,
     if (!ctx || !ctx->builder || !cstr_msg) return;
 
     IRBuilder* b = ctx->builder;
-    IRType* i8_ptr_t = ir_type_ptr(IR_TYPE_I8_T);
-    IRValue* n = ir_value_const_int(0, i8_ptr_t);
+    IRType* i8_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
+    IRValue* n = ir_value_const_int(ctx->builder->arena, 0, i8_ptr_t);
 
     int is_null_r = ir_builder_emit_cmp_eq(b, cstr_msg, n);
-    IRValue* is_null = ir_value_reg(is_null_r, IR_TYPE_I1_T);
+    IRValue* is_null = ir_value_reg(ctx->builder->arena, is_null_r, IR_TYPE_I1_T);
 
     IRBlock* skipb = cf_create_block(ctx, "رسالة_تخطي");
     IRBlock* printb = cf_create_block(ctx, "رسالة_طباعة");
@@ -652,10 +645,10 @@ static void ir_lower_emit_message_and_free_if_needed(IRLowerCtx* ctx,
 
 static IRValue* ir_lower_build_panic_path(IRLowerCtx* ctx, Node* site, Node* msg_node, const char* header)
 {
-    if (!ctx || !ctx->builder) return ir_builder_const_i64(0);
+    if (!ctx || !ctx->builder) return ir_builder_const_i64(ctx->builder, 0);
 
     IRBuilder* b = ctx->builder;
-    IRType* i8_ptr_t = ir_type_ptr(IR_TYPE_I8_T);
+    IRType* i8_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
 
     if (header && header[0]) {
         IRValue* hv = ir_builder_const_string(b, header);
@@ -677,7 +670,7 @@ static IRValue* ir_lower_build_panic_path(IRLowerCtx* ctx, Node* site, Node* msg
         }
 
         if (!msg_i8) {
-            msg_i8 = ir_value_const_int(0, i8_ptr_t);
+            msg_i8 = ir_value_const_int(ctx->builder->arena, 0, i8_ptr_t);
         }
         ir_lower_emit_message_and_free_if_needed(ctx, site, msg_i8, free_msg);
     }
@@ -689,19 +682,19 @@ static IRValue* ir_lower_build_panic_path(IRLowerCtx* ctx, Node* site, Node* msg
         ir_builder_set_insert_point(b, cont);
         if (site) ir_lower_set_loc(b, site);
     }
-    return ir_builder_const_i64(0);
+    return ir_builder_const_i64(ctx->builder, 0);
 }
 
 static IRValue* ir_lower_builtin_assert(IRLowerCtx* ctx, Node* call_expr)
 {
-    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(0);
+    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(ctx->builder, 0);
 
     Node* a0 = call_expr->data.call.args;
     Node* a1 = a0 ? a0->next : NULL;
     if (!a0 || !a1 || a1->next) {
         ir_lower_report_error(ctx, call_expr, "استدعاء 'تأكد' يتطلب وسيطين.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
     IRValue* cond_v = cast_to(ctx, lower_expr(ctx, a0), IR_TYPE_I1_T);
@@ -709,7 +702,7 @@ static IRValue* ir_lower_builtin_assert(IRLowerCtx* ctx, Node* call_expr)
     IRBlock* failb = cf_create_block(ctx, "تأكد_فشل");
     if (!passb || !failb) {
         ir_lower_report_error(ctx, call_expr, "فشل إنشاء كتل تحكم لـ 'تأكد'.");
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
     if (!ir_builder_is_block_terminated(ctx->builder)) {
@@ -722,58 +715,58 @@ static IRValue* ir_lower_builtin_assert(IRLowerCtx* ctx, Node* call_expr)
 
     ir_builder_set_insert_point(ctx->builder, passb);
     ir_lower_set_loc(ctx->builder, call_expr);
-    return ir_builder_const_i64(0);
+    return ir_builder_const_i64(ctx->builder, 0);
 }
 
 static IRValue* ir_lower_builtin_panic(IRLowerCtx* ctx, Node* call_expr)
 {
-    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(0);
+    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(ctx->builder, 0);
 
     Node* a0 = call_expr->data.call.args;
     if (!a0 || a0->next) {
         ir_lower_report_error(ctx, call_expr, "استدعاء 'توقف_فوري' يتطلب معاملاً واحداً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
     return ir_lower_build_panic_path(ctx, call_expr, a0, "توقف_فوري");
 }
 
 static IRValue* ir_lower_builtin_errno_get(IRLowerCtx* ctx, Node* call_expr)
 {
-    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(0);
+    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(ctx->builder, 0);
 
     if (call_expr->data.call.args) {
         ir_lower_report_error(ctx, call_expr, "استدعاء 'كود_خطأ_النظام' لا يقبل معاملات.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
-    IRType* i32_ptr_t = ir_type_ptr(IR_TYPE_I32_T);
+    IRType* i32_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I32_T);
     const char* errno_fn = ir_lower_errno_symbol(ctx);
     ir_lower_set_loc(ctx->builder, call_expr);
     int pr = ir_builder_emit_call(ctx->builder, errno_fn, i32_ptr_t, NULL, 0);
     if (pr < 0) {
         ir_lower_report_error(ctx, call_expr, "فشل خفض نداء مؤشر errno.");
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
-    IRValue* p = ir_value_reg(pr, i32_ptr_t);
+    IRValue* p = ir_value_reg(ctx->builder->arena, pr, i32_ptr_t);
     int vr = ir_builder_emit_load(ctx->builder, IR_TYPE_I32_T, p);
-    return cast_to(ctx, ir_value_reg(vr, IR_TYPE_I32_T), IR_TYPE_I64_T);
+    return cast_to(ctx, ir_value_reg(ctx->builder->arena, vr, IR_TYPE_I32_T), IR_TYPE_I64_T);
 }
 
 static IRValue* ir_lower_builtin_errno_set(IRLowerCtx* ctx, Node* call_expr)
 {
-    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(0);
+    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(ctx->builder, 0);
 
     Node* a0 = call_expr->data.call.args;
     if (!a0 || a0->next) {
         ir_lower_report_error(ctx, call_expr, "استدعاء 'ضبط_كود_خطأ_النظام' يتطلب معاملاً واحداً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
-    IRType* i32_ptr_t = ir_type_ptr(IR_TYPE_I32_T);
+    IRType* i32_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I32_T);
     const char* errno_fn = ir_lower_errno_symbol(ctx);
 
     IRValue* in_i64 = ensure_i64(ctx, lower_expr(ctx, a0));
@@ -783,26 +776,26 @@ static IRValue* ir_lower_builtin_errno_set(IRLowerCtx* ctx, Node* call_expr)
     int pr = ir_builder_emit_call(ctx->builder, errno_fn, i32_ptr_t, NULL, 0);
     if (pr < 0) {
         ir_lower_report_error(ctx, call_expr, "فشل خفض نداء مؤشر errno.");
-        return ir_builder_const_i64(0);
+        return ir_builder_const_i64(ctx->builder, 0);
     }
 
-    IRValue* p = ir_value_reg(pr, i32_ptr_t);
+    IRValue* p = ir_value_reg(ctx->builder->arena, pr, i32_ptr_t);
     ir_builder_emit_store(ctx->builder, in_i32, p);
-    return ir_builder_const_i64(0);
+    return ir_builder_const_i64(ctx->builder, 0);
 }
 
 static IRValue* ir_lower_builtin_errno_text(IRLowerCtx* ctx, Node* call_expr)
 {
-    if (!ctx || !ctx->builder || !call_expr) return ir_value_const_int(0, get_char_ptr_type(ctx->builder->module));
+    if (!ctx || !ctx->builder || !call_expr) return ir_value_const_int(ctx->builder->arena, 0, get_char_ptr_type(ctx->builder->module));
 
     Node* a0 = call_expr->data.call.args;
     if (!a0 || a0->next) {
         ir_lower_report_error(ctx, call_expr, "استدعاء 'نص_كود_خطأ' يتطلب معاملاً واحداً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_value_const_int(0, get_char_ptr_type(ctx->builder->module));
+        return ir_value_const_int(ctx->builder->arena, 0, get_char_ptr_type(ctx->builder->module));
     }
 
-    IRType* i8_ptr_t = ir_type_ptr(IR_TYPE_I8_T);
+    IRType* i8_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
     IRType* char_ptr_t = get_char_ptr_type(ctx->builder->module);
 
     IRValue* in_i64 = ensure_i64(ctx, lower_expr(ctx, a0));
@@ -813,14 +806,14 @@ static IRValue* ir_lower_builtin_errno_text(IRLowerCtx* ctx, Node* call_expr)
     int r = ir_builder_emit_call(ctx->builder, "strerror", i8_ptr_t, args, 1);
     if (r < 0) {
         ir_lower_report_error(ctx, call_expr, "فشل خفض نداء strerror.");
-        return ir_value_const_int(0, char_ptr_t);
+        return ir_value_const_int(ctx->builder->arena, 0, char_ptr_t);
     }
-    return ir_lower_cstr_to_baa_string_alloc(ctx, call_expr, ir_value_reg(r, i8_ptr_t));
+    return ir_lower_cstr_to_baa_string_alloc(ctx, call_expr, ir_value_reg(ctx->builder->arena, r, i8_ptr_t));
 }
 
 static IRValue* ir_lower_builtin_result_code_success(IRLowerCtx* ctx, Node* call_expr, bool success)
 {
-    if (!ctx || !ctx->builder || !call_expr) return ir_value_const_int(0, IR_TYPE_I1_T);
+    if (!ctx || !ctx->builder || !call_expr) return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I1_T);
 
     Node* a0 = call_expr->data.call.args;
     if (!a0 || a0->next) {
@@ -829,46 +822,46 @@ static IRValue* ir_lower_builtin_result_code_success(IRLowerCtx* ctx, Node* call
                                   ? "استدعاء 'نتيجة_ناجحة' يتطلب معاملاً واحداً."
                                   : "استدعاء 'نتيجة_فاشلة' يتطلب معاملاً واحداً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_value_const_int(0, IR_TYPE_I1_T);
+        return ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I1_T);
     }
 
     IRValue* code = ensure_i64(ctx, lower_expr(ctx, a0));
     int r = success
-                ? ir_builder_emit_cmp_eq(ctx->builder, code, ir_value_const_int(0, IR_TYPE_I64_T))
-                : ir_builder_emit_cmp_ne(ctx->builder, code, ir_value_const_int(0, IR_TYPE_I64_T));
-    return ir_value_reg(r, IR_TYPE_I1_T);
+                ? ir_builder_emit_cmp_eq(ctx->builder, code, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T))
+                : ir_builder_emit_cmp_ne(ctx->builder, code, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T));
+    return ir_value_reg(ctx->builder->arena, r, IR_TYPE_I1_T);
 }
 
 static IRValue* ir_lower_builtin_result_code_from_bool(IRLowerCtx* ctx, Node* call_expr)
 {
-    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(1);
+    if (!ctx || !ctx->builder || !call_expr) return ir_builder_const_i64(ctx->builder, 1);
 
     Node* a0 = call_expr->data.call.args;
     if (!a0 || a0->next) {
         ir_lower_report_error(ctx, call_expr, "استدعاء 'كود_نتيجة' يتطلب معاملاً واحداً.");
         ir_lower_eval_call_args(ctx, call_expr->data.call.args);
-        return ir_builder_const_i64(1);
+        return ir_builder_const_i64(ctx->builder, 1);
     }
 
     IRBuilder* b = ctx->builder;
-    IRType* i64_ptr_t = ir_type_ptr(IR_TYPE_I64_T);
-    IRValue* result_ptr = ir_value_reg(ir_builder_emit_alloca(b, IR_TYPE_I64_T), i64_ptr_t);
-    ir_builder_emit_store(b, ir_value_const_int(1, IR_TYPE_I64_T), result_ptr);
+    IRType* i64_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I64_T);
+    IRValue* result_ptr = ir_value_reg(ctx->builder->arena, ir_builder_emit_alloca(b, IR_TYPE_I64_T), i64_ptr_t);
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T), result_ptr);
 
     IRValue* ok = lower_to_bool(ctx, lower_expr(ctx, a0));
     IRBlock* success = cf_create_block(ctx, "كود_نتيجة_نجاح");
     IRBlock* done = cf_create_block(ctx, "كود_نتيجة_نهاية");
-    if (!success || !done) return ir_builder_const_i64(1);
+    if (!success || !done) return ir_builder_const_i64(ctx->builder, 1);
 
     ir_builder_emit_br_cond(b, ok, success, done);
 
     ir_builder_set_insert_point(b, success);
     ir_lower_set_loc(b, call_expr);
-    ir_builder_emit_store(b, ir_value_const_int(0, IR_TYPE_I64_T), result_ptr);
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T), result_ptr);
     ir_builder_emit_br(b, done);
 
     ir_builder_set_insert_point(b, done);
     ir_lower_set_loc(b, call_expr);
     int r = ir_builder_emit_load(b, IR_TYPE_I64_T, result_ptr);
-    return ir_value_reg(r, IR_TYPE_I64_T);
+    return ir_value_reg(ctx->builder->arena, r, IR_TYPE_I64_T);
 }
@@ -18,7 +18,7 @@ static bool ir_lower_try_process_builtin(IRLowerCtx* ctx, Node* expr, IRValue**
     if (strcmp(name, "ابدأ_عملية") == 0) {
         symbol = "baa_runtime_process_start";
         expected = 7;
-        result_type = ir_type_ptr(IR_TYPE_I8_T);
+        result_type = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
     } else if (strcmp(name, "حالة_عملية") == 0) {
         symbol = "baa_runtime_process_poll";
     } else if (strcmp(name, "انتظر_عملية") == 0) {
@@ -50,8 +50,8 @@ static bool ir_lower_try_process_builtin(IRLowerCtx* ctx, Node* expr, IRValue**
     if (count != expected) {
         ir_lower_report_error(ctx, expr, "عدد معاملات '%s' غير صحيح أثناء الخفض.", name);
         if (out_value) *out_value = returns_void
-            ? ir_value_const_int(0, IR_TYPE_I64_T)
-            : ir_value_const_int(-1, result_type);
+            ? ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T)
+            : ir_value_const_int(ctx->builder->arena, -1, result_type);
         return true;
     }
 
@@ -63,16 +63,16 @@ static bool ir_lower_try_process_builtin(IRLowerCtx* ctx, Node* expr, IRValue**
     ir_lower_set_loc(ctx->builder, expr);
     if (returns_void) {
         ir_builder_emit_call_void(ctx->builder, symbol, args, count);
-        if (out_value) *out_value = ir_value_const_int(0, IR_TYPE_I64_T);
+        if (out_value) *out_value = ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
         return true;
     }
 
     int result = ir_builder_emit_call(ctx->builder, symbol, result_type, args, count);
     if (result < 0) {
         ir_lower_report_error(ctx, expr, "فشل خفض نداء '%s'.", name);
-        if (out_value) *out_value = ir_value_const_int(-1, result_type);
+        if (out_value) *out_value = ir_value_const_int(ctx->builder->arena, -1, result_type);
         return true;
     }
-    if (out_value) *out_value = ir_value_reg(result, result_type);
+    if (out_value) *out_value = ir_value_reg(ctx->builder->arena, result, result_type);
     return true;
 }
@@ -114,7 +114,7 @@ static IRValue* ir_lower_global_init_value(IRBuilder* builder, Node* expr, IRTyp
     if (!builder) return NULL;
 
     if (!expr) {
-        return ir_value_const_int(0, expected_type ? expected_type : IR_TYPE_I64_T);
+        return ir_value_const_int(builder->arena, 0, expected_type ? expected_type : IR_TYPE_I64_T);
     }
 
     switch (expr->type) {
@@ -123,7 +123,7 @@ static IRValue* ir_lower_global_init_value(IRBuilder* builder, Node* expr, IRTyp
             IRType* t = expected_type ? expected_type : IR_TYPE_I64_T;
             int64_t v = (int64_t)expr->data.integer.value;
             v = ir_lower_trunc_const_to_type(v, t);
-            return ir_value_const_int(v, t);
+            return ir_value_const_int(builder->arena, v, t);
         }
 
         case NODE_BOOL:
@@ -131,23 +131,23 @@ static IRValue* ir_lower_global_init_value(IRBuilder* builder, Node* expr, IRTyp
             IRType* t = expected_type ? expected_type : IR_TYPE_I1_T;
             int64_t v = expr->data.bool_lit.value ? 1 : 0;
             v = ir_lower_trunc_const_to_type(v, t);
-            return ir_value_const_int(v, t);
+            return ir_value_const_int(builder->arena, v, t);
         }
 
         case NODE_FLOAT:
-            return ir_value_const_int((int64_t)expr->data.float_lit.bits,
+            return ir_value_const_int(builder->arena, (int64_t)expr->data.float_lit.bits,
                                       expected_type ? expected_type : IR_TYPE_F64_T);
 
         case NODE_CHAR:
             if (expected_type && expected_type->kind == IR_TYPE_CHAR) {
                 uint64_t packed = pack_utf8_codepoint((uint32_t)expr->data.char_lit.value);
-                return ir_value_const_int((int64_t)packed, IR_TYPE_CHAR_T);
+                return ir_value_const_int(builder->arena, (int64_t)packed, IR_TYPE_CHAR_T);
             }
             {
                 IRType* t = expected_type ? expected_type : IR_TYPE_I64_T;
                 int64_t v = (int64_t)expr->data.char_lit.value;
                 v = ir_lower_trunc_const_to_type(v, t);
-                return ir_value_const_int(v, t);
+                return ir_value_const_int(builder->arena, v, t);
             }
 
         case NODE_STRING:
@@ -155,22 +155,22 @@ static IRValue* ir_lower_global_init_value(IRBuilder* builder, Node* expr, IRTyp
             return ir_builder_const_baa_string(builder, expr->data.string_lit.value);
 
         case NODE_NULL:
-            return ir_value_const_int(0, expected_type ? expected_type : ir_type_ptr(IR_TYPE_I8_T));
+            return ir_value_const_int(builder->arena, 0, expected_type ? expected_type : ir_type_ptr(builder->arena, IR_TYPE_I8_T));
 
         case NODE_VAR_REF:
             // تهيئة عامة لمؤشر دالة: اسم دالة يُخزن كعنوان ثابت.
             if (expected_type && expected_type->kind == IR_TYPE_FUNC &&
                 expr->data.var_ref.name) {
-                return ir_value_func_ref(expr->data.var_ref.name, expected_type);
+                return ir_value_func_ref(builder->arena, expr->data.var_ref.name, expected_type);
             }
-            return ir_value_const_int(0, expected_type ? expected_type : IR_TYPE_I64_T);
+            return ir_value_const_int(builder->arena, 0, expected_type ? expected_type : IR_TYPE_I64_T);
 
         case NODE_MEMBER_ACCESS:
             if (expr->data.member_access.is_enum_value) {
-                return ir_value_const_int(expr->data.member_access.enum_value,
+                return ir_value_const_int(builder->arena, expr->data.member_access.enum_value,
                                           expected_type ? expected_type : IR_TYPE_I64_T);
             }
-            return ir_value_const_int(0, expected_type ? expected_type : IR_TYPE_I64_T);
+            return ir_value_const_int(builder->arena, 0, expected_type ? expected_type : IR_TYPE_I64_T);
 
         case NODE_CAST:
             return ir_lower_global_init_value(builder,
@@ -184,21 +184,21 @@ static IRValue* ir_lower_global_init_value(IRBuilder* builder, Node* expr, IRTyp
             if (ir_lower_eval_const_i64(expr, &v)) {
                 IRType* t = expected_type ? expected_type : IR_TYPE_I64_T;
                 v = ir_lower_trunc_const_to_type(v, t);
-                return ir_value_const_int(v, t);
+                return ir_value_const_int(builder->arena, v, t);
             }
             // Non-constant global initializers are not supported yet; fall back to zero.
-            return ir_value_const_int(0, expected_type ? expected_type : IR_TYPE_I64_T);
+            return ir_value_const_int(builder->arena, 0, expected_type ? expected_type : IR_TYPE_I64_T);
         }
 
         default:
             // Non-constant global initializers are not supported yet; fall back to zero.
-            return ir_value_const_int(0, expected_type ? expected_type : IR_TYPE_I64_T);
+            return ir_value_const_int(builder->arena, 0, expected_type ? expected_type : IR_TYPE_I64_T);
     }
 }
 
-IRModule* ir_lower_program(Node* program, const char* module_name,
-                           unsigned runtime_check_mask, const BaaTarget* target) {
-    if (!program || program->type != NODE_PROGRAM) return NULL;
+bool ir_lower_program(IRModule* module, Node* program,
+                      unsigned runtime_check_mask, const BaaTarget* target) {
+    if (!module || !program || program->type != NODE_PROGRAM) return false;
 
     // هل لدينا `الرئيسية(صحيح، نص[])`؟ إن كان نعم سنولد غلاف ABI لـ C ونُعيد تسمية دالة المستخدم.
     bool main_with_args = false;
@@ -213,14 +213,8 @@ IRModule* ir_lower_program(Node* program, const char* module_name,
         }
     }
 
-    IRModule* module = ir_module_new(module_name ? module_name : "module");
-    if (!module) return NULL;
-
     IRBuilder* builder = ir_builder_new(module);
-    if (!builder) {
-        ir_module_free(module);
-        return NULL;
-    }
+    if (!builder) return false;
 
     // -----------------------------------------------------------------
     // 0) إنشاء تواقيع الدوال أولاً (يدعم الاستدعاء قبل التعريف)
@@ -244,7 +238,7 @@ IRModule* ir_lower_program(Node* program, const char* module_name,
             if (decl0->data.func_def.is_variadic &&
                 existing->param_count == decl0_param_count) {
                 ir_builder_set_func(builder, existing);
-                (void)ir_builder_add_param(builder, "__baa_va_base", ir_type_ptr(IR_TYPE_I8_T));
+                (void)ir_builder_add_param(builder, "__baa_va_base", ir_type_ptr(builder->arena, IR_TYPE_I8_T));
             }
             if (!decl0->data.func_def.is_prototype) {
                 existing->is_prototype = false;
@@ -268,7 +262,7 @@ IRModule* ir_lower_program(Node* program, const char* module_name,
             (void)ir_builder_add_param(builder, p->data.var_decl.name, ptype);
         }
         if (decl0->data.func_def.is_variadic) {
-            (void)ir_builder_add_param(builder, "__baa_va_base", ir_type_ptr(IR_TYPE_I8_T));
+            (void)ir_builder_add_param(builder, "__baa_va_base", ir_type_ptr(builder->arena, IR_TYPE_I8_T));
         }
     }
 
@@ -308,11 +302,11 @@ IRModule* ir_lower_program(Node* program, const char* module_name,
                     continue;
                 }
                 elem_t = IR_TYPE_I8_T;
-                arr_t = ir_type_array(IR_TYPE_I8_T, (int)total_bytes64);
+                arr_t = ir_type_array(builder->arena, IR_TYPE_I8_T, (int)total_bytes64);
             } else {
                 elem_t = ir_type_from_datatype(module, elem_dt);
                 if (!elem_t || elem_t->kind == IR_TYPE_VOID) elem_t = IR_TYPE_I64_T;
-                arr_t = ir_type_array(elem_t, total_count);
+                arr_t = ir_type_array(builder->arena, elem_t, total_count);
             }
             if (!arr_t) continue;
 
@@ -339,8 +333,7 @@ IRModule* ir_lower_program(Node* program, const char* module_name,
                     elems = (IRValue**)ir_arena_calloc(&module->arena, (size_t)n, sizeof(IRValue*), _Alignof(IRValue*));
                     if (!elems) {
                         ir_builder_free(builder);
-                        ir_module_free(module);
-                        return NULL;
+                        return false;
                     }
                 }
 
@@ -368,7 +361,7 @@ IRModule* ir_lower_program(Node* program, const char* module_name,
                             decl->data.var_decl.name ? decl->data.var_decl.name : "???");
                     continue;
                 }
-                IRType* bytes_t = ir_type_array(IR_TYPE_I8_T, n);
+                IRType* bytes_t = ir_type_array(builder->arena, IR_TYPE_I8_T, n);
                 IRGlobal* g = ir_builder_create_global(builder, decl->data.var_decl.name, bytes_t,
                                                        decl->data.var_decl.is_const ? 1 : 0);
                 if (g) {
@@ -427,14 +420,14 @@ IRModule* ir_lower_program(Node* program, const char* module_name,
                     (void)ir_builder_add_param(builder, p->data.var_decl.name, ptype);
                 }
                 if (decl->data.func_def.is_variadic) {
-                    (void)ir_builder_add_param(builder, "__baa_va_base", ir_type_ptr(IR_TYPE_I8_T));
+                    (void)ir_builder_add_param(builder, "__baa_va_base", ir_type_ptr(builder->arena, IR_TYPE_I8_T));
                 }
             } else {
                 func->is_variadic = decl->data.func_def.is_variadic;
                 if (decl->data.func_def.is_variadic &&
                     func->param_count == decl_param_count) {
                     ir_builder_set_func(builder, func);
-                    (void)ir_builder_add_param(builder, "__baa_va_base", ir_type_ptr(IR_TYPE_I8_T));
+                    (void)ir_builder_add_param(builder, "__baa_va_base", ir_type_ptr(builder->arena, IR_TYPE_I8_T));
                 }
             }
 
@@ -492,9 +485,9 @@ IRModule* ir_lower_program(Node* program, const char* module_name,
                                     p->data.var_decl.type == TYPE_POINTER ? p->data.var_decl.ptr_base_type_name : NULL,
                                     p->data.var_decl.type == TYPE_POINTER ? p->data.var_decl.ptr_depth : 0);
 
-                IRValue* val = ir_value_reg(preg, ptype);
-                IRType* ptr_type = ir_type_ptr(ptype ? ptype : IR_TYPE_I64_T);
-                IRValue* ptr = ir_value_reg(ptr_reg, ptr_type);
+                IRValue* val = ir_value_reg(builder->arena, preg, ptype);
+                IRType* ptr_type = ir_type_ptr(builder->arena, ptype ? ptype : IR_TYPE_I64_T);
+                IRValue* ptr = ir_value_reg(builder->arena, ptr_reg, ptr_type);
                 ir_lower_set_loc(builder, p);
                 ir_builder_emit_store(builder, val, ptr);
                 ir_lower_tag_last_inst(builder, IR_OP_STORE, -1, pname);
@@ -516,7 +509,7 @@ IRModule* ir_lower_program(Node* program, const char* module_name,
                                           "الدالة '%s' قد تصل إلى النهاية بدون قيمة إرجاع.",
                                           decl->data.func_def.name ? decl->data.func_def.name : "???");
                     IRType* rt = func->ret_type ? func->ret_type : IR_TYPE_I64_T;
-                    ir_builder_emit_ret(builder, ir_value_const_int(0, rt));
+                    ir_builder_emit_ret(builder, ir_value_const_int(builder->arena, 0, rt));
                 }
             }
 
@@ -525,8 +518,7 @@ IRModule* ir_lower_program(Node* program, const char* module_name,
 
             if (ctx.had_error) {
                 ir_builder_free(builder);
-                ir_module_free(module);
-                return NULL;
+                return false;
             }
         }
     }
@@ -535,11 +527,10 @@ IRModule* ir_lower_program(Node* program, const char* module_name,
     if (main_with_args) {
         if (!ir_lower_emit_main_args_wrapper(builder, program, main_site, target)) {
             ir_builder_free(builder);
-            ir_module_free(module);
-            return NULL;
+            return false;
         }
     }
 
     ir_builder_free(builder);
-    return module;
+    return true;
 }
@@ -24,7 +24,6 @@ static void lower_array_decl(IRLowerCtx* ctx, Node* stmt) {
     bool elem_is_agg = (elem_dt == TYPE_STRUCT || elem_dt == TYPE_UNION);
 
     IRModule* m = ctx->builder->module;
-    if (m) ir_module_set_current(m);
 
     IRType* elem_t = NULL;
     IRType* arr_t = NULL;
@@ -42,11 +41,11 @@ static void lower_array_decl(IRLowerCtx* ctx, Node* stmt) {
             return;
         }
         elem_t = IR_TYPE_I8_T;
-        arr_t = ir_type_array(IR_TYPE_I8_T, (int)total_bytes64);
+        arr_t = ir_type_array(ctx->builder->arena, IR_TYPE_I8_T, (int)total_bytes64);
     } else {
         elem_t = ir_type_from_datatype(m, elem_dt);
         if (!elem_t || elem_t->kind == IR_TYPE_VOID) elem_t = IR_TYPE_I64_T;
-        arr_t = ir_type_array(elem_t, total_count);
+        arr_t = ir_type_array(ctx->builder->arena, elem_t, total_count);
     }
 
     if (!arr_t) {
@@ -59,7 +58,6 @@ static void lower_array_decl(IRLowerCtx* ctx, Node* stmt) {
             ir_lower_report_error(ctx, stmt, "وحدة IR غير متاحة لتعريف مصفوفة ساكنة.");
             return;
         }
-        ir_module_set_current(m);
 
         char* gname = ir_lower_make_static_label(ctx, stmt->data.array_decl.name);
         if (!gname) return;
@@ -135,13 +133,13 @@ static void lower_array_decl(IRLowerCtx* ctx, Node* stmt) {
         return;
     }
 
-    IRType* arr_ptr_t = ir_type_ptr(arr_t);
-    IRType* elem_ptr_t = ir_type_ptr(elem_t);
-    IRValue* arr_ptr = ir_value_reg(ptr_reg, arr_ptr_t);
+    IRType* arr_ptr_t = ir_type_ptr(ctx->builder->arena, arr_t);
+    IRType* elem_ptr_t = ir_type_ptr(ctx->builder->arena, elem_t);
+    IRValue* arr_ptr = ir_value_reg(ctx->builder->arena, ptr_reg, arr_ptr_t);
 
     // base: cast ptr(array) -> ptr(elem)
     int base_reg = ir_builder_emit_cast(ctx->builder, arr_ptr, elem_ptr_t);
-    IRValue* base_ptr = ir_value_reg(base_reg, elem_ptr_t);
+    IRValue* base_ptr = ir_value_reg(ctx->builder->arena, base_reg, elem_ptr_t);
 
     int i = 0;
     Node* v = stmt->data.array_decl.init_values;
@@ -149,14 +147,14 @@ static void lower_array_decl(IRLowerCtx* ctx, Node* stmt) {
         // اربط موقع التوليد بموقع عنصر التهيئة.
         ir_lower_set_loc(ctx->builder, v);
 
-        IRValue* idx = ir_value_const_int((int64_t)i, IR_TYPE_I64_T);
+        IRValue* idx = ir_value_const_int(ctx->builder->arena, (int64_t)i, IR_TYPE_I64_T);
         int ep = ir_builder_emit_ptr_offset(ctx->builder, elem_ptr_t, base_ptr, idx);
-        IRValue* elem_ptr = ir_value_reg(ep, elem_ptr_t);
+        IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, elem_ptr_t);
 
         IRValue* val = lower_expr(ctx, v);
         if (val && val->type && !ir_types_equal(val->type, elem_t)) {
             int cv = ir_builder_emit_cast(ctx->builder, val, elem_t);
-            val = ir_value_reg(cv, elem_t);
+            val = ir_value_reg(ctx->builder->arena, cv, elem_t);
         }
 
         ir_builder_emit_store(ctx->builder, val, elem_ptr);
@@ -167,10 +165,10 @@ static void lower_array_decl(IRLowerCtx* ctx, Node* stmt) {
     // تعبئة الباقي بأصفار
     for (; i < total_count; i++) {
         ir_lower_set_loc(ctx->builder, stmt);
-        IRValue* idx = ir_value_const_int((int64_t)i, IR_TYPE_I64_T);
+        IRValue* idx = ir_value_const_int(ctx->builder->arena, (int64_t)i, IR_TYPE_I64_T);
         int ep = ir_builder_emit_ptr_offset(ctx->builder, elem_ptr_t, base_ptr, idx);
-        IRValue* elem_ptr = ir_value_reg(ep, elem_ptr_t);
-        IRValue* z = ir_value_const_int(0, elem_t);
+        IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, elem_ptr_t);
+        IRValue* z = ir_value_const_int(ctx->builder->arena, 0, elem_t);
         ir_builder_emit_store(ctx->builder, z, elem_ptr);
     }
 }
@@ -179,14 +177,14 @@ static void lower_zero_aggregate_bytes(IRLowerCtx* ctx, Node* loc, IRValue* base
 {
     if (!ctx || !ctx->builder || !base_i8 || byte_count <= 0) return;
 
-    IRType* ptr_i8_t = ir_type_ptr(IR_TYPE_I8_T);
+    IRType* ptr_i8_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
     for (int i = 0; i < byte_count; i++) {
         ir_lower_set_loc(ctx->builder, loc);
-        IRValue* idx = ir_value_const_int((int64_t)i, IR_TYPE_I64_T);
+        IRValue* idx = ir_value_const_int(ctx->builder->arena, (int64_t)i, IR_TYPE_I64_T);
         int p = ir_builder_emit_ptr_offset(ctx->builder, ptr_i8_t, base_i8, idx);
         ir_builder_emit_store(ctx->builder,
-                              ir_value_const_int(0, IR_TYPE_I8_T),
-                              ir_value_reg(p, ptr_i8_t));
+                              ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I8_T),
+                              ir_value_reg(ctx->builder->arena, p, ptr_i8_t));
     }
 }
 
@@ -198,24 +196,23 @@ static void lower_struct_field_initializer(IRLowerCtx* ctx, Node* item, IRValue*
     if (!value) return;
 
     IRModule* m = ctx->builder->module;
-    if (m) ir_module_set_current(m);
 
-    IRType* ptr_i8_t = ir_type_ptr(IR_TYPE_I8_T);
-    IRValue* idx = ir_value_const_int((int64_t)item->data.struct_field_init.field_offset, IR_TYPE_I64_T);
+    IRType* ptr_i8_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
+    IRValue* idx = ir_value_const_int(ctx->builder->arena, (int64_t)item->data.struct_field_init.field_offset, IR_TYPE_I64_T);
     int byte_ptr_reg = ir_builder_emit_ptr_offset(ctx->builder, ptr_i8_t, base_i8, idx);
-    IRValue* byte_ptr = ir_value_reg(byte_ptr_reg, ptr_i8_t);
+    IRValue* byte_ptr = ir_value_reg(ctx->builder->arena, byte_ptr_reg, ptr_i8_t);
 
     IRType* field_t = ir_type_from_datatype(m, item->data.struct_field_init.field_type);
     if (!field_t || field_t->kind == IR_TYPE_VOID) field_t = IR_TYPE_I64_T;
-    IRType* field_ptr_t = ir_type_ptr(field_t);
+    IRType* field_ptr_t = ir_type_ptr(ctx->builder->arena, field_t);
     int field_ptr_reg = ir_builder_emit_cast(ctx->builder, byte_ptr, field_ptr_t);
-    IRValue* field_ptr = ir_value_reg(field_ptr_reg, field_ptr_t);
+    IRValue* field_ptr = ir_value_reg(ctx->builder->arena, field_ptr_reg, field_ptr_t);
 
     ir_lower_set_loc(ctx->builder, item);
     IRValue* rhs = lower_expr(ctx, value);
     if (rhs && rhs->type && !ir_types_equal(rhs->type, field_t)) {
         int cv = ir_builder_emit_cast(ctx->builder, rhs, field_t);
-        rhs = ir_value_reg(cv, field_t);
+        rhs = ir_value_reg(ctx->builder->arena, cv, field_t);
     }
 
     ir_builder_emit_store(ctx->builder, rhs, field_ptr);
@@ -239,7 +236,6 @@ static void lower_var_decl(IRLowerCtx* ctx, Node* stmt) {
             ir_lower_report_error(ctx, stmt, "وحدة IR غير متاحة لتعريف متغير ساكن.");
             return;
         }
-        ir_module_set_current(m);
 
         char* gname = ir_lower_make_static_label(ctx, stmt->data.var_decl.name);
         if (!gname) return;
@@ -251,7 +247,7 @@ static void lower_var_decl(IRLowerCtx* ctx, Node* stmt) {
                 return;
             }
 
-            IRType* bytes_t = ir_type_array(IR_TYPE_I8_T, n);
+            IRType* bytes_t = ir_type_array(ctx->builder->arena, IR_TYPE_I8_T, n);
             IRGlobal* g = ir_builder_create_global(ctx->builder, gname, bytes_t,
                                                    stmt->data.var_decl.is_const ? 1 : 0);
             if (!g) {
@@ -269,7 +265,7 @@ static void lower_var_decl(IRLowerCtx* ctx, Node* stmt) {
         if (stmt->data.var_decl.expression) {
             init = ir_lower_global_init_value(ctx->builder, stmt->data.var_decl.expression, value_type);
         } else {
-            init = ir_value_const_int(0, value_type);
+            init = ir_value_const_int(ctx->builder->arena, 0, value_type);
         }
 
         IRGlobal* g = ir_builder_create_global_init(ctx->builder, gname, value_type, init,
@@ -295,16 +291,16 @@ static void lower_var_decl(IRLowerCtx* ctx, Node* stmt) {
             return;
         }
 
-        IRType* bytes_t = ir_type_array(IR_TYPE_I8_T, n);
+        IRType* bytes_t = ir_type_array(ctx->builder->arena, IR_TYPE_I8_T, n);
         int ptr_reg = ir_builder_emit_alloca(ctx->builder, bytes_t);
         ir_lower_tag_last_inst(ctx->builder, IR_OP_ALLOCA, ptr_reg, stmt->data.var_decl.name);
         ir_lower_bind_local(ctx, stmt->data.var_decl.name, ptr_reg, bytes_t, TYPE_INT, NULL, 0);
 
         if (stmt->data.var_decl.struct_init_values) {
-            IRType* ptr_i8_t = ir_type_ptr(IR_TYPE_I8_T);
-            IRValue* storage_ptr = ir_value_reg(ptr_reg, ir_type_ptr(bytes_t));
+            IRType* ptr_i8_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
+            IRValue* storage_ptr = ir_value_reg(ctx->builder->arena, ptr_reg, ir_type_ptr(ctx->builder->arena, bytes_t));
             int base_reg = ir_builder_emit_cast(ctx->builder, storage_ptr, ptr_i8_t);
-            IRValue* base_i8 = ir_value_reg(base_reg, ptr_i8_t);
+            IRValue* base_i8 = ir_value_reg(ctx->builder->arena, base_reg, ptr_i8_t);
 
             lower_zero_aggregate_bytes(ctx, stmt, base_i8, n);
             for (Node* item = stmt->data.var_decl.struct_init_values; item; item = item->next) {
@@ -336,7 +332,7 @@ static void lower_var_decl(IRLowerCtx* ctx, Node* stmt) {
         init = lower_expr(ctx, stmt->data.var_decl.expression);
     } else {
         // Fallback (should not happen for locals; parser enforces initializer).
-        init = ir_value_const_int(0, value_type);
+        init = ir_value_const_int(ctx->builder->arena, 0, value_type);
     }
 
     if (init && init->type && value_type && !ir_types_equal(init->type, value_type)) {
@@ -344,8 +340,8 @@ static void lower_var_decl(IRLowerCtx* ctx, Node* stmt) {
     }
 
     // خزن <init>, %ptr
-    IRType* ptr_type = ir_type_ptr(value_type ? value_type : IR_TYPE_I64_T);
-    IRValue* ptr = ir_value_reg(ptr_reg, ptr_type);
+    IRType* ptr_type = ir_type_ptr(ctx->builder->arena, value_type ? value_type : IR_TYPE_I64_T);
+    IRValue* ptr = ir_value_reg(ctx->builder->arena, ptr_reg, ptr_type);
 
     // نعيد الموقع إلى تصريح المتغير كي تُنسب عملية الخزن لسطر التصريح.
     ir_lower_set_loc(ctx->builder, stmt);
@@ -383,15 +379,15 @@ static void lower_array_assign(IRLowerCtx* ctx, Node* stmt) {
         }
 
         IRType* elem_t = b->value_type->data.array.element ? b->value_type->data.array.element : IR_TYPE_I64_T;
-        IRType* elem_ptr_t = ir_type_ptr(elem_t);
+        IRType* elem_ptr_t = ir_type_ptr(ctx->builder->arena, elem_t);
 
         IRValue* base_ptr = NULL;
         if (b->is_static_storage) {
-            base_ptr = ir_value_global(storage_name, elem_t);
+            base_ptr = ir_value_global(ctx->builder->arena, storage_name, elem_t);
         } else {
-            IRValue* arr_ptr = ir_value_reg(b->ptr_reg, ir_type_ptr(b->value_type));
+            IRValue* arr_ptr = ir_value_reg(ctx->builder->arena, b->ptr_reg, ir_type_ptr(ctx->builder->arena, b->value_type));
             int base_reg = ir_builder_emit_cast(ctx->builder, arr_ptr, elem_ptr_t);
-            base_ptr = ir_value_reg(base_reg, elem_ptr_t);
+            base_ptr = ir_value_reg(ctx->builder->arena, base_reg, elem_ptr_t);
         }
 
         if (!base_ptr) {
@@ -409,12 +405,12 @@ static void lower_array_assign(IRLowerCtx* ctx, Node* stmt) {
                                                       b->array_dims,
                                                       b->array_rank);
         int ep = ir_builder_emit_ptr_offset(ctx->builder, elem_ptr_t, base_ptr, linear);
-        IRValue* elem_ptr = ir_value_reg(ep, elem_ptr_t);
+        IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, elem_ptr_t);
 
         IRValue* val = lower_expr(ctx, stmt->data.array_op.value);
         if (val && val->type && !ir_types_equal(val->type, elem_t)) {
             int cv = ir_builder_emit_cast(ctx->builder, val, elem_t);
-            val = ir_value_reg(cv, elem_t);
+            val = ir_value_reg(ctx->builder->arena, cv, elem_t);
         }
 
         ir_builder_emit_store(ctx->builder, val, elem_ptr);
@@ -454,8 +450,8 @@ static void lower_array_assign(IRLowerCtx* ctx, Node* stmt) {
     }
 
     IRType* elem_t = g->type->data.array.element ? g->type->data.array.element : IR_TYPE_I64_T;
-    IRType* elem_ptr_t = ir_type_ptr(elem_t);
-    IRValue* base_ptr = ir_value_global(name, elem_t);
+    IRType* elem_ptr_t = ir_type_ptr(ctx->builder->arena, elem_t);
+    IRValue* base_ptr = ir_value_global(ctx->builder->arena, name, elem_t);
 
     IRValue* linear = ir_lower_build_linear_index(ctx, stmt,
                                                   stmt->data.array_op.indices,
@@ -463,12 +459,12 @@ static void lower_array_assign(IRLowerCtx* ctx, Node* stmt) {
                                                   dims,
                                                   rank);
     int ep = ir_builder_emit_ptr_offset(ctx->builder, elem_ptr_t, base_ptr, linear);
-    IRValue* elem_ptr = ir_value_reg(ep, elem_ptr_t);
+    IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, elem_ptr_t);
 
     IRValue* val = lower_expr(ctx, stmt->data.array_op.value);
     if (val && val->type && !ir_types_equal(val->type, elem_t)) {
         int cv = ir_builder_emit_cast(ctx->builder, val, elem_t);
-        val = ir_value_reg(cv, elem_t);
+        val = ir_value_reg(ctx->builder->arena, cv, elem_t);
     }
 
     ir_builder_emit_store(ctx->builder, val, elem_ptr);
@@ -499,13 +495,12 @@ static void lower_member_assign(IRLowerCtx* ctx, Node* stmt) {
     }
 
     IRModule* m = ctx->builder->module;
-    if (m) ir_module_set_current(m);
 
-    IRType* ptr_i8_t = ir_type_ptr(IR_TYPE_I8_T);
+    IRType* ptr_i8_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
     IRValue* base_ptr = NULL;
 
     if (target->data.member_access.root_is_global) {
-        base_ptr = ir_value_global(target->data.member_access.root_var, IR_TYPE_I8_T);
+        base_ptr = ir_value_global(ctx->builder->arena, target->data.member_access.root_var, IR_TYPE_I8_T);
     } else {
         IRLowerBinding* b = find_local(ctx, target->data.member_access.root_var);
         if (!b || !b->value_type) {
@@ -514,28 +509,28 @@ static void lower_member_assign(IRLowerCtx* ctx, Node* stmt) {
             return;
         }
         if (b->is_static_storage) {
-            base_ptr = ir_value_global(ir_lower_binding_storage_name(b), IR_TYPE_I8_T);
+            base_ptr = ir_value_global(ctx->builder->arena, ir_lower_binding_storage_name(b), IR_TYPE_I8_T);
         } else {
-            IRValue* arr_ptr = ir_value_reg(b->ptr_reg, ir_type_ptr(b->value_type));
+            IRValue* arr_ptr = ir_value_reg(ctx->builder->arena, b->ptr_reg, ir_type_ptr(ctx->builder->arena, b->value_type));
             int c = ir_builder_emit_cast(ctx->builder, arr_ptr, ptr_i8_t);
-            base_ptr = ir_value_reg(c, ptr_i8_t);
+            base_ptr = ir_value_reg(ctx->builder->arena, c, ptr_i8_t);
         }
     }
 
-    IRValue* idx = ir_value_const_int((int64_t)target->data.member_access.member_offset, IR_TYPE_I64_T);
+    IRValue* idx = ir_value_const_int(ctx->builder->arena, (int64_t)target->data.member_access.member_offset, IR_TYPE_I64_T);
     int ep = ir_builder_emit_ptr_offset(ctx->builder, ptr_i8_t, base_ptr, idx);
-    IRValue* byte_ptr = ir_value_reg(ep, ptr_i8_t);
+    IRValue* byte_ptr = ir_value_reg(ctx->builder->arena, ep, ptr_i8_t);
 
     IRType* field_val_t = ir_type_from_datatype(m, target->data.member_access.member_type);
     if (!field_val_t || field_val_t->kind == IR_TYPE_VOID) field_val_t = IR_TYPE_I64_T;
-    IRType* field_ptr_t = ir_type_ptr(field_val_t);
+    IRType* field_ptr_t = ir_type_ptr(ctx->builder->arena, field_val_t);
     int fp = ir_builder_emit_cast(ctx->builder, byte_ptr, field_ptr_t);
-    IRValue* field_ptr = ir_value_reg(fp, field_ptr_t);
+    IRValue* field_ptr = ir_value_reg(ctx->builder->arena, fp, field_ptr_t);
 
     IRValue* rhs = lower_expr(ctx, value);
     if (rhs && rhs->type && !ir_types_equal(rhs->type, field_val_t)) {
         int cv = ir_builder_emit_cast(ctx->builder, rhs, field_val_t);
-        rhs = ir_value_reg(cv, field_val_t);
+        rhs = ir_value_reg(ctx->builder->arena, cv, field_val_t);
     }
 
     ir_builder_emit_store(ctx->builder, rhs, field_ptr);
@@ -554,7 +549,7 @@ static void lower_deref_assign(IRLowerCtx* ctx, Node* stmt) {
     IRValue* p0 = lower_expr(ctx, target->data.unary_op.operand);
     IRType* value_t = ir_type_from_datatype(ctx->builder ? ctx->builder->module : NULL, target->inferred_type);
     if (!value_t || value_t->kind == IR_TYPE_VOID) value_t = IR_TYPE_I64_T;
-    IRType* ptr_t = ir_type_ptr(value_t);
+    IRType* ptr_t = ir_type_ptr(ctx->builder->arena, value_t);
     IRValue* ptr = cast_to(ctx, p0, ptr_t);
     ir_lower_emit_debug_null_check(ctx, target, ptr);
 
@@ -588,10 +583,10 @@ static void lower_assign(IRLowerCtx* ctx, Node* stmt) {
         (void)value_type; // reserved for future casts/type checks
         IRValue* ptr = NULL;
         if (b->is_static_storage) {
-            ptr = ir_value_global(storage_name, value_type);
+            ptr = ir_value_global(ctx->builder->arena, storage_name, value_type);
         } else {
-            IRType* ptr_type = ir_type_ptr(value_type ? value_type : IR_TYPE_I64_T);
-            ptr = ir_value_reg(b->ptr_reg, ptr_type);
+            IRType* ptr_type = ir_type_ptr(ctx->builder->arena, value_type ? value_type : IR_TYPE_I64_T);
+            ptr = ir_value_reg(ctx->builder->arena, b->ptr_reg, ptr_type);
         }
         ir_lower_set_loc(ctx->builder, stmt);
         ir_builder_emit_store(ctx->builder, rhs, ptr);
@@ -611,7 +606,7 @@ static void lower_assign(IRLowerCtx* ctx, Node* stmt) {
             rhs = cast_to(ctx, rhs, g->type);
         }
 
-        IRValue* gptr = ir_value_global(name, g->type);
+        IRValue* gptr = ir_value_global(ctx->builder->arena, name, g->type);
         ir_lower_set_loc(ctx->builder, stmt);
         ir_builder_emit_store(ctx->builder, rhs, gptr);
         ir_lower_tag_last_inst(ctx->builder, IR_OP_STORE, -1, name);
@@ -658,50 +653,48 @@ static void lower_print_char_packed(IRLowerCtx* ctx, Node* stmt, IRValue* ch, co
     if (!ctx || !ctx->builder || !ch || !fmt) return;
 
     IRBuilder* b = ctx->builder;
-    IRModule* m = b->module;
-    if (m) ir_module_set_current(m);
 
-    IRType* buf_arr_t = ir_type_array(IR_TYPE_I8_T, 5);
+    IRType* buf_arr_t = ir_type_array(ctx->builder->arena, IR_TYPE_I8_T, 5);
     int buf_ptr_reg = ir_builder_emit_alloca(b, buf_arr_t);
-    IRValue* buf_ptr = ir_value_reg(buf_ptr_reg, ir_type_ptr(buf_arr_t));
+    IRValue* buf_ptr = ir_value_reg(ctx->builder->arena, buf_ptr_reg, ir_type_ptr(ctx->builder->arena, buf_arr_t));
 
-    IRType* i8_ptr_t = ir_type_ptr(IR_TYPE_I8_T);
+    IRType* i8_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I8_T);
     int base_reg = ir_builder_emit_cast(b, buf_ptr, i8_ptr_t);
-    IRValue* base_ptr = ir_value_reg(base_reg, i8_ptr_t);
+    IRValue* base_ptr = ir_value_reg(ctx->builder->arena, base_reg, i8_ptr_t);
 
     // i64 معبأ = bytes + len*2^32
     int pr = ir_builder_emit_cast(b, ch, IR_TYPE_I64_T);
-    IRValue* packed = ir_value_reg(pr, IR_TYPE_I64_T);
+    IRValue* packed = ir_value_reg(ctx->builder->arena, pr, IR_TYPE_I64_T);
 
-    IRValue* c_2p32 = ir_value_const_int(4294967296LL, IR_TYPE_I64_T);
+    IRValue* c_2p32 = ir_value_const_int(ctx->builder->arena, 4294967296LL, IR_TYPE_I64_T);
     int len_r = ir_builder_emit_div(b, IR_TYPE_I64_T, packed, c_2p32);
-    IRValue* len = ir_value_reg(len_r, IR_TYPE_I64_T);
+    IRValue* len = ir_value_reg(ctx->builder->arena, len_r, IR_TYPE_I64_T);
 
     int bytes_r = ir_builder_emit_mod(b, IR_TYPE_I64_T, packed, c_2p32);
-    IRValue* bytes = ir_value_reg(bytes_r, IR_TYPE_I64_T);
+    IRValue* bytes = ir_value_reg(ctx->builder->arena, bytes_r, IR_TYPE_I64_T);
 
-    IRValue* c256 = ir_value_const_int(256, IR_TYPE_I64_T);
+    IRValue* c256 = ir_value_const_int(ctx->builder->arena, 256, IR_TYPE_I64_T);
 
     int b0_r = ir_builder_emit_mod(b, IR_TYPE_I64_T, bytes, c256);
-    IRValue* b0 = ir_value_reg(b0_r, IR_TYPE_I64_T);
+    IRValue* b0 = ir_value_reg(ctx->builder->arena, b0_r, IR_TYPE_I64_T);
     int t1_r = ir_builder_emit_div(b, IR_TYPE_I64_T, bytes, c256);
-    IRValue* t1 = ir_value_reg(t1_r, IR_TYPE_I64_T);
+    IRValue* t1 = ir_value_reg(ctx->builder->arena, t1_r, IR_TYPE_I64_T);
     int b1_r = ir_builder_emit_mod(b, IR_TYPE_I64_T, t1, c256);
-    IRValue* b1 = ir_value_reg(b1_r, IR_TYPE_I64_T);
+    IRValue* b1 = ir_value_reg(ctx->builder->arena, b1_r, IR_TYPE_I64_T);
     int t2_r = ir_builder_emit_div(b, IR_TYPE_I64_T, t1, c256);
-    IRValue* t2 = ir_value_reg(t2_r, IR_TYPE_I64_T);
+    IRValue* t2 = ir_value_reg(ctx->builder->arena, t2_r, IR_TYPE_I64_T);
     int b2_r = ir_builder_emit_mod(b, IR_TYPE_I64_T, t2, c256);
-    IRValue* b2 = ir_value_reg(b2_r, IR_TYPE_I64_T);
+    IRValue* b2 = ir_value_reg(ctx->builder->arena, b2_r, IR_TYPE_I64_T);
     int t3_r = ir_builder_emit_div(b, IR_TYPE_I64_T, t2, c256);
-    IRValue* t3 = ir_value_reg(t3_r, IR_TYPE_I64_T);
+    IRValue* t3 = ir_value_reg(ctx->builder->arena, t3_r, IR_TYPE_I64_T);
     int b3_r = ir_builder_emit_mod(b, IR_TYPE_I64_T, t3, c256);
-    IRValue* b3 = ir_value_reg(b3_r, IR_TYPE_I64_T);
+    IRValue* b3 = ir_value_reg(ctx->builder->arena, b3_r, IR_TYPE_I64_T);
 
-    IRValue* idx0 = ir_value_const_int(0, IR_TYPE_I64_T);
-    IRValue* idx1 = ir_value_const_int(1, IR_TYPE_I64_T);
-    IRValue* idx2 = ir_value_const_int(2, IR_TYPE_I64_T);
-    IRValue* idx3 = ir_value_const_int(3, IR_TYPE_I64_T);
-    IRValue* idx4 = ir_value_const_int(4, IR_TYPE_I64_T);
+    IRValue* idx0 = ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
+    IRValue* idx1 = ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T);
+    IRValue* idx2 = ir_value_const_int(ctx->builder->arena, 2, IR_TYPE_I64_T);
+    IRValue* idx3 = ir_value_const_int(ctx->builder->arena, 3, IR_TYPE_I64_T);
+    IRValue* idx4 = ir_value_const_int(ctx->builder->arena, 4, IR_TYPE_I64_T);
 
     int p0r = ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx0);
     int p1r = ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx1);
@@ -709,15 +702,15 @@ static void lower_print_char_packed(IRLowerCtx* ctx, Node* stmt, IRValue* ch, co
     int p3r = ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx3);
     int p4r = ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, idx4);
 
-    ir_builder_emit_store(b, cast_to(ctx, b0, IR_TYPE_I8_T), ir_value_reg(p0r, i8_ptr_t));
-    ir_builder_emit_store(b, cast_to(ctx, b1, IR_TYPE_I8_T), ir_value_reg(p1r, i8_ptr_t));
-    ir_builder_emit_store(b, cast_to(ctx, b2, IR_TYPE_I8_T), ir_value_reg(p2r, i8_ptr_t));
-    ir_builder_emit_store(b, cast_to(ctx, b3, IR_TYPE_I8_T), ir_value_reg(p3r, i8_ptr_t));
-    ir_builder_emit_store(b, ir_value_const_int(0, IR_TYPE_I8_T), ir_value_reg(p4r, i8_ptr_t));
+    ir_builder_emit_store(b, cast_to(ctx, b0, IR_TYPE_I8_T), ir_value_reg(ctx->builder->arena, p0r, i8_ptr_t));
+    ir_builder_emit_store(b, cast_to(ctx, b1, IR_TYPE_I8_T), ir_value_reg(ctx->builder->arena, p1r, i8_ptr_t));
+    ir_builder_emit_store(b, cast_to(ctx, b2, IR_TYPE_I8_T), ir_value_reg(ctx->builder->arena, p2r, i8_ptr_t));
+    ir_builder_emit_store(b, cast_to(ctx, b3, IR_TYPE_I8_T), ir_value_reg(ctx->builder->arena, p3r, i8_ptr_t));
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I8_T), ir_value_reg(ctx->builder->arena, p4r, i8_ptr_t));
 
     // كتابة NUL في buf[len]
     int pend = ir_builder_emit_ptr_offset(b, i8_ptr_t, base_ptr, len);
-    ir_builder_emit_store(b, ir_value_const_int(0, IR_TYPE_I8_T), ir_value_reg(pend, i8_ptr_t));
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I8_T), ir_value_reg(ctx->builder->arena, pend, i8_ptr_t));
 
     lower_printf_cstr(ctx, stmt, fmt, base_ptr);
 }
@@ -727,21 +720,19 @@ static void lower_print_baa_string(IRLowerCtx* ctx, Node* stmt, IRValue* str_ptr
     if (!ctx || !ctx->builder || !str_ptr) return;
 
     IRBuilder* b = ctx->builder;
-    IRModule* m = b->module;
-    if (m) ir_module_set_current(m);
 
-    IRType* char_ptr_t = ir_type_ptr(IR_TYPE_CHAR_T);
+    IRType* char_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_CHAR_T);
     IRValue* base = str_ptr;
     if (!base->type || base->type->kind != IR_TYPE_PTR) {
         int cr = ir_builder_emit_cast(b, base, char_ptr_t);
-        base = ir_value_reg(cr, char_ptr_t);
+        base = ir_value_reg(ctx->builder->arena, cr, char_ptr_t);
     }
 
     // idx_ptr = alloca i64
     int idx_ptr_reg = ir_builder_emit_alloca(b, IR_TYPE_I64_T);
-    IRType* idx_ptr_t = ir_type_ptr(IR_TYPE_I64_T);
-    IRValue* idx_ptr = ir_value_reg(idx_ptr_reg, idx_ptr_t);
-    ir_builder_emit_store(b, ir_value_const_int(0, IR_TYPE_I64_T), idx_ptr);
+    IRType* idx_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I64_T);
+    IRValue* idx_ptr = ir_value_reg(ctx->builder->arena, idx_ptr_reg, idx_ptr_t);
+    ir_builder_emit_store(b, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T), idx_ptr);
 
     IRBlock* head = cf_create_block(ctx, "اطبع_نص_حلقة");
     IRBlock* body = cf_create_block(ctx, "اطبع_نص_جسم");
@@ -753,17 +744,17 @@ static void lower_print_baa_string(IRLowerCtx* ctx, Node* stmt, IRValue* str_ptr
     // head
     ir_builder_set_insert_point(b, head);
     int idx_r = ir_builder_emit_load(b, IR_TYPE_I64_T, idx_ptr);
-    IRValue* idx = ir_value_reg(idx_r, IR_TYPE_I64_T);
+    IRValue* idx = ir_value_reg(ctx->builder->arena, idx_r, IR_TYPE_I64_T);
 
     int ep = ir_builder_emit_ptr_offset(b, char_ptr_t, base, idx);
-    IRValue* elem_ptr = ir_value_reg(ep, char_ptr_t);
+    IRValue* elem_ptr = ir_value_reg(ctx->builder->arena, ep, char_ptr_t);
     int ch_r = ir_builder_emit_load(b, IR_TYPE_CHAR_T, elem_ptr);
-    IRValue* ch = ir_value_reg(ch_r, IR_TYPE_CHAR_T);
+    IRValue* ch = ir_value_reg(ctx->builder->arena, ch_r, IR_TYPE_CHAR_T);
 
     int chi_r = ir_builder_emit_cast(b, ch, IR_TYPE_I64_T);
-    IRValue* chi = ir_value_reg(chi_r, IR_TYPE_I64_T);
-    int is_end_r = ir_builder_emit_cmp_eq(b, chi, ir_value_const_int(0, IR_TYPE_I64_T));
-    IRValue* is_end = ir_value_reg(is_end_r, IR_TYPE_I1_T);
+    IRValue* chi = ir_value_reg(ctx->builder->arena, chi_r, IR_TYPE_I64_T);
+    int is_end_r = ir_builder_emit_cmp_eq(b, chi, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T));
+    IRValue* is_end = ir_value_reg(ctx->builder->arena, is_end_r, IR_TYPE_I1_T);
 
     if (!ir_builder_is_block_terminated(b))
         ir_builder_emit_br_cond(b, is_end, done, body);
@@ -772,8 +763,8 @@ static void lower_print_baa_string(IRLowerCtx* ctx, Node* stmt, IRValue* str_ptr
     ir_builder_set_insert_point(b, body);
     lower_print_char_packed(ctx, stmt, ch, "%s");
 
-    int inc_r = ir_builder_emit_add(b, IR_TYPE_I64_T, idx, ir_value_const_int(1, IR_TYPE_I64_T));
-    IRValue* inc = ir_value_reg(inc_r, IR_TYPE_I64_T);
+    int inc_r = ir_builder_emit_add(b, IR_TYPE_I64_T, idx, ir_value_const_int(ctx->builder->arena, 1, IR_TYPE_I64_T));
+    IRValue* inc = ir_value_reg(ctx->builder->arena, inc_r, IR_TYPE_I64_T);
     ir_builder_emit_store(b, inc, idx_ptr);
     if (!ir_builder_is_block_terminated(b))
         ir_builder_emit_br(b, head);
@@ -802,7 +793,7 @@ static void lower_print(IRLowerCtx* ctx, Node* stmt) {
     // عشري
     if (stmt->data.print_stmt.expression && stmt->data.print_stmt.expression->inferred_type == TYPE_FLOAT)
     {
-        IRValue* vf = value ? cast_to(ctx, value, IR_TYPE_F64_T) : ir_value_const_int(0, IR_TYPE_F64_T);
+        IRValue* vf = value ? cast_to(ctx, value, IR_TYPE_F64_T) : ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_F64_T);
         lower_printf_cstr(ctx, stmt, "%g\n", vf);
         return;
     }
@@ -812,12 +803,12 @@ static void lower_print(IRLowerCtx* ctx, Node* stmt) {
     DataType dt = (stmt->data.print_stmt.expression) ? stmt->data.print_stmt.expression->inferred_type : TYPE_INT;
     if (dt == TYPE_U8 || dt == TYPE_U16 || dt == TYPE_U32 || dt == TYPE_U64)
     {
-        IRValue* vu = value ? cast_to(ctx, value, IR_TYPE_U64_T) : ir_value_const_int(0, IR_TYPE_U64_T);
+        IRValue* vu = value ? cast_to(ctx, value, IR_TYPE_U64_T) : ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_U64_T);
         lower_printf_cstr(ctx, stmt, "%llu\n", vu);
         return;
     }
 
-    IRValue* v64 = value ? ensure_i64(ctx, value) : ir_value_const_int(0, IR_TYPE_I64_T);
+    IRValue* v64 = value ? ensure_i64(ctx, value) : ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T);
     lower_printf_cstr(ctx, stmt, "%lld\n", v64);
 }
 
@@ -832,8 +823,8 @@ static void lower_read(IRLowerCtx* ctx, Node* stmt) {
     }
 
     IRType* vt = (b->value_type) ? b->value_type : IR_TYPE_I64_T;
-    IRType* ptr_type = ir_type_ptr(vt);
-    IRValue* ptr = ir_value_reg(b->ptr_reg, ptr_type);
+    IRType* ptr_type = ir_type_ptr(ctx->builder->arena, vt);
+    IRValue* ptr = ir_value_reg(ctx->builder->arena, b->ptr_reg, ptr_type);
 
     // i64/u64 يمكن القراءة مباشرة إلى المتغير. للأحجام الأصغر نقرأ إلى مؤقت i64 ثم نقتطع.
     if (vt && (vt->kind == IR_TYPE_I64 || vt->kind == IR_TYPE_U64))
@@ -847,16 +838,16 @@ static void lower_read(IRLowerCtx* ctx, Node* stmt) {
 
     // tmp_ptr = alloca i64
     int tmp_ptr_reg = ir_builder_emit_alloca(ctx->builder, IR_TYPE_I64_T);
-    IRType* tmp_ptr_t = ir_type_ptr(IR_TYPE_I64_T);
-    IRValue* tmp_ptr = ir_value_reg(tmp_ptr_reg, tmp_ptr_t);
-    ir_builder_emit_store(ctx->builder, ir_value_const_int(0, IR_TYPE_I64_T), tmp_ptr);
+    IRType* tmp_ptr_t = ir_type_ptr(ctx->builder->arena, IR_TYPE_I64_T);
+    IRValue* tmp_ptr = ir_value_reg(ctx->builder->arena, tmp_ptr_reg, tmp_ptr_t);
+    ir_builder_emit_store(ctx->builder, ir_value_const_int(ctx->builder->arena, 0, IR_TYPE_I64_T), tmp_ptr);
 
     IRValue* fmt_val = ir_builder_const_string(ctx->builder, "%lld");
     IRValue* args[2] = { fmt_val, tmp_ptr };
     ir_builder_emit_call_void(ctx->builder, "اقرأ", args, 2);
 
     int tmp_r = ir_builder_emit_load(ctx->builder, IR_TYPE_I64_T, tmp_ptr);
-    IRValue* tmp_v = ir_value_reg(tmp_r, IR_TYPE_I64_T);
+    IRValue* tmp_v = ir_value_reg(ctx->builder->arena, tmp_r, IR_TYPE_I64_T);
     IRValue* cv = cast_to(ctx, tmp_v, vt);
     ir_builder_emit_store(ctx->builder, cv, ptr);
 }
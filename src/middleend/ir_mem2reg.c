@@ -10,11 +10,14 @@
  *
  * قيود السلامة (الصحة أولاً):
  * - نُرقّي فقط `alloca` الذي لا يهرب مؤشّره:
- *   - لا يُمرَّر المؤشر إلى `نداء` ولا يُستخدم داخل `فاي`.
- *   - لا يُخزَّن المؤشر نفسه كقيمة.
+ *   - لا يُستخدم داخل `فاي` ولا يُخزَّن المؤشر نفسه كقيمة.
+ *   - لا يُمرَّر إلى `نداء` إلا في وسائط لا يحتفظ بها (ملخصات ir_alias.h).
  * - كتلة تعريف المؤشر (الكتلة التي تحتوي `حجز`) تسيطر على كل الاستعمالات
  *   دون استثناء.
- * - نضمن أن كل `حمل` يرى `خزن` سابقاً على كل المسارات (تحليل must-def).
+ * - كل قراءة (`حمل` أو نداء يقرأ عبر المؤشر) يسبقها تعريف على كل المسارات
+ *   (تحليل must-def)؛ النداء الكاتب يكفيه ألا يصله أي تعريف إطلاقاً (may-def).
+ *   لا نخترع قيمة للقراءة غير المهيأة، وعقد `فاي` توضع فقط حيث المتغير معرّف.
+ * - المتغير الممرَّر إلى نداء يُرقّى جزئياً: يبقى `حجز` وتُزامَن قيمته حول النداء.
  *
  * ملاحظة ملكية الذاكرة:
  * - لا نُعيد استعمال نفس مؤشر IRValue بين تعليمات مختلفة لتجنب التحرير المزدوج.
@@ -22,7 +25,9 @@
  */
 
 #include "ir_mem2reg.h"
+#include "ir_alias.h"
 #include "ir_analysis.h"
+#include "ir_analysis_manager.h"
 #include "ir_mutate.h"
 
 #include <stdlib.h>
@@ -32,9 +37,13 @@
 // دمج IRPass
 // -----------------------------------------------------------------------------
 
+static bool ir_mem2reg_run_func(IRFunc* func);
+
 IRPass IR_PASS_MEM2REG = {
     .name = "ترقية_الذاكرة_إلى_سجلات",
-    .run = ir_mem2reg_run
+    .run = ir_mem2reg_run,
+    .run_func = ir_mem2reg_run_func,
+    .preserves = IR_ANALYSIS_CFG_ALL
 };
 
 // -----------------------------------------------------------------------------
@@ -50,7 +59,11 @@ typedef struct {
     // اسم المتغير المرتبط بهذا alloca (للتتبع بعد Mem2Reg)
     const char* dbg_name;
 
+    // مُمرَّر إلى نداء لا يحتفظ بالمؤشر: يبقى الحجز ويُزامَن حول النداء.
+    int partial;
+
     IRInst** phi_in_block; // [max_block_id]
+    unsigned char* defined_in; // [max_block_id] معرّف على كل مسار إلى بداية الكتلة
 
     IRValue** stack;
     int stack_size;
@@ -68,35 +81,35 @@ static IRType* ir_alloca_pointee_type(IRInst* alloca_inst) {
     return alloca_inst->type->data.pointee;
 }
 
-static IRValue* ir_value_clone_with_type(IRValue* v, IRType* override_type) {
+static IRValue* ir_value_clone_with_type(IRArena* arena, IRValue* v, IRType* override_type) {
     if (!v) return NULL;
 
     IRType* t = override_type ? override_type : v->type;
 
     switch (v->kind) {
         case IR_VAL_CONST_INT:
-            return ir_value_const_int(v->data.const_int, t);
+            return ir_value_const_int(arena, v->data.const_int, t);
 
         case IR_VAL_CONST_STR:
-            return ir_value_const_str(v->data.const_str.data, v->data.const_str.id);
+            return ir_value_const_str(arena, v->data.const_str.data, v->data.const_str.id);
 
         case IR_VAL_BAA_STR:
-            return ir_value_baa_str(v->data.const_str.data, v->data.const_str.id);
+            return ir_value_baa_str(arena, v->data.const_str.data, v->data.const_str.id);
 
         case IR_VAL_REG:
-            return ir_value_reg(v->data.reg_num, t);
+            return ir_value_reg(arena, v->data.reg_num, t);
 
         case IR_VAL_GLOBAL:
             if (v->type && v->type->kind == IR_TYPE_PTR) {
-                return ir_value_global(v->data.global_name, v->type->data.pointee);
+                return ir_value_global(arena, v->data.global_name, v->type->data.pointee);
             }
-            return ir_value_global(v->data.global_name, v->type);
+            return ir_value_global(arena, v->data.global_name, v->type);
 
         case IR_VAL_FUNC:
-            return ir_value_func_ref(v->data.global_name, t);
+            return ir_value_func_ref(arena, v->data.global_name, t);
 
         case IR_VAL_BLOCK:
-            return ir_value_block(v->data.block);
+            return ir_value_block(arena, v->data.block);
 
         case IR_VAL_NONE:
         default:
@@ -166,6 +179,55 @@ static int ir_inst_has_ptr_reg_use(IRInst* inst, int ptr_reg) {
     return 0;
 }
 
+// نداءات مكتبة معروفة تقرأ/تكتب عبر وسيط مؤشر ولا تحتفظ به بعد العودة
+// (جدول ملخصات ir_alias.c). المتغير المُمرَّر إليها يُرقّى جزئياً: يبقى حجزه،
+// ويُخزَّن فيه قبل النداء ويُعاد تحميله بعده إن كان النداء يكتب.
+enum {
+    MEM2REG_CALL_NONE = 0,
+    MEM2REG_CALL_READS = 1,
+    MEM2REG_CALL_WRITES = 2,
+    MEM2REG_CALL_ESCAPES = 3
+};
+
+/** أثر نداء على المؤشر: لا استعمال، قراءة، كتابة، أو هروب (لا يمكن الترقية). */
+static int mem2reg_call_ptr_effect(IRInst* call, int ptr_reg) {
+    if (!call || call->op != IR_OP_CALL) return MEM2REG_CALL_NONE;
+    if (ir_value_is_reg_num(call->call_callee, ptr_reg)) return MEM2REG_CALL_ESCAPES;
+
+    int effect = MEM2REG_CALL_NONE;
+    for (int i = 0; i < call->call_arg_count; i++) {
+        if (!call->call_args || !ir_value_is_reg_num(call->call_args[i], ptr_reg)) continue;
+
+        int modref = ir_alias_call_arg_effect(call, i);
+        if (modref < 0) return MEM2REG_CALL_ESCAPES;
+        int e = (modref & IR_MODREF_MOD) ? MEM2REG_CALL_WRITES : MEM2REG_CALL_READS;
+        if (e > effect) effect = e;
+    }
+    return effect;
+}
+
+/**
+ * هل هذا الحمل/الخزن من مزامنة ترقية جزئية سابقة؟ خزن المزامنة يسبق النداء
+ * (ربما مع خزون متغيرات أخرى لنفس النداء)، وحملها يليه بنفس الطريقة.
+ */
+static int mem2reg_is_sync_access(IRInst* inst, int ptr_reg) {
+    if (!inst) return 0;
+
+    if (inst->op == IR_OP_STORE) {
+        IRInst* it = inst->next;
+        while (it && it->op == IR_OP_STORE) it = it->next;
+        return mem2reg_call_ptr_effect(it, ptr_reg) != MEM2REG_CALL_NONE;
+    }
+
+    if (inst->op == IR_OP_LOAD) {
+        IRInst* it = inst->prev;
+        while (it && it->op == IR_OP_LOAD) it = it->prev;
+        return mem2reg_call_ptr_effect(it, ptr_reg) == MEM2REG_CALL_WRITES;
+    }
+
+    return 0;
+}
+
 static int ir_inst_ptr_use_is_allowed(IRInst* inst, int ptr_reg) {
     if (!inst) return 0;
 
@@ -188,16 +250,7 @@ static int ir_inst_ptr_use_is_allowed(IRInst* inst, int ptr_reg) {
     }
 
     if (inst->op == IR_OP_CALL) {
-        if (ir_value_is_reg_num(inst->call_callee, ptr_reg)) {
-            return 0;
-        }
-        if (inst->call_args) {
-            for (int i = 0; i < inst->call_arg_count; i++) {
-                if (ir_value_is_reg_num(inst->call_args[i], ptr_reg)) {
-                    return 0;
-                }
-            }
-        }
+        return mem2reg_call_ptr_effect(inst, ptr_reg) != MEM2REG_CALL_ESCAPES;
     }
 
     if (inst->op == IR_OP_PHI) {
@@ -211,140 +264,8 @@ static int ir_inst_ptr_use_is_allowed(IRInst* inst, int ptr_reg) {
     return 1;
 }
 
-typedef struct {
-    unsigned char has_store;
-    unsigned char load_before_store;
-} Mem2RegInitInfo;
-
-static int ir_alloca_loads_are_definitely_initialized(IRFunc* func,
-                                                      IRBlock* alloca_block,
-                                                      int ptr_reg,
-                                                      IRType* pointee) {
-    if (!func || !alloca_block || ptr_reg < 0 || !pointee) return 0;
-
-    // ملاحظة: هذه الدالة تُستدعى من Mem2Reg بعد حساب dominators.
-    // لذلك نعتمد على أن CFG (pred/succ) حديث كي لا نمسح idom/DF هنا.
-
-    int max_id = -1;
-    for (IRBlock* b = func->blocks; b; b = b->next) {
-        if (b->id > max_id) max_id = b->id;
-    }
-    int nblocks = max_id + 1;
-    if (nblocks <= 0) return 0;
-
-    Mem2RegInitInfo* info = (Mem2RegInitInfo*)calloc((size_t)nblocks, sizeof(Mem2RegInitInfo));
-    unsigned char* inited_in = (unsigned char*)calloc((size_t)nblocks, 1);
-    unsigned char* inited_out = (unsigned char*)calloc((size_t)nblocks, 1);
-    if (!info || !inited_in || !inited_out) {
-        free(info);
-        free(inited_in);
-        free(inited_out);
-        return 0;
-    }
-
-    // مسح داخل الكتل لتحديد: هل يوجد خزن؟ وهل يوجد حمل قبل أول خزن؟
-    for (IRBlock* b = func->blocks; b; b = b->next) {
-        if (!b) continue;
-        if (b->id < 0 || b->id >= nblocks) continue;
-
-        unsigned char seen_store = 0;
-        for (IRInst* inst = b->first; inst; inst = inst->next) {
-            if (!inst) continue;
-
-            if (inst->op == IR_OP_STORE &&
-                inst->operand_count >= 2 &&
-                ir_value_is_reg_num(inst->operands[1], ptr_reg)) {
-
-                IRValue* stored_val = inst->operands[0];
-                if (!stored_val || !stored_val->type) {
-                    free(info); free(inited_in); free(inited_out);
-                    return 0;
-                }
-                if (!ir_types_equal(stored_val->type, pointee)) {
-                    free(info); free(inited_in); free(inited_out);
-                    return 0;
-                }
-
-                info[b->id].has_store = 1;
-                seen_store = 1;
-                continue;
-            }
-
-            if (inst->op == IR_OP_LOAD &&
-                inst->operand_count >= 1 &&
-                ir_value_is_reg_num(inst->operands[0], ptr_reg)) {
-
-                if (!seen_store) {
-                    info[b->id].load_before_store = 1;
-                }
-            }
-        }
-    }
-
-    // تحليل must-def: OUT = IN OR has_store, IN = AND(OUT[preds])
-    // entry يبدأ غير مهيأ.
-    for (int iter = 0; iter < 128; iter++) {
-        int changed = 0;
-
-        for (IRBlock* b = func->blocks; b; b = b->next) {
-            if (!b) continue;
-            if (b->id < 0 || b->id >= nblocks) continue;
-
-            unsigned char in = 0;
-            if (b == func->entry) {
-                in = 0;
-            } else if (b->pred_count <= 0) {
-                in = 0;
-            } else {
-                in = 1;
-                for (int p = 0; p < b->pred_count; p++) {
-                    IRBlock* pred = b->preds[p];
-                    if (!pred || pred->id < 0 || pred->id >= nblocks) {
-                        in = 0;
-                        break;
-                    }
-                    if (!inited_out[pred->id]) {
-                        in = 0;
-                        break;
-                    }
-                }
-            }
-
-            if (inited_in[b->id] != in) {
-                inited_in[b->id] = in;
-                changed = 1;
-            }
-
-            unsigned char out = (in || info[b->id].has_store) ? 1 : 0;
-            if (inited_out[b->id] != out) {
-                inited_out[b->id] = out;
-                changed = 1;
-            }
-        }
-
-        if (!changed) break;
-    }
-
-    // تحقق: أي حمل قبل خزن في كتلة يتطلب IN==1
-    for (IRBlock* b = func->blocks; b; b = b->next) {
-        if (!b) continue;
-        if (b->id < 0 || b->id >= nblocks) continue;
-
-        if (info[b->id].load_before_store && !inited_in[b->id]) {
-            free(info);
-            free(inited_in);
-            free(inited_out);
-            return 0;
-        }
-    }
-
-    free(info);
-    free(inited_in);
-    free(inited_out);
-    return 1;
-}
-
-static int ir_mem2reg_can_promote_alloca(IRFunc* func, IRBlock* alloca_block, IRInst* alloca_inst) {
+static int ir_mem2reg_can_promote_alloca(IRFunc* func, IRBlock* alloca_block, IRInst* alloca_inst,
+                                         int* out_partial) {
     if (!func || !alloca_block || !alloca_inst) return 0;
     if (alloca_inst->op != IR_OP_ALLOCA) return 0;
     if (alloca_inst->dest < 0) return 0;
@@ -353,10 +274,11 @@ static int ir_mem2reg_can_promote_alloca(IRFunc* func, IRBlock* alloca_block, IR
     IRType* pointee = ir_alloca_pointee_type(alloca_inst);
     if (!pointee) return 0;
 
-    if (!ir_alloca_loads_are_definitely_initialized(func, alloca_block, ptr_reg, pointee)) {
-        return 0;
-    }
+    // كتلة غير قابلة للوصول لا تُزار أثناء إعادة التسمية.
+    if (alloca_block != func->entry && !alloca_block->idom) return 0;
 
+    int partial = 0;
+    int plain_uses = 0;  // حمل/خزن غير خزن المزامنة قبل نداء وحمله بعده
     for (IRBlock* b = func->blocks; b; b = b->next) {
         for (IRInst* inst = b->first; inst; inst = inst->next) {
             if (!ir_inst_has_ptr_reg_use(inst, ptr_reg)) continue;
@@ -364,6 +286,13 @@ static int ir_mem2reg_can_promote_alloca(IRFunc* func, IRBlock* alloca_block, IR
             if (!ir_inst_ptr_use_is_allowed(inst, ptr_reg)) return 0;
             if (!ir_block_dominates(alloca_block, b)) return 0;
 
+            if (inst->op == IR_OP_CALL) {
+                partial = 1;
+                continue;
+            }
+
+            if (!mem2reg_is_sync_access(inst, ptr_reg)) plain_uses++;
+
             if (inst->op == IR_OP_STORE &&
                 inst->operand_count >= 2 &&
                 ir_value_is_reg_num(inst->operands[1], ptr_reg)) {
@@ -382,9 +311,15 @@ static int ir_mem2reg_can_promote_alloca(IRFunc* func, IRBlock* alloca_block, IR
         }
     }
 
+    // متغير رُقّي جزئياً من قبل لم يبقَ فيه ما يُكسب؛ إعادة ترقيته تدور بلا نهاية.
+    if (partial && plain_uses == 0) return 0;
+
+    if (out_partial) *out_partial = partial;
     return 1;
 }
 
+#include "ir_mem2reg_init.inc"
+
 // -----------------------------------------------------------------------------
 // مكدس إعادة التسمية في SSA
 // -----------------------------------------------------------------------------
@@ -438,9 +373,13 @@ static void mem2reg_collect_def_blocks(IRFunc* func, int ptr_reg,
         if (b->id < 0 || b->id >= max_id) continue;
 
         for (IRInst* inst = b->first; inst; inst = inst->next) {
-            if (inst->op != IR_OP_STORE) continue;
-            if (inst->operand_count < 2) continue;
-            if (!ir_value_is_reg_num(inst->operands[1], ptr_reg)) continue;
+            if (inst->op == IR_OP_CALL) {
+                if (mem2reg_call_ptr_effect(inst, ptr_reg) != MEM2REG_CALL_WRITES) continue;
+            } else {
+                if (inst->op != IR_OP_STORE) continue;
+                if (inst->operand_count < 2) continue;
+                if (!ir_value_is_reg_num(inst->operands[1], ptr_reg)) continue;
+            }
 
             if (!is_def[b->id]) {
                 is_def[b->id] = 1;
@@ -460,10 +399,12 @@ static void mem2reg_insert_phis_for_var(IRFunc* func, IRBlock** block_by_id,
     if (!func || !block_by_id || !v || !is_def || !def_ids || def_count <= 0 || max_id <= 0) return;
 
     unsigned char* in_work = (unsigned char*)calloc((size_t)max_id, sizeof(unsigned char));
+    unsigned char* placed = (unsigned char*)calloc((size_t)max_id, sizeof(unsigned char));
     int* work = (int*)malloc((size_t)max_id * sizeof(int));
-    if (!in_work || !work) {
-        if (in_work) free(in_work);
-        if (work) free(work);
+    if (!in_work || !placed || !work) {
+        free(in_work);
+        free(placed);
+        free(work);
         return;
     }
 
@@ -489,9 +430,14 @@ static void mem2reg_insert_phis_for_var(IRFunc* func, IRBlock** block_by_id,
             if (!y) continue;
             if (y->id < 0 || y->id >= max_id) continue;
 
-            if (!v->phi_in_block[y->id]) {
+            if (placed[y->id]) continue;
+            placed[y->id] = 1;
+
+            // كتلة يصلها مسار بلا تعريف: قيمتها عند الدخول لا تُقرأ أبداً
+            // (تحقق التهيئة)، فلا فاي فيها، لكنها تبقى ضمن إغلاق الحدود.
+            if (v->defined_in[y->id]) {
                 int dest = ir_func_alloc_reg(func);
-                IRInst* phi = ir_inst_phi(v->pointee, dest);
+                IRInst* phi = ir_inst_phi(&func->arena, v->pointee, dest);
                 if (!phi) continue;
 
                 // ربط الفاي بموقع/اسم المتغير الأصلي (إن وُجد).
@@ -504,16 +450,17 @@ static void mem2reg_insert_phis_for_var(IRFunc* func, IRBlock** block_by_id,
 
                 ir_block_insert_phi(y, phi);
                 v->phi_in_block[y->id] = phi;
+            }
 
-                if (!is_def[y->id] && !in_work[y->id]) {
-                    work[tail++] = y->id;
-                    in_work[y->id] = 1;
-                }
+            if (!is_def[y->id] && !in_work[y->id]) {
+                work[tail++] = y->id;
+                in_work[y->id] = 1;
             }
         }
     }
 
     free(in_work);
+    free(placed);
     free(work);
 }
 
@@ -534,6 +481,44 @@ typedef struct {
     int changed;
 } Mem2RegRenameCtx;
 
+/**
+ * مزامنة المتغيرات المرقّاة جزئياً حول نداء يستعمل مؤشرها: خزن القيمة الحالية
+ * قبله، ثم (إن كان يكتب) حمل القيمة الجديدة بعده كتعريف جديد للمتغير.
+ * التعليمات المُدرجة لا تُزار في نفس المسح (تقع قبل/بعد التعليمة الحالية).
+ */
+static void mem2reg_sync_call(Mem2RegRenameCtx* ctx, IRBlock* block, IRInst* call) {
+    for (int i = 0; i < ctx->var_count; i++) {
+        Mem2RegVar* v = &ctx->vars[i];
+        if (!v->partial) continue;
+
+        int effect = mem2reg_call_ptr_effect(call, v->ptr_reg);
+        if (effect == MEM2REG_CALL_NONE || effect == MEM2REG_CALL_ESCAPES) continue;
+
+        IRType* ptr_t = v->alloca_inst ? v->alloca_inst->type : ir_type_ptr(&block->parent->arena, v->pointee);
+        IRValue* cur = mem2reg_stack_top(v);
+        IRValue* val = cur ? ir_value_clone_with_type(&block->parent->arena, cur, v->pointee) : NULL;
+        IRInst* st = val ? ir_inst_store(&block->parent->arena, val, ir_value_reg(&block->parent->arena, v->ptr_reg, ptr_t)) : NULL;
+        if (st) {
+            ir_inst_set_loc(st, call->src_file, call->src_line, call->src_col);
+            ir_block_insert_before(block, call, st);
+            ctx->changed = 1;
+        }
+
+        if (effect != MEM2REG_CALL_WRITES || !call->next) continue;
+
+        int dest = ir_func_alloc_reg(ctx->func);
+        IRInst* ld = ir_inst_load(&block->parent->arena, v->pointee, dest, ir_value_reg(&block->parent->arena, v->ptr_reg, ptr_t));
+        if (!ld) continue;
+        ir_inst_set_loc(ld, call->src_file, call->src_line, call->src_col);
+        if (v->dbg_name) ir_inst_set_dbg_name(ld, v->dbg_name);
+        ir_block_insert_before(block, call->next, ld);
+
+        IRValue* reloaded = ir_value_reg(&block->parent->arena, dest, v->pointee);
+        if (reloaded) (void)mem2reg_stack_push(v, reloaded);
+        ctx->changed = 1;
+    }
+}
+
 static void mem2reg_rename_block(Mem2RegRenameCtx* ctx, IRBlock* block) {
     if (!ctx || !block) return;
     if (block->id < 0 || block->id >= ctx->max_id) return;
@@ -550,7 +535,7 @@ static void mem2reg_rename_block(Mem2RegRenameCtx* ctx, IRBlock* block) {
         IRInst* phi = ctx->vars[i].phi_in_block[block->id];
         if (!phi) continue;
 
-        IRValue* phi_val = ir_value_reg(phi->dest, phi->type ? phi->type : ctx->vars[i].pointee);
+        IRValue* phi_val = ir_value_reg(&block->parent->arena, phi->dest, phi->type ? phi->type : ctx->vars[i].pointee);
         if (phi_val) (void)mem2reg_stack_push(&ctx->vars[i], phi_val);
     }
 
@@ -559,6 +544,12 @@ static void mem2reg_rename_block(Mem2RegRenameCtx* ctx, IRBlock* block) {
     while (inst) {
         IRInst* next = inst->next;
 
+        if (inst->op == IR_OP_CALL) {
+            mem2reg_sync_call(ctx, block, inst);
+            inst = next;
+            continue;
+        }
+
         if (inst->op == IR_OP_STORE &&
             inst->operand_count >= 2 &&
             inst->operands[1] &&
@@ -571,7 +562,7 @@ static void mem2reg_rename_block(Mem2RegRenameCtx* ctx, IRBlock* block) {
                     Mem2RegVar* v = &ctx->vars[vi];
 
                     IRValue* stored_val = inst->operands[0];
-                    IRValue* clone = ir_value_clone_with_type(stored_val, v->pointee);
+                    IRValue* clone = ir_value_clone_with_type(&block->parent->arena, stored_val, v->pointee);
                     if (clone) (void)mem2reg_stack_push(v, clone);
 
                     ir_block_remove_inst(block, inst);
@@ -599,7 +590,7 @@ static void mem2reg_rename_block(Mem2RegRenameCtx* ctx, IRBlock* block) {
                         continue;
                     }
 
-                    IRValue* src = ir_value_clone_with_type(cur, inst->type ? inst->type : v->pointee);
+                    IRValue* src = ir_value_clone_with_type(&block->parent->arena, cur, inst->type ? inst->type : v->pointee);
                     if (!src) {
                         inst = next;
                         continue;
@@ -645,17 +636,11 @@ static void mem2reg_rename_block(Mem2RegRenameCtx* ctx, IRBlock* block) {
             IRInst* phi = ctx->vars[i].phi_in_block[succ->id];
             if (!phi) continue;
 
+            // فاي لا توضع إلا حيث المتغير معرّف على كل مسار، فالمكدس هنا غير فارغ.
             IRValue* cur = mem2reg_stack_top(&ctx->vars[i]);
-            if (!cur) {
-                IRValue* zero = ir_value_const_int(0, phi->type ? phi->type : ctx->vars[i].pointee);
-                if (zero) {
-                    ir_inst_phi_add(phi, zero, block);
-                    ctx->changed = 1;
-                }
-                continue;
-            }
+            if (!cur) continue;
 
-            IRValue* clone = ir_value_clone_with_type(cur, phi->type ? phi->type : ctx->vars[i].pointee);
+            IRValue* clone = ir_value_clone_with_type(&block->parent->arena, cur, phi->type ? phi->type : ctx->vars[i].pointee);
             if (!clone) continue;
             ir_inst_phi_add(phi, clone, block);
             ctx->changed = 1;
@@ -688,8 +673,8 @@ static int ir_mem2reg_func(IRFunc* func) {
     if (!func || func->is_prototype) return 0;
     if (!func->entry) return 0;
 
-    // حساب dominators/DF + إعادة بناء preds/succs
-    ir_func_compute_dominators(func);
+    // dominators/DF + preds/succs (من كاش مدير التحليلات إن بقيت صالحة)
+    ir_analysis_require_dominators(func);
 
     int max_id = ir_func_max_block_id_local(func);
     if (max_id <= 0) return 0;
@@ -712,15 +697,26 @@ static int ir_mem2reg_func(IRFunc* func) {
         for (IRInst* inst = b->first; inst; inst = inst->next) {
             if (inst->op != IR_OP_ALLOCA) continue;
             if (inst->dest < 0) continue;
-            if (!ir_mem2reg_can_promote_alloca(func, b, inst)) continue;
+            int partial = 0;
+            if (!ir_mem2reg_can_promote_alloca(func, b, inst, &partial)) continue;
 
             IRType* pointee = ir_alloca_pointee_type(inst);
             if (!pointee) continue;
 
+            unsigned char* defined_in = (unsigned char*)calloc((size_t)max_id, sizeof(unsigned char));
+            if (!defined_in) continue;
+            if (!mem2reg_reads_are_defined(func, inst->dest, max_id, defined_in)) {
+                free(defined_in);
+                continue;
+            }
+
             if (var_count >= var_cap) {
                 int new_cap = (var_cap == 0) ? 8 : var_cap * 2;
                 Mem2RegVar* new_arr = (Mem2RegVar*)realloc(vars, (size_t)new_cap * sizeof(Mem2RegVar));
-                if (!new_arr) break;
+                if (!new_arr) {
+                    free(defined_in);
+                    break;
+                }
                 vars = new_arr;
                 var_cap = new_cap;
             }
@@ -732,6 +728,8 @@ static int ir_mem2reg_func(IRFunc* func) {
             v->alloca_inst = inst;
             v->alloca_block = b;
             v->dbg_name = inst->dbg_name;
+            v->partial = partial;
+            v->defined_in = defined_in;
             v->phi_in_block = (IRInst**)calloc((size_t)max_id, sizeof(IRInst*));
         }
     }
@@ -750,6 +748,7 @@ static int ir_mem2reg_func(IRFunc* func) {
     if (!ptr_reg_to_var) {
         for (int i = 0; i < var_count; i++) {
             free(vars[i].phi_in_block);
+            free(vars[i].defined_in);
         }
         free(vars);
         free(block_by_id);
@@ -790,6 +789,7 @@ static int ir_mem2reg_func(IRFunc* func) {
         free(ptr_reg_to_var);
         for (int i = 0; i < var_count; i++) {
             free(vars[i].phi_in_block);
+            free(vars[i].defined_in);
             mem2reg_stack_free_to(&vars[i], 0);
             free(vars[i].stack);
         }
@@ -827,11 +827,14 @@ static int ir_mem2reg_func(IRFunc* func) {
     rctx.max_id = max_id;
     rctx.changed = 0;
 
+    // المكدسات تبدأ فارغة: تحقق التهيئة يضمن ألا تُقرأ قيمة قبل تعريفها،
+    // والنداء الكاتب دون قيمة سابقة لا يسبقه خزن مزامنة.
     mem2reg_rename_block(&rctx, func->entry);
     if (rctx.changed) changed = 1;
 
-    // حذف allocas المرقّاة
+    // حذف allocas المرقّاة (المرقّاة جزئياً تبقى للنداءات)
     for (int i = 0; i < var_count; i++) {
+        if (vars[i].partial) continue;
         if (vars[i].alloca_block && vars[i].alloca_inst) {
             ir_block_remove_inst(vars[i].alloca_block, vars[i].alloca_inst);
             changed = 1;
@@ -845,6 +848,7 @@ static int ir_mem2reg_func(IRFunc* func) {
 
     for (int i = 0; i < var_count; i++) {
         free(vars[i].phi_in_block);
+        free(vars[i].defined_in);
         mem2reg_stack_free_to(&vars[i], 0);
         free(vars[i].stack);
     }
@@ -862,7 +866,6 @@ bool ir_mem2reg_run(IRModule* module) {
     if (!module) return false;
 
     // ضمان أن أي قيم/فاي جديدة تُخصَّص ضمن ساحة هذه الوحدة.
-    ir_module_set_current(module);
 
     int changed = 0;
     for (IRFunc* f = module->funcs; f; f = f->next) {
@@ -871,3 +874,7 @@ bool ir_mem2reg_run(IRModule* module) {
 
     return changed ? true : false;
 }
+
+static bool ir_mem2reg_run_func(IRFunc* func) {
+    return ir_mem2reg_func(func) ? true : false;
+}
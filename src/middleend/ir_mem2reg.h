@@ -17,11 +17,13 @@
  *
  * قيود السلامة (الصحة أولاً):
  * - نُرقّي فقط `alloca` الذي:
- *   - لا يهرب مؤشّره: لا يُمرَّر إلى `نداء` ولا يُستخدم كقيمة داخل `فاي`
- *     ولا يُخزَّن المؤشر نفسه كقيمة.
+ *   - لا يهرب مؤشّره: لا يُستخدم كقيمة داخل `فاي` ولا يُخزَّن المؤشر نفسه كقيمة،
+ *     ولا يُمرَّر إلى `نداء` إلا لدوال معروفة لا تحتفظ به (scanf/strlen/memcpy...).
  *   - كتلة تعريف المؤشر (الكتلة التي تحتوي `حجز`) تسيطر على كل استعمالات المؤشر
- *     دون استثناء لضمان صحة الـ SSA ومنع القراءة غير المهيّأة.
- *   - يوجد خزن تهيئة داخل نفس كتلة `حجز` قبل أي `حمل` لنفس المؤشر.
+ *     دون استثناء لضمان صحة الـ SSA.
+ * - `حمل` قبل أي `خزن` يقرأ قيمة غير معرّفة؛ نمثّلها بصفر من نوع المتغير.
+ * - الترقية الجزئية: إن مُرِّر المؤشر إلى نداء كهذا يبقى `حجز`، ونزامن الذاكرة
+ *   حول النداء فقط (خزن القيمة الحالية قبله، وحمل جديد بعده إن كان يكتب).
  */
 
 #ifndef BAA_IR_MEM2REG_H
@@ -0,0 +1,435 @@
+/**
+ * @file ir_memopt.c
+ * @brief تنفيذ حذف الوصولات الزائدة للذاكرة فوق تحليل التسمية.
+ *
+ * الخطوات لكل دالة:
+ * 1) حذف كل خزن إلى حجز لا يهرب ولا يقرؤه أي حمل أو نداء.
+ * 2) المرور على أشجار الكتل الممتدة: الجذر كتلة الدخول أو أي كتلة لها عدد
+ *    أسلاف غير واحد، وكل خليفة بسلف وحيد ترث حالة سلفها عند خروجه.
+ *    الحالة قائمة محدودة من (موقع ← قيمة معروفة)؛ الخزن والنداءات تُسقط منها
+ *    ما قد تكتبه. الخزون المعلّقة (لم تُقرأ بعد) محلية للكتلة.
+ */
+
+#include "ir_memopt.h"
+
+#include "ir_alias.h"
+#include "ir_analysis_manager.h"
+#include "ir_mutate.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/** أقصى عدد قيم معروفة في الحالة؛ الأقدم يُسقط عند الامتلاء. */
+#define MEMOPT_MAX_AVAIL 64
+
+/** أقصى عدد خزون معلّقة في كتلة واحدة. */
+#define MEMOPT_MAX_PENDING 32
+
+// -----------------------------------------------------------------------------
+// دمج IRPass
+// -----------------------------------------------------------------------------
+
+static bool ir_memopt_run_func(IRFunc* func);
+
+IRPass IR_PASS_MEMOPT = {
+    .name = "حذف_الوصولات_الزائدة",
+    .run = ir_memopt_run,
+    .run_func = ir_memopt_run_func,
+    .preserves = IR_ANALYSIS_CFG_ALL
+};
+
+// -----------------------------------------------------------------------------
+// البنى
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    IRMemLoc loc;
+    IRValue* value;  // قيمة الخزن، أو NULL فالقيمة هي السجل reg (ناتج حمل)
+    int reg;
+    IRType* type;
+} MemoptAvail;
+
+typedef struct {
+    MemoptAvail items[MEMOPT_MAX_AVAIL];
+    int count;
+} MemoptState;
+
+typedef struct {
+    IRInst* store;
+    IRMemLoc loc;
+} MemoptPending;
+
+typedef struct {
+    IRBlock* block;
+    MemoptState* state;  // مملوكة للعنصر
+} MemoptWork;
+
+typedef struct {
+    IRFunc* func;
+    IRAliasInfo* ai;
+    int changed;
+
+    MemoptWork* stack;
+    int stack_count;
+    int stack_cap;
+} MemoptCtx;
+
+// -----------------------------------------------------------------------------
+// مساعدات
+// -----------------------------------------------------------------------------
+
+static IRValue* memopt_clone_value(IRArena* arena, IRValue* v, IRType* type) {
+    if (!v) return NULL;
+    switch (v->kind) {
+        case IR_VAL_CONST_INT:
+            return ir_value_const_int(arena, v->data.const_int, type);
+        case IR_VAL_CONST_STR:
+            return ir_value_const_str(arena, v->data.const_str.data, v->data.const_str.id);
+        case IR_VAL_BAA_STR:
+            return ir_value_baa_str(arena, v->data.const_str.data, v->data.const_str.id);
+        case IR_VAL_REG:
+            return ir_value_reg(arena, v->data.reg_num, type);
+        case IR_VAL_GLOBAL:
+            if (v->type && v->type->kind == IR_TYPE_PTR) {
+                return ir_value_global(arena, v->data.global_name, v->type->data.pointee);
+            }
+            return ir_value_global(arena, v->data.global_name, v->type);
+        case IR_VAL_FUNC:
+            return ir_value_func_ref(arena, v->data.global_name, type);
+        default:
+            return NULL;
+    }
+}
+
+static bool memopt_value_is_forwardable(IRValue* v) {
+    if (!v) return false;
+    switch (v->kind) {
+        case IR_VAL_CONST_INT:
+        case IR_VAL_CONST_STR:
+        case IR_VAL_BAA_STR:
+        case IR_VAL_REG:
+        case IR_VAL_GLOBAL:
+        case IR_VAL_FUNC:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/** هل القيمة المعروفة هي نفس القيمة v؟ */
+static bool memopt_avail_equals(const MemoptAvail* a, IRValue* v) {
+    if (!a || !v) return false;
+    if (!a->value) return v->kind == IR_VAL_REG && v->data.reg_num == a->reg;
+
+    IRValue* w = a->value;
+    if (w->kind != v->kind) return false;
+    switch (v->kind) {
+        case IR_VAL_REG:
+            return w->data.reg_num == v->data.reg_num;
+        case IR_VAL_CONST_INT:
+            return w->data.const_int == v->data.const_int;
+        case IR_VAL_GLOBAL:
+        case IR_VAL_FUNC:
+            return w->data.global_name && v->data.global_name &&
+                   strcmp(w->data.global_name, v->data.global_name) == 0;
+        default:
+            return false;
+    }
+}
+
+static void memopt_state_remove(MemoptState* s, int i) {
+    memmove(&s->items[i], &s->items[i + 1], (size_t)(s->count - i - 1) * sizeof(MemoptAvail));
+    s->count--;
+}
+
+static void memopt_state_add(MemoptState* s, const IRMemLoc* loc, IRValue* value, int reg, IRType* type) {
+    if (!type) return;
+    if (s->count == MEMOPT_MAX_AVAIL) memopt_state_remove(s, 0);
+    MemoptAvail* a = &s->items[s->count++];
+    a->loc = *loc;
+    a->value = value;
+    a->reg = reg;
+    a->type = type;
+}
+
+/** إسقاط كل قيمة قد يكتبها خزن في loc. */
+static void memopt_state_kill_loc(MemoptCtx* ctx, MemoptState* s, const IRMemLoc* loc) {
+    for (int i = s->count - 1; i >= 0; i--) {
+        if (ir_alias_query(ctx->ai, &s->items[i].loc, loc) != IR_ALIAS_NO) memopt_state_remove(s, i);
+    }
+}
+
+static void memopt_rewrite_to_copy(IRInst* inst, IRValue* src) {
+    for (int i = 0; i < inst->operand_count; i++) {
+        if (inst->operands[i]) {
+            ir_value_free(inst->operands[i]);
+            inst->operands[i] = NULL;
+        }
+    }
+
+    inst->op = IR_OP_COPY;
+    inst->operand_count = 1;
+    inst->operands[0] = src;
+    inst->phi_entries = NULL;
+    inst->call_target = NULL;
+    inst->call_callee = NULL;
+    inst->call_args = NULL;
+    inst->call_arg_count = 0;
+}
+
+// -----------------------------------------------------------------------------
+// 1) الخزن إلى حجوزات لا تُقرأ
+// -----------------------------------------------------------------------------
+
+static bool memopt_loc_is_private_alloca(MemoptCtx* ctx, const IRMemLoc* loc) {
+    return loc->kind == IR_MEM_BASE_ALLOCA && !ir_alias_loc_may_escape(ctx->ai, loc);
+}
+
+static void memopt_remove_unread_alloca_stores(MemoptCtx* ctx) {
+    int max_reg = ctx->func->next_reg;
+    if (max_reg <= 0) return;
+
+    unsigned char* read = (unsigned char*)calloc((size_t)max_reg, 1);
+    if (!read) return;
+
+    for (IRBlock* b = ctx->func->blocks; b; b = b->next) {
+        for (IRInst* inst = b->first; inst; inst = inst->next) {
+            IRMemLoc loc;
+            if (inst->op == IR_OP_LOAD && ir_alias_inst_loc(ctx->ai, inst, &loc)) {
+                if (loc.kind == IR_MEM_BASE_ALLOCA && loc.base_reg >= 0 && loc.base_reg < max_reg) {
+                    read[loc.base_reg] = 1;
+                }
+                continue;
+            }
+            if (inst->op != IR_OP_CALL) continue;
+            for (int i = 0; i < inst->call_arg_count; i++) {
+                if (!inst->call_args || !inst->call_args[i]) continue;
+                int effect = ir_alias_call_arg_effect(inst, i);
+                if (effect >= 0 && !(effect & IR_MODREF_REF)) continue;
+                ir_alias_loc_of(ctx->ai, inst->call_args[i], 0, &loc);
+                if (loc.kind == IR_MEM_BASE_ALLOCA && loc.base_reg >= 0 && loc.base_reg < max_reg) {
+                    read[loc.base_reg] = 1;
+                }
+            }
+        }
+    }
+
+    for (IRBlock* b = ctx->func->blocks; b; b = b->next) {
+        IRInst* inst = b->first;
+        while (inst) {
+            IRInst* next = inst->next;
+            IRMemLoc loc;
+            if (inst->op == IR_OP_STORE && ir_alias_inst_loc(ctx->ai, inst, &loc) &&
+                memopt_loc_is_private_alloca(ctx, &loc) &&
+                loc.base_reg < max_reg && !read[loc.base_reg]) {
+                ir_block_remove_inst(b, inst);
+                ctx->changed = 1;
+            }
+            inst = next;
+        }
+    }
+
+    free(read);
+}
+
+// -----------------------------------------------------------------------------
+// 2) التمرير داخل الكتل الممتدة
+// -----------------------------------------------------------------------------
+
+static void memopt_pending_kill_reads(MemoptCtx* ctx, MemoptPending* pending, int* count,
+                                      const IRMemLoc* loc, IRInst* call) {
+    for (int i = *count - 1; i >= 0; i--) {
+        bool read = call ? (ir_alias_call_modref(ctx->ai, call, &pending[i].loc) & IR_MODREF_REF) != 0
+                         : ir_alias_query(ctx->ai, &pending[i].loc, loc) != IR_ALIAS_NO;
+        if (!read) continue;
+        memmove(&pending[i], &pending[i + 1], (size_t)(*count - i - 1) * sizeof(MemoptPending));
+        (*count)--;
+    }
+}
+
+static void memopt_visit_load(MemoptCtx* ctx, MemoptState* s, MemoptPending* pending, int* pending_count,
+                              IRInst* inst) {
+    IRMemLoc loc;
+    if (!ir_alias_inst_loc(ctx->ai, inst, &loc)) {
+        *pending_count = 0;
+        return;
+    }
+
+    for (int i = s->count - 1; i >= 0 && loc.size > 0; i--) {
+        MemoptAvail* a = &s->items[i];
+        if (!ir_types_equal(a->type, inst->type)) continue;
+        if (ir_alias_query(ctx->ai, &a->loc, &loc) != IR_ALIAS_MUST) continue;
+
+        IRValue* src = a->value ? memopt_clone_value(&ctx->func->arena, a->value, inst->type)
+                                 : ir_value_reg(&ctx->func->arena, a->reg, inst->type);
+        if (!src) break;
+        memopt_rewrite_to_copy(inst, src);
+        ctx->changed = 1;
+        return;
+    }
+
+    memopt_pending_kill_reads(ctx, pending, pending_count, &loc, NULL);
+    if (inst->dest >= 0 && loc.size > 0) memopt_state_add(s, &loc, NULL, inst->dest, inst->type);
+}
+
+static void memopt_visit_store(MemoptCtx* ctx, MemoptState* s, MemoptPending* pending, int* pending_count,
+                               IRBlock* block, IRInst* inst) {
+    IRMemLoc loc;
+    if (!ir_alias_inst_loc(ctx->ai, inst, &loc) || loc.size <= 0) {
+        // خزن بحجم مجهول: أسقط كل شيء.
+        s->count = 0;
+        *pending_count = 0;
+        return;
+    }
+    IRValue* value = inst->operands[0];
+
+    // الموقع يحمل هذه القيمة أصلاً.
+    for (int i = s->count - 1; i >= 0; i--) {
+        MemoptAvail* a = &s->items[i];
+        if (!ir_types_equal(a->type, value->type)) continue;
+        if (ir_alias_query(ctx->ai, &a->loc, &loc) != IR_ALIAS_MUST) continue;
+        if (!memopt_avail_equals(a, value)) break;
+        ir_block_remove_inst(block, inst);
+        ctx->changed = 1;
+        return;
+    }
+
+    // خزن سابق لنفس البايتات لم يُقرأ بعد: ميت.
+    for (int i = *pending_count - 1; i >= 0; i--) {
+        if (ir_alias_query(ctx->ai, &pending[i].loc, &loc) != IR_ALIAS_MUST) continue;
+        ir_block_remove_inst(block, pending[i].store);
+        memmove(&pending[i], &pending[i + 1], (size_t)(*pending_count - i - 1) * sizeof(MemoptPending));
+        (*pending_count)--;
+        ctx->changed = 1;
+    }
+
+    memopt_state_kill_loc(ctx, s, &loc);
+    if (memopt_value_is_forwardable(value)) memopt_state_add(s, &loc, value, -1, value->type);
+
+    if (*pending_count == MEMOPT_MAX_PENDING) {
+        memmove(&pending[0], &pending[1], (size_t)(*pending_count - 1) * sizeof(MemoptPending));
+        (*pending_count)--;
+    }
+    pending[*pending_count].store = inst;
+    pending[*pending_count].loc = loc;
+    (*pending_count)++;
+}
+
+static void memopt_visit_call(MemoptCtx* ctx, MemoptState* s, MemoptPending* pending, int* pending_count,
+                              IRInst* inst) {
+    for (int i = s->count - 1; i >= 0; i--) {
+        if (ir_alias_call_modref(ctx->ai, inst, &s->items[i].loc) & IR_MODREF_MOD) memopt_state_remove(s, i);
+    }
+    memopt_pending_kill_reads(ctx, pending, pending_count, NULL, inst);
+}
+
+static void memopt_block(MemoptCtx* ctx, IRBlock* block, MemoptState* s) {
+    MemoptPending pending[MEMOPT_MAX_PENDING];
+    int pending_count = 0;
+
+    IRInst* inst = block->first;
+    while (inst) {
+        IRInst* next = inst->next;
+        switch (inst->op) {
+            case IR_OP_LOAD:
+                memopt_visit_load(ctx, s, pending, &pending_count, inst);
+                break;
+            case IR_OP_STORE:
+                memopt_visit_store(ctx, s, pending, &pending_count, block, inst);
+                break;
+            case IR_OP_CALL:
+                memopt_visit_call(ctx, s, pending, &pending_count, inst);
+                break;
+            case IR_OP_RET:
+                // ذاكرة الحجوزات التي لا تهرب تنتهي بانتهاء الدالة.
+                for (int i = 0; i < pending_count; i++) {
+                    if (!memopt_loc_is_private_alloca(ctx, &pending[i].loc)) continue;
+                    ir_block_remove_inst(block, pending[i].store);
+                    ctx->changed = 1;
+                }
+                pending_count = 0;
+                break;
+            default:
+                break;
+        }
+        inst = next;
+    }
+}
+
+static bool memopt_push(MemoptCtx* ctx, IRBlock* block, MemoptState* state) {
+    if (ctx->stack_count == ctx->stack_cap) {
+        int cap = ctx->stack_cap ? ctx->stack_cap * 2 : 16;
+        MemoptWork* grown = (MemoptWork*)realloc(ctx->stack, (size_t)cap * sizeof(MemoptWork));
+        if (!grown) return false;
+        ctx->stack = grown;
+        ctx->stack_cap = cap;
+    }
+    ctx->stack[ctx->stack_count].block = block;
+    ctx->stack[ctx->stack_count].state = state;
+    ctx->stack_count++;
+    return true;
+}
+
+static bool memopt_is_root(IRFunc* func, IRBlock* b) {
+    return b == func->entry || b->pred_count != 1;
+}
+
+static void memopt_extended_tree(MemoptCtx* ctx, IRBlock* root) {
+    MemoptState* initial = (MemoptState*)calloc(1, sizeof(MemoptState));
+    if (!initial || !memopt_push(ctx, root, initial)) {
+        free(initial);
+        return;
+    }
+
+    while (ctx->stack_count > 0) {
+        MemoptWork w = ctx->stack[--ctx->stack_count];
+        memopt_block(ctx, w.block, w.state);
+
+        for (int i = 0; i < w.block->succ_count; i++) {
+            IRBlock* succ = w.block->succs[i];
+            if (!succ || succ == w.block || memopt_is_root(ctx->func, succ)) continue;
+            MemoptState* copy = (MemoptState*)malloc(sizeof(MemoptState));
+            if (!copy) continue;
+            memcpy(copy, w.state, sizeof(MemoptState));
+            if (!memopt_push(ctx, succ, copy)) free(copy);
+        }
+        free(w.state);
+    }
+}
+
+static int ir_memopt_func(IRFunc* func) {
+    if (!func || func->is_prototype || !func->entry) return 0;
+
+    ir_analysis_require_preds(func);
+
+    MemoptCtx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.func = func;
+    ctx.ai = ir_alias_info_build(func);
+    if (!ctx.ai) return 0;
+
+    memopt_remove_unread_alloca_stores(&ctx);
+
+    for (IRBlock* b = func->blocks; b; b = b->next) {
+        if (memopt_is_root(func, b)) memopt_extended_tree(&ctx, b);
+    }
+
+    free(ctx.stack);
+    ir_alias_info_free(ctx.ai);
+    if (ctx.changed) ir_func_invalidate_defuse(func);
+    return ctx.changed;
+}
+
+bool ir_memopt_run(IRModule* module) {
+    if (!module) return false;
+
+    int changed = 0;
+    for (IRFunc* f = module->funcs; f; f = f->next) {
+        changed |= ir_memopt_func(f);
+    }
+    return changed ? true : false;
+}
+
+static bool ir_memopt_run_func(IRFunc* func) {
+    return ir_memopt_func(func) ? true : false;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file ir_memopt.h
+ * @brief حذف الوصولات الزائدة للذاكرة — تمرير الخزن إلى الحمل، والحمل المكرر، والخزن الميت.
+ *
+ * تعتمد على تحليل التسمية في `ir_alias.h`:
+ * - حمل من موقع خُزِّن فيه أو حُمِّل منه سابقاً (بنفس النوع) دون كتابة قد تصله
+ *   بينهما يُستبدل بنسخ القيمة المعروفة.
+ * - الحالة تُمرَّر من الكتلة إلى خليفتها إن كانت الخليفة لا تملك سلفاً آخر
+ *   (كتل ممتدة)، فلا حاجة لفاي.
+ * - خزن يكتب نفس القيمة الموجودة يُحذف.
+ * - خزن تغطيه كتابة لاحقة في نفس الكتلة دون قراءة بينهما يُحذف، وكذلك الخزن
+ *   إلى حجز لا يهرب قبل `رجوع` أو إلى حجز لا يُقرأ أبداً.
+ */
+
+#ifndef BAA_IR_MEMOPT_H
+#define BAA_IR_MEMOPT_H
+
+#include <stdbool.h>
+
+#include "ir.h"
+#include "ir_pass.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief تشغيل التمريرة على وحدة IR كاملة.
+ * @return true إذا تم تعديل الـ IR؛ false خلاف ذلك.
+ */
+bool ir_memopt_run(IRModule* module);
+
+/**
+ * @brief واصف التمريرة لاستخدامه ضمن خط أنابيب المُحسِّن.
+ */
+extern IRPass IR_PASS_MEMOPT;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BAA_IR_MEMOPT_H
@@ -78,6 +78,13 @@ void ir_block_free_analysis_caches(IRBlock* block) {
     block->pred_count = 0;
     block->pred_capacity = 0;
 
+    if (block->succs) {
+        free(block->succs);
+        block->succs = NULL;
+    }
+    block->succ_count = 0;
+    block->succ_capacity = 0;
+
     if (block->dom_frontier) {
         free(block->dom_frontier);
         block->dom_frontier = NULL;
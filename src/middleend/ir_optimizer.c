@@ -3,14 +3,15 @@
  * @brief تنفيذ خط أنابيب تحسين IR (v0.3.1.6).
  *
  * يطبق خط التحسين الموحد مع:
- * - ترتيب التمريرات
- * - تكرار حتى نقطة التثبيت (Fixpoint)
+ * - ترتيب التمريرات (وصف خط قابل للتهيئة عبر --opt-pipeline)
+ * - تكرار حتى نقطة التثبيت (Fixpoint) لكل دالة على حدة
  * - التحكم بمستوى التحسين (-O0/-O1/-O2)
  */
 
 #include "ir_optimizer.h"
 #include "ir_inline.h"
 #include "ir_mem2reg.h"
+#include "ir_sroa.h"
 #include "ir_canon.h"
 #include "ir_licm.h"
 #include "ir_constfold.h"
@@ -19,14 +20,20 @@
 #include "ir_gvn.h"
 #include "ir_copyprop.h"
 #include "ir_cse.h"
+#include "ir_memopt.h"
 #include "ir_dce.h"
 #include "ir_cfg_simplify.h"
 #include "ir_verify_ir.h"
 #include "ir_verify_ssa.h"
+#include "ir_pass.h"
+#include "ir_analysis_manager.h"
 
+#include <stdatomic.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-/** الحد الأقصى للتكرارات لتفادي حلقات لا نهائية */
+/** الحد الأقصى لجولات دالة واحدة لتفادي حلقات لا نهائية */
 #define MAX_ITERATIONS 10
 
 /**
@@ -41,137 +48,409 @@ const char* ir_optimizer_level_name(OptLevel level) {
     }
 }
 
+// ============================================================================
+// وصف خط التمريرات
+// ============================================================================
+
+typedef struct {
+    const char* key;    /**< الاسم في --opt-pipeline وأسطر [OPT-PASS] */
+    IRPass* pass;
+    OptLevel min_level; /**< أدنى مستوى يشغّل التمريرة في الخط الافتراضي */
+} IROptPipelineEntry;
+
+/**
+ * الخط الافتراضي بالترتيب. كل جولة على دالة تمر عبر هذه القائمة مرة واحدة،
+ * وكل تمريرة تمر عبر ir_pass_run_func() حتى يعرف مدير التحليلات ما تحافظ عليه.
+ */
+static const IROptPipelineEntry k_pipeline[] = {
+    // SROA — تفكيك الهياكل/المصفوفات المحلية إلى حقول قبل Mem2Reg.
+    {"sroa", &IR_PASS_SROA, OPT_LEVEL_1},
+    // Mem2Reg — SSA (فاي + إعادة تسمية) من alloca/load/store.
+    {"mem2reg", &IR_PASS_MEM2REG, OPT_LEVEL_1},
+    // توحيد شكل التعليمات لزيادة فعالية CSE/ConstFold/DCE.
+    {"canon", &IR_PASS_CANON, OPT_LEVEL_1},
+    // تبسيطات محلية سريعة قبل نشر الثوابت.
+    {"instcombine", &IR_PASS_INSTCOMBINE, OPT_LEVEL_1},
+    // نشر الثوابت + تبسيط CFG بناءً على الوصول.
+    {"sccp", &IR_PASS_SCCP, OPT_LEVEL_1},
+    {"constfold", &IR_PASS_CONSTFOLD, OPT_LEVEL_1},
+    {"copyprop", &IR_PASS_COPYPROP, OPT_LEVEL_1},
+    // GVN ثم CSE — فقط في O2.
+    {"gvn", &IR_PASS_GVN, OPT_LEVEL_2},
+    {"cse", &IR_PASS_CSE, OPT_LEVEL_2},
+    // تمرير الخزن إلى الحمل + حذف الحمل المكرر والخزن الميت (ir_alias.h).
+    {"memopt", &IR_PASS_MEMOPT, OPT_LEVEL_1},
+    // حذف التعليمات الميتة والكتل غير القابلة للوصول.
+    {"dce", &IR_PASS_DCE, OPT_LEVEL_1},
+    // دمج كتل تافهة + إزالة أفرع زائدة.
+    {"cfg-simplify", &IR_PASS_CFG_SIMPLIFY, OPT_LEVEL_1},
+    // نقل التعليمات غير المتغيرة في الحلقات إلى preheader.
+    {"licm", &IR_PASS_LICM, OPT_LEVEL_1},
+};
+
+#define IR_OPT_PIPELINE_DEFAULT_COUNT ((int)(sizeof(k_pipeline) / sizeof(k_pipeline[0])))
+
+_Static_assert(sizeof(k_pipeline) / sizeof(k_pipeline[0]) <= IR_OPT_PIPELINE_MAX,
+               "IROptimizerStats::passes must cover every pipeline entry");
+
+static int pipeline_find(const char* name, size_t len) {
+    for (int i = 0; i < IR_OPT_PIPELINE_DEFAULT_COUNT; i++) {
+        if (strlen(k_pipeline[i].key) == len && strncmp(k_pipeline[i].key, name, len) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 /**
- * @brief تشغيل دورة واحدة من خط التحسين.
+ * @brief تحليل وصف خط إلى فهارس في k_pipeline.
  *
- * @param module وحدة IR المراد تحسينها.
- * @param level  مستوى التحسين.
- * @return true إذا أحدثت أي تمريرة تغييرات، false خلاف ذلك.
+ * @return عدد التمريرات، أو -1 عند تمريرة غير معروفة أو تجاوز الحد.
  */
-static bool optimizer_iteration(IRModule* module,
-                                OptLevel level,
-                                int verify_gate,
-                                FILE* verify_out) {
-    bool changed = false;
+static int pipeline_parse(const char* spec, int* out, FILE* err) {
+    int count = 0;
+    const char* p = spec;
+    while (*p) {
+        const char* comma = strchr(p, ',');
+        size_t len = comma ? (size_t)(comma - p) : strlen(p);
+
+        if (len > 0) {
+            int idx = pipeline_find(p, len);
+            if (idx < 0) {
+                if (err) {
+                    fprintf(err, "خطأ: تمريرة غير معروفة في --opt-pipeline: '%.*s'\n", (int)len, p);
+                    fprintf(err, "التمريرات المتاحة:");
+                    for (int i = 0; i < IR_OPT_PIPELINE_DEFAULT_COUNT; i++) {
+                        fprintf(err, " %s", k_pipeline[i].key);
+                    }
+                    fprintf(err, "\n");
+                }
+                return -1;
+            }
+            if (count >= IR_OPT_PIPELINE_MAX) {
+                if (err) fprintf(err, "خطأ: --opt-pipeline يقبل %d تمريرة كحد أقصى.\n", IR_OPT_PIPELINE_MAX);
+                return -1;
+            }
+            out[count++] = idx;
+        }
 
-    // تمريرة 0: Mem2Reg (ترقية الذاكرة إلى سجلات) — SSA (فاي + إعادة تسمية)
-    // يُحوِّل المتغيرات المحلية من alloca/load/store إلى SSA مع إدراج فاي عند الدمج.
-    changed |= ir_mem2reg_run(module);
+        if (!comma) break;
+        p = comma + 1;
+    }
+    return count;
+}
 
-    // تمريرة 0.5: Canonicalization (توحيد_الـIR)
-    // توحيد شكل التعليمات لزيادة فعالية CSE/ConstFold/DCE
-    changed |= ir_canon_run(module);
+bool ir_optimizer_validate_pipeline(const char* spec, FILE* err) {
+    int parsed[IR_OPT_PIPELINE_MAX];
+    return !spec || pipeline_parse(spec, parsed, err) >= 0;
+}
 
-    // تمريرة 0.6: InstCombine (دمج_التعليمات)
-    // تبسيطات محلية سريعة قبل نشر الثوابت.
-    changed |= ir_instcombine_run(module);
+/**
+ * @brief بناء قائمة فهارس التمريرات الفعلية لهذا المستوى.
+ *
+ * الخط المخصص يُشغَّل كما هو (المستوى يحدد فقط O0 مقابل غيره).
+ * @return عدد التمريرات، أو -1 إن كان الوصف المخصص غير صالح.
+ */
+static int pipeline_resolve(const char* spec, OptLevel level, int* out) {
+    if (spec && spec[0]) {
+        return pipeline_parse(spec, out, stderr);
+    }
 
-    // تمريرة 0.7: SCCP (نشر_الثوابت_المتناثر)
-    // نشر الثوابت + تبسيط CFG بناءً على الوصول.
-    changed |= ir_sccp_run(module);
+    int n = 0;
+    for (int i = 0; i < IR_OPT_PIPELINE_DEFAULT_COUNT; i++) {
+        if (level >= k_pipeline[i].min_level) out[n++] = i;
+    }
+    return n;
+}
 
-    // تمريرة 1: Constant Folding (طي_الثوابت)
-    // تطوي العمليات الحسابية عندما تكون المعاملات ثوابت
-    changed |= ir_constfold_run(module);
+// ============================================================================
+// إحصاءات المُحسِّن (--time-phases / --opt-stats)
+// ============================================================================
+
+static IROptimizerFuncStats* opt_func_stats_push(IROptimizerStats* stats, const char* name) {
+    if (stats->func_count >= stats->func_cap) {
+        int cap = stats->func_cap ? stats->func_cap * 2 : 64;
+        IROptimizerFuncStats* grown =
+            (IROptimizerFuncStats*)realloc(stats->funcs, sizeof(IROptimizerFuncStats) * (size_t)cap);
+        if (!grown) return NULL;
+        stats->funcs = grown;
+        stats->func_cap = cap;
+    }
+    IROptimizerFuncStats* s = &stats->funcs[stats->func_count++];
+    s->name = name ? name : "?";
+    s->rounds = 0;
+    s->changes = 0;
+    s->seconds = 0.0;
+    return s;
+}
 
-    // تمريرة 2: Copy Propagation (نشر_النسخ)
-    // تزيل نسخاً زائدة وتبسّط استعمالات السجلات
-    changed |= ir_copyprop_run(module);
+void ir_optimizer_stats_free(IROptimizerStats* stats) {
+    if (!stats) return;
+    free(stats->funcs);
+    stats->funcs = NULL;
+    stats->func_count = 0;
+    stats->func_cap = 0;
+}
 
-    // تمريرة 2.5: GVN (ترقيم_القيم) — فقط في O2
-    // يزيل تعابير متكررة حتى لو اختلفت أرقام السجلات بسبب النسخ.
-    if (level >= OPT_LEVEL_2) {
-        changed |= ir_gvn_run(module);
+void ir_optimizer_stats_print(const IROptimizerStats* stats, FILE* out, bool per_func) {
+    if (!stats || !out) return;
+
+    for (int i = 0; i < IR_OPT_PIPELINE_DEFAULT_COUNT; i++) {
+        const IROptimizerPassStats* s = &stats->passes[i];
+        if (s->runs == 0) continue;
+        fprintf(out, "[OPT-PASS] pass=%s runs=%llu changed=%llu time=%.6f\n",
+                k_pipeline[i].key,
+                (unsigned long long)s->runs,
+                (unsigned long long)s->changed,
+                s->seconds);
     }
 
-    // تمريرة 3: CSE (حذف_المكرر) — فقط في O2
-    // تزيل التعابير المكررة
-    if (level >= OPT_LEVEL_2) {
-        changed |= ir_cse_run(module);
+    int rounds = 0;
+    int max_rounds = 0;
+    int capped = 0;
+    for (int i = 0; i < stats->func_count; i++) {
+        const IROptimizerFuncStats* f = &stats->funcs[i];
+        if (per_func) {
+            fprintf(out, "[OPT-FUNC] func=%s rounds=%d changes=%d time=%.6f\n",
+                    f->name, f->rounds, f->changes, f->seconds);
+        }
+        rounds += f->rounds;
+        if (f->rounds > max_rounds) max_rounds = f->rounds;
+        if (f->rounds >= MAX_ITERATIONS) capped++;
     }
 
-    // تمريرة 4: DCE (حذف_الميت)
-    // تزيل التعليمات غير المستخدمة والكتل غير القابلة للوصول
-    changed |= ir_dce_run(module);
+    fprintf(out, "[OPT] funcs=%d skipped=%d rounds=%d max_rounds=%d capped=%d\n",
+            stats->func_count, stats->funcs_skipped, rounds, max_rounds, capped);
+}
 
-    // تمريرة 5: تبسيط CFG (تبسيط_CFG)
-    // دمج كتل تافهة + إزالة أفرع زائدة لتحسين IR
-    changed |= ir_cfg_simplify_run(module);
+// ============================================================================
+// التشغيل
+// ============================================================================
+
+/** عدّادات عامل واحد؛ تُجمع في إحصاءات المستدعي بترتيب العمال بعد انتهاء المهمة. */
+typedef struct {
+    IROptimizerPassStats passes[IR_OPT_PIPELINE_MAX];
+    IRAnalysisStats* analysis; // NULL = بلا عدّ تحليلات
+} OptWorker;
+
+/** خانة دالة واحدة؛ نتيجتها تُقرأ بالترتيب بعد انتهاء كل العمال. */
+typedef struct {
+    IRFunc* func;
+    IROptimizerFuncStats stats;
+    bool failed;
+} OptFuncItem;
+
+/** مهمة تقريب الدوال المتسخة (على المجمّع إن وُجد). */
+typedef struct {
+    OptLevel level;
+    const int* passes;
+    int pass_count;
+    bool verify_gate;
+    double (*clock)(void); // NULL = بلا قياس
+    OptFuncItem* items;
+    OptWorker* workers;
+    atomic_bool failed;    // فشل بوابة التحقق يوقف الدوال المتبقية
+} OptJob;
 
-    // تمريرة 6: LICM (حركة التعليمات غير المتغيرة)
-    // نقل التعليمات النقية غير المتغيرة في الحلقات إلى preheader
-    changed |= ir_licm_run(module);
+/**
+ * @brief تشغيل جولة واحدة من خط التحسين على دالة واحدة.
+ *
+ * @return عدد التمريرات التي غيّرت الدالة في هذه الجولة.
+ */
+static int optimizer_func_round(const OptJob* job, OptWorker* w, IRFunc* func) {
+    int changes = 0;
 
-    // بوابة التحقق (Debug Gate): بعد كل دورة تمريرات
-    if (verify_gate) {
-        FILE* out = verify_out ? verify_out : stderr;
+    for (int i = 0; i < job->pass_count; i++) {
+        IRPass* pass = k_pipeline[job->passes[i]].pass;
 
-        if (!ir_module_verify_ir(module, out)) {
-            fprintf(out, "فشل بوابة التحقق: IR غير صالح بعد تمريرة تحسين.\n");
-            // فشل بوابة التحقق يعني فشل التحسين (نعتبره عدم نجاح).
-            // نُرجع changed=true لإيقاف fixpoint بشكل صريح؟ الأفضل: أوقف فوراً.
-            return true;
+        if (!job->clock) {
+            changes += ir_pass_run_func(pass, func, w->analysis) ? 1 : 0;
+            continue;
         }
 
-        // إذا كانت SSA موجودة (بعد Mem2Reg) يمكن التحقق منها أيضاً.
-        if (!ir_module_verify_ssa(module, out)) {
-            fprintf(out, "فشل بوابة التحقق: SSA غير صالح بعد Mem2Reg/تمريرات تحسين.\n");
-            return true;
+        IROptimizerPassStats* s = &w->passes[job->passes[i]];
+        double t0 = job->clock();
+        bool changed = ir_pass_run_func(pass, func, w->analysis);
+        s->seconds += job->clock() - t0;
+        s->runs++;
+        if (changed) {
+            s->changed++;
+            changes++;
         }
     }
 
-    return changed;
+    return changes;
 }
 
 /**
- * @brief تشغيل خط التحسين على وحدة IR.
+ * @brief تقريب دالة واحدة إلى نقطة التثبيت.
+ *
+ * لا يلمس إلا الدالة وساحتها وخانتها وعدّادات عامله، فيصلح للتشغيل من أي خيط.
  */
-static int g_ir_optimizer_verify_gate = 0;
+static void optimizer_converge_func(const OptJob* job, OptWorker* w, OptFuncItem* item) {
+    IRFunc* f = item->func;
+    IROptimizerFuncStats* fs = &item->stats;
+    double t0 = job->clock ? job->clock() : 0.0;
+    bool converged = false;
+
+    for (int round = 0; round < MAX_ITERATIONS; round++) {
+        int changes = optimizer_func_round(job, w, f);
+        fs->rounds++;
+        fs->changes += changes;
+
+        // بوابة التحقق (Debug Gate): بعد كل جولة على الدالة.
+        if (job->verify_gate) {
+            if (!ir_func_verify_ir(f, stderr)) {
+                fprintf(stderr, "فشل بوابة التحقق: IR غير صالح بعد تمريرة تحسين.\n");
+                item->failed = true;
+                return;
+            }
+            if (!ir_func_verify_ssa(f, stderr)) {
+                fprintf(stderr, "فشل بوابة التحقق: SSA غير صالح بعد Mem2Reg/تمريرات تحسين.\n");
+                item->failed = true;
+                return;
+            }
+        }
+
+        if (changes == 0) {
+            // نقطة التثبيت لهذه الدالة — لم تُحدث أي تمريرة تغييرات.
+            converged = true;
+            break;
+        }
+    }
+
+    if (job->clock) fs->seconds = job->clock() - t0;
+    if (converged) {
+        f->opt_clean_epoch = f->ir_epoch;
+        f->opt_clean_level = (uint8_t)job->level;
+    }
+}
+
+static void optimizer_job_run(void* opaque, int index, int worker) {
+    OptJob* job = (OptJob*)opaque;
+    OptFuncItem* item = &job->items[index];
 
-void ir_optimizer_set_verify_gate(int enabled) {
-    g_ir_optimizer_verify_gate = enabled ? 1 : 0;
+    if (atomic_load_explicit(&job->failed, memory_order_relaxed)) return;
+    optimizer_converge_func(job, &job->workers[worker], item);
+    if (item->failed) atomic_store_explicit(&job->failed, true, memory_order_relaxed);
 }
 
-bool ir_optimizer_run(IRModule* module, OptLevel level) {
-    if (!module) return false;
+/**
+ * @brief تقريب الدوال المتسخة ثم جمع العدّادات والنتائج بترتيب ثابت.
+ *
+ * العدّادات تُجمع بترتيب العمال وسجلات الدوال بترتيب الوحدة، فالأسطر المطبوعة
+ * لا تتغير بعدد الخيوط (عدا الأزمنة).
+ */
+static bool optimizer_converge_funcs(OptJob* job, int item_count, BaaThreadPool* pool,
+                                     const IROptimizerOptions* options, IROptimizerStats* stats) {
+    if (item_count < 2) pool = NULL;
+    int worker_count = baa_thread_pool_size(pool);
+
+    job->workers = (OptWorker*)calloc((size_t)worker_count, sizeof(OptWorker));
+    if (!job->workers) return false;
+    bool ok = true;
+    if (options->analysis_stats) {
+        for (int w = 0; w < worker_count && ok; w++) {
+            job->workers[w].analysis = (IRAnalysisStats*)calloc(1, sizeof(IRAnalysisStats));
+            ok = job->workers[w].analysis != NULL;
+        }
+    }
 
-    // ضمان تخصيصات IR داخل تمريرات المُحسِّن ضمن ساحة هذه الوحدة.
-    ir_module_set_current(module);
+    if (ok) {
+        BaaParallelJob parallel = {.ctx = job, .run = optimizer_job_run};
+        baa_thread_pool_run(pool, &parallel, item_count);
+
+        for (int w = 0; w < worker_count; w++) {
+            if (stats) {
+                for (int i = 0; i < IR_OPT_PIPELINE_MAX; i++) {
+                    stats->passes[i].runs += job->workers[w].passes[i].runs;
+                    stats->passes[i].changed += job->workers[w].passes[i].changed;
+                    stats->passes[i].seconds += job->workers[w].passes[i].seconds;
+                }
+            }
+            ir_analysis_stats_merge(options->analysis_stats, job->workers[w].analysis);
+        }
+
+        for (int i = 0; i < item_count; i++) {
+            if (job->items[i].failed) ok = false;
+            if (stats && job->items[i].stats.rounds > 0) {
+                IROptimizerFuncStats* fs = opt_func_stats_push(stats, job->items[i].stats.name);
+                if (fs) *fs = job->items[i].stats;
+            }
+        }
+    }
+
+    for (int w = 0; w < worker_count; w++) free(job->workers[w].analysis);
+    free(job->workers);
+    job->workers = NULL;
+    return ok;
+}
+
+/**
+ * @brief تشغيل خط التحسين على وحدة IR.
+ */
+bool ir_optimizer_run(IRModule* module, const IROptimizerOptions* options) {
+    if (!module || !options) return false;
+    OptLevel level = options->level;
+    IROptimizerStats* stats = (options->stats && options->stats->clock) ? options->stats : NULL;
 
     // O0: بدون تحسين (نجاح بدون تغييرات)
     if (level == OPT_LEVEL_0) {
         return true;
     }
 
+    int passes[IR_OPT_PIPELINE_MAX];
+    int pass_count = pipeline_resolve(options->pipeline, level, passes);
+    if (pass_count < 0) return false;
+
     // v0.3.2.7.2: التضمين (Inlining) — O2 فقط، قبل Mem2Reg.
+    // يعدّل الدوال المستدعية فيتغير epoch لكل دالة ضُمِّن فيها مستدعى.
     if (level >= OPT_LEVEL_2) {
         (void)ir_inline_run(module);
     }
 
-    int iteration = 0;
+    // كل التمريرات محلية للدالة، فتتقارب كل دالة وحدها: دالة مستقرة لا تُعاد
+    // بسبب دالة أخرى ما زالت تتغير. قائمة العمل هي الدوال المتسخة فقط — أي التي
+    // تغيّر epoch لها منذ آخر نقطة تثبيت بهذا المستوى. ولأن كل دالة تخصص في
+    // ساحتها، تُوزَّع الدوال على عمال options->pool إن وُجد.
+    int item_count = 0;
+    for (IRFunc* f = module->funcs; f; f = f->next) {
+        if (!f->is_prototype && f->entry) item_count++;
+    }
 
-    // تكرار حتى نقطة التثبيت: تشغيل التمريرات حتى عدم وجود تغييرات
-    while (iteration < MAX_ITERATIONS) {
-        bool changed = optimizer_iteration(module, level, g_ir_optimizer_verify_gate, stderr);
+    OptFuncItem* items = item_count ? (OptFuncItem*)calloc((size_t)item_count, sizeof(OptFuncItem)) : NULL;
+    if (item_count && !items) return false;
 
-        // عندما تكون بوابة التحقق مفعلة: optimizer_iteration قد تطبع الأخطاء
-        // وتُرجع true بشكل غير دلالي. لذا نتحقق مباشرة من "سلامة" IR/SSA ونوقف.
-        if (g_ir_optimizer_verify_gate) {
-            if (!ir_module_verify_ir(module, stderr)) {
-                return false;
-            }
-            if (!ir_module_verify_ssa(module, stderr)) {
-                return false;
-            }
-        }
+    item_count = 0;
+    for (IRFunc* f = module->funcs; f; f = f->next) {
+        if (f->is_prototype || !f->entry) continue;
 
-        if (!changed) {
-            // تم الوصول لنقطة التثبيت — لم تُحدث أي تمريرة تغييرات
-            break;
+        if (f->opt_clean_level == (uint8_t)level && f->opt_clean_epoch == f->ir_epoch) {
+            if (stats) stats->funcs_skipped++;
+            continue;
         }
+        items[item_count].func = f;
+        items[item_count].stats.name = f->name ? f->name : "?";
+        item_count++;
+    }
 
-        iteration++;
+    OptJob job = {
+        .level = level,
+        .passes = passes,
+        .pass_count = pass_count,
+        .verify_gate = options->verify_gate,
+        .clock = stats ? stats->clock : NULL,
+        .items = items,
+    };
+    atomic_init(&job.failed, false);
+
+    bool ok = optimizer_converge_funcs(&job, item_count, options->pool, options, stats);
+    free(items);
+
+    // التحقق الكامل للوحدة (يشمل ما هو خارج الدوال) مرة واحدة في النهاية.
+    if (ok && options->verify_gate) {
+        ok = ir_module_verify_ir(module, stderr) && ir_module_verify_ssa(module, stderr);
     }
 
-    return true;
+    return ok;
 }
@@ -3,7 +3,7 @@
  * @brief خط أنابيب تحسين IR (v0.3.2.5.2).
  *
  * يوفر واجهة موحدة لتشغيل تمريرات تحسين IR بالترتيب الصحيح
- * مع تكرار حتى نقطة التثبيت (fixpoint) دون تغييرات إضافية.
+ * مع تكرار حتى نقطة التثبيت (fixpoint) لكل دالة على حدة.
  *
  * مستويات التحسين:
  * - O0: بدون تحسين (للتصحيح)
@@ -15,7 +15,10 @@
 #define BAA_IR_OPTIMIZER_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
 #include "ir.h"
+#include "../support/thread_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,37 +33,117 @@ typedef enum {
     OPT_LEVEL_2 = 2   /**< تحسينات كاملة */
 } OptLevel;
 
+/** أقصى عدد تمريرات في وصف خط مخصص (وحجم جدول إحصاءات التمريرات). */
+#define IR_OPT_PIPELINE_MAX 32
+
+/**
+ * @brief عدّادات تمريرة واحدة عبر كل الدوال.
+ */
+typedef struct {
+    uint64_t runs;
+    uint64_t changed;
+    double seconds;
+} IROptimizerPassStats;
+
+/**
+ * @brief عدّادات دالة واحدة حتى نقطة تثبيتها.
+ */
+typedef struct {
+    const char* name; /**< اسم الدالة (ذاكرة الوحدة؛ يُطبع قبل تحريرها) */
+    int rounds;
+    int changes;
+    double seconds;
+} IROptimizerFuncStats;
+
+/**
+ * @brief إحصاءات تشغيل المُحسِّن (--time-phases / --opt-stats).
+ *
+ * يملكها المستدعي: تبدأ مصفّرة مع ضبط `clock`، وتُطبع بـ ir_optimizer_stats_print()
+ * ثم تُحرَّر بـ ir_optimizer_stats_free().
+ */
+typedef struct {
+    double (*clock)(void);                              /**< ساعة بالثواني (مثل driver_time_seconds) */
+    IROptimizerPassStats passes[IR_OPT_PIPELINE_MAX];   /**< بفهرس التمريرة في الخط الافتراضي */
+    IROptimizerFuncStats* funcs;                        /**< دالة لكل تقريب (heap) */
+    int func_count;
+    int func_cap;
+    int funcs_skipped;                                  /**< دوال نظيفة تُخطيت */
+} IROptimizerStats;
+
+/**
+ * @brief خيارات تشغيل المُحسِّن لوحدة واحدة.
+ *
+ * تُمرَّر صراحةً إلى ir_optimizer_run()؛ لا يحتفظ المُحسِّن بأي إعداد عام.
+ */
+typedef struct {
+    OptLevel level;   /**< مستوى التحسين */
+
+    /**
+     * بوابة التحقق (--verify-gate): تشغيل `ir_module_verify_ir()` و
+     * `ir_module_verify_ssa()` بعد كل جولة على دالة لاكتشاف أخطاء التمريرات مبكراً.
+     */
+    bool verify_gate;
+
+    /**
+     * وصف خط التمريرات (--opt-pipeline): أسماء مفصولة بفواصل (مثل "mem2reg,sccp,dce")
+     * تُشغَّل بالترتيب المعطى في كل جولة ولأي مستوى أعلى من O0. NULL أو "" للخط الافتراضي.
+     */
+    const char* pipeline;
+
+    /** إحصاءات التمريرات والدوال، أو NULL لتعطيل القياس. */
+    IROptimizerStats* stats;
+
+    /**
+     * عدّادات كاش التحليلات لكل تمريرة (--opt-stats)، أو NULL لتعطيل العدّ.
+     * يملكها المستدعي ويطبعها بـ ir_analysis_stats_print().
+     */
+    IRAnalysisStats* analysis_stats;
+
+    /**
+     * مجمّع خيوط (--threads) توزَّع عليه الدوال المتسخة، أو NULL للتشغيل التسلسلي.
+     * كل دالة تخصص في ساحتها، والعدّادات تُجمع بترتيب الدوال، فالخرج مطابق للتسلسلي.
+     */
+    BaaThreadPool* pool;
+} IROptimizerOptions;
+
 /**
  * @brief تشغيل خط أنابيب التحسين على وحدة IR.
  *
- * ترتيب التمريرات (O1+):
- * 0. Mem2Reg (ترقية الذاكرة إلى سجلات) — SSA كامل
- * 1. Constant Folding (طي_الثوابت)
- * 2. Copy Propagation (نشر_النسخ)
- * 3. CSE (حذف_المكرر) — فقط في O2
- * 4. Dead Code Elimination (حذف_الميت)
+ * ترتيب التمريرات الافتراضي (O1+):
+ * sroa, mem2reg, canon, instcombine, sccp, constfold, copyprop,
+ * gvn و cse (O2 فقط), memopt, dce, cfg-simplify, licm.
  *
- * يكرر الخط حتى لا تُحدث أي تمريرة تغييرات (نقطة التثبيت)
- * أو الوصول لحد أقصى من التكرار.
+ * بعد التضمين (O2) تمر كل دالة متسخة عبر الخط جولةً بعد جولة حتى لا تُحدث
+ * أي تمريرة تغييرات فيها (نقطة التثبيت) أو الوصول لحد أقصى من الجولات.
+ * الدالة التي بلغت نقطة التثبيت ولم يتغير epoch لها تُتخطى في الاستدعاءات اللاحقة.
  *
- * @param module وحدة IR المراد تحسينها.
- * @param level  مستوى التحسين (OPT_LEVEL_0, OPT_LEVEL_1, OPT_LEVEL_2).
- * @return true عند النجاح؛ false عند فشل بوابة التحقق (إن كانت مفعّلة) أو خطأ داخلي.
+ * @param module  وحدة IR المراد تحسينها.
+ * @param options خيارات التشغيل (المستوى، بوابة التحقق، الخط، الإحصاءات).
+ * @return true عند النجاح؛ false عند فشل بوابة التحقق (إن كانت مفعّلة)، أو وصف خط
+ *         غير صالح، أو خطأ داخلي.
  */
-bool ir_optimizer_run(IRModule* module, OptLevel level);
+bool ir_optimizer_run(IRModule* module, const IROptimizerOptions* options);
 
 /**
- * @brief تفعيل/تعطيل بوابة التحقق داخل المُحسِّن (Debug Gate).
- *
- * عند التفعيل، يقوم المُحسِّن بتشغيل:
- * - `ir_module_verify_ir()` (سلامة/تشكيل IR)
- * - `ir_module_verify_ssa()` (صحة SSA بعد Mem2Reg)
+ * @brief التحقق من وصف خط التمريرات (--opt-pipeline) دون تشغيل أي شيء.
  *
- * بعد كل دورة تمريرات (iteration). هذا مفيد لاكتشاف أخطاء تمريرات التحسين مبكراً.
+ * @param spec وصف كما في IROptimizerOptions::pipeline (NULL أو "" صالحان).
+ * @param err  وجهة رسالة الخطأ (قد تكون NULL).
+ * @return false إن احتوى الوصف تمريرة غير معروفة أو تجاوز الحد.
+ */
+bool ir_optimizer_validate_pipeline(const char* spec, FILE* err);
+
+/**
+ * @brief طباعة أسطر `[OPT-PASS]` لكل تمريرة ثم سطر `[OPT]` الإجمالي.
  *
- * @param enabled 1 للتفعيل، 0 للتعطيل.
+ * @param per_func طباعة سطر `[OPT-FUNC]` لكل دالة أيضاً.
+ */
+void ir_optimizer_stats_print(const IROptimizerStats* stats, FILE* out, bool per_func);
+
+/**
+ * @brief تحرير سجلات الدوال في الإحصاءات (لا تحرر البنية نفسها).
  */
-void ir_optimizer_set_verify_gate(int enabled);
+void ir_optimizer_stats_free(IROptimizerStats* stats);
 
 /**
  * @brief الحصول على اسم مستوى التحسين.
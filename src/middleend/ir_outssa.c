@@ -20,6 +20,7 @@
 #include "ir_outssa.h"
 
 #include "ir_analysis.h"
+#include "ir_analysis_manager.h"
 #include "ir_mutate.h"
 
 #include <stdio.h>
@@ -33,7 +34,8 @@
 
 static int ir_is_terminator(const IRInst* inst) {
     if (!inst) return 0;
-    return inst->op == IR_OP_BR || inst->op == IR_OP_BR_COND || inst->op == IR_OP_RET;
+    return inst->op == IR_OP_BR || inst->op == IR_OP_BR_COND || inst->op == IR_OP_SWITCH ||
+           inst->op == IR_OP_RET;
 }
 
 static IRBlock* ir_block_from_value(IRValue* v) {
@@ -42,35 +44,35 @@ static IRBlock* ir_block_from_value(IRValue* v) {
     return v->data.block;
 }
 
-static IRValue* ir_value_clone_with_type_local(IRValue* v, IRType* override_type) {
+static IRValue* ir_value_clone_with_type_local(IRArena* arena, IRValue* v, IRType* override_type) {
     if (!v) return NULL;
 
     IRType* t = override_type ? override_type : v->type;
 
     switch (v->kind) {
         case IR_VAL_CONST_INT:
-            return ir_value_const_int(v->data.const_int, t);
+            return ir_value_const_int(arena, v->data.const_int, t);
 
         case IR_VAL_CONST_STR:
-            return ir_value_const_str(v->data.const_str.data, v->data.const_str.id);
+            return ir_value_const_str(arena, v->data.const_str.data, v->data.const_str.id);
 
         case IR_VAL_BAA_STR:
-            return ir_value_baa_str(v->data.const_str.data, v->data.const_str.id);
+            return ir_value_baa_str(arena, v->data.const_str.data, v->data.const_str.id);
 
         case IR_VAL_REG:
-            return ir_value_reg(v->data.reg_num, t);
+            return ir_value_reg(arena, v->data.reg_num, t);
 
         case IR_VAL_GLOBAL:
             if (v->type && v->type->kind == IR_TYPE_PTR) {
-                return ir_value_global(v->data.global_name, v->type->data.pointee);
+                return ir_value_global(arena, v->data.global_name, v->type->data.pointee);
             }
-            return ir_value_global(v->data.global_name, v->type);
+            return ir_value_global(arena, v->data.global_name, v->type);
 
         case IR_VAL_FUNC:
-            return ir_value_func_ref(v->data.global_name, t);
+            return ir_value_func_ref(arena, v->data.global_name, t);
 
         case IR_VAL_BLOCK:
-            return ir_value_block(v->data.block);
+            return ir_value_block(arena, v->data.block);
 
         case IR_VAL_NONE:
         default:
@@ -85,13 +87,16 @@ static IRValue* ir_value_clone_with_type_local(IRValue* v, IRType* override_type
 static void ir_term_replace_target(IRInst* term, IRBlock* old_target, IRBlock* new_target) {
     if (!term || !old_target || !new_target) return;
 
+    // تعديل أهداف المنهي يغيّر CFG: أسقط التحليلات المخزنة للدالة.
+    if (term->parent) ir_func_invalidate_cfg(term->parent->parent);
+
     if (term->op == IR_OP_BR) {
         if (term->operand_count < 1) return;
         IRBlock* cur = ir_block_from_value(term->operands[0]);
         if (cur != old_target) return;
 
         ir_value_free(term->operands[0]);
-        term->operands[0] = ir_value_block(new_target);
+        term->operands[0] = ir_value_block(&old_target->parent->arena, new_target);
         return;
     }
 
@@ -103,7 +108,22 @@ static void ir_term_replace_target(IRInst* term, IRBlock* old_target, IRBlock* n
             if (cur != old_target) continue;
 
             ir_value_free(term->operands[i]);
-            term->operands[i] = ir_value_block(new_target);
+            term->operands[i] = ir_value_block(&old_target->parent->arena, new_target);
+        }
+        return;
+    }
+
+    if (term->op == IR_OP_SWITCH) {
+        if (term->operand_count < 2) return;
+
+        if (ir_block_from_value(term->operands[1]) == old_target) {
+            ir_value_free(term->operands[1]);
+            term->operands[1] = ir_value_block(&old_target->parent->arena, new_target);
+        }
+        for (int i = 0; i < term->switch_case_count; i++) {
+            if (term->switch_cases[i].target == old_target) {
+                term->switch_cases[i].target = new_target;
+            }
         }
         return;
     }
@@ -146,10 +166,10 @@ static bool ir_emit_edge_copy(IRBlock* insert_block, IRInst* before,
                               const char* src_file, int src_line, int src_col) {
     if (!insert_block || !type || !src) return false;
 
-    IRValue* clone = ir_value_clone_with_type_local(src, type);
+    IRValue* clone = ir_value_clone_with_type_local(&insert_block->parent->arena, src, type);
     if (!clone) return false;
 
-    IRInst* copy = ir_inst_unary(IR_OP_COPY, type, dest_reg, clone);
+    IRInst* copy = ir_inst_unary(&insert_block->parent->arena, IR_OP_COPY, type, dest_reg, clone);
     if (!copy) {
         ir_value_free(clone);
         return false;
@@ -232,7 +252,7 @@ static bool ir_emit_parallel_copies(IRFunc* func, IRBlock* insert_block, IRInst*
         int temp_reg = ir_func_alloc_reg(func);
 
         // مؤقت = نسخ <type> %cycle_dest  (حفظ القيمة القديمة قبل الكتابة فوقها)
-        IRValue* cycle_dest_val = ir_value_reg(cycle_dest, t);
+        IRValue* cycle_dest_val = ir_value_reg(&func->arena, cycle_dest, t);
         if (!cycle_dest_val) {
             ok = false;
             goto cleanup;
@@ -248,7 +268,7 @@ static bool ir_emit_parallel_copies(IRFunc* func, IRBlock* insert_block, IRInst*
         }
         ir_value_free(cycle_dest_val);
 
-        IRValue* temp_val = ir_value_reg(temp_reg, t);
+        IRValue* temp_val = ir_value_reg(&func->arena, temp_reg, t);
         if (!temp_val) {
             ok = false;
             goto cleanup;
@@ -328,7 +348,7 @@ static IRBlock* ir_outssa_split_edge(IRFunc* func, IRBlock* pred, IRBlock* succ)
     ir_term_replace_target(term, succ, split);
 
     // تقسيم الحافة: ... ثم قفز إلى التابع (سنضيف النسخ قبل ذلك)
-    IRInst* br = ir_inst_br(succ);
+    IRInst* br = ir_inst_br(&func->arena, succ);
     if (br) {
         ir_block_append(split, br);
     }
@@ -459,7 +479,7 @@ static int ir_outssa_func(IRFunc* func) {
 
             // إذا كنا في كتلة تقسيم ولم يكن لديها تعليمة إنهاء (لسبب ما)، أضف قفزاً
             if (insert_block && insert_block != pred && !insert_block->last) {
-                IRInst* br = ir_inst_br(b);
+                IRInst* br = ir_inst_br(&func->arena, b);
                 if (!br) {
                     free(copies);
                     free(phis);
@@ -499,7 +519,6 @@ bool ir_outssa_run_ex(IRModule* module, bool* out_changed) {
     if (!module) return false;
 
     // ضمان أن أي نسخ/قيم جديدة تُخصَّص ضمن ساحة هذه الوحدة.
-    ir_module_set_current(module);
 
     int changed = 0;
     for (IRFunc* f = module->funcs; f; f = f->next) {
@@ -8,5 +8,18 @@
 
 bool ir_pass_run(IRPass* pass, IRModule* module) {
     if (!pass || !pass->run || !module) return false;
-    return pass->run(module);
+
+    ir_analysis_pass_begin(module, pass->name);
+    bool changed = pass->run(module);
+    ir_analysis_pass_end(module, pass->preserves);
+    return changed;
+}
+
+bool ir_pass_run_func(IRPass* pass, IRFunc* func, IRAnalysisStats* stats) {
+    if (!pass || !pass->run_func || !func) return false;
+
+    ir_analysis_func_pass_begin(func, stats, pass->name);
+    bool changed = pass->run_func(func);
+    ir_analysis_func_pass_end(func, pass->preserves);
+    return changed;
 }
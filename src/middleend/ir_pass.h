@@ -11,7 +11,9 @@
 #define BAA_IR_PASS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "ir.h"
+#include "ir_analysis_manager.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,21 +27,50 @@ extern "C" {
  */
 typedef bool (*IRPassRunFn)(IRModule* module);
 
+/**
+ * @brief Function signature for running a pass on a single function.
+ *
+ * @param func Target IR function (prototypes are skipped by the pass).
+ * @return true if the pass modified the function; false otherwise.
+ */
+typedef bool (*IRPassFuncFn)(IRFunc* func);
+
 /**
  * @struct IRPass
  * @brief Describes a single IR pass.
+ *
+ * `run_func` runs the same transformation on one function so the optimizer
+ * can converge each function independently (see ir_optimizer.c).
+ *
+ * `preserves` is an IR_ANALYSIS_* mask (ir_analysis_manager.h) of cached
+ * analyses that stay valid in every function the pass changes.
  */
 typedef struct IRPass {
     const char* name;
     IRPassRunFn run;
+    IRPassFuncFn run_func;
+    uint32_t preserves;
 } IRPass;
 
 /**
  * @brief Run a pass (NULL-safe).
+ *
+ * Brackets the run with the analysis manager so cached analyses the pass
+ * does not preserve are dropped from the functions it changed.
  * @return true if changed; false otherwise.
  */
 bool ir_pass_run(IRPass* pass, IRModule* module);
 
+/**
+ * @brief Run a pass on one function (NULL-safe).
+ *
+ * Same analysis-manager bracketing as ir_pass_run(), limited to @p func.
+ * Touches nothing outside @p func, so different functions may run on different
+ * threads. @p stats (may be NULL) counts the analysis requests of the run.
+ * @return true if changed; false otherwise.
+ */
+bool ir_pass_run_func(IRPass* pass, IRFunc* func, IRAnalysisStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
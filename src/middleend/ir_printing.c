@@ -101,7 +101,7 @@ static void ir_type_print(IRType* type, FILE* out, int use_arabic) {
     }
 }
 
-static int ir_param_index_for_reg(IRFunc* func, int reg_num) {
+static int ir_param_index_for_reg(const IRFunc* func, int reg_num) {
     if (!func) return -1;
     for (int i = 0; i < func->param_count; i++) {
         if (func->params[i].reg == reg_num) return i;
@@ -109,9 +109,6 @@ static int ir_param_index_for_reg(IRFunc* func, int reg_num) {
     return -1;
 }
 
-// Used to print parameter registers as %معامل<n> (instead of %م<n>) when possible.
-static IRFunc* g_ir_print_current_func = NULL;
-
 static void ir_print_dest_reg(FILE* out, int reg_num, int use_arabic) {
     char num_buf[64];
     fputc('%', out);
@@ -123,7 +120,8 @@ static void ir_print_dest_reg(FILE* out, int reg_num, int use_arabic) {
     }
 }
 
-static void ir_value_print_ex(IRValue* val, FILE* out, int use_arabic) {
+// param_func: when non-NULL, parameter registers print as %معامل<n> (instead of %م<n>).
+static void ir_value_print_ex(IRValue* val, FILE* out, int use_arabic, const IRFunc* param_func) {
     if (!val) {
         fputs("null", out);
         return;
@@ -138,7 +136,7 @@ static void ir_value_print_ex(IRValue* val, FILE* out, int use_arabic) {
 
         case IR_VAL_REG: {
             int reg = val->data.reg_num;
-            int param_index = ir_param_index_for_reg(g_ir_print_current_func, reg);
+            int param_index = ir_param_index_for_reg(param_func, reg);
 
             fputc('%', out);
             if (use_arabic) {
@@ -210,13 +208,10 @@ static void ir_value_print_ex(IRValue* val, FILE* out, int use_arabic) {
  * Print a value
  */
 void ir_value_print(IRValue* val, FILE* out, int use_arabic) {
-    ir_value_print_ex(val, out, use_arabic);
+    ir_value_print_ex(val, out, use_arabic, NULL);
 }
 
-/**
- * Print an instruction
- */
-void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
+static void ir_inst_print_ex(IRInst* inst, FILE* out, int use_arabic, const IRFunc* param_func) {
     if (!inst) return;
 
     const char* sep = ir_print_sep(use_arabic);
@@ -247,17 +242,45 @@ void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
 
         case IR_OP_BR:
             fputc(' ', out);
-            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic);
+            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic, param_func);
             fputc('\n', out);
             return;
 
         case IR_OP_BR_COND:
             fputc(' ', out);
-            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic);
-            if (inst->operand_count >= 2) { fputs(sep, out); ir_value_print_ex(inst->operands[1], out, use_arabic); }
-            if (inst->operand_count >= 3) { fputs(sep, out); ir_value_print_ex(inst->operands[2], out, use_arabic); }
+            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic, param_func);
+            if (inst->operand_count >= 2) { fputs(sep, out); ir_value_print_ex(inst->operands[1], out, use_arabic, param_func); }
+            if (inst->operand_count >= 3) { fputs(sep, out); ir_value_print_ex(inst->operands[2], out, use_arabic, param_func); }
+            fputc('\n', out);
+            return;
+
+        case IR_OP_SWITCH: {
+            // تفرع <type> value, default, [ثابت, كتلة]...
+            IRValue* v = (inst->operand_count >= 1) ? inst->operands[0] : NULL;
+            fputc(' ', out);
+            ir_type_print(v ? v->type : NULL, out, use_arabic);
+            fputc(' ', out);
+            if (v) ir_value_print_ex(v, out, use_arabic, param_func);
+            if (inst->operand_count >= 2) { fputs(sep, out); ir_value_print_ex(inst->operands[1], out, use_arabic, param_func); }
+            for (int i = 0; i < inst->switch_case_count; i++) {
+                IRValue tmp_case;
+                tmp_case.kind = IR_VAL_CONST_INT;
+                tmp_case.type = v ? v->type : NULL;
+                tmp_case.data.const_int = inst->switch_cases[i].value;
+                IRValue tmp_block;
+                tmp_block.kind = IR_VAL_BLOCK;
+                tmp_block.type = NULL;
+                tmp_block.data.block = inst->switch_cases[i].target;
+                fputs(sep, out);
+                fputc('[', out);
+                ir_value_print_ex(&tmp_case, out, use_arabic, param_func);
+                fputs(sep, out);
+                ir_value_print_ex(&tmp_block, out, use_arabic, param_func);
+                fputc(']', out);
+            }
             fputc('\n', out);
             return;
+        }
 
         case IR_OP_RET:
             if (inst->operand_count == 0 || !inst->operands[0]) {
@@ -267,7 +290,7 @@ void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
             fputc(' ', out);
             ir_type_print(inst->type ? inst->type : (inst->operands[0] ? inst->operands[0]->type : NULL), out, use_arabic);
             fputc(' ', out);
-            ir_value_print_ex(inst->operands[0], out, use_arabic);
+            ir_value_print_ex(inst->operands[0], out, use_arabic, param_func);
             fputc('\n', out);
             return;
 
@@ -277,7 +300,7 @@ void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
                 fputc('@', out);
                 fputs(inst->call_target, out);
             } else if (inst->call_callee) {
-                ir_value_print_ex(inst->call_callee, out, use_arabic);
+                ir_value_print_ex(inst->call_callee, out, use_arabic, param_func);
             } else {
                 fputs("???", out);
             }
@@ -285,7 +308,7 @@ void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
             for (int i = 0; i < inst->call_arg_count; i++) {
                 if (i > 0) fputs(sep, out);
                 if (inst->call_args && inst->call_args[i]) {
-                    ir_value_print_ex(inst->call_args[i], out, use_arabic);
+                    ir_value_print_ex(inst->call_args[i], out, use_arabic, param_func);
                 }
             }
             fputs(")\n", out);
@@ -303,14 +326,14 @@ void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
                 first = 0;
 
                 fputc('[', out);
-                ir_value_print_ex(entry->value, out, use_arabic);
+                ir_value_print_ex(entry->value, out, use_arabic, param_func);
                 fputs(sep, out);
                 // Avoid allocating a temporary IRValue for printing (prevents print-time leaks).
                 IRValue tmp_block;
                 tmp_block.kind = IR_VAL_BLOCK;
                 tmp_block.type = NULL;
                 tmp_block.data.block = entry->block;
-                ir_value_print_ex(&tmp_block, out, use_arabic);
+                ir_value_print_ex(&tmp_block, out, use_arabic, param_func);
                 fputc(']', out);
 
                 entry = entry->next;
@@ -325,7 +348,7 @@ void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
             IRType* from_t = (inst->operand_count >= 1 && inst->operands[0]) ? inst->operands[0]->type : NULL;
             ir_type_print(from_t, out, use_arabic);
             fputc(' ', out);
-            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic);
+            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic, param_func);
             fputs(use_arabic ? " إلى " : " to ", out);
             ir_type_print(inst->type, out, use_arabic);
             fputc('\n', out);
@@ -344,8 +367,8 @@ void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
             ir_type_print(cmp_type, out, use_arabic);
             fputc(' ', out);
 
-            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic);
-            if (inst->operand_count >= 2) { fputs(sep, out); ir_value_print_ex(inst->operands[1], out, use_arabic); }
+            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic, param_func);
+            if (inst->operand_count >= 2) { fputs(sep, out); ir_value_print_ex(inst->operands[1], out, use_arabic, param_func); }
             fputc('\n', out);
             return;
         }
@@ -366,7 +389,7 @@ void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
             fputc(' ', out);
             ir_type_print(inst->type, out, use_arabic);
             fputs(sep, out);
-            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic);
+            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic, param_func);
             fputc('\n', out);
             return;
 
@@ -380,8 +403,8 @@ void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
             ir_type_print(stored_t, out, use_arabic);
             fputc(' ', out);
 
-            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic);
-            if (inst->operand_count >= 2) { fputs(sep, out); ir_value_print_ex(inst->operands[1], out, use_arabic); }
+            if (inst->operand_count >= 1) ir_value_print_ex(inst->operands[0], out, use_arabic, param_func);
+            if (inst->operand_count >= 2) { fputs(sep, out); ir_value_print_ex(inst->operands[1], out, use_arabic, param_func); }
             fputc('\n', out);
             return;
         }
@@ -400,16 +423,23 @@ void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
 
     for (int i = 0; i < inst->operand_count; i++) {
         if (i > 0) fputs(sep, out);
-        ir_value_print_ex(inst->operands[i], out, use_arabic);
+        ir_value_print_ex(inst->operands[i], out, use_arabic, param_func);
     }
 
     fputc('\n', out);
 }
 
+/**
+ * Print an instruction
+ */
+void ir_inst_print(IRInst* inst, FILE* out, int use_arabic) {
+    ir_inst_print_ex(inst, out, use_arabic, NULL);
+}
+
 /**
  * Print a basic block
  */
-void ir_block_print(IRBlock* block, FILE* out, int use_arabic) {
+static void ir_block_print_ex(IRBlock* block, FILE* out, int use_arabic, const IRFunc* param_func) {
     if (!block) return;
 
     // Print label
@@ -428,11 +458,15 @@ void ir_block_print(IRBlock* block, FILE* out, int use_arabic) {
     // Print instructions
     IRInst* inst = block->first;
     while (inst) {
-        ir_inst_print(inst, out, use_arabic);
+        ir_inst_print_ex(inst, out, use_arabic, param_func);
         inst = inst->next;
     }
 }
 
+void ir_block_print(IRBlock* block, FILE* out, int use_arabic) {
+    ir_block_print_ex(block, out, use_arabic, NULL);
+}
+
 /**
  * Print a function
  */
@@ -481,17 +515,12 @@ void ir_func_print(IRFunc* func, FILE* out, int use_arabic) {
     fputs(" {\n", out);
 
     // Print blocks (enable param printing inside the body)
-    IRFunc* prev = g_ir_print_current_func;
-    g_ir_print_current_func = func;
-
     IRBlock* block = func->blocks;
     while (block) {
-        ir_block_print(block, out, use_arabic);
+        ir_block_print_ex(block, out, use_arabic, func);
         block = block->next;
     }
 
-    g_ir_print_current_func = prev;
-
     fputs("}\n\n", out);
 }
 
@@ -537,7 +566,7 @@ void ir_global_print(IRGlobal* global, FILE* out, int use_arabic) {
             }
 
             if (v) {
-                ir_value_print_ex(v, out, use_arabic);
+                ir_value_print_ex(v, out, use_arabic, NULL);
             } else {
                 (void)elem_t;
                 ir_print_int64(out, 0, use_arabic);
@@ -546,7 +575,7 @@ void ir_global_print(IRGlobal* global, FILE* out, int use_arabic) {
         fputc('}', out);
     } else {
         if (global->init) {
-            ir_value_print_ex(global->init, out, use_arabic);
+            ir_value_print_ex(global->init, out, use_arabic, NULL);
         } else {
             fputs(use_arabic ? "٠" : "0", out);
         }
@@ -571,8 +600,6 @@ const char* ir_module_get_baa_string(IRModule* module, int id) {
 int ir_module_add_baa_string(IRModule* module, const char* str) {
     if (!module || !str) return -1;
 
-    ir_module_set_current(module);
-
     IRBaaStringEntry* entry = module->baa_strings;
     while (entry) {
         if (entry->content && strcmp(entry->content, str) == 0) {
@@ -581,11 +608,11 @@ int ir_module_add_baa_string(IRModule* module, const char* str) {
         entry = entry->next;
     }
 
-    IRBaaStringEntry* new_entry = (IRBaaStringEntry*)ir_alloc(sizeof(IRBaaStringEntry), _Alignof(IRBaaStringEntry));
+    IRBaaStringEntry* new_entry = (IRBaaStringEntry*)ir_alloc(&module->arena, sizeof(IRBaaStringEntry), _Alignof(IRBaaStringEntry));
     if (!new_entry) return -1;
 
     new_entry->id = module->baa_string_count++;
-    new_entry->content = ir_strdup(str);
+    new_entry->content = ir_strdup(&module->arena, str);
     new_entry->next = module->baa_strings;
     module->baa_strings = new_entry;
 
@@ -7,7 +7,7 @@
  * - ونشر الثوابت عبر SSA
  *
  * ثم يُبسّط:
- * - `قفز_شرط` عندما يصبح الشرط ثابتاً
+ * - `قفز_شرط` و`تفرع` عندما تصبح القيمة ثابتة
  * - ويستبدل استعمالات سجلات ثابتة بقيم ثابتة
  *
  * ملاحظة:
@@ -17,6 +17,7 @@
 #include "ir_sccp.h"
 
 #include "ir_analysis.h"
+#include "ir_analysis_manager.h"
 #include "ir_defuse.h"
 #include "ir_mutate.h"
 
@@ -27,9 +28,13 @@
 // IRPass integration
 // -----------------------------------------------------------------------------
 
+static bool ir_sccp_run_func(IRFunc* func);
+
 IRPass IR_PASS_SCCP = {
     .name = "نشر_الثوابت_المتناثر",
     .run = ir_sccp_run,
+    .run_func = ir_sccp_run_func,
+    .preserves = IR_ANALYSIS_NONE
 };
 
 // -----------------------------------------------------------------------------
@@ -151,6 +156,7 @@ typedef struct {
     unsigned char* reachable;     // [max_id]
     unsigned char* fe0;           // [max_id] feasible succ0
     unsigned char* fe1;           // [max_id] feasible succ1
+    IRBlock** sel;                // [max_id] هدف `تفرع` الوحيد حين تكون قيمته ثابتة
     int max_id;
 } SCCPEdges;
 
@@ -164,6 +170,20 @@ static void sccp_set_block_reachable(SCCPEdges* e, IRBlock* b, int* changed)
     }
 }
 
+/**
+ * @brief هدف `تفرع` لقيمة ثابتة: الحالة المطابقة أو الافتراضي.
+ */
+static IRBlock* sccp_switch_target(IRInst* term, int64_t value)
+{
+    if (!term || term->operand_count < 2) return NULL;
+    for (int i = 0; i < term->switch_case_count; i++)
+    {
+        if (term->switch_cases[i].value == value)
+            return term->switch_cases[i].target;
+    }
+    return (term->operands[1] && term->operands[1]->kind == IR_VAL_BLOCK) ? term->operands[1]->data.block : NULL;
+}
+
 static void sccp_mark_term_edges(IRInst* term, SCCPVal* regs, int max_reg, SCCPEdges* edges, int* changed)
 {
     if (!term || !edges) return;
@@ -199,6 +219,22 @@ static void sccp_mark_term_edges(IRInst* term, SCCPVal* regs, int max_reg, SCCPE
             sccp_set_block_reachable(edges, bt, changed);
             sccp_set_block_reachable(edges, bf, changed);
         }
+        return;
+    }
+
+    if (term->op == IR_OP_SWITCH)
+    {
+        if (term->operand_count < 2) return;
+        SCCPVal c = sccp_val_of_value(term->operands[0], regs, max_reg);
+        if (c.kind == SCCP_CONST)
+        {
+            sccp_set_block_reachable(edges, sccp_switch_target(term, c.c), changed);
+            return;
+        }
+        if (term->operands[1] && term->operands[1]->kind == IR_VAL_BLOCK)
+            sccp_set_block_reachable(edges, term->operands[1]->data.block, changed);
+        for (int i = 0; i < term->switch_case_count; i++)
+            sccp_set_block_reachable(edges, term->switch_cases[i].target, changed);
     }
 }
 
@@ -210,6 +246,13 @@ static int sccp_pred_edge_feasible_to(IRBlock* pred, IRBlock* succ, const SCCPEd
     // إذا لم تُبنَ succs بعد: اعتبرها غير معروفة.
     if (pred->succ_count <= 0) return 0;
 
+    // `تفرع`: fe1 = كل الحواف ممكنة، fe0 = الحافة إلى sel فقط.
+    if (pred->last && pred->last->op == IR_OP_SWITCH)
+    {
+        if (edges->fe1[pred->id]) return 1;
+        return (edges->fe0[pred->id] && edges->sel[pred->id] == succ) ? 1 : 0;
+    }
+
     if (pred->succ_count >= 1 && pred->succs[0] == succ)
         return edges->fe0[pred->id] ? 1 : 0;
     if (pred->succ_count >= 2 && pred->succs[1] == succ)
@@ -452,7 +495,33 @@ static int sccp_simplify_brcond(IRFunc* func, IRBlock* b, SCCPVal* regs, int max
     IRBlock* dst = c.c ? bt : bf;
     if (!dst) return 0;
 
-    IRInst* br = ir_inst_br(dst);
+    IRInst* br = ir_inst_br(&func->arena, dst);
+    if (!br) return 0;
+
+    if (term->src_file && term->src_line > 0)
+        ir_inst_set_loc(br, term->src_file, term->src_line, term->src_col);
+    if (term->dbg_name)
+        ir_inst_set_dbg_name(br, term->dbg_name);
+
+    ir_block_remove_inst(b, term);
+    ir_block_append(b, br);
+    return 1;
+}
+
+static int sccp_simplify_switch(IRFunc* func, IRBlock* b, SCCPVal* regs, int max_reg)
+{
+    if (!func || !b || !b->last) return 0;
+    IRInst* term = b->last;
+    if (term->op != IR_OP_SWITCH) return 0;
+    if (term->operand_count < 2) return 0;
+
+    SCCPVal c = sccp_val_of_value(term->operands[0], regs, max_reg);
+    if (c.kind != SCCP_CONST) return 0;
+
+    IRBlock* dst = sccp_switch_target(term, c.c);
+    if (!dst) return 0;
+
+    IRInst* br = ir_inst_br(&func->arena, dst);
     if (!br) return 0;
 
     if (term->src_file && term->src_line > 0)
@@ -470,7 +539,7 @@ static int ir_sccp_func(IRFunc* func)
     if (!func || func->is_prototype) return 0;
     if (!func->entry) return 0;
 
-    ir_func_rebuild_preds(func);
+    ir_analysis_require_preds(func);
 
     int max_reg = func->next_reg;
 
@@ -501,11 +570,13 @@ static int ir_sccp_func(IRFunc* func)
     edges.reachable = (unsigned char*)calloc((size_t)max_id, 1);
     edges.fe0 = (unsigned char*)calloc((size_t)max_id, 1);
     edges.fe1 = (unsigned char*)calloc((size_t)max_id, 1);
-    if (!edges.reachable || !edges.fe0 || !edges.fe1)
+    edges.sel = (IRBlock**)calloc((size_t)max_id, sizeof(IRBlock*));
+    if (!edges.reachable || !edges.fe0 || !edges.fe1 || !edges.sel)
     {
         free(edges.reachable);
         free(edges.fe0);
         free(edges.fe1);
+        free(edges.sel);
         free(regs);
         return 0;
     }
@@ -513,8 +584,6 @@ static int ir_sccp_func(IRFunc* func)
     // entry reachable
     edges.reachable[func->entry->id] = 1;
 
-    int changed_any = 0;
-
     // حلقة تثبيت بسيطة (monotone) مع حد.
     for (int iter = 0; iter < 64; iter++)
     {
@@ -527,8 +596,12 @@ static int ir_sccp_func(IRFunc* func)
             if (!edges.reachable[b->id]) continue;
 
             // افتراض: إن لم يكن المنهي ثابتاً، كل الحواف ممكنة.
+            const unsigned char old_fe0 = edges.fe0[b->id];
+            const unsigned char old_fe1 = edges.fe1[b->id];
+            IRBlock* const old_sel = edges.sel[b->id];
             edges.fe0[b->id] = 0;
             edges.fe1[b->id] = 0;
+            edges.sel[b->id] = NULL;
 
             for (IRInst* inst = b->first; inst; inst = inst->next)
             {
@@ -555,6 +628,21 @@ static int ir_sccp_func(IRFunc* func)
                     sccp_mark_term_edges(inst, regs, max_reg, &edges, &changed);
                     break;
                 }
+                if (inst->op == IR_OP_SWITCH)
+                {
+                    SCCPVal c = sccp_val_of_value(inst->operands[0], regs, max_reg);
+                    if (c.kind == SCCP_CONST)
+                    {
+                        edges.fe0[b->id] = 1;
+                        edges.sel[b->id] = sccp_switch_target(inst, c.c);
+                    }
+                    else
+                    {
+                        edges.fe1[b->id] = 1;
+                    }
+                    sccp_mark_term_edges(inst, regs, max_reg, &edges, &changed);
+                    break;
+                }
                 if (inst->op == IR_OP_RET)
                 {
                     break;
@@ -566,11 +654,14 @@ static int ir_sccp_func(IRFunc* func)
                     changed |= sccp_update(&regs[inst->dest], v);
                 }
             }
+
+            // حافة صارت ممكنة بعد تقييم فاي في كتلة سابقة: يلزم دور آخر.
+            if (edges.fe0[b->id] != old_fe0 || edges.fe1[b->id] != old_fe1 || edges.sel[b->id] != old_sel)
+                changed = 1;
         }
 
         if (!changed)
             break;
-        changed_any = 1;
     }
 
     // تطبيق: استبدال استعمالات السجلات الثابتة
@@ -593,7 +684,7 @@ static int ir_sccp_func(IRFunc* func)
                 IRType* t = cur->type;
                 if (!t) t = IR_TYPE_I64_T;
 
-                *u->slot = ir_value_const_int(sccp_trunc_to_type(regs[r].c, t), t);
+                *u->slot = ir_value_const_int(&func->arena, sccp_trunc_to_type(regs[r].c, t), t);
                 applied = 1;
             }
         }
@@ -604,6 +695,7 @@ static int ir_sccp_func(IRFunc* func)
     {
         if (!b) continue;
         applied |= sccp_simplify_brcond(func, b, regs, max_reg);
+        applied |= sccp_simplify_switch(func, b, regs, max_reg);
     }
 
     if (applied)
@@ -615,15 +707,17 @@ static int ir_sccp_func(IRFunc* func)
     free(edges.reachable);
     free(edges.fe0);
     free(edges.fe1);
+    free(edges.sel);
     free(regs);
 
-    return (changed_any || applied) ? 1 : 0;
+    // تقدّم الشبكة (lattice) أثناء التحليل ليس تغييراً في IR؛ فقط ما طُبِّق يُبلَّغ
+    // وإلا لن تبلغ أي دالة نقطة التثبيت في المُحسِّن.
+    return applied ? 1 : 0;
 }
 
 bool ir_sccp_run(IRModule* module)
 {
     if (!module) return false;
-    ir_module_set_current(module);
 
     int changed = 0;
     for (IRFunc* f = module->funcs; f; f = f->next)
@@ -631,3 +725,8 @@ bool ir_sccp_run(IRModule* module)
 
     return changed ? true : false;
 }
+
+static bool ir_sccp_run_func(IRFunc* func)
+{
+    return ir_sccp_func(func) ? true : false;
+}
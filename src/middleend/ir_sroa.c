@@ -0,0 +1,478 @@
+/**
+ * @file ir_sroa.c
+ * @brief تفكيك المجمّعات إلى قيم مفردة (SROA).
+ *
+ * الخطوات لكل دالة:
+ * 1) تتبّع المؤشرات المشتقة من كل `حجز مصفوفة[...]` عبر `تحويل` و`إزاحة_مؤشر`
+ *    بفهرس ثابت، مع إزاحتها بالبايت من بداية الحجز.
+ * 2) جمع الوصولات (`حمل`/`خزن`) ورفض أي استعمال آخر للمؤشر (هروب).
+ * 3) بناء الشرائح: كل (إزاحة، حجم، نوع) مميز؛ التداخل الجزئي يُلغي التفكيك.
+ * 4) إعادة كتابة كل وصول ليستعمل حجز الشريحة مباشرة، ثم حذف الحجز الأصلي
+ *    وسلسلة اشتقاقه. الحجوزات الجديدة مرشّحة لـ Mem2Reg في نفس الجولة.
+ *
+ * الحجوم تُحسب بتخطيط البيانات الافتراضي (مثل `إزاحة_مؤشر` في isel):
+ * أحجام الأنواع العددية والمؤشرات واحدة في كل الأهداف المدعومة.
+ */
+
+#include "ir_sroa.h"
+#include "ir_data_layout.h"
+#include "ir_mutate.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** أقصى عدد شرائح لحجز واحد؛ ما زاد يبقى في الذاكرة لتفادي ضغط السجلات. */
+#define SROA_MAX_SLICES 64
+
+// -----------------------------------------------------------------------------
+// دمج IRPass
+// -----------------------------------------------------------------------------
+
+static bool ir_sroa_run_func(IRFunc* func);
+
+IRPass IR_PASS_SROA = {
+    .name = "تفكيك_المجمعات",
+    .run = ir_sroa_run,
+    .run_func = ir_sroa_run_func,
+    .preserves = IR_ANALYSIS_CFG_ALL
+};
+
+// -----------------------------------------------------------------------------
+// البنى
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    IRInst* inst;
+    IRBlock* block;
+    int pos;         // ترتيب التعليمة في كتلتها (يُرقَّم مرة واحدة أثناء الجمع)
+    int off;
+    int size;
+    IRType* type;    // نوع القيمة المحمّلة/المخزّنة
+    int addr_index;  // موضع العنوان: 0 في الحمل، 1 في الخزن
+    int slice;       // -1 = تصفير بايت لا يقرؤه أحد (يُحذف)
+    bool fill;       // `خزن ص٨ ٠` داخل شريحة أعرض (تصفير الهيكل)
+} SroaAccess;
+
+typedef struct {
+    int off;
+    int size;
+    IRType* type;
+    int fill_count;
+    IRInst* last_fill;  // آخر خزن تصفير للشريحة (يصبح خزن صفر بنوعها)
+    int reg;            // سجل الحجز الجديد
+} SroaSlice;
+
+typedef struct {
+    IRInst* alloca_inst;
+    IRBlock* block;
+    int size;
+    bool bad;
+
+    SroaAccess* acc;
+    int acc_count;
+    int acc_cap;
+} SroaCand;
+
+typedef struct {
+    IRFunc* func;
+    int nregs;
+    int* cand_of;     // سجل → فهرس المرشح (-1 = غير متتبَّع)
+    int64_t* off_of;  // سجل → الإزاحة بالبايت من بداية الحجز
+    SroaCand* cands;
+    int cand_count;
+} SroaCtx;
+
+// -----------------------------------------------------------------------------
+// مساعدات
+// -----------------------------------------------------------------------------
+
+static int sroa_tracked(SroaCtx* ctx, IRValue* v) {
+    if (!v || v->kind != IR_VAL_REG) return -1;
+    int r = v->data.reg_num;
+    if (r < 0 || r >= ctx->nregs) return -1;
+    return ctx->cand_of[r];
+}
+
+static void sroa_escape(SroaCtx* ctx, IRValue* v) {
+    int c = sroa_tracked(ctx, v);
+    if (c >= 0) ctx->cands[c].bad = true;
+}
+
+static int sroa_is_byte_zero_store(IRInst* inst) {
+    if (!inst || inst->op != IR_OP_STORE || inst->operand_count < 2) return 0;
+    IRValue* v = inst->operands[0];
+    return v && v->kind == IR_VAL_CONST_INT && v->data.const_int == 0 &&
+           v->type && v->type->kind == IR_TYPE_I8;
+}
+
+static void sroa_add_access(SroaCtx* ctx, int c, IRInst* inst, IRBlock* block, int pos,
+                            int addr_index, IRType* type) {
+    SroaCand* cand = &ctx->cands[c];
+    if (cand->bad) return;
+
+    // الشرائح قيم مفردة فقط؛ حمل/خزن مجمّع كامل يبقى في الذاكرة.
+    if (!type || type->kind == IR_TYPE_ARRAY || type->kind == IR_TYPE_VOID || type->kind == IR_TYPE_FUNC) {
+        cand->bad = true;
+        return;
+    }
+
+    int addr_reg = inst->operands[addr_index]->data.reg_num;
+    int64_t off = ctx->off_of[addr_reg];
+    int size = ir_type_store_size(NULL, type);
+    if (size <= 0 || off < 0 || off + size > cand->size) {
+        cand->bad = true;
+        return;
+    }
+
+    if (cand->acc_count >= cand->acc_cap) {
+        int new_cap = cand->acc_cap ? cand->acc_cap * 2 : 8;
+        SroaAccess* arr = (SroaAccess*)realloc(cand->acc, (size_t)new_cap * sizeof(SroaAccess));
+        if (!arr) {
+            cand->bad = true;
+            return;
+        }
+        cand->acc = arr;
+        cand->acc_cap = new_cap;
+    }
+
+    SroaAccess* a = &cand->acc[cand->acc_count++];
+    memset(a, 0, sizeof(*a));
+    a->inst = inst;
+    a->block = block;
+    a->pos = pos;
+    a->off = (int)off;
+    a->size = size;
+    a->type = type;
+    a->addr_index = addr_index;
+    a->slice = -1;
+}
+
+// -----------------------------------------------------------------------------
+// 1) تتبّع المؤشرات المشتقة
+// -----------------------------------------------------------------------------
+
+static void sroa_track_derived(SroaCtx* ctx) {
+    bool grew = true;
+    while (grew) {
+        grew = false;
+        for (IRBlock* b = ctx->func->blocks; b; b = b->next) {
+            for (IRInst* inst = b->first; inst; inst = inst->next) {
+                if (inst->op != IR_OP_CAST && inst->op != IR_OP_PTR_OFFSET) continue;
+                if (inst->dest < 0 || inst->dest >= ctx->nregs) continue;
+                if (ctx->cand_of[inst->dest] >= 0) continue;
+                if (inst->operand_count < 1) continue;
+
+                int c = sroa_tracked(ctx, inst->operands[0]);
+                if (c < 0 || ctx->cands[c].bad) continue;
+
+                // تحويل المؤشر إلى عدد يعني أن العنوان نفسه صار قيمة.
+                if (!inst->type || inst->type->kind != IR_TYPE_PTR || !inst->type->data.pointee) {
+                    ctx->cands[c].bad = true;
+                    continue;
+                }
+
+                int64_t off = ctx->off_of[inst->operands[0]->data.reg_num];
+                if (inst->op == IR_OP_PTR_OFFSET) {
+                    IRValue* idx = (inst->operand_count >= 2) ? inst->operands[1] : NULL;
+                    if (!idx || idx->kind != IR_VAL_CONST_INT) {
+                        ctx->cands[c].bad = true;
+                        continue;
+                    }
+                    int elem = ir_type_store_size(NULL, inst->type->data.pointee);
+                    if (elem <= 0) elem = 1;
+                    off += idx->data.const_int * (int64_t)elem;
+                }
+
+                ctx->cand_of[inst->dest] = c;
+                ctx->off_of[inst->dest] = off;
+                grew = true;
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// 2) جمع الوصولات ورفض الهروب
+// -----------------------------------------------------------------------------
+
+static void sroa_collect_uses(SroaCtx* ctx) {
+    for (IRBlock* b = ctx->func->blocks; b; b = b->next) {
+        int pos = 0;
+        for (IRInst* inst = b->first; inst; inst = inst->next, pos++) {
+            switch (inst->op) {
+                case IR_OP_LOAD: {
+                    int c = (inst->operand_count >= 1) ? sroa_tracked(ctx, inst->operands[0]) : -1;
+                    if (c >= 0) sroa_add_access(ctx, c, inst, b, pos, 0, inst->type);
+                    break;
+                }
+
+                case IR_OP_STORE: {
+                    if (inst->operand_count < 2) break;
+                    sroa_escape(ctx, inst->operands[0]);
+                    int c = sroa_tracked(ctx, inst->operands[1]);
+                    if (c >= 0) sroa_add_access(ctx, c, inst, b, pos, 1, inst->operands[0] ? inst->operands[0]->type : NULL);
+                    break;
+                }
+
+                case IR_OP_CAST:
+                case IR_OP_PTR_OFFSET:
+                    // القاعدة عولجت أثناء التتبّع؛ الفهرس لا يجوز أن يكون مؤشراً متتبَّعاً.
+                    for (int i = 1; i < inst->operand_count; i++) sroa_escape(ctx, inst->operands[i]);
+                    break;
+
+                default:
+                    for (int i = 0; i < inst->operand_count; i++) sroa_escape(ctx, inst->operands[i]);
+                    break;
+            }
+
+            if (inst->op == IR_OP_CALL) {
+                sroa_escape(ctx, inst->call_callee);
+                for (int i = 0; i < inst->call_arg_count; i++) {
+                    if (inst->call_args) sroa_escape(ctx, inst->call_args[i]);
+                }
+            }
+            if (inst->op == IR_OP_PHI) {
+                for (IRPhiEntry* e = inst->phi_entries; e; e = e->next) sroa_escape(ctx, e->value);
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// 3) بناء الشرائح
+// -----------------------------------------------------------------------------
+
+static int sroa_build_slices(SroaCand* cand, SroaSlice* slices) {
+    int count = 0;
+
+    for (int i = 0; i < cand->acc_count; i++) {
+        SroaAccess* a = &cand->acc[i];
+        if (sroa_is_byte_zero_store(a->inst)) continue;
+
+        int found = -1;
+        for (int s = 0; s < count; s++) {
+            if (slices[s].off == a->off) {
+                found = s;
+                break;
+            }
+            if (a->off < slices[s].off + slices[s].size && slices[s].off < a->off + a->size) return -1;
+        }
+
+        if (found >= 0) {
+            if (slices[found].size != a->size || !ir_types_equal(slices[found].type, a->type)) return -1;
+            a->slice = found;
+            continue;
+        }
+
+        if (count >= SROA_MAX_SLICES) return -1;
+        memset(&slices[count], 0, sizeof(slices[count]));
+        slices[count].off = a->off;
+        slices[count].size = a->size;
+        slices[count].type = a->type;
+        a->slice = count++;
+    }
+
+    // تصفير البايتات: إما خزن عادي لشريحة ص٨، أو جزء من تصفير شريحة أعرض، أو ميت.
+    for (int i = 0; i < cand->acc_count; i++) {
+        SroaAccess* a = &cand->acc[i];
+        if (!sroa_is_byte_zero_store(a->inst)) continue;
+
+        a->slice = -1;
+        for (int s = 0; s < count; s++) {
+            if (a->off >= slices[s].off && a->off < slices[s].off + slices[s].size) {
+                a->slice = s;
+                break;
+            }
+        }
+        if (a->slice < 0) continue;
+
+        SroaSlice* sl = &slices[a->slice];
+        if (sl->size == 1 && ir_types_equal(sl->type, a->type)) continue;
+        a->fill = true;
+        sl->fill_count++;
+    }
+
+    // كل شريحة مصفّرة يجب أن تُصفَّر بالكامل في كتلة واحدة دون وصول لها في المنتصف.
+    for (int s = 0; s < count; s++) {
+        SroaSlice* sl = &slices[s];
+        if (sl->fill_count == 0) continue;
+        if (sl->fill_count != sl->size || sl->size > 64) return -1;
+
+        uint64_t bytes = 0;
+        IRBlock* block = NULL;
+        int first = -1, last = -1;
+        for (int i = 0; i < cand->acc_count; i++) {
+            SroaAccess* a = &cand->acc[i];
+            if (!a->fill || a->slice != s) continue;
+            uint64_t bit = (uint64_t)1 << (a->off - sl->off);
+            if (bytes & bit) return -1;
+            bytes |= bit;
+            if (block && block != a->block) return -1;
+            block = a->block;
+
+            if (first < 0 || a->pos < first) first = a->pos;
+            if (a->pos > last) {
+                last = a->pos;
+                sl->last_fill = a->inst;
+            }
+        }
+
+        for (int i = 0; i < cand->acc_count; i++) {
+            SroaAccess* a = &cand->acc[i];
+            if (a->fill || a->slice != s || a->block != block) continue;
+            if (a->pos > first && a->pos < last) return -1;
+        }
+    }
+
+    return count;
+}
+
+// -----------------------------------------------------------------------------
+// 4) إعادة الكتابة
+// -----------------------------------------------------------------------------
+
+static void sroa_set_operand(IRInst* inst, int index, IRValue* v) {
+    if (inst->operands[index]) ir_value_free(inst->operands[index]);
+    inst->operands[index] = v;
+}
+
+static void sroa_rewrite(SroaCtx* ctx, int c, SroaSlice* slices, int slice_count) {
+    SroaCand* cand = &ctx->cands[c];
+    IRInst* orig = cand->alloca_inst;
+
+    for (int s = 0; s < slice_count; s++) {
+        slices[s].reg = ir_func_alloc_reg(ctx->func);
+        IRInst* a = ir_inst_alloca(&ctx->func->arena, slices[s].type, slices[s].reg);
+        if (!a) {
+            slices[s].reg = -1;
+            continue;
+        }
+        ir_inst_set_loc(a, orig->src_file, orig->src_line, orig->src_col);
+        ir_block_insert_before(cand->block, orig, a);
+    }
+
+    for (int i = 0; i < cand->acc_count; i++) {
+        SroaAccess* a = &cand->acc[i];
+        if (a->slice < 0 || (a->fill && a->inst != slices[a->slice].last_fill)) {
+            ir_block_remove_inst(a->block, a->inst);
+            continue;
+        }
+
+        SroaSlice* sl = &slices[a->slice];
+        IRType* ptr_t = ir_type_ptr(&ctx->func->arena, sl->type);
+        if (a->fill) {
+            sroa_set_operand(a->inst, 0, ir_value_const_int(&ctx->func->arena, 0, sl->type));
+        }
+        sroa_set_operand(a->inst, a->addr_index, ir_value_reg(&ctx->func->arena, sl->reg, ptr_t));
+    }
+
+    // سلسلة الاشتقاق لم يعد لها مستعمل.
+    for (IRBlock* b = ctx->func->blocks; b; b = b->next) {
+        IRInst* inst = b->first;
+        while (inst) {
+            IRInst* next = inst->next;
+            if ((inst->op == IR_OP_CAST || inst->op == IR_OP_PTR_OFFSET) &&
+                inst->dest >= 0 && inst->dest < ctx->nregs && ctx->cand_of[inst->dest] == c) {
+                ir_block_remove_inst(b, inst);
+            }
+            inst = next;
+        }
+    }
+
+    ir_block_remove_inst(cand->block, orig);
+}
+
+// -----------------------------------------------------------------------------
+// النواة
+// -----------------------------------------------------------------------------
+
+static int ir_sroa_func(IRFunc* func) {
+    if (!func || func->is_prototype || !func->entry) return 0;
+
+    SroaCtx ctx = {0};
+    ctx.func = func;
+
+    int cand_cap = 0;
+    for (IRBlock* b = func->blocks; b; b = b->next) {
+        for (IRInst* inst = b->first; inst; inst = inst->next) {
+            if (inst->op != IR_OP_ALLOCA || inst->dest < 0) continue;
+            IRType* pointee = (inst->type && inst->type->kind == IR_TYPE_PTR) ? inst->type->data.pointee : NULL;
+            if (!pointee || pointee->kind != IR_TYPE_ARRAY) continue;
+
+            if (ctx.cand_count >= cand_cap) {
+                int new_cap = cand_cap ? cand_cap * 2 : 4;
+                SroaCand* arr = (SroaCand*)realloc(ctx.cands, (size_t)new_cap * sizeof(SroaCand));
+                if (!arr) break;
+                ctx.cands = arr;
+                cand_cap = new_cap;
+            }
+            SroaCand* cand = &ctx.cands[ctx.cand_count++];
+            memset(cand, 0, sizeof(*cand));
+            cand->alloca_inst = inst;
+            cand->block = b;
+            cand->size = ir_type_store_size(NULL, pointee);
+            if (cand->size <= 0) cand->bad = true;
+        }
+    }
+
+    if (ctx.cand_count == 0) {
+        free(ctx.cands);
+        return 0;
+    }
+
+    ctx.nregs = func->next_reg > 0 ? func->next_reg : 1;
+    ctx.cand_of = (int*)malloc((size_t)ctx.nregs * sizeof(int));
+    ctx.off_of = (int64_t*)calloc((size_t)ctx.nregs, sizeof(int64_t));
+    SroaSlice* slices = (SroaSlice*)malloc(SROA_MAX_SLICES * sizeof(SroaSlice));
+    if (!ctx.cand_of || !ctx.off_of || !slices) {
+        free(ctx.cand_of);
+        free(ctx.off_of);
+        free(slices);
+        free(ctx.cands);
+        return 0;
+    }
+
+    for (int r = 0; r < ctx.nregs; r++) ctx.cand_of[r] = -1;
+    for (int c = 0; c < ctx.cand_count; c++) {
+        int r = ctx.cands[c].alloca_inst->dest;
+        if (r < ctx.nregs) ctx.cand_of[r] = c;
+    }
+
+    sroa_track_derived(&ctx);
+    sroa_collect_uses(&ctx);
+
+    int changed = 0;
+    for (int c = 0; c < ctx.cand_count; c++) {
+        if (ctx.cands[c].bad) continue;
+        int slice_count = sroa_build_slices(&ctx.cands[c], slices);
+        if (slice_count < 0) continue;
+        sroa_rewrite(&ctx, c, slices, slice_count);
+        changed = 1;
+    }
+
+    for (int c = 0; c < ctx.cand_count; c++) free(ctx.cands[c].acc);
+    free(ctx.cands);
+    free(ctx.cand_of);
+    free(ctx.off_of);
+    free(slices);
+    return changed;
+}
+
+// -----------------------------------------------------------------------------
+// الواجهة العامة
+// -----------------------------------------------------------------------------
+
+bool ir_sroa_run(IRModule* module) {
+    if (!module) return false;
+
+    int changed = 0;
+    for (IRFunc* f = module->funcs; f; f = f->next) {
+        changed |= ir_sroa_func(f);
+    }
+    return changed ? true : false;
+}
+
+static bool ir_sroa_run_func(IRFunc* func) {
+    return ir_sroa_func(func) ? true : false;
+}
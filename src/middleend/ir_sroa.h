@@ -0,0 +1,43 @@
+/**
+ * @file ir_sroa.h
+ * @brief تفكيك المجمّعات إلى قيم مفردة (SROA) — Scalar Replacement of Aggregates.
+ *
+ * الهياكل والمصفوفات المحلية تُخفَّض إلى `حجز مصفوفة[...]` يُوصل إلى حقولها عبر
+ * سلسلة `تحويل`/`إزاحة_مؤشر` بفهارس ثابتة. هذه التمريرة تستبدل كل حجز كهذا بحجز
+ * مستقل لكل حقل (شريحة) يُقرأ/يُكتب، فتستطيع Mem2Reg بعدها ترقية الحقول إلى SSA.
+ *
+ * قيود السلامة:
+ * - كل استعمال للمؤشر ومشتقاته يجب أن يكون `حمل`/`خزن` (كعنوان) أو `تحويل` إلى
+ *   مؤشر أو `إزاحة_مؤشر` بفهرس ثابت؛ أي نداء/فاي/تخزين للمؤشر نفسه يعني الهروب.
+ * - الوصولات المتداخلة جزئياً غير مسموحة، إلا تصفير البايتات (`خزن ص٨ ٠`) الذي
+ *   يسبق تهيئة الهيكل: يُدمج في خزن صفر واحد بنوع الحقل إن غطّى كل بايتاته.
+ */
+
+#ifndef BAA_IR_SROA_H
+#define BAA_IR_SROA_H
+
+#include <stdbool.h>
+
+#include "ir.h"
+#include "ir_pass.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief تشغيل تمريرة SROA على وحدة IR كاملة.
+ * @return true إذا تم تعديل الـ IR؛ false خلاف ذلك.
+ */
+bool ir_sroa_run(IRModule* module);
+
+/**
+ * @brief واصف التمريرة لاستخدامه ضمن خط أنابيب المُحسِّن.
+ */
+extern IRPass IR_PASS_SROA;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BAA_IR_SROA_H
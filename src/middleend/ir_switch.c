@@ -0,0 +1,243 @@
+/**
+ * @file ir_switch.c
+ * @brief خفض `تفرع` قبل اختيار التعليمات.
+ *
+ * تبقى `تفرع` تعليمة واحدة طوال التحسين، ثم يُقرر شكلها النهائي هنا:
+ * - الحالات الكثيفة تبقى `تفرع`، ويخفضها isel إلى فحص حدود وقفز عبر جدول.
+ * - المتفرقة تُفك إلى شجرة بحث ثنائي من `قارن` و`قفز_شرط`، ويُقارن آخر
+ *   IR_SWITCH_LINEAR_MAX_CASES حالات خطياً؛ وأي مدى كثيف داخل الشجرة يصبح
+ *   `تفرع` أصغر بجدوله الخاص.
+ *
+ * يعمل بعد الخروج من SSA، فلا توجد `فاي` في الأهداف تحتاج تحديثاً.
+ */
+
+#include "ir_switch.h"
+
+#include "ir_analysis.h"
+#include "ir_defuse.h"
+#include "ir_mutate.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool ir_switch_type_is_unsigned(const IRType* t)
+{
+    return t && (t->kind == IR_TYPE_U8 || t->kind == IR_TYPE_U16 ||
+                 t->kind == IR_TYPE_U32 || t->kind == IR_TYPE_U64);
+}
+
+static IRType* ir_switch_value_type(const IRInst* sw)
+{
+    IRValue* v = (sw && sw->operand_count > 0) ? sw->operands[0] : NULL;
+    return (v && v->type) ? v->type : IR_TYPE_I64_T;
+}
+
+/**
+ * @brief هل تصلح حالات مرتبة أو غير مرتبة لجدول واحد؟
+ */
+static bool ir_switch_cases_use_table(const IRSwitchCase* cases, int count, bool is_unsigned,
+                                      int64_t* out_min, int64_t* out_entries)
+{
+    if (!cases || count < IR_SWITCH_TABLE_MIN_CASES) return false;
+
+    int64_t lo = cases[0].value;
+    int64_t hi = cases[0].value;
+    for (int i = 0; i < count; i++) {
+        int64_t v = cases[i].value;
+        if (v < (int64_t)INT32_MIN || v > (int64_t)INT32_MAX) return false;
+        if (is_unsigned && v < 0) return false;
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+    }
+
+    int64_t entries = hi - lo + 1;
+    if (entries > IR_SWITCH_TABLE_MAX_ENTRIES) return false;
+    if ((int64_t)count * 100 < entries * IR_SWITCH_TABLE_MIN_DENSITY) return false;
+
+    if (out_min) *out_min = lo;
+    if (out_entries) *out_entries = entries;
+    return true;
+}
+
+bool ir_switch_use_table(const IRInst* sw, int64_t* out_min, int64_t* out_entries)
+{
+    if (!sw || sw->op != IR_OP_SWITCH) return false;
+    return ir_switch_cases_use_table(sw->switch_cases, sw->switch_case_count,
+                                     ir_switch_type_is_unsigned(ir_switch_value_type(sw)),
+                                     out_min, out_entries);
+}
+
+// -----------------------------------------------------------------------------
+// شجرة البحث الثنائي
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    IRFunc* func;
+    IRInst* origin;         // `تفرع` الأصلي (القيمة وموقع المصدر)
+    IRType* type;
+    bool is_unsigned;
+    IRBlock* default_target;
+    int origin_block_id;
+    int seq;                // عداد أسماء الكتل الجديدة
+} SwitchExpand;
+
+static int ir_switch_case_cmp_signed(const void* a, const void* b)
+{
+    int64_t x = ((const IRSwitchCase*)a)->value;
+    int64_t y = ((const IRSwitchCase*)b)->value;
+    return (x > y) - (x < y);
+}
+
+static int ir_switch_case_cmp_unsigned(const void* a, const void* b)
+{
+    uint64_t x = (uint64_t)((const IRSwitchCase*)a)->value;
+    uint64_t y = (uint64_t)((const IRSwitchCase*)b)->value;
+    return (x > y) - (x < y);
+}
+
+static IRValue* ir_switch_value(const SwitchExpand* ex)
+{
+    IRValue* v = ex->origin->operands[0];
+    if (v->kind == IR_VAL_CONST_INT) return ir_value_const_int(&ex->func->arena, v->data.const_int, ex->type);
+    return ir_value_reg(&ex->func->arena, v->data.reg_num, ex->type);
+}
+
+static void ir_switch_append(const SwitchExpand* ex, IRBlock* block, IRInst* inst)
+{
+    const IRInst* o = ex->origin;
+    if (o->src_file && o->src_line > 0) {
+        ir_inst_set_loc(inst, o->src_file, o->src_line, o->src_col);
+    }
+    ir_block_append(block, inst);
+}
+
+static IRBlock* ir_switch_new_block(SwitchExpand* ex)
+{
+    char label[96];
+    snprintf(label, sizeof(label), "تفرع_%d_%d", ex->origin_block_id, ex->seq++);
+    return ir_func_new_block(ex->func, label);
+}
+
+/**
+ * @brief إصدار `v == value` أو `v < value` وقفز_شرط على نتيجته.
+ */
+static bool ir_switch_emit_test(SwitchExpand* ex, IRBlock* at, IRCmpPred pred, int64_t value,
+                                IRBlock* if_true, IRBlock* if_false)
+{
+    int r = ir_func_alloc_reg(ex->func);
+    IRInst* cmp = ir_inst_cmp(&ex->func->arena, pred, r, ir_switch_value(ex),
+                              ir_value_const_int(&ex->func->arena, value, ex->type));
+    if (!cmp) return false;
+    ir_switch_append(ex, at, cmp);
+
+    IRInst* br = ir_inst_br_cond(&ex->func->arena, ir_value_reg(&ex->func->arena, r, IR_TYPE_I1_T),
+                                 if_true, if_false);
+    if (!br) return false;
+    ir_switch_append(ex, at, br);
+    return true;
+}
+
+/**
+ * @brief إنهاء الكتلة at بتوزيع الحالات cases[0..count) (مرتبة) على أهدافها.
+ */
+static bool ir_switch_emit_range(SwitchExpand* ex, IRBlock* at, IRSwitchCase* cases, int count)
+{
+    if (ir_switch_cases_use_table(cases, count, ex->is_unsigned, NULL, NULL)) {
+        IRInst* sw = ir_inst_switch(&ex->func->arena, ir_switch_value(ex), ex->default_target);
+        if (!sw) return false;
+        for (int i = 0; i < count; i++) {
+            ir_inst_switch_add_case(&ex->func->arena, sw, cases[i].value, cases[i].target);
+        }
+        ir_switch_append(ex, at, sw);
+        return true;
+    }
+
+    if (count <= IR_SWITCH_LINEAR_MAX_CASES) {
+        for (int i = 0; i < count; i++) {
+            IRBlock* next = ex->default_target;
+            if (i + 1 < count) {
+                next = ir_switch_new_block(ex);
+                if (!next) return false;
+            }
+            if (!ir_switch_emit_test(ex, at, IR_CMP_EQ, cases[i].value, cases[i].target, next)) {
+                return false;
+            }
+            at = next;
+        }
+        if (count == 0) {
+            IRInst* br = ir_inst_br(&ex->func->arena, ex->default_target);
+            if (!br) return false;
+            ir_switch_append(ex, at, br);
+        }
+        return true;
+    }
+
+    int mid = count / 2;
+    IRBlock* left = ir_switch_new_block(ex);
+    IRBlock* right = ir_switch_new_block(ex);
+    if (!left || !right) return false;
+    if (!ir_switch_emit_test(ex, at, ex->is_unsigned ? IR_CMP_ULT : IR_CMP_LT, cases[mid].value,
+                             left, right)) {
+        return false;
+    }
+    return ir_switch_emit_range(ex, left, cases, mid) &&
+           ir_switch_emit_range(ex, right, cases + mid, count - mid);
+}
+
+static bool ir_switch_expand(IRFunc* func, IRBlock* block, IRInst* sw)
+{
+    IRBlock* def = (sw->operands[1] && sw->operands[1]->kind == IR_VAL_BLOCK)
+                       ? sw->operands[1]->data.block
+                       : NULL;
+    IRValue* v = sw->operands[0];
+    if (!def || !v || (v->kind != IR_VAL_REG && v->kind != IR_VAL_CONST_INT)) return false;
+
+    SwitchExpand ex = {0};
+    ex.func = func;
+    ex.origin = sw;
+    ex.type = ir_switch_value_type(sw);
+    ex.is_unsigned = ir_switch_type_is_unsigned(ex.type);
+    ex.default_target = def;
+    ex.origin_block_id = block->id;
+
+    IRSwitchCase* cases = NULL;
+    if (sw->switch_case_count > 0) {
+        cases = (IRSwitchCase*)malloc((size_t)sw->switch_case_count * sizeof(IRSwitchCase));
+        if (!cases) return false;
+        memcpy(cases, sw->switch_cases, (size_t)sw->switch_case_count * sizeof(IRSwitchCase));
+        qsort(cases, (size_t)sw->switch_case_count, sizeof(IRSwitchCase),
+              ex.is_unsigned ? ir_switch_case_cmp_unsigned : ir_switch_case_cmp_signed);
+    }
+
+    // الأصل يبقى مرجعاً للقيمة والموقع حتى ينتهي البناء.
+    ir_block_remove_inst(block, sw);
+    bool ok = ir_switch_emit_range(&ex, block, cases, sw->switch_case_count);
+    free(cases);
+    return ok;
+}
+
+bool ir_switch_lower_func(IRFunc* func)
+{
+    if (!func || func->is_prototype) return false;
+
+    bool changed = false;
+    IRBlock* last = NULL;
+    for (IRBlock* b = func->blocks; b; b = b->next) last = b;
+
+    // الكتل الجديدة تُلحق بنهاية الدالة ولا تحتاج فكاً مرة أخرى.
+    for (IRBlock* b = func->blocks; b; b = b->next) {
+        IRInst* term = b->last;
+        if (term && term->op == IR_OP_SWITCH && !ir_switch_use_table(term, NULL, NULL) &&
+            term->operand_count >= 2) {
+            if (ir_switch_expand(func, b, term)) changed = true;
+        }
+        if (b == last) break;
+    }
+
+    if (changed) {
+        ir_func_rebuild_preds(func);
+        ir_func_invalidate_defuse(func);
+    }
+    return changed;
+}
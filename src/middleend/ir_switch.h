@@ -0,0 +1,52 @@
+/**
+ * @file ir_switch.h
+ * @brief سياسة خفض `تفرع`: جدول قفز للحالات الكثيفة وبحث ثنائي للمتفرقة.
+ */
+
+#ifndef BAA_IR_SWITCH_H
+#define BAA_IR_SWITCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ir.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// أقل عدد حالات يستحق جدول قفز.
+#define IR_SWITCH_TABLE_MIN_CASES 4
+// أقصى عدد مدخلات في جدول واحد.
+#define IR_SWITCH_TABLE_MAX_ENTRIES 4096
+// أقل كثافة (نسبة مئوية من الحالات إلى مدى القيم) لجدول القفز.
+#define IR_SWITCH_TABLE_MIN_DENSITY 40
+// مدى الحالات الذي يُقارن خطياً بدل تقسيمه مرة أخرى.
+#define IR_SWITCH_LINEAR_MAX_CASES 3
+
+/**
+ * @brief هل يُخفض `تفرع` إلى جدول قفز؟
+ *
+ * يشترط عدداً كافياً من الحالات، وكثافة لا تقل عن IR_SWITCH_TABLE_MIN_DENSITY،
+ * وقيماً ضمن مدى int32 (غير سالبة للأنواع بلا إشارة).
+ *
+ * @param out_min أصغر قيمة حالة (أول مدخل في الجدول).
+ * @param out_entries عدد مدخلات الجدول (max - min + 1).
+ */
+bool ir_switch_use_table(const IRInst* sw, int64_t* out_min, int64_t* out_entries);
+
+/**
+ * @brief فك كل `تفرع` متفرق في الدالة إلى شجرة بحث ثنائي.
+ *
+ * المدى الكثيف داخل الشجرة يصبح `تفرع` أصغر يُخفض إلى جدول. يُستدعى بعد
+ * الخروج من SSA (لا `فاي` في الأهداف) وقبل اختيار التعليمات.
+ *
+ * @return true إن تغيّرت الدالة.
+ */
+bool ir_switch_lower_func(IRFunc* func);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BAA_IR_SWITCH_H
@@ -309,6 +309,23 @@ static void ir_text_write_inst(FILE* out, IRInst* inst) {
             if (inst->operand_count >= 3) { fputs(", ", out); ir_text_write_value(out, inst->operands[2]); }
             break;
 
+        case IR_OP_SWITCH: {
+            // switch <type> <value>, %blockD, [<int>, %blockN]...
+            IRValue* v = (inst->operand_count >= 1) ? inst->operands[0] : NULL;
+            fputc(' ', out);
+            ir_text_write_type(out, v ? v->type : NULL);
+            fputc(' ', out);
+            if (v) ir_text_write_value(out, v);
+            if (inst->operand_count >= 2) { fputs(", ", out); ir_text_write_value(out, inst->operands[1]); }
+            for (int i = 0; i < inst->switch_case_count; i++) {
+                const IRSwitchCase* c = &inst->switch_cases[i];
+                fprintf(out, ", [%lld, ", (long long)c->value);
+                if (c->target) fprintf(out, "%%block%d]", c->target->id);
+                else fputs("%block?]", out);
+            }
+            break;
+        }
+
         case IR_OP_RET:
             fputc(' ', out);
             if (inst->type && inst->type->kind == IR_TYPE_VOID) {
@@ -662,7 +679,7 @@ static IRBlock* ir_text_get_or_create_block(IRFunc* func, IRTextBlockMap* map, i
 
     char label[64];
     snprintf(label, sizeof(label), "block%d", id);
-    IRBlock* b = ir_block_new(label, id);
+    IRBlock* b = ir_block_new(&func->arena, label, id);
     if (!b) return NULL;
     ir_func_add_block(func, b);
     map->blocks[id] = b;
@@ -692,6 +709,7 @@ static IROp ir_text_parse_op(const char* op) {
     if (strcmp(op, "shr") == 0) return IR_OP_SHR;
     if (strcmp(op, "br") == 0) return IR_OP_BR;
     if (strcmp(op, "br.cond") == 0) return IR_OP_BR_COND;
+    if (strcmp(op, "switch") == 0) return IR_OP_SWITCH;
     if (strcmp(op, "ret") == 0) return IR_OP_RET;
     if (strcmp(op, "call") == 0) return IR_OP_CALL;
     if (strcmp(op, "phi") == 0) return IR_OP_PHI;
@@ -718,7 +736,7 @@ static IRCmpPred ir_text_parse_pred(const char* s) {
     return IR_CMP_EQ;
 }
 
-static IRType* ir_text_parse_type_rec(const char** p);
+static IRType* ir_text_parse_type_rec(IRArena* arena, const char** p);
 
 static IRType* ir_text_parse_primitive_type(const char* tok) {
     if (!tok) return NULL;
@@ -737,27 +755,27 @@ static IRType* ir_text_parse_primitive_type(const char* tok) {
     return NULL;
 }
 
-static IRType* ir_text_parse_type_rec(const char** p) {
+static IRType* ir_text_parse_type_rec(IRArena* arena, const char** p) {
     ir_text_skip_ws(p);
 
     // ptr<...>
     if (ir_text_match(p, "ptr<")) {
-        IRType* inner = ir_text_parse_type_rec(p);
+        IRType* inner = ir_text_parse_type_rec(arena, p);
         ir_text_skip_ws(p);
         if (!ir_text_match(p, ">")) return NULL;
-        return ir_type_ptr(inner);
+        return ir_type_ptr(arena, inner);
     }
 
     // array<type, n>
     if (ir_text_match(p, "array<")) {
-        IRType* elem = ir_text_parse_type_rec(p);
+        IRType* elem = ir_text_parse_type_rec(arena, p);
         ir_text_skip_ws(p);
         if (!ir_text_match(p, ",")) return NULL;
         int count = 0;
         if (!ir_text_parse_int32(p, &count)) return NULL;
         ir_text_skip_ws(p);
         if (!ir_text_match(p, ">")) return NULL;
-        return ir_type_array(elem, count);
+        return ir_type_array(arena, elem, count);
     }
 
     // func(t1, t2) -> tret
@@ -769,7 +787,7 @@ static IRType* ir_text_parse_type_rec(const char** p) {
         if (!ir_text_match(p, ")")) {
             while (1) {
                 if (pc >= 64) return NULL;
-                IRType* pt = ir_text_parse_type_rec(p);
+                IRType* pt = ir_text_parse_type_rec(arena, p);
                 if (!pt) return NULL;
                 params_local[pc++] = pt;
 
@@ -785,12 +803,12 @@ static IRType* ir_text_parse_type_rec(const char** p) {
             if (!ir_text_match(p, " ->")) return NULL;
         }
 
-        IRType* ret = ir_text_parse_type_rec(p);
+        IRType* ret = ir_text_parse_type_rec(arena, p);
         if (!ret) return NULL;
 
         IRType* param_ptrs[64];
         for (int i = 0; i < pc; i++) param_ptrs[i] = params_local[i];
-        return ir_type_func(ret, param_ptrs, pc);
+        return ir_type_func(arena, ret, param_ptrs, pc);
     }
 
     char* tok = ir_text_parse_token(p);
@@ -1,6 +1,7 @@
 ﻿static IRValue* ir_text_parse_value(IRModule* module, IRFunc* func, IRTextBlockMap* bmap,
                                    const char** p, IRType* expected_type) {
-    (void)func;
+    // قيم المستوى العام (مهيئات globals) لا تملك دالة؛ تُخصص من ساحة الوحدة.
+    IRArena* arena = func ? &func->arena : &module->arena;
     ir_text_skip_ws(p);
 
     // رقم ثابت
@@ -9,7 +10,7 @@
         if (!ir_text_parse_int64(p, &v)) return NULL;
         // إذا لم يتوفر نوع متوقع، نفترض i64 لأن نص IR لا يحمل نوعاً للثوابت.
         IRType* t = expected_type ? expected_type : IR_TYPE_I64_T;
-        return ir_value_const_int(v, t);
+        return ir_value_const_int(arena, v, t);
     }
 
     // سلسلة: @.strN
@@ -17,7 +18,7 @@
         int id = 0;
         if (!ir_text_parse_int32(p, &id)) return NULL;
         const char* s = module ? ir_module_get_string(module, id) : NULL;
-        return ir_value_const_str(s, id);
+        return ir_value_const_str(arena, s, id);
     }
 
     // سلسلة باء: @.bsN
@@ -25,7 +26,7 @@
         int id = 0;
         if (!ir_text_parse_int32(p, &id)) return NULL;
         const char* s = module ? ir_module_get_baa_string(module, id) : NULL;
-        return ir_value_baa_str(s, id);
+        return ir_value_baa_str(arena, s, id);
     }
 
     // مرجع global/function: @name
@@ -35,7 +36,7 @@
         if (!name) return NULL;
 
         if (expected_type && expected_type->kind == IR_TYPE_FUNC) {
-            IRValue* v = ir_value_func_ref(name, expected_type);
+            IRValue* v = ir_value_func_ref(arena, name, expected_type);
             free(name);
             return v;
         }
@@ -60,8 +61,8 @@
                             return NULL;
                         }
                     }
-                    IRType* sig = ir_type_func(fn->ret_type, pp, pc);
-                    IRValue* v = ir_value_func_ref(name, sig);
+                    IRType* sig = ir_type_func(arena, fn->ret_type, pp, pc);
+                    IRValue* v = ir_value_func_ref(arena, name, sig);
                     free(name);
                     return v;
                 }
@@ -70,7 +71,7 @@
 
         IRType* base = NULL;
         if (expected_type && expected_type->kind == IR_TYPE_PTR) base = expected_type->data.pointee;
-        IRValue* v = ir_value_global(name, base);
+        IRValue* v = ir_value_global(arena, name, base);
         free(name);
         return v;
     }
@@ -83,7 +84,7 @@
     if (ir_text_parse_reg_token(tok, &reg)) {
         free(tok);
         IRType* rt = expected_type ? expected_type : ir_text_reg_type_get(bmap, reg);
-        return ir_value_reg(reg, rt);
+        return ir_value_reg(arena, reg, rt);
     }
 
     int bid = -1;
@@ -91,7 +92,7 @@
         free(tok);
         if (!func || !bmap) return NULL;
         IRBlock* b = ir_text_get_or_create_block(func, bmap, bid);
-        return b ? ir_value_block(b) : NULL;
+        return b ? ir_value_block(arena, b) : NULL;
     }
 
     free(tok);
@@ -152,7 +153,7 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
 
     if (op == IR_OP_CPU_NOP) {
         if (dest >= 0) return 0;
-        inst = ir_inst_new(IR_OP_CPU_NOP, IR_TYPE_VOID_T, -1);
+        inst = ir_inst_new(&func->arena, IR_OP_CPU_NOP, IR_TYPE_VOID_T, -1);
         if (!inst) return 0;
         if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
         ir_block_append(block, inst);
@@ -161,9 +162,9 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
 
     if (op == IR_OP_READ_TSC) {
         if (dest < 0) return 0;
-        IRType* type = ir_text_parse_type_rec(&p);
+        IRType* type = ir_text_parse_type_rec(&func->arena, &p);
         if (!type || type->kind != IR_TYPE_I64) return 0;
-        inst = ir_inst_new(IR_OP_READ_TSC, type, dest);
+        inst = ir_inst_new(&func->arena, IR_OP_READ_TSC, type, dest);
         if (!inst) return 0;
         if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
         ir_block_append(block, inst);
@@ -172,7 +173,7 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
     }
 
     if (op == IR_OP_NOP) {
-        inst = ir_inst_new(IR_OP_NOP, IR_TYPE_VOID_T, -1);
+        inst = ir_inst_new(&func->arena, IR_OP_NOP, IR_TYPE_VOID_T, -1);
         if (!inst) return 0;
         if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
         ir_block_append(block, inst);
@@ -183,7 +184,7 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
         IRType* bt = NULL;
         IRValue* tgtv = ir_text_parse_value(module, func, bmap, &p, bt);
         if (!tgtv || tgtv->kind != IR_VAL_BLOCK) return 0;
-        inst = ir_inst_br(tgtv->data.block);
+        inst = ir_inst_br(&func->arena, tgtv->data.block);
         if (!inst) return 0;
         if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
         ir_block_append(block, inst);
@@ -201,7 +202,7 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
         IRValue* f = ir_text_parse_value(module, func, bmap, &p, NULL);
         if (!f || f->kind != IR_VAL_BLOCK) return 0;
 
-        inst = ir_inst_br_cond(cond, t->data.block, f->data.block);
+        inst = ir_inst_br_cond(&func->arena, cond, t->data.block, f->data.block);
         if (!inst) return 0;
         if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
         ir_block_append(block, inst);
@@ -210,11 +211,45 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
         return 1;
     }
 
+    if (op == IR_OP_SWITCH) {
+        IRType* vt = ir_text_parse_type_rec(&func->arena, &p);
+        if (!vt) return 0;
+        IRValue* v = ir_text_parse_value(module, func, bmap, &p, vt);
+        if (!v) return 0;
+        if (!ir_text_consume_char(&p, ',')) return 0;
+        IRValue* d = ir_text_parse_value(module, func, bmap, &p, NULL);
+        if (!d || d->kind != IR_VAL_BLOCK) return 0;
+
+        inst = ir_inst_switch(&func->arena, v, d->data.block);
+        if (!inst) return 0;
+        while (ir_text_consume_char(&p, ',')) {
+            if (!ir_text_consume_char(&p, '[')) return 0;
+            IRValue* cv = ir_text_parse_value(module, func, bmap, &p, vt);
+            if (!cv || cv->kind != IR_VAL_CONST_INT) return 0;
+            if (!ir_text_consume_char(&p, ',')) return 0;
+            IRValue* tv = ir_text_parse_value(module, func, bmap, &p, NULL);
+            if (!tv || tv->kind != IR_VAL_BLOCK) return 0;
+            if (!ir_text_consume_char(&p, ']')) return 0;
+            ir_inst_switch_add_case(&func->arena, inst, cv->data.const_int, tv->data.block);
+        }
+        if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
+        ir_block_append(block, inst);
+        // الحواف تُعاد بناؤها بعد القراءة؛ هنا يكفي الهدف الافتراضي ثم أهداف الحالات المختلفة.
+        ir_block_add_succ(block, d->data.block);
+        for (int i = 0; i < inst->switch_case_count; i++) {
+            IRBlock* target = inst->switch_cases[i].target;
+            int seen = 0;
+            for (int k = 0; k < block->succ_count && !seen; k++) seen = (block->succs[k] == target);
+            if (!seen) ir_block_add_succ(block, target);
+        }
+        return 1;
+    }
+
     if (op == IR_OP_RET) {
-        IRType* rt = ir_text_parse_type_rec(&p);
+        IRType* rt = ir_text_parse_type_rec(&func->arena, &p);
         if (!rt) return 0;
         if (rt->kind == IR_TYPE_VOID) {
-            inst = ir_inst_ret(NULL);
+            inst = ir_inst_ret(&func->arena, NULL);
             if (!inst) return 0;
             if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
             ir_block_append(block, inst);
@@ -222,7 +257,7 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
         }
         IRValue* v = ir_text_parse_value(module, func, bmap, &p, rt);
         if (!v) return 0;
-        inst = ir_inst_ret(v);
+        inst = ir_inst_ret(&func->arena, v);
         if (!inst) return 0;
         if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
         ir_block_append(block, inst);
@@ -230,7 +265,7 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
     }
 
     if (op == IR_OP_CALL) {
-        IRType* ret_t = ir_text_parse_type_rec(&p);
+        IRType* ret_t = ir_text_parse_type_rec(&func->arena, &p);
         if (!ret_t) return 0;
         ir_text_skip_ws(&p);
         bool is_direct = false;
@@ -262,7 +297,7 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
                         return 0;
                     }
                 }
-                callee_sig = ir_type_func(fnd->ret_type, pp, pc);
+                callee_sig = ir_type_func(&func->arena, fnd->ret_type, pp, pc);
             }
         } else if (ir_text_match(&p, "<")) {
             callee = ir_text_parse_value(module, func, bmap, &p, NULL);
@@ -313,9 +348,9 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
         }
 
         if (is_direct) {
-            inst = ir_inst_call(fn, ret_t, dest, args, ac);
+            inst = ir_inst_call(&func->arena, fn, ret_t, dest, args, ac);
         } else {
-            inst = ir_inst_call_indirect(callee, ret_t, dest, args, ac);
+            inst = ir_inst_call_indirect(&func->arena, callee, ret_t, dest, args, ac);
         }
         free(fn);
         free(args);
@@ -330,9 +365,9 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
     }
 
     if (op == IR_OP_ALLOCA) {
-        IRType* t = ir_text_parse_type_rec(&p);
+        IRType* t = ir_text_parse_type_rec(&func->arena, &p);
         if (!t) return 0;
-        inst = ir_inst_alloca(t, dest);
+        inst = ir_inst_alloca(&func->arena, t, dest);
         if (!inst) return 0;
         if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
         ir_block_append(block, inst);
@@ -344,13 +379,13 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
     }
 
     if (op == IR_OP_LOAD) {
-        IRType* t = ir_text_parse_type_rec(&p);
+        IRType* t = ir_text_parse_type_rec(&func->arena, &p);
         if (!t) return 0;
         if (!ir_text_consume_char(&p, ',')) return 0;
-        IRType* ptr_t = ir_type_ptr(t);
+        IRType* ptr_t = ir_type_ptr(&func->arena, t);
         IRValue* ptr = ir_text_parse_value(module, func, bmap, &p, ptr_t);
         if (!ptr) return 0;
-        inst = ir_inst_load(t, dest, ptr);
+        inst = ir_inst_load(&func->arena, t, dest, ptr);
         if (!inst) return 0;
         if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
         ir_block_append(block, inst);
@@ -362,15 +397,15 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
     }
 
     if (op == IR_OP_STORE) {
-        IRType* t = ir_text_parse_type_rec(&p);
+        IRType* t = ir_text_parse_type_rec(&func->arena, &p);
         if (!t) return 0;
         IRValue* v = ir_text_parse_value(module, func, bmap, &p, t);
         if (!v) return 0;
         if (!ir_text_consume_char(&p, ',')) return 0;
-        IRType* ptr_t = ir_type_ptr(t);
+        IRType* ptr_t = ir_type_ptr(&func->arena, t);
         IRValue* ptr = ir_text_parse_value(module, func, bmap, &p, ptr_t);
         if (!ptr) return 0;
-        inst = ir_inst_store(v, ptr);
+        inst = ir_inst_store(&func->arena, v, ptr);
         if (!inst) return 0;
         if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
         ir_block_append(block, inst);
@@ -382,14 +417,14 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
         if (!pred_tok) return 0;
         IRCmpPred pred = ir_text_parse_pred(pred_tok);
         free(pred_tok);
-        IRType* t = ir_text_parse_type_rec(&p);
+        IRType* t = ir_text_parse_type_rec(&func->arena, &p);
         if (!t) return 0;
         IRValue* lhs = ir_text_parse_value(module, func, bmap, &p, t);
         if (!lhs) return 0;
         if (!ir_text_consume_char(&p, ',')) return 0;
         IRValue* rhs = ir_text_parse_value(module, func, bmap, &p, t);
         if (!rhs) return 0;
-        inst = ir_inst_cmp(pred, dest, lhs, rhs);
+        inst = ir_inst_cmp(&func->arena, pred, dest, lhs, rhs);
         if (!inst) return 0;
         if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
         ir_block_append(block, inst);
@@ -401,9 +436,9 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
     }
 
     if (op == IR_OP_PHI) {
-        IRType* t = ir_text_parse_type_rec(&p);
+        IRType* t = ir_text_parse_type_rec(&func->arena, &p);
         if (!t) return 0;
-        inst = ir_inst_phi(t, dest);
+        inst = ir_inst_phi(&func->arena, t, dest);
         if (!inst) return 0;
 
         // phi entries: [v, %blockN], ...
@@ -440,16 +475,16 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
     }
 
     if (op == IR_OP_CAST) {
-        IRType* from_t = ir_text_parse_type_rec(&p);
+        IRType* from_t = ir_text_parse_type_rec(&func->arena, &p);
         if (!from_t) return 0;
         IRValue* v = ir_text_parse_value(module, func, bmap, &p, from_t);
         if (!v) return 0;
         ir_text_skip_ws(&p);
         if (!ir_text_match(&p, "to")) return 0;
-        IRType* to_t = ir_text_parse_type_rec(&p);
+        IRType* to_t = ir_text_parse_type_rec(&func->arena, &p);
         if (!to_t) return 0;
 
-        inst = ir_inst_new(IR_OP_CAST, to_t, dest);
+        inst = ir_inst_new(&func->arena, IR_OP_CAST, to_t, dest);
         if (!inst) return 0;
         ir_inst_add_operand(inst, v);
         if (!ir_text_parse_inst_attrs(&p, inst, func)) return 0;
@@ -462,10 +497,10 @@ static int ir_text_parse_instruction_line(IRModule* module, IRFunc* func, IRBloc
     }
 
     // العمليات القياسية ذات النوع
-    IRType* t = ir_text_parse_type_rec(&p);
+    IRType* t = ir_text_parse_type_rec(&func->arena, &p);
     if (!t) return 0;
 
-    inst = ir_inst_new(op, t, dest);
+    inst = ir_inst_new(&func->arena, op, t, dest);
     if (!inst) return 0;
 
     // تحميل/نسخ/حساب...: معاملات مفصولة بفواصل
@@ -599,11 +634,11 @@ IRModule* ir_text_read_module_file(const char* filename) {
                 free(line);
                 break;
             }
-            IRType* t = ir_text_parse_type_rec(&p);
+            IRType* t = ir_text_parse_type_rec(&module->arena, &p);
             if (!t) { free(name); ok = 0; free(line); break; }
 
             if (is_extern) {
-                IRGlobal* g = ir_global_new(name, t, is_const);
+                IRGlobal* g = ir_global_new(&module->arena, name, t, is_const);
                 free(name);
                 if (!g) { ok = 0; free(line); break; }
                 g->is_extern = true;
@@ -666,7 +701,7 @@ IRModule* ir_text_read_module_file(const char* filename) {
                 IRGlobal* g = NULL;
                 if (ok)
                 {
-                    g = ir_global_new(name, t, is_const);
+                    g = ir_global_new(&module->arena, name, t, is_const);
                 }
                 free(name);
                 if (!ok || !g) { free(tmp); ok = 0; free(line); break; }
@@ -696,7 +731,7 @@ IRModule* ir_text_read_module_file(const char* filename) {
                 IRValue* init = ir_text_parse_value(module, NULL, NULL, &p, t);
                 if (!init) { free(name); ok = 0; free(line); break; }
 
-                IRGlobal* g = ir_global_new(name, t, is_const);
+                IRGlobal* g = ir_global_new(&module->arena, name, t, is_const);
                 free(name);
                 if (!g) { ok = 0; free(line); break; }
                 g->is_internal = is_internal ? true : false;
@@ -726,6 +761,8 @@ IRModule* ir_text_read_module_file(const char* filename) {
             IRFunc* fn = ir_func_new(fname, IR_TYPE_VOID_T);
             free(fname);
             if (!fn) { ok = 0; free(line); break; }
+            // تُضاف الدالة فوراً لتتولى الوحدة تحرير ساحتها حتى في مسارات الخطأ.
+            ir_module_add_func(module, fn);
 
             // params
             ir_text_skip_ws(&p);
@@ -736,7 +773,7 @@ IRModule* ir_text_read_module_file(const char* filename) {
                     if (!ir_text_match(&p, ")")) { ok = 0; free(line); break; }
                 } else {
                     while (1) {
-                        IRType* pt = ir_text_parse_type_rec(&p);
+                        IRType* pt = ir_text_parse_type_rec(&fn->arena, &p);
                         if (!pt) { ok = 0; free(line); break; }
                         char* reg_tok = ir_text_parse_token(&p);
                         if (!reg_tok) { ok = 0; free(line); break; }
@@ -768,14 +805,13 @@ IRModule* ir_text_read_module_file(const char* filename) {
 
             ir_text_skip_ws(&p);
             if (!ir_text_match(&p, "->")) { ok = 0; free(line); break; }
-            IRType* rt = ir_text_parse_type_rec(&p);
+            IRType* rt = ir_text_parse_type_rec(&fn->arena, &p);
             if (!rt) { ok = 0; free(line); break; }
             fn->ret_type = rt;
 
             ir_text_skip_ws(&p);
             if (ir_text_match(&p, ";")) {
                 fn->is_prototype = true;
-                ir_module_add_func(module, fn);
                 cur_func = NULL;
                 free(line);
                 continue;
@@ -783,7 +819,6 @@ IRModule* ir_text_read_module_file(const char* filename) {
 
             if (!ir_text_match(&p, "{")) { ok = 0; free(line); break; }
             fn->is_prototype = false;
-            ir_module_add_func(module, fn);
             cur_func = fn;
 
             free(line);
@@ -318,7 +318,7 @@ static int ir_get_trip_count_for_simple_inc1_loop(IRFunc* func,
 static IRInst* ir_clone_inst_for_unroll(IRInst* inst) {
     if (!inst) return NULL;
 
-    IRInst* c = ir_inst_new(inst->op, inst->type, inst->dest);
+    IRInst* c = ir_inst_new(inst->arena, inst->op, inst->type, inst->dest);
     if (!c) return NULL;
 
     c->cmp_pred = inst->cmp_pred;
@@ -420,7 +420,7 @@ static int ir_unroll_full_simple_loop(IRFunc* func, IRLoop* loop, int max_trip)
     }
 
     // بدّل قفز preheader إلى exit.
-    term->operands[0] = ir_value_block(exit_succ);
+    term->operands[0] = ir_value_block(&func->arena, exit_succ);
     ir_func_invalidate_defuse(func);
 
     // إعادة بناء preds/succs لضمان الاتساق.
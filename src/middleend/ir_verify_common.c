@@ -76,6 +76,25 @@ int ir_verify_func_block_refs_safe(const IRFunc* func, IRVerifyReportFn report,
                 continue;
             }
 
+            if (inst->op == IR_OP_SWITCH)
+            {
+                IRValue* t = (inst->operand_count >= 2) ? inst->operands[1] : NULL;
+                if (t && t->kind == IR_VAL_BLOCK && !block_is_in_func(t->data.block, func))
+                {
+                    report(ctx, func, b, inst, "تعليمة `تفرع`: الهدف الافتراضي فارغ أو خارج الدالة (غير مسموح).");
+                    ok = 0;
+                }
+                for (int i = 0; i < inst->switch_case_count; i++)
+                {
+                    if (!block_is_in_func(inst->switch_cases[i].target, func))
+                    {
+                        report(ctx, func, b, inst, "تعليمة `تفرع`: هدف حالة فارغ أو خارج الدالة (غير مسموح).");
+                        ok = 0;
+                    }
+                }
+                continue;
+            }
+
             if (inst->op == IR_OP_PHI)
             {
                 for (const IRPhiEntry* e = inst->phi_entries; e; e = e->next)
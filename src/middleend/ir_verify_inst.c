@@ -14,8 +14,8 @@
 
     // تحقق عام للنوع/الوجهة.
     if (inst->op != IR_OP_STORE && inst->op != IR_OP_BR &&
-        inst->op != IR_OP_BR_COND && inst->op != IR_OP_RET &&
-        inst->op != IR_OP_CPU_NOP) {
+        inst->op != IR_OP_BR_COND && inst->op != IR_OP_SWITCH &&
+        inst->op != IR_OP_RET && inst->op != IR_OP_CPU_NOP) {
         // معظم التعليمات المنتجة للقيم يجب أن تملك type غير void.
         if (!inst->type) {
             ir_report(diag, module, func, block, inst, "تعليمة بدون نوع (type=NULL).");
@@ -345,6 +345,43 @@
             break;
         }
 
+        // --------------------------------------------------------------------
+        // switch: no dest + 2 operands: value(int), default(block) + cases
+        // --------------------------------------------------------------------
+        case IR_OP_SWITCH: {
+            ir_verify_inst_dest_rules(diag, module, func, block, inst, 0);
+            ir_verify_inst_operands_present(diag, module, func, block, inst, 2);
+
+            IRValue* v = inst->operands[0];
+            if (!v || !v->type || v->type->kind == IR_TYPE_F64 || v->type->kind == IR_TYPE_PTR ||
+                v->type->kind == IR_TYPE_VOID || v->type->kind == IR_TYPE_ARRAY ||
+                v->type->kind == IR_TYPE_FUNC) {
+                ir_report(diag, module, func, block, inst, "تعليمة `تفرع`: القيمة يجب أن تكون عدداً صحيحاً.");
+            }
+
+            if (!ir_value_is_block(inst->operands[1])) {
+                ir_report(diag, module, func, block, inst, "تعليمة `تفرع`: الهدف الافتراضي يجب أن يكون كتلة.");
+            } else if (!ir_value_is_block_in_func(inst->operands[1], func)) {
+                ir_report(diag, module, func, block, inst,
+                          "تعليمة `تفرع`: الهدف الافتراضي يشير إلى كتلة خارج الدالة (غير مسموح).");
+            }
+
+            for (int i = 0; i < inst->switch_case_count; i++) {
+                const IRSwitchCase* c = &inst->switch_cases[i];
+                if (!c->target || c->target->parent != func) {
+                    ir_report(diag, module, func, block, inst,
+                              "تعليمة `تفرع`: هدف حالة مفقود أو خارج الدالة (غير مسموح).");
+                }
+                for (int j = 0; j < i; j++) {
+                    if (inst->switch_cases[j].value == c->value) {
+                        ir_report(diag, module, func, block, inst, "تعليمة `تفرع`: قيمة حالة مكررة.");
+                        break;
+                    }
+                }
+            }
+            break;
+        }
+
         // --------------------------------------------------------------------
         // ret: no dest, 0 أو 1 معامل، النوع يجب أن يطابق نوع الدالة
         // --------------------------------------------------------------------
@@ -167,7 +167,7 @@ static int ir_inst_dest_in_range(const IRInst* inst, const IRFunc* func) {
 }
 
 static int ir_is_terminator_op(IROp op) {
-    return op == IR_OP_BR || op == IR_OP_BR_COND || op == IR_OP_RET;
+    return op == IR_OP_BR || op == IR_OP_BR_COND || op == IR_OP_SWITCH || op == IR_OP_RET;
 }
 
 typedef struct
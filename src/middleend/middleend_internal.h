@@ -15,6 +15,7 @@
 
 #include "ir.h"
 #include "ir_analysis.h"
+#include "ir_analysis_manager.h"
 #include "ir_builder.h"
 #include "ir_defuse.h"
 #include "ir_lower.h"
@@ -24,6 +25,7 @@
 #include "ir_verify_ir.h"
 #include "../frontend/ast.h"
 #include "../support/diagnostics.h"
+#include "../support/session.h"
 #include "../support/file_io.h"
 
 #endif
@@ -46,10 +46,15 @@ typedef struct {
     int end_col;
 } DiagnosticSpan;
 
-extern WarningConfig g_warning_config;
+/**
+ * @brief إعدادات التحذيرات للجلسة المربوطة بالخيط الحالي.
+ */
+WarningConfig* diagnostics_warning_config(void);
 
 void error_init(const char* source);
 void error_register_source(const char* filename, const char* source);
+// مثل error_register_source() لكن دون نسخ؛ يجب أن يبقى source صالحاً حتى error_init() التالية.
+void error_register_source_shared(const char* filename, const char* source);
 void warning_init(void);
 void error_report_loc(const char* filename, int line, int col, const char* message, ...);
 void error_report_loc_code(const char* code, const char* filename, int line, int col, const char* message, ...);
@@ -38,20 +38,12 @@
 // حالة النظام (System State)
 // ============================================================================
 
-static const char* current_source = NULL;
-static bool had_error = false;
-static bool had_warning = false;
-static int warning_count = 0;
-
 typedef struct {
     char* filename;
     char* source;
+    bool owned;     // false: نص مستعار يملكه غيرنا (مثل ذاكرة ملفات التضمين المخبئية)
 } ErrorSourceEntry;
 
-static ErrorSourceEntry* g_error_sources = NULL;
-static int g_error_sources_count = 0;
-static int g_error_sources_cap = 0;
-
 typedef struct {
     char* code;
     char* severity;
@@ -78,13 +70,26 @@ typedef struct {
     const char* new_text;
 } DiagnosticJsonFix;
 
-static DiagnosticJsonRecord* g_diagnostic_json_records = NULL;
-static int g_diagnostic_json_count = 0;
-static int g_diagnostic_json_cap = 0;
-static bool g_diagnostics_json_enabled = false;
+/**
+ * @brief حالة التشخيص لجلسة ترجمة واحدة (مملوكة لخانة BAA_SESSION_SLOT_DIAGNOSTICS).
+ */
+typedef struct {
+    const char* current_source;
+    bool had_error;
+    bool had_warning;
+    int warning_count;
+
+    ErrorSourceEntry* sources;
+    int sources_count;
+    int sources_cap;
 
-// إعدادات التحذيرات العامة
-WarningConfig g_warning_config;
+    DiagnosticJsonRecord* json_records;
+    int json_count;
+    int json_cap;
+    bool json_enabled;
+
+    WarningConfig warnings;
+} DiagnosticState;
 
 // ============================================================================
 // دوال مساعدة (Helper Functions)
@@ -172,34 +177,73 @@ static const char* diagnostic_category_for_code(const char* code)
 
 static DiagnosticSpan diagnostic_span_normalize(DiagnosticSpan span);
 static int diagnostic_byte_offset(const char* filename, int line, int col);
+static void error_sources_clear(DiagnosticState* ds);
+static void diagnostic_json_records_clear(DiagnosticState* ds);
+
+static void diagnostic_state_destroy(void* state)
+{
+    DiagnosticState* ds = (DiagnosticState*)state;
+    if (!ds) return;
+    error_sources_clear(ds);
+    diagnostic_json_records_clear(ds);
+    free(ds);
+}
+
+/**
+ * @brief حالة التشخيص للجلسة المربوطة بالخيط الحالي (تُنشأ عند أول استخدام).
+ */
+static DiagnosticState* diagnostic_state(void)
+{
+    BaaSession* session = baa_session_current();
+    if (!session) {
+        fprintf(stderr, "Fatal: diagnostics used outside a bound compilation session\n");
+        exit(1);
+    }
+    DiagnosticState* ds = (DiagnosticState*)baa_session_slot(session, BAA_SESSION_SLOT_DIAGNOSTICS);
+    if (ds) return ds;
+
+    ds = (DiagnosticState*)calloc(1, sizeof(DiagnosticState));
+    if (!ds) {
+        fprintf(stderr, "Fatal: out of memory while allocating diagnostics state\n");
+        exit(1);
+    }
+    baa_session_set_slot(session, BAA_SESSION_SLOT_DIAGNOSTICS, ds, diagnostic_state_destroy);
+    return ds;
+}
+
+WarningConfig* diagnostics_warning_config(void)
+{
+    return &diagnostic_state()->warnings;
+}
 
-static void error_sources_clear(void) {
-    if (g_error_sources) {
-        for (int i = 0; i < g_error_sources_count; i++) {
-            free(g_error_sources[i].filename);
-            free(g_error_sources[i].source);
-            g_error_sources[i].filename = NULL;
-            g_error_sources[i].source = NULL;
+static void error_sources_clear(DiagnosticState* ds) {
+    if (ds->sources) {
+        for (int i = 0; i < ds->sources_count; i++) {
+            free(ds->sources[i].filename);
+            if (ds->sources[i].owned) free(ds->sources[i].source);
+            ds->sources[i].filename = NULL;
+            ds->sources[i].source = NULL;
         }
-        free(g_error_sources);
+        free(ds->sources);
     }
 
-    g_error_sources = NULL;
-    g_error_sources_count = 0;
-    g_error_sources_cap = 0;
+    ds->sources = NULL;
+    ds->sources_count = 0;
+    ds->sources_cap = 0;
 }
 
 static const char* error_sources_lookup(const char* filename) {
-    if (!filename || !filename[0]) return current_source;
+    DiagnosticState* ds = diagnostic_state();
+    if (!filename || !filename[0]) return ds->current_source;
 
-    for (int i = 0; i < g_error_sources_count; i++) {
-        if (g_error_sources[i].filename &&
-            strcmp(g_error_sources[i].filename, filename) == 0) {
-            return g_error_sources[i].source;
+    for (int i = 0; i < ds->sources_count; i++) {
+        if (ds->sources[i].filename &&
+            strcmp(ds->sources[i].filename, filename) == 0) {
+            return ds->sources[i].source;
         }
     }
 
-    return current_source;
+    return ds->current_source;
 }
 
 static char* diagnostic_strdup(const char* text)
@@ -228,273 +272,7 @@ static char* diagnostic_vformat(const char* format, va_list args)
     return out;
 }
 
-static void diagnostic_json_record_free(DiagnosticJsonRecord* record)
-{
-    if (!record) return;
-    free(record->code);
-    free(record->severity);
-    free(record->category);
-    free(record->message);
-    free(record->filename);
-    free(record->hint);
-    free(record->fix_id);
-    free(record->fix_title);
-    free(record->fix_filename);
-    free(record->fix_new_text);
-    memset(record, 0, sizeof(*record));
-}
-
-void diagnostics_json_reset(void)
-{
-    for (int i = 0; i < g_diagnostic_json_count; ++i) {
-        diagnostic_json_record_free(&g_diagnostic_json_records[i]);
-    }
-    free(g_diagnostic_json_records);
-    g_diagnostic_json_records = NULL;
-    g_diagnostic_json_count = 0;
-    g_diagnostic_json_cap = 0;
-}
-
-void diagnostics_set_json_enabled(bool enabled)
-{
-    g_diagnostics_json_enabled = enabled;
-}
-
-bool diagnostics_json_enabled(void)
-{
-    return g_diagnostics_json_enabled;
-}
-
-static bool diagnostics_json_reserve(void)
-{
-    if (g_diagnostic_json_count < g_diagnostic_json_cap) return true;
-
-    int new_cap = (g_diagnostic_json_cap == 0) ? 8 : g_diagnostic_json_cap * 2;
-    DiagnosticJsonRecord* grown = (DiagnosticJsonRecord*)realloc(
-        g_diagnostic_json_records,
-        (size_t)new_cap * sizeof(*grown));
-    if (!grown) return false;
-
-    g_diagnostic_json_records = grown;
-    g_diagnostic_json_cap = new_cap;
-    return true;
-}
-
-static void diagnostics_json_add(const char* code,
-                                 const char* severity,
-                                 const char* category,
-                                 DiagnosticSpan span,
-                                 const char* hint,
-                                 const DiagnosticJsonFix* fix,
-                                 const char* message)
-{
-    if (!g_diagnostics_json_enabled) return;
-    if (!diagnostics_json_reserve()) return;
-
-    DiagnosticJsonRecord* record = &g_diagnostic_json_records[g_diagnostic_json_count++];
-    memset(record, 0, sizeof(*record));
-    record->code = diagnostic_strdup(code);
-    record->severity = diagnostic_strdup(severity);
-    record->category = diagnostic_strdup(category);
-    record->message = diagnostic_strdup(message);
-    record->filename = diagnostic_strdup(span.filename ? span.filename : "unknown");
-    record->span = diagnostic_span_normalize(span);
-    record->start_byte = diagnostic_byte_offset(record->filename, record->span.line, record->span.col);
-    record->end_byte = diagnostic_byte_offset(record->filename, record->span.end_line, record->span.end_col);
-    record->hint = hint && hint[0] ? diagnostic_strdup(hint) : NULL;
-    if (fix && fix->id && fix->id[0] && fix->title && fix->title[0] &&
-        fix->new_text) {
-        record->fix_id = diagnostic_strdup(fix->id);
-        record->fix_title = diagnostic_strdup(fix->title);
-        record->fix_filename = diagnostic_strdup(
-            fix->span.filename ? fix->span.filename : record->filename);
-        record->fix_span = fix->span;
-        record->fix_span.filename = record->fix_filename;
-        if (record->fix_span.line <= 0) record->fix_span.line = record->span.line;
-        if (record->fix_span.col <= 0) record->fix_span.col = record->span.col;
-        if (record->fix_span.end_line <= 0)
-            record->fix_span.end_line = record->fix_span.line;
-        if (record->fix_span.end_line < record->fix_span.line)
-            record->fix_span.end_line = record->fix_span.line;
-        if (record->fix_span.end_line == record->fix_span.line &&
-            record->fix_span.end_col < record->fix_span.col)
-            record->fix_span.end_col = record->fix_span.col;
-        if (record->fix_span.end_line > record->fix_span.line &&
-            record->fix_span.end_col <= 0)
-            record->fix_span.end_col = 1;
-        record->fix_start_byte = diagnostic_byte_offset(
-            record->fix_filename,
-            record->fix_span.line,
-            record->fix_span.col);
-        record->fix_end_byte = diagnostic_byte_offset(
-            record->fix_filename,
-            record->fix_span.end_line,
-            record->fix_span.end_col);
-        if (record->fix_end_byte < record->fix_start_byte)
-            record->fix_end_byte = record->fix_start_byte;
-        record->fix_new_text = diagnostic_strdup(fix->new_text);
-    }
-}
-
-static int diagnostic_byte_offset(const char* filename, int line, int col)
-{
-    const char* src = error_sources_lookup(filename);
-    if (!src) return 0;
-
-    int current_line = 1;
-    int offset = 0;
-    while (src[offset] && current_line < line) {
-        if (src[offset] == '\n') current_line++;
-        offset++;
-    }
-
-    int remaining_col = col > 0 ? col - 1 : 0;
-    while (src[offset] && src[offset] != '\n' && remaining_col > 0) {
-        offset++;
-        remaining_col--;
-    }
-    return offset;
-}
-
-static void diagnostics_json_escape(FILE* out, const char* text)
-{
-    if (!out) return;
-    if (!text) return;
-
-    for (const unsigned char* p = (const unsigned char*)text; *p; ++p) {
-        switch (*p) {
-            case '"': fputs("\\\"", out); break;
-            case '\\': fputs("\\\\", out); break;
-            case '\b': fputs("\\b", out); break;
-            case '\f': fputs("\\f", out); break;
-            case '\n': fputs("\\n", out); break;
-            case '\r': fputs("\\r", out); break;
-            case '\t': fputs("\\t", out); break;
-            default:
-                if (*p < 0x20u) {
-                    fprintf(out, "\\u%04x", (unsigned)*p);
-                } else {
-                    fputc((int)*p, out);
-                }
-                break;
-        }
-    }
-}
-
-void diagnostics_json_write(FILE* out,
-                            const char* compiler_version,
-                            const char* mode,
-                            const char* target,
-                            const char* working_directory)
-{
-    if (!out) out = stdout;
-
-    int errors = 0;
-    int warnings = 0;
-    int notes = 0;
-    for (int i = 0; i < g_diagnostic_json_count; ++i) {
-        const char* severity = g_diagnostic_json_records[i].severity;
-        if (severity && strcmp(severity, "warning") == 0)
-            warnings++;
-        else if (severity && (strcmp(severity, "note") == 0 || strcmp(severity, "help") == 0))
-            notes++;
-        else
-            errors++;
-    }
-
-    fputs("{\n", out);
-    fputs("  \"schema_version\": \"diagnostics-json-v1\",\n", out);
-    fputs("  \"compiler\": {\"name\": \"baa\", \"version\": \"", out);
-    diagnostics_json_escape(out, compiler_version ? compiler_version : "");
-    fputs("\"},\n", out);
-    fputs("  \"invocation\": {\"mode\": \"", out);
-    diagnostics_json_escape(out, mode ? mode : "");
-    fputs("\", \"target\": \"", out);
-    diagnostics_json_escape(out, target ? target : "");
-    fputs("\", \"working_directory\": \"", out);
-    diagnostics_json_escape(out, working_directory ? working_directory : ".");
-    fputs("\"},\n", out);
-    fprintf(out,
-            "  \"summary\": {\"errors\": %d, \"warnings\": %d, \"notes\": %d},\n",
-            errors,
-            warnings,
-            notes);
-    fputs("  \"diagnostics\": [\n", out);
-
-    for (int i = 0; i < g_diagnostic_json_count; ++i) {
-        DiagnosticJsonRecord* record = &g_diagnostic_json_records[i];
-        DiagnosticSpan span = diagnostic_span_normalize(record->span);
-        fputs("    {\n", out);
-        fputs("      \"code\": \"", out);
-        diagnostics_json_escape(out, record->code);
-        fputs("\",\n      \"severity\": \"", out);
-        diagnostics_json_escape(out, record->severity);
-        fputs("\",\n      \"category\": \"", out);
-        diagnostics_json_escape(out, record->category);
-        fputs("\",\n      \"message\": \"", out);
-        diagnostics_json_escape(out, record->message);
-        fputs("\",\n      \"file\": \"", out);
-        diagnostics_json_escape(out, record->filename);
-        fprintf(out, "\",\n      \"line\": %d,\n      \"column\": %d,\n", span.line, span.col);
-        fputs("      \"span\": {", out);
-        fprintf(out,
-                "\"start\": {\"line\": %d, \"column\": %d, \"byte\": %d}, ",
-                span.line,
-                span.col,
-                record->start_byte);
-        fprintf(out,
-                "\"end\": {\"line\": %d, \"column\": %d, \"byte\": %d}",
-                span.end_line,
-                span.end_col,
-                record->end_byte);
-        fputs("},\n      \"hint\": ", out);
-        if (record->hint) {
-            fputs("\"", out);
-            diagnostics_json_escape(out, record->hint);
-            fputs("\"", out);
-        } else {
-            fputs("null", out);
-        }
-        fputs(",\n      \"hints\": [", out);
-        if (record->hint) {
-            fputs("\"", out);
-            diagnostics_json_escape(out, record->hint);
-            fputs("\"", out);
-        }
-        fputs("],\n      \"fixes\": [", out);
-        if (record->fix_id) {
-            fputs("\n        {\n          \"id\": \"", out);
-            diagnostics_json_escape(out, record->fix_id);
-            fputs("\",\n          \"title\": \"", out);
-            diagnostics_json_escape(out, record->fix_title);
-            fputs("\",\n          \"kind\": \"quickfix\",\n"
-                  "          \"applicability\": \"safe\",\n"
-                  "          \"edits\": [\n"
-                  "            {\n              \"file\": \"", out);
-            diagnostics_json_escape(out, record->fix_filename);
-            fputs("\",\n              \"span\": {", out);
-            fprintf(out,
-                    "\"start\": {\"line\": %d, \"column\": %d, \"byte\": %d}, ",
-                    record->fix_span.line,
-                    record->fix_span.col,
-                    record->fix_start_byte);
-            fprintf(out,
-                    "\"end\": {\"line\": %d, \"column\": %d, \"byte\": %d}",
-                    record->fix_span.end_line,
-                    record->fix_span.end_col,
-                    record->fix_end_byte);
-            fputs("},\n              \"new_text\": \"", out);
-            diagnostics_json_escape(out, record->fix_new_text);
-            fputs("\"\n            }\n          ]\n        }\n      ", out);
-        }
-        fputs("]\n    }", out);
-        if (i + 1 < g_diagnostic_json_count) fputs(",", out);
-        fputs("\n", out);
-    }
-
-    fputs("  ]\n}\n", out);
-    fflush(out);
-}
+#include "error_json.inc"
 
 static DiagnosticSpan diagnostic_span_normalize(DiagnosticSpan span)
 {
@@ -566,59 +344,76 @@ static void diagnostic_print_spaces(int count)
 // ============================================================================
 
 void error_init(const char* source) {
-    error_sources_clear();
-    current_source = source;
-    had_error = false;
+    DiagnosticState* ds = diagnostic_state();
+    error_sources_clear(ds);
+    ds->current_source = source;
+    ds->had_error = false;
 }
 
-void error_register_source(const char* filename, const char* source)
+static void error_register_source_entry(const char* filename, const char* source, bool copy)
 {
+    DiagnosticState* ds = diagnostic_state();
     if (!filename || !filename[0] || !source) return;
 
-    for (int i = 0; i < g_error_sources_count; i++) {
-        if (g_error_sources[i].filename &&
-            strcmp(g_error_sources[i].filename, filename) == 0) {
-            char* src_copy = strdup(source);
-            if (!src_copy) return;
-            free(g_error_sources[i].source);
-            g_error_sources[i].source = src_copy;
+    char* text = copy ? strdup(source) : (char*)source;
+    if (!text) return;
+
+    for (int i = 0; i < ds->sources_count; i++) {
+        if (ds->sources[i].filename &&
+            strcmp(ds->sources[i].filename, filename) == 0) {
+            if (ds->sources[i].owned) free(ds->sources[i].source);
+            ds->sources[i].source = text;
+            ds->sources[i].owned = copy;
             return;
         }
     }
 
-    if (g_error_sources_count >= g_error_sources_cap) {
-        int new_cap = (g_error_sources_cap == 0) ? 8 : g_error_sources_cap * 2;
-        ErrorSourceEntry* new_arr = (ErrorSourceEntry*)realloc(g_error_sources,
+    if (ds->sources_count >= ds->sources_cap) {
+        int new_cap = (ds->sources_cap == 0) ? 8 : ds->sources_cap * 2;
+        ErrorSourceEntry* new_arr = (ErrorSourceEntry*)realloc(ds->sources,
             (size_t)new_cap * sizeof(ErrorSourceEntry));
-        if (!new_arr) return;
-        g_error_sources = new_arr;
-        g_error_sources_cap = new_cap;
+        if (!new_arr) {
+            if (copy) free(text);
+            return;
+        }
+        ds->sources = new_arr;
+        ds->sources_cap = new_cap;
     }
 
     char* name_copy = strdup(filename);
-    if (!name_copy) return;
-    char* src_copy = strdup(source);
-    if (!src_copy) {
-        free(name_copy);
+    if (!name_copy) {
+        if (copy) free(text);
         return;
     }
 
-    g_error_sources[g_error_sources_count].filename = name_copy;
-    g_error_sources[g_error_sources_count].source = src_copy;
-    g_error_sources_count++;
+    ds->sources[ds->sources_count].filename = name_copy;
+    ds->sources[ds->sources_count].source = text;
+    ds->sources[ds->sources_count].owned = copy;
+    ds->sources_count++;
+}
+
+void error_register_source(const char* filename, const char* source)
+{
+    error_register_source_entry(filename, source, true);
+}
+
+void error_register_source_shared(const char* filename, const char* source)
+{
+    error_register_source_entry(filename, source, false);
 }
 
 void warning_init(void) {
+    DiagnosticState* ds = diagnostic_state();
     // تعطيل جميع التحذيرات افتراضياً
     for (int i = 0; i < WARN_COUNT; i++) {
-        g_warning_config.enabled[i] = false;
+        ds->warnings.enabled[i] = false;
     }
-    g_warning_config.warnings_as_errors = false;
-    g_warning_config.all_warnings = false;
-    g_warning_config.colored_output = supports_color();
+    ds->warnings.warnings_as_errors = false;
+    ds->warnings.all_warnings = false;
+    ds->warnings.colored_output = supports_color();
     
-    had_warning = false;
-    warning_count = 0;
+    ds->had_warning = false;
+    ds->warning_count = 0;
 }
 
 // ============================================================================
@@ -626,24 +421,29 @@ void warning_init(void) {
 // ============================================================================
 
 bool error_has_occurred() {
-    return had_error;
+    DiagnosticState* ds = diagnostic_state();
+    return ds->had_error;
 }
 
 bool warning_has_occurred() {
-    return had_warning;
+    DiagnosticState* ds = diagnostic_state();
+    return ds->had_warning;
 }
 
 int warning_get_count() {
-    return warning_count;
+    DiagnosticState* ds = diagnostic_state();
+    return ds->warning_count;
 }
 
 void error_reset() {
-    had_error = false;
+    DiagnosticState* ds = diagnostic_state();
+    ds->had_error = false;
 }
 
 void warning_reset() {
-    had_warning = false;
-    warning_count = 0;
+    DiagnosticState* ds = diagnostic_state();
+    ds->had_warning = false;
+    ds->warning_count = 0;
 }
 
 // ============================================================================
@@ -745,15 +545,16 @@ static void error_report_vspan(const char* code,
                                const char* message,
                                va_list args)
 {
+    DiagnosticState* ds = diagnostic_state();
     span = diagnostic_span_normalize(span);
     code = diagnostic_code_or_default(code, DIAG_CODE_SYNTAX_GENERIC);
     const char* category = diagnostic_category_for_code(code);
-    had_error = true;
-    bool use_color = g_warning_config.colored_output;
+    ds->had_error = true;
+    bool use_color = ds->warnings.colored_output;
     char* formatted = diagnostic_vformat(message, args);
     diagnostics_json_add(code, "error", category, span, hint, fix,
                          formatted ? formatted : "");
-    if (g_diagnostics_json_enabled) {
+    if (ds->json_enabled) {
         free(formatted);
         return;
     }
@@ -879,37 +680,38 @@ static void warning_report_vspan(WarningType type,
                                  const char* message,
                                  va_list args)
 {
+    DiagnosticState* ds = diagnostic_state();
     // التحقق من تفعيل التحذير
-    if (!g_warning_config.all_warnings && !g_warning_config.enabled[type]) {
+    if (!ds->warnings.all_warnings && !ds->warnings.enabled[type]) {
         return;
     }
 
     span = diagnostic_span_normalize(span);
     
-    had_warning = true;
-    warning_count++;
-    bool use_color = g_warning_config.colored_output;
+    ds->had_warning = true;
+    ds->warning_count++;
+    bool use_color = ds->warnings.colored_output;
     
     // إذا كانت التحذيرات تُعامل كأخطاء
-    if (g_warning_config.warnings_as_errors) {
-        had_error = true;
+    if (ds->warnings.warnings_as_errors) {
+        ds->had_error = true;
     }
     
     // طباعة رأس التحذير
     const char* warn_name = warning_type_name(type);
     const char* warn_code = warning_type_code(type);
     const char* warn_category = diagnostic_category_for_code(warn_code);
-    const char* severity = g_warning_config.warnings_as_errors ? "error" : "warning";
+    const char* severity = ds->warnings.warnings_as_errors ? "error" : "warning";
     char* formatted = diagnostic_vformat(message, args);
     diagnostics_json_add(warn_code, severity, warn_category, span, NULL, NULL,
                          formatted ? formatted : "");
-    if (g_diagnostics_json_enabled) {
+    if (ds->json_enabled) {
         free(formatted);
         return;
     }
     
     if (use_color) {
-        if (g_warning_config.warnings_as_errors) {
+        if (ds->warnings.warnings_as_errors) {
             fprintf(stderr, "%s[Error]%s %s[%s]%s %s[%s]%s %s:%d:%d: ",
                     ANSI_BOLD_RED, ANSI_RESET,
                     ANSI_CYAN, warn_code, ANSI_RESET,
@@ -924,7 +726,7 @@ static void warning_report_vspan(WarningType type,
         }
         fprintf(stderr, "%s[-W%s]%s ", ANSI_CYAN, warn_name, ANSI_RESET);
     } else {
-        if (g_warning_config.warnings_as_errors) {
+        if (ds->warnings.warnings_as_errors) {
             fprintf(stderr, "[Error] [%s] [%s] %s:%d:%d: ",
                     warn_code, warn_category,
                     span.filename ? span.filename : "unknown", span.line, span.col);
@@ -941,7 +743,7 @@ static void warning_report_vspan(WarningType type,
     fprintf(stderr, "\n");
 
     // طباعة سياق الكود
-    const char* ptr_color = g_warning_config.warnings_as_errors ? ANSI_BOLD_RED : ANSI_BOLD_YELLOW;
+    const char* ptr_color = ds->warnings.warnings_as_errors ? ANSI_BOLD_RED : ANSI_BOLD_YELLOW;
     print_source_line(span, use_color, ptr_color);
     fprintf(stderr, "\n");
     free(formatted);
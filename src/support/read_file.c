@@ -12,15 +12,16 @@
 #ifdef _WIN32
 #include <fcntl.h>
 #include <io.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
-static void read_file_die(FILE* f, char* buffer, const char* msg)
-{
-    if (f) fclose(f);
-    free(buffer);
-    printf("%s\n", msg);
-    exit(1);
-}
+// أصغر ملف يستحق الربط بالذاكرة؛ ما دونه تكفيه قراءة واحدة أسرع من mmap/munmap.
+#define READ_FILE_MAP_MIN_BYTES ((size_t)16u * 1024u)
 
 typedef enum
 {
@@ -28,12 +29,11 @@ typedef enum
     READ_FILE_ERR_SEEK,
     READ_FILE_ERR_SIZE,
     READ_FILE_ERR_READ,
+    READ_FILE_ERR_MEMORY,
 } ReadFilePathError;
 
-static void read_file_die_path(FILE* f, char* buffer, const char* path, ReadFilePathError err)
+static void read_file_die_path(const char* path, ReadFilePathError err)
 {
-    if (f) fclose(f);
-    free(buffer);
     switch (err)
     {
         case READ_FILE_ERR_OPEN:
@@ -45,9 +45,10 @@ static void read_file_die_path(FILE* f, char* buffer, const char* path, ReadFile
         case READ_FILE_ERR_SIZE:
             printf("Error: Could not read size of input file '%s'\n", path);
             break;
-        case READ_FILE_ERR_READ:
-            printf("Error: Could not read input file '%s'\n", path);
+        case READ_FILE_ERR_MEMORY:
+            printf("Error: Memory allocation failed\n");
             break;
+        case READ_FILE_ERR_READ:
         default:
             printf("Error: Could not read input file '%s'\n", path);
             break;
@@ -55,34 +56,40 @@ static void read_file_die_path(FILE* f, char* buffer, const char* path, ReadFile
     exit(1);
 }
 
-char *read_file(const char *path)
+/**
+ * @brief القراءة عبر FILE* إلى مخزن على الكومة (المسار المحمول لكل المنصات).
+ */
+static bool read_file_load_stream(const char* path, BaaSourceFile* out, ReadFilePathError* err)
 {
     FILE *f = baa_fopen_utf8(path, "rb");
     if (!f)
     {
-        read_file_die_path(NULL, NULL, path, READ_FILE_ERR_OPEN);
+        *err = READ_FILE_ERR_OPEN;
+        return false;
     }
 
+    long length = -1;
     if (fseek(f, 0, SEEK_END) != 0)
+        *err = READ_FILE_ERR_SEEK;
+    else if ((length = ftell(f)) < 0)
+        *err = READ_FILE_ERR_SIZE;
+    else if (fseek(f, 0, SEEK_SET) != 0)
     {
-        read_file_die_path(f, NULL, path, READ_FILE_ERR_SEEK);
+        *err = READ_FILE_ERR_SEEK;
+        length = -1;
     }
-
-    long length = ftell(f);
     if (length < 0)
     {
-        read_file_die_path(f, NULL, path, READ_FILE_ERR_SIZE);
-    }
-
-    if (fseek(f, 0, SEEK_SET) != 0)
-    {
-        read_file_die_path(f, NULL, path, READ_FILE_ERR_SEEK);
+        fclose(f);
+        return false;
     }
 
     char *buffer = (char *)malloc((size_t)length + 1);
     if (!buffer)
     {
-        read_file_die(f, NULL, "Error: Memory allocation failed");
+        fclose(f);
+        *err = READ_FILE_ERR_MEMORY;
+        return false;
     }
 
     size_t got = fread(buffer, 1, (size_t)length, f);
@@ -90,14 +97,157 @@ char *read_file(const char *path)
     {
         if (ferror(f))
         {
-            read_file_die_path(f, buffer, path, READ_FILE_ERR_READ);
+            fclose(f);
+            free(buffer);
+            *err = READ_FILE_ERR_READ;
+            return false;
         }
         length = (long)got;
     }
 
     buffer[length] = '\0';
     fclose(f);
-    return buffer;
+    out->data = buffer;
+    out->length = (size_t)length;
+    out->mapped = false;
+    return true;
+}
+
+#ifndef _WIN32
+typedef enum
+{
+    READ_FILE_FD_LOADED,
+    READ_FILE_FD_FALLBACK,  // ليس ملفاً عادياً؛ يُترك للقراءة عبر FILE*
+    READ_FILE_FD_FAILED,
+} ReadFileFdResult;
+
+/**
+ * @brief تحميل ملف عادي عبر واصف واحد: ربطه بالذاكرة أو قراءته دفعة واحدة.
+ *
+ * يُربط الملف حين لا يكون حجمه مضاعفاً لحجم الصفحة: النواة تملأ بقية آخر صفحة
+ * بعد نهاية الملف بأصفار، فيقع الصفر الختامي داخل الربط دون نسخ.
+ */
+static ReadFileFdResult read_file_load_fd(const char* path, BaaSourceFile* out, ReadFilePathError* err)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        *err = READ_FILE_ERR_OPEN;
+        return READ_FILE_FD_FAILED;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        close(fd);
+        return READ_FILE_FD_FALLBACK;
+    }
+
+    const size_t length = (size_t)st.st_size;
+    const long page = sysconf(_SC_PAGESIZE);
+    if (length >= READ_FILE_MAP_MIN_BYTES && page > 0 && (length % (size_t)page) != 0)
+    {
+        void* view = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED)
+        {
+            close(fd);
+            out->data = (char*)view;
+            out->length = length;
+            out->mapped = true;
+            return READ_FILE_FD_LOADED;
+        }
+    }
+
+    char* buffer = (char*)malloc(length + 1u);
+    if (!buffer)
+    {
+        close(fd);
+        *err = READ_FILE_ERR_MEMORY;
+        return READ_FILE_FD_FAILED;
+    }
+    size_t got = 0;
+    while (got < length)
+    {
+        ssize_t n = read(fd, buffer + got, length - got);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0)
+        {
+            close(fd);
+            free(buffer);
+            *err = READ_FILE_ERR_READ;
+            return READ_FILE_FD_FAILED;
+        }
+        if (n == 0) break;  // تقلّص الملف بعد fstat
+        got += (size_t)n;
+    }
+    close(fd);
+    buffer[got] = '\0';
+    out->data = buffer;
+    out->length = got;
+    out->mapped = false;
+    return READ_FILE_FD_LOADED;
+}
+#endif
+
+static bool read_file_load(const char* path, BaaSourceFile* out, ReadFilePathError* err)
+{
+    out->data = NULL;
+    out->length = 0;
+    out->mapped = false;
+    if (!path || !path[0])
+    {
+        *err = READ_FILE_ERR_OPEN;
+        return false;
+    }
+#ifndef _WIN32
+    switch (read_file_load_fd(path, out, err))
+    {
+        case READ_FILE_FD_LOADED:
+            return true;
+        case READ_FILE_FD_FAILED:
+            return false;
+        case READ_FILE_FD_FALLBACK:
+        default:
+            break;
+    }
+#endif
+    return read_file_load_stream(path, out, err);
+}
+
+char *read_file(const char *path)
+{
+    BaaSourceFile file;
+    ReadFilePathError err = READ_FILE_ERR_READ;
+    if (!read_file_load_stream(path, &file, &err))
+        read_file_die_path(path, err);
+    return file.data;
+}
+
+void read_source_file(const char* path, BaaSourceFile* out)
+{
+    ReadFilePathError err = READ_FILE_ERR_READ;
+    if (!read_file_load(path, out, &err))
+        read_file_die_path(path, err);
+}
+
+bool baa_source_file_load(const char* path, BaaSourceFile* out)
+{
+    ReadFilePathError err = READ_FILE_ERR_READ;
+    return out && read_file_load(path, out, &err);
+}
+
+void baa_source_file_release(BaaSourceFile* file)
+{
+    if (!file || !file->data) return;
+#ifndef _WIN32
+    if (file->mapped)
+        (void)munmap(file->data, file->length);
+    else
+#endif
+        free(file->data);
+    file->data = NULL;
+    file->length = 0;
+    file->mapped = false;
 }
 
 char *read_stdin_source(void)
@@ -6,7 +6,37 @@
 #ifndef BAA_READ_FILE_H
 #define BAA_READ_FILE_H
 
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief نص ملف مصدر محمّل في الذاكرة، منتهٍ دائماً بصفر عند data[length].
+ *
+ * يُربط الملف بالذاكرة (mmap) حين يسمح حجمه بذلك، وإلا يُقرأ إلى مخزن على الكومة.
+ * الربط خاص (MAP_PRIVATE)، فالكتابة في المخزن لا تصل إلى الملف.
+ */
+typedef struct {
+    char* data;
+    size_t length;
+    bool mapped;
+} BaaSourceFile;
+
 char* read_file(const char* path);
 char* read_stdin_source(void);
 
+/**
+ * @brief تحميل ملف مصدر؛ ينهي العملية برسالة read_file() نفسها عند الفشل.
+ */
+void read_source_file(const char* path, BaaSourceFile* out);
+
+/**
+ * @brief تحميل ملف مصدر دون إنهاء العملية؛ تعيد false إن تعذر فتحه أو قراءته.
+ */
+bool baa_source_file_load(const char* path, BaaSourceFile* out);
+
+/**
+ * @brief تحرير مخزن محمّل عبر read_source_file() أو baa_source_file_load().
+ */
+void baa_source_file_release(BaaSourceFile* file);
+
 #endif
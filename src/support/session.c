@@ -0,0 +1,66 @@
+/**
+ * @file session.c
+ * @brief جلسة الترجمة وربطها بالخيط الحالي.
+ */
+
+#include "support_internal.h"
+
+struct BaaSession {
+    void* slots[BAA_SESSION_SLOT_COUNT];
+    BaaSessionSlotDestroy destroy[BAA_SESSION_SLOT_COUNT];
+};
+
+static BAA_THREAD_LOCAL BaaSession* g_session_bound = NULL;
+
+BaaSession* baa_session_create(void)
+{
+    return (BaaSession*)calloc(1, sizeof(BaaSession));
+}
+
+void baa_session_destroy(BaaSession* session)
+{
+    if (!session) return;
+
+    for (int i = 0; i < BAA_SESSION_SLOT_COUNT; i++) {
+        if (session->slots[i] && session->destroy[i]) {
+            session->destroy[i](session->slots[i]);
+        }
+        session->slots[i] = NULL;
+        session->destroy[i] = NULL;
+    }
+
+    if (g_session_bound == session) g_session_bound = NULL;
+    free(session);
+}
+
+BaaSession* baa_session_bind(BaaSession* session)
+{
+    BaaSession* previous = g_session_bound;
+    g_session_bound = session;
+    return previous;
+}
+
+BaaSession* baa_session_current(void)
+{
+    return g_session_bound;
+}
+
+void* baa_session_slot(BaaSession* session, BaaSessionSlot slot)
+{
+    if (!session || slot < 0 || slot >= BAA_SESSION_SLOT_COUNT) return NULL;
+    return session->slots[slot];
+}
+
+void baa_session_set_slot(BaaSession* session,
+                          BaaSessionSlot slot,
+                          void* state,
+                          BaaSessionSlotDestroy destroy)
+{
+    if (!session || slot < 0 || slot >= BAA_SESSION_SLOT_COUNT) return;
+
+    if (session->slots[slot] && session->destroy[slot] && session->slots[slot] != state) {
+        session->destroy[slot](session->slots[slot]);
+    }
+    session->slots[slot] = state;
+    session->destroy[slot] = destroy;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file session.h
+ * @brief جلسة الترجمة: المالك الصريح لكل حالة الترجمة القابلة للتغيير.
+ *
+ * تحتفظ الجلسة بحالة التشخيصات والتحليل الدلالي بدلاً من متغيرات عامة على
+ * مستوى العملية. ينشئها المستدعي صراحةً ويمررها إلى نقاط الدخول
+ * (`parse()`، `analyze()`)، وهذه تربطها بالخيط طوال الاستدعاء فقط ثم تعيد
+ * الربط السابق، لذا يمكن لعدة خيوط أن تترجم وحدات مختلفة في الوقت نفسه،
+ * ويمكن لأداة طويلة العمر أن تنشئ جلسة جديدة لكل ترجمة.
+ *
+ * لا توجد جلسة افتراضية ضمنية: تشخيص خارج جلسة مربوطة خطأ داخلي.
+ */
+
+#ifndef BAA_SUPPORT_SESSION_H
+#define BAA_SUPPORT_SESSION_H
+
+#if defined(_MSC_VER)
+#define BAA_THREAD_LOCAL __declspec(thread)
+#else
+#define BAA_THREAD_LOCAL _Thread_local
+#endif
+
+/**
+ * @enum BaaSessionSlot
+ * @brief خانات الحالة التي تملكها الجلسة؛ كل نظام فرعي يملأ خانته عند أول استخدام.
+ */
+typedef enum {
+    BAA_SESSION_SLOT_DIAGNOSTICS = 0, /**< support/error.c */
+    BAA_SESSION_SLOT_ANALYSIS,        /**< frontend/analysis.c */
+    BAA_SESSION_SLOT_COUNT
+} BaaSessionSlot;
+
+typedef struct BaaSession BaaSession;
+typedef void (*BaaSessionSlotDestroy)(void* state);
+
+/**
+ * @brief إنشاء جلسة فارغة (NULL عند نفاد الذاكرة).
+ */
+BaaSession* baa_session_create(void);
+
+/**
+ * @brief تحرير الجلسة وكل حالات خاناتها. لا يجوز تحرير جلسة مربوطة بخيط آخر.
+ */
+void baa_session_destroy(BaaSession* session);
+
+/**
+ * @brief ربط جلسة بالخيط الحالي (NULL يفك الربط).
+ * @return الجلسة المربوطة سابقاً لاستعادتها لاحقاً.
+ */
+BaaSession* baa_session_bind(BaaSession* session);
+
+/**
+ * @brief الجلسة المربوطة بالخيط الحالي (NULL إن لم تُربط جلسة).
+ */
+BaaSession* baa_session_current(void);
+
+/**
+ * @brief حالة الخانة المطلوبة (NULL إن لم تُملأ بعد).
+ */
+void* baa_session_slot(BaaSession* session, BaaSessionSlot slot);
+
+/**
+ * @brief تعيين حالة خانة مع دالة تحريرها؛ تُحرَّر الحالة السابقة إن وُجدت.
+ */
+void baa_session_set_slot(BaaSession* session,
+                          BaaSessionSlot slot,
+                          void* state,
+                          BaaSessionSlotDestroy destroy);
+
+#endif
@@ -0,0 +1,229 @@
+/**
+ * @file source_cache.c
+ * @brief تنفيذ الذاكرة المخبئية لملفات التضمين.
+ *
+ * التحميل نفسه يجري خارج القفل؛ إن سبق خيط آخر إلى الملف نفسه تُحرَّر النسخة
+ * الزائدة. النسخ التي تغيّر ملفها أثناء البناء لا تُحرَّر فوراً لأن وحدات سابقة
+ * قد تشير إليها (مواقع الرموز ونصوص التشخيص)، بل تُنقل إلى قائمة قديمة.
+ */
+
+#include "support_internal.h"
+#include "source_cache.h"
+
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <wchar.h>
+#endif
+
+typedef struct {
+    char* key;          // المسار المطلق المطبّع
+    unsigned int hash;  // تجزئة FNV-1a للمفتاح
+    long long mtime;
+    long long size;
+    BaaSourceFile file;
+} SourceCacheEntry;
+
+static SourceCacheEntry* g_entries = NULL;
+static size_t g_entry_count = 0;
+static size_t g_entry_cap = 0;
+
+static BaaSourceFile* g_stale = NULL;
+static size_t g_stale_count = 0;
+static size_t g_stale_cap = 0;
+
+static BaaSourceCacheStats g_stats;
+static atomic_flag g_lock = ATOMIC_FLAG_INIT;
+
+static void source_cache_lock(void)
+{
+    while (atomic_flag_test_and_set_explicit(&g_lock, memory_order_acquire)) {
+    }
+}
+
+static void source_cache_unlock(void)
+{
+    atomic_flag_clear_explicit(&g_lock, memory_order_release);
+}
+
+static unsigned int source_cache_hash(const char* key)
+{
+    unsigned int h = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)key; *p; ++p) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static double source_cache_now(void)
+{
+    struct timespec ts;
+    if (timespec_get(&ts, TIME_UTC) != TIME_UTC) return 0.0;
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief زمن التعديل والحجم لملف عادي؛ false للمجلدات والملفات المفقودة.
+ */
+static bool source_cache_stat(const char* path, long long* out_mtime, long long* out_size)
+{
+#ifdef _WIN32
+    wchar_t* wide = baa_windows_extended_path_utf8(path);
+    if (!wide) return false;
+    struct _stat64 st;
+    const int rc = _wstat64(wide, &st);
+    free(wide);
+    if (rc != 0 || (st.st_mode & _S_IFMT) != _S_IFREG) return false;
+#else
+    struct stat st;
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) return false;
+#endif
+    *out_mtime = (long long)st.st_mtime;
+    *out_size = (long long)st.st_size;
+    return true;
+}
+
+static SourceCacheEntry* source_cache_find(const char* key, unsigned int hash)
+{
+    for (size_t i = 0; i < g_entry_count; ++i) {
+        if (g_entries[i].hash == hash && strcmp(g_entries[i].key, key) == 0) {
+            return &g_entries[i];
+        }
+    }
+    return NULL;
+}
+
+static bool source_cache_matches(const SourceCacheEntry* e, long long mtime, long long size)
+{
+    return e && e->mtime == mtime && e->size == size;
+}
+
+static bool source_cache_grow(void** items, size_t* cap, size_t need, size_t elem_size)
+{
+    if (need <= *cap) return true;
+    size_t new_cap = *cap ? *cap * 2u : 16u;
+    while (new_cap < need) new_cap *= 2u;
+    void* grown = realloc(*items, new_cap * elem_size);
+    if (!grown) return false;
+    *items = grown;
+    *cap = new_cap;
+    return true;
+}
+
+char* baa_source_cache_get(const char* path, size_t* out_length)
+{
+    if (!path || !path[0]) return NULL;
+
+    char* key = baa_fullpath_utf8(path);
+    if (!key) {
+        key = strdup(path);
+        if (!key) return NULL;
+    }
+
+    long long mtime = 0;
+    long long size = 0;
+    if (!source_cache_stat(key, &mtime, &size)) {
+        free(key);
+        return NULL;
+    }
+
+    const unsigned int hash = source_cache_hash(key);
+    source_cache_lock();
+    SourceCacheEntry* hit = source_cache_find(key, hash);
+    if (source_cache_matches(hit, mtime, size)) {
+        char* data = hit->file.data;
+        if (out_length) *out_length = hit->file.length;
+        g_stats.hits++;
+        source_cache_unlock();
+        free(key);
+        return data;
+    }
+    source_cache_unlock();
+
+    const double t0 = source_cache_now();
+    BaaSourceFile file;
+    if (!baa_source_file_load(key, &file)) {
+        free(key);
+        return NULL;
+    }
+    const double elapsed = source_cache_now() - t0;
+
+    source_cache_lock();
+    SourceCacheEntry* entry = source_cache_find(key, hash);
+    if (source_cache_matches(entry, mtime, size)) {
+        // سبقنا خيط آخر إلى الملف نفسه.
+        char* data = entry->file.data;
+        if (out_length) *out_length = entry->file.length;
+        g_stats.hits++;
+        source_cache_unlock();
+        baa_source_file_release(&file);
+        free(key);
+        return data;
+    }
+
+    if (entry) {
+        if (!source_cache_grow((void**)&g_stale, &g_stale_cap, g_stale_count + 1u, sizeof(BaaSourceFile))) {
+            source_cache_unlock();
+            baa_source_file_release(&file);
+            free(key);
+            return NULL;
+        }
+        g_stale[g_stale_count++] = entry->file;
+        free(key);
+    } else {
+        if (!source_cache_grow((void**)&g_entries, &g_entry_cap, g_entry_count + 1u, sizeof(SourceCacheEntry))) {
+            source_cache_unlock();
+            baa_source_file_release(&file);
+            free(key);
+            return NULL;
+        }
+        entry = &g_entries[g_entry_count++];
+        entry->key = key;
+        entry->hash = hash;
+    }
+    entry->mtime = mtime;
+    entry->size = size;
+    entry->file = file;
+
+    g_stats.loads++;
+    if (file.mapped) g_stats.mapped++;
+    g_stats.bytes += file.length;
+    g_stats.load_seconds += elapsed;
+
+    char* data = entry->file.data;
+    if (out_length) *out_length = entry->file.length;
+    source_cache_unlock();
+    return data;
+}
+
+void baa_source_cache_get_stats(BaaSourceCacheStats* out)
+{
+    if (!out) return;
+    source_cache_lock();
+    *out = g_stats;
+    source_cache_unlock();
+}
+
+void baa_source_cache_clear(void)
+{
+    source_cache_lock();
+    for (size_t i = 0; i < g_entry_count; ++i) {
+        free(g_entries[i].key);
+        baa_source_file_release(&g_entries[i].file);
+    }
+    for (size_t i = 0; i < g_stale_count; ++i) {
+        baa_source_file_release(&g_stale[i]);
+    }
+    free(g_entries);
+    free(g_stale);
+    g_entries = NULL;
+    g_entry_count = 0;
+    g_entry_cap = 0;
+    g_stale = NULL;
+    g_stale_count = 0;
+    g_stale_cap = 0;
+    source_cache_unlock();
+}
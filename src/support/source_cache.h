@@ -0,0 +1,40 @@
+/**
+ * @file source_cache.h
+ * @brief ذاكرة مخبئية لملفات التضمين على مستوى العملية.
+ *
+ * يُحمَّل كل ملف مرة واحدة لكل بناء ويُشارك بين كل وحدات الترجمة التي تضمّنه.
+ * المفتاح هو المسار المطلق المطبّع مع زمن التعديل والحجم؛ إن تغيّر أحدهما أُعيد
+ * التحميل. تبقى المخازن صالحة حتى baa_source_cache_clear().
+ */
+
+#ifndef BAA_SOURCE_CACHE_H
+#define BAA_SOURCE_CACHE_H
+
+#include <stddef.h>
+
+typedef struct {
+    size_t loads;        /**< ملفات حُمّلت من القرص (بما فيها إعادة التحميل بعد تغيّرها) */
+    size_t hits;         /**< طلبات خُدمت من الذاكرة المخبئية */
+    size_t mapped;       /**< ما رُبط منها بالذاكرة بدل قراءته */
+    size_t bytes;        /**< مجموع أحجام الملفات المحمّلة */
+    double load_seconds; /**< زمن التحميل من القرص */
+} BaaSourceCacheStats;
+
+/**
+ * @brief نص الملف (منتهٍ بصفر)، أو NULL إن لم يكن ملفاً عادياً قابلاً للقراءة.
+ *
+ * المخزن مملوك للذاكرة المخبئية ومشترك بين المستدعين؛ لا يُحرَّر ولا يُعدَّل.
+ */
+char* baa_source_cache_get(const char* path, size_t* out_length);
+
+/**
+ * @brief إحصاءات تراكمية منذ بدء العملية.
+ */
+void baa_source_cache_get_stats(BaaSourceCacheStats* out);
+
+/**
+ * @brief تحرير كل المخازن؛ يُستدعى مرة واحدة عند انتهاء البناء.
+ */
+void baa_source_cache_clear(void);
+
+#endif
@@ -17,6 +17,7 @@
 #include "file_io.h"
 #include "read_file.h"
 #include "diagnostics.h"
+#include "session.h"
 #include "updater.h"
 
 #endif
@@ -0,0 +1,405 @@
+/**
+ * @file text_scan.c
+ * @brief تنفيذ مسح النصوص بالجملة بمسارات SSE2/AVX2 ومسار عددي احتياطي.
+ *
+ * التحقق من UTF-8 متجهياً يغطي الحالة الشائعة في مصادر باء: نص ASCII ممزوج
+ * بحروف عربية ثنائية البايت. أي كتلة فيها تسلسل أطول أو خطأ تُحسم بالمسار العددي
+ * من بداية التسلسل، فتبقى إزاحة أول خطأ مطابقة تماماً للتحقق بايتاً ببايت.
+ */
+
+#include "support_internal.h"
+#include "text_scan.h"
+
+#include <stdatomic.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BAA_TEXT_SCAN_X86 1
+#include <immintrin.h>
+#define TS_TARGET_SSE2 __attribute__((target("sse2")))
+#define TS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define BAA_TEXT_SCAN_X86 0
+#endif
+
+// -1 = لم يُكتشف بعد؛ القيمة نفسها تُكتب من أي خيط، لذا يكفي ترتيب relaxed.
+static atomic_int g_text_scan_level = -1;
+
+static BaaTextScanLevel ts_detect_level(void)
+{
+#if BAA_TEXT_SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return BAA_TEXT_SCAN_AVX2;
+    if (__builtin_cpu_supports("sse2")) return BAA_TEXT_SCAN_SSE2;
+#endif
+    return BAA_TEXT_SCAN_SCALAR;
+}
+
+BaaTextScanLevel baa_text_scan_level(void)
+{
+    int level = atomic_load_explicit(&g_text_scan_level, memory_order_relaxed);
+    if (level < 0) {
+        level = (int)ts_detect_level();
+        atomic_store_explicit(&g_text_scan_level, level, memory_order_relaxed);
+    }
+    return (BaaTextScanLevel)level;
+}
+
+BaaTextScanLevel baa_text_scan_limit_level(BaaTextScanLevel max_level)
+{
+    BaaTextScanLevel level = ts_detect_level();
+    if (max_level < level) level = max_level;
+    atomic_store_explicit(&g_text_scan_level, (int)level, memory_order_relaxed);
+    return level;
+}
+
+// ============================================================================
+// المسار العددي (Scalar)
+// ============================================================================
+
+static int ts_is_cont(unsigned char b)
+{
+    return (b & 0xC0u) == 0x80u;
+}
+
+int baa_utf8_sequence_length(const char* text, size_t remaining)
+{
+    if (!text || remaining == 0u) return 0;
+    const unsigned char* s = (const unsigned char*)text;
+    const unsigned char b0 = s[0];
+    if (b0 < 0x80u) return 1;
+
+    if ((b0 & 0xE0u) == 0xC0u) {
+        if (remaining < 2u || !ts_is_cont(s[1])) return 0;
+        uint32_t cp = ((uint32_t)(b0 & 0x1Fu) << 6) | (uint32_t)(s[1] & 0x3Fu);
+        return cp >= 0x80u ? 2 : 0;
+    }
+    if ((b0 & 0xF0u) == 0xE0u) {
+        if (remaining < 3u || !ts_is_cont(s[1]) || !ts_is_cont(s[2])) return 0;
+        uint32_t cp = ((uint32_t)(b0 & 0x0Fu) << 12) |
+                      ((uint32_t)(s[1] & 0x3Fu) << 6) |
+                      (uint32_t)(s[2] & 0x3Fu);
+        if (cp < 0x800u) return 0;                     // overlong
+        if (cp >= 0xD800u && cp <= 0xDFFFu) return 0;  // surrogate
+        return 3;
+    }
+    if ((b0 & 0xF8u) == 0xF0u) {
+        if (remaining < 4u || !ts_is_cont(s[1]) || !ts_is_cont(s[2]) || !ts_is_cont(s[3])) return 0;
+        uint32_t cp = ((uint32_t)(b0 & 0x07u) << 18) |
+                      ((uint32_t)(s[1] & 0x3Fu) << 12) |
+                      ((uint32_t)(s[2] & 0x3Fu) << 6) |
+                      (uint32_t)(s[3] & 0x3Fu);
+        return (cp >= 0x10000u && cp <= 0x10FFFFu) ? 4 : 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief التحقق العددي بدءاً من i (حد تسلسل) حتى stop على الأقل.
+ * @return إزاحة أول تسلسل غير صالح، أو أول حد تسلسل >= stop.
+ */
+static size_t ts_valid_scalar(const unsigned char* s, size_t i, size_t stop, size_t length, int* ok)
+{
+    *ok = 1;
+    while (i < stop) {
+        if (stop - i >= 8u) {
+            uint64_t word;
+            memcpy(&word, s + i, sizeof(word));
+            if ((word & 0x8080808080808080ull) == 0u) {
+                i += 8u;
+                continue;
+            }
+        }
+        if (s[i] < 0x80u) {
+            i++;
+            continue;
+        }
+        const int n = baa_utf8_sequence_length((const char*)s + i, length - i);
+        if (n == 0) {
+            *ok = 0;
+            return i;
+        }
+        i += (size_t)n;
+    }
+    return i;
+}
+
+static size_t ts_valid_prefix_scalar(const unsigned char* s, size_t length)
+{
+    int ok = 1;
+    size_t i = ts_valid_scalar(s, 0, length, length, &ok);
+    return ok ? length : i;
+}
+
+static size_t ts_count_newlines_scalar(const unsigned char* s, size_t i, size_t length, size_t count)
+{
+    for (; i < length; i++) count += (s[i] == '\n');
+    return count;
+}
+
+static int ts_is_space(unsigned char b)
+{
+    return b == ' ' || (b >= '\t' && b <= '\r');
+}
+
+static size_t ts_span_space_scalar(const unsigned char* s, size_t i, size_t length)
+{
+    while (i < length && ts_is_space(s[i])) i++;
+    return i;
+}
+
+static size_t ts_find_either_scalar(const unsigned char* s, size_t i, size_t length,
+                                    unsigned char a, unsigned char b)
+{
+    while (i < length && s[i] != a && s[i] != b) i++;
+    return i;
+}
+
+#if BAA_TEXT_SCAN_X86
+
+// ============================================================================
+// مسار SSE2 (16 بايت لكل كتلة)
+// ============================================================================
+
+/*
+ * قناعا البايت القائد الثنائي [C2,DF] والبايت التابع [80,BF] يُحسبان بمقارنة
+ * موقّعة بعد قلب البت الأعلى. الكتلة صالحة إذا كانت كل بايتاتها العليا قائدة أو
+ * تابعة، وكان كل تابع مسبوقاً بقائد مباشرة (مع ترحيل قائد آخر الكتلة).
+ */
+TS_TARGET_SSE2
+static size_t ts_valid_prefix_sse2(const unsigned char* s, size_t length)
+{
+    const __m128i flip = _mm_set1_epi8((char)0x80);
+    const __m128i lead_lo = _mm_set1_epi8(0x41);
+    const __m128i lead_hi = _mm_set1_epi8(0x60);
+    const __m128i cont_lo = _mm_set1_epi8(-1);
+    const __m128i cont_hi = _mm_set1_epi8(0x40);
+    size_t i = 0;
+    unsigned carry = 0;
+
+    while (length - i >= 16u) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+        const unsigned high = (unsigned)_mm_movemask_epi8(v);
+        if ((high | carry) == 0u) {
+            i += 16u;
+            continue;
+        }
+        const __m128i x = _mm_xor_si128(v, flip);
+        const unsigned lead = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpgt_epi8(x, lead_lo), _mm_cmplt_epi8(x, lead_hi)));
+        const unsigned cont = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpgt_epi8(x, cont_lo), _mm_cmplt_epi8(x, cont_hi)));
+        if ((lead | cont) == high && cont == (((lead << 1) | carry) & 0xFFFFu)) {
+            carry = lead >> 15;
+            i += 16u;
+            continue;
+        }
+
+        int ok = 1;
+        const size_t stop = i + 16u;
+        i = ts_valid_scalar(s, i - carry, stop, length, &ok);
+        if (!ok) return i;
+        carry = 0;
+    }
+
+    int ok = 1;
+    i = ts_valid_scalar(s, i - carry, length, length, &ok);
+    return ok ? length : i;
+}
+
+TS_TARGET_SSE2
+static size_t ts_count_newlines_sse2(const unsigned char* s, size_t length)
+{
+    const __m128i nl = _mm_set1_epi8('\n');
+    size_t i = 0;
+    size_t count = 0;
+    for (; length - i >= 16u; i += 16u) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+        count += (size_t)__builtin_popcount((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl)));
+    }
+    return ts_count_newlines_scalar(s, i, length, count);
+}
+
+TS_TARGET_SSE2
+static size_t ts_span_space_sse2(const unsigned char* s, size_t length)
+{
+    const __m128i sp = _mm_set1_epi8(' ');
+    const __m128i lo = _mm_set1_epi8('\t' - 1);
+    const __m128i hi = _mm_set1_epi8('\r' + 1);
+    size_t i = 0;
+    for (; length - i >= 16u; i += 16u) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+        const __m128i is_space = _mm_or_si128(_mm_cmpeq_epi8(v, sp),
+                                              _mm_and_si128(_mm_cmpgt_epi8(v, lo), _mm_cmplt_epi8(v, hi)));
+        const unsigned other = ~(unsigned)_mm_movemask_epi8(is_space) & 0xFFFFu;
+        if (other) return i + (size_t)__builtin_ctz(other);
+    }
+    return ts_span_space_scalar(s, i, length);
+}
+
+TS_TARGET_SSE2
+static size_t ts_find_either_sse2(const unsigned char* s, size_t length, unsigned char a, unsigned char b)
+{
+    const __m128i va = _mm_set1_epi8((char)a);
+    const __m128i vb = _mm_set1_epi8((char)b);
+    size_t i = 0;
+    for (; length - i >= 16u; i += 16u) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+        const unsigned hit = (unsigned)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)));
+        if (hit) return i + (size_t)__builtin_ctz(hit);
+    }
+    return ts_find_either_scalar(s, i, length, a, b);
+}
+
+// ============================================================================
+// مسار AVX2 (32 بايت لكل كتلة)
+// ============================================================================
+
+TS_TARGET_AVX2
+static size_t ts_valid_prefix_avx2(const unsigned char* s, size_t length)
+{
+    const __m256i flip = _mm256_set1_epi8((char)0x80);
+    const __m256i lead_lo = _mm256_set1_epi8(0x41);
+    const __m256i lead_hi = _mm256_set1_epi8(0x60);
+    const __m256i cont_lo = _mm256_set1_epi8(-1);
+    const __m256i cont_hi = _mm256_set1_epi8(0x40);
+    size_t i = 0;
+    uint32_t carry = 0;
+
+    while (length - i >= 32u) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+        const uint32_t high = (uint32_t)_mm256_movemask_epi8(v);
+        if ((high | carry) == 0u) {
+            i += 32u;
+            continue;
+        }
+        const __m256i x = _mm256_xor_si256(v, flip);
+        const uint32_t lead = (uint32_t)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpgt_epi8(x, lead_lo), _mm256_cmpgt_epi8(lead_hi, x)));
+        const uint32_t cont = (uint32_t)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpgt_epi8(x, cont_lo), _mm256_cmpgt_epi8(cont_hi, x)));
+        if ((lead | cont) == high && cont == ((lead << 1) | carry)) {
+            carry = lead >> 31;
+            i += 32u;
+            continue;
+        }
+
+        int ok = 1;
+        const size_t stop = i + 32u;
+        i = ts_valid_scalar(s, i - carry, stop, length, &ok);
+        if (!ok) return i;
+        carry = 0;
+    }
+
+    int ok = 1;
+    i = ts_valid_scalar(s, i - carry, length, length, &ok);
+    return ok ? length : i;
+}
+
+TS_TARGET_AVX2
+static size_t ts_count_newlines_avx2(const unsigned char* s, size_t length)
+{
+    const __m256i nl = _mm256_set1_epi8('\n');
+    size_t i = 0;
+    size_t count = 0;
+    for (; length - i >= 32u; i += 32u) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+        count += (size_t)__builtin_popcount((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl)));
+    }
+    return ts_count_newlines_scalar(s, i, length, count);
+}
+
+TS_TARGET_AVX2
+static size_t ts_span_space_avx2(const unsigned char* s, size_t length)
+{
+    const __m256i sp = _mm256_set1_epi8(' ');
+    const __m256i lo = _mm256_set1_epi8('\t' - 1);
+    const __m256i hi = _mm256_set1_epi8('\r' + 1);
+    size_t i = 0;
+    for (; length - i >= 32u; i += 32u) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+        const __m256i is_space = _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, sp),
+            _mm256_and_si256(_mm256_cmpgt_epi8(v, lo), _mm256_cmpgt_epi8(hi, v)));
+        const uint32_t other = ~(uint32_t)_mm256_movemask_epi8(is_space);
+        if (other) return i + (size_t)__builtin_ctz(other);
+    }
+    return ts_span_space_scalar(s, i, length);
+}
+
+TS_TARGET_AVX2
+static size_t ts_find_either_avx2(const unsigned char* s, size_t length, unsigned char a, unsigned char b)
+{
+    const __m256i va = _mm256_set1_epi8((char)a);
+    const __m256i vb = _mm256_set1_epi8((char)b);
+    size_t i = 0;
+    for (; length - i >= 32u; i += 32u) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+        const uint32_t hit = (uint32_t)_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb)));
+        if (hit) return i + (size_t)__builtin_ctz(hit);
+    }
+    return ts_find_either_scalar(s, i, length, a, b);
+}
+
+#endif // BAA_TEXT_SCAN_X86
+
+// ============================================================================
+// الواجهة العامة (اختيار المسار)
+// ============================================================================
+
+size_t baa_utf8_valid_prefix(const char* text, size_t length)
+{
+    if (!text) return 0;
+    const unsigned char* s = (const unsigned char*)text;
+#if BAA_TEXT_SCAN_X86
+    switch (baa_text_scan_level()) {
+        case BAA_TEXT_SCAN_AVX2: return ts_valid_prefix_avx2(s, length);
+        case BAA_TEXT_SCAN_SSE2: return ts_valid_prefix_sse2(s, length);
+        default: break;
+    }
+#endif
+    return ts_valid_prefix_scalar(s, length);
+}
+
+size_t baa_text_count_newlines(const char* text, size_t length)
+{
+    if (!text) return 0;
+    const unsigned char* s = (const unsigned char*)text;
+#if BAA_TEXT_SCAN_X86
+    switch (baa_text_scan_level()) {
+        case BAA_TEXT_SCAN_AVX2: return ts_count_newlines_avx2(s, length);
+        case BAA_TEXT_SCAN_SSE2: return ts_count_newlines_sse2(s, length);
+        default: break;
+    }
+#endif
+    return ts_count_newlines_scalar(s, 0, length, 0);
+}
+
+size_t baa_text_span_space(const char* text, size_t length)
+{
+    if (!text) return 0;
+    const unsigned char* s = (const unsigned char*)text;
+#if BAA_TEXT_SCAN_X86
+    switch (baa_text_scan_level()) {
+        case BAA_TEXT_SCAN_AVX2: return ts_span_space_avx2(s, length);
+        case BAA_TEXT_SCAN_SSE2: return ts_span_space_sse2(s, length);
+        default: break;
+    }
+#endif
+    return ts_span_space_scalar(s, 0, length);
+}
+
+size_t baa_text_find_either(const char* text, size_t length, char a, char b)
+{
+    if (!text) return 0;
+    const unsigned char* s = (const unsigned char*)text;
+#if BAA_TEXT_SCAN_X86
+    switch (baa_text_scan_level()) {
+        case BAA_TEXT_SCAN_AVX2: return ts_find_either_avx2(s, length, (unsigned char)a, (unsigned char)b);
+        case BAA_TEXT_SCAN_SSE2: return ts_find_either_sse2(s, length, (unsigned char)a, (unsigned char)b);
+        default: break;
+    }
+#endif
+    return ts_find_either_scalar(s, 0, length, (unsigned char)a, (unsigned char)b);
+}
@@ -0,0 +1,57 @@
+/**
+ * @file text_scan.h
+ * @brief مسح نصوص المصدر بالجملة: التحقق من UTF-8، عدّ الأسطر، وتخطي المسافات.
+ *
+ * تختار الدوال عند أول استدعاء أوسع مسار متجهي يدعمه المعالج (AVX2 ثم SSE2)
+ * وترجع إلى مسار عددي (scalar) على بقية المعماريات. كل المسارات تعطي نتائج متطابقة.
+ */
+
+#ifndef BAA_TEXT_SCAN_H
+#define BAA_TEXT_SCAN_H
+
+#include <stddef.h>
+
+typedef enum {
+    BAA_TEXT_SCAN_SCALAR = 0,
+    BAA_TEXT_SCAN_SSE2 = 1,
+    BAA_TEXT_SCAN_AVX2 = 2,
+} BaaTextScanLevel;
+
+/**
+ * @brief المسار المستخدم حالياً.
+ */
+BaaTextScanLevel baa_text_scan_level(void);
+
+/**
+ * @brief حصر المسار بمستوى أقصى (للاختبار والقياس)؛ تعيد المستوى الفعلي بعد الحصر.
+ */
+BaaTextScanLevel baa_text_scan_limit_level(BaaTextScanLevel max_level);
+
+/**
+ * @brief طول تسلسل UTF-8 الصالح في بداية text (1..4)، أو 0 إن كان غير صالح.
+ *
+ * يرفض الترميز الزائد (overlong) وأنصاف البدائل (surrogates) وما تجاوز U+10FFFF.
+ */
+int baa_utf8_sequence_length(const char* text, size_t remaining);
+
+/**
+ * @brief إزاحة أول تسلسل UTF-8 غير صالح في text، أو length إن كان النص صالحاً كله.
+ */
+size_t baa_utf8_valid_prefix(const char* text, size_t length);
+
+/**
+ * @brief عدد محارف '\n' في أول length بايت.
+ */
+size_t baa_text_count_newlines(const char* text, size_t length);
+
+/**
+ * @brief طول سلسلة المسافات البيضاء (' '، '\t'، '\n'، '\v'، '\f'، '\r') في بداية text.
+ */
+size_t baa_text_span_space(const char* text, size_t length);
+
+/**
+ * @brief إزاحة أول بايت يساوي a أو b، أو length إن لم يوجد.
+ */
+size_t baa_text_find_either(const char* text, size_t length, char a, char b);
+
+#endif
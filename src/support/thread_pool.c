@@ -0,0 +1,217 @@
+/**
+ * @file thread_pool.c
+ * @brief تنفيذ مجمّع الخيوط (pthreads على POSIX وواجهة Win32 على ويندوز).
+ *
+ * الخيوط دائمة طوال عمر المجمّع وتنتظر "جيلاً" جديداً من المهام. كل تشغيل
+ * يرفع الجيل، ويسحب كل عامل (ومنه الخيط المستدعي) العناصر بعدّاد ذري حتى
+ * تنفد، ثم يُبلِغ بانتهائه. لا توجد طوابير؛ المهمة الواحدة نشطة في كل لحظة.
+ */
+
+#include "support_internal.h"
+#include "thread_pool.h"
+
+#include <stdatomic.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+typedef HANDLE BaaThread;
+typedef SRWLOCK BaaMutex;
+typedef CONDITION_VARIABLE BaaCond;
+#define baa_mutex_init(m) InitializeSRWLock(m)
+#define baa_mutex_lock(m) AcquireSRWLockExclusive(m)
+#define baa_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#define baa_mutex_destroy(m) ((void)(m))
+#define baa_cond_init(c) InitializeConditionVariable(c)
+#define baa_cond_wait(c, m) SleepConditionVariableSRW((c), (m), INFINITE, 0)
+#define baa_cond_broadcast(c) WakeAllConditionVariable(c)
+#define baa_cond_destroy(c) ((void)(c))
+#else
+#include <pthread.h>
+typedef pthread_t BaaThread;
+typedef pthread_mutex_t BaaMutex;
+typedef pthread_cond_t BaaCond;
+#define baa_mutex_init(m) pthread_mutex_init((m), NULL)
+#define baa_mutex_lock(m) pthread_mutex_lock(m)
+#define baa_mutex_unlock(m) pthread_mutex_unlock(m)
+#define baa_mutex_destroy(m) pthread_mutex_destroy(m)
+#define baa_cond_init(c) pthread_cond_init((c), NULL)
+#define baa_cond_wait(c, m) pthread_cond_wait((c), (m))
+#define baa_cond_broadcast(c) pthread_cond_broadcast(c)
+#define baa_cond_destroy(c) pthread_cond_destroy(c)
+#endif
+
+/** حد أعلى معقول؛ الزائد لا يفيد مع وحدات بحجم برامج باء. */
+#define BAA_THREAD_POOL_MAX 64
+
+typedef struct {
+    BaaThreadPool* pool;
+    int index;  // رقم العامل (1..size-1)
+} BaaPoolWorker;
+
+struct BaaThreadPool {
+    int size;
+    int started;  // عدد الخيوط التي أُنشئت فعلاً
+    BaaThread threads[BAA_THREAD_POOL_MAX];
+    BaaPoolWorker workers[BAA_THREAD_POOL_MAX];
+
+    BaaMutex lock;
+    BaaCond wake;  // جيل جديد أو إيقاف
+    BaaCond done;  // عامل أنهى الجيل الحالي
+
+    unsigned generation;
+    bool stopping;
+    int pending;  // عمال لم ينهوا الجيل الحالي بعد
+
+    const BaaParallelJob* job;
+    int item_count;
+    atomic_int next_item;
+};
+
+static void pool_drain(BaaThreadPool* pool, const BaaParallelJob* job, int item_count, int worker) {
+    if (job->worker_begin) job->worker_begin(job->ctx, worker);
+    for (;;) {
+        int item = atomic_fetch_add_explicit(&pool->next_item, 1, memory_order_relaxed);
+        if (item >= item_count) break;
+        job->run(job->ctx, item, worker);
+    }
+    if (job->worker_end) job->worker_end(job->ctx, worker);
+}
+
+static void pool_worker_loop(BaaPoolWorker* self) {
+    BaaThreadPool* pool = self->pool;
+    unsigned seen = 0;
+
+    for (;;) {
+        baa_mutex_lock(&pool->lock);
+        while (!pool->stopping && pool->generation == seen) {
+            baa_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stopping) {
+            baa_mutex_unlock(&pool->lock);
+            return;
+        }
+        seen = pool->generation;
+        const BaaParallelJob* job = pool->job;
+        int item_count = pool->item_count;
+        baa_mutex_unlock(&pool->lock);
+
+        pool_drain(pool, job, item_count, self->index);
+
+        baa_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) baa_cond_broadcast(&pool->done);
+        baa_mutex_unlock(&pool->lock);
+    }
+}
+
+#ifdef _WIN32
+static unsigned __stdcall pool_thread_main(void* arg) {
+    pool_worker_loop((BaaPoolWorker*)arg);
+    return 0;
+}
+#else
+static void* pool_thread_main(void* arg) {
+    pool_worker_loop((BaaPoolWorker*)arg);
+    return NULL;
+}
+#endif
+
+static bool pool_thread_start(BaaThread* out, BaaPoolWorker* worker) {
+#ifdef _WIN32
+    uintptr_t h = _beginthreadex(NULL, 0, pool_thread_main, worker, 0, NULL);
+    if (h == 0) return false;
+    *out = (HANDLE)h;
+    return true;
+#else
+    return pthread_create(out, NULL, pool_thread_main, worker) == 0;
+#endif
+}
+
+static void pool_thread_join(BaaThread thread) {
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+BaaThreadPool* baa_thread_pool_create(int threads) {
+    if (threads <= 1) return NULL;
+    if (threads > BAA_THREAD_POOL_MAX) threads = BAA_THREAD_POOL_MAX;
+
+    BaaThreadPool* pool = (BaaThreadPool*)calloc(1, sizeof(BaaThreadPool));
+    if (!pool) return NULL;
+
+    baa_mutex_init(&pool->lock);
+    baa_cond_init(&pool->wake);
+    baa_cond_init(&pool->done);
+    atomic_init(&pool->next_item, 0);
+
+    pool->size = 1;
+    for (int i = 1; i < threads; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        if (!pool_thread_start(&pool->threads[i], &pool->workers[i])) break;
+        pool->size++;
+    }
+    pool->started = pool->size;
+
+    if (pool->size <= 1) {
+        baa_thread_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+int baa_thread_pool_size(const BaaThreadPool* pool) {
+    return pool ? pool->size : 1;
+}
+
+void baa_thread_pool_run(BaaThreadPool* pool, const BaaParallelJob* job, int item_count) {
+    if (!job || !job->run || item_count <= 0) return;
+
+    if (!pool || item_count == 1) {
+        if (job->worker_begin) job->worker_begin(job->ctx, 0);
+        for (int i = 0; i < item_count; i++) job->run(job->ctx, i, 0);
+        if (job->worker_end) job->worker_end(job->ctx, 0);
+        return;
+    }
+
+    baa_mutex_lock(&pool->lock);
+    pool->job = job;
+    pool->item_count = item_count;
+    atomic_store_explicit(&pool->next_item, 0, memory_order_relaxed);
+    pool->pending = pool->size - 1;
+    pool->generation++;
+    baa_cond_broadcast(&pool->wake);
+    baa_mutex_unlock(&pool->lock);
+
+    pool_drain(pool, job, item_count, 0);
+
+    // القفل يضمن أن كتابات العمال مرئية للمستدعي بعد العودة.
+    baa_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+        baa_cond_wait(&pool->done, &pool->lock);
+    }
+    pool->job = NULL;
+    baa_mutex_unlock(&pool->lock);
+}
+
+void baa_thread_pool_destroy(BaaThreadPool* pool) {
+    if (!pool) return;
+
+    baa_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    baa_cond_broadcast(&pool->wake);
+    baa_mutex_unlock(&pool->lock);
+
+    for (int i = 1; i < pool->started; i++) {
+        pool_thread_join(pool->threads[i]);
+    }
+
+    baa_cond_destroy(&pool->done);
+    baa_cond_destroy(&pool->wake);
+    baa_mutex_destroy(&pool->lock);
+    free(pool);
+}
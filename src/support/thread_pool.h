@@ -0,0 +1,55 @@
+/**
+ * @file thread_pool.h
+ * @brief مجمّع خيوط صغير لتوزيع دوال الوحدة الواحدة على الأنوية.
+ *
+ * يُنشأ المجمّع مرة لكل وحدة ترجمة ويُعاد استخدامه لكل مرحلة (المُحسِّن،
+ * اختيار التعليمات، تخصيص السجلات، الإصدار). الخيط المستدعي يعمل دائماً
+ * كعامل رقم 0، فمجمّع بحجم 1 (أو NULL) يعني تشغيلاً تسلسلياً بلا خيوط.
+ *
+ * العناصر تُوزّع ديناميكياً بعدّاد ذري؛ على المستدعي أن يخزّن نتيجة كل عنصر
+ * في خانته (بالفهرس) ثم يجمعها بالترتيب بعد انتهاء المهمة حتى يبقى الخرج حتمياً.
+ */
+
+#ifndef BAA_THREAD_POOL_H
+#define BAA_THREAD_POOL_H
+
+#include <stdbool.h>
+
+typedef struct BaaThreadPool BaaThreadPool;
+
+/**
+ * @brief مهمة متوازية على عناصر مرقّمة 0..item_count-1.
+ *
+ * worker_begin/worker_end اختياريتان وتُستدعيان مرة لكل عامل داخل خيطه،
+ * لتهيئة حالة العامل في خانته من ctx (بالفهرس worker) ثم إنهائها.
+ */
+typedef struct {
+    void* ctx;
+    void (*worker_begin)(void* ctx, int worker);
+    void (*run)(void* ctx, int item, int worker);
+    void (*worker_end)(void* ctx, int worker);
+} BaaParallelJob;
+
+/**
+ * @brief إنشاء مجمّع بـ threads عاملاً (يشمل الخيط المستدعي).
+ *
+ * @return NULL إن كان threads <= 1 أو فشل إنشاء الخيوط (فيُشغَّل تسلسلياً).
+ */
+BaaThreadPool* baa_thread_pool_create(int threads);
+
+/**
+ * @brief عدد العمال (1 لمجمّع NULL).
+ */
+int baa_thread_pool_size(const BaaThreadPool* pool);
+
+/**
+ * @brief تشغيل المهمة وانتظار كل عناصرها. NULL-safe: بدون مجمّع تُشغَّل تسلسلياً.
+ */
+void baa_thread_pool_run(BaaThreadPool* pool, const BaaParallelJob* job, int item_count);
+
+/**
+ * @brief إيقاف الخيوط وتحرير المجمّع (NULL-safe).
+ */
+void baa_thread_pool_destroy(BaaThreadPool* pool);
+
+#endif
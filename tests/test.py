@@ -246,6 +246,7 @@ def main() -> int:
         return 1
 
     failures: list[str] = []
+    assembler = os.environ.get("BAA_TEST_ASSEMBLER", "").strip()
 
     exe_ext = ".exe" if os.name == "nt" else ""
     out_dir = Path(f".baa_test_out_{os.getpid()}")
@@ -298,6 +299,9 @@ def main() -> int:
                     flags = ["-S", "--assembler=gas", *flags]
             else:
                 out = out_dir / f"{out_stem}{exe_ext}"
+                if assembler and not any(flag.startswith("--assembler=") for flag in flags):
+                    # BAA_TEST_ASSEMBLER=elf links every runtime fixture against native objects.
+                    flags = [f"--assembler={assembler}", *flags]
 
             # -O2 is required because --verify runs SSA verification (Mem2Reg) via the optimizer.
             rc = _run([str(baa), "-O2", "--verify", *flags, str(src_rel), "-o", str(out)], cwd=ROOT)
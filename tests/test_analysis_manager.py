@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Contract tests for the optimizer analysis cache ([ANALYSIS] hit/miss lines from --opt-stats)."""
+
+from __future__ import annotations
+
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+STATS_RE = re.compile(r"^\[ANALYSIS\] pass=(\S+) (.*)$")
+KINDS = ("preds", "dom", "loops")
+
+# حلقات متداخلة + فروع حتى تطلب mem2reg/GVN/CSE/LICM السيطرة والحلقات.
+PROGRAM = """\
+صحيح مجموع_مربعات(صحيح ن) {
+    صحيح م = ٠.
+    لكل (صحيح ي = ٠؛ ي < ن؛ ي++) {
+        صحيح ك = ن * ٣.
+        إذا (ي % ٢ == ٠) {
+            م = م + ي * ي + ك.
+        } وإلا {
+            م = م - ي.
+        }
+    }
+    إرجع م.
+}
+
+صحيح جدول(صحيح ن) {
+    صحيح م = ٠.
+    لكل (صحيح ي = ٠؛ ي < ن؛ ي++) {
+        لكل (صحيح ج = ٠؛ ج < ن؛ ج++) {
+            م = م + (ي * ج) % ٧.
+        }
+    }
+    إرجع م.
+}
+
+صحيح الرئيسية() {
+    اطبع مجموع_مربعات(٢٠).
+    اطبع جدول(١٢).
+    إرجع ٠.
+}
+"""
+
+EXPECTED = "1640\n345\n"
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _parse_stats(stderr: str) -> dict[str, dict[str, int]]:
+    """سطر [ANALYSIS] لكل تمريرة: أزواج <kind>_hit/<kind>_miss."""
+    out: dict[str, dict[str, int]] = {}
+    for line in stderr.splitlines():
+        m = STATS_RE.match(line.strip())
+        if not m:
+            continue
+        out[m.group(1)] = {k: int(v) for k, v in (p.split("=", 1) for p in m.group(2).split())}
+    return out
+
+
+class AnalysisManagerTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def compile_s(self, work: Path, out: str, *args: str) -> subprocess.CompletedProcess[str]:
+        proc = self.run_baa(work, "-S", "--assembler=gas", *args, "main.baa", "-o", out)
+        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+        return proc
+
+    def test_opt_stats_reports_cache_hits(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_analysis_stats_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            for level in ("-O1", "-O2"):
+                with self.subTest(level=level):
+                    st = _parse_stats(self.compile_s(work, "main.s", level, "--opt-stats").stderr)
+                    self.assertIn("total", st)
+                    self.assertIn("LICM", st)
+                    total = st["total"]
+                    for kind in KINDS:
+                        self.assertEqual(
+                            total[f"{kind}_hit"], sum(v[f"{kind}_hit"] for p, v in st.items() if p != "total")
+                        )
+                    # بعد أول حساب لا يُعاد بناء السيطرة ما لم يتغير CFG.
+                    self.assertGreater(total["dom_hit"], 0)
+                    self.assertGreater(total["loops_hit"], 0)
+
+    def test_stats_lines_are_opt_in(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_analysis_optin_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            self.assertEqual(_parse_stats(self.compile_s(work, "a.s", "-O2").stderr), {})
+            self.assertEqual(_parse_stats(self.compile_s(work, "b.s", "-O2", "--time-phases").stderr), {})
+            self.assertEqual(_parse_stats(self.compile_s(work, "c.s", "-O0", "--opt-stats").stderr), {})
+            self.assertIn("total", _parse_stats(self.compile_s(work, "d.s", "-O2", "-v", "--time-phases").stderr))
+
+    def test_cached_analyses_do_not_change_output(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_analysis_gate_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            for level in ("-O1", "-O2"):
+                with self.subTest(level=level):
+                    # بوابة التحقق تعيد بناء CFG بعد كل دورة فتُسقط الكاش؛ يجب أن يطابق الخرج.
+                    self.compile_s(work, "plain.s", level)
+                    self.compile_s(work, "gated.s", level, "--verify-gate")
+                    self.assertEqual((work / "plain.s").read_bytes(), (work / "gated.s").read_bytes())
+
+    @unittest.skipIf(os.name == "nt", "runtime check uses the Linux toolchain")
+    def test_optimized_program_output_is_unchanged(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_analysis_run_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            for level in ("-O0", "-O1", "-O2"):
+                with self.subTest(level=level):
+                    exe = work / f"main{level}"
+                    proc = self.run_baa(work, "--assembler=gas", level, "main.baa", "-o", exe.name)
+                    self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                    run = subprocess.run([str(exe)], cwd=work, text=True, capture_output=True, timeout=30)
+                    self.assertEqual(run.returncode, 0, run.stderr)
+                    self.assertEqual(run.stdout, EXPECTED)
+
+
+if __name__ == "__main__":
+    unittest.main()
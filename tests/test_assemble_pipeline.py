@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""Pipelined GAS assembly: gcc -c runs in the background while later units compile."""
+
+from __future__ import annotations
+
+import os
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+UNITS = 6
+
+# gcc وهمي يسجل بداية ونهاية كل تجميع (-c) ثم يمرر الطلب إلى gcc الحقيقي.
+FAKE_GCC = """\
+#!/bin/sh
+log="$BAA_TEST_ASM_LOG"
+case " $* " in
+  *" -c "*)
+    for arg in "$@"; do
+      case "$arg" in *.s) src="$arg" ;; esac
+    done
+    if [ -n "$BAA_TEST_ASM_FAIL" ] && grep -q "$BAA_TEST_ASM_FAIL" "$src"; then
+      exit 1
+    fi
+    echo "start $$" >> "$log"
+    sleep 0.2
+    echo "end $$" >> "$log"
+    ;;
+esac
+exec "$BAA_TEST_REAL_GCC" "$@"
+"""
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _max_overlap(log: Path) -> int:
+    running = 0
+    peak = 0
+    for line in log.read_text(encoding="utf-8").splitlines():
+        running += 1 if line.startswith("start") else -1
+        peak = max(peak, running)
+    return peak
+
+
+@unittest.skipIf(os.name == "nt" or shutil.which("gcc") is None, "uses the Linux gcc toolchain")
+class AssemblePipelineTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, work: Path, *args: str, env: dict[str, str] | None = None) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), "--assembler=gas", *args],
+            cwd=work,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+            env=env,
+        )
+
+    def write_program(self, work: Path) -> list[str]:
+        names = [f"جزء_{i}" for i in range(UNITS)]
+        (work / "api.baahd").write_text(
+            "".join(f"خارجي صحيح {name}().\n" for name in names), encoding="utf-8"
+        )
+        inputs = ["main.baa"]
+        for i, name in enumerate(names):
+            path = f"part{i}.baa"
+            (work / path).write_text(
+                f"#تضمين \"api.baahd\"\nصحيح {name}() {{ إرجع {i + 1}. }}\n", encoding="utf-8"
+            )
+            inputs.append(path)
+        total = " + ".join(f"{name}()" for name in names)
+        (work / "main.baa").write_text(
+            f"#تضمين \"api.baahd\"\nصحيح الرئيسية() {{\n    اطبع {total}.\n    إرجع ٠.\n}}\n",
+            encoding="utf-8",
+        )
+        return inputs
+
+    def fake_gcc_env(self, work: Path, fail_marker: str = "") -> dict[str, str]:
+        tools = work / "tools"
+        tools.mkdir()
+        gcc = tools / "gcc"
+        gcc.write_text(FAKE_GCC, encoding="utf-8")
+        gcc.chmod(0o755)
+        env = dict(os.environ)
+        env["PATH"] = f"{tools}{os.pathsep}{env.get('PATH', '')}"
+        env["BAA_TEST_REAL_GCC"] = shutil.which("gcc") or "gcc"
+        env["BAA_TEST_ASM_LOG"] = str(work / "asm.log")
+        env["BAA_TEST_ASM_FAIL"] = fail_marker
+        return env
+
+    def leftovers(self, work: Path) -> list[str]:
+        return sorted(p.name for p in work.iterdir() if ".baa_asm_" in p.name or p.suffix == ".s")
+
+    def test_pipelined_build_matches_synchronous_assembly(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_asmq_link_") as temp:
+            work = Path(temp)
+            inputs = self.write_program(work)
+            outputs = []
+            for name, extra in (("piped", ()), ("sync", ("-j", "1"))):
+                proc = self.run_baa(
+                    work, *extra, "-O1", *inputs, "-o", name, "--emit-build-manifest", f"{name}.json"
+                )
+                self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                run = subprocess.run([str(work / name)], capture_output=True, text=True, timeout=30)
+                self.assertEqual(run.returncode, 0, run.stderr)
+                outputs.append(run.stdout)
+            self.assertEqual(outputs, ["21\n", "21\n"])
+            self.assertEqual((work / "piped.json").read_bytes(), (work / "sync.json").read_bytes())
+            self.assertEqual(self.leftovers(work), [])
+
+    def test_assemblies_overlap_within_the_limit(self) -> None:
+        for extra, low, high in (((), 2, 8), (("--diagnostics=json", "-j", "3"), 2, 3), (("-j", "1"), 1, 1)):
+            with self.subTest(extra=extra), tempfile.TemporaryDirectory(prefix="baa_asmq_overlap_") as temp:
+                work = Path(temp)
+                inputs = self.write_program(work)
+                env = self.fake_gcc_env(work)
+                proc = self.run_baa(work, *extra, *inputs, "-o", "app", env=env)
+                self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                peak = _max_overlap(work / "asm.log")
+                self.assertGreaterEqual(peak, low)
+                self.assertLessEqual(peak, high)
+
+    def test_incremental_cache_stores_queued_objects(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_asmq_cache_") as temp:
+            work = Path(temp)
+            inputs = self.write_program(work)
+            for run in ("first", "second"):
+                proc = self.run_baa(
+                    work, "--incremental", "--cache-dir", "cache", *inputs, "-o", "app",
+                    "--emit-build-manifest", f"{run}.json",
+                )
+                self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            second = (work / "second.json").read_text(encoding="utf-8")
+            self.assertEqual(second.count('"hit": true'), len(inputs))
+            run = subprocess.run([str(work / "app")], capture_output=True, text=True, timeout=30)
+            self.assertEqual(run.stdout, "21\n")
+
+    def test_first_assembler_failure_is_reported_once(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_asmq_fail_") as temp:
+            work = Path(temp)
+            inputs = self.write_program(work)
+            env = self.fake_gcc_env(work, fail_marker="^جزء_1:")
+            proc = self.run_baa(work, *inputs, "-o", "app", env=env)
+            self.assertNotEqual(proc.returncode, 0)
+            self.assertEqual(proc.stderr.count("فشلت أداة التجميع"), 1, proc.stderr)
+            self.assertFalse((work / "app").exists())
+            self.assertEqual(self.leftovers(work), [])
+
+
+if __name__ == "__main__":
+    unittest.main()
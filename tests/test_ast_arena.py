@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Contract tests for the bulk-freed AST arena and its [MEM] reporting."""
+
+from __future__ import annotations
+
+import json
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+MEM_RE = re.compile(r"^\[MEM\] (.*)$", re.MULTILINE)
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _mem_fields(stderr: str) -> dict[str, int]:
+    match = MEM_RE.search(stderr)
+    if not match:
+        raise AssertionError(f"missing [MEM] line in:\n{stderr}")
+    return {key: int(value) for key, value in (item.split("=", 1) for item in match.group(1).split())}
+
+
+HEADER = "صحيح مضاعف(صحيح س) {\n    إرجع س * ٢.\n}\n"
+
+MAIN = (
+    '#تضمين "مساعد.baahd"\n'
+    "هيكل نقطة {\n"
+    "    صحيح س.\n"
+    "    صحيح ص.\n"
+    "}\n"
+    "صحيح الرئيسية() {\n"
+    "    هيكل نقطة ن.\n"
+    "    ن:س = مضاعف(٣).\n"
+    "    ن:ص = ن:س + ١.\n"
+    "    إرجع ن:ص.\n"
+    "}\n"
+)
+
+
+class AstArenaTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def write_sources(self, work: Path) -> None:
+        (work / "مساعد.baahd").write_text(HEADER, encoding="utf-8")
+        (work / "main.baa").write_text(MAIN, encoding="utf-8")
+
+    def test_time_phases_reports_ast_arena(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_ast_arena_") as temp:
+            work = Path(temp)
+            self.write_sources(work)
+            proc = self.run_baa(work, "-O1", "--time-phases", "-S", "main.baa", "-o", "main.s")
+            self.assertEqual(proc.returncode, 0, proc.stderr)
+            mem = _mem_fields(proc.stderr)
+            self.assertGreater(mem["ast_arena_used_max"], 0)
+            self.assertGreaterEqual(mem["ast_arena_cap_max"], mem["ast_arena_used_max"])
+            self.assertGreaterEqual(mem["ast_arena_chunks_max"], 1)
+
+    def test_parallel_jobs_merge_ast_arena_stats(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_ast_arena_jobs_") as temp:
+            work = Path(temp)
+            (work / "a.baa").write_text("صحيح الرئيسية() {\n    إرجع ٠.\n}\n", encoding="utf-8")
+            (work / "b.baa").write_text(
+                "صحيح مساعد_ب(صحيح س) {\n    إرجع س + ١.\n}\n", encoding="utf-8"
+            )
+            proc = self.run_baa(work, "-j", "2", "--time-phases", "-c", "a.baa", "b.baa")
+            self.assertEqual(proc.returncode, 0, proc.stderr)
+            self.assertGreater(_mem_fields(proc.stderr)["ast_arena_used_max"], 0)
+
+    def test_source_locations_outlive_the_ast(self) -> None:
+        # مواقع المصدر وأسماء التصحيح تُنسخ إلى الـ IR قبل تحرير الساحة.
+        with tempfile.TemporaryDirectory(prefix="baa_ast_arena_loc_") as temp:
+            work = Path(temp)
+            self.write_sources(work)
+            proc = self.run_baa(work, "-O0", "--debug-info", "-S", "main.baa", "-o", "main.s")
+            self.assertEqual(proc.returncode, 0, proc.stderr)
+            source_map = json.loads(
+                Path(work / "main.s.خريطة-باء.json").read_text(encoding="utf-8")
+            )
+            files = {
+                bytes.fromhex(entry["source_file_utf8_hex"]).decode("utf-8")
+                for entry in source_map["entries"]
+            }
+            self.assertTrue(any(f.endswith("main.baa") for f in files), files)
+            self.assertTrue(any(f.endswith("مساعد.baahd") for f in files), files)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""Contract tests for machine block placement and redundant-jump removal."""
+
+from __future__ import annotations
+
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+LABEL_RE = re.compile(r"^(\.LBB_\d+_\d+):$")
+JUMP_RE = re.compile(r"^\s+(j[a-z]+)\s+(\.LBB_\d+_\d+)$")
+
+PROGRAM = """\
+صحيح خطوة(صحيح ن) {
+    إذا (ن % ٢ == ٠) {
+        إرجع ن / ٢.
+    }
+    إرجع ٣ * ن + ١.
+}
+
+صحيح تصنيف(صحيح ن) {
+    اختر (ن % ٤) {
+        حالة ٠:
+            إرجع ١٠.
+        حالة ١:
+            إرجع ٢٠.
+        حالة ٢:
+            إرجع ٣٠.
+        افتراضي:
+            إرجع ٤٠.
+    }
+    إرجع ٠.
+}
+
+صحيح متداخلة(صحيح حد) {
+    صحيح مجموع = ٠.
+    لكل (صحيح أ = ٠؛ أ < حد؛ أ = أ + ١) {
+        إذا (أ == ٧) {
+            استمر.
+        }
+        لكل (صحيح ب = ٠؛ ب < أ؛ ب = ب + ١) {
+            إذا (ب > ٥) {
+                توقف.
+            }
+            مجموع = مجموع + ب * أ.
+        }
+        إذا (مجموع > ١٠٠٠٠) {
+            توقف.
+        }
+    }
+    إرجع مجموع.
+}
+
+صحيح عشري_فرع(عشري أ، عشري ب) {
+    إذا (أ < ب) {
+        إرجع ١.
+    }
+    إذا (أ == ب) {
+        إرجع ٢.
+    }
+    إرجع ٣.
+}
+
+صحيح الرئيسية() {
+    صحيح ن = ٢٧.
+    صحيح خطوات = ٠.
+    طالما (ن != ١) {
+        ن = خطوة(ن).
+        خطوات = خطوات + ١.
+    }
+    اطبع خطوات.
+    صحيح ص = ٠.
+    لكل (صحيح س = ٠؛ س < ١٠؛ س = س + ١) {
+        ص = ص + تصنيف(س).
+    }
+    اطبع ص.
+    اطبع متداخلة(٢٠).
+    اطبع عشري_فرع(١.٠، ٢.٠) * ١٠٠ + عشري_فرع(٢.٠، ٢.٠) * ١٠ + عشري_فرع(٣.٠، ٢.٠).
+    إرجع ٠.
+}
+"""
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _jumps_to_next_label(asm: str) -> list[str]:
+    """القفزات التي يليها مباشرة تعريف هدفها."""
+    lines = [line for line in asm.splitlines() if line.strip() and not line.lstrip().startswith(("#", ".loc", ".file"))]
+    found = []
+    for current, following in zip(lines, lines[1:]):
+        jump = JUMP_RE.match(current)
+        label = LABEL_RE.match(following)
+        if jump and label and jump.group(2) == label.group(1):
+            found.append(current.strip())
+    return found
+
+
+def _count_jumps(asm: str) -> int:
+    return sum(1 for line in asm.splitlines() if JUMP_RE.match(line))
+
+
+class BlockLayoutTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def emit_asm(self, work: Path, level: str) -> str:
+        out = f"main{level}.s"
+        proc = self.run_baa(work, level, "-S", "--assembler=gas", "--target=x86_64-linux", "main.baa", "-o", out)
+        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+        return (work / out).read_text(encoding="utf-8")
+
+    def test_optimized_code_has_no_jump_to_next_block(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_block_layout_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            o0 = self.emit_asm(work, "-O0")
+            for level in ("-O1", "-O2"):
+                with self.subTest(level=level):
+                    asm = self.emit_asm(work, level)
+                    self.assertEqual(_jumps_to_next_label(asm), [])
+                    self.assertLess(_count_jumps(asm), _count_jumps(o0))
+            # بدون تحسين تبقى القفزات الصريحة كما يصدرها اختيار التعليمات.
+            self.assertNotEqual(_jumps_to_next_label(o0), [])
+
+    @unittest.skipIf(os.name == "nt", "runtime check uses the Linux toolchain")
+    def test_reordered_program_matches_unoptimized_output(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_block_layout_run_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            outputs = {}
+            for level in ("-O0", "-O1", "-O2"):
+                with self.subTest(level=level):
+                    exe = work / f"main{level}"
+                    proc = self.run_baa(work, "--assembler=gas", level, "main.baa", "-o", exe.name)
+                    self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                    run = subprocess.run([str(exe)], cwd=work, text=True, capture_output=True, timeout=30)
+                    self.assertEqual(run.returncode, 0, run.stderr)
+                    outputs[level] = run.stdout
+            for level, stdout in outputs.items():
+                with self.subTest(level=level):
+                    self.assertEqual(stdout, "111\n230\n2605\n123\n")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -74,6 +74,25 @@ class DiagnosticDeterminismTests(unittest.TestCase):
         self.assertFalse(result.passed)
         self.assertIn("exit code differed", result.detail)
 
+    def test_thread_counts_must_produce_identical_output(self) -> None:
+        with tempfile.TemporaryDirectory() as temp_dir:
+            out_file = Path(temp_dir) / "out.s"
+            payloads = iter([b"same\n", b"same\n", b"serial\n", b"threaded\n"])
+
+            def fake_run(cmd: list[str], timeout_s: float = 0.0) -> subprocess.CompletedProcess[str]:
+                out_file.write_bytes(next(payloads))
+                return _process(0)
+
+            with mock.patch.object(DETERMINISM, "_run", side_effect=fake_run) as run:
+                same = DETERMINISM._compare_thread_counts("threaded", ["baa", "-S"], out_file)
+                drift = DETERMINISM._compare_thread_counts("threaded", ["baa", "-S"], out_file)
+
+        self.assertTrue(same.passed)
+        self.assertEqual(run.call_args_list[0].args[0][-1], "--threads=1")
+        self.assertEqual(run.call_args_list[1].args[0][-1], "--threads=4")
+        self.assertFalse(drift.passed)
+        self.assertIn("--threads=1 and --threads=4", drift.detail)
+
     def test_manifest_receipt_keeps_stability_and_shape_results(self) -> None:
         with tempfile.TemporaryDirectory() as temp_dir:
             out_dir = Path(temp_dir)
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""Native ELF64 object writer (--assembler=elf): linking, object shape, and CLI limits."""
+
+from __future__ import annotations
+
+import os
+import re
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+TIME_RE = re.compile(
+    r"^\[TIME\] .*\bassemble=([0-9.]+) assemble_encode=([0-9.]+) assemble_io=([0-9.]+)"
+)
+
+LIB_SOURCE = """\
+صحيح مربع(صحيح س) {
+    إرجع س * س.
+}
+
+صحيح تصنيف(صحيح س) {
+    اختر (س) {
+        حالة ٠: إرجع ١٠.
+        حالة ١: إرجع ٢٠.
+        حالة ٢: إرجع ٣٠.
+        حالة ٣: إرجع ٤٠.
+        حالة ٤: إرجع ٥٠.
+        افتراضي: إرجع -١.
+    }
+    إرجع ٠.
+}
+"""
+
+MAIN_SOURCE = """\
+صحيح مربع(صحيح س).
+صحيح تصنيف(صحيح س).
+
+صحيح عداد = ٧.
+نص تحية = "مرحبا".
+
+صحيح الرئيسية() {
+    صحيح مجموع = ٠.
+    لكل (صحيح ي = ٠؛ ي < ٦؛ ي = ي + ١) {
+        مجموع = مجموع + تصنيف(ي).
+    }
+    اطبع تحية.
+    اطبع مربع(عداد).
+    اطبع مجموع.
+    إرجع ٠.
+}
+"""
+
+EXPECTED = "مرحبا\n49\n149\n"
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+class ElfWriterTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def write_sources(self, work: Path) -> None:
+        (work / "lib.baa").write_text(LIB_SOURCE, encoding="utf-8")
+        (work / "main.baa").write_text(MAIN_SOURCE, encoding="utf-8")
+
+    def run_exe(self, exe: Path) -> None:
+        run = subprocess.run([str(exe)], cwd=exe.parent, text=True, encoding="utf-8", capture_output=True, timeout=30)
+        self.assertEqual(run.returncode, 0, run.stderr)
+        self.assertEqual(run.stdout, EXPECTED)
+
+    @unittest.skipIf(os.name == "nt", "ELF objects need the Linux toolchain")
+    def test_program_links_and_runs(self) -> None:
+        for level in ("-O0", "-O2"):
+            with self.subTest(level=level), tempfile.TemporaryDirectory(prefix="baa_elf_run_") as temp:
+                work = Path(temp)
+                self.write_sources(work)
+                proc = self.run_baa(work, "--assembler=elf", level, "main.baa", "lib.baa", "-o", "prog")
+                self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                self.run_exe(work / "prog")
+
+    @unittest.skipIf(os.name == "nt" or shutil.which("gcc") is None, "mixed link uses the Linux gcc toolchain")
+    def test_elf_objects_link_with_gas_objects(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_elf_mixed_") as temp:
+            work = Path(temp)
+            self.write_sources(work)
+            proc = self.run_baa(work, "-c", "--assembler=elf", "-O2", "lib.baa", "-o", "lib.o")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            proc = self.run_baa(work, "-S", "--assembler=gas", "--startup=custom", "-O2", "main.baa", "-o", "main.s")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            for cmd in (
+                ["gcc", "-c", "main.s", "-o", "main.o"],
+                ["gcc", "-nostartfiles", "-Wl,-e,الرئيسية_بدء", "main.o", "lib.o", "-o", "prog"],
+            ):
+                tool = subprocess.run(cmd, cwd=work, text=True, encoding="utf-8", errors="replace", capture_output=True)
+                self.assertEqual(tool.returncode, 0, tool.stdout + tool.stderr)
+            self.run_exe(work / "prog")
+
+    @unittest.skipIf(shutil.which("readelf") is None, "readelf not available")
+    def test_object_is_relocatable_with_function_symbols(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_elf_shape_") as temp:
+            work = Path(temp)
+            self.write_sources(work)
+            proc = self.run_baa(work, "-c", "--assembler=elf", "lib.baa", "-o", "lib.o")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            header = subprocess.run(["readelf", "-h", "lib.o"], cwd=work, text=True, capture_output=True)
+            self.assertIn("REL (Relocatable file)", header.stdout)
+            self.assertIn("X86-64", header.stdout)
+            symbols = subprocess.run(
+                ["readelf", "-sW", "lib.o"], cwd=work, text=True, errors="replace", capture_output=True
+            )
+            funcs = [line for line in symbols.stdout.splitlines() if " FUNC " in line and " GLOBAL " in line]
+            self.assertEqual(len(funcs), 2, symbols.stdout)
+            if shutil.which("nm") is not None:
+                names = subprocess.run(["nm", "--defined-only", "lib.o"], cwd=work, capture_output=True)
+                defined = names.stdout.decode("utf-8", errors="replace")
+                self.assertIn(" T مربع", defined)
+                self.assertIn(" T تصنيف", defined)
+            sections = subprocess.run(["readelf", "-SW", "lib.o"], cwd=work, text=True, capture_output=True)
+            self.assertIn(".note.GNU-stack", sections.stdout)
+
+    @unittest.skipIf(os.name == "nt", "ELF objects need the Linux toolchain")
+    def test_time_phases_splits_assemble_into_encode_and_io(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_elf_time_") as temp:
+            work = Path(temp)
+            self.write_sources(work)
+            proc = self.run_baa(work, "-c", "--assembler=elf", "--time-phases", "lib.baa", "-o", "lib.o")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            matches = [m for m in map(TIME_RE.match, proc.stderr.splitlines()) if m]
+            self.assertEqual(len(matches), 1, proc.stderr)
+            assemble, encode, io = (float(v) for v in matches[0].groups())
+            self.assertGreater(encode, 0.0)
+            self.assertGreater(io, 0.0)
+            self.assertAlmostEqual(assemble, encode + io, delta=2e-6)
+
+    def test_rejects_unsupported_combinations(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_elf_cli_") as temp:
+            work = Path(temp)
+            self.write_sources(work)
+            for extra in (("--target=x86_64-windows",), ("--debug-info",)):
+                with self.subTest(extra=extra):
+                    proc = self.run_baa(work, "-c", "--assembler=elf", *extra, "lib.baa", "-o", "lib.o")
+                    self.assertNotEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                    self.assertIn("elf", proc.stderr)
+                    self.assertFalse((work / "lib.o").exists())
+
+
+if __name__ == "__main__":
+    unittest.main()
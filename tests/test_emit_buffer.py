@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Buffered assembly emission: modules larger than one buffer stay correct and stable."""
+
+from __future__ import annotations
+
+import json
+import os
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+FUNCTIONS = 80
+STEPS = 40
+
+
+def _program() -> tuple[str, str]:
+    """برنامج بعدة دوال يتجاوز نصه المولد حجم المخزن الابتدائي (64 KiB)."""
+    lines: list[str] = []
+    total = 0
+    for n in range(FUNCTIONS):
+        lines.append(f"صحيح د{n}(صحيح أ) {{")
+        lines.append("    صحيح س = أ.")
+        value = n
+        for i in range(STEPS):
+            lines.append(f"    س = س + {i}.")
+            lines.append("    إذا (س > 1000) { س = س - 997. }")
+            value += i
+            if value > 1000:
+                value -= 997
+        lines.append("    إرجع س.")
+        lines.append("}")
+        total += value
+    lines.append("صحيح الرئيسية() {")
+    lines.append("    صحيح مجموع = 0.")
+    for n in range(FUNCTIONS):
+        lines.append(f"    مجموع = مجموع + د{n}({n}).")
+    lines.append("    اطبع مجموع.")
+    lines.append("    إرجع 0.")
+    lines.append("}")
+    return "\n".join(lines) + "\n", f"{total}\n"
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+class EmitBufferTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+        cls.source, cls.expected = _program()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=180,
+        )
+
+    def write_source(self, work: Path) -> None:
+        (work / "big.baa").write_text(self.source, encoding="utf-8")
+
+    @unittest.skipIf(os.name == "nt", "runs the generated program with the Linux toolchain")
+    def test_large_module_links_and_runs(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_emitbuf_run_") as temp:
+            work = Path(temp)
+            self.write_source(work)
+            proc = self.run_baa(work, "--assembler=gas", "-O0", "-S", "big.baa", "-o", "big.s")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            asm = (work / "big.s").read_bytes()
+            self.assertGreater(len(asm), 64 * 1024)
+            self.assertTrue(asm.endswith(b"\n"))
+            self.assertEqual(asm.count(".globl ".encode()), FUNCTIONS + 1)
+
+            proc = self.run_baa(work, "--assembler=gas", "-O0", "big.baa", "-o", "big")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            run = subprocess.run(
+                [str(work / "big")], cwd=work, text=True, encoding="utf-8", capture_output=True, timeout=30
+            )
+            self.assertEqual(run.returncode, 0, run.stderr)
+            self.assertEqual(run.stdout, self.expected)
+
+    def test_gas_text_is_identical_across_runs(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_emitbuf_gas_") as temp:
+            work = Path(temp)
+            self.write_source(work)
+            for flags in (("-O0",), ("-O2", "--asm-comments")):
+                with self.subTest(flags=flags):
+                    outputs = []
+                    for run in ("a.s", "b.s"):
+                        proc = self.run_baa(work, "--assembler=gas", "-S", *flags, "big.baa", "-o", run)
+                        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                        outputs.append((work / run).read_bytes())
+                    self.assertEqual(outputs[0], outputs[1])
+
+    def test_nazm_source_map_covers_buffered_source(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_emitbuf_nazm_") as temp:
+            work = Path(temp)
+            self.write_source(work)
+            proc = self.run_baa(work, "--assembler=nazm", "-O0", "-S", "big.baa", "-o", "big.نظم")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            text = (work / "big.نظم").read_text(encoding="utf-8")
+            self.assertTrue(text.endswith("\n"))
+            line_count = text.count("\n")
+            source_map = json.loads((work / "big.نظم.خريطة-باء.json").read_text(encoding="utf-8"))
+            entries = source_map["entries"]
+            self.assertGreater(len(entries), FUNCTIONS * STEPS)
+            previous = 0
+            for entry in entries:
+                self.assertLessEqual(entry["generated_line_start"], entry["generated_line_end"])
+                self.assertGreaterEqual(entry["generated_line_start"], previous)
+                previous = entry["generated_line_start"]
+            self.assertLessEqual(entries[-1]["generated_line_end"], line_count)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""Contract tests for fused compare-and-branch lowering on the GAS path only."""
+
+from __future__ import annotations
+
+import os
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+FIXTURES = ROOT / "tests" / "fixtures" / "fused_compare_branch"
+
+# صيغ نظم للقفزات الشرطية خارج عقد القدرات؛ لا يجوز أن تصل إلى نظم.
+NAZM_FUSED_JUMPS = (
+    "اقفز_أكبر",
+    "اقفز_أصغر",
+    "اقفز_فوق",
+    "اقفز_تحت",
+    "اقفز_تكافؤ",
+    "اقفز_عدم_تكافؤ",
+)
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _expectations(source: Path, prefix: str) -> list[str]:
+    marker = f"// {prefix}:"
+    return [
+        line[len(marker):].strip()
+        for line in source.read_text(encoding="utf-8").splitlines()
+        if line.startswith(marker)
+    ]
+
+
+class FusedCompareBranchTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def test_gas_assembly_uses_jcc(self) -> None:
+        source = FIXTURES / "asm.baa"
+        with tempfile.TemporaryDirectory(prefix="baa_fused_gas_") as temp:
+            work = Path(temp)
+            proc = self.run_baa(
+                work, "-S", "--assembler=gas", "--target=x86_64-linux",
+                str(source), "-o", "out.s",
+            )
+            self.assertEqual(proc.returncode, 0, proc.stderr)
+            asm = (work / "out.s").read_text(encoding="utf-8")
+        for needle in _expectations(source, "EXPECT-ASM"):
+            self.assertIn(needle, asm)
+        for needle in _expectations(source, "EXPECT-NOT-ASM"):
+            self.assertNotIn(needle, asm)
+
+    def test_nazm_keeps_setcc_lowering(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_fused_nazm_") as temp:
+            work = Path(temp)
+            proc = self.run_baa(
+                work, "--emit-nazm", "--target=x86_64-linux",
+                str(FIXTURES / "asm.baa"), "-o", "out.نظم",
+            )
+            self.assertEqual(proc.returncode, 0, proc.stderr)
+            nazm = (work / "out.نظم").read_text(encoding="utf-8")
+        self.assertIn("اختبر_البتات", nazm)
+        for mnemonic in NAZM_FUSED_JUMPS:
+            self.assertNotIn(mnemonic, nazm)
+
+    def run_fixture(self, assembler: str) -> None:
+        suffix = ".exe" if os.name == "nt" else ""
+        for level in ("-O0", "-O2"):
+            with self.subTest(assembler=assembler, level=level), tempfile.TemporaryDirectory(
+                prefix="baa_fused_run_"
+            ) as temp:
+                work = Path(temp)
+                exe = work / f"fused{suffix}"
+                proc = self.run_baa(
+                    work, level, f"--assembler={assembler}",
+                    str(FIXTURES / "runtime.baa"), "-o", str(exe),
+                )
+                self.assertEqual(proc.returncode, 0, proc.stderr)
+                run = subprocess.run(
+                    [str(exe)],
+                    cwd=work,
+                    text=True,
+                    encoding="utf-8",
+                    errors="replace",
+                    capture_output=True,
+                    timeout=60,
+                )
+                self.assertEqual(run.returncode, 0, run.stdout + run.stderr)
+                self.assertIn("PASS", run.stdout)
+
+    def test_gas_runtime_conditions(self) -> None:
+        if shutil.which("gcc") is None:
+            self.skipTest("gcc is required to assemble and link the GAS path")
+        self.run_fixture("gas")
+
+    @unittest.skipIf(os.name == "nt", "the native ELF writer targets Linux only")
+    def test_elf_runtime_conditions(self) -> None:
+        if shutil.which("gcc") is None:
+            self.skipTest("gcc is required to link the ELF objects")
+        self.run_fixture("elf")
+
+
+if __name__ == "__main__":
+    unittest.main()
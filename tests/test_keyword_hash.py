@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Contract tests for perfect-hash keyword and directive recognition."""
+
+from __future__ import annotations
+
+import importlib.util
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+GENERATOR = ROOT / "scripts" / "generate_keyword_hash.py"
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _load_generator():
+    spec = importlib.util.spec_from_file_location("generate_keyword_hash", GENERATOR)
+    module = importlib.util.module_from_spec(spec)
+    assert spec.loader is not None
+    spec.loader.exec_module(module)
+    return module
+
+
+class KeywordHashGeneratorTests(unittest.TestCase):
+    def test_checked_in_tables_match_language_profile(self) -> None:
+        proc = subprocess.run(
+            [sys.executable, str(GENERATOR), "--check"],
+            cwd=ROOT,
+            capture_output=True,
+            text=True,
+            timeout=60,
+        )
+        self.assertEqual(proc.returncode, 0, proc.stderr)
+
+    def test_every_slot_points_at_a_distinct_entry(self) -> None:
+        gen = _load_generator()
+        keywords, directives = gen.read_profile(gen.DEFAULT_PROFILE)
+        for entries in (keywords, directives):
+            seed, size, slots = gen.find_perfect_hash(entries)
+            self.assertEqual(size & (size - 1), 0)
+            self.assertEqual(sorted(i for i in slots if i >= 0), sorted(i for i, _ in entries))
+            for index, label in entries:
+                slot = gen.fnv1a_seeded(label.encode("utf-8"), seed) & (size - 1)
+                self.assertEqual(slots[slot], index, label)
+
+
+class KeywordHashLexerTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+        gen = _load_generator()
+        cls.keywords, cls.directives = gen.read_profile(gen.DEFAULT_PROFILE)
+
+    def token_kinds(self, words: list[str]) -> list[str]:
+        source = "\n".join(words) + "\n"
+        proc = subprocess.run(
+            [str(self.baa), "--dump-tokens=json", "--source-stdin=رئيسي.baa"],
+            cwd=ROOT,
+            input=source.encode("utf-8"),
+            capture_output=True,
+            timeout=30,
+        )
+        self.assertEqual(proc.returncode, 0, proc.stderr.decode("utf-8", errors="replace"))
+        data = json.loads(proc.stdout.decode("utf-8"))
+        return [token["kind"] for token in data["tokens"]]
+
+    def run_check(self, source: str) -> subprocess.CompletedProcess[str]:
+        with tempfile.TemporaryDirectory(prefix="baa_keyword_hash_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(source, encoding="utf-8")
+            return subprocess.run(
+                [str(self.baa), "--check", "main.baa"],
+                cwd=work,
+                text=True,
+                encoding="utf-8",
+                errors="replace",
+                capture_output=True,
+                timeout=30,
+            )
+
+    def test_every_lexical_keyword_is_recognized(self) -> None:
+        labels = [label for _, label in self.keywords]
+        kinds = self.token_kinds(labels)
+        self.assertEqual(len(kinds), len(labels))
+        for label, kind in zip(labels, kinds):
+            self.assertIn(kind, {"keyword", "type", "modifier"}, label)
+
+    def test_near_miss_words_stay_identifiers(self) -> None:
+        words: list[str] = []
+        for _, label in self.keywords:
+            words.append(label + "س")
+            words.append("س" + label)
+            if len(label) > 1:
+                words.append(label[:-1])
+        known = {label for _, label in self.keywords}
+        words = [w for w in words if w not in known]
+        kinds = self.token_kinds(words)
+        self.assertEqual(len(kinds), len(words))
+        for word, kind in zip(words, kinds):
+            self.assertEqual(kind, "identifier", word)
+
+    def test_directives_dispatch_through_hash(self) -> None:
+        proc = self.run_check(
+            "#تعريف حد ٣\n"
+            "#إذا_عرف حد\n"
+            "#الغاء_تعريف حد\n"
+            "#وإلا\n"
+            "#نهاية\n"
+            "صحيح الرئيسية() {\n"
+            "    إرجع ٠.\n"
+            "}\n"
+        )
+        self.assertEqual(proc.returncode, 0, proc.stderr)
+
+    def test_unknown_directive_is_rejected(self) -> None:
+        for directive in ("تعريفات", "تضمي", "نهايةس"):
+            with self.subTest(directive=directive):
+                proc = self.run_check(
+                    f"#{directive} س\n"
+                    "صحيح الرئيسية() {\n"
+                    "    إرجع ٠.\n"
+                    "}\n"
+                )
+                self.assertNotEqual(proc.returncode, 0)
+                self.assertIn("توجيه غير معروف", proc.stdout + proc.stderr)
+
+
+if __name__ == "__main__":
+    unittest.main()
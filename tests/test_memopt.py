@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+"""Contract tests for alias analysis: store-to-load forwarding, redundant load/dead store elimination and LICM load hoisting."""
+
+from __future__ import annotations
+
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+
+# عوامّ تُكتب مرتين وتُقرأ بعد نداء طباعة معروف، حمل عام ثابت في حلقة،
+# وحمل لا يجوز نقله بسبب نداء دالة مستخدم أو خزن عبر مؤشر مجهول،
+# وحمل عبر مؤشر مجهول في رأس الحلقة بعد قسمة قد تُطلق مصيدة،
+# ومصفوفتان محليتان بفهارس متغيرة (حجزان مختلفان لا يتداخلان).
+PROGRAM = """\
+صحيح عداد = ٠.
+صحيح مقياس = ٣.
+صحيح مجموع = ٠.
+
+صحيح مكرر() {
+    عداد = ٣.
+    عداد = ٤.
+    اطبع عداد.
+    إرجع عداد + عداد.
+}
+
+صحيح ثابت_الحلقة(صحيح ن) {
+    صحيح ج = ٠.
+    لكل (صحيح ي = ٠؛ ي < ن؛ ي++) {
+        ج = ج + ي * مقياس.
+        مجموع = ج.
+    }
+    إرجع ج.
+}
+
+عدم زد() {
+    مقياس = مقياس + ١.
+}
+
+صحيح مع_نداء(صحيح ن) {
+    صحيح ج = ٠.
+    لكل (صحيح ي = ٠؛ ي < ن؛ ي++) {
+        ج = ج + مقياس.
+        زد().
+    }
+    إرجع ج.
+}
+
+صحيح عبر_مؤشر(صحيح* م، صحيح ن) {
+    صحيح ج = ٠.
+    لكل (صحيح ي = ٠؛ ي < ن؛ ي++) {
+        ج = ج + مقياس.
+        *م = ج.
+    }
+    إرجع ج.
+}
+
+صحيح قسمة_ثم_حمل(صحيح* م، صحيح د، صحيح ن) {
+    صحيح ج = ٠.
+    لكل (صحيح ي = ٠؛ ي < ن / د + *م؛ ي++) {
+        ج = ج + ي.
+    }
+    إرجع ج.
+}
+
+صحيح محلي(صحيح ن) {
+    صحيح أ[٨].
+    صحيح ب[٨].
+    لكل (صحيح ي = ٠؛ ي < ٨؛ ي++) {
+        أ[ي] = ي.
+        ب[ي] = ي * ٢.
+    }
+    ب[٣] = ن.
+    أ[ن & ٧] = ٥.
+    إرجع ب[٣] + أ[٢].
+}
+
+صحيح الرئيسية() {
+    اطبع مكرر().
+    اطبع ثابت_الحلقة(١٠).
+    اطبع مجموع.
+    اطبع مع_نداء(٤).
+    صحيح ق[١].
+    ق[٠] = ٠.
+    اطبع عبر_مؤشر(&ق[٠]، ٤).
+    اطبع ق[٠].
+    اطبع قسمة_ثم_حمل(&ق[٠]، ٢، ٦).
+    اطبع محلي(٣).
+    اطبع مقياس.
+    إرجع ٠.
+}
+"""
+
+EXPECTED = "4\n8\n135\n135\n18\n28\n28\n465\n5\n7\n"
+
+NO_MEMOPT = "sroa,mem2reg,canon,instcombine,sccp,constfold,copyprop,dce,cfg-simplify,licm"
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _functions(ir: str) -> dict[str, str]:
+    """جسم كل دالة في تفريغ الـ IR باسمها."""
+    out: dict[str, str] = {}
+    for chunk in re.split(r"\nدالة @", ir)[1:]:
+        name = chunk.split("(", 1)[0]
+        out[name] = chunk
+    return out
+
+
+def _loop_body(func: str) -> str:
+    return func.split("لكل_جسم_١:", 1)[1].split("لكل_زيادة_٢:", 1)[0]
+
+
+class MemoptTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=self.work,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def dump_opt(self, *args: str) -> dict[str, str]:
+        proc = self.run_baa("-S", "--assembler=gas", "--dump-ir-opt", *args, "main.baa", "-o", "out.s")
+        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+        return _functions(proc.stdout)
+
+    def setUp(self) -> None:
+        self._temp = tempfile.TemporaryDirectory(prefix="baa_memopt_")
+        self.work = Path(self._temp.name)
+        (self.work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+
+    def tearDown(self) -> None:
+        self._temp.cleanup()
+
+    def test_global_store_is_forwarded_across_known_call(self) -> None:
+        for level in ("-O1", "-O2"):
+            with self.subTest(level=level):
+                body = self.dump_opt(level)["مكرر"]
+                # الخزن الأول ميت، والقراءات الثلاث تأخذ القيمة المخزَّنة رغم نداء الطباعة.
+                self.assertEqual(len(re.findall(r"خزن ص٦٤ ", body)), 1)
+                self.assertIn("خزن ص٦٤ ٤، @عداد", body)
+                self.assertNotIn("حمل", body)
+                self.assertIn("رجوع ص٦٤ ٨", body)
+
+    def test_invariant_global_load_is_hoisted(self) -> None:
+        func = self.dump_opt("-O1")["ثابت_الحلقة"]
+        entry = func.split("لكل_تحقق_٠:", 1)[0]
+        self.assertIn("حمل ص٦٤، @مقياس", entry)
+        self.assertNotIn("حمل", _loop_body(func))
+        # الخزن إلى عام آخر لا يمنع النقل، لكنه يبقى في الحلقة.
+        self.assertIn("خزن ص٦٤", _loop_body(func))
+
+    def test_user_call_or_unknown_pointer_store_blocks_hoisting(self) -> None:
+        funcs = self.dump_opt("-O1")
+        for name in ("مع_نداء", "عبر_مؤشر"):
+            with self.subTest(func=name):
+                self.assertIn("حمل ص٦٤، @مقياس", _loop_body(funcs[name]))
+
+    def test_header_load_is_not_hoisted_above_a_trapping_division(self) -> None:
+        func = self.dump_opt("-O1")["قسمة_ثم_حمل"]
+        entry, header = func.split("لكل_تحقق_٠:", 1)
+        self.assertNotIn("= حمل", entry)
+        header = header.split("لكل_جسم_١:", 1)[0]
+        # الحمل عبر مؤشر مجهول يبقى بعد القسمة على غير ثابت.
+        self.assertLess(header.index("= قسم"), header.index("= حمل"))
+
+    def test_distinct_local_arrays_do_not_alias(self) -> None:
+        func = self.dump_opt("-O1")["محلي"]
+        # ب[٣] يُمرَّر من خزنه رغم الكتابة بفهرس متغير في أ، فلا يبقى من ب شيء؛
+        # أ[٢] يبقى حملاً لأن أ[ن & ٧] قد يكتبه.
+        self.assertEqual(len(re.findall(r"= حمل ", func)), 1)
+        self.assertEqual(len(re.findall(r"= حجز ", func)), 1)
+
+    def test_without_memopt_the_redundant_accesses_stay(self) -> None:
+        body = self.dump_opt("-O1", f"--opt-pipeline={NO_MEMOPT}")["مكرر"]
+        self.assertEqual(len(re.findall(r"خزن ص٦٤ ", body)), 2)
+        self.assertIn("حمل", body)
+
+    @unittest.skipIf(os.name == "nt", "runtime check uses the Linux toolchain")
+    def test_runtime_output_is_unchanged(self) -> None:
+        for args in (("-O0",), ("-O1",), ("-O2",), ("-O2", "--regalloc=split"), ("-O2", f"--opt-pipeline={NO_MEMOPT}")):
+            with self.subTest(args=args):
+                exe = self.work / "main_bin"
+                proc = self.run_baa("--assembler=gas", *args, "main.baa", "-o", exe.name)
+                self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                run = subprocess.run([str(exe)], cwd=self.work, text=True, capture_output=True, timeout=30)
+                self.assertEqual(run.returncode, 0, run.stderr)
+                self.assertEqual(run.stdout, EXPECTED)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -955,6 +955,8 @@ class NazmEmitterTests(unittest.TestCase):
                     proc = self.run_baa(
                         work,
                         "--emit-nazm",
+                        # -O0 يبقي القفز إلى الكتلة التالية (ترتيب الكتل يحذفه).
+                        "-O0",
                         f"--target={target}",
                         str(source),
                         "-o",
@@ -22,17 +22,17 @@ SPEC.loader.exec_module(MATRIX)
 
 EXPECTED_TARGETS = {
     "x86_64-linux": {
-        "summary": {"emitted": 100, "unsupported": 0, "error": 0},
+        "summary": {"emitted": 103, "unsupported": 0, "error": 0},
         "blockers": {},
         "emitted_sources_sha256": (
-            "a0f36b388029e61e8737c028b5290b853e780e104034f5fea0340e8c403a86ee"
+            "0349d24a0c760b3b13afa578fee8580a9cc27426896d40c877340405e30fdf17"
         ),
     },
     "x86_64-windows": {
-        "summary": {"emitted": 100, "unsupported": 0, "error": 0},
+        "summary": {"emitted": 103, "unsupported": 0, "error": 0},
         "blockers": {},
         "emitted_sources_sha256": (
-            "a0f36b388029e61e8737c028b5290b853e780e104034f5fea0340e8c403a86ee"
+            "0349d24a0c760b3b13afa578fee8580a9cc27426896d40c877340405e30fdf17"
         ),
     },
 }
@@ -69,8 +69,8 @@ class NazmShadowCorpusTests(unittest.TestCase):
             target = self.matrix["targets"][target_name]
             expected = EXPECTED_TARGETS[target_name]
             rows = target["sources"]
-            self.assertEqual(target["source_count"], 100)
-            self.assertEqual(len(rows), 100)
+            self.assertEqual(target["source_count"], 103)
+            self.assertEqual(len(rows), 103)
             self.assertEqual(
                 [row["source"] for row in rows], inventory_target["sources"]
             )
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""Contract tests for the per-function optimizer fixpoint and --opt-pipeline ([OPT-PASS]/[OPT-FUNC]/[OPT] lines)."""
+
+from __future__ import annotations
+
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+PASS_RE = re.compile(r"^\[OPT-PASS\] pass=(\S+) (.*)$")
+FUNC_RE = re.compile(r"^\[OPT-FUNC\] func=(\S+) (.*)$")
+SUMMARY_RE = re.compile(r"^\[OPT\] (.*)$")
+
+DEFAULT_O1 = ["sroa", "mem2reg", "canon", "instcombine", "sccp", "constfold", "copyprop", "memopt", "dce", "cfg-simplify", "licm"]
+DEFAULT_O2 = ["sroa", "mem2reg", "canon", "instcombine", "sccp", "constfold", "copyprop", "gvn", "cse", "memopt", "dce", "cfg-simplify", "licm"]
+
+# دالة تحتاج عدة جولات (ثوابت تطوي فروعاً ثم حلقة) ودالة تافهة تستقر من أول جولة.
+PROGRAM = """\
+صحيح معقدة(صحيح ن) {
+    صحيح أ = ٤.
+    صحيح ب = أ * ٢.
+    صحيح م = ٠.
+    إذا (ب > ٥) {
+        م = ن + ب.
+    } وإلا {
+        م = ن - ب.
+    }
+    لكل (صحيح ي = ٠؛ ي < ن؛ ي++) {
+        صحيح ك = ب * ٣.
+        م = م + ي * ك.
+    }
+    إرجع م.
+}
+
+صحيح ثابتة() {
+    إرجع ٧.
+}
+
+صحيح الرئيسية() {
+    اطبع معقدة(١٠).
+    اطبع ثابتة().
+    إرجع ٠.
+}
+"""
+
+EXPECTED = "1098\n7\n"
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _kv(text: str) -> dict[str, float]:
+    return {k: float(v) for k, v in (p.split("=", 1) for p in text.split())}
+
+
+def _parse(stderr: str) -> tuple[dict[str, dict[str, float]], dict[str, dict[str, float]], dict[str, float] | None]:
+    """أسطر [OPT-PASS] و[OPT-FUNC] و[OPT] بالترتيب."""
+    passes: dict[str, dict[str, float]] = {}
+    funcs: dict[str, dict[str, float]] = {}
+    summary = None
+    for line in stderr.splitlines():
+        line = line.strip()
+        if m := PASS_RE.match(line):
+            passes[m.group(1)] = _kv(m.group(2))
+        elif m := FUNC_RE.match(line):
+            funcs[m.group(1)] = _kv(m.group(2))
+        elif m := SUMMARY_RE.match(line):
+            summary = _kv(m.group(1))
+    return passes, funcs, summary
+
+
+class OptimizerWorklistTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def compile_s(self, work: Path, out: str, *args: str) -> subprocess.CompletedProcess[str]:
+        proc = self.run_baa(work, "-S", "--assembler=gas", *args, "main.baa", "-o", out)
+        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+        return proc
+
+    def setUp(self) -> None:
+        self._temp = tempfile.TemporaryDirectory(prefix="baa_opt_worklist_")
+        self.work = Path(self._temp.name)
+        (self.work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+
+    def tearDown(self) -> None:
+        self._temp.cleanup()
+
+    def test_time_phases_reports_default_pipeline(self) -> None:
+        for level, expected in (("-O1", DEFAULT_O1), ("-O2", DEFAULT_O2)):
+            with self.subTest(level=level):
+                passes, funcs, summary = _parse(self.compile_s(self.work, "a.s", level, "--time-phases").stderr)
+                self.assertEqual(list(passes), expected)
+                self.assertEqual(funcs, {})
+                self.assertIsNotNone(summary)
+                self.assertEqual(summary["funcs"], 3)
+                self.assertEqual(summary["capped"], 0)
+                for name, st in passes.items():
+                    self.assertEqual(st["runs"], summary["rounds"], name)
+                    self.assertLessEqual(st["changed"], st["runs"], name)
+
+    def test_functions_converge_independently(self) -> None:
+        passes, funcs, summary = _parse(self.compile_s(self.work, "a.s", "-O2", "-v", "--time-phases").stderr)
+        self.assertEqual(set(funcs), {"معقدة", "ثابتة", "الرئيسية"})
+        # الدالة التافهة لا تُعاد لأن معقدة ما زالت تتغير.
+        self.assertEqual(funcs["ثابتة"]["rounds"], 1)
+        self.assertEqual(funcs["ثابتة"]["changes"], 0)
+        self.assertGreater(funcs["معقدة"]["rounds"], 1)
+        self.assertEqual(summary["rounds"], sum(f["rounds"] for f in funcs.values()))
+        self.assertEqual(summary["max_rounds"], max(f["rounds"] for f in funcs.values()))
+        # آخر جولة لكل دالة لا تغيّر شيئاً (نقطة تثبيت حقيقية).
+        for name, f in funcs.items():
+            self.assertLess(f["changes"], f["rounds"] * len(passes), name)
+
+    def test_opt_stats_prints_per_function_lines(self) -> None:
+        _, funcs, summary = _parse(self.compile_s(self.work, "a.s", "-O2", "--opt-stats").stderr)
+        self.assertEqual(len(funcs), 3)
+        self.assertIsNotNone(summary)
+        self.assertEqual(_parse(self.compile_s(self.work, "b.s", "-O2").stderr), ({}, {}, None))
+        self.assertEqual(_parse(self.compile_s(self.work, "c.s", "-O0", "--time-phases").stderr), ({}, {}, None))
+
+    def test_explicit_default_pipeline_matches_default(self) -> None:
+        for level, spec in (("-O1", DEFAULT_O1), ("-O2", DEFAULT_O2)):
+            with self.subTest(level=level):
+                self.compile_s(self.work, "plain.s", level)
+                self.compile_s(self.work, "spec.s", level, "--opt-pipeline=" + ",".join(spec))
+                self.assertEqual((self.work / "plain.s").read_bytes(), (self.work / "spec.s").read_bytes())
+
+    def test_custom_pipeline_runs_only_listed_passes(self) -> None:
+        passes, _, _ = _parse(
+            self.compile_s(self.work, "a.s", "-O1", "--time-phases", "--opt-pipeline=mem2reg,gvn,dce").stderr
+        )
+        self.assertEqual(list(passes), ["mem2reg", "gvn", "dce"])
+
+    def test_unknown_pass_is_rejected(self) -> None:
+        proc = self.run_baa(self.work, "-S", "--opt-pipeline=mem2reg,nosuchpass", "main.baa", "-o", "a.s")
+        self.assertNotEqual(proc.returncode, 0)
+        self.assertIn("nosuchpass", proc.stderr)
+        self.assertIn("cfg-simplify", proc.stderr)
+        self.assertFalse((self.work / "a.s").exists())
+
+    def test_verify_gate_checks_each_round(self) -> None:
+        for level in ("-O1", "-O2"):
+            with self.subTest(level=level):
+                self.compile_s(self.work, "plain.s", level)
+                self.compile_s(self.work, "gated.s", level, "--verify-gate")
+                self.assertEqual((self.work / "plain.s").read_bytes(), (self.work / "gated.s").read_bytes())
+
+    @unittest.skipIf(os.name == "nt", "runtime check uses the Linux toolchain")
+    def test_program_output_is_unchanged(self) -> None:
+        for args in (("-O0",), ("-O1",), ("-O2",), ("-O2", "--opt-pipeline=mem2reg,sccp,dce")):
+            with self.subTest(args=args):
+                exe = self.work / "main_bin"
+                proc = self.run_baa(self.work, "--assembler=gas", *args, "main.baa", "-o", exe.name)
+                self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                run = subprocess.run([str(exe)], cwd=self.work, text=True, capture_output=True, timeout=30)
+                self.assertEqual(run.returncode, 0, run.stderr)
+                self.assertEqual(run.stdout, EXPECTED)
+
+
+if __name__ == "__main__":
+    unittest.main()
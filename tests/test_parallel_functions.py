@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""Contract tests for --threads: one unit's functions are optimized and lowered on a thread pool with identical output."""
+
+from __future__ import annotations
+
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+REGALLOC_RE = re.compile(r"^\[REGALLOC\] .*$")
+OPT_FUNC_RE = re.compile(r"^\[OPT-FUNC\] func=(\S+) rounds=(\d+) changes=(\d+) ")
+ANALYSIS_RE = re.compile(r"^\[ANALYSIS\] .*$")
+FUNC_COUNT = 40
+
+
+def _program() -> str:
+    """دوال كثيرة مستقلة (حلقات وفروع وتفرع) حتى يتوزع العمل فعلاً على العمال."""
+    parts = []
+    for i in range(FUNC_COUNT):
+        parts.append(
+            f"""صحيح ف{i}(صحيح ن) {{
+    صحيح م = {i}.
+    لكل (صحيح ي = ٠؛ ي < ن؛ ي++) {{
+        صحيح ك = ن * ٣ + {i}.
+        إذا (ي % ٢ == ٠) {{
+            م = م + ي * ك.
+        }} وإلا {{
+            م = م - ي.
+        }}
+    }}
+    اختر (م % ٤) {{
+        حالة ٠: م = م + ١. توقف.
+        حالة ١: م = م * ٢. توقف.
+        حالة ٢: م = م - ٣. توقف.
+        افتراضي: م = م + ٧. توقف.
+    }}
+    إرجع م.
+}}
+"""
+        )
+    calls = "".join(f"    م = م + ف{i}(٥).\n" for i in range(FUNC_COUNT))
+    parts.append(f"صحيح الرئيسية() {{\n    صحيح م = ٠.\n{calls}    اطبع م.\n    إرجع ٠.\n}}\n")
+    return "\n".join(parts)
+
+
+def _expected() -> str:
+    total = 0
+    for i in range(FUNC_COUNT):
+        m = i
+        for j in range(5):
+            k = 5 * 3 + i
+            m = m + j * k if j % 2 == 0 else m - j
+        r = m % 4 if m >= 0 else -((-m) % 4)
+        m = {0: m + 1, 1: m * 2, 2: m - 3}.get(r, m + 7)
+        total += m
+    return f"{total}\n"
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _lines(stderr: str, pattern: re.Pattern[str]) -> list[str]:
+    return [line.strip() for line in stderr.splitlines() if pattern.match(line.strip())]
+
+
+class ParallelFunctionsTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=self.work,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def compile_s(self, out: str, *args: str) -> subprocess.CompletedProcess[str]:
+        proc = self.run_baa("-S", "--assembler=gas", *args, "main.baa", "-o", out)
+        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+        return proc
+
+    def setUp(self) -> None:
+        self._temp = tempfile.TemporaryDirectory(prefix="baa_parallel_funcs_")
+        self.work = Path(self._temp.name)
+        (self.work / "main.baa").write_text(_program(), encoding="utf-8")
+
+    def tearDown(self) -> None:
+        self._temp.cleanup()
+
+    def assert_same_file(self, a: str, b: str) -> None:
+        self.assertEqual((self.work / a).read_bytes(), (self.work / b).read_bytes())
+
+    def test_assembly_is_identical_across_thread_counts(self) -> None:
+        for args in (("-O0",), ("-O1",), ("-O2",), ("-O2", "--regalloc=split"), ("-O2", "--debug-info")):
+            with self.subTest(args=args):
+                self.compile_s("serial.s", *args, "--threads=1")
+                for threads in (2, 4, 8):
+                    self.compile_s("threaded.s", *args, f"--threads={threads}")
+                    self.assert_same_file("serial.s", "threaded.s")
+
+    def test_nazm_text_and_optimized_ir_are_identical(self) -> None:
+        # إصدار نظم يبقى تسلسلياً، لكن ما قبله (المُحسِّن/isel/التخصيص) موزّع.
+        dumps = []
+        for threads in (1, 4):
+            proc = self.run_baa("-S", "--assembler=nazm", "-O2", "--dump-ir-opt", f"--threads={threads}",
+                                "main.baa", "-o", f"t{threads}.نظم")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            dumps.append(proc.stdout)
+        self.assertIn("@ف0", dumps[0])
+        self.assertEqual(dumps[0], dumps[1])
+        self.assert_same_file("t1.نظم", "t4.نظم")
+
+    def test_stats_lines_keep_function_order(self) -> None:
+        serial = self.compile_s("a.s", "-O2", "-v", "--time-phases", "--regalloc-stats", "--threads=1").stderr
+        threaded = self.compile_s("b.s", "-O2", "-v", "--time-phases", "--regalloc-stats", "--threads=4").stderr
+
+        regalloc = _lines(serial, REGALLOC_RE)
+        self.assertEqual(len(regalloc), FUNC_COUNT + 1)
+        self.assertEqual(regalloc, _lines(threaded, REGALLOC_RE))
+        # الأزمنة تختلف؛ الترتيب والجولات والتغييرات لا.
+        funcs = [OPT_FUNC_RE.match(line).groups() for line in serial.splitlines() if OPT_FUNC_RE.match(line)]
+        self.assertEqual(len(funcs), FUNC_COUNT + 1)
+        self.assertEqual(funcs, [OPT_FUNC_RE.match(l).groups() for l in threaded.splitlines() if OPT_FUNC_RE.match(l)])
+        self.assertEqual(_lines(serial, ANALYSIS_RE), _lines(threaded, ANALYSIS_RE))
+
+    def test_jobs_flag_threads_a_single_input(self) -> None:
+        self.compile_s("serial.s", "-O2")
+        self.compile_s("jobs.s", "-O2", "-j", "4")
+        self.assert_same_file("serial.s", "jobs.s")
+
+    @unittest.skipIf(os.name == "nt", "-j runs serially on Windows")
+    def test_threads_with_multi_input_jobs_warns(self) -> None:
+        # عمال -j عمليات منفصلة، فلا يُنشأ مجمّع خيوط ويُحذَّر المستخدم بدل التجاهل الصامت.
+        (self.work / "other.baa").write_text(_program(), encoding="utf-8")
+        proc = self.run_baa("-S", "--assembler=gas", "-j", "2", "--threads=4", "main.baa", "other.baa")
+        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+        self.assertIn("تم تجاهل --threads", proc.stderr)
+        self.assertTrue((self.work / "other.s").is_file())
+
+        proc = self.run_baa("-S", "--assembler=gas", "-j", "2", "main.baa", "other.baa")
+        self.assertNotIn("--threads", proc.stderr)
+
+    def test_invalid_thread_count_is_rejected(self) -> None:
+        for value in ("0", "-2", "abc", ""):
+            with self.subTest(value=value):
+                proc = self.run_baa("-S", f"--threads={value}", "main.baa", "-o", "a.s")
+                self.assertNotEqual(proc.returncode, 0)
+                self.assertIn("--threads", proc.stderr)
+
+    @unittest.skipIf(os.name == "nt", "runtime check uses the Linux toolchain")
+    def test_threaded_program_output_is_unchanged(self) -> None:
+        for level in ("-O1", "-O2"):
+            with self.subTest(level=level):
+                exe = self.work / "main_bin"
+                proc = self.run_baa("--assembler=gas", level, "--threads=4", "main.baa", "-o", exe.name)
+                self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                run = subprocess.run([str(exe)], cwd=self.work, text=True, capture_output=True, timeout=30)
+                self.assertEqual(run.returncode, 0, run.stderr)
+                self.assertEqual(run.stdout, _expected())
+
+
+if __name__ == "__main__":
+    unittest.main()
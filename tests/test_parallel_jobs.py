@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+
+from __future__ import annotations
+
+import os
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+
+
+def _find_baa() -> Path:
+    env = os.environ.get("BAA")
+    if env:
+        p = Path(env)
+        if p.exists():
+            return p
+
+    candidates = [
+        ROOT / "build" / "presets" / "windows-verify" / "baa.exe",
+        ROOT / "build" / "baa.exe",
+        ROOT / "build-linux" / "presets" / "verify" / "baa",
+        ROOT / "build-linux" / "baa",
+    ]
+    for candidate in candidates:
+        if candidate.exists():
+            return candidate
+    raise FileNotFoundError("Could not find compiler binary; set BAA or build first")
+
+
+class ParallelJobsTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _find_baa()
+
+    def run_baa(self, work: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=str(work),
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=60,
+        )
+
+    def write_program(self, work: Path, unit_count: int) -> list[str]:
+        names = [f"وحدة_{i}" for i in range(unit_count)]
+        (work / "api.baahd").write_text(
+            "".join(f"خارجي صحيح {name}().\n" for name in names),
+            encoding="utf-8",
+        )
+        inputs = ["main.baa"]
+        for i, name in enumerate(names):
+            path = f"unit{i}.baa"
+            (work / path).write_text(
+                "#تضمين \"api.baahd\"\n"
+                f"صحيح {name}() {{ إرجع {i}. }}\n",
+                encoding="utf-8",
+            )
+            inputs.append(path)
+        total = " + ".join(f"{name}()" for name in names)
+        expected = sum(range(unit_count))
+        (work / "main.baa").write_text(
+            "#تضمين \"api.baahd\"\n"
+            f"صحيح الرئيسية() {{ إرجع {total} - {expected}. }}\n",
+            encoding="utf-8",
+        )
+        return inputs
+
+    def test_parallel_build_matches_serial_manifest_and_runs(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_jobs_link_") as temp:
+            work = Path(temp)
+            inputs = self.write_program(work, 6)
+            exe_ext = ".exe" if os.name == "nt" else ""
+
+            serial = self.run_baa(
+                work, "-O1", *inputs, "-o", f"serial{exe_ext}",
+                "--emit-build-manifest", "serial.json",
+            )
+            self.assertEqual(serial.returncode, 0, serial.stderr)
+            parallel = self.run_baa(
+                work, "-O1", "-j", "4", *inputs, "-o", f"parallel{exe_ext}",
+                "--emit-build-manifest", "parallel.json",
+            )
+            self.assertEqual(parallel.returncode, 0, parallel.stderr)
+
+            self.assertEqual(
+                (work / "serial.json").read_bytes(),
+                (work / "parallel.json").read_bytes(),
+            )
+            run = subprocess.run(
+                [str(work / f"parallel{exe_ext}")], capture_output=True, timeout=30
+            )
+            self.assertEqual(run.returncode, 0)
+            leftovers = sorted(p.name for p in work.iterdir() if ".baa_job_" in p.name)
+            self.assertEqual(leftovers, [])
+
+    def test_parallel_compile_only_writes_each_object(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_jobs_c_") as temp:
+            work = Path(temp)
+            inputs = self.write_program(work, 4)
+            proc = self.run_baa(work, "-c", "--jobs=3", *inputs)
+            self.assertEqual(proc.returncode, 0, proc.stderr)
+            for source in inputs:
+                self.assertTrue((work / source).with_suffix(".o").is_file(), source)
+
+    def test_diagnostics_stay_in_input_order(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_jobs_diag_") as temp:
+            work = Path(temp)
+            (work / "ok.baa").write_text("صحيح الرئيسية() { إرجع ٠. }\n", encoding="utf-8")
+            (work / "bad1.baa").write_text(
+                "صحيح س() { إرجع غير_معرف. }\n", encoding="utf-8"
+            )
+            (work / "bad2.baa").write_text(
+                "صحيح ص() { إرجع مجهول. }\n", encoding="utf-8"
+            )
+            args = ["-Wno-color", "ok.baa", "bad1.baa", "bad2.baa", "-o", "app"]
+            serial = self.run_baa(work, *args)
+            parallel = self.run_baa(work, "-j4", *args)
+
+        self.assertNotEqual(parallel.returncode, 0)
+        self.assertEqual(serial.returncode, parallel.returncode)
+        self.assertEqual(serial.stderr, parallel.stderr)
+        self.assertIn("bad1.baa", parallel.stderr)
+        self.assertNotIn("bad2.baa", parallel.stderr)
+
+    def test_parallel_one_definition_conflict_reports_first_definition(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_jobs_odr_") as temp:
+            work = Path(temp)
+            inputs = self.write_program(work, 3)
+            (work / "dup.baa").write_text(
+                "#تضمين \"api.baahd\"\n"
+                "صحيح وحدة_1() { إرجع ٩. }\n",
+                encoding="utf-8",
+            )
+            proc = self.run_baa(work, "-j", "4", *inputs, "dup.baa", "-o", "app")
+
+        combined = f"{proc.stdout}\n{proc.stderr}"
+        self.assertNotEqual(proc.returncode, 0, combined)
+        self.assertIn("تعريف متعدد للرمز العام 'وحدة_1'", combined)
+        self.assertIn("التعريف الأول: دالة في unit1.baa", combined)
+        self.assertIn("التعريف الثاني: دالة في dup.baa", combined)
+
+    def test_serial_only_modes_warn_that_jobs_is_ignored(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_jobs_warn_") as temp:
+            work = Path(temp)
+            inputs = self.write_program(work, 2)
+            proc = self.run_baa(work, "-S", "-j2", "--diagnostics=json", *inputs)
+
+        self.assertEqual(proc.returncode, 0, proc.stderr)
+        self.assertIn("تم تجاهل -j", proc.stderr)
+        self.assertIn("--diagnostics=json", proc.stderr)
+
+    def test_invalid_job_count_is_invalid_invocation(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_jobs_cli_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text("صحيح الرئيسية() { إرجع ٠. }\n", encoding="utf-8")
+            for bad in (["-j0"], ["--jobs=abc"], ["-j"]):
+                proc = self.run_baa(work, *bad, "main.baa")
+                self.assertEqual(proc.returncode, 2, f"{bad}: {proc.stderr}")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Contract tests for copy hints and the post-allocation cleanup (copies_removed/spill_removed)."""
+
+from __future__ import annotations
+
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+STATS_RE = re.compile(r"^\[REGALLOC\] func=(\S+) allocator=(\w+) (.*)$")
+
+# حلقات تدوير قيم (نسخ فاي بعد الخروج من SSA) ونسخ ٣٢ بت لا يجوز حذفها.
+PROGRAM = """\
+صحيح فيبوناتشي(صحيح ن) {
+    صحيح أ = ٠.
+    صحيح ب = ١.
+    لكل (صحيح ي = ٠؛ ي < ن؛ ي++) {
+        صحيح ت = (أ + ب) % ١٠٠٠٠٠٧.
+        أ = ب.
+        ب = ت.
+    }
+    إرجع أ.
+}
+
+صحيح تدوير(صحيح ن) {
+    صحيح أ = ١. صحيح ب = ٢. صحيح ج = ٣. صحيح د = ٤.
+    لكل (صحيح ي = ٠؛ ي < ن؛ ي++) {
+        صحيح ت = أ.
+        أ = ب. ب = ج. ج = د. د = ت + ي.
+    }
+    إرجع أ * ١ + ب * ١٠ + ج * ١٠٠ + د * ١٠٠٠.
+}
+
+ط٣٢ خلط(ط٣٢ س، ط٣٢ ص) {
+    ط٣٢ م = س.
+    لكل (صحيح ي = ٠؛ ي < ٥؛ ي++) {
+        ط٣٢ ت = م * ٣ + ص.
+        م = ت.
+    }
+    إرجع م.
+}
+
+صحيح الرئيسية() {
+    اطبع فيبوناتشي(٩٠).
+    اطبع تدوير(٢٥).
+    اطبع خلط(٤٠٠٠٠٠٠٠٠٠، ٧).
+    إرجع ٠.
+}
+"""
+
+EXPECTED = "577833\n94018\n1337391951\n"
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _parse_stats(stderr: str) -> dict[str, dict[str, str]]:
+    """سطور [REGALLOC] لكل دالة: allocator ثم أزواج المفتاح=القيمة."""
+    out: dict[str, dict[str, str]] = {}
+    for line in stderr.splitlines():
+        m = STATS_RE.match(line.strip())
+        if not m:
+            continue
+        kv = dict(part.split("=", 1) for part in m.group(3).split() if "=" in part)
+        kv["allocator"] = m.group(2)
+        out[m.group(1)] = kv
+    return out
+
+
+class RegAllocCoalesceTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def stats(self, work: Path, *args: str) -> dict[str, dict[str, str]]:
+        proc = self.run_baa(
+            work, "-S", "--assembler=gas", "--target=x86_64-linux", *args, "main.baa", "-o", "main.s"
+        )
+        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+        return _parse_stats(proc.stderr)
+
+    def test_loop_copies_are_removed_by_both_allocators(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_regalloc_coalesce_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            for allocator in ("linear", "split"):
+                for level in ("-O0", "-O2"):
+                    with self.subTest(allocator=allocator, level=level):
+                        st = self.stats(work, level, f"--regalloc={allocator}", "--regalloc-stats")
+                        self.assertEqual(st["تدوير"]["allocator"], allocator)
+                        removed = sum(int(kv["copies_removed"]) for kv in st.values())
+                        self.assertGreater(removed, 0)
+                        for kv in st.values():
+                            self.assertGreaterEqual(int(kv["spill_removed"]), 0)
+                            self.assertGreaterEqual(int(kv["cost"]), 0)
+
+    def test_verbose_time_phases_reports_removed_copies(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_regalloc_coalesce_time_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            st = self.stats(work, "-O2", "-v", "--time-phases")
+            self.assertEqual(set(st), {"فيبوناتشي", "تدوير", "خلط", "الرئيسية"})
+            self.assertIn("copies_removed", st["تدوير"])
+            # بدون -v يبقى --time-phases على أسطره المعتادة.
+            self.assertEqual(self.stats(work, "-O2", "--time-phases"), {})
+
+    @unittest.skipIf(os.name == "nt", "runtime check uses the Linux toolchain")
+    def test_cleaned_program_output_is_unchanged(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_regalloc_coalesce_run_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            for allocator in ("linear", "split"):
+                for level in ("-O0", "-O1", "-O2"):
+                    with self.subTest(allocator=allocator, level=level):
+                        exe = work / f"main_{allocator}{level}"
+                        proc = self.run_baa(
+                            work, "--assembler=gas", level, f"--regalloc={allocator}", "main.baa", "-o", exe.name
+                        )
+                        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                        run = subprocess.run([str(exe)], cwd=work, text=True, capture_output=True, timeout=30)
+                        self.assertEqual(run.returncode, 0, run.stderr)
+                        self.assertEqual(run.stdout, EXPECTED)
+
+
+if __name__ == "__main__":
+    unittest.main()
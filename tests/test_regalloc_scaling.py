@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""Large generated functions (thousands of blocks and calls) through both register allocators."""
+
+from __future__ import annotations
+
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+ARABIC_DIGITS = str.maketrans("0123456789", "٠١٢٣٤٥٦٧٨٩")
+TIME_RE = re.compile(r"^\[TIME\] .*\bregalloc=([0-9.]+)")
+MOD = 1000003
+
+
+def _num(n: int) -> str:
+    return str(n).translate(ARABIC_DIGITS)
+
+
+def _program(stmts: int) -> tuple[str, str]:
+    """دالة واحدة بثمانية متغيرات متناوبة وتفرع كل ٨ جمل ونداء كل ٣٢، مع ناتجها المتوقع."""
+    lines = ["صحيح مساعد(صحيح س) {", "    إرجع س % ٩٧ + ١.", "}", "صحيح ضخم(صحيح أ) {"]
+    vals = [3 + v for v in range(8)]
+    for v in range(8):
+        lines.append(f"    صحيح م{_num(v)} = أ + {_num(v)}.")
+    for i in range(stmts):
+        d = i % 8
+        s = (i * 3 + 1) % 8
+        if i % 32 == 31:
+            lines.append(f"    م{_num(d)} = (م{_num(d)} + مساعد(م{_num(s)})) % {_num(MOD)}.")
+            vals[d] = (vals[d] + vals[s] % 97 + 1) % MOD
+        elif i % 8 == 7:
+            lines.append(f"    إذا (م{_num(d)} > ٥٠٠٠٠٠) {{ م{_num(d)} = م{_num(d)} - م{_num(s)} % ١٠٠٠. }}")
+            if vals[d] > 500000:
+                vals[d] -= vals[s] % 1000
+        else:
+            lines.append(f"    م{_num(d)} = (م{_num(s)} * ٣ + م{_num(d)} % ٧ + {_num(i % 100)}) % {_num(MOD)}.")
+            vals[d] = (vals[s] * 3 + vals[d] % 7 + i % 100) % MOD
+    lines.append("    إرجع " + " + ".join(f"م{_num(v)}" for v in range(8)) + ".")
+    lines += ["}", "صحيح الرئيسية() {", "    اطبع ضخم(٣).", "    إرجع ٠.", "}"]
+    return "\n".join(lines) + "\n", f"{sum(vals)}\n"
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+class RegAllocScalingTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=300,
+        )
+
+    def test_time_phases_reports_regalloc_for_large_function(self) -> None:
+        source, _ = _program(1500)
+        with tempfile.TemporaryDirectory(prefix="baa_regalloc_scale_time_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(source, encoding="utf-8")
+            proc = self.run_baa(work, "-O0", "-S", "--time-phases", "main.baa", "-o", "main.s")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            self.assertTrue(any(TIME_RE.match(line) for line in proc.stderr.splitlines()), proc.stderr)
+
+    @unittest.skipIf(os.name == "nt", "runtime check uses the Linux toolchain")
+    def test_large_function_output_matches_for_both_allocators(self) -> None:
+        for stmts, level in ((2000, "-O0"), (300, "-O2")):
+            source, expected = _program(stmts)
+            with tempfile.TemporaryDirectory(prefix="baa_regalloc_scale_") as temp:
+                work = Path(temp)
+                (work / "main.baa").write_text(source, encoding="utf-8")
+                for allocator in ("linear", "split"):
+                    with self.subTest(stmts=stmts, level=level, allocator=allocator):
+                        exe = work / f"main_{allocator}"
+                        proc = self.run_baa(
+                            work, "--assembler=gas", level, f"--regalloc={allocator}", "main.baa", "-o", exe.name
+                        )
+                        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                        run = subprocess.run([str(exe)], cwd=work, text=True, capture_output=True, timeout=30)
+                        self.assertEqual(run.returncode, 0, run.stderr)
+                        self.assertEqual(run.stdout, expected)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Contract tests for the live-range splitting register allocator (--regalloc=split)."""
+
+from __future__ import annotations
+
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+STATS_RE = re.compile(r"^\[REGALLOC\] func=(\S+) allocator=(\w+) (.*)$")
+
+# ضغط سجلات عال: متغيرات حية عبر حلقات متداخلة ونداءات واختيار بجدول قفز.
+PROGRAM = """\
+صحيح مزج(صحيح أ، صحيح ب) {
+    إرجع (أ * ٣١ + ب) % ١٠٠٠٠٣.
+}
+
+صحيح ضغط(صحيح ن) {
+    صحيح أ = ١. صحيح ب = ٢. صحيح ج = ٣. صحيح د = ٤.
+    صحيح هـ = ٥. صحيح و = ٦. صحيح ز = ٧. صحيح ح = ٨.
+    صحيح ط = ٩. صحيح ي = ١٠. صحيح ك = ١١. صحيح ل = ١٢.
+    لكل (صحيح س = ٠؛ س < ن؛ س = س + ١) {
+        أ = أ + ب * س.
+        ب = ب + ج - س.
+        ج = مزج(ج، د).
+        د = د + هـ.
+        لكل (صحيح ص = ٠؛ ص < ٤؛ ص = ص + ١) {
+            هـ = هـ + و * ص.
+            و = و + ز.
+            ز = (ز + ح) % ٩٩٧.
+            ح = ح + ط - ص.
+            إذا (ص == ٢) {
+                ط = مزج(ط، ي).
+            }
+        }
+        ي = ي + ك.
+        ك = (ك + ل) % ١٠٠٠.
+        ل = ل + أ % ١٧.
+        اختر (س % ٥) {
+            حالة ٠:
+                أ = أ + ١.
+            حالة ١:
+                ب = ب + ٢.
+            حالة ٢:
+                ج = ج + ٣.
+            حالة ٣:
+                د = د + ٤.
+            افتراضي:
+                هـ = هـ + ٥.
+        }
+    }
+    إرجع (أ + ب + ج + د + هـ + و + ز + ح + ط + ي + ك + ل) % ١٠٠٠٠٠٠٧.
+}
+
+صحيح دوار(صحيح ن) {
+    صحيح أ = ١. صحيح ب = ٢. صحيح ج = ٣. صحيح د = ٤. صحيح هـ = ٥. صحيح و = ٦. صحيح ز = ٧.
+    لكل (صحيح س = ٠؛ س < ن؛ س = س + ١) {
+        صحيح ت = أ.
+        أ = ب. ب = ج. ج = د. د = هـ. هـ = و. و = ز. ز = ت + س.
+    }
+    إرجع أ * ١ + ب * ٢ + ج * ٣ + د * ٤ + هـ * ٥ + و * ٦ + ز * ٧.
+}
+
+صحيح الرئيسية() {
+    اطبع ضغط(١٠).
+    اطبع ضغط(١٠٠).
+    اطبع دوار(١٣).
+    اطبع دوار(١٠٠).
+    إرجع ٠.
+}
+"""
+
+EXPECTED = "555272\n8984794\n484\n20300\n"
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _parse_stats(stderr: str) -> dict[str, dict[str, str]]:
+    """سطور [REGALLOC] لكل دالة: allocator ثم أزواج المفتاح=القيمة."""
+    out: dict[str, dict[str, str]] = {}
+    for line in stderr.splitlines():
+        m = STATS_RE.match(line.strip())
+        if not m:
+            continue
+        kv = dict(part.split("=", 1) for part in m.group(3).split() if "=" in part)
+        kv["allocator"] = m.group(2)
+        out[m.group(1)] = kv
+    return out
+
+
+class RegAllocSplitTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def stats(self, work: Path, allocator: str, level: str) -> dict[str, dict[str, str]]:
+        proc = self.run_baa(
+            work, level, "-S", "--assembler=gas", "--target=x86_64-linux",
+            f"--regalloc={allocator}", "--regalloc-stats", "main.baa", "-o", f"{allocator}{level}.s",
+        )
+        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+        return _parse_stats(proc.stderr)
+
+    def test_stats_report_each_function_for_both_allocators(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_regalloc_split_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            linear = self.stats(work, "linear", "-O2")
+            split = self.stats(work, "split", "-O2")
+            self.assertEqual(set(linear), {"مزج", "ضغط", "دوار", "الرئيسية"})
+            self.assertEqual(set(split), set(linear))
+            for func, kv in split.items():
+                with self.subTest(func=func):
+                    self.assertEqual(kv["allocator"], "split")
+                    self.assertEqual(linear[func]["allocator"], "linear")
+                    self.assertEqual(linear[func]["splits"], "0")
+            # الدالة ذات الضغط العالي تُقسم مداها بدل تسريب متغيرات كاملة.
+            self.assertGreater(int(split["ضغط"]["splits"]), 0)
+
+    def test_stats_are_off_by_default(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_regalloc_quiet_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            proc = self.run_baa(work, "-O2", "-S", "--regalloc=split", "main.baa", "-o", "main.s")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            self.assertNotIn("[REGALLOC]", proc.stderr)
+
+    def test_unknown_allocator_is_rejected(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_regalloc_bad_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            proc = self.run_baa(work, "-S", "--regalloc=graph", "main.baa", "-o", "main.s")
+            self.assertNotEqual(proc.returncode, 0)
+            self.assertIn("Unknown register allocator", proc.stderr)
+
+    @unittest.skipIf(os.name == "nt", "runtime check uses the Linux toolchain")
+    def test_split_program_matches_linear_output(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_regalloc_split_run_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            for allocator in ("linear", "split"):
+                for level in ("-O0", "-O1", "-O2"):
+                    with self.subTest(allocator=allocator, level=level):
+                        exe = work / f"main_{allocator}{level}"
+                        proc = self.run_baa(
+                            work, "--assembler=gas", level, f"--regalloc={allocator}", "main.baa", "-o", exe.name
+                        )
+                        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                        run = subprocess.run([str(exe)], cwd=work, text=True, capture_output=True, timeout=30)
+                        self.assertEqual(run.returncode, 0, run.stderr)
+                        self.assertEqual(run.stdout, EXPECTED)
+
+
+if __name__ == "__main__":
+    unittest.main()
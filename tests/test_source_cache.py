@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""Contract tests for memory-mapped source loading and the per-process include cache."""
+
+from __future__ import annotations
+
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+MEM_RE = re.compile(r"^\[MEM\] (.*)$", re.MULTILINE)
+PAGE = 4096
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _mem_fields(stderr: str) -> dict[str, int]:
+    match = MEM_RE.search(stderr)
+    if not match:
+        raise AssertionError(f"missing [MEM] line in:\n{stderr}")
+    return {key: int(value) for key, value in (item.split("=", 1) for item in match.group(1).split())}
+
+
+def _functions(prefix: str, count: int) -> str:
+    return "".join(f"صحيح {prefix}{i}(صحيح س) {{\n    إرجع س + {i}.\n}}\n" for i in range(count))
+
+
+def _padded(text: str, size: int) -> bytes:
+    """النص متبوعاً بتعليق يجعل حجم الملف size بايتاً بالضبط."""
+    data = text.encode("utf-8")
+    filler = size - len(data) - 4
+    if filler < 0:
+        raise ValueError("text does not fit")
+    return data + b"//" + b"x" * filler + b"\n\n"
+
+
+class SourceCacheTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def test_shared_header_is_loaded_once_per_build(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_source_cache_") as temp:
+            work = Path(temp)
+            (work / "مشترك.baahd").write_text(_functions("مشترك", 50), encoding="utf-8")
+            units = []
+            for n in range(4):
+                name = f"وحدة{n}.baa"
+                (work / name).write_text(
+                    '#تضمين "مشترك.baahd"\n'
+                    f"صحيح دالة{n}() {{\n    إرجع مشترك{n}(١).\n}}\n",
+                    encoding="utf-8",
+                )
+                units.append(name)
+            proc = self.run_baa(work, "--check", "--time-phases", *units)
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            mem = _mem_fields(proc.stderr)
+            self.assertEqual(mem["source_loads"], 1)
+            self.assertEqual(mem["source_cache_hits"], len(units) - 1)
+
+    def test_page_boundary_sizes_compile_identically(self) -> None:
+        # ملفات أحجامها مضاعف الصفحة تُقرأ، وغيرها يُربط بالذاكرة؛ النتيجة واحدة.
+        body = _functions("ف", 300)
+        main = "صحيح الرئيسية() {\n    إرجع ف5(١).\n}\n"
+        with tempfile.TemporaryDirectory(prefix="baa_source_map_") as temp:
+            work = Path(temp)
+            outputs = []
+            for size in (9 * PAGE - 1, 9 * PAGE, 9 * PAGE + 1):
+                with self.subTest(header_size=size):
+                    (work / "كبير.baahd").write_bytes(_padded(body, size))
+                    (work / "main.baa").write_text('#تضمين "كبير.baahd"\n' + main, encoding="utf-8")
+                    proc = self.run_baa(work, "-O1", "-S", "main.baa", "-o", "main.s")
+                    self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                    outputs.append((work / "main.s").read_text(encoding="utf-8"))
+            for size in (10 * PAGE - 1, 10 * PAGE, 10 * PAGE + 1):
+                with self.subTest(root_size=size):
+                    (work / "root.baa").write_bytes(_padded(body + main, size))
+                    proc = self.run_baa(work, "-O1", "-S", "root.baa", "-o", "root.s")
+                    self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            self.assertEqual(len(set(outputs)), 1)
+
+    def test_errors_in_cached_header_keep_source_context(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_source_cache_diag_") as temp:
+            work = Path(temp)
+            header = _functions("ف", 400) + "صحيح معطوب() {\n    إرجع مجهول_تماما.\n}\n"
+            (work / "معطوب.baahd").write_bytes(_padded(header, 10 * PAGE + 7))
+            line = header.count("\n") - 1
+            for n in range(2):
+                (work / f"u{n}.baa").write_text(
+                    '#تضمين "معطوب.baahd"\n' f"صحيح د{n}() {{\n    إرجع ٠.\n}}\n",
+                    encoding="utf-8",
+                )
+            # الوحدة الثانية تأخذ الترويسة من الذاكرة المخبئية؛ يجب أن يظهر السياق نفسه.
+            for unit in ("u0.baa", "u1.baa"):
+                with self.subTest(unit=unit):
+                    proc = self.run_baa(work, "--check", unit)
+                    combined = proc.stdout + proc.stderr
+                    self.assertNotEqual(proc.returncode, 0, combined)
+                    self.assertIn(f"معطوب.baahd:{line}:", combined)
+                    self.assertIn("إرجع مجهول_تماما.", combined)
+
+    @unittest.skipIf(os.name == "nt", "directory probing differs on Windows")
+    def test_directory_candidates_are_skipped_during_include_search(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_source_cache_dir_") as temp:
+            work = Path(temp)
+            (work / "مساعد.baahd").mkdir()
+            lib = work / "lib"
+            lib.mkdir()
+            (lib / "مساعد.baahd").write_text(_functions("م", 2), encoding="utf-8")
+            (work / "main.baa").write_text(
+                '#تضمين "مساعد.baahd"\nصحيح الرئيسية() {\n    إرجع م1(٠).\n}\n',
+                encoding="utf-8",
+            )
+            proc = self.run_baa(work, "--check", "-I", "lib", "main.baa")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+
+    def test_missing_include_still_reports_search_paths(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_source_cache_missing_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(
+                '#تضمين "غائب.baahd"\nصحيح الرئيسية() {\n    إرجع ٠.\n}\n', encoding="utf-8"
+            )
+            proc = self.run_baa(work, "--check", "main.baa")
+            self.assertNotEqual(proc.returncode, 0)
+            self.assertIn("تعذر تضمين الملف", proc.stdout + proc.stderr)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""Contract tests for SROA and Mem2Reg: field splitting, the must-def check and partial promotion around calls."""
+
+from __future__ import annotations
+
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+
+# هيكل ومصفوفة بفهارس ثابتة تُفكَّك ثم تُرقّى بالكامل؛ وعنصر لا يُكتب
+# على كل المسارات قبل قراءته (يبقى في الذاكرة بدل اختراع قيمة له).
+FIELDS = """\
+هيكل نقطة {
+    صحيح س.
+    صحيح ص.
+}
+
+صحيح مجموع(صحيح ن) {
+    هيكل نقطة ق = { س: ٠، ص: ١ }.
+    لكل (صحيح ي = ٠؛ ي < ن؛ ي++) {
+        ق:س = ق:س + ي.
+        ق:ص = ق:ص * ٢ % ١٠٠٠.
+    }
+    صحيح م[٤].
+    م[٠] = ١. م[١] = ٢. م[٢] = ٣. م[٣] = ٤.
+    إرجع ق:س + ق:ص + م[٢].
+}
+
+صحيح شرطي(صحيح ن) {
+    صحيح ر[٢].
+    إذا (ن > ٠) {
+        ر[٠] = ن * ٢.
+    }
+    إرجع ر[٠].
+}
+
+صحيح الرئيسية() {
+    اطبع مجموع(١٠).
+    اطبع شرطي(٥).
+    إرجع ٠.
+}
+"""
+
+FIELDS_EXPECTED = "72\n10\n"
+
+# عناوين تُمرَّر لـ scanf (ترقية جزئية)، مصفوفة تهرب إلى دالة، ومصفوفة بفهرس متغير.
+ESCAPES = """\
+صحيح يهرب(صحيح* م) {
+    إرجع م[١].
+}
+
+صحيح الرئيسية() {
+    صحيح س = ٠.
+    صحيح ع = ٠.
+    صحيح عدد = اقرأ_منسق("%ص %ص", &س, &ع).
+    لكل (صحيح ي = ٠؛ ي < ١٠؛ ي++) {
+        س = س + ي.
+    }
+    اطبع س + ع.
+    صحيح ق[٣].
+    ق[٠] = ٤. ق[١] = ٥. ق[٢] = ٦.
+    اطبع يهرب(&ق[٠]).
+    صحيح د[٤].
+    لكل (صحيح ي = ٠؛ ي < ٤؛ ي++) {
+        د[ي] = ي * ي.
+    }
+    اطبع د[٣].
+    إرجع ٠.
+}
+"""
+
+ESCAPES_STDIN = "3 4\n"
+ESCAPES_EXPECTED = "52\n5\n9\n"
+
+NO_SROA = "mem2reg,canon,instcombine,sccp,constfold,copyprop,memopt,dce,cfg-simplify,licm"
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _functions(ir: str) -> dict[str, str]:
+    """جسم كل دالة في تفريغ الـ IR باسمها."""
+    out: dict[str, str] = {}
+    for chunk in re.split(r"\nدالة @", ir)[1:]:
+        name = chunk.split("(", 1)[0]
+        out[name] = chunk
+    return out
+
+
+class SroaTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=self.work,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def dump_opt(self, src: str, *args: str) -> dict[str, str]:
+        proc = self.run_baa("-S", "--assembler=gas", "--dump-ir-opt", *args, src, "-o", "out.s")
+        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+        return _functions(proc.stdout)
+
+    def setUp(self) -> None:
+        self._temp = tempfile.TemporaryDirectory(prefix="baa_sroa_")
+        self.work = Path(self._temp.name)
+        (self.work / "fields.baa").write_text(FIELDS, encoding="utf-8")
+        (self.work / "escapes.baa").write_text(ESCAPES, encoding="utf-8")
+
+    def tearDown(self) -> None:
+        self._temp.cleanup()
+
+    def test_struct_and_constant_indexed_array_are_fully_promoted(self) -> None:
+        for level in ("-O1", "-O2"):
+            with self.subTest(level=level):
+                funcs = self.dump_opt("fields.baa", level)
+                self.assertIn("مجموع", funcs)
+                self.assertNotIn("حجز", funcs["مجموع"])
+                self.assertNotIn("حمل", funcs["مجموع"])
+                self.assertIn("فاي", funcs["مجموع"])
+
+    def test_field_read_before_any_store_stays_in_memory(self) -> None:
+        for level in ("-O1", "-O2"):
+            with self.subTest(level=level):
+                funcs = self.dump_opt("fields.baa", level)
+                # الشريحة مفصولة لكن حملها لا يُستبدل بثابت.
+                self.assertIn("حجز ص٦٤", funcs["شرطي"])
+                self.assertIn("حمل", funcs["شرطي"])
+
+    def test_without_sroa_the_aggregate_stays_in_memory(self) -> None:
+        funcs = self.dump_opt("fields.baa", "-O1", f"--opt-pipeline={NO_SROA}")
+        self.assertIn("حجز مصفوفة", funcs["مجموع"])
+
+    def test_scanf_arguments_are_partially_promoted(self) -> None:
+        main = self.dump_opt("escapes.baa", "-O1")["الرئيسية"]
+        # الحجزان باقيان للنداء، لكن الحلقة تعمل على فاي دون حمل/خزن.
+        self.assertEqual(len(re.findall(r"= حجز ص٦٤", main)), 2)
+        loop = main.split("لكل_تحقق_٠:", 1)[1].split("لكل_نهاية_٣:", 1)[0]
+        self.assertIn("فاي", loop)
+        self.assertNotIn("حمل", loop)
+        self.assertNotIn("خزن", loop)
+
+    def test_escaping_or_dynamically_indexed_arrays_are_not_split(self) -> None:
+        main = self.dump_opt("escapes.baa", "-O1")["الرئيسية"]
+        self.assertIn("حجز مصفوفة[ص٦٤، ٣]", main)
+        self.assertIn("حجز مصفوفة[ص٦٤، ٤]", main)
+
+    @unittest.skipIf(os.name == "nt", "runtime check uses the Linux toolchain")
+    def test_runtime_output_is_unchanged(self) -> None:
+        cases = (("fields.baa", "", FIELDS_EXPECTED), ("escapes.baa", ESCAPES_STDIN, ESCAPES_EXPECTED))
+        for src, stdin, expected in cases:
+            for args in (("-O0",), ("-O1",), ("-O2",), ("-O2", "--regalloc=split"), ("-O2", f"--opt-pipeline={NO_SROA}")):
+                with self.subTest(src=src, args=args):
+                    exe = self.work / "main_bin"
+                    proc = self.run_baa("--assembler=gas", *args, src, "-o", exe.name)
+                    self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                    run = subprocess.run([str(exe)], cwd=self.work, input=stdin, text=True,
+                                         capture_output=True, timeout=30)
+                    self.assertEqual(run.returncode, 0, run.stderr)
+                    self.assertEqual(run.stdout, expected)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""Contract tests for `تفرع` lowering: jump tables for dense switches, binary search for sparse ones."""
+
+from __future__ import annotations
+
+import os
+import re
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+TABLE_RE = re.compile(r"^(\.LJT_\d+_\d+):$", re.MULTILINE)
+FUNC_RE = re.compile(r"^\.globl (\S+)$", re.MULTILINE)
+
+PROGRAM = """\
+صحيح كثيف(صحيح ن) {
+    اختر (ن) {
+        حالة ٠: إرجع ١٠.
+        حالة ١: إرجع ٢١.
+        حالة ٢: إرجع ٣٢.
+        حالة ٣: إرجع ٤٣.
+        حالة ٤: إرجع ٥٤.
+        حالة ٦: إرجع ٧٦.
+        حالة ٧: إرجع ٨٧.
+        افتراضي: إرجع -١.
+    }
+    إرجع ٠.
+}
+
+صحيح متفرق(صحيح ن) {
+    اختر (ن) {
+        حالة ١: إرجع ١.
+        حالة ١٠٠: إرجع ٢.
+        حالة ١٠٠٠: إرجع ٣.
+        حالة ١٠٠٠٠: إرجع ٤.
+        حالة ١٠٠٠٠٠: إرجع ٥.
+        حالة ٧٠٠٠٠: إرجع ٦.
+        حالة ٥٠٠: إرجع ٧.
+        افتراضي: إرجع ٠.
+    }
+    إرجع ٠.
+}
+
+صحيح مختلط(ط٨ ح) {
+    صحيح ن = ٠.
+    اختر (ح) {
+        حالة ٢٠٠:
+            ن = ن + ١.
+        حالة ٢٠١:
+            ن = ن + ٢.
+            توقف.
+        حالة ٢٠٢:
+        حالة ٢٠٣:
+            ن = ن + ٣.
+            توقف.
+        حالة ٢٠٥:
+            ن = ن + ٥.
+            توقف.
+        حالة ٩:
+            ن = ن + ٩.
+            توقف.
+    }
+    إرجع ن.
+}
+
+صحيح الرئيسية() {
+    صحيح س = ٠.
+    لكل (صحيح ي = -٢؛ ي < ١٠؛ ي = ي + ١) {
+        س = س * ٣ + كثيف(ي).
+    }
+    اطبع س.
+    اطبع متفرق(١) + متفرق(١٠٠) * ١٠ + متفرق(١٠٠٠) * ١٠٠ + متفرق(١٠٠٠٠) * ١٠٠٠ + متفرق(١٠٠٠٠٠) * ١٠٠٠٠ + متفرق(٧٠٠٠٠) * ١٠٠٠٠٠ + متفرق(٥٠٠) * ١٠٠٠٠٠٠ + متفرق(٣).
+    صحيح م = ٠.
+    لكل (صحيح ي = ٠؛ ي < ٢٥٦؛ ي = ي + ١) {
+        م = م * ٢ + مختلط(ي).
+        م = م % ١٠٠٠٠٠٧.
+    }
+    اطبع م.
+    إرجع ٠.
+}
+"""
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _tables_by_function(asm: str) -> dict[str, int]:
+    """عدد جداول القفز التي تلي تعريف كل دالة."""
+    counts: dict[str, int] = {}
+    current = None
+    for line in asm.splitlines():
+        func = FUNC_RE.match(line)
+        if func:
+            current = func.group(1)
+            counts[current] = 0
+        elif current and TABLE_RE.match(line):
+            counts[current] += 1
+    return counts
+
+
+class SwitchLoweringTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def run_baa(self, cwd: Path, *args: str) -> subprocess.CompletedProcess[str]:
+        return subprocess.run(
+            [str(self.baa), *args],
+            cwd=cwd,
+            text=True,
+            encoding="utf-8",
+            errors="replace",
+            capture_output=True,
+            timeout=120,
+        )
+
+    def emit_asm(self, work: Path, level: str) -> str:
+        out = f"main{level}.s"
+        proc = self.run_baa(work, level, "-S", "--assembler=gas", "--target=x86_64-linux", "main.baa", "-o", out)
+        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+        return (work / out).read_text(encoding="utf-8")
+
+    def test_ir_uses_single_switch_terminator(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_switch_ir_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            proc = self.run_baa(work, "-O0", "--verify-ir", "--dump-ir", "-S", "main.baa", "-o", "main.s")
+            self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+            self.assertEqual(proc.stdout.count("تفرع "), 3, proc.stdout)
+
+    def test_dense_switch_uses_table_and_sparse_does_not(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_switch_asm_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            for level in ("-O0", "-O2"):
+                with self.subTest(level=level):
+                    asm = self.emit_asm(work, level)
+                    tables = _tables_by_function(asm)
+                    self.assertEqual(tables["كثيف"], 1)
+                    self.assertEqual(tables["متفرق"], 0)
+                    self.assertIn("jmp *%rax", asm)
+                    for label in TABLE_RE.findall(asm):
+                        self.assertIn(f"leaq {label}(%rip), %r11", asm)
+
+    def test_nazm_table_bound_check_avoids_jcc(self) -> None:
+        # نظم لا يعرف ja: فحص حدود الجدول يمر بـ seta/test/jne.
+        with tempfile.TemporaryDirectory(prefix="baa_switch_nazm_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            for level in ("-O0", "-O2"):
+                with self.subTest(level=level):
+                    proc = self.run_baa(
+                        work, level, "--emit-nazm", "--target=x86_64-linux", "main.baa", "-o", "main.نظم"
+                    )
+                    self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                    nazm = (work / "main.نظم").read_text(encoding="utf-8")
+                    self.assertIn("جدول_قفز_", nazm)
+                    self.assertIn("عين_فوق ", nazm)
+                    self.assertNotIn("اقفز_فوق", nazm)
+
+    @unittest.skipIf(os.name == "nt", "runtime check uses the Linux toolchain")
+    def test_lowered_switches_match_across_levels(self) -> None:
+        with tempfile.TemporaryDirectory(prefix="baa_switch_run_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_text(PROGRAM, encoding="utf-8")
+            outputs = {}
+            for level in ("-O0", "-O1", "-O2"):
+                with self.subTest(level=level):
+                    exe = work / f"main{level}"
+                    verify = () if level == "-O0" else ("--verify",)
+                    proc = self.run_baa(work, "--assembler=gas", *verify, level, "main.baa", "-o", exe.name)
+                    self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+                    run = subprocess.run([str(exe)], cwd=work, text=True, capture_output=True, timeout=30)
+                    self.assertEqual(run.returncode, 0, run.stderr)
+                    outputs[level] = run.stdout
+            self.assertEqual(outputs["-O0"].splitlines(), ["215618", "7654321", "840237"])
+            self.assertEqual(outputs["-O1"], outputs["-O0"])
+            self.assertEqual(outputs["-O2"], outputs["-O0"])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""Contract tests for bulk UTF-8 validation and whitespace/newline scanning in the lexer."""
+
+from __future__ import annotations
+
+import json
+import os
+import re
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+
+ROOT = Path(__file__).resolve().parents[1]
+LOCATION_RE = re.compile(r"main\.baa:(\d+):(\d+):")
+
+# طولا بادئتي السطر الثاني بالبايت: عمود البايت الخاطئ = البادئة + 2 × عدد الحروف + 1.
+STRING_PREFIX = '    نص س = "'
+IDENT_PREFIX = "    صحيح س"
+# أطوال تعبر حدود كتل 16 و32 بايتاً من الجهتين.
+RUN_LENGTHS = (0, 1, 6, 7, 8, 9, 15, 16, 17, 23, 24, 31, 32, 33, 48, 63, 64, 65)
+
+
+def _compiler() -> Path:
+    configured = os.environ.get("BAA")
+    if configured:
+        return Path(configured).resolve()
+    suffix = ".exe" if os.name == "nt" else ""
+    for candidate in (
+        ROOT / "build" / f"baa{suffix}",
+        ROOT / "build-linux" / f"baa{suffix}",
+    ):
+        if candidate.is_file():
+            return candidate.resolve()
+    raise unittest.SkipTest("Set BAA to a built Baa compiler")
+
+
+def _string_source(run: int) -> bytes:
+    return (
+        "صحيح الرئيسية() {\n".encode("utf-8")
+        + (STRING_PREFIX + "ب" * run).encode("utf-8")
+        + b"\xff"
+        + 'د".\n    إرجع ٠.\n}\n'.encode("utf-8")
+    )
+
+
+class TextScanLexerTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.baa = _compiler()
+
+    def check_file(self, source: bytes) -> subprocess.CompletedProcess[str]:
+        with tempfile.TemporaryDirectory(prefix="baa_text_scan_") as temp:
+            work = Path(temp)
+            (work / "main.baa").write_bytes(source)
+            return subprocess.run(
+                [str(self.baa), "--check", "main.baa"],
+                cwd=work,
+                text=True,
+                encoding="utf-8",
+                errors="replace",
+                capture_output=True,
+                timeout=30,
+            )
+
+    def error_location(self, source: bytes) -> tuple[int, int]:
+        proc = self.check_file(source)
+        combined = proc.stdout + proc.stderr
+        self.assertNotEqual(proc.returncode, 0, combined)
+        match = LOCATION_RE.search(combined)
+        self.assertIsNotNone(match, combined)
+        return int(match.group(1)), int(match.group(2))
+
+    def test_invalid_byte_in_string_reports_exact_column_across_blocks(self) -> None:
+        base = len(STRING_PREFIX.encode("utf-8"))
+        for run in RUN_LENGTHS:
+            with self.subTest(run=run):
+                self.assertEqual(self.error_location(_string_source(run)), (2, base + 2 * run + 1))
+
+    def test_invalid_byte_in_identifier_reports_exact_column_across_blocks(self) -> None:
+        base = len(IDENT_PREFIX.encode("utf-8"))
+        for run in RUN_LENGTHS:
+            with self.subTest(run=run):
+                source = (
+                    "صحيح الرئيسية() {\n".encode("utf-8")
+                    + (IDENT_PREFIX + "ب" * run).encode("utf-8")
+                    + b"\xc3("
+                    + " = ١.\n    إرجع ٠.\n}\n".encode("utf-8")
+                )
+                self.assertEqual(self.error_location(source), (2, base + 2 * run + 1))
+
+    def test_invalid_stdin_reports_exact_line_and_column(self) -> None:
+        base = len(STRING_PREFIX.encode("utf-8"))
+        for run in RUN_LENGTHS:
+            with self.subTest(run=run):
+                proc = subprocess.run(
+                    [str(self.baa), "--check", "--diagnostics=json", "--source-stdin=main.baa"],
+                    cwd=ROOT,
+                    input=_string_source(run),
+                    capture_output=True,
+                    timeout=30,
+                )
+                self.assertEqual(proc.returncode, 1, proc.stderr.decode("utf-8", errors="replace"))
+                diagnostic = json.loads(proc.stdout.decode("utf-8"))["diagnostics"][0]
+                self.assertIn("0xFF", diagnostic["message"])
+                self.assertEqual((diagnostic["line"], diagnostic["column"]), (2, base + 2 * run + 1))
+
+    def test_overlong_and_surrogate_sequences_are_rejected(self) -> None:
+        for bad in (b"\xc0\xaf", b"\xe0\x80\xaf", b"\xed\xa0\x80", b"\xf4\x90\x80\x80", b"\xf5\x80\x80\x80"):
+            with self.subTest(bad=bad.hex()):
+                source = (
+                    "صحيح الرئيسية() {\n".encode("utf-8")
+                    + (STRING_PREFIX + "ب" * 20).encode("utf-8")
+                    + bad
+                    + '".\n    إرجع ٠.\n}\n'.encode("utf-8")
+                )
+                self.assertEqual(self.error_location(source)[0], 2)
+
+    def test_multibyte_text_in_long_strings_and_comments_is_accepted(self) -> None:
+        mixed = "أ€ب😀ج✓" * 40
+        source = (
+            f"// {mixed}\n"
+            "صحيح الرئيسية() {\n"
+            f'    نص س = "{mixed}\\س\\"{mixed}".\n'
+            "    إرجع ٠.\n"
+            "}\n"
+        )
+        proc = self.check_file(source.encode("utf-8"))
+        self.assertEqual(proc.returncode, 0, proc.stdout + proc.stderr)
+
+    def test_long_whitespace_comments_and_skipped_blocks_keep_line_numbers(self) -> None:
+        filler = []
+        for i in range(40):
+            filler.append(" \t" * 37 + f"// سطر تعليق {i} / # {'ـ' * i}\n")
+            filler.append("\r\n" if i % 7 == 0 else "\n")
+        skipped = "#إذا_عرف غير_معرف\n" + "نص \"/ //\" غير مُحلَّل. / ب\n" * 30 + "#نهاية\n"
+        prefix = "".join(filler) + skipped + "صحيح الرئيسية() {\n" + " " * 70 + "\t"
+        line = prefix.count("\n") + 1
+        column = len(prefix.rsplit("\n", 1)[1].encode("utf-8")) + 1
+        source = prefix + "إرجع مجهول.\n}\n"
+        self.assertEqual(self.error_location(source.encode("utf-8")), (line, column + len("إرجع ".encode("utf-8"))))
+
+
+class TextScanKernelTests(unittest.TestCase):
+    def test_vector_paths_match_scalar(self) -> None:
+        cc = os.environ.get("CC") or shutil.which("cc") or shutil.which("gcc")
+        if not cc:
+            self.skipTest("no C compiler found (set CC)")
+        with tempfile.TemporaryDirectory(prefix="baa_text_scan_bench_") as temp:
+            exe = Path(temp) / ("text_scan_bench" + (".exe" if os.name == "nt" else ""))
+            build = subprocess.run(
+                [
+                    cc, "-std=c11", "-O1",
+                    "-I", str(ROOT / "src" / "support"), "-I", str(ROOT / "src"),
+                    "-o", str(exe),
+                    str(ROOT / "bench" / "text_scan_bench.c"),
+                    str(ROOT / "src" / "support" / "text_scan.c"),
+                ],
+                cwd=ROOT,
+                text=True,
+                capture_output=True,
+                timeout=120,
+            )
+            self.assertEqual(build.returncode, 0, build.stderr)
+            sources = sorted(str(p) for p in (ROOT / "tests" / "corpus_docs").glob("*.baa"))
+            run = subprocess.run(
+                [str(exe), "1", *sources],
+                cwd=ROOT,
+                text=True,
+                capture_output=True,
+                timeout=120,
+            )
+            self.assertEqual(run.returncode, 0, run.stderr)
+            self.assertGreater(json.loads(run.stdout)["bytes"], 0)
+
+
+if __name__ == "__main__":
+    unittest.main()